@@ -30,11 +30,13 @@
 #include <MessagesClient.h>
 #include <NetworkAccessManager.h>
 #include <NodeList.h>
+#include <PathUtils.h>
 #include <udt/PacketHeaders.h>
 #include <ResourceCache.h>
 #include <ResourceScriptingInterface.h>
 #include <ScriptCache.h>
 #include <ScriptEngines.h>
+#include <SharedUtil.h>
 #include <SoundCacheScriptingInterface.h>
 #include <SoundCache.h>
 #include <UserActivityLoggerScriptingInterface.h>
@@ -181,7 +183,7 @@ void Agent::run() {
     // Create ScriptEngines on threaded-assignment thread then move to main thread.
     DependencyManager::set<ScriptEngines>(ScriptEngine::AGENT_SCRIPT)->moveToThread(qApp->thread());
 
-    DependencyManager::set<ScriptCache>();
+    DependencyManager::set<ScriptCache>()->setDiskCacheDirectory(PathUtils::getAppLocalDataFilePath("scriptCache"));
 
     // make sure we request our script once the agent connects to the domain
     auto nodeList = DependencyManager::get<NodeList>();
@@ -350,6 +352,9 @@ void Agent::scriptRequestFinished() {
         _scriptContents = request->getData();
         qInfo() << "Downloaded script:" << _scriptContents;
 
+        // start on the scripts it includes while the engine is being set up
+        DependencyManager::get<ScriptCache>()->prefetchDependencies(request->getUrl(), _scriptContents);
+
         // we could just call executeScript directly - we use a QueuedConnection to allow scriptRequestFinished
         // to return before calling executeScript
         QMetaObject::invokeMethod(this, "executeScript", Qt::QueuedConnection);
@@ -373,6 +378,9 @@ void Agent::executeScript() {
     {
         _scriptEngine = scriptEngineFactory(ScriptEngine::AGENT_SCRIPT, _scriptContents, _payload);
 
+        setUpMetrics();
+        _scriptEngine->setTimerDispatchLagHistogram(_metrics.timerDispatchLag);
+
         // setup an Avatar for the script to use
         auto scriptedAvatar = DependencyManager::get<ScriptableAvatar>();
         scriptedAvatar->setID(getSessionUUID());
@@ -692,6 +700,8 @@ void Agent::processAgentAvatarAudio() {
     bool isPlayingRecording = recordingInterface->isPlaying();
 
     if (_isAvatar && ((_isListeningToAudioStream && !isPlayingRecording) || _avatarSound)) {
+        quint64 start = usecTimestampNow();
+
         // if we have an avatar audio stream then send it out to our audio-mixer
         auto scriptedAvatar = DependencyManager::get<ScriptableAvatar>();
         bool silentFrame = true;
@@ -815,9 +825,34 @@ void Agent::processAgentAvatarAudio() {
                 nodeList->sendUnreliablePacket(*audioPacket, *node);
             }
         });
+
+        if (audioPacket->getType() == PacketType::SilentAudioFrame) {
+            _metrics.silentFrames->increment();
+        } else {
+            _metrics.audioFrames->increment();
+        }
+        _metrics.audioFrameTime->record(usecTimestampNow() - start);
     }
 }
 
+void Agent::setUpMetrics() {
+    if (!DependencyManager::isSet<MetricsRegistry>()) {
+        return;
+    }
+    auto registry = DependencyManager::get<MetricsRegistry>();
+
+    _metrics.audioFrameTime = registry->histogram("hifi_agent_audio_frame_microseconds",
+        "Time spent encoding and sending a frame of the avatar's audio");
+
+    const QString FRAMES_METRIC = "hifi_agent_audio_frames_total";
+    const QString FRAMES_HELP = "Frames of the avatar's audio sent, by kind";
+    _metrics.audioFrames = registry->counter(FRAMES_METRIC, FRAMES_HELP, MetricsRegistry::label("kind", "audio"));
+    _metrics.silentFrames = registry->counter(FRAMES_METRIC, FRAMES_HELP, MetricsRegistry::label("kind", "silent"));
+
+    _metrics.timerDispatchLag = registry->histogram("hifi_agent_timer_lag_microseconds",
+        "Time from a script timer's deadline to its callback running");
+}
+
 void Agent::aboutToFinish() {
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
     DependencyManager::get<EntityScriptingInterface>()->setEntityTree(nullptr);
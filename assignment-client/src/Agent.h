@@ -23,6 +23,7 @@
 
 #include <EntityEditPacketSender.h>
 #include <EntityTree.h>
+#include <MetricsRegistry.h>
 #include <ScriptEngine.h>
 #include <ThreadedAssignment.h>
 
@@ -88,6 +89,7 @@ private:
     void selectAudioFormat(const QString& selectedCodecName);
     void encodeFrameOfZeros(QByteArray& encodedZeros);
     void computeLoudness(const QByteArray* decodedBuffer, QSharedPointer<ScriptableAvatar>);
+    void setUpMetrics();
 
     ScriptEnginePointer _scriptEngine;
     EntityEditPacketSender _entityEditSender;
@@ -120,6 +122,15 @@ private:
     Encoder* _encoder { nullptr };
     QTimer _avatarAudioTimer;
     bool _flushEncoder { false };
+
+    // the scripted avatar's outbound audio, and how late its script timers run
+    struct Metrics {
+        std::shared_ptr<MetricHistogram> audioFrameTime { std::make_shared<MetricHistogram>() };
+        std::shared_ptr<MetricCounter> audioFrames { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> silentFrames { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricHistogram> timerDispatchLag { std::make_shared<MetricHistogram>() };
+    };
+    Metrics _metrics;
 };
 
 #endif // hifi_Agent_h
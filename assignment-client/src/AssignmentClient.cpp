@@ -13,7 +13,9 @@
 
 #include <assert.h>
 
+#include <QFileInfo>
 #include <QProcess>
+#include <QProcessEnvironment>
 #include <QSharedMemory>
 #include <QThread>
 #include <QTimer>
@@ -23,8 +25,10 @@
 #include <AddressManager.h>
 #include <Assignment.h>
 #include <LogHandler.h>
+#include <HTTPConnection.h>
 #include <LogUtils.h>
 #include <LimitedNodeList.h>
+#include <MetricsRegistry.h>
 #include <NodeList.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
@@ -39,17 +43,28 @@
 
 const QString ASSIGNMENT_CLIENT_TARGET_NAME = "assignment-client";
 const long long ASSIGNMENT_REQUEST_INTERVAL_MSECS = 1 * 1000;
+const QString TRACE_FILE_ENVIRONMENT_VARIABLE = "HIFI_TRACE_FILE";
 
 AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QString assignmentPool,
                                    quint16 listenPort, QUuid walletUUID, QString assignmentServerHostname,
-                                   quint16 assignmentServerPort, quint16 assignmentMonitorPort) :
+                                   quint16 assignmentServerPort, quint16 assignmentMonitorPort, quint16 metricsPort) :
     _assignmentServerHostname(DEFAULT_ASSIGNMENT_SERVER_HOSTNAME)
 {
     LogUtils::init();
 
-    DependencyManager::set<tracing::Tracer>();
+    auto tracer = DependencyManager::set<tracing::Tracer>();
     DependencyManager::set<StatTracker>();
+    DependencyManager::set<MetricsRegistry>();
     DependencyManager::set<AccountManager>();
+
+    // record the profile ranges of every assignment-client started with HIFI_TRACE_FILE set,
+    // adding the process ID to the file name since forked children inherit the environment
+    QString traceFile = QProcessEnvironment::systemEnvironment().value(TRACE_FILE_ENVIRONMENT_VARIABLE);
+    if (!traceFile.isEmpty()) {
+        QFileInfo traceFileInfo(traceFile);
+        tracer->startRecording(QString("%1/%2-%3.%4").arg(traceFileInfo.path(), traceFileInfo.completeBaseName(),
+            QString::number(QCoreApplication::applicationPid()), traceFileInfo.suffix()));
+    }
     DependencyManager::set<ResourceRequestObserver>();
 
     auto addressManager = DependencyManager::set<AddressManager>();
@@ -113,6 +128,12 @@ AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QStri
         // Hook up a timer to send this child's status to the Monitor once per second
         setUpStatusToMonitor();
     }
+
+    if (metricsPort > 0) {
+        qCDebug(assignment_client) << "Serving metrics on port" << metricsPort;
+        _metricsHTTPManager.reset(new HTTPManager(QHostAddress::AnyIPv4, metricsPort, "", this));
+    }
+
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListener(PacketType::CreateAssignment, this, "handleCreateAssignmentPacket");
     packetReceiver.registerListener(PacketType::StopNode, this, "handleStopNodePacket");
@@ -136,6 +157,8 @@ void AssignmentClient::stopAssignmentClient() {
             QCoreApplication::processEvents();
         }
     }
+
+    DependencyManager::get<tracing::Tracer>()->stopRecording();
 }
 
 AssignmentClient::~AssignmentClient() {
@@ -147,6 +170,16 @@ void AssignmentClient::aboutToQuit() {
     stopAssignmentClient();
 }
 
+bool AssignmentClient::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
+    if (url.path() == "/metrics") {
+        connection->respond(HTTPConnection::StatusCode200, DependencyManager::get<MetricsRegistry>()->toPrometheusText(),
+                            "text/plain; version=0.0.4");
+    } else {
+        connection->respond(HTTPConnection::StatusCode404);
+    }
+    return true;
+}
+
 void AssignmentClient::setUpStatusToMonitor() {
     // send a stats packet every 1 seconds
     connect(&_statsTimerACM, &QTimer::timeout, this, &AssignmentClient::sendStatusPacketToACM);
@@ -15,19 +15,24 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QPointer>
 
+#include <HTTPManager.h>
+
 #include "ThreadedAssignment.h"
 
 class QSharedMemory;
 
-class AssignmentClient : public QObject {
+class AssignmentClient : public QObject, public HTTPRequestHandler {
     Q_OBJECT
 public:
     AssignmentClient(Assignment::Type requestAssignmentType, QString assignmentPool,
                      quint16 listenPort,
                      QUuid walletUUID, QString assignmentServerHostname, quint16 assignmentServerPort,
-                     quint16 assignmentMonitorPort);
+                     quint16 assignmentMonitorPort, quint16 metricsPort);
     ~AssignmentClient();
 
+    /// serves the MetricsRegistry on /metrics
+    bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
+
 private slots:
     void sendAssignmentRequest();
     void assignmentCompleted();
@@ -53,6 +58,7 @@ private:
     QTimer _requestTimer; // timer for requesting and assignment
     QTimer _statsTimerACM; // timer for sending stats to assignment client monitor
     QUuid _childAssignmentUUID = QUuid::createUuid();
+    std::unique_ptr<HTTPManager> _metricsHTTPManager;
 
  protected:
     HifiSockAddr _assignmentClientMonitorSocket;
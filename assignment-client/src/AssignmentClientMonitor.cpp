@@ -41,7 +41,8 @@ AssignmentClientMonitor::AssignmentClientMonitor(const unsigned int numAssignmen
                                                  const unsigned int maxAssignmentClientForks,
                                                  Assignment::Type requestAssignmentType, QString assignmentPool,
                                                  quint16 listenPort, quint16 childMinListenPort, QUuid walletUUID, QString assignmentServerHostname,
-                                                 quint16 assignmentServerPort, quint16 httpStatusServerPort, QString logDirectory) :
+                                                 quint16 assignmentServerPort, quint16 httpStatusServerPort, quint16 childMinMetricsPort,
+                                                 QString logDirectory) :
     _httpManager(QHostAddress::LocalHost, httpStatusServerPort, "", this),
     _numAssignmentClientForks(numAssignmentClientForks),
     _minAssignmentClientForks(minAssignmentClientForks),
@@ -51,7 +52,8 @@ AssignmentClientMonitor::AssignmentClientMonitor(const unsigned int numAssignmen
     _walletUUID(walletUUID),
     _assignmentServerHostname(assignmentServerHostname),
     _assignmentServerPort(assignmentServerPort),
-    _childMinListenPort(childMinListenPort)
+    _childMinListenPort(childMinListenPort),
+    _childMinMetricsPort(childMinMetricsPort)
 {
     qDebug() << "_requestAssignmentType =" << _requestAssignmentType;
 
@@ -100,13 +102,17 @@ void AssignmentClientMonitor::simultaneousWaitOnChildren(int waitMsecs) {
     }
 }
 
-void AssignmentClientMonitor::childProcessFinished(qint64 pid, quint16 listenPort, int exitCode, QProcess::ExitStatus exitStatus) {
+void AssignmentClientMonitor::childProcessFinished(qint64 pid, quint16 listenPort, quint16 metricsPort,
+                                                   int exitCode, QProcess::ExitStatus exitStatus) {
     auto message = "Child process " + QString::number(pid) + " on port " + QString::number(listenPort) +
                    "has %1 with exit code " + QString::number(exitCode) + ".";
 
     if (listenPort) {
         _childListenPorts.remove(listenPort);
     }
+    if (metricsPort) {
+        _childMetricsPorts.remove(metricsPort);
+    }
 
     if (_childProcesses.remove(pid)) {
         message.append(" Removed from internal map.");
@@ -175,6 +181,22 @@ void AssignmentClientMonitor::spawnChildClient() {
         _childListenPorts.insert(listenPort);
     }
 
+    // each child serves its own metrics, so give it a port of its own
+    quint16 metricsPort = 0;
+    if (_childMinMetricsPort) {
+        for (metricsPort = _childMinMetricsPort; _childMetricsPorts.contains(metricsPort); metricsPort++) {
+            if (_maxAssignmentClientForks &&
+                (metricsPort >= _maxAssignmentClientForks + _childMinMetricsPort)) {
+                metricsPort = 0;
+                qDebug() << "Insufficient metrics ports";
+                break;
+            }
+        }
+    }
+    if (metricsPort) {
+        _childMetricsPorts.insert(metricsPort);
+    }
+
     // unparse the parts of the command-line that the child cares about
     QStringList _childArguments;
     if (_assignmentPool != "") {
@@ -203,6 +225,11 @@ void AssignmentClientMonitor::spawnChildClient() {
         _childArguments.append(QString::number(listenPort));
     }
 
+    if (metricsPort) {
+        _childArguments.append("--" + ASSIGNMENT_METRICS_PORT_OPTION);
+        _childArguments.append(QString::number(metricsPort));
+    }
+
     // tell children which assignment monitor port to use
     // for now they simply talk to us on localhost
     _childArguments.append("--" + ASSIGNMENT_CLIENT_MONITOR_PORT_OPTION);
@@ -274,13 +301,13 @@ void AssignmentClientMonitor::spawnChildClient() {
         auto pid = assignmentClient->processId();
         // make sure we hear that this process has finished when it does
         connect(assignmentClient, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
-                this, [this, listenPort, pid](int exitCode, QProcess::ExitStatus exitStatus) {
-                    childProcessFinished(pid, listenPort, exitCode, exitStatus);
+                this, [this, listenPort, metricsPort, pid](int exitCode, QProcess::ExitStatus exitStatus) {
+                    childProcessFinished(pid, listenPort, metricsPort, exitCode, exitStatus);
             });
 
         qDebug() << "Spawned a child client with PID" << assignmentClient->processId();
 
-        _childProcesses.insert(assignmentClient->processId(), { assignmentClient, stdoutPath, stderrPath });
+        _childProcesses.insert(assignmentClient->processId(), { assignmentClient, stdoutPath, stderrPath, metricsPort });
     }
 }
 
@@ -387,6 +414,9 @@ bool AssignmentClientMonitor::handleHTTPRequest(HTTPConnection* connection, cons
             server["pid"] = ac.process->processId();
             server["logStdout"] = ac.logStdoutPath;
             server["logStderr"] = ac.logStderrPath;
+            if (ac.metricsPort) {
+                server["metricsPort"] = ac.metricsPort;
+            }
 
             servers[QString::number(ac.process->processId())] = server;
         }
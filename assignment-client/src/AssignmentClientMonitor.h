@@ -30,6 +30,7 @@ struct ACProcess {
     QProcess* process; // looks like a dangling pointer, but is parented by the AssignmentClientMonitor 
     QString logStdoutPath;
     QString logStderrPath;
+    quint16 metricsPort;
 };
 
 class AssignmentClientMonitor : public QObject, public HTTPRequestHandler {
@@ -39,13 +40,13 @@ public:
                             const unsigned int maxAssignmentClientForks, Assignment::Type requestAssignmentType,
                             QString assignmentPool, quint16 listenPort, quint16 childMinListenPort, QUuid walletUUID,
                             QString assignmentServerHostname, quint16 assignmentServerPort, quint16 httpStatusServerPort,
-                            QString logDirectory);
+                            quint16 childMinMetricsPort, QString logDirectory);
     ~AssignmentClientMonitor();
 
     void stopChildProcesses();
 private slots:
     void checkSpares();
-    void childProcessFinished(qint64 pid, quint16 port, int exitCode, QProcess::ExitStatus exitStatus);
+    void childProcessFinished(qint64 pid, quint16 port, quint16 metricsPort, int exitCode, QProcess::ExitStatus exitStatus);
     void handleChildStatusPacket(QSharedPointer<ReceivedMessage> message);
 
     bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
@@ -79,6 +80,9 @@ private:
     quint16 _childMinListenPort;
     QSet<quint16> _childListenPorts;
 
+    quint16 _childMinMetricsPort;
+    QSet<quint16> _childMetricsPorts;
+
     bool _wantsChildFileLogging { false };
 };
 
@@ -12,6 +12,7 @@
 
 #include "AssetServer.h"
 
+#include <algorithm>
 #include <thread>
 #include <memory>
 
@@ -33,6 +34,7 @@
 #include <NodeType.h>
 #include <SharedUtil.h>
 #include <PathUtils.h>
+#include <PortableHighResolutionClock.h>
 #include <image/TextureProcessing.h>
 
 #include "AssetServerLogging.h"
@@ -367,6 +369,8 @@ static const QString ASSET_FILES_SUBDIR = "files";
 void AssetServer::completeSetup() {
     auto nodeList = DependencyManager::get<NodeList>();
 
+    setUpMetrics();
+
     auto& domainHandler = nodeList->getDomainHandler();
     const QJsonObject& settingsObject = domainHandler.getSettingsObject();
 
@@ -472,6 +476,27 @@ void AssetServer::completeSetup() {
     replayRequests();
 }
 
+void AssetServer::setUpMetrics() {
+    if (!DependencyManager::isSet<MetricsRegistry>()) {
+        return;
+    }
+    auto registry = DependencyManager::get<MetricsRegistry>();
+
+    const QString REQUEST_METRIC = "hifi_asset_server_request_microseconds";
+    const QString REQUEST_HELP = "Time from a request arriving to its reply being sent, by request";
+    _metrics.getTime = registry->histogram(REQUEST_METRIC, REQUEST_HELP, MetricsRegistry::label("request", "get"));
+    _metrics.getInfoTime = registry->histogram(REQUEST_METRIC, REQUEST_HELP, MetricsRegistry::label("request", "get_info"));
+    _metrics.uploadTime = registry->histogram(REQUEST_METRIC, REQUEST_HELP, MetricsRegistry::label("request", "upload"));
+    _metrics.mappingTime = registry->histogram(REQUEST_METRIC, REQUEST_HELP, MetricsRegistry::label("request", "mapping"));
+}
+
+void AssetServer::recordRequestTime(MetricHistogram& histogram, const ReceivedMessage& request) {
+    // the receive time is on the high resolution clock, not the one usecTimestampNow() reads
+    qint64 now = std::chrono::duration_cast<std::chrono::microseconds>(
+        p_high_resolution_clock::now().time_since_epoch()).count();
+    histogram.record((uint64_t)std::max(now - request.getFirstPacketReceiveTime(), (qint64)0));
+}
+
 void AssetServer::queueRequests(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode) {
     qCDebug(asset_server) << "Queuing requests until fully setup";
 
@@ -626,6 +651,7 @@ void AssetServer::handleAssetMappingOperation(QSharedPointer<ReceivedMessage> me
     } else {
         nodeList->sendPacketList(std::move(replyPacket), message->getSenderSockAddr());
     }
+    recordRequestTime(*_metrics.mappingTime, *message);
 }
 
 void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket) {
@@ -855,6 +881,7 @@ void AssetServer::handleAssetGetInfo(QSharedPointer<ReceivedMessage> message, Sh
 
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->sendPacket(std::move(replyPacket), *senderNode);
+    recordRequestTime(*_metrics.getInfoTime, *message);
 }
 
 void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -867,7 +894,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _metrics.getTime);
     _transferTaskPool.start(task);
 }
 
@@ -881,7 +908,7 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (canWriteToAssetServer) {
         qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << message->getSourceID();
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit);
+        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit, _metrics.uploadTime);
         _transferTaskPool.start(task);
     } else {
         // this is a node the domain told us is not allowed to rez entities
@@ -16,6 +16,7 @@
 #include <QtCore/QThreadPool>
 #include <QRunnable>
 
+#include <MetricsRegistry.h>
 #include <ThreadedAssignment.h>
 
 #include "AssetUtils.h"
@@ -77,6 +78,9 @@ public:
 
     void aboutToFinish() override;
 
+    /// records the time since the request arrived, which includes any wait for setup or a transfer thread
+    static void recordRequestTime(MetricHistogram& histogram, const ReceivedMessage& request);
+
 public slots:
     void run() override;
 
@@ -92,6 +96,7 @@ private slots:
     void sendStatsPacket() override;
 
 private:
+    void setUpMetrics();
     void replayRequests();
 
     void handleGetMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket);
@@ -159,6 +164,15 @@ private:
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
     QThreadPool _bakingTaskPool;
 
+    // time from a request arriving to the reply going out, by request type
+    struct Metrics {
+        std::shared_ptr<MetricHistogram> getTime { std::make_shared<MetricHistogram>() };
+        std::shared_ptr<MetricHistogram> getInfoTime { std::make_shared<MetricHistogram>() };
+        std::shared_ptr<MetricHistogram> uploadTime { std::make_shared<MetricHistogram>() };
+        std::shared_ptr<MetricHistogram> mappingTime { std::make_shared<MetricHistogram>() };
+    };
+    Metrics _metrics;
+
     QMutex _queuedRequestsMutex;
     bool _isQueueingRequests { true };
     using RequestQueue = QVector<QPair<QSharedPointer<ReceivedMessage>, SharedNodePointer>>;
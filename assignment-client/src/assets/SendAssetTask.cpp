@@ -26,11 +26,13 @@
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                             std::shared_ptr<MetricHistogram> requestTime) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _requestTime(requestTime)
 {
     
 }
@@ -117,4 +119,5 @@ void SendAssetTask::run() {
     } else {
         nodeList->sendPacketList(std::move(replyPacketList), _message->getSenderSockAddr());
     }
+    AssetServer::recordRequestTime(*_requestTime, *_message);
 }
@@ -18,14 +18,17 @@
 #include <NodeList.h>
 #include <NLPacketList.h>
 
+#include "AssetServer.h"
 #include "ClientServerUtils.h"
 
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir, uint64_t filesizeLimit) :
+                                 const QDir& resourcesDir, uint64_t filesizeLimit,
+                                 std::shared_ptr<MetricHistogram> requestTime) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
     _resourcesDir(resourcesDir),
-    _filesizeLimit(filesizeLimit)
+    _filesizeLimit(filesizeLimit),
+    _requestTime(requestTime)
 {
     
 }
@@ -114,4 +117,5 @@ void UploadAssetTask::run() {
     } else {
         nodeList->sendPacket(std::move(replyPacket), _receivedMessage->getSenderSockAddr());
     }
+    AssetServer::recordRequestTime(*_requestTime, *_receivedMessage);
 }
@@ -127,6 +127,9 @@ void AudioMixer::aboutToFinish() {
 void AudioMixer::queueAudioPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
     if (message->getType() == PacketType::SilentAudioFrame) {
         _numSilentPackets++;
+        if (_metrics.silentPackets) {
+            _metrics.silentPackets->increment();
+        }
     }
 
     getOrCreateClientData(node.data())->queuePacket(message, node);
@@ -399,6 +402,8 @@ AudioMixerClientData* AudioMixer::getOrCreateClientData(Node* node) {
 void AudioMixer::start() {
     auto nodeList = DependencyManager::get<NodeList>();
 
+    setUpMetrics();
+
     // prepare the NodeList
     nodeList->addSetOfNodeTypesToNodeInterestSet({
         NodeType::Agent, NodeType::EntityScriptServer,
@@ -465,10 +470,13 @@ void AudioMixer::start() {
         });
 
         // gather stats
+        AudioMixerStats frameStats;
         _slavePool.each([&](AudioMixerSlave& slave) {
-            _stats.accumulate(slave.stats);
+            frameStats.accumulate(slave.stats);
             slave.stats.reset();
         });
+        _stats.accumulate(frameStats);
+        updateMetrics(frameStats);
 
         ++frame;
         ++_numStatFrames;
@@ -807,12 +815,109 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
     }
 }
 
-AudioMixer::Timer::Timing::Timing(uint64_t& sum) : _sum(sum) {
+void AudioMixer::setUpMetrics() {
+    if (!DependencyManager::isSet<MetricsRegistry>()) {
+        return;
+    }
+    auto registry = DependencyManager::get<MetricsRegistry>();
+
+    const QString STAGE_METRIC = "hifi_audio_mixer_stage_microseconds";
+    const QString STAGE_HELP = "Time spent in each stage of the audio mixer frame loop";
+    auto stageHistogram = [&](const QString& stage) {
+        return registry->histogram(STAGE_METRIC, STAGE_HELP, MetricsRegistry::label("stage", stage));
+    };
+    _ticTiming.setHistogram(stageHistogram("tic"));
+    _checkTimeTiming.setHistogram(stageHistogram("check_time"));
+    _sleepTiming.setHistogram(stageHistogram("sleep"));
+    _frameTiming.setHistogram(stageHistogram("frame"));
+    _mixTiming.setHistogram(stageHistogram("mix"));
+    _eventsTiming.setHistogram(stageHistogram("events"));
+    _packetsTiming.setHistogram(stageHistogram("packets"));
+
+    _metrics.frames = registry->counter("hifi_audio_mixer_frames_total", "Audio mixer frames");
+    _metrics.mixes = registry->counter("hifi_audio_mixer_mixes_total", "Listener mixes");
+    _metrics.hrtfRenders = registry->counter("hifi_audio_mixer_hrtf_renders_total", "Streams rendered through an HRTF");
+    _metrics.hrtfResets = registry->counter("hifi_audio_mixer_hrtf_resets_total", "HRTFs reset for a stream");
+    _metrics.hrtfUpdates = registry->counter("hifi_audio_mixer_hrtf_updates_total",
+                                             "HRTFs updated without rendering, for inactive streams");
+
+    const QString MANUAL_MIXES_METRIC = "hifi_audio_mixer_manual_mixes_total";
+    const QString MANUAL_MIXES_HELP = "Streams mixed without an HRTF, by kind";
+    _metrics.manualStereoMixes = registry->counter(MANUAL_MIXES_METRIC, MANUAL_MIXES_HELP,
+                                                   MetricsRegistry::label("kind", "stereo"));
+    _metrics.manualEchoMixes = registry->counter(MANUAL_MIXES_METRIC, MANUAL_MIXES_HELP,
+                                                 MetricsRegistry::label("kind", "echo"));
+
+    const QString STREAMS_METRIC = "hifi_audio_mixer_stream_frames_total";
+    const QString STREAMS_HELP = "Streams considered for a listener mix, by how they were mixed";
+    _metrics.skippedStreams = registry->counter(STREAMS_METRIC, STREAMS_HELP, MetricsRegistry::label("state", "skipped"));
+    _metrics.inactiveStreams = registry->counter(STREAMS_METRIC, STREAMS_HELP, MetricsRegistry::label("state", "inactive"));
+    _metrics.activeStreams = registry->counter(STREAMS_METRIC, STREAMS_HELP, MetricsRegistry::label("state", "active"));
+
+    const QString TRANSITIONS_METRIC = "hifi_audio_mixer_stream_transitions_total";
+    const QString TRANSITIONS_HELP = "Streams that changed how they were mixed for a listener";
+    auto transitionCounter = [&](const QString& from, const QString& to) {
+        return registry->counter(TRANSITIONS_METRIC, TRANSITIONS_HELP,
+                                 MetricsRegistry::label("from", from) + "," + MetricsRegistry::label("to", to));
+    };
+    _metrics.skippedToActive = transitionCounter("skipped", "active");
+    _metrics.skippedToInactive = transitionCounter("skipped", "inactive");
+    _metrics.inactiveToSkipped = transitionCounter("inactive", "skipped");
+    _metrics.inactiveToActive = transitionCounter("inactive", "active");
+    _metrics.activeToSkipped = transitionCounter("active", "skipped");
+    _metrics.activeToInactive = transitionCounter("active", "inactive");
+
+    _metrics.silentPackets = registry->counter("hifi_audio_mixer_silent_packets_total", "Silent audio frames received");
+
+    _metrics.streams = registry->gauge("hifi_audio_mixer_streams", "Streams mixed in the last frame");
+    _metrics.listeners = registry->gauge("hifi_audio_mixer_listeners", "Listeners mixed for in the last frame");
+    _metrics.silentListeners = registry->gauge("hifi_audio_mixer_silent_listeners",
+                                               "Listeners sent silence in the last frame");
+
+    _metrics.threads = registry->gauge("hifi_audio_mixer_threads", "Slave threads mixing");
+    _metrics.trailingMixRatio = registry->gauge("hifi_audio_mixer_trailing_mix_ratio",
+                                                "Trailing ratio of time spent mixing to time available");
+    _metrics.throttlingRatio = registry->gauge("hifi_audio_mixer_throttling_ratio", "Share of streams throttled");
+}
+
+void AudioMixer::updateMetrics(const AudioMixerStats& frameStats) {
+    if (!_metrics.frames) {
+        return;
+    }
+    _metrics.frames->increment();
+    _metrics.mixes->increment(frameStats.totalMixes);
+    _metrics.hrtfRenders->increment(frameStats.hrtfRenders);
+    _metrics.hrtfResets->increment(frameStats.hrtfResets);
+    _metrics.hrtfUpdates->increment(frameStats.hrtfUpdates);
+    _metrics.manualStereoMixes->increment(frameStats.manualStereoMixes);
+    _metrics.manualEchoMixes->increment(frameStats.manualEchoMixes);
+    _metrics.skippedStreams->increment(frameStats.skipped);
+    _metrics.inactiveStreams->increment(frameStats.inactive);
+    _metrics.activeStreams->increment(frameStats.active);
+    _metrics.skippedToActive->increment(frameStats.skippedToActive);
+    _metrics.skippedToInactive->increment(frameStats.skippedToInactive);
+    _metrics.inactiveToSkipped->increment(frameStats.inactiveToSkipped);
+    _metrics.inactiveToActive->increment(frameStats.inactiveToActive);
+    _metrics.activeToSkipped->increment(frameStats.activeToSkipped);
+    _metrics.activeToInactive->increment(frameStats.activeToInactive);
+    _metrics.streams->set(frameStats.sumStreams);
+    _metrics.listeners->set(frameStats.sumListeners);
+    _metrics.silentListeners->set(frameStats.sumListenersSilent);
+    _metrics.threads->set(_slavePool.numThreads());
+    _metrics.trailingMixRatio->set(_trailingMixRatio);
+    _metrics.throttlingRatio->set(_throttlingRatio);
+}
+
+AudioMixer::Timer::Timing::Timing(uint64_t& sum, MetricHistogram* histogram) : _sum(sum), _histogram(histogram) {
     _timing = p_high_resolution_clock::now();
 }
 
 AudioMixer::Timer::Timing::~Timing() {
-    _sum += chrono::duration_cast<chrono::microseconds>(p_high_resolution_clock::now() - _timing).count();
+    uint64_t duration = chrono::duration_cast<chrono::microseconds>(p_high_resolution_clock::now() - _timing).count();
+    _sum += duration;
+    if (_histogram) {
+        _histogram->record(duration);
+    }
 }
 
 void AudioMixer::Timer::get(uint64_t& timing, uint64_t& trailing) {
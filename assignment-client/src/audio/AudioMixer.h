@@ -15,6 +15,7 @@
 #include <AABox.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
+#include <MetricsRegistry.h>
 #include <ThreadedAssignment.h>
 #include <UUIDHasher.h>
 
@@ -94,6 +95,9 @@ private:
     void parseSettingsObject(const QJsonObject& settingsObject);
     void clearDomainSettings();
 
+    void setUpMetrics();
+    void updateMetrics(const AudioMixerStats& frameStats);
+
     p_high_resolution_clock::time_point _idealFrameTimestamp;
     p_high_resolution_clock::time_point _startFrameTimestamp;
 
@@ -111,18 +115,22 @@ private:
     public:
         class Timing{
         public:
-            Timing(uint64_t& sum);
+            Timing(uint64_t& sum, MetricHistogram* histogram);
             ~Timing();
         private:
             p_high_resolution_clock::time_point _timing;
             uint64_t& _sum;
+            MetricHistogram* _histogram;
         };
 
-        Timing timer() { return Timing(_sum); }
+        Timing timer() { return Timing(_sum, _histogram.get()); }
         void get(uint64_t& timing, uint64_t& trailing);
+        // also record each timing, so the tail is visible and not just the trailing average
+        void setHistogram(std::shared_ptr<MetricHistogram> histogram) { _histogram = histogram; }
     private:
         static const int TIMER_TRAILING_SECONDS = 10;
 
+        std::shared_ptr<MetricHistogram> _histogram;
         uint64_t _sum { 0 };
         uint64_t _trailing { 0 };
         uint64_t _history[TIMER_TRAILING_SECONDS] {};
@@ -138,6 +146,33 @@ private:
     Timer _eventsTiming;
     Timer _packetsTiming;
 
+    struct Metrics {
+        std::shared_ptr<MetricCounter> frames;
+        std::shared_ptr<MetricCounter> mixes;
+        std::shared_ptr<MetricCounter> hrtfRenders;
+        std::shared_ptr<MetricCounter> hrtfResets;
+        std::shared_ptr<MetricCounter> hrtfUpdates;
+        std::shared_ptr<MetricCounter> manualStereoMixes;
+        std::shared_ptr<MetricCounter> manualEchoMixes;
+        std::shared_ptr<MetricCounter> skippedStreams;
+        std::shared_ptr<MetricCounter> inactiveStreams;
+        std::shared_ptr<MetricCounter> activeStreams;
+        std::shared_ptr<MetricCounter> skippedToActive;
+        std::shared_ptr<MetricCounter> skippedToInactive;
+        std::shared_ptr<MetricCounter> inactiveToSkipped;
+        std::shared_ptr<MetricCounter> inactiveToActive;
+        std::shared_ptr<MetricCounter> activeToSkipped;
+        std::shared_ptr<MetricCounter> activeToInactive;
+        std::shared_ptr<MetricCounter> silentPackets;
+        std::shared_ptr<MetricGauge> streams;
+        std::shared_ptr<MetricGauge> listeners;
+        std::shared_ptr<MetricGauge> silentListeners;
+        std::shared_ptr<MetricGauge> threads;
+        std::shared_ptr<MetricGauge> trailingMixRatio;
+        std::shared_ptr<MetricGauge> throttlingRatio;
+    };
+    Metrics _metrics;
+
     static int _numStaticJitterFrames; // -1 denotes dynamic jitter buffering
     static float _noiseMutingThreshold;
     static float _attenuationPerDoublingInDistance;
@@ -290,6 +290,7 @@ void AvatarMixer::start() {
             }, &lockWait, &nodeTransform, &functor);
             auto end = usecTimestampNow();
             _processQueuedAvatarDataPacketsElapsedTime += (end - start);
+            _metrics.processQueuedAvatarDataPacketsTime->record(end - start);
 
             _broadcastAvatarDataLockWait += lockWait;
             _broadcastAvatarDataNodeTransform += nodeTransform;
@@ -311,6 +312,7 @@ void AvatarMixer::start() {
             }, &lockWait, &nodeTransform, &functor);
             auto end = usecTimestampNow();
             _displayNameManagementElapsedTime += (end - start);
+            _metrics.displayNameManagementTime->record(end - start);
 
             _broadcastAvatarDataLockWait += lockWait;
             _broadcastAvatarDataNodeTransform += nodeTransform;
@@ -328,6 +330,7 @@ void AvatarMixer::start() {
             }, &lockWait, &nodeTransform, &functor);
             auto end = usecTimestampNow();
             _broadcastAvatarDataElapsedTime += (end - start);
+            _metrics.broadcastAvatarDataTime->record(end - start);
 
             _broadcastAvatarDataLockWait += lockWait;
             _broadcastAvatarDataNodeTransform += nodeTransform;
@@ -350,6 +353,7 @@ void AvatarMixer::start() {
             }
             auto end = usecTimestampNow();
             _processEventsElapsedTime += (end - start);
+            _metrics.processEventsTime->record(end - start);
         }
 
         _lastFrameTimestamp = frameTimestamp;
@@ -754,6 +758,11 @@ void AvatarMixer::sendStatsPacket() {
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
 
+    _metrics.loopRate->set(_loopRate.rate());
+    _metrics.threads->set(_slavePool.numThreads());
+    _metrics.trailingMixRatio->set(_trailingMixRatio);
+    _metrics.throttlingRatio->set(_throttlingRatio);
+
 #ifdef DEBUG_EVENT_QUEUE
     QJsonObject qtStats;
 
@@ -782,6 +791,14 @@ void AvatarMixer::sendStatsPacket() {
     incomingPacketStats["handleAvatarQueryPacket"] = TIGHT_LOOP_STAT_UINT64(_handleViewFrustumPacketElapsedTime);
 
     singleCoreTasks["incoming_packets"] = incomingPacketStats;
+
+    _metrics.queueIncomingPacketTime->increment(_queueIncomingPacketElapsedTime);
+    _metrics.handleAvatarIdentityPacketTime->increment(_handleAvatarIdentityPacketElapsedTime);
+    _metrics.handleKillAvatarPacketTime->increment(_handleKillAvatarPacketElapsedTime);
+    _metrics.handleNodeIgnoreRequestPacketTime->increment(_handleNodeIgnoreRequestPacketElapsedTime);
+    _metrics.handleRadiusIgnoreRequestPacketTime->increment(_handleRadiusIgnoreRequestPacketElapsedTime);
+    _metrics.handleRequestsDomainListDataPacketTime->increment(_handleRequestsDomainListDataPacketElapsedTime);
+    _metrics.handleAvatarQueryPacketTime->increment(_handleViewFrustumPacketElapsedTime);
     singleCoreTasks["sendStats"] = (float)_sendStatsElapsedTime;
 
     statsObject["singleCoreTasks"] = singleCoreTasks;
@@ -819,6 +836,26 @@ void AvatarMixer::sendStatsPacket() {
         aggregateStats += stats;
     });
 
+    _metrics.packetsProcessed->increment(aggregateStats.packetsProcessed);
+    _metrics.dataBytesSent->increment(aggregateStats.numDataBytesSent);
+    _metrics.traitsBytesSent->increment(aggregateStats.numTraitsBytesSent);
+    _metrics.identityBytesSent->increment(aggregateStats.numIdentityBytesSent);
+    _metrics.dataPacketsSent->increment(aggregateStats.numDataPacketsSent);
+    _metrics.traitsPacketsSent->increment(aggregateStats.numTraitsPacketsSent);
+    _metrics.identityPacketsSent->increment(aggregateStats.numIdentityPacketsSent);
+    _metrics.nodesProcessed->increment(aggregateStats.nodesProcessed);
+    _metrics.nodesBroadcastedTo->increment(aggregateStats.nodesBroadcastedTo);
+    _metrics.downstreamMixersBroadcastedTo->increment(aggregateStats.downstreamMixersBroadcastedTo);
+    _metrics.othersIncluded->increment(aggregateStats.numOthersIncluded);
+    _metrics.overBudgetAvatars->increment(aggregateStats.overBudgetAvatars);
+    _metrics.heroesIncluded->increment(aggregateStats.numHeroesIncluded);
+    _metrics.processIncomingPacketsTime->increment(aggregateStats.processIncomingPacketsElapsedTime);
+    _metrics.ignoreCalculationTime->increment(aggregateStats.ignoreCalculationElapsedTime);
+    _metrics.toByteArrayTime->increment(aggregateStats.toByteArrayElapsedTime);
+    _metrics.avatarDataPackingTime->increment(aggregateStats.avatarDataPackingElapsedTime);
+    _metrics.packetSendingTime->increment(aggregateStats.packetSendingElapsedTime);
+    _metrics.jobTime->increment(aggregateStats.jobElapsedTime);
+
     QJsonObject slavesAggregatObject;
 
     slavesAggregatObject["received_1_nodesProcessed"] = TIGHT_LOOP_STAT(aggregateStats.nodesProcessed);
@@ -957,11 +994,97 @@ void AvatarMixer::domainSettingsRequestComplete() {
     parseDomainServerSettings(nodeList->getDomainHandler().getSettingsObject());
 
     setupEntityQuery();
+    setUpMetrics();
 
     // start our tight loop...
     start();
 }
 
+void AvatarMixer::setUpMetrics() {
+    if (!DependencyManager::isSet<MetricsRegistry>()) {
+        return;
+    }
+    auto registry = DependencyManager::get<MetricsRegistry>();
+
+    const QString STAGE_METRIC = "hifi_avatar_mixer_stage_microseconds";
+    const QString STAGE_HELP = "Time spent in each stage of the avatar mixer frame loop";
+    _metrics.processQueuedAvatarDataPacketsTime = registry->histogram(STAGE_METRIC, STAGE_HELP,
+        MetricsRegistry::label("stage", "process_queued_avatar_data_packets"));
+    _metrics.displayNameManagementTime = registry->histogram(STAGE_METRIC, STAGE_HELP,
+        MetricsRegistry::label("stage", "display_name_management"));
+    _metrics.broadcastAvatarDataTime = registry->histogram(STAGE_METRIC, STAGE_HELP,
+        MetricsRegistry::label("stage", "broadcast_avatar_data"));
+    _metrics.processEventsTime = registry->histogram(STAGE_METRIC, STAGE_HELP,
+        MetricsRegistry::label("stage", "process_events"));
+
+    _slaveSharedData.nodeBroadcastTime = registry->histogram("hifi_avatar_mixer_node_broadcast_microseconds",
+        "Time spent sending avatar data to each node, per frame");
+
+    _metrics.packetsProcessed = registry->counter("hifi_avatar_mixer_packets_processed_total",
+        "Avatar packets processed by the mixer slaves");
+
+    const QString BYTES_METRIC = "hifi_avatar_mixer_sent_bytes_total";
+    const QString BYTES_HELP = "Avatar bytes sent, by packet type";
+    _metrics.dataBytesSent = registry->counter(BYTES_METRIC, BYTES_HELP, MetricsRegistry::label("type", "data"));
+    _metrics.traitsBytesSent = registry->counter(BYTES_METRIC, BYTES_HELP, MetricsRegistry::label("type", "traits"));
+    _metrics.identityBytesSent = registry->counter(BYTES_METRIC, BYTES_HELP, MetricsRegistry::label("type", "identity"));
+
+    const QString PACKETS_METRIC = "hifi_avatar_mixer_sent_packets_total";
+    const QString PACKETS_HELP = "Avatar packets sent, by packet type";
+    _metrics.dataPacketsSent = registry->counter(PACKETS_METRIC, PACKETS_HELP, MetricsRegistry::label("type", "data"));
+    _metrics.traitsPacketsSent = registry->counter(PACKETS_METRIC, PACKETS_HELP, MetricsRegistry::label("type", "traits"));
+    _metrics.identityPacketsSent = registry->counter(PACKETS_METRIC, PACKETS_HELP,
+        MetricsRegistry::label("type", "identity"));
+
+    // the rest of the harvested slave stats, as totals rather than the per frame averages of the stats packet
+    _metrics.nodesProcessed = registry->counter("hifi_avatar_mixer_nodes_processed_total",
+        "Nodes whose queued avatar packets were processed, summed over frames");
+    _metrics.nodesBroadcastedTo = registry->counter("hifi_avatar_mixer_nodes_broadcasted_to_total",
+        "Nodes sent avatar data, summed over frames");
+    _metrics.downstreamMixersBroadcastedTo = registry->counter("hifi_avatar_mixer_downstream_mixers_broadcasted_to_total",
+        "Downstream mixers sent replicated avatar data, summed over frames");
+
+    const QString INCLUDED_METRIC = "hifi_avatar_mixer_avatars_considered_total";
+    const QString INCLUDED_HELP = "Other avatars considered for each node's broadcast, by outcome";
+    _metrics.othersIncluded = registry->counter(INCLUDED_METRIC, INCLUDED_HELP,
+        MetricsRegistry::label("outcome", "included"));
+    _metrics.overBudgetAvatars = registry->counter(INCLUDED_METRIC, INCLUDED_HELP,
+        MetricsRegistry::label("outcome", "over_budget"));
+    _metrics.heroesIncluded = registry->counter(INCLUDED_METRIC, INCLUDED_HELP,
+        MetricsRegistry::label("outcome", "hero"));
+
+    const QString SLAVE_TIME_METRIC = "hifi_avatar_mixer_slave_microseconds_total";
+    const QString SLAVE_TIME_HELP = "Time the mixer slaves spent in each task";
+    auto slaveTimeCounter = [&](const QString& task) {
+        return registry->counter(SLAVE_TIME_METRIC, SLAVE_TIME_HELP, MetricsRegistry::label("task", task));
+    };
+    _metrics.processIncomingPacketsTime = slaveTimeCounter("process_incoming_packets");
+    _metrics.ignoreCalculationTime = slaveTimeCounter("ignore_calculation");
+    _metrics.toByteArrayTime = slaveTimeCounter("to_byte_array");
+    _metrics.avatarDataPackingTime = slaveTimeCounter("avatar_data_packing");
+    _metrics.packetSendingTime = slaveTimeCounter("packet_sending");
+    _metrics.jobTime = slaveTimeCounter("job");
+
+    const QString HANDLER_TIME_METRIC = "hifi_avatar_mixer_packet_handler_microseconds_total";
+    const QString HANDLER_TIME_HELP = "Time the main thread spent handling each type of packet";
+    auto handlerTimeCounter = [&](const QString& handler) {
+        return registry->counter(HANDLER_TIME_METRIC, HANDLER_TIME_HELP, MetricsRegistry::label("handler", handler));
+    };
+    _metrics.queueIncomingPacketTime = handlerTimeCounter("queue_incoming_packet");
+    _metrics.handleAvatarIdentityPacketTime = handlerTimeCounter("avatar_identity");
+    _metrics.handleKillAvatarPacketTime = handlerTimeCounter("kill_avatar");
+    _metrics.handleNodeIgnoreRequestPacketTime = handlerTimeCounter("node_ignore_request");
+    _metrics.handleRadiusIgnoreRequestPacketTime = handlerTimeCounter("radius_ignore_request");
+    _metrics.handleRequestsDomainListDataPacketTime = handlerTimeCounter("requests_domain_list_data");
+    _metrics.handleAvatarQueryPacketTime = handlerTimeCounter("avatar_query");
+
+    _metrics.loopRate = registry->gauge("hifi_avatar_mixer_loop_rate", "Broadcast loop frames per second");
+    _metrics.threads = registry->gauge("hifi_avatar_mixer_threads", "Slave threads broadcasting");
+    _metrics.trailingMixRatio = registry->gauge("hifi_avatar_mixer_trailing_mix_ratio",
+        "Trailing ratio of time spent broadcasting to time available");
+    _metrics.throttlingRatio = registry->gauge("hifi_avatar_mixer_throttling_ratio", "Share of broadcasts throttled");
+}
+
 void AvatarMixer::handlePacketVersionMismatch(PacketType type, const HifiSockAddr& senderSockAddr, const QUuid& senderUUID) {
     // if this client is using packet versions we don't expect.
     if ((type == PacketTypeEnum::Value::AvatarIdentity || type == PacketTypeEnum::Value::AvatarData) && !senderUUID.isNull()) {
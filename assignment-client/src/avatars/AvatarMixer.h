@@ -17,6 +17,7 @@
 
 #include <set>
 #include <shared/RateCounter.h>
+#include <MetricsRegistry.h>
 #include <PortableHighResolutionClock.h>
 
 #include <ThreadedAssignment.h>
@@ -81,6 +82,7 @@ private:
     void optionallyReplicatePacket(ReceivedMessage& message, const Node& node);
 
     void setupEntityQuery();
+    void setUpMetrics();
 
     p_high_resolution_clock::time_point _lastFrameTimestamp;
 
@@ -151,6 +153,45 @@ private:
 
     RateCounter<> _loopRate; // this is the rate that the main thread tight loop runs
 
+    // main thread and slave timings, plus the slave and packet handler stats that sendStatsPacket() reports
+    struct Metrics {
+        std::shared_ptr<MetricHistogram> processQueuedAvatarDataPacketsTime { std::make_shared<MetricHistogram>() };
+        std::shared_ptr<MetricHistogram> displayNameManagementTime { std::make_shared<MetricHistogram>() };
+        std::shared_ptr<MetricHistogram> broadcastAvatarDataTime { std::make_shared<MetricHistogram>() };
+        std::shared_ptr<MetricHistogram> processEventsTime { std::make_shared<MetricHistogram>() };
+        std::shared_ptr<MetricCounter> packetsProcessed { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> dataBytesSent { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> traitsBytesSent { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> identityBytesSent { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> dataPacketsSent { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> traitsPacketsSent { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> identityPacketsSent { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> nodesProcessed { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> nodesBroadcastedTo { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> downstreamMixersBroadcastedTo { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> othersIncluded { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> overBudgetAvatars { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> heroesIncluded { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> processIncomingPacketsTime { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> ignoreCalculationTime { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> toByteArrayTime { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> avatarDataPackingTime { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> packetSendingTime { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> jobTime { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> queueIncomingPacketTime { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> handleAvatarIdentityPacketTime { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> handleKillAvatarPacketTime { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> handleNodeIgnoreRequestPacketTime { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> handleRadiusIgnoreRequestPacketTime { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> handleRequestsDomainListDataPacketTime { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> handleAvatarQueryPacketTime { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricGauge> loopRate { std::make_shared<MetricGauge>() };
+        std::shared_ptr<MetricGauge> threads { std::make_shared<MetricGauge>() };
+        std::shared_ptr<MetricGauge> trailingMixRatio { std::make_shared<MetricGauge>() };
+        std::shared_ptr<MetricGauge> throttlingRatio { std::make_shared<MetricGauge>() };
+    };
+    Metrics _metrics;
+
     AvatarMixerSlavePool _slavePool;
     SlaveSharedData _slaveSharedData;
 };
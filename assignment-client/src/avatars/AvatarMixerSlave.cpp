@@ -278,6 +278,7 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
 
     quint64 end = usecTimestampNow();
     _stats.jobElapsedTime += (end - start);
+    _sharedData->nodeBroadcastTime->record(end - start);
 }
 
 AABox computeBubbleBox(const AvatarData& avatar, float bubbleExpansionFactor) {
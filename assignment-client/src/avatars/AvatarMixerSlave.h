@@ -12,6 +12,7 @@
 #ifndef hifi_AvatarMixerSlave_h
 #define hifi_AvatarMixerSlave_h
 
+#include <MetricsRegistry.h>
 #include <NodeList.h>
 
 class AvatarMixerClientData;
@@ -100,6 +101,7 @@ struct SlaveSharedData {
     QStringList skeletonURLWhitelist;
     QUrl skeletonReplacementURL;
     EntityTreePointer entityTree;
+    std::shared_ptr<MetricHistogram> nodeBroadcastTime { std::make_shared<MetricHistogram>() };
 };
 
 class AvatarMixerSlave {
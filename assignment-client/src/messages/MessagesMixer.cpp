@@ -14,9 +14,14 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonObject>
 #include <QBuffer>
+
+#include <algorithm>
+
 #include <LogHandler.h>
 #include <MessagesClient.h>
 #include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 #include <udt/PacketHeaders.h>
 
 const QString MESSAGES_MIXER_LOGGING_NAME = "messages-mixer";
@@ -31,41 +36,59 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
 }
 
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
-    }
+    _channels.removeSubscriber(killedNode->getUUID());
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
-    QString channel, message;
-    QByteArray data;
-    QUuid senderID;
-    bool isText;
-    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
+    quint64 start = usecTimestampNow();
+
+    // a well formed message is forwarded exactly as it arrived, its payload shared by every recipient's packet list
+    QByteArray payload = receivedMessage->getMessage();
+    QByteArray channel;
+    if (!MessagesClient::decodeMessagesChannel(payload, channel)) {
+        // a truncated message is completed once, the same way decoding and encoding it again would for each recipient
+        QString channelString, message;
+        QByteArray data;
+        QUuid senderID;
+        bool isText;
+        MessagesClient::decodeMessagesPacket(receivedMessage, channelString, isText, message, data, senderID);
+        channel = channelString.toUtf8();
+        payload = MessagesClient::encodeMessagesPayload(channel, isText, isText ? message.toUtf8() : data, senderID);
+    }
+
+    auto channelID = _channels.find(channel);
+    if (channelID == MessagesChannelIndex::INVALID_CHANNEL) {
+        _channels.recordUnsubscribedMessage(payload.size());
+        _metrics.unsubscribedMessages->increment();
+        _metrics.receivedBytes->increment(payload.size());
+        return;
+    }
 
     auto nodeList = DependencyManager::get<NodeList>();
+    int numDeliveries = 0;
+    for (const auto& subscriberID : _channels.getSubscribers(channelID)) {
+        auto node = nodeList->nodeWithUUID(subscriberID);
+        if (node && node->getActiveSocket()) {
+            // each packet list still gets its own copy, since the packets carry per connection headers
+            nodeList->sendPacketList(MessagesClient::createMessagesPacketList(payload), *node);
+            ++numDeliveries;
+        }
+    }
+    _channels.recordMessage(channelID, payload.size(), numDeliveries);
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    _metrics.forwardedMessages->increment();
+    _metrics.deliveries->increment(numDeliveries);
+    _metrics.receivedBytes->increment(payload.size());
+    _metrics.sentBytes->increment((uint64_t)payload.size() * numDeliveries);
+    _metrics.forwardTime->record(usecTimestampNow() - start);
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
-    QString channel = QString::fromUtf8(message->getMessage());
-    _channelSubscribers[channel] << senderNode->getUUID();
+    _channels.subscribe(message->getMessage(), senderNode->getUUID());
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
-    QString channel = QString::fromUtf8(message->getMessage());
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderNode->getUUID());
-    }
+    _channels.unsubscribe(message->getMessage(), senderNode->getUUID());
 }
 
 void MessagesMixer::sendStatsPacket() {
@@ -81,6 +104,45 @@ void MessagesMixer::sendStatsPacket() {
     });
 
     statsObject["messages"] = messagesMixerObject;
+
+    // add stats for the busiest channels since the last stats packet
+    auto now = usecTimestampNow();
+    float seconds = _lastStatsTime > 0 ? (float)(now - _lastStatsTime) / (float)USECS_PER_SECOND : 0.0f;
+    _lastStatsTime = now;
+    if (seconds > 0.0f) {
+        const float BITS_PER_KILOBIT = 1000.0f;
+        std::vector<MessagesChannelIndex::ChannelID> busiest;
+        auto numSlots = (MessagesChannelIndex::ChannelID)_channels.getNumChannelSlots();
+        for (MessagesChannelIndex::ChannelID id = 0; id < numSlots; ++id) {
+            if (_channels.isLive(id) && _channels.getChannel(id).numMessages > 0) {
+                busiest.push_back(id);
+            }
+        }
+        const size_t MAX_REPORTED_CHANNELS = 32;
+        auto numReported = std::min(busiest.size(), MAX_REPORTED_CHANNELS);
+        std::partial_sort(busiest.begin(), busiest.begin() + numReported, busiest.end(),
+            [&](MessagesChannelIndex::ChannelID a, MessagesChannelIndex::ChannelID b) {
+                return _channels.getChannel(a).numBytesOut > _channels.getChannel(b).numBytesOut;
+            });
+
+        QJsonObject channelsObject;
+        for (size_t i = 0; i < numReported; ++i) {
+            const auto& channel = _channels.getChannel(busiest[i]);
+            QJsonObject channelStats;
+            channelStats["subscribers"] = (int)channel.subscribers.size();
+            channelStats["messages_per_second"] = (float)channel.numMessages / seconds;
+            channelStats["deliveries_per_second"] = (float)channel.numDeliveries / seconds;
+            channelStats["inbound_kbps"] = (float)(channel.numBytesIn * BITS_IN_BYTE) / BITS_PER_KILOBIT / seconds;
+            channelStats["outbound_kbps"] = (float)(channel.numBytesOut * BITS_IN_BYTE) / BITS_PER_KILOBIT / seconds;
+            channelsObject[QString::fromUtf8(channel.name)] = channelStats;
+        }
+        statsObject["channels"] = channelsObject;
+        statsObject["num_channels"] = (int)_channels.getNumChannels();
+        statsObject["unsubscribed_messages_per_second"] = (float)_channels.getNumUnsubscribedMessages() / seconds;
+    }
+    _channels.resetStats();
+    _metrics.channels->set(_channels.getNumChannels());
+
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
@@ -88,4 +150,28 @@ void MessagesMixer::run() {
     ThreadedAssignment::commonInit(MESSAGES_MIXER_LOGGING_NAME, NodeType::MessagesMixer);
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
+
+    setUpMetrics();
+}
+
+void MessagesMixer::setUpMetrics() {
+    if (!DependencyManager::isSet<MetricsRegistry>()) {
+        return;
+    }
+    auto registry = DependencyManager::get<MetricsRegistry>();
+
+    _metrics.forwardTime = registry->histogram("hifi_messages_mixer_forward_microseconds",
+        "Time spent forwarding a message to every subscriber of its channel");
+
+    const QString MESSAGES_METRIC = "hifi_messages_mixer_messages_total";
+    const QString MESSAGES_HELP = "Messages received, by whether the channel had subscribers";
+    _metrics.forwardedMessages = registry->counter(MESSAGES_METRIC, MESSAGES_HELP,
+        MetricsRegistry::label("state", "forwarded"));
+    _metrics.unsubscribedMessages = registry->counter(MESSAGES_METRIC, MESSAGES_HELP,
+        MetricsRegistry::label("state", "unsubscribed"));
+
+    _metrics.deliveries = registry->counter("hifi_messages_mixer_deliveries_total", "Messages sent to subscribers");
+    _metrics.receivedBytes = registry->counter("hifi_messages_mixer_received_bytes_total", "Message payload bytes received");
+    _metrics.sentBytes = registry->counter("hifi_messages_mixer_sent_bytes_total", "Message payload bytes sent");
+    _metrics.channels = registry->gauge("hifi_messages_mixer_channels", "Channels with subscribers");
 }
@@ -15,6 +15,8 @@
 #ifndef hifi_MessagesMixer_h
 #define hifi_MessagesMixer_h
 
+#include <MessagesChannelIndex.h>
+#include <MetricsRegistry.h>
 #include <ThreadedAssignment.h>
 
 /// Handles assignments of type MessagesMixer - distribution of avatar data to various clients
@@ -34,7 +36,22 @@ private slots:
     void handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
 private:
-    QHash<QString,QSet<QUuid>> _channelSubscribers;
+    void setUpMetrics();
+
+    MessagesChannelIndex _channels;
+    quint64 _lastStatsTime { 0 };
+
+    // message forwarding, traffic and channel count
+    struct Metrics {
+        std::shared_ptr<MetricHistogram> forwardTime { std::make_shared<MetricHistogram>() };
+        std::shared_ptr<MetricCounter> forwardedMessages { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> unsubscribedMessages { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> deliveries { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> receivedBytes { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricCounter> sentBytes { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricGauge> channels { std::make_shared<MetricGauge>() };
+    };
+    Metrics _metrics;
 };
 
 #endif // hifi_MessagesMixer_h
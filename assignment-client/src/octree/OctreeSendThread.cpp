@@ -40,6 +40,13 @@ OctreeSendThread::OctreeSendThread(OctreeServer* myServer, const SharedNodePoint
         safeServerName = _myServer->getMyServerName();
     }
 
+    if (DependencyManager::isSet<MetricsRegistry>()) {
+        _sendTime = DependencyManager::get<MetricsRegistry>()->histogram("hifi_octree_server_node_send_microseconds",
+            "Time spent sending octree data to a node in one pass", MetricsRegistry::label("server", safeServerName));
+    } else {
+        _sendTime = std::make_shared<MetricHistogram>();
+    }
+
     qDebug() << qPrintable(safeServerName)  << "server [" << _myServer << "]: client connected "
                                             "- starting sending thread [" << this << "]";
 
@@ -90,7 +97,9 @@ bool OctreeSendThread::process() {
             // then we can't send an entity data packet
             if (nodeData && nodeData->hasReceivedFirstQuery() && node->getActiveSocket() && !nodeData->isShuttingDown()) {
                 bool viewFrustumChanged = nodeData->updateCurrentViewFrustum();
+                quint64 sendStart = usecTimestampNow();
                 packetDistributor(node, nodeData, viewFrustumChanged);
+                _sendTime->record(usecTimestampNow() - sendStart);
             }
         } else {
             return false; // exit early if we're shutting down
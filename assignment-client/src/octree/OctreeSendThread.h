@@ -17,6 +17,7 @@
 #include <atomic>
 
 #include <GenericThread.h>
+#include <MetricsRegistry.h>
 #include <Node.h>
 #include <OctreePacketData.h>
 #include "OctreeQueryNode.h"
@@ -74,6 +75,8 @@ private:
     int _trueBytesSent { 0 }; // available for debug stats
     int _packetsSentThisInterval { 0 }; // used for bandwidth throttle condition
     bool _isShuttingDown { false };
+
+    std::shared_ptr<MetricHistogram> _sendTime; // of each packetDistributor pass, shared by the server's send threads
 };
 
 #endif // hifi_OctreeSendThread_h
@@ -0,0 +1,85 @@
+//
+//  EntityScriptEngineRouter.cpp
+//  assignment-client/src/scripts
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptEngineRouter.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+
+void EntityScriptEngineRouter::setEngines(std::vector<ScriptEnginePointer> engines, Affinity affinity) {
+    Lock lock(_mutex);
+    _engines = std::move(engines);
+    _affinity = affinity;
+    _entityEngines.clear();
+}
+
+std::vector<ScriptEnginePointer> EntityScriptEngineRouter::getEngines() const {
+    Lock lock(_mutex);
+    return _engines;
+}
+
+void EntityScriptEngineRouter::clear() {
+    Lock lock(_mutex);
+    _engines.clear();
+    _entityEngines.clear();
+}
+
+ScriptEnginePointer EntityScriptEngineRouter::getEngine(const EntityItemID& entityID) const {
+    Lock lock(_mutex);
+    auto it = _entityEngines.constFind(entityID);
+    return it != _entityEngines.constEnd() ? _engines[it.value()] : ScriptEnginePointer();
+}
+
+ScriptEnginePointer EntityScriptEngineRouter::assignEngine(const EntityItemID& entityID, const QString& scriptURL) {
+    Lock lock(_mutex);
+    if (_engines.empty()) {
+        return ScriptEnginePointer();
+    }
+
+    // hashing keeps an entity, or every entity with the same script, on the same engine across reloads
+    uint hash = _affinity == ScriptAffinity ? qHash(scriptURL) : qHash(entityID);
+    int index = (int)(hash % (uint)_engines.size());
+    _entityEngines[entityID] = index;
+    return _engines[index];
+}
+
+void EntityScriptEngineRouter::unassign(const EntityItemID& entityID) {
+    Lock lock(_mutex);
+    _entityEngines.remove(entityID);
+}
+
+QList<EntityItemID> EntityScriptEngineRouter::getAssignedEntities() const {
+    Lock lock(_mutex);
+    return _entityEngines.keys();
+}
+
+int EntityScriptEngineRouter::getNumRunningEntityScripts() const {
+    int numRunningScripts = 0;
+    for (const auto& engine : getEngines()) {
+        numRunningScripts += engine->getNumRunningEntityScripts();
+    }
+    return numRunningScripts;
+}
+
+void EntityScriptEngineRouter::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                      const QStringList& params, const QUuid& remoteCallerID) {
+    auto engine = getEngine(entityID);
+    if (engine) {
+        // queued onto the engine's thread if called from another one
+        engine->callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+    }
+}
+
+QFuture<QVariant> EntityScriptEngineRouter::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    auto engine = getEngine(entityID);
+    if (engine) {
+        return engine->getLocalEntityScriptDetails(entityID);
+    }
+    return QtConcurrent::run([] { return QVariant(); });
+}
@@ -0,0 +1,62 @@
+//
+//  EntityScriptEngineRouter.h
+//  assignment-client/src/scripts
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptEngineRouter_h
+#define hifi_EntityScriptEngineRouter_h
+
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QHash>
+
+#include <EntitiesScriptEngineProvider.h>
+#include <ScriptEngine.h>
+
+// Spreads entity scripts over a pool of script engines, each running on its own thread.
+//
+// Every entity is assigned an engine when its script is loaded, either by its ID or by its script URL so that
+// entities sharing a script share an engine.  Calls into an entity script are routed to the engine running it:
+// the engines queue calls made from other threads, so scripts on one engine can safely call methods of entities
+// running on another.
+class EntityScriptEngineRouter : public EntitiesScriptEngineProvider {
+public:
+    enum Affinity {
+        EntityAffinity,
+        ScriptAffinity
+    };
+
+    void setEngines(std::vector<ScriptEnginePointer> engines, Affinity affinity);
+    std::vector<ScriptEnginePointer> getEngines() const;
+    /// \brief forget the engines and the entities assigned to them
+    void clear();
+
+    /// \return the engine the entity is assigned to, null if it has none
+    ScriptEnginePointer getEngine(const EntityItemID& entityID) const;
+    /// \return the engine that should run the entity's script, which it is now assigned to
+    ScriptEnginePointer assignEngine(const EntityItemID& entityID, const QString& scriptURL);
+    void unassign(const EntityItemID& entityID);
+    QList<EntityItemID> getAssignedEntities() const;
+
+    int getNumRunningEntityScripts() const;
+
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const QStringList& params = QStringList(), const QUuid& remoteCallerID = QUuid()) override;
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+
+private:
+    using Lock = std::lock_guard<std::mutex>;
+
+    mutable std::mutex _mutex;
+    std::vector<ScriptEnginePointer> _engines;
+    Affinity _affinity { EntityAffinity };
+    QHash<EntityItemID, int> _entityEngines; // index into _engines, by entity
+};
+
+#endif // hifi_EntityScriptEngineRouter_h
@@ -13,6 +13,15 @@
 
 #include <mutex>
 
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QThread>
+
 #include <AudioConstants.h>
 #include <AudioInjectorManager.h>
 #include <ClientServerUtils.h>
@@ -21,6 +30,7 @@
 #include <EntityScriptingInterface.h>
 #include <LogHandler.h>
 #include <MessagesClient.h>
+#include <PathUtils.h>
 #include <plugins/CodecPlugin.h>
 #include <plugins/PluginManager.h>
 #include <ResourceManager.h>
@@ -52,6 +62,27 @@ void messageHandler(QtMsgType type, const QMessageLogContext& context, const QSt
     }
 }
 
+// in usecs, for per engine CPU usage stats
+static quint64 currentThreadCPUTime() {
+#ifdef Q_OS_WIN
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0;
+    }
+    // FILETIMEs are in 100ns intervals
+    auto toUsecs = [](const FILETIME& time) {
+        return (((quint64)time.dwHighDateTime << 32) | time.dwLowDateTime) / 10;
+    };
+    return toUsecs(kernelTime) + toUsecs(userTime);
+#else
+    timespec time;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+        return 0;
+    }
+    return (quint64)time.tv_sec * USECS_PER_SECOND + (quint64)time.tv_nsec / NSECS_PER_USEC;
+#endif
+}
+
 int EntityScriptServer::_entitiesScriptEngineCount = 0;
 
 EntityScriptServer::EntityScriptServer(ReceivedMessage& message) : ThreadedAssignment(message) {
@@ -75,7 +106,7 @@ EntityScriptServer::EntityScriptServer(ReceivedMessage& message) : ThreadedAssig
     DependencyManager::set<SoundCacheScriptingInterface>();
     DependencyManager::set<AudioInjectorManager>();
 
-    DependencyManager::set<ScriptCache>();
+    DependencyManager::set<ScriptCache>()->setDiskCacheDirectory(PathUtils::getAppLocalDataFilePath("scriptCache"));
 
 
     // Needed to ensure the creation of the DebugDraw instance on the main thread
@@ -127,7 +158,8 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        auto engine = _entitiesScriptEngines->getEngine(entityID);
+        if (engine && engine->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -169,10 +201,37 @@ void EntityScriptServer::handleSettings() {
 
     qDebug() << QString("Received entity script server settings, Max Entity PPS: %1, Entity PPS Per Entity Script: %2")
                 .arg(_maxEntityPPS).arg(_entityPPSPerScript);
+
+    static const QString NUM_SCRIPT_ENGINES_OPTION = "num_script_engines";
+    static const QString SCRIPT_ENGINE_AFFINITY_OPTION = "script_engine_affinity";
+
+    int numScriptEngines = entityScriptServerSettings[NUM_SCRIPT_ENGINES_OPTION].toInt(1);
+    {
+        int maxScriptEngines = QThread::idealThreadCount();
+        if (maxScriptEngines == -1) {
+            // idealThreadCount returns -1 if cores cannot be detected
+            static const int MAX_SCRIPT_ENGINES_IF_UNKNOWN = 4;
+            maxScriptEngines = MAX_SCRIPT_ENGINES_IF_UNKNOWN;
+        }
+        // 0 is one engine per core
+        numScriptEngines = numScriptEngines <= 0 ? maxScriptEngines : std::min(numScriptEngines, maxScriptEngines);
+    }
+
+    auto scriptEngineAffinity = entityScriptServerSettings[SCRIPT_ENGINE_AFFINITY_OPTION].toString() == "script" ?
+        EntityScriptEngineRouter::ScriptAffinity : EntityScriptEngineRouter::EntityAffinity;
+
+    if (numScriptEngines != _numScriptEngines || scriptEngineAffinity != _scriptEngineAffinity) {
+        _numScriptEngines = numScriptEngines;
+        _scriptEngineAffinity = scriptEngineAffinity;
+
+        qCDebug(entity_script_server) << "Running entity scripts on" << _numScriptEngines << "script engines, by"
+            << (_scriptEngineAffinity == EntityScriptEngineRouter::ScriptAffinity ? "script" : "entity");
+        reassignEntityScripts();
+    }
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    int numRunningScripts = _entitiesScriptEngines->getNumRunningEntityScripts();
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplication would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -233,7 +292,7 @@ void EntityScriptServer::pushLogs() {
 
 void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
 
-    if (_entitiesScriptEngine && _entityViewer.getTree() && !_shuttingDown) {
+    if (_entityViewer.getTree() && !_shuttingDown) {
         auto entityID = QUuid::fromRfc4122(receivedMessage->read(NUM_BYTES_RFC4122_UUID));
 
         auto method = receivedMessage->readString();
@@ -247,7 +306,8 @@ void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<Recei
             params << paramString;
         }
 
-        _entitiesScriptEngine->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
+        // queued onto the thread of the engine running the entity's script
+        _entitiesScriptEngines->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
     }
 }
 
@@ -277,8 +337,8 @@ void EntityScriptServer::run() {
         NodeType::EntityServer, NodeType::MessagesMixer, NodeType::AssetServer
     });
 
-    // Setup Script Engine
-    resetEntitiesScriptEngine();
+    // Setup Script Engines
+    resetEntitiesScriptEngines();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     entityScriptingInterface->init();
@@ -433,63 +493,100 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
-    auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
-    auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
+void EntityScriptServer::resetEntitiesScriptEngines() {
+    std::vector<ScriptEnginePointer> newEngines;
+    std::vector<std::shared_ptr<ScriptEngineStats>> newStats;
+    for (int i = 0; i < _numScriptEngines; ++i) {
+        auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
+        auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
+
+        auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
+        newEngine->globalObject().setProperty("WebSocketServer", webSocketServerConstructorValue);
+
+        newEngine->registerGlobalObject("SoundCache", DependencyManager::get<SoundCacheScriptingInterface>().data());
+
+        // connect this script engines printedMessage signal to the global ScriptEngines these various messages
+        auto scriptEngines = DependencyManager::get<ScriptEngines>().data();
+        connect(newEngine.data(), &ScriptEngine::printedMessage, scriptEngines, &ScriptEngines::onPrintedMessage);
+        connect(newEngine.data(), &ScriptEngine::errorMessage, scriptEngines, &ScriptEngines::onErrorMessage);
+        connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
+        connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
+
+        // the tree only needs updating once a frame, not once per engine
+        if (newEngines.empty()) {
+            connect(newEngine.data(), &ScriptEngine::update, this, [this] {
+                _entityViewer.queryOctree();
+                _entityViewer.getTree()->update();
+            });
+        }
 
-    auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
-    newEngine->globalObject().setProperty("WebSocketServer", webSocketServerConstructorValue);
+        connect(newEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
+                this, &EntityScriptServer::updateEntityPPS);
 
-    newEngine->registerGlobalObject("SoundCache", DependencyManager::get<SoundCacheScriptingInterface>().data());
+        auto stats = std::make_shared<ScriptEngineStats>();
+        setUpScriptEngineMetrics(*stats, (int)newEngines.size());
+        newEngine->setTimerDispatchLagHistogram(stats->timerDispatchLagMetric);
 
-    // connect this script engines printedMessage signal to the global ScriptEngines these various messages
-    auto scriptEngines = DependencyManager::get<ScriptEngines>().data();
-    connect(newEngine.data(), &ScriptEngine::printedMessage, scriptEngines, &ScriptEngines::onPrintedMessage);
-    connect(newEngine.data(), &ScriptEngine::errorMessage, scriptEngines, &ScriptEngines::onErrorMessage);
-    connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
-    connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
+        newEngine->runInThread();
+        newEngines.push_back(newEngine);
+        newStats.push_back(stats);
+    }
 
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
-        _entityViewer.queryOctree();
-        _entityViewer.getTree()->update();
-    });
+    _scriptEngineStats = newStats;
 
+    _entitiesScriptEngines->setEngines(newEngines, _scriptEngineAffinity);
+    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(_entitiesScriptEngines);
+}
 
-    newEngine->runInThread();
-    auto newEngineSP = qSharedPointerCast<EntitiesScriptEngineProvider>(newEngine);
-    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(newEngineSP);
+void EntityScriptServer::stopEntitiesScriptEngines() {
+    auto engines = _entitiesScriptEngines->getEngines();
+    _entitiesScriptEngines->clear();
+    _scriptEngineStats.clear();
 
-    if (_entitiesScriptEngine) {
-        disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
+    for (auto& engine : engines) {
+        disconnect(engine.data(), &ScriptEngine::entityScriptDetailsUpdated,
                    this, &EntityScriptServer::updateEntityPPS);
+
+        // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
+        engine->unloadAllEntityScripts();
+        engine->stop();
     }
 
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-            this, &EntityScriptServer::updateEntityPPS);
+    // stop them all before waiting on any, so they wind down in parallel
+    for (auto& engine : engines) {
+        engine->waitTillDoneRunning();
+    }
 }
 
-
 void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
-        // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
-        _entitiesScriptEngine->waitTillDoneRunning();
-    }
+    // unload and stop the engines
+    stopEntitiesScriptEngines();
 
     _entityViewer.clear();
 
-    // reset the engine
+    // reset the engines
     if (!_shuttingDown) {
-        resetEntitiesScriptEngine();
+        resetEntitiesScriptEngines();
+    }
+}
+
+void EntityScriptServer::reassignEntityScripts() {
+    if (_shuttingDown || !_entityViewer.getTree()) {
+        return;
+    }
+
+    // restart every running script on the new set of engines, keeping the entity tree
+    auto entityIDs = _entitiesScriptEngines->getAssignedEntities();
+    stopEntitiesScriptEngines();
+    resetEntitiesScriptEngines();
+    for (const auto& entityID : entityIDs) {
+        checkAndCallPreload(entityID);
     }
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    for (auto& engine : _entitiesScriptEngines->getEngines()) {
+        engine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
     }
     _shuttingDown = true;
 
@@ -498,9 +595,8 @@ void EntityScriptServer::shutdownScriptEngine() {
     auto scriptEngines = DependencyManager::get<ScriptEngines>();
     scriptEngines->shutdownScripting();
 
-    _entitiesScriptEngine.clear();
-
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+    entityScriptingInterface->setEntitiesScriptEngine(nullptr);
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
     entityScriptingInterface->setEntityTree(nullptr);
 
@@ -516,8 +612,12 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown) {
+        auto engine = _entitiesScriptEngines->getEngine(entityID);
+        if (engine) {
+            engine->unloadEntityScript(entityID, true);
+            _entitiesScriptEngines->unassign(entityID);
+        }
     }
 }
 
@@ -528,27 +628,132 @@ void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, bool forceRedownload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    if (_entityViewer.getTree() && !_shuttingDown) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool isRunning = _entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        auto engine = _entitiesScriptEngines->getEngine(entityID);
+        bool isRunning = engine && engine->getEntityScriptDetails(entityID, details);
         if (entity && (forceRedownload || !isRunning || details.scriptText != entity->getServerScripts())) {
             if (isRunning) {
-                _entitiesScriptEngine->unloadEntityScript(entityID, true);
+                engine->unloadEntityScript(entityID, true);
             }
+            _entitiesScriptEngines->unassign(entityID);
 
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = DependencyManager::get<ResourceManager>()->normalizeURL(scriptUrl);
-                _entitiesScriptEngine->loadEntityScript(entityID, scriptUrl, forceRedownload);
+                // the script may belong on another engine than before if it changed
+                engine = _entitiesScriptEngines->assignEngine(entityID, scriptUrl);
+                if (engine) {
+                    engine->loadEntityScript(entityID, scriptUrl, forceRedownload);
+                }
             }
         }
     }
 }
 
+void EntityScriptServer::setUpScriptEngineMetrics(ScriptEngineStats& stats, int engineIndex) {
+    if (!DependencyManager::isSet<MetricsRegistry>()) {
+        return;
+    }
+    auto registry = DependencyManager::get<MetricsRegistry>();
+
+    // labelled by index rather than engine name, so the series carry on when the engines are replaced
+    auto engine = MetricsRegistry::label("engine", QString::number(engineIndex));
+    stats.eventLoopLatencyMetric = registry->histogram("hifi_entity_script_server_event_loop_latency_microseconds",
+        "Time for a queued event to run on a script engine, sampled once per stats interval", engine);
+    stats.timerDispatchLagMetric = registry->histogram("hifi_entity_script_server_timer_lag_microseconds",
+        "Time from a script timer's deadline to its callback running", engine);
+    stats.timerCallbacksMetric = registry->counter("hifi_entity_script_server_timer_callbacks_total",
+        "Script timer callbacks run", engine);
+    stats.cpuUsageMetric = registry->gauge("hifi_entity_script_server_cpu_ratio",
+        "Share of a core a script engine used between the last two probes", engine);
+    stats.runningScriptsMetric = registry->gauge("hifi_entity_script_server_running_scripts",
+        "Entity scripts running on a script engine", engine);
+    stats.timersMetric = registry->gauge("hifi_entity_script_server_timers", "Script timers pending", engine);
+
+    const QString LOAD_METRIC = "hifi_entity_script_server_script_load_microseconds";
+    const QString LOAD_HELP = "Time a script engine has spent loading its scripts, by stage";
+    stats.fetchTimeMetric = registry->gauge(LOAD_METRIC, LOAD_HELP, engine + "," + MetricsRegistry::label("stage", "fetch"));
+    stats.compileTimeMetric = registry->gauge(LOAD_METRIC, LOAD_HELP,
+                                              engine + "," + MetricsRegistry::label("stage", "compile"));
+    stats.evaluateTimeMetric = registry->gauge(LOAD_METRIC, LOAD_HELP,
+                                               engine + "," + MetricsRegistry::label("stage", "evaluate"));
+}
+
+void EntityScriptServer::probeScriptEngine(const ScriptEnginePointer& engine,
+                                           const std::shared_ptr<ScriptEngineStats>& stats) {
+    // a queued call runs once the engine gets back to its event loop, which is how late its timers,
+    // signals and entity method calls are running
+    quint64 queuedTime = usecTimestampNow();
+    QTimer::singleShot(0, engine.data(), [stats, queuedTime] {
+        quint64 now = usecTimestampNow();
+        quint64 cpuTime = currentThreadCPUTime();
+        stats->eventLoopLatency = now - queuedTime;
+        stats->eventLoopLatencyMetric->record(now - queuedTime);
+        if (stats->lastProbeTime > 0 && now > stats->lastProbeTime) {
+            stats->cpuUsage = (float)(cpuTime - stats->lastCPUTime) / (float)(now - stats->lastProbeTime);
+        }
+        stats->lastProbeTime = now;
+        stats->lastCPUTime = cpuTime;
+    });
+}
+
 void EntityScriptServer::sendStatsPacket() {
+    static const quint64 SLOW_EVENT_LOOP_USECS = 100 * USECS_PER_MSEC;
+    static const int LOG_STATS_EVERY_N_PACKETS = 60;
+    bool logStats = (++_numStatsPackets % LOG_STATS_EVERY_N_PACKETS) == 0;
+
+    QJsonObject scriptEnginesStats;
+    auto engines = _entitiesScriptEngines->getEngines();
+    for (size_t i = 0; i < engines.size() && i < _scriptEngineStats.size(); ++i) {
+        const auto& engine = engines[i];
+        const auto& stats = _scriptEngineStats[i];
+
+        // these are from the previous probe, a busy engine may not have run this one yet
+        quint64 eventLoopLatency = stats->eventLoopLatency;
+        float cpuUsage = stats->cpuUsage;
+        int numRunningScripts = engine->getNumRunningEntityScripts();
+        auto timerStats = engine->takeTimerStats();
+        auto loadStats = engine->getLoadStats();
+
+        QJsonObject engineStats;
+        engineStats["running_scripts"] = numRunningScripts;
+        engineStats["event_loop_latency_usecs"] = (double)eventLoopLatency;
+        engineStats["cpu_percent"] = cpuUsage * 100.0f;
+        engineStats["timers"] = timerStats.numTimers;
+        engineStats["timer_callbacks"] = (double)timerStats.numDispatched;
+        engineStats["timer_dispatch_lag_usecs"] = (double)timerStats.averageDispatchLag;
+        engineStats["timer_dispatch_lag_max_usecs"] = (double)timerStats.maxDispatchLag;
+        engineStats["script_fetch_usecs"] = (double)loadStats.fetchTime;
+        engineStats["script_compile_usecs"] = (double)loadStats.compileTime;
+        engineStats["script_evaluate_usecs"] = (double)loadStats.evaluateTime;
+        scriptEnginesStats[QString("engine_%1").arg(i)] = engineStats;
+
+        stats->cpuUsageMetric->set(cpuUsage);
+        stats->runningScriptsMetric->set(numRunningScripts);
+        stats->timersMetric->set(timerStats.numTimers);
+        stats->timerCallbacksMetric->increment(timerStats.numDispatched);
+        stats->fetchTimeMetric->set((double)loadStats.fetchTime);
+        stats->compileTimeMetric->set((double)loadStats.compileTime);
+        stats->evaluateTimeMetric->set((double)loadStats.evaluateTime);
+
+        if (eventLoopLatency > SLOW_EVENT_LOOP_USECS) {
+            qCWarning(entity_script_server) << "Script engine" << i << "is running events" << eventLoopLatency / USECS_PER_MSEC
+                << "ms late with" << numRunningScripts << "scripts at" << cpuUsage * 100.0f << "% CPU";
+        } else if (logStats) {
+            qCDebug(entity_script_server) << "Script engine" << i << ":" << numRunningScripts << "scripts,"
+                << cpuUsage * 100.0f << "% CPU," << eventLoopLatency << "usecs event loop latency,"
+                << timerStats.numTimers << "timers," << timerStats.maxDispatchLag << "usecs max timer lag";
+        }
+
+        probeScriptEngine(engine, stats);
+    }
 
+    QJsonObject statsObject;
+    statsObject["script_engines"] = scriptEnginesStats;
+    addPacketStatsAndSendStatsPacket(statsObject);
 }
 
 void EntityScriptServer::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -12,6 +12,8 @@
 #ifndef hifi_EntityScriptServer_h
 #define hifi_EntityScriptServer_h
 
+#include <atomic>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -19,10 +21,12 @@
 #include <QtCore/QUuid>
 
 #include <EntityEditPacketSender.h>
+#include <MetricsRegistry.h>
 #include <plugins/CodecPlugin.h>
 #include <ScriptEngine.h>
 #include <ThreadedAssignment.h>
 #include "../entities/EntityTreeHeadlessViewer.h"
+#include "EntityScriptEngineRouter.h"
 
 class EntityScriptServer : public ThreadedAssignment {
     Q_OBJECT
@@ -60,9 +64,11 @@ private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
-    void resetEntitiesScriptEngine();
+    void resetEntitiesScriptEngines();
+    void stopEntitiesScriptEngines();
     void clear();
     void shutdownScriptEngine();
+    void reassignEntityScripts();
 
     void addingEntity(const EntityItemID& entityID);
     void deletingEntity(const EntityItemID& entityID);
@@ -73,8 +79,34 @@ private:
 
     bool _shuttingDown { false };
 
+    struct ScriptEngineStats {
+        std::atomic<quint64> eventLoopLatency { 0 }; // usecs for a queued event to run, at the last probe
+        std::atomic<float> cpuUsage { 0.0f }; // of one core, between the last two probes
+
+        // only used on the engine's thread
+        quint64 lastProbeTime { 0 };
+        quint64 lastCPUTime { 0 };
+
+        // this engine's stats as registered by setUpScriptEngineMetrics(), labelled with its index
+        std::shared_ptr<MetricHistogram> eventLoopLatencyMetric { std::make_shared<MetricHistogram>() };
+        std::shared_ptr<MetricHistogram> timerDispatchLagMetric { std::make_shared<MetricHistogram>() };
+        std::shared_ptr<MetricCounter> timerCallbacksMetric { std::make_shared<MetricCounter>() };
+        std::shared_ptr<MetricGauge> cpuUsageMetric { std::make_shared<MetricGauge>() };
+        std::shared_ptr<MetricGauge> runningScriptsMetric { std::make_shared<MetricGauge>() };
+        std::shared_ptr<MetricGauge> timersMetric { std::make_shared<MetricGauge>() };
+        std::shared_ptr<MetricGauge> fetchTimeMetric { std::make_shared<MetricGauge>() };
+        std::shared_ptr<MetricGauge> compileTimeMetric { std::make_shared<MetricGauge>() };
+        std::shared_ptr<MetricGauge> evaluateTimeMetric { std::make_shared<MetricGauge>() };
+    };
+    void setUpScriptEngineMetrics(ScriptEngineStats& stats, int engineIndex);
+    void probeScriptEngine(const ScriptEnginePointer& engine, const std::shared_ptr<ScriptEngineStats>& stats);
+
     static int _entitiesScriptEngineCount;
-    ScriptEnginePointer _entitiesScriptEngine;
+    QSharedPointer<EntityScriptEngineRouter> _entitiesScriptEngines { QSharedPointer<EntityScriptEngineRouter>::create() };
+    std::vector<std::shared_ptr<ScriptEngineStats>> _scriptEngineStats; // in the same order as the engines
+    int _numScriptEngines { 1 };
+    EntityScriptEngineRouter::Affinity _scriptEngineAffinity { EntityScriptEngineRouter::EntityAffinity };
+    int _numStatsPackets { 0 };
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
 
@@ -114,7 +114,7 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
 
         // guard against patched agents asking to hear about other agents
         auto safeInterestSet = nodeConnection.interestList.toSet();
-        if (nodeConnection.nodeType == NodeType::Agent) {
+        if (nodeConnection.nodeType == NodeType::Agent && !DomainServer::_agentsHearAgents) {
             safeInterestSet.remove(NodeType::Agent);
         }
 
@@ -262,7 +262,7 @@ NodePermissions DomainGatekeeper::setPermissionsForUser(bool isLocalUser, QStrin
 void DomainGatekeeper::updateNodePermissions() {
     // If the permissions were changed on the domain-server webpage (and nothing else was), a restart isn't required --
     // we reprocess the permissions map and update the nodes here.  The node list is frequently sent out to all
-    // the connected nodes, so these changes are propagated to other nodes.
+    // the connected nodes, so nodes whose permissions change here go out to the other nodes with the next domain list.
 
     QList<SharedNodePointer> nodesToKill;
 
@@ -309,6 +309,9 @@ void DomainGatekeeper::updateNodePermissions() {
             userPerms = setPermissionsForUser(isLocalUser, verifiedUsername, connectingAddr.getAddress(), hardwareAddress, machineFingerprint);
         }
 
+        if (node->getPermissions().permissions != userPerms.permissions) {
+            _server->domainListChanged(node);
+        }
         node->setPermissions(userPerms);
 
         if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
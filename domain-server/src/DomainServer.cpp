@@ -81,6 +81,7 @@ QUuid DomainServer::_overridingDomainID;
 bool DomainServer::_getTempName { false };
 QString DomainServer::_userConfigFilename;
 int DomainServer::_parentPID { -1 };
+bool DomainServer::_agentsHearAgents { false };
 
 bool DomainServer::forwardMetaverseAPIRequest(HTTPConnection* connection,
                                               const QString& metaversePath,
@@ -350,6 +351,9 @@ void DomainServer::parseCommandLine(int argc, char* argv[]) {
     const QCommandLineOption parentPIDOption(PARENT_PID_OPTION, "PID of the parent process", "parent-pid");
     parser.addOption(parentPIDOption);
 
+    const QCommandLineOption agentsHearAgentsOption("agents-hear-agents",
+                                                    "Let agents hear about other agents, for load tests like domain-churn");
+    parser.addOption(agentsHearAgentsOption);
 
     QStringList arguments;
     for (int i = 0; i < argc; ++i) {
@@ -411,6 +415,11 @@ void DomainServer::parseCommandLine(int argc, char* argv[]) {
             qDebug() << "Parent process PID is" << _parentPID;
         }
     }
+
+    if (parser.isSet(agentsHearAgentsOption)) {
+        _agentsHearAgents = true;
+        qDebug() << "Agents may hear about other agents";
+    }
 }
 
 DomainServer::~DomainServer() {
@@ -1052,8 +1061,12 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     NodeConnectionData nodeRequestData = NodeConnectionData::fromDataStream(packetStream, message->getSenderSockAddr(), false);
 
     // update this node's sockets in case they have changed
-    sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
-    sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+    if (sendingNode->getPublicSocket() != nodeRequestData.publicSockAddr ||
+        sendingNode->getLocalSocket() != nodeRequestData.localSockAddr) {
+        sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
+        sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+        domainListChanged(sendingNode);
+    }
 
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
 
@@ -1066,12 +1079,17 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
 
     // guard against patched agents asking to hear about other agents
     auto safeInterestSet = nodeRequestData.interestList.toSet();
-    if (sendingNode->getType() == NodeType::Agent) {
+    if (sendingNode->getType() == NodeType::Agent && !_agentsHearAgents) {
         safeInterestSet.remove(NodeType::Agent);
     }
 
     // update the NodeInterestSet in case there have been any changes
-    nodeData->setNodeInterestSet(safeInterestSet);
+    // if it did change the node needs the full list, since it hasn't heard about the nodes it is newly interested in
+    quint64 knownDomainListEpoch = nodeRequestData.domainListEpoch;
+    if (nodeData->getNodeInterestSet() != safeInterestSet) {
+        nodeData->setNodeInterestSet(safeInterestSet);
+        knownDomainListEpoch = 0;
+    }
 
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
@@ -1079,7 +1097,8 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // client-side send time of last connect/domain list request
     nodeData->setLastDomainCheckinTimestamp(nodeRequestData.lastPingTimestamp);
 
-    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false);
+    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false,
+                         knownDomainListEpoch);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -1157,11 +1176,50 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 reques
         newNode->setIsReplicated(true);
     }
 
+    domainListChanged(newNode);
+
     // send out this node to our other connected nodes
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr &senderSockAddr, bool newConnection) {
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr &senderSockAddr,
+                                        bool newConnection, quint64 knownDomainListEpoch) {
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
+    // a node that is caught up to an epoch we still have the changes for only needs to hear about those changes
+    bool isDelta = knownDomainListEpoch >= _oldestDeltaEpoch && knownDomainListEpoch <= _domainListEpoch;
+    quint64 baseDomainListEpoch = isDelta ? knownDomainListEpoch : 0;
+
+    // gather the nodes this node needs to hear about before writing anything, so the record count can go in the header
+    std::vector<SharedNodePointer> changedNodes;
+    std::vector<QUuid> removedNodes;
+    if (nodeData->getNodeInterestSet().size() > 0 && nodeData->isAuthenticated()) {
+        // if this authenticated node has any interest types, send back those nodes as well
+        if (isDelta) {
+            QSet<QUuid> seenNodes;
+            for (auto it = _domainListChanges.rbegin(); it != _domainListChanges.rend() && it->epoch > knownDomainListEpoch; ++it) {
+                if (it->nodeUUID == node->getUUID() || !nodeData->getNodeInterestSet().contains(it->nodeType) ||
+                    seenNodes.contains(it->nodeUUID)) {
+                    continue;
+                }
+                seenNodes.insert(it->nodeUUID);
+                SharedNodePointer otherNode = limitedNodeList->nodeWithUUID(it->nodeUUID);
+                if (otherNode) {
+                    changedNodes.push_back(otherNode);
+                } else {
+                    removedNodes.push_back(it->nodeUUID);
+                }
+            }
+        } else {
+            limitedNodeList->eachNode([this, node, &changedNodes](const SharedNodePointer& otherNode) {
+                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
+                    changedNodes.push_back(otherNode);
+                }
+            });
+        }
+    }
+
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID +
         NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4;
 
@@ -1169,8 +1227,6 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     // this data is at the beginning of each of the domain list packets
     QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
     QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
-    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
-    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << limitedNodeList->getSessionLocalID();
@@ -1182,35 +1238,36 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
     extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
     extendedHeaderStream << newConnection;
+
+    // the node moves up to _domainListEpoch once it has every record of this list, which may span several packets
+    extendedHeaderStream << baseDomainListEpoch;
+    extendedHeaderStream << _domainListEpoch;
+    extendedHeaderStream << quint32(changedNodes.size() + removedNodes.size());
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
     // always send the node their own UUID back
     QDataStream domainListStream(domainListPackets.get());
 
-    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
-    auto& nodeInterestSet = nodeData->getNodeInterestSet();
-
-    if (nodeInterestSet.size() > 0) {
+    quint32 recordIndex = 0;
+    for (auto& otherNode : changedNodes) {
+        // since we're about to add a node to the packet we start a segment
+        domainListPackets->startSegment();
 
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([this, node, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+        domainListStream << recordIndex++ << quint8(LimitedNodeList::DomainListNode);
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+        // don't send avatar nodes to other avatars, that will come from avatar mixer
+        domainListStream << *otherNode.data();
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+        // pack the secret that these two nodes will use to communicate with each other
+        domainListStream << connectionSecretForNodes(node, otherNode);
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
-                }
-            });
-        }
+        // we've added the node we wanted so end the segment now
+        domainListPackets->endSegment();
+    }
+    for (auto& removedUUID : removedNodes) {
+        domainListPackets->startSegment();
+        domainListStream << recordIndex++ << quint8(LimitedNodeList::DomainListRemovedNode) << removedUUID;
+        domainListPackets->endSegment();
     }
 
     // send an empty list to the node, in case there were no other nodes
@@ -1220,6 +1277,19 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
 }
 
+void DomainServer::domainListChanged(const SharedNodePointer& node) {
+    const size_t MAX_DOMAIN_LIST_CHANGES = 4096;
+
+    ++_domainListEpoch;
+    _domainListChanges.push_back({ _domainListEpoch, node->getUUID(), node->getType() });
+
+    // nodes that haven't caught up to the changes we drop here will get the full list on their next check in
+    while (_domainListChanges.size() > MAX_DOMAIN_LIST_CHANGES) {
+        _oldestDeltaEpoch = _domainListChanges.front().epoch;
+        _domainListChanges.pop_front();
+    }
+}
+
 QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
     DomainServerNodeData* nodeAData = static_cast<DomainServerNodeData*>(nodeA->getLinkedData());
     DomainServerNodeData* nodeBData = static_cast<DomainServerNodeData*>(nodeB->getLinkedData());
@@ -3101,6 +3171,7 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
         }
     }
 
+    domainListChanged(node);
     broadcastNodeDisconnect(node);
 }
 
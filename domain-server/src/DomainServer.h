@@ -12,6 +12,8 @@
 #ifndef hifi_DomainServer_h
 #define hifi_DomainServer_h
 
+#include <deque>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QHash>
 #include <QtCore/QJsonObject>
@@ -173,7 +175,11 @@ private:
     void handleKillNode(SharedNodePointer nodeToKill);
     void broadcastNodeDisconnect(const SharedNodePointer& disconnnectedNode);
 
-    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr& senderSockAddr, bool newConnection);
+    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr& senderSockAddr,
+                              bool newConnection, quint64 knownDomainListEpoch = 0);
+
+    // records that a node was added, removed or changed so it goes out in the next domain list deltas
+    void domainListChanged(const SharedNodePointer& node);
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
@@ -279,6 +285,7 @@ private:
     static bool _getTempName;
     static QString _userConfigFilename;
     static int _parentPID;
+    static bool _agentsHearAgents; // should we let agents ask to hear about other agents?
 
     bool _sendICEServerAddressToMetaverseAPIInProgress { false };
     bool _sendICEServerAddressToMetaverseAPIRedo { false };
@@ -291,6 +298,18 @@ private:
     std::unordered_map<int, std::unique_ptr<QTemporaryFile>> _pendingContentFiles;
 
     QThread _assetClientThread;
+
+    // Every change to the node list bumps the domain list epoch.  Nodes tell us the last epoch they have fully received
+    // with each DomainListRequest and we send them only the nodes that changed since then, unless they have fallen
+    // further behind than the change log goes back, in which case they get the full list.
+    struct DomainListChange {
+        quint64 epoch;
+        QUuid nodeUUID;
+        NodeType_t nodeType;
+    };
+    quint64 _domainListEpoch { 1 };
+    quint64 _oldestDeltaEpoch { 1 };
+    std::deque<DomainListChange> _domainListChanges;
 };
 
 
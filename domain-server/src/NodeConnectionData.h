@@ -33,6 +33,7 @@ public:
     QUuid machineFingerprint;
     quint32 connectReason;
     quint64 previousConnectionUpTime;
+    quint64 domainListEpoch { 0 }; // last domain list epoch the node has fully received
 
     QByteArray protocolVersion;
 };
@@ -71,6 +71,10 @@ Item {
                     StatText {
                         text: "Physics Object Count: " + root.physicsObjectCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "    Contacts: " + root.physicsContactCount + " (" + root.physicsContactUpdateTime.toFixed(2) + " ms)"
+                    }
                     StatText {
                         visible: root.expanded
                         text: root.gameUpdateStats
@@ -131,6 +135,16 @@ Item {
                         visible: root.expanded
                         text: "Avatars NOT Updated: " + root.notUpdatedAvatarCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Avatar Anim LOD High/Med/Low: " + root.highAnimationLODAvatarCount + "/" +
+                            root.mediumAnimationLODAvatarCount + "/" + root.lowAnimationLODAvatarCount
+                    }
+                    StatText {
+                        visible: root.expanded
+                        text: "Avatar Anim LOD ms: " + root.highAnimationLODTime.toFixed(2) + "/" +
+                            root.mediumAnimationLODTime.toFixed(2) + "/" + root.lowAnimationLODTime.toFixed(2)
+                    }
                     StatText {
                         visible: root.expanded
                         text: "Total picks:\n    " +
@@ -134,6 +134,7 @@
 #include <ScriptCache.h>
 #include <ShapeEntityItem.h>
 #include <SoundCacheScriptingInterface.h>
+#include <SpatiallyNestable.h>
 #include <ui/TabletScriptingInterface.h>
 #include <ui/ToolbarScriptingInterface.h>
 #include <Tooltip.h>
@@ -2668,6 +2669,7 @@ void Application::cleanupBeforeQuit() {
     QString webengineRemoteDebugging = QProcessEnvironment::systemEnvironment().value("QTWEBENGINE_REMOTE_DEBUGGING", "false");
     qCDebug(interfaceapp) << "QTWEBENGINE_REMOTE_DEBUGGING =" << webengineRemoteDebugging;
 
+    SpatiallyNestable::setBatchedTransformUpdates(false);
     DependencyManager::prepareToExit();
 
     if (tracing::enabled()) {
@@ -5501,6 +5503,9 @@ void Application::init() {
     ObjectMotionState::setShapeManager(&_shapeManager);
     _physicsEngine->init();
 
+    // entities and avatars that moved get their world transforms recomputed once a frame in update()
+    SpatiallyNestable::setBatchedTransformUpdates(true);
+
     EntityTreePointer tree = getEntities()->getTree();
     _entitySimulation->init(tree, _physicsEngine, &_entityEditSender);
     tree->setSimulation(_entitySimulation);
@@ -6575,6 +6580,25 @@ void Application::update(float deltaTime) {
         }
     }
 
+    {
+        // everything has moved for this frame, so the world transforms of what moved are worked out once here
+        // rather than over and over up the parent chains by whatever asks for them first
+        PerformanceTimer perfTimer("worldTransforms");
+        SpatiallyNestable::updateWorldTransforms();
+    }
+
+    {
+        // entity load priorities fall off with distance from the avatar, so once it has moved far enough the queued
+        // downloads are reordered the next time one starts
+        const float LOAD_PRIORITY_REFRESH_DISTANCE = 2.0f; // meters
+        auto avatarPosition = getMyAvatar()->getWorldPosition();
+        if (glm::distance(avatarPosition, _lastLoadPriorityPosition) > LOAD_PRIORITY_REFRESH_DISTANCE &&
+                ResourceCache::getPendingRequestCount() > 0) {
+            _lastLoadPriorityPosition = avatarPosition;
+            ResourceCache::invalidateLoadPriorities();
+        }
+    }
+
     bool showWarnings = Menu::getInstance()->isOptionChecked(MenuOption::PipelineWarnings);
     PerformanceWarning warn(showWarnings, "Application::update()");
 
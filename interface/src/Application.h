@@ -822,6 +822,7 @@ private:
     void endHMDSession();
 
     glm::vec3 _thirdPersonHMDCameraBoom { 0.0f, 0.0f, -1.0f };
+    glm::vec3 _lastLoadPriorityPosition;
     bool _thirdPersonHMDCameraBoomValid { true };
 
     QUrl _avatarOverrideUrl;
@@ -55,6 +55,28 @@
 // We add _myAvatar into the hash with all the other AvatarData, and we use the default NULL QUid as the key.
 const QUuid MY_AVATAR_KEY;  // NULL key
 
+// Remote avatars update their joints less often, and skip the face and the hand flow, the further down the update
+// order they rank and the smaller they look from every view.  Heroes are always animated in full.
+const int MAX_HIGH_ANIMATION_LOD_RANK = 16;
+const int MAX_MEDIUM_ANIMATION_LOD_RANK = 48;
+const float MIN_HIGH_ANIMATION_LOD_ANGULAR_SIZE = 0.05f; // a one meter radius at 20 meters
+const float MIN_MEDIUM_ANIMATION_LOD_ANGULAR_SIZE = 0.02f; // a one meter radius at 50 meters
+
+static OtherAvatar::AnimationLOD computeAnimationLOD(const ConicalViewFrustums& views, const OtherAvatar& avatar, int rank) {
+    float angularSize = 0.0f;
+    for (const auto& view : views) {
+        float distance = glm::distance(view.getPosition(), avatar.getWorldPosition());
+        angularSize = std::max(angularSize, view.getAngularSize(distance, avatar.getBoundingRadius()));
+    }
+    if (rank < MAX_HIGH_ANIMATION_LOD_RANK && angularSize >= MIN_HIGH_ANIMATION_LOD_ANGULAR_SIZE) {
+        return OtherAvatar::AnimationHigh;
+    }
+    if (rank < MAX_MEDIUM_ANIMATION_LOD_RANK && angularSize >= MIN_MEDIUM_ANIMATION_LOD_ANGULAR_SIZE) {
+        return OtherAvatar::AnimationMedium;
+    }
+    return OtherAvatar::AnimationLow;
+}
+
 AvatarManager::AvatarManager(QObject* parent) :
     _myAvatar(new MyAvatar(qApp->thread()), [](MyAvatar* ptr) { ptr->deleteLater(); })
 {
@@ -292,6 +314,9 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     int numHerosUpdated = 0;
     int numAvatarsUpdated = 0;
     int numAvatarsNotUpdated = 0;
+    int numAvatarsAtAnimationLOD[OtherAvatar::NumAnimationLODs] = { 0, 0, 0 };
+    uint64_t animationLODSimulationTime[OtherAvatar::NumAnimationLODs] = { 0, 0, 0 };
+    int animationRank = 0; // across both queues, in the order they are simulated
 
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
@@ -331,17 +356,29 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
             if (now < passExpiry) {
                 // we're within budget
                 bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
-                if (inView && avatar->hasNewJointData()) {
-                    numAvatarsUpdated++;
-                }
+                // the animation LOD may hold the new joints back for a later frame
+                bool hadNewJointData = inView && avatar->hasNewJointData();
                 auto transitStatus = avatar->_transit.update(deltaTime, avatar->_serverPosition, _transitConfig);
                 if (avatar->getIsNewAvatar() && (transitStatus == AvatarTransit::Status::START_TRANSIT ||
                                                  transitStatus == AvatarTransit::Status::ABORT_TRANSIT)) {
                     avatar->_transit.reset();
                     avatar->setIsNewAvatar(false);
                 }
+                // heroes always animate fully, but take their places in the budget ahead of everyone else
+                auto animationLOD = p == kHero ? OtherAvatar::AnimationHigh : computeAnimationLOD(views, *avatar, animationRank);
+                ++animationRank;
+                avatar->setAnimationLOD(animationLOD);
+                uint64_t simulateStart = usecTimestampNow();
                 avatar->simulate(deltaTime, inView);
-                if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
+                if (hadNewJointData && !avatar->hasNewJointData()) {
+                    numAvatarsUpdated++;
+                }
+                if (inView) {
+                    ++numAvatarsAtAnimationLOD[animationLOD];
+                    animationLODSimulationTime[animationLOD] += usecTimestampNow() - simulateStart;
+                }
+                if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1 &&
+                    animationLOD == OtherAvatar::AnimationHigh) {
                     _myAvatar->addAvatarHandsToFlow(avatar);
                 }
                 if (_drawOtherAvatarSkeletons) {
@@ -395,6 +432,10 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     _numAvatarsUpdated = numAvatarsUpdated;
     _numAvatarsNotUpdated = numAvatarsNotUpdated;
     _numHeroAvatarsUpdated = numHerosUpdated;
+    for (int lod = 0; lod < OtherAvatar::NumAnimationLODs; ++lod) {
+        _numAvatarsAtAnimationLOD[lod] = numAvatarsAtAnimationLOD[lod];
+        _animationLODSimulationTime[lod] = (float)animationLODSimulationTime[lod] / (float)USECS_PER_MSEC;
+    }
 
     _avatarSimulationTime = (float)(usecTimestampNow() - startTime) / (float)USECS_PER_MSEC;
 }
@@ -119,6 +119,10 @@ public:
     int getNumHeroAvatarsUpdated() const { return _numHeroAvatarsUpdated; }
     float getAvatarSimulationTime() const { return _avatarSimulationTime; }
 
+    // of the avatars simulated in view last frame
+    int getNumAvatarsAtAnimationLOD(OtherAvatar::AnimationLOD lod) const { return _numAvatarsAtAnimationLOD[lod]; }
+    float getAnimationLODSimulationTime(OtherAvatar::AnimationLOD lod) const { return _animationLODSimulationTime[lod]; } // msecs
+
     void updateMyAvatar(float deltaTime);
     void updateOtherAvatars(float deltaTime);
 
@@ -305,6 +309,8 @@ private:
     int _numHeroAvatars{ 0 };
     int _numHeroAvatarsUpdated{ 0 };
     float _avatarSimulationTime { 0.0f };
+    int _numAvatarsAtAnimationLOD[OtherAvatar::NumAnimationLODs] { 0, 0, 0 };
+    float _animationLODSimulationTime[OtherAvatar::NumAnimationLODs] { 0.0f, 0.0f, 0.0f };
     bool _shouldRender { true };
     bool _myAvatarDataPacketsPaused { false };
 
@@ -21,6 +21,9 @@
 const float DISPLAYNAME_FADE_TIME = 0.5f;
 const float DISPLAYNAME_FADE_FACTOR = pow(0.01f, 1.0f / DISPLAYNAME_FADE_TIME);
 
+// the least time between joint updates at each animation LOD, in seconds
+const float ANIMATION_LOD_JOINT_UPDATE_PERIODS[OtherAvatar::NumAnimationLODs] = { 0.0f, 1.0f / 20.0f, 1.0f / 8.0f };
+
 static glm::u8vec3 getLoadingOrbColor(Avatar::LoadingStatus loadingStatus) {
 
     const glm::u8vec3 NO_MODEL_COLOR(0xe3, 0xe3, 0xe3);
@@ -257,9 +260,12 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
     PerformanceTimer perfTimer("simulate");
     {
         PROFILE_RANGE(simulation, "updateJoints");
+        _timeSinceJointUpdate += deltaTime;
         if (inView) {
             Head* head = getHead();
-            if (_hasNewJointData || _transit.isActive()) {
+            bool needsJointUpdate = _hasNewJointData || _transit.isActive();
+            if (needsJointUpdate && _timeSinceJointUpdate >= ANIMATION_LOD_JOINT_UPDATE_PERIODS[_animationLOD]) {
+                _timeSinceJointUpdate = 0.0f;
                 _skeletonModel->getRig().copyJointsFromJointData(_jointData);
                 glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
                 _skeletonModel->getRig().computeExternalPoses(rootTransform);
@@ -275,9 +281,14 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
                     headPosition = getWorldPosition();
                 }
                 head->setPosition(headPosition);
+            } else if (needsJointUpdate) {
+                // the joints hold their pose until the next update is due, but the body keeps following the avatar
+                _skeletonModel->simulate(deltaTime, false);
             }
             head->setScale(getModelScale());
-            head->simulate(deltaTime);
+            if (_animationLOD != AnimationLOD::AnimationLow) {
+                head->simulate(deltaTime);
+            }
             relayJointDataToChildren();
         } else {
             // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
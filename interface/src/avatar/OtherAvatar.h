@@ -32,6 +32,13 @@ public:
         MultiSphereHigh // All joints
     };
 
+    enum AnimationLOD {
+        AnimationHigh = 0, // Joints every frame, with flow on the hands
+        AnimationMedium, // Joints at a reduced rate
+        AnimationLow, // Joints at a low rate, no face
+        NumAnimationLODs
+    };
+
     virtual void instantiableAvatar() override { };
     virtual void createOrb() override;
     virtual void indicateLoadingStatus(LoadingStatus loadingStatus) override;
@@ -63,6 +70,9 @@ public:
 
     void setCollisionWithOtherAvatarsFlags() override;
 
+    void setAnimationLOD(AnimationLOD lod) { _animationLOD = lod; }
+    AnimationLOD getAnimationLOD() const { return _animationLOD; }
+
     void simulate(float deltaTime, bool inView) override;
     void debugJointData() const;
     friend AvatarManager;
@@ -90,6 +100,8 @@ protected:
     int32_t _spaceIndex { -1 };
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
+    AnimationLOD _animationLOD { AnimationLOD::AnimationHigh };
+    float _timeSinceJointUpdate { 0.0f };
     bool _needsDetailedRebuild { false };
 };
 
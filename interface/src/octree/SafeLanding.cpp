@@ -10,6 +10,7 @@
 //
 
 #include "SafeLanding.h"
+#include <ResourceCache.h>
 #include <SharedUtil.h>
 
 #include "EntityTreeRenderer.h"
@@ -53,6 +54,7 @@ void SafeLanding::startEntitySequence(QSharedPointer<EntityTreeRenderer> entityT
             _initialEnd = INVALID_SEQUENCE;
             _startTime = usecTimestampNow();
             EntityTreeRenderer::setEntityLoadingPriorityFunction(&ElevatedPriority);
+            ResourceCache::invalidateLoadPriorities();
         }
     }
 }
@@ -120,6 +122,7 @@ bool SafeLanding::isLoadSequenceComplete() {
         _entityTreeRenderer.clear();
         _trackingEntities = false; // Don't track anything else that comes in.
         EntityTreeRenderer::setEntityLoadingPriorityFunction(StandardPriority);
+        ResourceCache::invalidateLoadPriorities();
     }
 
     return !_trackingEntities;
@@ -127,6 +127,11 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(avatarCount, avatarManager->size() - 1);
     STAT_UPDATE(heroAvatarCount, avatarManager->getNumHeroAvatars());
     STAT_UPDATE(physicsObjectCount, qApp->getNumCollisionObjects());
+    auto physicsEngine = qApp->getPhysicsEngine();
+    if (physicsEngine) {
+        STAT_UPDATE(physicsContactCount, (int)physicsEngine->getNumContacts());
+        STAT_UPDATE_FLOAT(physicsContactUpdateTime, (float)physicsEngine->getContactUpdateTime() / (float)USECS_PER_MSEC, 0.01f);
+    }
     STAT_UPDATE(updatedAvatarCount, avatarManager->getNumAvatarsUpdated());
     STAT_UPDATE(updatedHeroAvatarCount, avatarManager->getNumHeroAvatarsUpdated());
     STAT_UPDATE(notUpdatedAvatarCount, avatarManager->getNumAvatarsNotUpdated());
@@ -387,6 +392,12 @@ void Stats::updateStats(bool force) {
     auto config = qApp->getRenderEngine()->getConfiguration().get();
     STAT_UPDATE(engineFrameTime, (float) config->getCPURunTime());
     STAT_UPDATE(avatarSimulationTime, (float)avatarManager->getAvatarSimulationTime());
+    STAT_UPDATE(highAnimationLODAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(OtherAvatar::AnimationHigh));
+    STAT_UPDATE(mediumAnimationLODAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(OtherAvatar::AnimationMedium));
+    STAT_UPDATE(lowAnimationLODAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(OtherAvatar::AnimationLow));
+    STAT_UPDATE_FLOAT(highAnimationLODTime, avatarManager->getAnimationLODSimulationTime(OtherAvatar::AnimationHigh), 0.01f);
+    STAT_UPDATE_FLOAT(mediumAnimationLODTime, avatarManager->getAnimationLODSimulationTime(OtherAvatar::AnimationMedium), 0.01f);
+    STAT_UPDATE_FLOAT(lowAnimationLODTime, avatarManager->getAnimationLODSimulationTime(OtherAvatar::AnimationLow), 0.01f);
 
     if (_expanded) {
         STAT_UPDATE(gpuBuffers, (int)gpu::Context::getBufferGPUCount());
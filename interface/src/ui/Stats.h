@@ -52,6 +52,8 @@ private: \
  * @property {number} avatarCount - <em>Read-only.</em>
  * @property {number} heroAvatarCount - <em>Read-only.</em>
  * @property {number} physicsObjectCount - <em>Read-only.</em>
+ * @property {number} physicsContactCount - <em>Read-only.</em>
+ * @property {number} physicsContactUpdateTime - <em>Read-only.</em>
  * @property {number} updatedAvatarCount - <em>Read-only.</em>
  * @property {number} updatedHeroAvatarCount - <em>Read-only.</em>
  * @property {number} notUpdatedAvatarCount - <em>Read-only.</em>
@@ -141,6 +143,12 @@ private: \
  * @property {number} batchFrameTime - <em>Read-only.</em>
  * @property {number} engineFrameTime - <em>Read-only.</em>
  * @property {number} avatarSimulationTime - <em>Read-only.</em>
+ * @property {number} highAnimationLODAvatarCount - <em>Read-only.</em>
+ * @property {number} mediumAnimationLODAvatarCount - <em>Read-only.</em>
+ * @property {number} lowAnimationLODAvatarCount - <em>Read-only.</em>
+ * @property {number} highAnimationLODTime - <em>Read-only.</em>
+ * @property {number} mediumAnimationLODTime - <em>Read-only.</em>
+ * @property {number} lowAnimationLODTime - <em>Read-only.</em>
  *
  *
  * @property {number} x
@@ -216,6 +224,8 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QString, uxMode, QString())
     STATS_PROPERTY(int, heroAvatarCount, 0)
     STATS_PROPERTY(int, physicsObjectCount, 0)
+    STATS_PROPERTY(int, physicsContactCount, 0)
+    STATS_PROPERTY(float, physicsContactUpdateTime, 0)
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, updatedHeroAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
@@ -308,6 +318,12 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(float, batchFrameTime, 0)
     STATS_PROPERTY(float, engineFrameTime, 0)
     STATS_PROPERTY(float, avatarSimulationTime, 0)
+    STATS_PROPERTY(int, highAnimationLODAvatarCount, 0)
+    STATS_PROPERTY(int, mediumAnimationLODAvatarCount, 0)
+    STATS_PROPERTY(int, lowAnimationLODAvatarCount, 0)
+    STATS_PROPERTY(float, highAnimationLODTime, 0)
+    STATS_PROPERTY(float, mediumAnimationLODTime, 0)
+    STATS_PROPERTY(float, lowAnimationLODTime, 0)
 
     STATS_PROPERTY(int, stylusPicksCount, 0)
     STATS_PROPERTY(int, rayPicksCount, 0)
@@ -454,6 +470,20 @@ signals:
      */
     void physicsObjectCountChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>physicsContactCount</code> property changes.
+     * @function Stats.physicsContactCountChanged
+     * @returns {Signal}
+     */
+    void physicsContactCountChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>physicsContactUpdateTime</code> property changes.
+     * @function Stats.physicsContactUpdateTimeChanged
+     * @returns {Signal}
+     */
+    void physicsContactUpdateTimeChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>avatarCount</code> property changes.
      * @function Stats.avatarCountChanged
@@ -1086,6 +1116,48 @@ signals:
      */
     void avatarSimulationTimeChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>highAnimationLODAvatarCount</code> property changes.
+     * @function Stats.highAnimationLODAvatarCountChanged
+     * @returns {Signal}
+     */
+    void highAnimationLODAvatarCountChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>highAnimationLODTime</code> property changes.
+     * @function Stats.highAnimationLODTimeChanged
+     * @returns {Signal}
+     */
+    void highAnimationLODTimeChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>mediumAnimationLODAvatarCount</code> property changes.
+     * @function Stats.mediumAnimationLODAvatarCountChanged
+     * @returns {Signal}
+     */
+    void mediumAnimationLODAvatarCountChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>mediumAnimationLODTime</code> property changes.
+     * @function Stats.mediumAnimationLODTimeChanged
+     * @returns {Signal}
+     */
+    void mediumAnimationLODTimeChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>lowAnimationLODAvatarCount</code> property changes.
+     * @function Stats.lowAnimationLODAvatarCountChanged
+     * @returns {Signal}
+     */
+    void lowAnimationLODAvatarCountChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>lowAnimationLODTime</code> property changes.
+     * @function Stats.lowAnimationLODTimeChanged
+     * @returns {Signal}
+     */
+    void lowAnimationLODTimeChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>rectifiedTextureCount</code> property changes.
      * @function Stats.rectifiedTextureCountChanged
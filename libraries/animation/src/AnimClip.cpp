@@ -49,10 +49,10 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
         _networkAnim.reset();
     }
 
-    if (_anim.size()) {
+    if (_clipData && !_poses.empty() && _clipData->getNumJoints() == (int)_poses.size()) {
 
         // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
+        if (_mirrorFlag && !_mirrorClipData) {
             buildMirrorAnim();
         }
 
@@ -66,15 +66,22 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = _clipData->getNumFrames();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
+        const AnimClipData& clipData = _mirrorFlag ? *_mirrorClipData : *_clipData;
         float alpha = glm::fract(_frame);
 
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        if (nextIndex == prevIndex || nextIndex == prevIndex + 1) {
+            // the tracks interpolate between neighbouring frames themselves
+            clipData.sample((float)prevIndex + (nextIndex == prevIndex ? 0.0f : alpha), &_poses[0]);
+        } else {
+            _nextPoses.resize(_poses.size());
+            clipData.sample((float)prevIndex, &_poses[0]);
+            clipData.sample((float)nextIndex, &_nextPoses[0]);
+            ::blend(_poses.size(), &_poses[0], &_nextPoses[0], alpha, &_poses[0]);
+        }
     }
 
     processOutputJoints(triggersOut);
@@ -109,19 +116,32 @@ static std::vector<int> buildJointIndexMap(const AnimSkeleton& dstSkeleton, cons
 
 void AnimClip::copyFromNetworkAnim() {
     assert(_networkAnim && _networkAnim->isLoaded() && _skeleton);
-    _anim.clear();
 
     auto avatarSkeleton = getSkeleton();
+    const int avatarJointCount = avatarSkeleton->getNumJoints();
+    _poses.resize(avatarJointCount);
+
+    // mirrorAnim will be re-built on demand, if needed.
+    _mirrorClipData.reset();
+
+    // another avatar with the same skeleton may have retargeted this animation already
+    _skeletonHash = AnimClipData::hashSkeleton(*avatarSkeleton);
+    _clipData = AnimClipData::find(_url, _skeletonHash, false);
+    if (_clipData) {
+        return;
+    }
+
     const HFMModel& animModel = _networkAnim->getHFMModel();
     AnimSkeleton animSkeleton(animModel);
     const int animJointCount = animSkeleton.getNumJoints();
-    const int avatarJointCount = avatarSkeleton->getNumJoints();
 
     // build a mapping from animation joint indices to avatar joint indices by matching joints with the same name.
     std::vector<int> avatarToAnimJointIndexMap = buildJointIndexMap(animSkeleton, *avatarSkeleton);
 
-    const int animFrameCount = animModel.animationFrames.size();
-    _anim.resize(animFrameCount);
+    const int animFrameCount = std::min(animModel.animationFrames.size(), (int)AnimClipData::MAX_FRAMES);
+
+    // anim[frame][joint]
+    std::vector<AnimPoseVec> anim(animFrameCount);
 
     // find the size scale factor for translation in the animation.
     float boneLengthScale = 1.0f;
@@ -201,7 +221,7 @@ void AnimClip::copyFromNetworkAnim() {
         // convert avatar rotations into relative frame
         avatarSkeleton->convertAbsoluteRotationsToRelative(avatarRotations);
 
-        _anim[frame].reserve(avatarJointCount);
+        anim[frame].reserve(avatarJointCount);
         for (int avatarJointIndex = 0; avatarJointIndex < avatarJointCount; avatarJointIndex++) {
             const AnimPose& avatarDefaultPose = avatarSkeleton->getRelativeDefaultPose(avatarJointIndex);
 
@@ -224,25 +244,29 @@ void AnimClip::copyFromNetworkAnim() {
             }
 
             // build the final pose
-            _anim[frame].push_back(AnimPose(relativeScale, avatarRotations[avatarJointIndex], relativeTranslation));
+            anim[frame].push_back(AnimPose(relativeScale, avatarRotations[avatarJointIndex], relativeTranslation));
         }
     }
 
-    // mirrorAnim will be re-built on demand, if needed.
-    _mirrorAnim.clear();
-
-    _poses.resize(avatarJointCount);
+    _clipData = AnimClipData::share(_url, _skeletonHash, false, std::make_shared<AnimClipData>(anim));
 }
 
 void AnimClip::buildMirrorAnim() {
-    assert(_skeleton);
+    assert(_skeleton && _clipData);
+
+    _mirrorClipData = AnimClipData::find(_url, _skeletonHash, true);
+    if (_mirrorClipData) {
+        return;
+    }
 
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
+    int frameCount = _clipData->getNumFrames();
+    std::vector<AnimPoseVec> mirrorAnim(frameCount);
+    for (int frame = 0; frame < frameCount; frame++) {
+        mirrorAnim[frame].resize(_clipData->getNumJoints());
+        _clipData->sample((float)frame, &mirrorAnim[frame][0]);
+        _skeleton->mirrorRelativePoses(mirrorAnim[frame]);
     }
+    _mirrorClipData = AnimClipData::share(_url, _skeletonHash, true, std::make_shared<AnimClipData>(mirrorAnim));
 }
 
 const AnimPoseVec& AnimClip::getPosesInternal() const {
@@ -13,6 +13,7 @@
 
 #include <string>
 #include "AnimationCache.h"
+#include "AnimClipData.h"
 #include "AnimNode.h"
 
 // Playback a single animation timeline.
@@ -24,6 +25,7 @@
 class AnimClip : public AnimNode {
 public:
     friend class AnimTests;
+    friend class AnimPerfTests;
 
     AnimClip(const QString& id, const QString& url, float startFrame, float endFrame, float timeScale, bool loopFlag, bool mirrorFlag);
     virtual ~AnimClip() override;
@@ -67,9 +69,11 @@ protected:
     AnimationPointer _networkAnim;
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // shared with every other clip playing _url on the same skeleton
+    AnimClipData::Pointer _clipData;
+    AnimClipData::Pointer _mirrorClipData;
+    uint64_t _skeletonHash { 0 };
+    AnimPoseVec _nextPoses; // only used when looping back to the start frame
 
     QString _url;
     float _startFrame;
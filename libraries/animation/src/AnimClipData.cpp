@@ -0,0 +1,314 @@
+//
+//  AnimClipData.cpp
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimClipData.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include <QtCore/QHash>
+
+#include <GLMHelpers.h>
+
+#include "AnimSkeleton.h"
+#include "AnimUtil.h"
+
+// the largest error linear interpolation between keys may leave
+static const float ROTATION_TOLERANCE = 0.001f; // radians
+static const float VECTOR_RELATIVE_TOLERANCE = 0.001f; // of the largest value on the track
+static const float MIN_VECTOR_TOLERANCE = 0.0001f;
+
+// bounds the work of finding the keys
+static const int MAX_KEY_SPAN = 64;
+
+// the three smallest components of a unit quaternion are within +/- sqrt(1/2)
+static const float SMALLEST_THREE_RANGE = 0.70710678f;
+static const uint16_t ROTATION_COMPONENT_MAX = 0x7fff;
+static const uint16_t VECTOR_COMPONENT_MAX = 0xffff;
+
+static uint16_t quantize(float value, float min, float extent, uint16_t maxValue) {
+    if (extent <= 0.0f) {
+        return 0;
+    }
+    float normalized = glm::clamp((value - min) / extent, 0.0f, 1.0f);
+    return (uint16_t)(normalized * maxValue + 0.5f);
+}
+
+static float dequantize(uint16_t value, float min, float extent, uint16_t maxValue) {
+    return min + extent * ((float)value / (float)maxValue);
+}
+
+// the largest component is dropped and rebuilt from the others, with its index in the top bits of the first two
+static void packRotation(const glm::quat& rotation, uint16_t* values) {
+    float components[4] = { rotation.x, rotation.y, rotation.z, rotation.w };
+    int largest = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (fabsf(components[i]) > fabsf(components[largest])) {
+            largest = i;
+        }
+    }
+    // q and -q are the same rotation, so the dropped component is made positive
+    float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+    int j = 0;
+    for (int i = 0; i < 4; ++i) {
+        if (i != largest) {
+            values[j++] = quantize(sign * components[i], -SMALLEST_THREE_RANGE, 2.0f * SMALLEST_THREE_RANGE, ROTATION_COMPONENT_MAX);
+        }
+    }
+    values[0] |= (uint16_t)((largest & 1) << 15);
+    values[1] |= (uint16_t)((largest >> 1) << 15);
+}
+
+static glm::quat unpackRotation(const uint16_t* values) {
+    int largest = (values[0] >> 15) | ((values[1] >> 15) << 1);
+    float components[4];
+    float sumOfSquares = 0.0f;
+    int j = 0;
+    for (int i = 0; i < 4; ++i) {
+        if (i != largest) {
+            float component = dequantize(values[j++] & ROTATION_COMPONENT_MAX, -SMALLEST_THREE_RANGE,
+                                         2.0f * SMALLEST_THREE_RANGE, ROTATION_COMPONENT_MAX);
+            components[i] = component;
+            sumOfSquares += component * component;
+        }
+    }
+    components[largest] = sqrtf(std::max(0.0f, 1.0f - sumOfSquares));
+    return glm::normalize(glm::quat(components[3], components[0], components[1], components[2]));
+}
+
+// the angle between two rotations, from the chord rather than acos of the dot product, which is too coarse for small angles
+static float rotationError(const glm::quat& a, const glm::quat& b) {
+    glm::quat chord = glm::dot(a, b) < 0.0f ? a + b : a - b;
+    return 4.0f * asinf(std::min(0.5f * glm::length(chord), 1.0f));
+}
+
+// The frames a track has to keep for linear interpolation between them to stay within tolerance of every frame
+template <typename T, typename Lerp, typename Error>
+static std::vector<int> reduceKeys(const std::vector<T>& values, float tolerance, Lerp lerp, Error error) {
+    int numFrames = (int)values.size();
+    std::vector<int> keys { 0 };
+
+    bool still = true;
+    for (int i = 1; i < numFrames && still; ++i) {
+        still = error(values[i], values[0]) <= tolerance;
+    }
+    if (still) {
+        return keys;
+    }
+
+    auto spans = [&](int start, int end) {
+        for (int i = start + 1; i < end; ++i) {
+            float alpha = (float)(i - start) / (float)(end - start);
+            if (error(lerp(values[start], values[end], alpha), values[i]) > tolerance) {
+                return false;
+            }
+        }
+        return true;
+    };
+    int start = 0;
+    while (start < numFrames - 1) {
+        int end = start + 1;
+        while (end + 1 < numFrames && end + 1 - start <= MAX_KEY_SPAN && spans(start, end + 1)) {
+            ++end;
+        }
+        keys.push_back(end);
+        start = end;
+    }
+    return keys;
+}
+
+static void computeRange(const std::vector<glm::vec3>& values, glm::vec3& min, glm::vec3& extent, float& tolerance) {
+    min = values[0];
+    glm::vec3 max = values[0];
+    float largest = 0.0f;
+    for (const auto& value : values) {
+        min = glm::min(min, value);
+        max = glm::max(max, value);
+        largest = std::max(largest, glm::length(value));
+    }
+    extent = max - min;
+    tolerance = std::max(MIN_VECTOR_TOLERANCE, VECTOR_RELATIVE_TOLERANCE * largest);
+}
+
+AnimClipData::AnimClipData(const std::vector<AnimPoseVec>& frames) {
+    _numFrames = std::min((int)frames.size(), (int)MAX_FRAMES);
+    if (_numFrames == 0) {
+        return;
+    }
+
+    auto addKeys = [&](const std::vector<int>& keys, auto pack) {
+        Track track;
+        track.firstKey = (uint32_t)_keyFrames.size();
+        track.numKeys = (uint32_t)keys.size();
+        for (int frame : keys) {
+            _keyFrames.push_back((uint16_t)frame);
+            uint16_t values[3];
+            pack(frame, values);
+            _keyValues.insert(_keyValues.end(), values, values + 3);
+        }
+        return track;
+    };
+    auto vectorLerp = [](const glm::vec3& a, const glm::vec3& b, float alpha) { return lerp(a, b, alpha); };
+    auto vectorError = [](const glm::vec3& a, const glm::vec3& b) { return glm::distance(a, b); };
+
+    int numJoints = (int)frames[0].size();
+    _joints.resize(numJoints);
+    std::vector<glm::quat> rotations(_numFrames);
+    std::vector<glm::vec3> translations(_numFrames);
+    std::vector<glm::vec3> scales(_numFrames);
+    for (int i = 0; i < numJoints; ++i) {
+        for (int frame = 0; frame < _numFrames; ++frame) {
+            const AnimPose& pose = frames[frame][i];
+            rotations[frame] = pose.rot();
+            translations[frame] = pose.trans();
+            scales[frame] = pose.scale();
+        }
+        JointTracks& joint = _joints[i];
+
+        auto keys = reduceKeys(rotations, ROTATION_TOLERANCE, safeLerp, rotationError);
+        joint.rotation = addKeys(keys, [&](int frame, uint16_t* values) {
+            packRotation(rotations[frame], values);
+        });
+
+        float tolerance;
+        computeRange(translations, joint.translationMin, joint.translationExtent, tolerance);
+        keys = reduceKeys(translations, tolerance, vectorLerp, vectorError);
+        joint.translation = addKeys(keys, [&](int frame, uint16_t* values) {
+            for (int axis = 0; axis < 3; ++axis) {
+                values[axis] = quantize(translations[frame][axis], joint.translationMin[axis], joint.translationExtent[axis], VECTOR_COMPONENT_MAX);
+            }
+        });
+
+        computeRange(scales, joint.scaleMin, joint.scaleExtent, tolerance);
+        keys = reduceKeys(scales, tolerance, vectorLerp, vectorError);
+        joint.scale = addKeys(keys, [&](int frame, uint16_t* values) {
+            for (int axis = 0; axis < 3; ++axis) {
+                values[axis] = quantize(scales[frame][axis], joint.scaleMin[axis], joint.scaleExtent[axis], VECTOR_COMPONENT_MAX);
+            }
+        });
+    }
+    _keyFrames.shrink_to_fit();
+    _keyValues.shrink_to_fit();
+}
+
+int AnimClipData::findKey(const Track& track, float frame, float& alpha) const {
+    alpha = 0.0f;
+    const uint16_t* keyFrames = &_keyFrames[track.firstKey];
+    if (track.numKeys == 1 || frame <= keyFrames[0]) {
+        return 0;
+    }
+    int key = (int)(std::upper_bound(keyFrames, keyFrames + track.numKeys, frame) - keyFrames) - 1;
+    if (key >= (int)track.numKeys - 1) {
+        return (int)track.numKeys - 1;
+    }
+    alpha = (frame - keyFrames[key]) / (float)(keyFrames[key + 1] - keyFrames[key]);
+    return key;
+}
+
+glm::quat AnimClipData::sampleRotation(const Track& track, float frame) const {
+    float alpha;
+    int key = findKey(track, frame, alpha);
+    const uint16_t* values = &_keyValues[3 * (track.firstKey + key)];
+    glm::quat rotation = unpackRotation(values);
+    if (alpha > 0.0f) {
+        rotation = safeLerp(rotation, unpackRotation(values + 3), alpha);
+    }
+    return rotation;
+}
+
+glm::vec3 AnimClipData::sampleVector(const Track& track, const glm::vec3& min, const glm::vec3& extent, float frame) const {
+    float alpha;
+    int key = findKey(track, frame, alpha);
+    const uint16_t* values = &_keyValues[3 * (track.firstKey + key)];
+    glm::vec3 result;
+    for (int axis = 0; axis < 3; ++axis) {
+        float value = dequantize(values[axis], min[axis], extent[axis], VECTOR_COMPONENT_MAX);
+        if (alpha > 0.0f) {
+            float nextValue = dequantize(values[axis + 3], min[axis], extent[axis], VECTOR_COMPONENT_MAX);
+            value += (nextValue - value) * alpha;
+        }
+        result[axis] = value;
+    }
+    return result;
+}
+
+void AnimClipData::sample(float frame, AnimPose* poses) const {
+    for (size_t i = 0; i < _joints.size(); ++i) {
+        const JointTracks& joint = _joints[i];
+        poses[i] = AnimPose(sampleVector(joint.scale, joint.scaleMin, joint.scaleExtent, frame),
+                            sampleRotation(joint.rotation, frame),
+                            sampleVector(joint.translation, joint.translationMin, joint.translationExtent, frame));
+    }
+}
+
+size_t AnimClipData::getMemorySize() const {
+    return sizeof(AnimClipData) + _joints.capacity() * sizeof(JointTracks) +
+        (_keyFrames.capacity() + _keyValues.capacity()) * sizeof(uint16_t);
+}
+
+uint64_t AnimClipData::hashSkeleton(const AnimSkeleton& skeleton) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    auto add = [&](const void* data, size_t size) {
+        const uint8_t* bytes = (const uint8_t*)data;
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+    };
+    int numJoints = skeleton.getNumJoints();
+    add(&numJoints, sizeof(numJoints));
+    for (int i = 0; i < numJoints; ++i) {
+        const QString& name = skeleton.getJointName(i);
+        add(name.constData(), name.size() * sizeof(QChar));
+        int parentIndex = skeleton.getParentIndex(i);
+        add(&parentIndex, sizeof(parentIndex));
+        const AnimPose& pose = skeleton.getRelativeDefaultPose(i);
+        add(&pose, sizeof(AnimPose));
+    }
+    add(&skeleton.getGeometryOffset(), sizeof(glm::mat4));
+    return hash;
+}
+
+static std::mutex sharedClipsMutex;
+
+static QHash<QString, std::weak_ptr<const AnimClipData>>& getSharedClips() {
+    static QHash<QString, std::weak_ptr<const AnimClipData>> sharedClips;
+    return sharedClips;
+}
+
+static QString sharedClipKey(const QString& url, uint64_t skeletonHash, bool mirrored) {
+    return url + "|" + QString::number(skeletonHash, 16) + (mirrored ? "|mirrored" : "");
+}
+
+AnimClipData::Pointer AnimClipData::find(const QString& url, uint64_t skeletonHash, bool mirrored) {
+    std::lock_guard<std::mutex> lock(sharedClipsMutex);
+    return getSharedClips().value(sharedClipKey(url, skeletonHash, mirrored)).lock();
+}
+
+AnimClipData::Pointer AnimClipData::share(const QString& url, uint64_t skeletonHash, bool mirrored, const Pointer& clipData) {
+    std::lock_guard<std::mutex> lock(sharedClipsMutex);
+    auto& sharedClips = getSharedClips();
+    auto& sharedClip = sharedClips[sharedClipKey(url, skeletonHash, mirrored)];
+    auto existing = sharedClip.lock();
+    if (existing) {
+        return existing;
+    }
+    sharedClip = clipData;
+
+    // forget the clips nobody plays anymore
+    for (auto itr = sharedClips.begin(); itr != sharedClips.end();) {
+        if (itr.value().expired()) {
+            itr = sharedClips.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+    return clipData;
+}
@@ -0,0 +1,85 @@
+//
+//  AnimClipData.h
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimClipData_h
+#define hifi_AnimClipData_h
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "AnimPose.h"
+
+class AnimSkeleton;
+
+// The frames of an animation retargeted to one skeleton, compressed and immutable.
+// Each joint has a rotation, a translation and a scale track.  A track only keeps the frames that can't be linearly
+// interpolated from their neighbours, rotations are quantized to their smallest three components and translations and
+// scales to the range they cover, so a key takes six bytes and a still joint a single key.
+// Clips are shared by every AnimClip playing the same animation on the same skeleton.
+class AnimClipData {
+public:
+    using Pointer = std::shared_ptr<const AnimClipData>;
+
+    static const int MAX_FRAMES = 65536;
+
+    // frames[frame][joint], in relative poses
+    explicit AnimClipData(const std::vector<AnimPoseVec>& frames);
+
+    int getNumFrames() const { return _numFrames; }
+    int getNumJoints() const { return (int)_joints.size(); }
+
+    // Writes the relative pose of every joint at the frame, which may fall between two frames
+    void sample(float frame, AnimPose* poses) const;
+
+    // in bytes
+    size_t getMemorySize() const;
+
+    // Identifies the skeleton the frames were retargeted to, from everything the retargeting reads
+    static uint64_t hashSkeleton(const AnimSkeleton& skeleton);
+
+    static Pointer find(const QString& url, uint64_t skeletonHash, bool mirrored);
+
+    // Returns the clip shared under the same key by someone else first, or this one
+    static Pointer share(const QString& url, uint64_t skeletonHash, bool mirrored, const Pointer& clipData);
+
+private:
+    class Track {
+    public:
+        uint32_t firstKey { 0 };
+        uint32_t numKeys { 0 };
+    };
+
+    class JointTracks {
+    public:
+        Track rotation;
+        Track translation;
+        Track scale;
+        glm::vec3 translationMin;
+        glm::vec3 translationExtent;
+        glm::vec3 scaleMin;
+        glm::vec3 scaleExtent;
+    };
+
+    // finds the key at or before the frame, and how far the frame is towards the next one
+    int findKey(const Track& track, float frame, float& alpha) const;
+
+    glm::quat sampleRotation(const Track& track, float frame) const;
+    glm::vec3 sampleVector(const Track& track, const glm::vec3& min, const glm::vec3& extent, float frame) const;
+
+    std::vector<JointTracks> _joints;
+    std::vector<uint16_t> _keyFrames; // of the keys of every track
+    std::vector<uint16_t> _keyValues; // three per key
+    int _numFrames { 0 };
+};
+
+#endif // hifi_AnimClipData_h
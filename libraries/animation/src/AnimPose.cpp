@@ -68,6 +68,27 @@ glm::vec3 AnimPose::xformVectorFast(const glm::vec3& rhs) const {
 }
 
 AnimPose AnimPose::operator*(const AnimPose& rhs) const {
+    // With a uniform positive scale on the left and a positive scale on the right the product has no shear, so it is
+    // composed directly rather than through a matrix that would have to be decomposed again.  This is the common case
+    // for every joint of a skeleton.
+    const float UNIFORM_SCALE_EPSILON = 1.0e-4f;
+    float scale = _scale.x;
+    if (scale > 0.0f && fabsf(_scale.y - scale) <= UNIFORM_SCALE_EPSILON * scale &&
+        fabsf(_scale.z - scale) <= UNIFORM_SCALE_EPSILON * scale &&
+        rhs._scale.x > 0.0f && rhs._scale.y > 0.0f && rhs._scale.z > 0.0f) {
+        AnimPose result;
+        result._scale = scale * rhs._scale;
+        result._rot = _rot * rhs._rot;
+        result._trans = _trans + _rot * (scale * rhs._trans);
+
+        // the same renormalization as the decomposition
+        float lengthSquared = glm::length2(result._rot);
+        if (glm::abs(lengthSquared - 1.0f) > EPSILON) {
+            result._rot *= 1.0f / sqrtf(lengthSquared);
+        }
+        return result;
+    }
+
     glm::mat4 result;
     glm_mat4u_mul(*this, rhs, result);
     return AnimPose(result);
@@ -12,11 +12,49 @@
 #include <GLMHelpers.h>
 #include <NumericalConstants.h>
 #include <DebugDraw.h>
+#include <CPUDetect.h>
 
-// TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
+#ifdef ARCH_X86
+#include <emmintrin.h>
+
+// the kernels below treat each pose as ten packed floats: scale at 0, rot at 3 and trans at 7
+static_assert(sizeof(AnimPose) == 10 * sizeof(float), "AnimPose is expected to be packed");
+
+static inline __m128 dot4(__m128 a, __m128 b) {
+    __m128 m = _mm_mul_ps(a, b);
+    m = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+// lerps scale and trans, and nlerps rot along the shortest arc, the same as safeLerp.
+// Everything is loaded before anything is stored so the result may alias either pose.
+static inline void blendPose(const float* a, const float* b, __m128 alpha, float* result) {
+    __m128 scaleA = _mm_loadu_ps(a);
+    __m128 scaleB = _mm_loadu_ps(b);
+    __m128 rotA = _mm_loadu_ps(a + 3);
+    __m128 rotB = _mm_loadu_ps(b + 3);
+    __m128 transA = _mm_loadu_ps(a + 6);
+    __m128 transB = _mm_loadu_ps(b + 6);
+
+    const __m128 SIGN_MASK = _mm_set1_ps(-0.0f);
+    rotB = _mm_xor_ps(rotB, _mm_and_ps(dot4(rotA, rotB), SIGN_MASK));
+    __m128 rot = _mm_add_ps(rotA, _mm_mul_ps(_mm_sub_ps(rotB, rotA), alpha));
+    rot = _mm_div_ps(rot, _mm_sqrt_ps(dot4(rot, rot)));
+
+    // the lanes spilling into rot are overwritten by the last store
+    _mm_storeu_ps(result + 6, _mm_add_ps(transA, _mm_mul_ps(_mm_sub_ps(transB, transA), alpha)));
+    _mm_storeu_ps(result, _mm_add_ps(scaleA, _mm_mul_ps(_mm_sub_ps(scaleB, scaleA), alpha)));
+    _mm_storeu_ps(result + 3, rot);
+}
+#endif
 
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+#ifdef ARCH_X86
+    const __m128 alphas = _mm_set1_ps(alpha);
+    for (size_t i = 0; i < numPoses; i++) {
+        blendPose((const float*)&a[i], (const float*)&b[i], alphas, (float*)&result[i]);
+    }
+#else
     for (size_t i = 0; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
         const AnimPose& bPose = b[i];
@@ -25,6 +63,22 @@ void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, A
         result[i].rot() = safeLerp(aPose.rot(), bPose.rot(), alpha);
         result[i].trans() = lerp(aPose.trans(), bPose.trans(), alpha);
     }
+#endif
+}
+
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, const float* alphas, float alphaScale, AnimPose* result) {
+#ifdef ARCH_X86
+    for (size_t i = 0; i < numPoses; i++) {
+        blendPose((const float*)&a[i], (const float*)&b[i], _mm_set1_ps(alphas[i] * alphaScale), (float*)&result[i]);
+    }
+#else
+    for (size_t i = 0; i < numPoses; i++) {
+        float alpha = alphas[i] * alphaScale;
+        result[i].scale() = lerp(a[i].scale(), b[i].scale(), alpha);
+        result[i].rot() = safeLerp(a[i].rot(), b[i].rot(), alpha);
+        result[i].trans() = lerp(a[i].trans(), b[i].trans(), alpha);
+    }
+#endif
 }
 
 glm::quat averageQuats(size_t numQuats, const glm::quat* quats) {
@@ -14,8 +14,12 @@
 #include "AnimNode.h"
 
 // this is where the magic happens
+// result may be the same array as a or b
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result);
 
+// same, with each pose blended by its own alpha times alphaScale
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, const float* alphas, float alphaScale, AnimPose* result);
+
 glm::quat averageQuats(size_t numQuats, const glm::quat* quats);
 
 float accumulateTime(float startFrame, float endFrame, float timeScale, float currentFrame, float dt, bool loopFlag,
@@ -1507,8 +1507,9 @@ void Rig::updateAnimations(float deltaTime, const glm::mat4& rootTransform, cons
                 alpha = _computeNetworkAnimation ? (_networkAnimState.blendTime / TOTAL_BLEND_TIME) : (1.0f - (_networkAnimState.blendTime / TOTAL_BLEND_TIME));
                 alpha = glm::clamp(alpha, 0.0f, 1.0f);
                 size_t numJoints = std::min(_networkPoseSet._relativePoses.size(), _internalPoseSet._relativePoses.size());
-                for (size_t i = 0; i < numJoints; i++) {
-                    _networkPoseSet._relativePoses[i].blend(_internalPoseSet._relativePoses[i], alpha);
+                if (numJoints > 0) {
+                    ::blend(numJoints, &_internalPoseSet._relativePoses[0], &_networkPoseSet._relativePoses[0], alpha,
+                            &_networkPoseSet._relativePoses[0]);
                 }
             }
         }
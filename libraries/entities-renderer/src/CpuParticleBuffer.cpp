@@ -0,0 +1,160 @@
+//
+//  CpuParticleBuffer.cpp
+//  libraries/entities-renderer/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CpuParticleBuffer.h"
+
+#include <CPUDetect.h>
+
+#ifdef ARCH_X86
+#include <emmintrin.h>
+#endif
+
+static const size_t MIN_CAPACITY = 64;
+
+void CpuParticleBuffer::clear() {
+    _head = 0;
+    _size = 0;
+}
+
+void CpuParticleBuffer::grow() {
+    size_t capacity = std::max(_capacity * 2, MIN_CAPACITY);
+
+    // unroll the ring into the front of the bigger arrays
+    for (auto& component : _components) {
+        std::vector<float> grown(capacity);
+        forEachSpan([&](size_t start, size_t count) {
+            size_t offset = (start == _head) ? 0 : _capacity - _head;
+            std::copy(component.begin() + start, component.begin() + start + count, grown.begin() + offset);
+        });
+        component.swap(grown);
+    }
+    std::vector<uint64_t> expirations(capacity);
+    forEachSpan([&](size_t start, size_t count) {
+        size_t offset = (start == _head) ? 0 : _capacity - _head;
+        std::copy(_expirations.begin() + start, _expirations.begin() + start + count, expirations.begin() + offset);
+    });
+    _expirations.swap(expirations);
+
+    _capacity = capacity;
+    _head = 0;
+}
+
+void CpuParticleBuffer::push(const Particle& particle) {
+    if (_size == _capacity) {
+        grow();
+    }
+    size_t i = slot(_size++);
+    _components[SEED][i] = particle.seed;
+    _components[LIFETIME][i] = particle.lifetime;
+    for (int axis = 0; axis < 3; ++axis) {
+        _components[BASE_X + axis][i] = particle.basePosition[axis];
+        _components[POSITION_X + axis][i] = particle.relativePosition[axis];
+        _components[VELOCITY_X + axis][i] = particle.velocity[axis];
+        _components[ACCELERATION_X + axis][i] = particle.acceleration[axis];
+    }
+    _expirations[i] = particle.expiration;
+}
+
+CpuParticleBuffer::Particle CpuParticleBuffer::get(size_t index) const {
+    size_t i = slot(index);
+    Particle particle;
+    particle.seed = _components[SEED][i];
+    particle.lifetime = _components[LIFETIME][i];
+    for (int axis = 0; axis < 3; ++axis) {
+        particle.basePosition[axis] = _components[BASE_X + axis][i];
+        particle.relativePosition[axis] = _components[POSITION_X + axis][i];
+        particle.velocity[axis] = _components[VELOCITY_X + axis][i];
+        particle.acceleration[axis] = _components[ACCELERATION_X + axis][i];
+    }
+    particle.expiration = _expirations[i];
+    return particle;
+}
+
+void CpuParticleBuffer::expire(uint64_t now, size_t maxParticles) {
+    // particles are emitted with the same lifespan, so the oldest expire first
+    while (_size > maxParticles || (_size > 0 && _expirations[_head] <= now)) {
+        _head = (_head + 1) & (_capacity - 1);
+        --_size;
+    }
+}
+
+void CpuParticleBuffer::rebase(const glm::vec3& basePosition, bool keepWorldPosition) {
+    forEachSpan([&](size_t start, size_t count) {
+        for (int axis = 0; axis < 3; ++axis) {
+            float* base = _components[BASE_X + axis].data() + start;
+            float* position = _components[POSITION_X + axis].data() + start;
+            for (size_t i = 0; i < count; ++i) {
+                if (keepWorldPosition) {
+                    position[i] += base[i] - basePosition[axis];
+                }
+                base[i] = basePosition[axis];
+            }
+        }
+    });
+}
+
+void CpuParticleBuffer::integrate(float deltaTime) {
+    const float halfDeltaTimeSquared = 0.5f * deltaTime * deltaTime;
+    forEachSpan([&](size_t start, size_t count) {
+        for (int axis = 0; axis < 3; ++axis) {
+            float* position = _components[POSITION_X + axis].data() + start;
+            float* velocity = _components[VELOCITY_X + axis].data() + start;
+            const float* acceleration = _components[ACCELERATION_X + axis].data() + start;
+            size_t i = 0;
+#ifdef ARCH_X86
+            const __m128 dt = _mm_set1_ps(deltaTime);
+            const __m128 halfDtSquared = _mm_set1_ps(halfDeltaTimeSquared);
+            for (; i + 4 <= count; i += 4) {
+                __m128 p = _mm_loadu_ps(position + i);
+                __m128 v = _mm_loadu_ps(velocity + i);
+                __m128 a = _mm_loadu_ps(acceleration + i);
+                p = _mm_add_ps(p, _mm_add_ps(_mm_mul_ps(v, dt), _mm_mul_ps(a, halfDtSquared)));
+                v = _mm_add_ps(v, _mm_mul_ps(a, dt));
+                _mm_storeu_ps(position + i, p);
+                _mm_storeu_ps(velocity + i, v);
+            }
+#endif
+            for (; i < count; ++i) {
+                position[i] += velocity[i] * deltaTime + acceleration[i] * halfDeltaTimeSquared;
+                velocity[i] += acceleration[i] * deltaTime;
+            }
+        }
+
+        float* lifetime = _components[LIFETIME].data() + start;
+        for (size_t i = 0; i < count; ++i) {
+            lifetime[i] += deltaTime;
+        }
+    });
+}
+
+void CpuParticleBuffer::writeVertices(Vertex* vertices, bool trail, const glm::vec3& emitterPosition) const {
+    forEachSpan([&](size_t start, size_t count) {
+        const float* seed = _components[SEED].data() + start;
+        const float* lifetime = _components[LIFETIME].data() + start;
+        const float* x = _components[POSITION_X].data() + start;
+        const float* y = _components[POSITION_Y].data() + start;
+        const float* z = _components[POSITION_Z].data() + start;
+        if (trail) {
+            const float* baseX = _components[BASE_X].data() + start;
+            const float* baseY = _components[BASE_Y].data() + start;
+            const float* baseZ = _components[BASE_Z].data() + start;
+            for (size_t i = 0; i < count; ++i) {
+                vertices[i].xyz = glm::vec3(x[i] + baseX[i], y[i] + baseY[i], z[i] + baseZ[i]);
+                vertices[i].uv = glm::vec2(lifetime[i], seed[i]);
+            }
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                vertices[i].xyz = glm::vec3(x[i], y[i], z[i]) + emitterPosition;
+                vertices[i].uv = glm::vec2(lifetime[i], seed[i]);
+            }
+        }
+        vertices += count;
+    });
+}
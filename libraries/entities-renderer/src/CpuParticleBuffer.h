@@ -0,0 +1,95 @@
+//
+//  CpuParticleBuffer.h
+//  libraries/entities-renderer/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_CpuParticleBuffer_h
+#define hifi_CpuParticleBuffer_h
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// The live particles of one emitter, oldest first, in a ring of structure of arrays so that they integrate four at
+// a time and expire from the front without moving the rest.
+class CpuParticleBuffer {
+public:
+    class Particle {
+    public:
+        float seed { 0.0f };
+        uint64_t expiration { 0 };
+        float lifetime { 0.0f };
+        glm::vec3 basePosition;
+        glm::vec3 relativePosition;
+        glm::vec3 velocity;
+        glm::vec3 acceleration;
+    };
+
+    // What the particle shader reads for each particle
+    class Vertex {
+    public:
+        glm::vec3 xyz; // Position
+        glm::vec2 uv; // Lifetime + seed
+    };
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    void clear();
+
+    // Appends the newest particle
+    void push(const Particle& particle);
+    Particle get(size_t index) const;
+
+    // Drops the particles expired by now, and the oldest ones beyond maxParticles
+    void expire(uint64_t now, size_t maxParticles);
+
+    // Moves every particle to a new base position, keeping where they are in the world or not
+    void rebase(const glm::vec3& basePosition, bool keepWorldPosition);
+
+    void integrate(float deltaTime);
+
+    // Writes one vertex per particle, positioned from their own base when trailing or the emitter's otherwise
+    void writeVertices(Vertex* vertices, bool trail, const glm::vec3& emitterPosition) const;
+
+private:
+    enum Component {
+        SEED = 0,
+        LIFETIME,
+        BASE_X, BASE_Y, BASE_Z,
+        POSITION_X, POSITION_Y, POSITION_Z,
+        VELOCITY_X, VELOCITY_Y, VELOCITY_Z,
+        ACCELERATION_X, ACCELERATION_Y, ACCELERATION_Z,
+        NUM_COMPONENTS
+    };
+
+    size_t slot(size_t index) const { return (_head + index) & (_capacity - 1); }
+    void grow();
+
+    // calls the operator with each contiguous run of slots in order
+    template <typename F>
+    void forEachSpan(F&& f) const {
+        size_t first = std::min(_size, _capacity - _head);
+        if (first > 0) {
+            f(_head, first);
+        }
+        if (_size > first) {
+            f((size_t)0, _size - first);
+        }
+    }
+
+    std::vector<float> _components[NUM_COMPONENTS];
+    std::vector<uint64_t> _expirations;
+    size_t _capacity { 0 }; // always a power of two
+    size_t _head { 0 };
+    size_t _size { 0 };
+};
+
+#endif // hifi_CpuParticleBuffer_h
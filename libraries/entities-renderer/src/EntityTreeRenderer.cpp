@@ -420,36 +420,30 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
         // we expect the cost to updating all renderables to exceed available time budget
         // so we first sort by priority and update in order until out of time
 
-        class SortableRenderer: public PrioritySortUtil::Sortable {
-        public:
-            SortableRenderer(const EntityRendererPointer& renderer) : _renderer(renderer) { }
-
-            glm::vec3 getPosition() const override { return _renderer->getEntity()->getWorldPosition(); }
-            float getRadius() const override { return 0.5f * _renderer->getEntity()->getQueryAACube().getScale(); }
-            uint64_t getTimestamp() const override { return _renderer->getUpdateTime(); }
-
-            EntityRendererPointer getRenderer() const { return _renderer; }
-        private:
-            EntityRendererPointer _renderer;
-        };
-
         // prioritize and sort the renderables
         uint64_t sortStart = usecTimestampNow();
 
-        const auto& views = _viewState->getConicalViews();
-        PrioritySortUtil::PriorityQueue<SortableRenderer> sortedRenderables(views);
-        sortedRenderables.reserve(_renderablesToUpdate.size());
+        _sortedRenderables.clear();
+        _sortedRenderables.setViews(_viewState->getConicalViews());
+        _sortedRenderables.reserve(_renderablesToUpdate.size());
+        const std::vector<SortableRenderer>* sortedRenderablesVector = nullptr;
         {
             PROFILE_RANGE_EX(simulation_physics, "SortRenderables", 0xffff00ff, (uint64_t)_renderablesToUpdate.size());
             std::unordered_map<EntityItemID, EntityRendererPointer>::iterator itr = _renderablesToUpdate.begin();
             while (itr != _renderablesToUpdate.end()) {
                 assert(itr->second); // only valid renderables are added to _renderablesToUpdate
-                sortedRenderables.push(SortableRenderer(itr->second));
+                _sortedRenderables.push(SortableRenderer(itr->second));
                 ++itr;
             }
+
+            // only those there could be time for need to be in order, the rest follow in no particular order
+            const float NUM_TO_SORT_MARGIN = 2.0f;
+            int numToSort = (int)(NUM_TO_SORT_MARGIN * (float)MAX_UPDATE_RENDERABLES_TIME_BUDGET /
+                                  std::max(_avgRenderableUpdateCost, 1.0f)) + 1;
+            sortedRenderablesVector = &_sortedRenderables.getSortedVector(numToSort);
         }
         {
-            PROFILE_RANGE_EX(simulation_physics, "UpdateRenderables", 0xffff00ff, sortedRenderables.size());
+            PROFILE_RANGE_EX(simulation_physics, "UpdateRenderables", 0xffff00ff, _sortedRenderables.size());
 
             // compute remaining time budget
             uint64_t updateStart = usecTimestampNow();
@@ -461,26 +455,40 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
             uint64_t expiry = updateStart + timeBudget;
 
             // process the sorted renderables
-            size_t numSorted = sortedRenderables.size();
-            const auto& sortedRenderablesVector = sortedRenderables.getSortedVector();
-            for (const auto& sortedRenderable : sortedRenderablesVector) {
+            size_t numUpdated = 1; // start at one to avoid divide by zero
+            for (const auto& sortedRenderable : *sortedRenderablesVector) {
                 if (usecTimestampNow() > expiry) {
                     break;
                 }
                 const auto& renderable = sortedRenderable.getRenderer();
                 renderable->updateInScene(scene, transaction);
                 _renderablesToUpdate.erase(renderable->getEntity()->getID());
+                ++numUpdated;
             }
 
             // compute average per-renderable update cost
-            size_t numUpdated = numSorted - sortedRenderables.size() + 1; // add one to avoid divide by zero
             float cost = (float)(usecTimestampNow() - updateStart) / (float)(numUpdated);
             const float blend = 0.1f;
             _avgRenderableUpdateCost = (1.0f - blend) * _avgRenderableUpdateCost + blend * cost;
         }
+
+        // let go of the renderables until the next sort
+        _sortedRenderables.clear();
     }
 }
 
+glm::vec3 EntityTreeRenderer::SortableRenderer::getPosition() const {
+    return _renderer->getEntity()->getWorldPosition();
+}
+
+float EntityTreeRenderer::SortableRenderer::getRadius() const {
+    return 0.5f * _renderer->getEntity()->getQueryAACube().getScale();
+}
+
+uint64_t EntityTreeRenderer::SortableRenderer::getTimestamp() const {
+    return _renderer->getUpdateTime();
+}
+
 void EntityTreeRenderer::preUpdate() {
     if (_tree && !_shuttingDown) {
         _tree->preUpdate();
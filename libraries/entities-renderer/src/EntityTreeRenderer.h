@@ -23,6 +23,7 @@
 #include <ScriptCache.h>
 #include <TextureCache.h>
 #include <OctreeProcessor.h>
+#include <PrioritySortUtil.h>
 #include <render/Forward.h>
 #include <workload/Space.h>
 
@@ -243,6 +244,22 @@ private:
 
     float _avgRenderableUpdateCost { 0.0f };
 
+    class SortableRenderer : public PrioritySortUtil::Sortable {
+    public:
+        SortableRenderer(const EntityRendererPointer& renderer) : _renderer(renderer) { }
+
+        glm::vec3 getPosition() const override;
+        float getRadius() const override;
+        uint64_t getTimestamp() const override;
+
+        EntityRendererPointer getRenderer() const { return _renderer; }
+    private:
+        EntityRendererPointer _renderer;
+    };
+
+    // kept between updates, so that each sort starts from where the last one left off
+    PrioritySortUtil::PriorityQueue<SortableRenderer> _sortedRenderables { ConicalViewFrustums() };
+
     ReadWriteLockable _changedEntitiesGuard;
     std::unordered_set<EntityItemID> _changedEntities;
 
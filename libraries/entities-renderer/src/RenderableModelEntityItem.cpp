@@ -1361,6 +1361,12 @@ void ModelEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& sce
         withWriteLock([&] {
             _prevModelLoaded = false;
         });
+        // the priority depends on where the viewer is, so refresh it while the model waits to load
+        auto loadPriorityEpoch = ResourceCache::getLoadPriorityEpoch();
+        if (loadPriorityEpoch != _loadPriorityEpoch) {
+            _loadPriorityEpoch = loadPriorityEpoch;
+            model->setLoadingPriority(EntityTreeRenderer::getEntityLoadingPriority(*entity));
+        }
         emit requestRenderUpdate();
         return;
     } else if (!_prevModelLoaded) {
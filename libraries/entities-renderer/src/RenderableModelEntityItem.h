@@ -195,6 +195,7 @@ private:
 
     bool _didLastVisualGeometryRequestSucceed { true };
     bool _prevModelLoaded { false };
+    uint32_t _loadPriorityEpoch { 0 };
 
     void processMaterials();
 };
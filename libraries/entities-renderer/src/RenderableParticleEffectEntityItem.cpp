@@ -14,8 +14,14 @@
 #include <GeometryCache.h>
 #include <shaders/Shaders.h>
 
+#include <mutex>
+#include <random>
+#include <unordered_set>
+
 #include <glm/gtx/transform.hpp>
 
+#include <TBBHelpers.h>
+
 using namespace render;
 using namespace render::entities;
 
@@ -40,15 +46,23 @@ static ShapePipelinePointer shapePipelineFactory(const ShapePlumber& plumber, co
     return std::make_shared<render::ShapePipeline>(texturedPipeline, nullptr, nullptr, nullptr);
 }
 
-struct GpuParticle {
-    GpuParticle(const glm::vec3& xyzIn, const glm::vec2& uvIn) : xyz(xyzIn), uv(uvIn) {}
-    glm::vec3 xyz; // Position
-    glm::vec2 uv; // Lifetime + seed
-};
-
-using GpuParticles = std::vector<GpuParticle>;
+using GpuParticle = CpuParticleBuffer::Vertex;
+
+// the emitters alive, for stepping the ones being rendered together
+static std::mutex _emittersMutex;
+static std::unordered_set<ParticleEffectEntityRenderer*> _emitters;
+static uint64_t _lastEmittersStepTime { 0 };
+static uint64_t _emittersStep { 0 };
+
+ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPointer& entity) :
+    Parent(entity),
+    _random(std::random_device()())
+{
+    {
+        std::unique_lock<std::mutex> lock(_emittersMutex);
+        _emitters.insert(this);
+    }
 
-ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPointer& entity) : Parent(entity) {
     ParticleUniforms uniforms;
     _uniformBuffer = std::make_shared<Buffer>(sizeof(ParticleUniforms), (const gpu::Byte*) &uniforms);
 
@@ -64,6 +78,11 @@ ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPoint
     });
 }
 
+ParticleEffectEntityRenderer::~ParticleEffectEntityRenderer() {
+    std::unique_lock<std::mutex> lock(_emittersMutex);
+    _emitters.erase(this);
+}
+
 bool ParticleEffectEntityRenderer::needsRenderUpdateFromTypedEntity(const TypedEntityPointer& entity) const {
     entity->updateQueryAACube();
 
@@ -196,24 +215,39 @@ Item::Bound ParticleEffectEntityRenderer::getBound() {
     return _bound;
 }
 
+// Each renderer draws from its own generator: rand() is locked process wide on some platforms and seeded alike on
+// every thread on others, and emitters are stepped across threads
+static float randFloat(std::mt19937& random) {
+    // the top 24 bits, so that it never rounds up to 1
+    return (float)(random() >> 8) * (1.0f / (float)(1 << 24));
+}
+
+static float randFloatInRange(std::mt19937& random, float min, float max) {
+    return min + randFloat(random) * (max - min);
+}
+
+static int randIntInRange(std::mt19937& random, int min, int max) {
+    return std::uniform_int_distribution<int>(min, max)(random);
+}
+
 // FIXME: these methods assume uniform emitDimensions, need to importance sample based on dimensions
-float importanceSample2DDimension(float startDim) {
+float importanceSample2DDimension(std::mt19937& random, float startDim) {
     float dimension = 1.0f;
     if (startDim < 1.0f) {
         float innerDimensionSquared = startDim * startDim;
         float outerDimensionSquared = 1.0f;  // pow(particle::MAXIMUM_EMIT_RADIUS_START, 2);
-        float randDimensionSquared = randFloatInRange(innerDimensionSquared, outerDimensionSquared);
+        float randDimensionSquared = randFloatInRange(random, innerDimensionSquared, outerDimensionSquared);
         dimension = std::sqrt(randDimensionSquared);
     }
     return dimension;
 }
 
-float importanceSample3DDimension(float startDim) {
+float importanceSample3DDimension(std::mt19937& random, float startDim) {
     float dimension = 1.0f;
     if (startDim < 1.0f) {
         float innerDimensionCubed = startDim * startDim * startDim;
         float outerDimensionCubed = 1.0f;  // pow(particle::MAXIMUM_EMIT_RADIUS_START, 3);
-        float randDimensionCubed = randFloatInRange(innerDimensionCubed, outerDimensionCubed);
+        float randDimensionCubed = randFloatInRange(random, innerDimensionCubed, outerDimensionCubed);
         dimension = std::cbrt(randDimensionCubed);
     }
     return dimension;
@@ -221,7 +255,7 @@ float importanceSample3DDimension(float startDim) {
 
 ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createParticle(uint64_t now, const Transform& baseTransform, const particle::Properties& particleProperties,
                                                                                        const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
-                                                                                       const TriangleInfo& triangleInfo) {
+                                                                                       const TriangleInfo& triangleInfo, std::mt19937& random) {
     CpuParticle particle;
 
     const auto& accelerationSpread = particleProperties.emission.acceleration.spread;
@@ -236,7 +270,7 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
     const auto& polarStart = particleProperties.polar.start;
     const auto& polarFinish = particleProperties.polar.finish;
 
-    particle.seed = randFloatInRange(-1.0f, 1.0f);
+    particle.seed = randFloatInRange(random, -1.0f, 1.0f);
     particle.expiration = now + (uint64_t)(particleProperties.lifespan * USECS_PER_SECOND);
 
     particle.relativePosition = glm::vec3(0.0f);
@@ -255,13 +289,13 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
 
         float elevationMinZ = sinf(PI_OVER_TWO - polarFinish);
         float elevationMaxZ = sinf(PI_OVER_TWO - polarStart);
-        float elevation = asinf(elevationMinZ + (elevationMaxZ - elevationMinZ) * randFloat());
+        float elevation = asinf(elevationMinZ + (elevationMaxZ - elevationMinZ) * randFloat(random));
 
         float azimuth;
         if (azimuthFinish >= azimuthStart) {
-            azimuth = azimuthStart + (azimuthFinish - azimuthStart) * randFloat();
+            azimuth = azimuthStart + (azimuthFinish - azimuthStart) * randFloat(random);
         } else {
-            azimuth = azimuthStart + (TWO_PI + azimuthFinish - azimuthStart) * randFloat();
+            azimuth = azimuthStart + (TWO_PI + azimuthFinish - azimuthStart) * randFloat(random);
         }
         // TODO: azimuth and elevation are only used for ellipsoids/circles, but could be used for other shapes too
 
@@ -272,28 +306,28 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
             glm::vec3 emitPosition;
             switch (shapeType) {
                 case SHAPE_TYPE_BOX: {
-                    glm::vec3 dim = importanceSample3DDimension(emitRadiusStart) * 0.5f * emitDimensions;
+                    glm::vec3 dim = importanceSample3DDimension(random, emitRadiusStart) * 0.5f * emitDimensions;
 
-                    int side = randIntInRange(0, 5);
+                    int side = randIntInRange(random, 0, 5);
                     int axis = side % 3;
                     float direction = side > 2 ? 1.0f : -1.0f;
 
                     emitDirection[axis] = direction;
                     emitPosition[axis] = direction * dim[axis];
                     axis = (axis + 1) % 3;
-                    emitPosition[axis] = dim[axis] * randFloatInRange(-1.0f, 1.0f);
+                    emitPosition[axis] = dim[axis] * randFloatInRange(random, -1.0f, 1.0f);
                     axis = (axis + 1) % 3;
-                    emitPosition[axis] = dim[axis] * randFloatInRange(-1.0f, 1.0f);
+                    emitPosition[axis] = dim[axis] * randFloatInRange(random, -1.0f, 1.0f);
                     break;
                 }
 
                 case SHAPE_TYPE_CYLINDER_X:
                 case SHAPE_TYPE_CYLINDER_Y:
                 case SHAPE_TYPE_CYLINDER_Z: {
-                    glm::vec3 radii = importanceSample2DDimension(emitRadiusStart) * 0.5f * emitDimensions;
+                    glm::vec3 radii = importanceSample2DDimension(random, emitRadiusStart) * 0.5f * emitDimensions;
                     int axis = shapeType - SHAPE_TYPE_CYLINDER_X;
 
-                    emitPosition[axis] = emitDimensions[axis] * randFloatInRange(-0.5f, 0.5f);
+                    emitPosition[axis] = emitDimensions[axis] * randFloatInRange(random, -0.5f, 0.5f);
                     emitDirection[axis] = 0.0f;
                     axis = (axis + 1) % 3;
                     emitPosition[axis] = radii[axis] * glm::cos(azimuth);
@@ -306,7 +340,7 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                 }
 
                 case SHAPE_TYPE_CIRCLE: {
-                    glm::vec2 radii = importanceSample2DDimension(emitRadiusStart) * 0.5f * glm::vec2(emitDimensions.x, emitDimensions.z);
+                    glm::vec2 radii = importanceSample2DDimension(random, emitRadiusStart) * 0.5f * glm::vec2(emitDimensions.x, emitDimensions.z);
                     float x = radii.x * glm::cos(azimuth);
                     float z = radii.y * glm::sin(azimuth);
                     emitPosition = glm::vec3(x, 0.0f, z);
@@ -314,16 +348,16 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                     break;
                 }
                 case SHAPE_TYPE_PLANE: {
-                    glm::vec2 dim = importanceSample2DDimension(emitRadiusStart) * 0.5f * glm::vec2(emitDimensions.x, emitDimensions.z);
+                    glm::vec2 dim = importanceSample2DDimension(random, emitRadiusStart) * 0.5f * glm::vec2(emitDimensions.x, emitDimensions.z);
 
-                    int side = randIntInRange(0, 3);
+                    int side = randIntInRange(random, 0, 3);
                     int axis = side % 2;
                     float direction = side > 1 ? 1.0f : -1.0f;
 
                     glm::vec2 pos;
                     pos[axis] = direction * dim[axis];
                     axis = (axis + 1) % 2;
-                    pos[axis] = dim[axis] * randFloatInRange(-1.0f, 1.0f);
+                    pos[axis] = dim[axis] * randFloatInRange(random, -1.0f, 1.0f);
 
                     emitPosition = glm::vec3(pos.x, 0.0f, pos.y);
                     emitDirection = Vectors::UP;
@@ -333,7 +367,7 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                 case SHAPE_TYPE_COMPOUND: {
                     // if we get here we know that geometryResource is loaded
 
-                    size_t index = randFloat() * triangleInfo.totalSamples;
+                    size_t index = randFloat(random) * triangleInfo.totalSamples;
                     Triangle triangle;
                     for (size_t i = 0; i < triangleInfo.samplesPerTriangle.size(); i++) {
                         size_t numSamples = triangleInfo.samplesPerTriangle[i];
@@ -349,14 +383,14 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                     float edgeLength3 = glm::length(triangle.v0 - triangle.v2);
 
                     float perimeter = edgeLength1 + edgeLength2 + edgeLength3;
-                    float fraction1 = randFloatInRange(0.0f, 1.0f);
+                    float fraction1 = randFloatInRange(random, 0.0f, 1.0f);
                     float fractionEdge1 = glm::min(fraction1 * perimeter / edgeLength1, 1.0f);
                     float fraction2 = fraction1 - edgeLength1 / perimeter;
                     float fractionEdge2 = glm::clamp(fraction2 * perimeter / edgeLength2, 0.0f, 1.0f);
                     float fraction3 = fraction2 - edgeLength2 / perimeter;
                     float fractionEdge3 = glm::clamp(fraction3 * perimeter / edgeLength3, 0.0f, 1.0f);
 
-                    float dim = importanceSample2DDimension(emitRadiusStart);
+                    float dim = importanceSample2DDimension(random, emitRadiusStart);
                     triangle = triangle * (glm::scale(emitDimensions) * triangleInfo.transform);
                     glm::vec3 center = (triangle.v0 + triangle.v1 + triangle.v2) / 3.0f;
                     glm::vec3 v0 = (dim * (triangle.v0 - center)) + center;
@@ -371,7 +405,7 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                 case SHAPE_TYPE_SPHERE:
                 case SHAPE_TYPE_ELLIPSOID:
                 default: {
-                    glm::vec3 radii = importanceSample3DDimension(emitRadiusStart) * 0.5f * emitDimensions;
+                    glm::vec3 radii = importanceSample3DDimension(random, emitRadiusStart) * 0.5f * emitDimensions;
                     float x = radii.x * glm::cos(elevation) * glm::cos(azimuth);
                     float y = radii.y * glm::cos(elevation) * glm::sin(azimuth);
                     float z = radii.z * glm::sin(elevation);
@@ -386,20 +420,50 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
             particle.relativePosition += emitOrientation * emitPosition;
         }
     }
-    particle.velocity = (emitSpeed + randFloatInRange(-1.0f, 1.0f) * speedSpread) * (emitOrientation * emitDirection);
+    particle.velocity = (emitSpeed + randFloatInRange(random, -1.0f, 1.0f) * speedSpread) * (emitOrientation * emitDirection);
     particle.acceleration = emitAcceleration +
-        glm::vec3(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f)) * accelerationSpread;
+        glm::vec3(randFloatInRange(random, -1.0f, 1.0f), randFloatInRange(random, -1.0f, 1.0f), randFloatInRange(random, -1.0f, 1.0f)) * accelerationSpread;
 
     return particle;
 }
 
-void ParticleEffectEntityRenderer::stepSimulation() {
+void ParticleEffectEntityRenderer::stepRenderedEmitters(uint64_t now) {
+    // the render passes of a frame come well within this of each other, and frames further apart
+    const uint64_t MIN_STEP_INTERVAL = USECS_PER_MSEC * 4;
+    // an emitter that hasn't been rendered for this long is out of view, and is left alone until it is back
+    const uint64_t RENDERED_LATELY = USECS_PER_SECOND;
+
+    std::unique_lock<std::mutex> lock(_emittersMutex);
+    if (now - _lastEmittersStepTime < MIN_STEP_INTERVAL) {
+        return;
+    }
+    _lastEmittersStepTime = now;
+    ++_emittersStep;
+
+    std::vector<ParticleEffectEntityRenderer*> emitters;
+    emitters.reserve(_emitters.size());
+    for (auto emitter : _emitters) {
+        if (now - emitter->_lastRendered < RENDERED_LATELY) {
+            emitters.push_back(emitter);
+        }
+    }
+
+    PROFILE_RANGE(render, "stepParticleEmitters");
+    // emitters hold anywhere from a handful of particles to tens of thousands, so let the scheduler split them
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, emitters.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            emitters[i]->stepSimulation(now);
+            emitters[i]->_lastStep = _emittersStep;
+        }
+    });
+}
+
+void ParticleEffectEntityRenderer::stepSimulation(uint64_t now) {
     if (_lastSimulated == 0) {
-        _lastSimulated = usecTimestampNow();
+        _lastSimulated = now;
         return;
     }
 
-    const auto now = usecTimestampNow();
     const auto interval = std::min<uint64_t>(USECS_PER_SECOND / 60, now - _lastSimulated);
     _lastSimulated = now;
 
@@ -423,7 +487,7 @@ void ParticleEffectEntityRenderer::stepSimulation() {
                     computeTriangles(geometryResource->getHFMModel());
                 }
                 // emit particle
-                _cpuParticles.push_back(createParticle(now, modelTransform, particleProperties, shapeType, geometryResource, _triangleInfo));
+                _cpuParticles.push(createParticle(now, modelTransform, particleProperties, shapeType, geometryResource, _triangleInfo, _random));
                 _timeUntilNextEmit = emitInterval;
                 if (emitInterval < timeRemaining) {
                     timeRemaining -= emitInterval;
@@ -435,38 +499,23 @@ void ParticleEffectEntityRenderer::stepSimulation() {
     }
 
     // Kill any particles that have expired or are over the max size
-    while (_cpuParticles.size() > particleProperties.maxParticles || (!_cpuParticles.empty() && _cpuParticles.front().expiration <= now)) {
-        _cpuParticles.pop_front();
-    }
+    _cpuParticles.expire(now, particleProperties.maxParticles);
 
     const float deltaTime = (float)interval / (float)USECS_PER_SECOND;
     // update the particles
-    for (auto& particle : _cpuParticles) {
-        if (_prevEmitterShouldTrail != particleProperties.emission.shouldTrail) {
-            if (_prevEmitterShouldTrail) {
-                particle.relativePosition = particle.relativePosition + particle.basePosition - modelTransform.getTranslation();
-            }
-            particle.basePosition = modelTransform.getTranslation();
-        }
-        particle.integrate(deltaTime);
+    if (_prevEmitterShouldTrail != particleProperties.emission.shouldTrail) {
+        _cpuParticles.rebase(modelTransform.getTranslation(), _prevEmitterShouldTrail);
     }
+    _cpuParticles.integrate(deltaTime);
     _prevEmitterShouldTrail = particleProperties.emission.shouldTrail;
 
-    // Build particle primitives
-    static GpuParticles gpuParticles;
-    gpuParticles.clear();
-    gpuParticles.reserve(_cpuParticles.size()); // Reserve space
-    std::transform(_cpuParticles.begin(), _cpuParticles.end(), std::back_inserter(gpuParticles), [&particleProperties, &modelTransform] (const CpuParticle& particle) {
-        glm::vec3 position = particle.relativePosition + (particleProperties.emission.shouldTrail ? particle.basePosition : modelTransform.getTranslation());
-        return GpuParticle(position, glm::vec2(particle.lifetime, particle.seed));
-    });
-
-    // Update particle buffer
+    // Write the particle primitives straight into the particle buffer
     auto& particleBuffer = _particleBuffer;
-    size_t numBytes = sizeof(GpuParticle) * gpuParticles.size();
-    particleBuffer->resize(numBytes);
-    if (numBytes != 0) {
-        particleBuffer->setData(numBytes, (const gpu::Byte*)gpuParticles.data());
+    size_t numParticles = _cpuParticles.size();
+    particleBuffer->resize(sizeof(GpuParticle) * numParticles);
+    if (numParticles != 0) {
+        _cpuParticles.writeVertices(particleBuffer->editSubData<GpuParticle>(0, numParticles),
+                                    particleProperties.emission.shouldTrail, modelTransform.getTranslation());
     }
 }
 
@@ -476,7 +525,14 @@ void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
     }
 
     // FIXME migrate simulation to a compute stage
-    stepSimulation();
+    auto now = usecTimestampNow();
+    _lastRendered = now;
+    stepRenderedEmitters(now);
+    if (_lastStep != _emittersStep) {
+        // just came into view, after the others were stepped
+        stepSimulation(now);
+        _lastStep = _emittersStep;
+    }
 
     gpu::Batch& batch = *args->_batch;
     batch.setResourceTexture(0, _networkTexture->getGPUTexture());
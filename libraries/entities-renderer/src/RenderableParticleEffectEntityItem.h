@@ -11,7 +11,10 @@
 #ifndef hifi_RenderableParticleEffectEntityItem_h
 #define hifi_RenderableParticleEffectEntityItem_h
 
+#include <random>
+
 #include "RenderableEntityItem.h"
+#include "CpuParticleBuffer.h"
 #include <ParticleEffectEntityItem.h>
 #include <TextureCache.h>
 
@@ -23,6 +26,7 @@ class ParticleEffectEntityRenderer : public TypedEntityRenderer<ParticleEffectEn
 
 public:
     ParticleEffectEntityRenderer(const EntityItemPointer& entity);
+    ~ParticleEffectEntityRenderer();
 
 protected:
     virtual bool needsRenderUpdateFromTypedEntity(const TypedEntityPointer& entity) const override;
@@ -44,25 +48,8 @@ private:
     using BufferView = gpu::BufferView;
 
     // CPU particles
-    // FIXME either switch to GPU compute particles or switch to simd updating of the particles
-    struct CpuParticle {
-        float seed { 0.0f };
-        uint64_t expiration { 0 };
-        float lifetime { 0.0f };
-        glm::vec3 basePosition;
-        glm::vec3 relativePosition;
-        glm::vec3 velocity;
-        glm::vec3 acceleration;
-
-        void integrate(float deltaTime) {
-            glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * acceleration;
-            relativePosition += velocity * deltaTime + atSquared;
-            velocity += acceleration * deltaTime;
-            lifetime += deltaTime;
-        }
-    };
-    using CpuParticles = std::deque<CpuParticle>;
-
+    // FIXME switch to GPU compute particles
+    using CpuParticle = CpuParticleBuffer::Particle;
 
     template<typename T>
     struct InterpolationData {
@@ -92,18 +79,24 @@ private:
 
     static CpuParticle createParticle(uint64_t now, const Transform& baseTransform, const particle::Properties& particleProperties,
                                       const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
-                                      const TriangleInfo& triangleInfo);
-    void stepSimulation();
+                                      const TriangleInfo& triangleInfo, std::mt19937& random);
+    void stepSimulation(uint64_t now);
+
+    // Steps every emitter rendered lately, in parallel, the first time one is rendered in a frame
+    static void stepRenderedEmitters(uint64_t now);
 
     particle::Properties _particleProperties;
     bool _prevEmitterShouldTrail;
     bool _prevEmitterShouldTrailInitialized { false };
-    CpuParticles _cpuParticles;
+    CpuParticleBuffer _cpuParticles;
+    std::mt19937 _random;
     bool _emitting { false };
     uint64_t _timeUntilNextEmit { 0 };
     BufferPointer _particleBuffer { std::make_shared<Buffer>() };
     BufferView _uniformBuffer;
     quint64 _lastSimulated { 0 };
+    quint64 _lastRendered { 0 };
+    uint64_t _lastStep { 0 }; // the stepRenderedEmitters pass that last stepped this
 
     PulsePropertyGroup _pulseProperties;
     ShapeType _shapeType;
@@ -52,6 +52,7 @@
 
 #include <Model.h>
 #include <PerfStat.h>
+#include <TBBHelpers.h>
 #include <render/Scene.h>
 
 #ifdef _WIN32
@@ -78,6 +79,7 @@
 #include "PhysicalEntitySimulation.h"
 
 const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
+const int MESH_CHUNK_SIZE = 16;
 
 /*
   A PolyVoxEntity has several interdependent parts:
@@ -101,8 +103,13 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
   is set, isReadyToComputeShape() gets called and _shape is created either from _volData or _shape, depending on
   the surface style.
 
+  _volData is divided into _meshChunks.  Changing a voxel marks the chunks around it dirty, and recomputeMesh only
+  extracts those again, in parallel, along with the collision hulls made from them.  The chunks are then stitched
+  into a single _mesh, and computeShapeInfoWorker gathers their hulls into _shape.  Only one recomputeMesh runs at
+  a time -- edits made while it runs are picked up by the next one.
+
   When a script changes _volData, compressVolumeDataAndSendEditPacket is called to update _voxelData and to
-  send a packet to the entity-server.
+  send a packet to the entity-server.  Edits made while a compression is running are sent together by one more.
 
   decompressVolumeData, recomputeMesh, computeShapeInfoWorker, and compressVolumeDataAndSendEditPacket are too expensive
   to run on a thread that has other things to do.  These use QtConcurrent::run to spawn a thread.  As each thread
@@ -199,6 +206,7 @@ void RenderablePolyVoxEntityItem::setVoxelSurfaceStyle(PolyVoxSurfaceStyle voxel
         } else {
             _volDataDirty = true;
             _voxelSurfaceStyle = voxelSurfaceStyle;
+            markAllMeshChunksDirty();
         }
     });
 
@@ -750,20 +758,26 @@ void RenderablePolyVoxEntityItem::computeShapeInfo(ShapeInfo& info) {
 bool RenderablePolyVoxEntityItem::updateDependents() {
     bool voxelDataDirty;
     bool volDataDirty;
+    bool startMeshing = false;
     withWriteLock([&] {
         voxelDataDirty = _voxelDataDirty;
         volDataDirty = _volDataDirty;
         if (_voxelDataDirty) {
             _voxelDataDirty = false;
         } else if (_volDataDirty) {
-            _volDataDirty = false;
-        } else {
+            // leave the edits for the next pass if a mesh is still being extracted
+            if (!_meshing) {
+                _volDataDirty = false;
+                _meshing = true;
+                startMeshing = true;
+            }
+        } else if (!_meshing) {
             _meshReady = true;
         }
     });
     if (voxelDataDirty) {
         decompressVolumeData();
-    } else if (volDataDirty) {
+    } else if (startMeshing) {
         recomputeMesh();
     }
 
@@ -807,9 +821,67 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(const glm::vec3& voxelVolum
         _volData.reset(new PolyVox::SimpleVolume<uint8_t>(PolyVox::Region(lowCorner, highCorner)));
         // having the "outside of voxel-space" value be 255 has helped me notice some problems.
         _volData->setBorderValue(255);
+        resetMeshChunks();
+    });
+}
+
+void RenderablePolyVoxEntityItem::resetMeshChunks() {
+    // lay the chunks out over _volData, with each sharing its upper faces with the chunks above it.  This assumes
+    // that the caller has write-locked the entity.
+    ++_meshChunksGeneration;
+    _meshChunks.clear();
+    _numMeshChunks = ivec3(0);
+    if (!_volData) {
+        return;
+    }
+
+    PolyVox::Region enclosing = _volData->getEnclosingRegion();
+    ivec3 low(enclosing.getLowerX(), enclosing.getLowerY(), enclosing.getLowerZ());
+    ivec3 high(enclosing.getUpperX(), enclosing.getUpperY(), enclosing.getUpperZ());
+    _numMeshChunks = glm::max((high - low + MESH_CHUNK_SIZE - 1) / MESH_CHUNK_SIZE, ivec3(1));
+    _meshChunks.resize(_numMeshChunks.x * _numMeshChunks.y * _numMeshChunks.z);
+
+    size_t index = 0;
+    loop3(ivec3(0), _numMeshChunks, [&](const ivec3& chunk) {
+        ivec3 chunkLow = low + chunk * MESH_CHUNK_SIZE;
+        ivec3 chunkHigh = glm::min(chunkLow + MESH_CHUNK_SIZE, high);
+        _meshChunks[index++].region = PolyVox::Region(PolyVox::Vector3DInt32(chunkLow.x, chunkLow.y, chunkLow.z),
+                                                      PolyVox::Vector3DInt32(chunkHigh.x, chunkHigh.y, chunkHigh.z));
     });
 }
 
+void RenderablePolyVoxEntityItem::markMeshChunksDirty(const ivec3& volDataVoxel) {
+    // a voxel changes the chunks that contain it, and through the normals and the collision hulls of the
+    // cubic styles, those that come within a voxel of it.  This assumes that the caller has write-locked the entity.
+    if (_meshChunks.empty()) {
+        return;
+    }
+    PolyVox::Region enclosing = _volData->getEnclosingRegion();
+    ivec3 voxel = volDataVoxel - ivec3(enclosing.getLowerX(), enclosing.getLowerY(), enclosing.getLowerZ());
+    ivec3 low = glm::max((voxel - 2) / MESH_CHUNK_SIZE, ivec3(0));
+    ivec3 high = glm::min((voxel + 1) / MESH_CHUNK_SIZE, _numMeshChunks - 1);
+    loop3(low, high + 1, [&](const ivec3& chunk) {
+        _meshChunks[(chunk.z * _numMeshChunks.y + chunk.y) * _numMeshChunks.x + chunk.x].dirty = true;
+    });
+}
+
+void RenderablePolyVoxEntityItem::markAllMeshChunksDirty() {
+    for (auto& chunk : _meshChunks) {
+        chunk.dirty = true;
+    }
+}
+
+std::vector<size_t> RenderablePolyVoxEntityItem::takeDirtyMeshChunks() {
+    std::vector<size_t> dirtyChunks;
+    for (size_t i = 0; i < _meshChunks.size(); ++i) {
+        if (_meshChunks[i].dirty) {
+            _meshChunks[i].dirty = false;
+            dirtyChunks.push_back(i);
+        }
+    }
+    return dirtyChunks;
+}
+
 bool inUserBounds(const std::shared_ptr<PolyVox::SimpleVolume<uint8_t>> vol,
                   PolyVoxEntityItem::PolyVoxSurfaceStyle surfaceStyle,
                   const ivec3& v) {
@@ -865,10 +937,10 @@ bool RenderablePolyVoxEntityItem::setVoxelInternal(const ivec3& v, uint8_t toVal
 
     result = updateOnCount(v, toValue);
 
-    if (isEdged()) {
-        _volData->setVoxelAt(v.x + 1, v.y + 1, v.z + 1, toValue);
-    } else {
-        _volData->setVoxelAt(v.x, v.y, v.z, toValue);
+    ivec3 volDataVoxel = isEdged() ? v + 1 : v;
+    if (_volData->getVoxelAt(volDataVoxel.x, volDataVoxel.y, volDataVoxel.z) != toValue) {
+        _volData->setVoxelAt(volDataVoxel.x, volDataVoxel.y, volDataVoxel.z, toValue);
+        markMeshChunksDirty(volDataVoxel);
     }
 
     if (glm::any(glm::equal(ivec3(0), v))) {
@@ -960,6 +1032,14 @@ void RenderablePolyVoxEntityItem::setVoxelsFromData(QByteArray uncompressedData,
 }
 
 void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
+    // a sculpting script edits many times a second, so while one compression is running the edits made meanwhile
+    // are only counted, and finishCompressing sends them all in one more.
+    if (_numUncompressedEdits++ == 0) {
+        startCompressing();
+    }
+}
+
+void RenderablePolyVoxEntityItem::startCompressing() {
     // compress the data in _volData and save the results.  The compressed form is used during
     // saves to disk and for transmission over the wire to the entity-server
 
@@ -979,6 +1059,7 @@ void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
 
     QtConcurrent::run([voxelXSize, voxelYSize, voxelZSize, entity, tree] {
         auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
+        int numEdits = polyVoxEntity->_numUncompressedEdits;
         QByteArray uncompressedData = polyVoxEntity->volDataToArray(voxelXSize, voxelYSize, voxelZSize);
 
         QByteArray newVoxelData;
@@ -994,6 +1075,7 @@ void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
             // HACK -- until we have a way to allow for properties larger than MTU, don't update.
             // revert the active voxel-space to the last version that fit.
             qCDebug(entitiesrenderer) << "compressed voxel data is too large" << entity->getName() << entity->getID();
+            polyVoxEntity->finishCompressing(numEdits);
             return;
         }
 
@@ -1001,7 +1083,10 @@ void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
         entity->setLastEdited(now);
         entity->setLastBroadcast(now);
 
-        std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->setVoxelData(newVoxelData);
+        // this came from _volData, which may have been edited again since, so it must not be decompressed back
+        polyVoxEntity->withWriteLock([&] {
+            polyVoxEntity->_voxelData = newVoxelData;
+        });
 
         tree->withReadLock([&] {
             EntityItemProperties properties = entity->getProperties();
@@ -1015,9 +1100,17 @@ void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
                 packetSender->queueEditEntityMessage(PacketType::EntityEdit, tree, entity->getID(), properties);
             }
         });
+        polyVoxEntity->finishCompressing(numEdits);
     });
 }
 
+void RenderablePolyVoxEntityItem::finishCompressing(int numEdits) {
+    // numEdits were counted before _volData was read, so anything beyond them may have been missed
+    if (_numUncompressedEdits.fetch_sub(numEdits) != numEdits) {
+        startCompressing();
+    }
+}
+
 EntityItemPointer lookUpNeighbor(EntityTreePointer tree, EntityItemID neighborID, EntityItemWeakPointer& currentWP) {
     EntityItemPointer current = currentWP.lock();
 
@@ -1075,10 +1168,13 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
             for (int y = 0; y < _volData->getHeight(); y++) {
                 for (int z = 0; z < _volData->getDepth(); z++) {
                     uint8_t neighborValue = currentXPNeighbor->getVoxel({ 0, y, z });
-                    if ((y == 0 || z == 0) && _volData->getVoxelAt(_volData->getWidth() - 1, y, z) != neighborValue) {
-                        bonkNeighbors();
+                    if (_volData->getVoxelAt(_volData->getWidth() - 1, y, z) != neighborValue) {
+                        if (y == 0 || z == 0) {
+                            bonkNeighbors();
+                        }
+                        _volData->setVoxelAt(_volData->getWidth() - 1, y, z, neighborValue);
+                        markMeshChunksDirty({ _volData->getWidth() - 1, y, z });
                     }
-                    _volData->setVoxelAt(_volData->getWidth() - 1, y, z, neighborValue);
                 }
             }
         });
@@ -1090,10 +1186,13 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
             for (int x = 0; x < _volData->getWidth(); x++) {
                 for (int z = 0; z < _volData->getDepth(); z++) {
                     uint8_t neighborValue = currentYPNeighbor->getVoxel({ x, 0, z });
-                    if ((x == 0 || z == 0) && _volData->getVoxelAt(x, _volData->getHeight() - 1, z) != neighborValue) {
-                        bonkNeighbors();
+                    if (_volData->getVoxelAt(x, _volData->getHeight() - 1, z) != neighborValue) {
+                        if (x == 0 || z == 0) {
+                            bonkNeighbors();
+                        }
+                        _volData->setVoxelAt(x, _volData->getHeight() - 1, z, neighborValue);
+                        markMeshChunksDirty({ x, _volData->getHeight() - 1, z });
                     }
-                    _volData->setVoxelAt(x, _volData->getHeight() - 1, z, neighborValue);
                 }
             }
         });
@@ -1105,74 +1204,202 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
             for (int x = 0; x < _volData->getWidth(); x++) {
                 for (int y = 0; y < _volData->getHeight(); y++) {
                     uint8_t neighborValue = currentZPNeighbor->getVoxel({ x, y, 0 });
-                    _volData->setVoxelAt(x, y, _volData->getDepth() - 1, neighborValue);
-                    if ((x == 0 || y == 0) && _volData->getVoxelAt(x, y, _volData->getDepth() - 1) != neighborValue) {
-                        bonkNeighbors();
+                    if (_volData->getVoxelAt(x, y, _volData->getDepth() - 1) != neighborValue) {
+                        if (x == 0 || y == 0) {
+                            bonkNeighbors();
+                        }
+                        _volData->setVoxelAt(x, y, _volData->getDepth() - 1, neighborValue);
+                        markMeshChunksDirty({ x, y, _volData->getDepth() - 1 });
                     }
-                    _volData->setVoxelAt(x, y, _volData->getDepth() - 1, neighborValue);
                 }
             }
         });
     }
 }
 
+void RenderablePolyVoxEntityItem::extractMeshChunk(PolyVox::SimpleVolume<uint8_t>* volData,
+                                                   PolyVoxSurfaceStyle voxelSurfaceStyle, MeshChunk& chunk) {
+    // A mesh object to hold the result of surface extraction
+    PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+
+    bool marchingCubes = voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
+        voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES;
+    if (marchingCubes) {
+        PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+            (volData, chunk.region, &polyVoxMesh);
+        surfaceExtractor.execute();
+    } else {
+        PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+            (volData, chunk.region, &polyVoxMesh);
+        surfaceExtractor.execute();
+    }
+
+    // the extractors place vertices relative to the region
+    glm::vec3 offset(chunk.region.getLowerX(), chunk.region.getLowerY(), chunk.region.getLowerZ());
+    chunk.vertices = polyVoxMesh.getRawVertexData();
+    for (auto& vertex : chunk.vertices) {
+        PolyVox::Vector3DFloat position = vertex.getPosition();
+        vertex.setPosition(PolyVox::Vector3DFloat(position.getX() + offset.x,
+                                                  position.getY() + offset.y,
+                                                  position.getZ() + offset.z));
+    }
+    chunk.indices = polyVoxMesh.getIndices();
+
+    chunk.hulls.clear();
+    if (marchingCubes) {
+        // pull each triangle in the mesh into a polyhedron which can be collided with
+        const auto& vertices = chunk.vertices;
+        for (size_t i = 0; i + 2 < chunk.indices.size(); i += 3) {
+            const auto& p0Position = vertices[chunk.indices[i]].getPosition();
+            const auto& p1Position = vertices[chunk.indices[i + 1]].getPosition();
+            const auto& p2Position = vertices[chunk.indices[i + 2]].getPosition();
+            glm::vec3 p0(p0Position.getX(), p0Position.getY(), p0Position.getZ());
+            glm::vec3 p1(p1Position.getX(), p1Position.getY(), p1Position.getZ());
+            glm::vec3 p2(p2Position.getX(), p2Position.getY(), p2Position.getZ());
+
+            glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
+            glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+            glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
+
+            QVector<glm::vec3> pointsInPart;
+            pointsInPart << p0 << p1 << p2 << p3;
+            chunk.hulls << pointsInPart;
+        }
+        return;
+    }
+
+    // each chunk hulls the voxels from its lower faces up to, but not including, the upper faces it shares
+    PolyVox::Region enclosing = volData->getEnclosingRegion();
+    ivec3 low(chunk.region.getLowerX(), chunk.region.getLowerY(), chunk.region.getLowerZ());
+    ivec3 high(chunk.region.getUpperX(), chunk.region.getUpperY(), chunk.region.getUpperZ());
+    ivec3 enclosingHigh(enclosing.getUpperX(), enclosing.getUpperY(), enclosing.getUpperZ());
+    high += ivec3(glm::equal(high, enclosingHigh));
+
+    // user voxels are inset by one in the edged styles, and the others keep an extra layer on their upper faces
+    ivec3 userOffset = ivec3(PolyVoxEntityItem::isEdged(voxelSurfaceStyle) ? 1 : 0);
+    ivec3 userLow = userOffset;
+    ivec3 userHigh = ivec3(volData->getWidth(), volData->getHeight(), volData->getDepth()) - userOffset * 2;
+    if (!PolyVoxEntityItem::isEdged(voxelSurfaceStyle)) {
+        userHigh -= 1;
+    }
+    userHigh += userOffset;
+
+    loop3(glm::max(low, userLow), glm::min(high, userHigh), [&](const ivec3& v) {
+        if (volData->getVoxelAt(v.x, v.y, v.z) == 0) {
+            return;
+        }
+        if (glm::all(glm::greaterThan(v, userLow)) &&
+            glm::all(glm::lessThan(v, userHigh - 1)) &&
+            volData->getVoxelAt(v.x - 1, v.y, v.z) > 0 &&
+            volData->getVoxelAt(v.x, v.y - 1, v.z) > 0 &&
+            volData->getVoxelAt(v.x, v.y, v.z - 1) > 0 &&
+            volData->getVoxelAt(v.x + 1, v.y, v.z) > 0 &&
+            volData->getVoxelAt(v.x, v.y + 1, v.z) > 0 &&
+            volData->getVoxelAt(v.x, v.y, v.z + 1) > 0) {
+            // this voxel has neighbors in every cardinal direction, so there's no need
+            // to include it in the collision hull.
+            return;
+        }
+
+        QVector<glm::vec3> pointsInPart;
+        glm::vec3 center(v);
+        loop3(ivec3(0), ivec3(2), [&](const ivec3& corner) {
+            pointsInPart << center + glm::vec3(corner) - 0.5f;
+        });
+        chunk.hulls << pointsInPart;
+    });
+}
+
 void RenderablePolyVoxEntityItem::recomputeMesh() {
     // use _volData to make a renderable mesh
+    cacheNeighbors();
+    copyUpperEdgesFromNeighbors();
+
     PolyVoxSurfaceStyle voxelSurfaceStyle;
-    withReadLock([&] {
+    uint32_t meshChunksGeneration;
+    std::vector<size_t> dirtyChunks;
+    bool hasMesh;
+    withWriteLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
+        meshChunksGeneration = _meshChunksGeneration;
+        dirtyChunks = takeDirtyMeshChunks();
+        hasMesh = (bool)_mesh;
+        if (dirtyChunks.empty() && hasMesh) {
+            // none of the voxels changed, as when our own edit comes back from the entity-server
+            _meshing = false;
+            _meshReady = true;
+        }
     });
-
-    cacheNeighbors();
-    copyUpperEdgesFromNeighbors();
+    if (dirtyChunks.empty() && hasMesh) {
+        return;
+    }
 
     auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
-    QtConcurrent::run([entity, voxelSurfaceStyle] {
-        graphics::MeshPointer mesh(new graphics::Mesh());
-
-        // A mesh object to hold the result of surface extraction
-        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+    QtConcurrent::run([entity, voxelSurfaceStyle, meshChunksGeneration, dirtyChunks] {
+        MeshChunks updatedChunks(dirtyChunks.size());
+        std::vector<PolyVox::PositionMaterialNormal> vecVertices;
+        std::vector<uint32_t> vecIndices;
+        bool current = false;
 
         entity->withReadLock([&] {
+            current = entity->_meshChunksGeneration == meshChunksGeneration;
+            if (!current) {
+                return;
+            }
+
+            // the volume is only read while the lock is held, so the chunks can all be extracted at once
             PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
-            switch (voxelSurfaceStyle) {
-                case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+            const MeshChunks& chunks = entity->_meshChunks;
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, dirtyChunks.size()), [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i != range.end(); ++i) {
+                    updatedChunks[i].region = chunks[dirtyChunks[i]].region;
+                    extractMeshChunk(volData, voxelSurfaceStyle, updatedChunks[i]);
                 }
-                case PolyVoxEntityItem::SURFACE_EDGED_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+            });
+
+            // stitch the new chunks and the unchanged ones into one mesh
+            auto chunkAt = [&](size_t index, size_t& nextUpdated) -> const MeshChunk& {
+                if (nextUpdated < dirtyChunks.size() && dirtyChunks[nextUpdated] == index) {
+                    return updatedChunks[nextUpdated++];
                 }
-                case PolyVoxEntityItem::SURFACE_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+                return chunks[index];
+            };
+            size_t numVertices = 0;
+            size_t numIndices = 0;
+            size_t nextUpdated = 0;
+            for (size_t i = 0; i < chunks.size(); ++i) {
+                const MeshChunk& chunk = chunkAt(i, nextUpdated);
+                numVertices += chunk.vertices.size();
+                numIndices += chunk.indices.size();
+            }
+            vecVertices.reserve(numVertices);
+            vecIndices.reserve(numIndices);
+            nextUpdated = 0;
+            for (size_t i = 0; i < chunks.size(); ++i) {
+                const MeshChunk& chunk = chunkAt(i, nextUpdated);
+                uint32_t baseVertex = (uint32_t)vecVertices.size();
+                vecVertices.insert(vecVertices.end(), chunk.vertices.begin(), chunk.vertices.end());
+                for (uint32_t index : chunk.indices) {
+                    vecIndices.push_back(baseVertex + index);
                 }
             }
         });
 
+        if (!current) {
+            // _volData was reallocated, and all of it will be meshed again
+            entity->setMesh(nullptr, meshChunksGeneration, dirtyChunks, updatedChunks);
+            return;
+        }
+
         // convert PolyVox mesh to a Sam mesh
-        const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
+        graphics::MeshPointer mesh(new graphics::Mesh());
         auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
                                                          (gpu::Byte*)vecIndices.data());
         auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
         gpu::BufferView indexBufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::INDEX));
         mesh->setIndexBuffer(indexBufferView);
 
-        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getRawVertexData();
         auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
                                                           (gpu::Byte*)vecVertices.data());
         auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
@@ -1198,14 +1425,28 @@ void RenderablePolyVoxEntityItem::recomputeMesh() {
                                              graphics::Mesh::TRIANGLES)); // topology
         mesh->setPartBuffer(gpu::BufferView(new gpu::Buffer(parts.size() * sizeof(graphics::Mesh::Part),
                                                             (gpu::Byte*) parts.data()), gpu::Element::PART_DRAWCALL));
-        entity->setMesh(mesh);
+        entity->setMesh(mesh, meshChunksGeneration, dirtyChunks, updatedChunks);
     });
 }
 
-void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh) {
+void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh, uint32_t meshChunksGeneration,
+                                          const std::vector<size_t>& chunkIndices, MeshChunks& chunks) {
     // this catches the payload from recomputeMesh
-    bool neighborsNeedUpdate;
+    bool neighborsNeedUpdate = false;
+    bool current = false;
     withWriteLock([&] {
+        _meshing = false;
+        current = mesh && meshChunksGeneration == _meshChunksGeneration;
+        if (!current) {
+            return;
+        }
+        for (size_t i = 0; i < chunkIndices.size(); ++i) {
+            auto& chunk = _meshChunks[chunkIndices[i]];
+            chunk.vertices.swap(chunks[i].vertices);
+            chunk.indices.swap(chunks[i].indices);
+            chunk.hulls.swap(chunks[i].hulls);
+        }
+
         if (!_collisionless) {
             _flags |= Simulation::DIRTY_SHAPE | Simulation::DIRTY_MASS;
         }
@@ -1215,6 +1456,9 @@ void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh) {
         neighborsNeedUpdate = _neighborsNeedUpdate;
         _neighborsNeedUpdate = false;
     });
+    if (!current) {
+        return;
+    }
     if (neighborsNeedUpdate) {
         bonkNeighbors();
     }
@@ -1223,136 +1467,46 @@ void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh) {
 }
 
 void RenderablePolyVoxEntityItem::computeShapeInfoWorker() {
-    // this creates a collision-shape for the physics engine.  The shape comes from
-    // _volData for cubic extractors and from _mesh for marching-cube extractors
+    // this creates a collision-shape for the physics engine.  The hulls were made along with the mesh, in voxel
+    // coords, one chunk at a time, and only need gathering and moving into the entity's frame.
     if (!_meshReady) {
         return;
     }
 
     EntityItemPointer entity = getThisPointer();
 
-    PolyVoxSurfaceStyle voxelSurfaceStyle;
-    glm::vec3 voxelVolumeSize;
-    graphics::MeshPointer mesh;
-
+    // these share their points with the chunks until the chunks are next extracted
+    std::vector<ShapeInfo::PointCollection> chunkHulls;
     withReadLock([&] {
-        voxelSurfaceStyle = _voxelSurfaceStyle;
-        voxelVolumeSize = _voxelVolumeSize;
-        mesh = _mesh;
+        chunkHulls.reserve(_meshChunks.size());
+        for (const auto& chunk : _meshChunks) {
+            chunkHulls.push_back(chunk.hulls);
+        }
     });
 
-    QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize, mesh] {
+    QtConcurrent::run([entity, chunkHulls] {
         auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
         QVector<QVector<glm::vec3>> pointCollection;
         AABox box;
-        glm::mat4 vtoM = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->voxelToLocalMatrix();
-
-        if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
-            voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES) {
-            // pull each triangle in the mesh into a polyhedron which can be collided with
-            unsigned int i = 0;
-
-            const gpu::BufferView& vertexBufferView = mesh->getVertexBuffer();
-            const gpu::BufferView& indexBufferView = mesh->getIndexBuffer();
-
-            gpu::BufferView::Iterator<const uint32_t> it = indexBufferView.cbegin<uint32_t>();
-            while (it != indexBufferView.cend<uint32_t>()) {
-                uint32_t p0Index = *(it++);
-                uint32_t p1Index = *(it++);
-                uint32_t p2Index = *(it++);
-
-                const glm::vec3& p0 = vertexBufferView.get<const glm::vec3>(p0Index);
-                const glm::vec3& p1 = vertexBufferView.get<const glm::vec3>(p1Index);
-                const glm::vec3& p2 = vertexBufferView.get<const glm::vec3>(p2Index);
-
-                glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
-                glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
-                glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
-
-                glm::vec3 p0Model = glm::vec3(vtoM * glm::vec4(p0, 1.0f));
-                glm::vec3 p1Model = glm::vec3(vtoM * glm::vec4(p1, 1.0f));
-                glm::vec3 p2Model = glm::vec3(vtoM * glm::vec4(p2, 1.0f));
-                glm::vec3 p3Model = glm::vec3(vtoM * glm::vec4(p3, 1.0f));
-
-                box += p0Model;
-                box += p1Model;
-                box += p2Model;
-                box += p3Model;
+        glm::mat4 vtoM = polyVoxEntity->voxelToLocalMatrix();
 
+        int numHulls = 0;
+        for (const auto& hulls : chunkHulls) {
+            numHulls += hulls.size();
+        }
+        pointCollection.reserve(numHulls);
+        for (const auto& hulls : chunkHulls) {
+            for (const auto& hull : hulls) {
                 QVector<glm::vec3> pointsInPart;
-                pointsInPart << p0Model;
-                pointsInPart << p1Model;
-                pointsInPart << p2Model;
-                pointsInPart << p3Model;
+                pointsInPart.reserve(hull.size());
+                for (const auto& point : hull) {
+                    glm::vec3 pointModel = glm::vec3(vtoM * glm::vec4(point, 1.0f));
+                    box += pointModel;
+                    pointsInPart << pointModel;
+                }
                 // add next convex hull
-                QVector<glm::vec3> newMeshPoints;
-                pointCollection << newMeshPoints;
-                // add points to the new convex hull
-                pointCollection[i++] << pointsInPart;
+                pointCollection << pointsInPart;
             }
-        } else {
-            unsigned int i = 0;
-            polyVoxEntity->forEachVoxelValue(voxelVolumeSize, [&](const ivec3& v, uint8_t value) {
-                if (value > 0) {
-                    const auto& x = v.x;
-                    const auto& y = v.y;
-                    const auto& z = v.z;
-                    if (glm::all(glm::greaterThan(v, ivec3(0))) && 
-                        glm::all(glm::lessThan(v, ivec3(voxelVolumeSize) - 1)) && 
-                        (polyVoxEntity->getVoxelInternal({ x - 1, y, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y - 1, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y, z - 1 }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x + 1, y, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y + 1, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y, z + 1 }) > 0)) {
-                        // this voxel has neighbors in every cardinal direction, so there's no need
-                        // to include it in the collision hull.
-                        return;
-                    }
-
-                    QVector<glm::vec3> pointsInPart;
-
-                    float offL = -0.5f;
-                    float offH = 0.5f;
-                    if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_CUBIC) {
-                        offL += 1.0f;
-                        offH += 1.0f;
-                    }
-
-                    glm::vec3 p000 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offL, 1.0f));
-                    glm::vec3 p001 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offH, 1.0f));
-                    glm::vec3 p010 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offL, 1.0f));
-                    glm::vec3 p011 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offH, 1.0f));
-                    glm::vec3 p100 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offL, 1.0f));
-                    glm::vec3 p101 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offH, 1.0f));
-                    glm::vec3 p110 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offL, 1.0f));
-                    glm::vec3 p111 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offH, 1.0f));
-
-                    box += p000;
-                    box += p001;
-                    box += p010;
-                    box += p011;
-                    box += p100;
-                    box += p101;
-                    box += p110;
-                    box += p111;
-
-                    pointsInPart << p000;
-                    pointsInPart << p001;
-                    pointsInPart << p010;
-                    pointsInPart << p011;
-                    pointsInPart << p100;
-                    pointsInPart << p101;
-                    pointsInPart << p110;
-                    pointsInPart << p111;
-
-                    // add next convex hull
-                    QVector<glm::vec3> newMeshPoints;
-                    pointCollection << newMeshPoints;
-                    // add points to the new convex hull
-                    pointCollection[i++] << pointsInPart;
-                }
-            });
         }
         polyVoxEntity->setCollisionPoints(pointCollection, box);
     });
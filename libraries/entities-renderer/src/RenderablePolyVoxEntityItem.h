@@ -13,11 +13,13 @@
 #define hifi_RenderablePolyVoxEntityItem_h
 
 #include <atomic>
+#include <vector>
 
 #include <QSemaphore>
 
 #include <PolyVoxCore/SimpleVolume.h>
 #include <PolyVoxCore/Raycast.h>
+#include <PolyVoxCore/SurfaceMesh.h>
 
 #include <gpu/Forward.h>
 #include <gpu/Context.h>
@@ -107,7 +109,6 @@ public:
     void forEachVoxelValue(const ivec3& voxelSize, std::function<void(const ivec3&, uint8_t)> thunk);
     QByteArray volDataToArray(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) const;
 
-    void setMesh(graphics::MeshPointer mesh);
     void setCollisionPoints(ShapeInfo::PointCollection points, AABox box);
     PolyVox::SimpleVolume<uint8_t>* getVolData() { return _volData.get(); }
 
@@ -116,10 +117,37 @@ public:
 
     void setVolDataDirty() { withWriteLock([&] { _volDataDirty = true; _meshReady = false; }); }
 
+    // indices of the mesh chunks changed since this was last called, which recomputeMesh() extracts again.  This
+    // assumes that the caller has write-locked the entity.
+    std::vector<size_t> takeDirtyMeshChunks();
+
     bool getMeshes(MeshProxyList& result) override; // deprecated
     virtual scriptable::ScriptableModelBase getScriptableModel() override;
 
 private:
+    // The volume is meshed and hulled in chunks of MESH_CHUNK_SIZE voxels a side, so that an edit only redoes the
+    // chunks around the voxels it changed.  Neighboring chunks share the voxels on their common face, which is what
+    // lets the surface extractors knit their meshes together.
+    class MeshChunk {
+    public:
+        PolyVox::Region region; // in _volData coords, inclusive
+        std::vector<PolyVox::PositionMaterialNormal> vertices; // in _volData coords
+        std::vector<uint32_t> indices; // into vertices
+        ShapeInfo::PointCollection hulls; // in _volData coords
+        bool dirty { true };
+    };
+    using MeshChunks = std::vector<MeshChunk>;
+
+    void resetMeshChunks();
+    void markMeshChunksDirty(const ivec3& volDataVoxel);
+    void markAllMeshChunksDirty();
+    static void extractMeshChunk(PolyVox::SimpleVolume<uint8_t>* volData, PolyVoxSurfaceStyle voxelSurfaceStyle,
+                                 MeshChunk& chunk);
+    void setMesh(graphics::MeshPointer mesh, uint32_t meshChunksGeneration,
+                 const std::vector<size_t>& chunkIndices, MeshChunks& chunks);
+    void startCompressing();
+    void finishCompressing(int numEdits);
+
     bool updateOnCount(const ivec3& v, uint8_t toValue);
     PolyVox::RaycastResult doRayCast(glm::vec4 originInVoxel, glm::vec4 farInVoxel, glm::vec4& result) const;
 
@@ -147,6 +175,14 @@ private:
     bool _volDataDirty { false }; // does recomputeMesh need to be called?
     int _onCount; // how many non-zero voxels are in _volData
 
+    MeshChunks _meshChunks;
+    glm::ivec3 _numMeshChunks { 0 };
+    uint32_t _meshChunksGeneration { 0 }; // bumped whenever _volData is reallocated
+    bool _meshing { false }; // is recomputeMesh running?
+
+    // edits not yet compressed into _voxelData.  One compression runs at a time and takes in all of them.
+    std::atomic<int> _numUncompressedEdits { 0 };
+
     bool _neighborsNeedUpdate { false };
 
     // these are cached lookups of _xNNeighborID, _yNNeighborID, _zNNeighborID, _xPNeighborID, _yPNeighborID, _zPNeighborID
@@ -120,6 +120,8 @@ public:
     HFMModel* extractHFMModel(const hifi::VariantHash& mapping, const QString& url);
 
     static ExtractedMesh extractMesh(const FBXNode& object, unsigned int& meshIndex, bool deduplicate);
+    // Extracts every mesh under the "Objects" node in parallel, keyed by object ID, with mesh indices in document order
+    static void extractMeshes(const FBXNode& rootNode, bool deduplicate, QMap<QString, ExtractedMesh>& meshes, unsigned int& meshIndex);
     QHash<QString, ExtractedMesh> meshes;
 
     HFMTexture getTexture(const QString& textureID, const QString& materialID);
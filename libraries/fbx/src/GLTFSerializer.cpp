@@ -11,6 +11,8 @@
 
 #include "GLTFSerializer.h"
 
+#include <algorithm>
+
 #include <QtCore/QBuffer>
 #include <QtCore/QIODevice>
 #include <QtCore/QEventLoop>
@@ -32,6 +34,7 @@
 #include <NetworkAccessManager.h>
 #include <ResourceManager.h>
 #include <PathUtils.h>
+#include <TBBHelpers.h>
 #include <image/ColorChannel.h>
 #include <FaceshiftConstants.h>
 
@@ -407,11 +410,8 @@ bool GLTFSerializer::addBuffer(const QJsonObject& object) {
             return false;
         }
     }
-    if (getStringVal(object, "uri", buffer.uri, buffer.defined)) {
-        if (!readBinary(buffer.uri, buffer.blob)) {
-            return false;
-        }
-    }
+    // the blob of a buffer with a uri is filled in later by loadBuffers
+    getStringVal(object, "uri", buffer.uri, buffer.defined);
     _file.buffers.push_back(buffer);
     
     return true;
@@ -690,6 +690,7 @@ bool GLTFSerializer::parseGLTF(const hifi::ByteArray& data) {
                     success = success && addBuffer(bufVal.toObject());
                 }
             }
+            success = success && loadBuffers();
         }
 
         QJsonArray cameras;
@@ -1662,17 +1663,81 @@ HFMModel::Pointer GLTFSerializer::read(const hifi::ByteArray& data, const hifi::
     return nullptr;
 }
 
-bool GLTFSerializer::readBinary(const QString& url, hifi::ByteArray& outdata) {
-    bool success;
+bool GLTFSerializer::loadBuffers() {
+    static const QString EMBEDDED_DATA_PREFIX = "data:application/octet-stream;base64,";
 
-    if (url.contains("data:application/octet-stream;base64,")) {
-        outdata = requestEmbeddedData(url);
-        success = !outdata.isEmpty();
-    } else {
-        hifi::URL binaryUrl = _url.resolved(url);
-        std::tie<bool, hifi::ByteArray>(success, outdata) = requestData(binaryUrl);
+    std::vector<int> embeddedBuffers;
+    std::vector<int> externalBuffers;
+    for (int i = 0; i < _file.buffers.size(); i++) {
+        const auto& buffer = _file.buffers[i];
+        if (!buffer.defined.value("uri")) {
+            continue;
+        }
+        if (buffer.uri.contains(EMBEDDED_DATA_PREFIX)) {
+            embeddedBuffers.push_back(i);
+        } else {
+            externalBuffers.push_back(i);
+        }
     }
-    
+
+    // Decoding large base64 buffers is CPU bound, so decode them in parallel
+    // (data() detaches the vector once here rather than concurrently in the workers)
+    GLTFBuffer* buffers = _file.buffers.data();
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, embeddedBuffers.size(), 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            auto& buffer = buffers[embeddedBuffers[i]];
+            buffer.blob = requestEmbeddedData(buffer.uri);
+        }
+    });
+    bool success = std::all_of(embeddedBuffers.cbegin(), embeddedBuffers.cend(), [&](int index) {
+        return !_file.buffers[index].blob.isEmpty();
+    });
+
+    // Send every request up front and wait for all of them in a single event loop, rather than one download at a time
+    if (success && !externalBuffers.empty()) {
+        auto resourceManager = DependencyManager::get<ResourceManager>();
+        std::vector<ResourceRequest*> requests;
+        for (int index : externalBuffers) {
+            hifi::URL binaryUrl = _url.resolved(_file.buffers[index].uri);
+            auto request = resourceManager->createResourceRequest(nullptr, binaryUrl, true, -1, "GLTFSerializer::loadBuffers");
+            if (!request) {
+                success = false;
+                break;
+            }
+            requests.push_back(request);
+        }
+
+        if (success) {
+            QEventLoop loop;
+            int pendingRequests = (int)requests.size();
+            for (auto request : requests) {
+                QObject::connect(request, &ResourceRequest::finished, &loop, [&loop, &pendingRequests] {
+                    if (--pendingRequests == 0) {
+                        loop.quit();
+                    }
+                });
+            }
+            for (auto request : requests) {
+                request->send();
+            }
+            if (pendingRequests > 0) {
+                loop.exec();
+            }
+
+            for (size_t i = 0; i < requests.size(); i++) {
+                if (requests[i]->getResult() == ResourceRequest::Success) {
+                    _file.buffers[externalBuffers[i]].blob = requests[i]->getData();
+                } else {
+                    success = false;
+                }
+            }
+        }
+
+        for (auto request : requests) {
+            request->deleteLater();
+        }
+    }
+
     return success;
 }
 
@@ -1684,26 +1749,6 @@ bool GLTFSerializer::doesResourceExist(const QString& url) {
     return DependencyManager::get<ResourceManager>()->resourceExists(candidateUrl);
 }
 
-std::tuple<bool, hifi::ByteArray> GLTFSerializer::requestData(hifi::URL& url) {
-    auto request = DependencyManager::get<ResourceManager>()->createResourceRequest(
-        nullptr, url, true, -1, "GLTFSerializer::requestData");
-
-    if (!request) {
-        return std::make_tuple(false, hifi::ByteArray());
-    }
-
-    QEventLoop loop;
-    QObject::connect(request, &ResourceRequest::finished, &loop, &QEventLoop::quit);
-    request->send();
-    loop.exec();
-
-    if (request->getResult() == ResourceRequest::Success) {
-        return std::make_tuple(true, request->getData());
-    } else {
-        return std::make_tuple(false, hifi::ByteArray());
-    }
-}
-
 hifi::ByteArray GLTFSerializer::requestEmbeddedData(const QString& url) {
     QString binaryUrl = url.split(",")[1]; 
     return binaryUrl.isEmpty() ? hifi::ByteArray() : QByteArray::fromBase64(binaryUrl.toUtf8());
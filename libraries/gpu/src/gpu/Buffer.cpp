@@ -149,6 +149,12 @@ Buffer::Size Buffer::setSubData(Size offset, Size size, const Byte* data) {
     return changedBytes;
 }
 
+Byte* Buffer::editSubData(Size offset, Size size) {
+    assert(offset + size <= _end);
+    markDirty(offset, size);
+    return editData() + offset;
+}
+
 Buffer::Size Buffer::append(Size size, const Byte* data) {
     auto offset = _end;
     resize(_end + size);
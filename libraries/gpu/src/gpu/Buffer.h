@@ -90,6 +90,15 @@ public:
         return setSubData(offset, size, reinterpret_cast<const Byte*>(&t[0]));
     }
 
+    // Mark a range of the buffer as changed and return it to be written in place, instead of copying it in
+    // \return the first byte of the range, which must lie within the current size
+    Byte* editSubData(Size offset, Size size);
+
+    template <typename T>
+    T* editSubData(Size index, Size count) {
+        return reinterpret_cast<T*>(editSubData(index * sizeof(T), count * sizeof(T)));
+    }
+
     // Append new data at the end of the current buffer
     // do a resize( size + getSize) and copy the new data
     // \return the number of bytes copied
@@ -0,0 +1,103 @@
+//
+//  MeshKernels_avx2.cpp
+//  model-baker/src/avx2
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+
+#include <NumericalConstants.h>
+
+#include "../model-baker/MeshKernels.h"
+
+namespace baker {
+
+void faceNormals_AVX2(const float* ax, const float* ay, const float* az,
+                      const float* bx, const float* by, const float* bz,
+                      const float* cx, const float* cy, const float* cz,
+                      float* nx, float* ny, float* nz, int count) {
+    int i = 0;
+    for (; i < count - 7; i += 8) {
+        __m256 x0 = _mm256_loadu_ps(&ax[i]);
+        __m256 y0 = _mm256_loadu_ps(&ay[i]);
+        __m256 z0 = _mm256_loadu_ps(&az[i]);
+
+        __m256 e0x = _mm256_sub_ps(_mm256_loadu_ps(&bx[i]), x0);
+        __m256 e0y = _mm256_sub_ps(_mm256_loadu_ps(&by[i]), y0);
+        __m256 e0z = _mm256_sub_ps(_mm256_loadu_ps(&bz[i]), z0);
+        __m256 e1x = _mm256_sub_ps(_mm256_loadu_ps(&cx[i]), x0);
+        __m256 e1y = _mm256_sub_ps(_mm256_loadu_ps(&cy[i]), y0);
+        __m256 e1z = _mm256_sub_ps(_mm256_loadu_ps(&cz[i]), z0);
+
+        _mm256_storeu_ps(&nx[i], _mm256_fmsub_ps(e0y, e1z, _mm256_mul_ps(e0z, e1y)));
+        _mm256_storeu_ps(&ny[i], _mm256_fmsub_ps(e0z, e1x, _mm256_mul_ps(e0x, e1z)));
+        _mm256_storeu_ps(&nz[i], _mm256_fmsub_ps(e0x, e1y, _mm256_mul_ps(e0y, e1x)));
+    }
+    faceNormals_scalar(&ax[i], &ay[i], &az[i], &bx[i], &by[i], &bz[i], &cx[i], &cy[i], &cz[i],
+                       &nx[i], &ny[i], &nz[i], count - i);
+}
+
+void edgeTangents_AVX2(const float* nx, const float* ny, const float* nz,
+                       const float* ex, const float* ey, const float* ez,
+                       const float* ds, const float* dt,
+                       float* tx, float* ty, float* tz, int count) {
+    const __m256 epsilon = _mm256_set1_ps(EPSILON);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    int i = 0;
+    for (; i < count - 7; i += 8) {
+        __m256 n0 = _mm256_loadu_ps(&nx[i]);
+        __m256 n1 = _mm256_loadu_ps(&ny[i]);
+        __m256 n2 = _mm256_loadu_ps(&nz[i]);
+        __m256 e0 = _mm256_loadu_ps(&ex[i]);
+        __m256 e1 = _mm256_loadu_ps(&ey[i]);
+        __m256 e2 = _mm256_loadu_ps(&ez[i]);
+
+        // bitangent = n x e
+        __m256 b0 = _mm256_fmsub_ps(n1, e2, _mm256_mul_ps(n2, e1));
+        __m256 b1 = _mm256_fmsub_ps(n2, e0, _mm256_mul_ps(n0, e2));
+        __m256 b2 = _mm256_fmsub_ps(n0, e1, _mm256_mul_ps(n1, e0));
+        __m256 bitangentLength = _mm256_sqrt_ps(_mm256_fmadd_ps(b2, b2, _mm256_fmadd_ps(b1, b1, _mm256_mul_ps(b0, b0))));
+        __m256 valid = _mm256_cmp_ps(bitangentLength, epsilon, _CMP_GE_OQ);
+        b0 = _mm256_div_ps(b0, bitangentLength);
+        b1 = _mm256_div_ps(b1, bitangentLength);
+        b2 = _mm256_div_ps(b2, bitangentLength);
+
+        __m256 normalLength = _mm256_sqrt_ps(_mm256_fmadd_ps(n2, n2, _mm256_fmadd_ps(n1, n1, _mm256_mul_ps(n0, n0))));
+        n0 = _mm256_div_ps(n0, normalLength);
+        n1 = _mm256_div_ps(n1, normalLength);
+        n2 = _mm256_div_ps(n2, normalLength);
+
+        // cos and sin of the texture coordinate rotation, (1, 0) when the delta is zero
+        __m256 s0 = _mm256_loadu_ps(&ds[i]);
+        __m256 t0 = _mm256_loadu_ps(&dt[i]);
+        __m256 r = _mm256_sqrt_ps(_mm256_fmadd_ps(t0, t0, _mm256_mul_ps(s0, s0)));
+        __m256 nonZero = _mm256_cmp_ps(r, zero, _CMP_GT_OQ);
+        __m256 c = _mm256_blendv_ps(one, _mm256_div_ps(s0, r), nonZero);
+        __m256 s = _mm256_and_ps(nonZero, _mm256_div_ps(t0, r));
+
+        // t = c * (b x n) + s * b
+        __m256 r0 = _mm256_fmadd_ps(c, _mm256_fmsub_ps(b1, n2, _mm256_mul_ps(b2, n1)), _mm256_mul_ps(s, b0));
+        __m256 r1 = _mm256_fmadd_ps(c, _mm256_fmsub_ps(b2, n0, _mm256_mul_ps(b0, n2)), _mm256_mul_ps(s, b1));
+        __m256 r2 = _mm256_fmadd_ps(c, _mm256_fmsub_ps(b0, n1, _mm256_mul_ps(b1, n0)), _mm256_mul_ps(s, b2));
+
+        _mm256_storeu_ps(&tx[i], _mm256_and_ps(valid, r0));
+        _mm256_storeu_ps(&ty[i], _mm256_and_ps(valid, r1));
+        _mm256_storeu_ps(&tz[i], _mm256_and_ps(valid, r2));
+    }
+    edgeTangents_scalar(&nx[i], &ny[i], &nz[i], &ex[i], &ey[i], &ez[i], &ds[i], &dt[i],
+                        &tx[i], &ty[i], &tz[i], count - i);
+
+    _mm256_zeroupper();
+}
+
+};
+
+#endif
@@ -21,6 +21,10 @@
 #include "ParseMaterialMappingTask.h"
 
 namespace baker {
+    // Whenever a change is made to the baker that changes its output, this value should be incremented.
+    // Processed models are persisted by content and baker version, so this discards models baked by older versions.
+    static const int BAKER_VERSION = 1;
+
     class Baker {
     public:
         Baker(const hfm::Model::Pointer& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& materialMappingBaseURL);
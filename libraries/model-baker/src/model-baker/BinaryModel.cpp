@@ -0,0 +1,610 @@
+//
+//  BinaryModel.cpp
+//  model-baker/src/model-baker
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BinaryModel.h"
+
+#include <cstring>
+
+#include <QDataStream>
+
+namespace {
+
+const uint32_t BINARY_MODEL_MAGIC = 0x424D4648; // "HFMB"
+const size_t ARRAY_ALIGNMENT = 16;
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t length;
+};
+
+class Writer {
+public:
+    Writer() { _buffer.resize(sizeof(Header)); }
+
+    template <typename T>
+    void write(const T& value) { append(&value, sizeof(T)); }
+
+    void writeCount(size_t count) { write<uint32_t>((uint32_t)count); }
+
+    template <typename T>
+    void writeArray(const T* data, size_t count) {
+        writeCount(count);
+        align();
+        append(data, count * sizeof(T));
+    }
+
+    template <typename T>
+    void writeArray(const QVector<T>& array) { writeArray(array.constData(), array.size()); }
+
+    template <typename T>
+    void writeArray(const std::vector<T>& array) { writeArray(array.data(), array.size()); }
+
+    void writeBytes(const QByteArray& bytes) { writeArray(bytes.constData(), bytes.size()); }
+    void writeString(const QString& string) { writeBytes(string.toUtf8()); }
+
+    void writeTransform(const Transform& transform) {
+        write(transform.getTranslation());
+        write(transform.getRotation());
+        write(transform.getScale());
+    }
+
+    void writeExtents(const Extents& extents) {
+        write(extents.minimum);
+        write(extents.maximum);
+    }
+
+    void writeVariant(const QVariant& variant) {
+        QByteArray bytes;
+        QDataStream stream(&bytes, QIODevice::WriteOnly);
+        stream << variant;
+        writeBytes(bytes);
+    }
+
+    hifi::ByteArray finish() {
+        Header header { BINARY_MODEL_MAGIC, baker::BINARY_MODEL_VERSION, (uint64_t)_buffer.size() };
+        memcpy(_buffer.data(), &header, sizeof(Header));
+        return _buffer;
+    }
+
+private:
+    void append(const void* data, size_t size) { _buffer.append(reinterpret_cast<const char*>(data), (int)size); }
+
+    void align() {
+        size_t padding = (ARRAY_ALIGNMENT - (_buffer.size() % ARRAY_ALIGNMENT)) % ARRAY_ALIGNMENT;
+        _buffer.append((int)padding, '\0');
+    }
+
+    hifi::ByteArray _buffer;
+};
+
+// Reads back what Writer wrote.  Every read is bounds checked, and once a read fails all
+// further reads return default values, so callers only need to check isValid() at the end.
+class Reader {
+public:
+    Reader(const char* data, size_t length) : _data(data), _length(length) {
+        Header header = read<Header>();
+        _valid = _valid && header.magic == BINARY_MODEL_MAGIC && header.version == baker::BINARY_MODEL_VERSION &&
+            header.length == length;
+    }
+
+    bool isValid() const { return _valid; }
+
+    template <typename T>
+    T read() {
+        T value;
+        readRaw(&value, sizeof(T));
+        return value;
+    }
+
+    // Element counts are checked against the remaining data so a corrupt file can't trigger a huge allocation
+    size_t readCount() {
+        size_t count = read<uint32_t>();
+        if (count > _length - _offset) {
+            _valid = false;
+            return 0;
+        }
+        return count;
+    }
+
+    template <typename T>
+    void readArray(T* data, size_t count) {
+        align();
+        readRaw(data, count * sizeof(T));
+    }
+
+    template <typename T>
+    void readArray(QVector<T>& array) {
+        array.resize((int)readCount());
+        readArray(array.data(), array.size());
+    }
+
+    template <typename T>
+    void readArray(std::vector<T>& array) {
+        array.resize(readCount());
+        readArray(array.data(), array.size());
+    }
+
+    QByteArray readBytes() {
+        QByteArray bytes;
+        bytes.resize((int)readCount());
+        readArray(bytes.data(), bytes.size());
+        return bytes;
+    }
+
+    QString readString() { return QString::fromUtf8(readBytes()); }
+
+    Transform readTransform() {
+        Transform transform;
+        transform.setTranslation(read<glm::vec3>());
+        transform.setRotation(read<glm::quat>());
+        transform.setScale(read<glm::vec3>());
+        return transform;
+    }
+
+    Extents readExtents() {
+        Extents extents;
+        extents.minimum = read<glm::vec3>();
+        extents.maximum = read<glm::vec3>();
+        return extents;
+    }
+
+    QVariant readVariant() {
+        QByteArray bytes = readBytes();
+        QDataStream stream(bytes);
+        QVariant variant;
+        stream >> variant;
+        return variant;
+    }
+
+private:
+    void readRaw(void* destination, size_t size) {
+        if (!_valid || size > _length - _offset) {
+            _valid = false;
+            memset(destination, 0, size);
+            return;
+        }
+        memcpy(destination, _data + _offset, size);
+        _offset += size;
+    }
+
+    void align() {
+        size_t padding = (ARRAY_ALIGNMENT - (_offset % ARRAY_ALIGNMENT)) % ARRAY_ALIGNMENT;
+        if (padding > _length - _offset) {
+            _valid = false;
+            return;
+        }
+        _offset += padding;
+    }
+
+    const char* _data;
+    size_t _length;
+    size_t _offset { 0 };
+    bool _valid { true };
+};
+
+void writeJoint(Writer& writer, const hfm::Joint& joint) {
+    writer.write(joint.shapeInfo.avgPoint);
+    writer.writeArray(joint.shapeInfo.dots);
+    writer.writeArray(joint.shapeInfo.points);
+    writer.writeArray(joint.shapeInfo.debugLines);
+    writer.write(joint.parentIndex);
+    writer.write(joint.distanceToParent);
+    writer.write(joint.translation);
+    writer.write(joint.preTransform);
+    writer.write(joint.preRotation);
+    writer.write(joint.rotation);
+    writer.write(joint.postRotation);
+    writer.write(joint.postTransform);
+    writer.write(joint.transform);
+    writer.write(joint.rotationMin);
+    writer.write(joint.rotationMax);
+    writer.write(joint.inverseDefaultRotation);
+    writer.write(joint.inverseBindRotation);
+    writer.write(joint.bindTransform);
+    writer.writeString(joint.name);
+    writer.write(joint.isSkeletonJoint);
+    writer.write(joint.bindTransformFoundInCluster);
+    writer.write(joint.hasGeometricOffset);
+    writer.write(joint.geometricTranslation);
+    writer.write(joint.geometricRotation);
+    writer.write(joint.geometricScaling);
+}
+
+hfm::Joint readJoint(Reader& reader) {
+    hfm::Joint joint;
+    joint.shapeInfo.avgPoint = reader.read<glm::vec3>();
+    reader.readArray(joint.shapeInfo.dots);
+    reader.readArray(joint.shapeInfo.points);
+    reader.readArray(joint.shapeInfo.debugLines);
+    joint.parentIndex = reader.read<int>();
+    joint.distanceToParent = reader.read<float>();
+    joint.translation = reader.read<glm::vec3>();
+    joint.preTransform = reader.read<glm::mat4>();
+    joint.preRotation = reader.read<glm::quat>();
+    joint.rotation = reader.read<glm::quat>();
+    joint.postRotation = reader.read<glm::quat>();
+    joint.postTransform = reader.read<glm::mat4>();
+    joint.transform = reader.read<glm::mat4>();
+    joint.rotationMin = reader.read<glm::vec3>();
+    joint.rotationMax = reader.read<glm::vec3>();
+    joint.inverseDefaultRotation = reader.read<glm::quat>();
+    joint.inverseBindRotation = reader.read<glm::quat>();
+    joint.bindTransform = reader.read<glm::mat4>();
+    joint.name = reader.readString();
+    joint.isSkeletonJoint = reader.read<bool>();
+    joint.bindTransformFoundInCluster = reader.read<bool>();
+    joint.hasGeometricOffset = reader.read<bool>();
+    joint.geometricTranslation = reader.read<glm::vec3>();
+    joint.geometricRotation = reader.read<glm::quat>();
+    joint.geometricScaling = reader.read<glm::vec3>();
+    return joint;
+}
+
+void writeTexture(Writer& writer, const hfm::Texture& texture) {
+    writer.writeString(texture.id);
+    writer.writeString(texture.name);
+    writer.writeBytes(texture.filename);
+    writer.writeBytes(texture.content);
+    writer.write((int32_t)texture.sourceChannel);
+    writer.writeTransform(texture.transform);
+    writer.write(texture.maxNumPixels);
+    writer.write(texture.texcoordSet);
+    writer.writeString(texture.texcoordSetName);
+    writer.write(texture.isBumpmap);
+}
+
+hfm::Texture readTexture(Reader& reader) {
+    hfm::Texture texture;
+    texture.id = reader.readString();
+    texture.name = reader.readString();
+    texture.filename = reader.readBytes();
+    texture.content = reader.readBytes();
+    texture.sourceChannel = (image::ColorChannel)reader.read<int32_t>();
+    texture.transform = reader.readTransform();
+    texture.maxNumPixels = reader.read<int>();
+    texture.texcoordSet = reader.read<int>();
+    texture.texcoordSetName = reader.readString();
+    texture.isBumpmap = reader.read<bool>();
+    return texture;
+}
+
+// Serializers create the graphics::Material from the hfm::Material using format specific rules, so store its
+// resulting properties rather than trying to derive it again.  Texture maps are only attached later, by NetworkMaterial.
+void writeGraphicsMaterial(Writer& writer, const graphics::MaterialPointer& material) {
+    writer.write(material != nullptr);
+    if (!material) {
+        return;
+    }
+    writer.write(material->getEmissive(false));
+    writer.write(material->getOpacity());
+    writer.write(material->getKey().isAlbedo());
+    writer.write(material->getAlbedo(false));
+    writer.write(material->getRoughness());
+    writer.write(material->getMetallic());
+    writer.write(material->getScattering());
+    writer.write(material->isUnlit());
+}
+
+graphics::MaterialPointer readGraphicsMaterial(Reader& reader) {
+    if (!reader.read<bool>()) {
+        return graphics::MaterialPointer();
+    }
+    auto material = std::make_shared<graphics::Material>();
+    material->setEmissive(reader.read<glm::vec3>(), false);
+    material->setOpacity(reader.read<float>());
+    bool hasAlbedo = reader.read<bool>();
+    glm::vec3 albedo = reader.read<glm::vec3>();
+    if (hasAlbedo) {
+        material->setAlbedo(albedo, false);
+    }
+    material->setRoughness(reader.read<float>());
+    material->setMetallic(reader.read<float>());
+    material->setScattering(reader.read<float>());
+    material->setUnlit(reader.read<bool>());
+    return material;
+}
+
+void writeMaterial(Writer& writer, const hfm::Material& material) {
+    writer.write(material.diffuseColor);
+    writer.write(material.diffuseFactor);
+    writer.write(material.specularColor);
+    writer.write(material.specularFactor);
+    writer.write(material.emissiveColor);
+    writer.write(material.emissiveFactor);
+    writer.write(material.shininess);
+    writer.write(material.opacity);
+    writer.write(material.metallic);
+    writer.write(material.roughness);
+    writer.write(material.emissiveIntensity);
+    writer.write(material.ambientFactor);
+    writer.write(material.bumpMultiplier);
+    writer.writeString(material.materialID);
+    writer.writeString(material.name);
+    writer.writeString(material.shadingModel);
+    writeGraphicsMaterial(writer, material._material);
+    for (auto texture : { &material.normalTexture, &material.albedoTexture, &material.opacityTexture, &material.glossTexture,
+                          &material.roughnessTexture, &material.specularTexture, &material.metallicTexture,
+                          &material.emissiveTexture, &material.occlusionTexture, &material.scatteringTexture,
+                          &material.lightmapTexture }) {
+        writeTexture(writer, *texture);
+    }
+    writer.write(material.lightmapParams);
+    writer.write(material.isPBSMaterial);
+    writer.write(material.useNormalMap);
+    writer.write(material.useAlbedoMap);
+    writer.write(material.useOpacityMap);
+    writer.write(material.useRoughnessMap);
+    writer.write(material.useSpecularMap);
+    writer.write(material.useMetallicMap);
+    writer.write(material.useEmissiveMap);
+    writer.write(material.useOcclusionMap);
+}
+
+hfm::Material readMaterial(Reader& reader) {
+    hfm::Material material;
+    material.diffuseColor = reader.read<glm::vec3>();
+    material.diffuseFactor = reader.read<float>();
+    material.specularColor = reader.read<glm::vec3>();
+    material.specularFactor = reader.read<float>();
+    material.emissiveColor = reader.read<glm::vec3>();
+    material.emissiveFactor = reader.read<float>();
+    material.shininess = reader.read<float>();
+    material.opacity = reader.read<float>();
+    material.metallic = reader.read<float>();
+    material.roughness = reader.read<float>();
+    material.emissiveIntensity = reader.read<float>();
+    material.ambientFactor = reader.read<float>();
+    material.bumpMultiplier = reader.read<float>();
+    material.materialID = reader.readString();
+    material.name = reader.readString();
+    material.shadingModel = reader.readString();
+    material._material = readGraphicsMaterial(reader);
+    for (auto texture : { &material.normalTexture, &material.albedoTexture, &material.opacityTexture, &material.glossTexture,
+                          &material.roughnessTexture, &material.specularTexture, &material.metallicTexture,
+                          &material.emissiveTexture, &material.occlusionTexture, &material.scatteringTexture,
+                          &material.lightmapTexture }) {
+        *texture = readTexture(reader);
+    }
+    material.lightmapParams = reader.read<glm::vec2>();
+    material.isPBSMaterial = reader.read<bool>();
+    material.useNormalMap = reader.read<bool>();
+    material.useAlbedoMap = reader.read<bool>();
+    material.useOpacityMap = reader.read<bool>();
+    material.useRoughnessMap = reader.read<bool>();
+    material.useSpecularMap = reader.read<bool>();
+    material.useMetallicMap = reader.read<bool>();
+    material.useEmissiveMap = reader.read<bool>();
+    material.useOcclusionMap = reader.read<bool>();
+    return material;
+}
+
+void writeMesh(Writer& writer, const hfm::Mesh& mesh) {
+    writer.writeCount(mesh.parts.size());
+    for (const auto& part : mesh.parts) {
+        writer.writeArray(part.quadIndices);
+        writer.writeArray(part.quadTrianglesIndices);
+        writer.writeArray(part.triangleIndices);
+        writer.writeString(part.materialID);
+    }
+    writer.writeArray(mesh.vertices);
+    writer.writeArray(mesh.normals);
+    writer.writeArray(mesh.tangents);
+    writer.writeArray(mesh.colors);
+    writer.writeArray(mesh.texCoords);
+    writer.writeArray(mesh.texCoords1);
+    writer.writeArray(mesh.clusterIndices);
+    writer.writeArray(mesh.clusterWeights);
+    writer.writeArray(mesh.originalIndices);
+    writer.writeCount(mesh.clusters.size());
+    for (const auto& cluster : mesh.clusters) {
+        writer.write(cluster.jointIndex);
+        writer.write(cluster.inverseBindMatrix);
+        writer.writeTransform(cluster.inverseBindTransform);
+    }
+    writer.writeExtents(mesh.meshExtents);
+    writer.write(mesh.modelTransform);
+    writer.writeCount(mesh.blendshapes.size());
+    for (const auto& blendshape : mesh.blendshapes) {
+        writer.writeArray(blendshape.indices);
+        writer.writeArray(blendshape.vertices);
+        writer.writeArray(blendshape.normals);
+        writer.writeArray(blendshape.tangents);
+    }
+    writer.write(mesh.meshIndex);
+    writer.write(mesh.wasCompressed);
+}
+
+hfm::Mesh readMesh(Reader& reader) {
+    hfm::Mesh mesh;
+    mesh.parts.resize((int)reader.readCount());
+    for (auto& part : mesh.parts) {
+        reader.readArray(part.quadIndices);
+        reader.readArray(part.quadTrianglesIndices);
+        reader.readArray(part.triangleIndices);
+        part.materialID = reader.readString();
+    }
+    reader.readArray(mesh.vertices);
+    reader.readArray(mesh.normals);
+    reader.readArray(mesh.tangents);
+    reader.readArray(mesh.colors);
+    reader.readArray(mesh.texCoords);
+    reader.readArray(mesh.texCoords1);
+    reader.readArray(mesh.clusterIndices);
+    reader.readArray(mesh.clusterWeights);
+    reader.readArray(mesh.originalIndices);
+    mesh.clusters.resize((int)reader.readCount());
+    for (auto& cluster : mesh.clusters) {
+        cluster.jointIndex = reader.read<int>();
+        cluster.inverseBindMatrix = reader.read<glm::mat4>();
+        cluster.inverseBindTransform = reader.readTransform();
+    }
+    mesh.meshExtents = reader.readExtents();
+    mesh.modelTransform = reader.read<glm::mat4>();
+    mesh.blendshapes.resize((int)reader.readCount());
+    for (auto& blendshape : mesh.blendshapes) {
+        reader.readArray(blendshape.indices);
+        reader.readArray(blendshape.vertices);
+        reader.readArray(blendshape.normals);
+        reader.readArray(blendshape.tangents);
+    }
+    mesh.meshIndex = reader.read<unsigned int>();
+    mesh.wasCompressed = reader.read<bool>();
+    return mesh;
+}
+
+}
+
+hifi::ByteArray baker::writeBinaryModel(const hfm::Model& model) {
+    Writer writer;
+    writer.writeString(model.originalURL);
+    writer.writeString(model.author);
+    writer.writeString(model.applicationName);
+
+    writer.writeCount(model.joints.size());
+    for (const auto& joint : model.joints) {
+        writeJoint(writer, joint);
+    }
+    writer.writeCount(model.jointIndices.size());
+    for (auto it = model.jointIndices.cbegin(); it != model.jointIndices.cend(); ++it) {
+        writer.writeString(it.key());
+        writer.write(it.value());
+    }
+    writer.write(model.hasSkeletonJoints);
+
+    writer.writeCount(model.meshes.size());
+    for (const auto& mesh : model.meshes) {
+        writeMesh(writer, mesh);
+    }
+
+    writer.writeCount(model.scripts.size());
+    for (const auto& script : model.scripts) {
+        writer.writeString(script);
+    }
+
+    writer.writeCount(model.materials.size());
+    for (auto it = model.materials.cbegin(); it != model.materials.cend(); ++it) {
+        writer.writeString(it.key());
+        writeMaterial(writer, it.value());
+    }
+
+    writer.write(model.offset);
+    writer.write(model.neckPivot);
+    writer.writeExtents(model.bindExtents);
+    writer.writeExtents(model.meshExtents);
+
+    writer.writeCount(model.animationFrames.size());
+    for (const auto& frame : model.animationFrames) {
+        writer.writeArray(frame.rotations);
+        writer.writeArray(frame.translations);
+    }
+
+    writer.writeCount(model.meshIndicesToModelNames.size());
+    for (auto it = model.meshIndicesToModelNames.cbegin(); it != model.meshIndicesToModelNames.cend(); ++it) {
+        writer.write(it.key());
+        writer.writeString(it.value());
+    }
+
+    writer.writeCount(model.blendshapeChannelNames.size());
+    for (const auto& name : model.blendshapeChannelNames) {
+        writer.writeString(name);
+    }
+
+    writer.writeCount(model.jointRotationOffsets.size());
+    for (auto it = model.jointRotationOffsets.cbegin(); it != model.jointRotationOffsets.cend(); ++it) {
+        writer.write(it.key());
+        writer.write(it.value());
+    }
+
+    writer.writeCount(model.shapeVertices.size());
+    for (const auto& shapeVertices : model.shapeVertices) {
+        writer.writeArray(shapeVertices);
+    }
+
+    writer.writeVariant(model.flowData._physicsConfig);
+    writer.writeVariant(model.flowData._collisionsConfig);
+
+    return writer.finish();
+}
+
+hfm::Model::Pointer baker::readBinaryModel(const char* data, size_t length) {
+    Reader reader(data, length);
+    if (!reader.isValid()) {
+        return hfm::Model::Pointer();
+    }
+
+    auto model = std::make_shared<hfm::Model>();
+    model->originalURL = reader.readString();
+    model->author = reader.readString();
+    model->applicationName = reader.readString();
+
+    model->joints.resize((int)reader.readCount());
+    for (auto& joint : model->joints) {
+        joint = readJoint(reader);
+    }
+    for (size_t i = 0, count = reader.readCount(); i < count; i++) {
+        QString name = reader.readString();
+        model->jointIndices.insert(name, reader.read<int>());
+    }
+    model->hasSkeletonJoints = reader.read<bool>();
+
+    model->meshes.resize((int)reader.readCount());
+    for (auto& mesh : model->meshes) {
+        mesh = readMesh(reader);
+    }
+
+    model->scripts.resize((int)reader.readCount());
+    for (auto& script : model->scripts) {
+        script = reader.readString();
+    }
+
+    for (size_t i = 0, count = reader.readCount(); i < count; i++) {
+        QString materialID = reader.readString();
+        model->materials.insert(materialID, readMaterial(reader));
+    }
+
+    model->offset = reader.read<glm::mat4>();
+    model->neckPivot = reader.read<glm::vec3>();
+    model->bindExtents = reader.readExtents();
+    model->meshExtents = reader.readExtents();
+
+    model->animationFrames.resize((int)reader.readCount());
+    for (auto& frame : model->animationFrames) {
+        reader.readArray(frame.rotations);
+        reader.readArray(frame.translations);
+    }
+
+    for (size_t i = 0, count = reader.readCount(); i < count; i++) {
+        int meshIndex = reader.read<int>();
+        model->meshIndicesToModelNames.insert(meshIndex, reader.readString());
+    }
+
+    for (size_t i = 0, count = reader.readCount(); i < count; i++) {
+        model->blendshapeChannelNames.push_back(reader.readString());
+    }
+
+    for (size_t i = 0, count = reader.readCount(); i < count; i++) {
+        int jointIndex = reader.read<int>();
+        model->jointRotationOffsets.insert(jointIndex, reader.read<glm::quat>());
+    }
+
+    model->shapeVertices.resize(reader.readCount());
+    for (auto& shapeVertices : model->shapeVertices) {
+        reader.readArray(shapeVertices);
+    }
+
+    model->flowData._physicsConfig = reader.readVariant().toMap();
+    model->flowData._collisionsConfig = reader.readVariant().toMap();
+
+    if (!reader.isValid()) {
+        return hfm::Model::Pointer();
+    }
+    return model;
+}
@@ -0,0 +1,35 @@
+//
+//  BinaryModel.h
+//  model-baker/src/model-baker
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_baker_BinaryModel_h
+#define hifi_baker_BinaryModel_h
+
+#include <shared/HifiTypes.h>
+#include <hfm/HFM.h>
+
+//
+// A versioned binary snapshot of an hfm::Model, used to persist processed models between sessions.
+// Vertex and index arrays are stored as raw, 16 byte aligned blocks, so a memory mapped file can be
+// read back with one copy per array and no per element parsing.
+// Graphics meshes are not stored; they are rebuilt by the baker from the stored attributes.
+//
+
+namespace baker {
+
+    // Whenever a change is made to the binary model layout, this value should be incremented
+    static const uint32_t BINARY_MODEL_VERSION = 1;
+
+    hifi::ByteArray writeBinaryModel(const hfm::Model& model);
+
+    // Returns nullptr if the data is truncated, corrupt or written with a different BINARY_MODEL_VERSION
+    hfm::Model::Pointer readBinaryModel(const char* data, size_t length);
+};
+
+#endif // hifi_baker_BinaryModel_h
@@ -14,6 +14,8 @@
 #include <glm/gtc/packing.hpp>
 
 #include <LogHandler.h>
+#include <TBBHelpers.h>
+
 #include "ModelBakerLogging.h"
 #include "ModelMath.h"
 
@@ -380,20 +382,24 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
 
     auto& graphicsMeshes = output;
 
+    // Each graphics::Mesh only depends on its own hfm::Mesh, so they can be built in parallel
     int n = (int)meshes.size();
-    for (int i = 0; i < n; i++) {
-        graphicsMeshes.emplace_back();
-        auto& graphicsMesh = graphicsMeshes[i];
-        
-        // Try to create the graphics::Mesh
-        buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i));
-
-        // Choose a name for the mesh
-        if (graphicsMesh) {
-            graphicsMesh->displayName = url.toString().toStdString() + "#/mesh/" + std::to_string(i);
-            if (meshIndicesToModelNames.find(i) != meshIndicesToModelNames.cend()) {
-                graphicsMesh->modelName = meshIndicesToModelNames[i].toStdString();
+    graphicsMeshes.resize(n);
+    tbb::parallel_for(tbb::blocked_range<int>(0, n, 1), [&](const tbb::blocked_range<int>& range) {
+        for (int i = range.begin(); i < range.end(); i++) {
+            auto& graphicsMesh = graphicsMeshes[i];
+
+            // Try to create the graphics::Mesh
+            buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i));
+
+            // Choose a name for the mesh
+            if (graphicsMesh) {
+                graphicsMesh->displayName = url.toString().toStdString() + "#/mesh/" + std::to_string(i);
+                auto modelNameItr = meshIndicesToModelNames.find(i);
+                if (modelNameItr != meshIndicesToModelNames.cend()) {
+                    graphicsMesh->modelName = modelNameItr.value().toStdString();
+                }
             }
         }
-    }
+    });
 }
@@ -33,37 +33,14 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
             if (!normalsIn.empty()) {
                 normalsPerBlendshapeOut.push_back(normalsIn.toStdVector());
             } else {
-                // Create lookup to get index in blendshape from vertex index in mesh
-                std::vector<int> reverseIndices;
-                reverseIndices.resize(mesh.vertices.size());
-                std::iota(reverseIndices.begin(), reverseIndices.end(), 0);
-                for (int indexInBlendShape = 0; indexInBlendShape < blendshape.indices.size(); ++indexInBlendShape) {
-                    auto indexInMesh = blendshape.indices[indexInBlendShape];
-                    reverseIndices[indexInMesh] = indexInBlendShape;
-                }
+                baker::AttributeIndexMap attributeIndices;
+                QVector<glm::vec3> positions;
+                baker::prepareBlendshape(mesh, blendshape, attributeIndices, positions);
 
                 normalsPerBlendshapeOut.emplace_back();
                 auto& normals = normalsPerBlendshapeOut[normalsPerBlendshapeOut.size()-1];
                 normals.resize(mesh.vertices.size());
-                baker::calculateNormals(mesh,
-                    [&reverseIndices, &blendshape, &normals](int normalIndex) /* NormalAccessor */ {
-                        const auto lookupIndex = reverseIndices[normalIndex];
-                        if (lookupIndex < blendshape.vertices.size()) {
-                            return &normals[lookupIndex];
-                        } else {
-                            // Index isn't in the blendshape. Request that the normal not be calculated.
-                            return (glm::vec3*)nullptr;
-                        }
-                    },
-                    [&mesh, &reverseIndices, &blendshape](int vertexIndex, glm::vec3& outVertex) /* VertexSetter */ {
-                        const auto lookupIndex = reverseIndices[vertexIndex];
-                        if (lookupIndex < blendshape.vertices.size()) {
-                            outVertex = blendshape.vertices[lookupIndex];
-                        } else {
-                            // Index isn't in the blendshape, so return vertex from mesh
-                            outVertex = baker::safeGet(mesh.vertices, lookupIndex);
-                        }
-                    });
+                baker::calculateNormals(mesh, positions, attributeIndices, normals);
             }
         }
     }
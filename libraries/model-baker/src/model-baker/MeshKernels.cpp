@@ -0,0 +1,204 @@
+//
+//  MeshKernels.cpp
+//  model-baker/src/model-baker
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshKernels.h"
+
+#include <cmath>
+
+#include <CPUDetect.h>
+#include <NumericalConstants.h>
+
+#ifdef ARCH_X86
+#include <emmintrin.h>
+#endif
+
+namespace baker {
+
+void faceNormals_scalar(const float* ax, const float* ay, const float* az,
+                        const float* bx, const float* by, const float* bz,
+                        const float* cx, const float* cy, const float* cz,
+                        float* nx, float* ny, float* nz, int count) {
+    for (int i = 0; i < count; i++) {
+        float e0x = bx[i] - ax[i];
+        float e0y = by[i] - ay[i];
+        float e0z = bz[i] - az[i];
+        float e1x = cx[i] - ax[i];
+        float e1y = cy[i] - ay[i];
+        float e1z = cz[i] - az[i];
+        nx[i] = e0y * e1z - e0z * e1y;
+        ny[i] = e0z * e1x - e0x * e1z;
+        nz[i] = e0x * e1y - e0y * e1x;
+    }
+}
+
+void edgeTangents_scalar(const float* nx, const float* ny, const float* nz,
+                         const float* ex, const float* ey, const float* ez,
+                         const float* ds, const float* dt,
+                         float* tx, float* ty, float* tz, int count) {
+    for (int i = 0; i < count; i++) {
+        // bitangent = n x e
+        float bx = ny[i] * ez[i] - nz[i] * ey[i];
+        float by = nz[i] * ex[i] - nx[i] * ez[i];
+        float bz = nx[i] * ey[i] - ny[i] * ex[i];
+        float bitangentLength = sqrtf(bx * bx + by * by + bz * bz);
+        if (bitangentLength < EPSILON) {
+            tx[i] = ty[i] = tz[i] = 0.0f;
+            continue;
+        }
+        bx /= bitangentLength;
+        by /= bitangentLength;
+        bz /= bitangentLength;
+
+        float normalLength = sqrtf(nx[i] * nx[i] + ny[i] * ny[i] + nz[i] * nz[i]);
+        float unx = nx[i] / normalLength;
+        float uny = ny[i] / normalLength;
+        float unz = nz[i] / normalLength;
+
+        // cos and sin of the texture coordinate rotation
+        float r = sqrtf(ds[i] * ds[i] + dt[i] * dt[i]);
+        float c = r > 0.0f ? ds[i] / r : 1.0f;
+        float s = r > 0.0f ? dt[i] / r : 0.0f;
+
+        // t = c * (b x n) + s * b
+        tx[i] = c * (by * unz - bz * uny) + s * bx;
+        ty[i] = c * (bz * unx - bx * unz) + s * by;
+        tz[i] = c * (bx * uny - by * unx) + s * bz;
+    }
+}
+
+#ifdef ARCH_X86
+
+static void faceNormals_SSE(const float* ax, const float* ay, const float* az,
+                            const float* bx, const float* by, const float* bz,
+                            const float* cx, const float* cy, const float* cz,
+                            float* nx, float* ny, float* nz, int count) {
+    int i = 0;
+    for (; i < count - 3; i += 4) {
+        __m128 x0 = _mm_loadu_ps(&ax[i]);
+        __m128 y0 = _mm_loadu_ps(&ay[i]);
+        __m128 z0 = _mm_loadu_ps(&az[i]);
+
+        __m128 e0x = _mm_sub_ps(_mm_loadu_ps(&bx[i]), x0);
+        __m128 e0y = _mm_sub_ps(_mm_loadu_ps(&by[i]), y0);
+        __m128 e0z = _mm_sub_ps(_mm_loadu_ps(&bz[i]), z0);
+        __m128 e1x = _mm_sub_ps(_mm_loadu_ps(&cx[i]), x0);
+        __m128 e1y = _mm_sub_ps(_mm_loadu_ps(&cy[i]), y0);
+        __m128 e1z = _mm_sub_ps(_mm_loadu_ps(&cz[i]), z0);
+
+        _mm_storeu_ps(&nx[i], _mm_sub_ps(_mm_mul_ps(e0y, e1z), _mm_mul_ps(e0z, e1y)));
+        _mm_storeu_ps(&ny[i], _mm_sub_ps(_mm_mul_ps(e0z, e1x), _mm_mul_ps(e0x, e1z)));
+        _mm_storeu_ps(&nz[i], _mm_sub_ps(_mm_mul_ps(e0x, e1y), _mm_mul_ps(e0y, e1x)));
+    }
+    faceNormals_scalar(&ax[i], &ay[i], &az[i], &bx[i], &by[i], &bz[i], &cx[i], &cy[i], &cz[i],
+                       &nx[i], &ny[i], &nz[i], count - i);
+}
+
+static void edgeTangents_SSE(const float* nx, const float* ny, const float* nz,
+                             const float* ex, const float* ey, const float* ez,
+                             const float* ds, const float* dt,
+                             float* tx, float* ty, float* tz, int count) {
+    const __m128 epsilon = _mm_set1_ps(EPSILON);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    int i = 0;
+    for (; i < count - 3; i += 4) {
+        __m128 n0 = _mm_loadu_ps(&nx[i]);
+        __m128 n1 = _mm_loadu_ps(&ny[i]);
+        __m128 n2 = _mm_loadu_ps(&nz[i]);
+        __m128 e0 = _mm_loadu_ps(&ex[i]);
+        __m128 e1 = _mm_loadu_ps(&ey[i]);
+        __m128 e2 = _mm_loadu_ps(&ez[i]);
+
+        // bitangent = n x e
+        __m128 b0 = _mm_sub_ps(_mm_mul_ps(n1, e2), _mm_mul_ps(n2, e1));
+        __m128 b1 = _mm_sub_ps(_mm_mul_ps(n2, e0), _mm_mul_ps(n0, e2));
+        __m128 b2 = _mm_sub_ps(_mm_mul_ps(n0, e1), _mm_mul_ps(n1, e0));
+        __m128 bitangentLength = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(b0, b0), _mm_mul_ps(b1, b1)), _mm_mul_ps(b2, b2)));
+        __m128 valid = _mm_cmpge_ps(bitangentLength, epsilon);
+        b0 = _mm_div_ps(b0, bitangentLength);
+        b1 = _mm_div_ps(b1, bitangentLength);
+        b2 = _mm_div_ps(b2, bitangentLength);
+
+        __m128 normalLength = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(n0, n0), _mm_mul_ps(n1, n1)), _mm_mul_ps(n2, n2)));
+        n0 = _mm_div_ps(n0, normalLength);
+        n1 = _mm_div_ps(n1, normalLength);
+        n2 = _mm_div_ps(n2, normalLength);
+
+        // cos and sin of the texture coordinate rotation, (1, 0) when the delta is zero
+        __m128 s0 = _mm_loadu_ps(&ds[i]);
+        __m128 t0 = _mm_loadu_ps(&dt[i]);
+        __m128 r = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(s0, s0), _mm_mul_ps(t0, t0)));
+        __m128 nonZero = _mm_cmpgt_ps(r, zero);
+        __m128 c = _mm_or_ps(_mm_and_ps(nonZero, _mm_div_ps(s0, r)), _mm_andnot_ps(nonZero, one));
+        __m128 s = _mm_and_ps(nonZero, _mm_div_ps(t0, r));
+
+        // t = c * (b x n) + s * b
+        __m128 r0 = _mm_add_ps(_mm_mul_ps(c, _mm_sub_ps(_mm_mul_ps(b1, n2), _mm_mul_ps(b2, n1))), _mm_mul_ps(s, b0));
+        __m128 r1 = _mm_add_ps(_mm_mul_ps(c, _mm_sub_ps(_mm_mul_ps(b2, n0), _mm_mul_ps(b0, n2))), _mm_mul_ps(s, b1));
+        __m128 r2 = _mm_add_ps(_mm_mul_ps(c, _mm_sub_ps(_mm_mul_ps(b0, n1), _mm_mul_ps(b1, n0))), _mm_mul_ps(s, b2));
+
+        _mm_storeu_ps(&tx[i], _mm_and_ps(valid, r0));
+        _mm_storeu_ps(&ty[i], _mm_and_ps(valid, r1));
+        _mm_storeu_ps(&tz[i], _mm_and_ps(valid, r2));
+    }
+    edgeTangents_scalar(&nx[i], &ny[i], &nz[i], &ex[i], &ey[i], &ez[i], &ds[i], &dt[i],
+                        &tx[i], &ty[i], &tz[i], count - i);
+}
+
+//
+// Runtime CPU dispatch
+//
+
+void faceNormals_AVX2(const float* ax, const float* ay, const float* az,
+                      const float* bx, const float* by, const float* bz,
+                      const float* cx, const float* cy, const float* cz,
+                      float* nx, float* ny, float* nz, int count);
+
+void edgeTangents_AVX2(const float* nx, const float* ny, const float* nz,
+                       const float* ex, const float* ey, const float* ez,
+                       const float* ds, const float* dt,
+                       float* tx, float* ty, float* tz, int count);
+
+void faceNormals(const float* ax, const float* ay, const float* az,
+                 const float* bx, const float* by, const float* bz,
+                 const float* cx, const float* cy, const float* cz,
+                 float* nx, float* ny, float* nz, int count) {
+    static auto f = cpuSupportsAVX2() ? faceNormals_AVX2 : faceNormals_SSE;
+    (*f)(ax, ay, az, bx, by, bz, cx, cy, cz, nx, ny, nz, count); // dispatch
+}
+
+void edgeTangents(const float* nx, const float* ny, const float* nz,
+                  const float* ex, const float* ey, const float* ez,
+                  const float* ds, const float* dt,
+                  float* tx, float* ty, float* tz, int count) {
+    static auto f = cpuSupportsAVX2() ? edgeTangents_AVX2 : edgeTangents_SSE;
+    (*f)(nx, ny, nz, ex, ey, ez, ds, dt, tx, ty, tz, count); // dispatch
+}
+
+#else   // portable reference code
+
+void faceNormals(const float* ax, const float* ay, const float* az,
+                 const float* bx, const float* by, const float* bz,
+                 const float* cx, const float* cy, const float* cz,
+                 float* nx, float* ny, float* nz, int count) {
+    faceNormals_scalar(ax, ay, az, bx, by, bz, cx, cy, cz, nx, ny, nz, count);
+}
+
+void edgeTangents(const float* nx, const float* ny, const float* nz,
+                  const float* ex, const float* ey, const float* ez,
+                  const float* ds, const float* dt,
+                  float* tx, float* ty, float* tz, int count) {
+    edgeTangents_scalar(nx, ny, nz, ex, ey, ez, ds, dt, tx, ty, tz, count);
+}
+
+#endif
+
+};
@@ -0,0 +1,62 @@
+//
+//  MeshKernels.h
+//  model-baker/src/model-baker
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MeshKernels_h
+#define hifi_MeshKernels_h
+
+#include <cstddef>
+#include <vector>
+
+//
+// Batched kernels for normal and tangent generation.
+// Inputs and outputs are in SoA layout (separate x, y and z arrays), and are processed
+// with SSE or AVX2 when available, with a portable scalar fallback.
+//
+
+namespace baker {
+
+    // A batch of vec3 in SoA layout
+    struct Vec3Batch {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+
+        void resize(size_t size) { x.resize(size); y.resize(size); z.resize(size); }
+        size_t size() const { return x.size(); }
+    };
+
+    // n = (b - a) x (c - a) for count faces with corners a, b and c
+    void faceNormals(const float* ax, const float* ay, const float* az,
+                     const float* bx, const float* by, const float* bz,
+                     const float* cx, const float* cy, const float* cz,
+                     float* nx, float* ny, float* nz, int count);
+
+    // Tangent contribution of an edge e leaving a vertex with normal n, where (ds, dt) is the texture
+    // coordinate delta along the edge. Equivalent to rotating normalize(n x e) around normalize(n) by
+    // -atan2(-dt, ds) and crossing the result with normalize(n), but without trigonometry.
+    // The contribution is zero where |n x e| < EPSILON.
+    void edgeTangents(const float* nx, const float* ny, const float* nz,
+                      const float* ex, const float* ey, const float* ez,
+                      const float* ds, const float* dt,
+                      float* tx, float* ty, float* tz, int count);
+
+    // scalar reference implementations, used for the tail of each batch and for validation
+    void faceNormals_scalar(const float* ax, const float* ay, const float* az,
+                            const float* bx, const float* by, const float* bz,
+                            const float* cx, const float* cy, const float* cz,
+                            float* nx, float* ny, float* nz, int count);
+
+    void edgeTangents_scalar(const float* nx, const float* ny, const float* nz,
+                             const float* ex, const float* ey, const float* ez,
+                             const float* ds, const float* dt,
+                             float* tx, float* ty, float* tz, int count);
+};
+
+#endif // hifi_MeshKernels_h
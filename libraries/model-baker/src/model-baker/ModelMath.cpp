@@ -11,8 +11,11 @@
 
 #include "ModelMath.h"
 
+#include <algorithm>
+
 #include <LogHandler.h>
 #include "ModelBakerLogging.h"
+#include "MeshKernels.h"
 
 namespace baker {
     template<class T>
@@ -39,79 +42,177 @@ namespace baker {
         return vector[i];
     }
 
-    void setTangent(const HFMMesh& mesh, const IndexAccessor& vertexAccessor, int firstIndex, int secondIndex) {
-        glm::vec3 vertex[2];
-        glm::vec2 texCoords[2];
-        glm::vec3 normal;
-        glm::vec3* tangent = vertexAccessor(firstIndex, secondIndex, vertex, texCoords, normal);
-        if (tangent) {
-            glm::vec3 bitangent = glm::cross(normal, vertex[1] - vertex[0]);
-            if (glm::length(bitangent) < EPSILON) {
-                return;
-            }
-            glm::vec2 texCoordDelta = texCoords[1] - texCoords[0];
-            glm::vec3 normalizedNormal = glm::normalize(normal);
-            *tangent += glm::cross(glm::angleAxis(-atan2f(-texCoordDelta.t, texCoordDelta.s), normalizedNormal) *
-                glm::normalize(bitangent), normalizedNormal);
+    static const int FACE_BATCH_SIZE = 256;
+
+    // Returns the attribute index of a mesh vertex, or -1 if it has none or it is out of range
+    static int getAttributeIndex(const AttributeIndexMap& attributeIndices, int vertexIndex, int numAttributes) {
+        int attributeIndex = vertexIndex;
+        if (!attributeIndices.empty()) {
+            attributeIndex = (vertexIndex >= 0 && vertexIndex < (int)attributeIndices.size()) ? attributeIndices[vertexIndex] : -1;
         }
+        return (attributeIndex >= 0 && attributeIndex < numAttributes) ? attributeIndex : -1;
     }
 
-    void calculateNormals(const hfm::Mesh& mesh, NormalAccessor normalAccessor, VertexSetter vertexSetter) {
-        static int repeatMessageID = LogHandler::getInstance().newRepeatedMessageID();
-        for (const HFMMeshPart& part : mesh.parts) {
-            for (int i = 0; i < part.quadIndices.size(); i += 4) {
-                glm::vec3* n0 = normalAccessor(part.quadIndices[i]);
-                glm::vec3* n1 = normalAccessor(part.quadIndices[i + 1]);
-                glm::vec3* n2 = normalAccessor(part.quadIndices[i + 2]);
-                glm::vec3* n3 = normalAccessor(part.quadIndices[i + 3]);
-                if (!n0 || !n1 || !n2 || !n3) {
-                    // Quad is not in the mesh (can occur with blendshape meshes, which are a subset of the hfm Mesh vertices)
+    static void setFaceNormals(const QVector<int>& indices, int cornersPerFace, const QVector<glm::vec3>& positions,
+            const AttributeIndexMap& attributeIndices, std::vector<glm::vec3>& outNormals) {
+        const int numFaces = indices.size() / cornersPerFace;
+        const int numNormals = (int)outNormals.size();
+        const int* faceIndices = indices.constData();
+
+        Vec3Batch corner0, corner1, corner2, normals;
+        corner0.resize(FACE_BATCH_SIZE);
+        corner1.resize(FACE_BATCH_SIZE);
+        corner2.resize(FACE_BATCH_SIZE);
+        normals.resize(FACE_BATCH_SIZE);
+        std::vector<int> batchFaces;
+        batchFaces.reserve(FACE_BATCH_SIZE);
+
+        for (int firstFace = 0; firstFace < numFaces; firstFace += FACE_BATCH_SIZE) {
+            int endFace = std::min(firstFace + FACE_BATCH_SIZE, numFaces);
+
+            // gather
+            batchFaces.clear();
+            for (int face = firstFace; face < endFace; face++) {
+                const int* corners = &faceIndices[face * cornersPerFace];
+                bool isInMesh = true;
+                for (int k = 0; k < cornersPerFace; k++) {
+                    isInMesh = isInMesh && getAttributeIndex(attributeIndices, corners[k], numNormals) != -1;
+                }
+                if (!isInMesh) {
+                    // Face is not in the mesh (can occur with blendshape meshes, which are a subset of the hfm Mesh vertices)
                     continue;
                 }
-                glm::vec3 vertices[3]; // Assume all vertices in this quad are in the same plane, so only the first three are needed to calculate the normal
-                vertexSetter(part.quadIndices[i], vertices[0]);
-                vertexSetter(part.quadIndices[i + 1], vertices[1]);
-                vertexSetter(part.quadIndices[i + 2], vertices[2]);
-                *n0 = *n1 = *n2 = *n3 = glm::cross(vertices[1] - vertices[0], vertices[2] - vertices[0]);
+                // Assume all vertices of a quad are in the same plane, so only the first three are needed to calculate the normal
+                const glm::vec3& p0 = safeGet(positions, corners[0]);
+                const glm::vec3& p1 = safeGet(positions, corners[1]);
+                const glm::vec3& p2 = safeGet(positions, corners[2]);
+                int j = (int)batchFaces.size();
+                corner0.x[j] = p0.x; corner0.y[j] = p0.y; corner0.z[j] = p0.z;
+                corner1.x[j] = p1.x; corner1.y[j] = p1.y; corner1.z[j] = p1.z;
+                corner2.x[j] = p2.x; corner2.y[j] = p2.y; corner2.z[j] = p2.z;
+                batchFaces.push_back(face);
             }
-            // <= size - 3 in order to prevent overflowing triangleIndices when (i % 3) != 0
-            // This is most likely evidence of a further problem in extractMesh()
-            for (int i = 0; i <= part.triangleIndices.size() - 3; i += 3) {
-                glm::vec3* n0 = normalAccessor(part.triangleIndices[i]);
-                glm::vec3* n1 = normalAccessor(part.triangleIndices[i + 1]);
-                glm::vec3* n2 = normalAccessor(part.triangleIndices[i + 2]);
-                if (!n0 || !n1 || !n2) {
-                    // Tri is not in the mesh (can occur with blendshape meshes, which are a subset of the hfm Mesh vertices)
-                    continue;
+
+            int count = (int)batchFaces.size();
+            faceNormals(corner0.x.data(), corner0.y.data(), corner0.z.data(),
+                corner1.x.data(), corner1.y.data(), corner1.z.data(),
+                corner2.x.data(), corner2.y.data(), corner2.z.data(),
+                normals.x.data(), normals.y.data(), normals.z.data(), count);
+
+            // scatter, in face order so the last face to touch a vertex wins
+            for (int j = 0; j < count; j++) {
+                const int* corners = &faceIndices[batchFaces[j] * cornersPerFace];
+                glm::vec3 normal(normals.x[j], normals.y[j], normals.z[j]);
+                for (int k = 0; k < cornersPerFace; k++) {
+                    outNormals[getAttributeIndex(attributeIndices, corners[k], numNormals)] = normal;
                 }
-                glm::vec3 vertices[3];
-                vertexSetter(part.triangleIndices[i], vertices[0]);
-                vertexSetter(part.triangleIndices[i + 1], vertices[1]);
-                vertexSetter(part.triangleIndices[i + 2], vertices[2]);
-                *n0 = *n1 = *n2 = glm::cross(vertices[1] - vertices[0], vertices[2] - vertices[0]);
             }
+        }
+    }
+
+    static void addEdgeTangents(const QVector<int>& indices, int cornersPerFace, const hfm::Mesh& mesh, const QVector<glm::vec3>& positions,
+            const AttributeIndexMap& attributeIndices, const std::vector<glm::vec3>& normals, std::vector<glm::vec3>& outTangents) {
+        const int numFaces = indices.size() / cornersPerFace;
+        const int numTangents = (int)std::min(normals.size(), outTangents.size());
+        const int numTexCoords = mesh.texCoords.size();
+        const int* faceIndices = indices.constData();
+        const int batchSize = FACE_BATCH_SIZE * cornersPerFace;
+
+        Vec3Batch edgeNormals, edges, tangents;
+        edgeNormals.resize(batchSize);
+        edges.resize(batchSize);
+        tangents.resize(batchSize);
+        std::vector<float> texCoordDeltaS(batchSize);
+        std::vector<float> texCoordDeltaT(batchSize);
+        std::vector<int> batchTangents;
+        batchTangents.reserve(batchSize);
+
+        for (int firstFace = 0; firstFace < numFaces; firstFace += FACE_BATCH_SIZE) {
+            int endFace = std::min(firstFace + FACE_BATCH_SIZE, numFaces);
+
+            // gather every edge (first, second) of the faces in this batch
+            batchTangents.clear();
+            for (int face = firstFace; face < endFace; face++) {
+                const int* corners = &faceIndices[face * cornersPerFace];
+                for (int k = 0; k < cornersPerFace; k++) {
+                    int firstIndex = corners[k];
+                    int secondIndex = corners[(k + 1) % cornersPerFace];
+                    int tangentIndex = getAttributeIndex(attributeIndices, firstIndex, numTangents);
+                    if (tangentIndex == -1) {
+                        // Vertex isn't in the blendshape
+                        continue;
+                    }
+                    int secondTexCoordIndex = getAttributeIndex(attributeIndices, secondIndex, numTexCoords);
+                    if (secondTexCoordIndex == -1) {
+                        secondTexCoordIndex = secondIndex;
+                    }
+                    const glm::vec3& normal = normals[tangentIndex];
+                    glm::vec3 edge = safeGet(positions, secondIndex) - safeGet(positions, firstIndex);
+                    glm::vec2 texCoordDelta = safeGet(mesh.texCoords, secondTexCoordIndex) - safeGet(mesh.texCoords, tangentIndex);
+
+                    int j = (int)batchTangents.size();
+                    edgeNormals.x[j] = normal.x; edgeNormals.y[j] = normal.y; edgeNormals.z[j] = normal.z;
+                    edges.x[j] = edge.x; edges.y[j] = edge.y; edges.z[j] = edge.z;
+                    texCoordDeltaS[j] = texCoordDelta.s;
+                    texCoordDeltaT[j] = texCoordDelta.t;
+                    batchTangents.push_back(tangentIndex);
+                }
+            }
+
+            int count = (int)batchTangents.size();
+            edgeTangents(edgeNormals.x.data(), edgeNormals.y.data(), edgeNormals.z.data(),
+                edges.x.data(), edges.y.data(), edges.z.data(),
+                texCoordDeltaS.data(), texCoordDeltaT.data(),
+                tangents.x.data(), tangents.y.data(), tangents.z.data(), count);
+
+            // accumulate, in edge order
+            for (int j = 0; j < count; j++) {
+                outTangents[batchTangents[j]] += glm::vec3(tangents.x[j], tangents.y[j], tangents.z[j]);
+            }
+        }
+    }
+
+    void prepareBlendshape(const hfm::Mesh& mesh, const hfm::Blendshape& blendshape, AttributeIndexMap& outAttributeIndices, QVector<glm::vec3>& outPositions) {
+        const int numVertices = mesh.vertices.size();
+        const int numBlendshapeVertices = blendshape.vertices.size();
+
+        // Create lookup to get index in blendshape from vertex index in mesh
+        outAttributeIndices.resize(numVertices);
+        std::fill(outAttributeIndices.begin(), outAttributeIndices.end(), -1);
+        for (int indexInBlendshape = 0; indexInBlendshape < blendshape.indices.size(); ++indexInBlendshape) {
+            auto indexInMesh = blendshape.indices[indexInBlendshape];
+            if (indexInMesh >= 0 && indexInMesh < numVertices && indexInBlendshape < numBlendshapeVertices) {
+                outAttributeIndices[indexInMesh] = indexInBlendshape;
+            }
+        }
+
+        // Vertices that aren't in the blendshape keep their position from the mesh
+        outPositions = mesh.vertices;
+        for (int i = 0; i < numVertices; i++) {
+            if (outAttributeIndices[i] != -1) {
+                outPositions[i] = blendshape.vertices[outAttributeIndices[i]];
+            }
+        }
+    }
+
+    void calculateNormals(const hfm::Mesh& mesh, const QVector<glm::vec3>& positions, const AttributeIndexMap& attributeIndices,
+            std::vector<glm::vec3>& outNormals) {
+        static int repeatMessageID = LogHandler::getInstance().newRepeatedMessageID();
+        for (const HFMMeshPart& part : mesh.parts) {
+            setFaceNormals(part.quadIndices, 4, positions, attributeIndices, outNormals);
+            setFaceNormals(part.triangleIndices, 3, positions, attributeIndices, outNormals);
             if ((part.triangleIndices.size() % 3) != 0) {
                 HIFI_FCDEBUG_ID(model_baker(), repeatMessageID, "Error in baker::calculateNormals: part.triangleIndices.size() is not divisible by three");
             }
         }
     }
 
-    void calculateTangents(const hfm::Mesh& mesh, IndexAccessor accessor) {
+    void calculateTangents(const hfm::Mesh& mesh, const QVector<glm::vec3>& positions, const AttributeIndexMap& attributeIndices,
+            const std::vector<glm::vec3>& normals, std::vector<glm::vec3>& outTangents) {
         static int repeatMessageID = LogHandler::getInstance().newRepeatedMessageID();
         for (const HFMMeshPart& part : mesh.parts) {
-            for (int i = 0; i < part.quadIndices.size(); i += 4) {
-                setTangent(mesh, accessor, part.quadIndices.at(i), part.quadIndices.at(i + 1));
-                setTangent(mesh, accessor, part.quadIndices.at(i + 1), part.quadIndices.at(i + 2));
-                setTangent(mesh, accessor, part.quadIndices.at(i + 2), part.quadIndices.at(i + 3));
-                setTangent(mesh, accessor, part.quadIndices.at(i + 3), part.quadIndices.at(i));
-            }
-            // <= size - 3 in order to prevent overflowing triangleIndices when (i % 3) != 0
-            // This is most likely evidence of a further problem in extractMesh()
-            for (int i = 0; i <= part.triangleIndices.size() - 3; i += 3) {
-                setTangent(mesh, accessor, part.triangleIndices.at(i), part.triangleIndices.at(i + 1));
-                setTangent(mesh, accessor, part.triangleIndices.at(i + 1), part.triangleIndices.at(i + 2));
-                setTangent(mesh, accessor, part.triangleIndices.at(i + 2), part.triangleIndices.at(i));
-            }
+            addEdgeTangents(part.quadIndices, 4, mesh, positions, attributeIndices, normals, outTangents);
+            addEdgeTangents(part.triangleIndices, 3, mesh, positions, attributeIndices, normals, outTangents);
             if ((part.triangleIndices.size() % 3) != 0) {
                 HIFI_FCDEBUG_ID(model_baker(), repeatMessageID, "Error in baker::calculateTangents: part.triangleIndices.size() is not divisible by three");
             }
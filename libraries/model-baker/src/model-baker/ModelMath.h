@@ -36,21 +36,21 @@ namespace baker {
         }
     }
 
-    // Returns a reference to the normal at the specified index, or nullptr if it cannot be accessed
-    using NormalAccessor = std::function<glm::vec3*(int index)>;
-
-    // Assigns a vertex to outVertex given the lookup index
-    using VertexSetter = std::function<void(int index, glm::vec3& outVertex)>;
-
-    void calculateNormals(const hfm::Mesh& mesh, NormalAccessor normalAccessor, VertexSetter vertexAccessor);
-
-    // firstIndex, secondIndex: the vertex indices to be used for calculation
-    // outVertices: should be assigned a 2 element array containing the vertices at firstIndex and secondIndex
-    // outTexCoords: same as outVertices but for texture coordinates
-    // outNormal: reference to the normal of this triangle
-    //
-    // Return value: pointer to the tangent you want to be calculated
-    using IndexAccessor = std::function<glm::vec3*(int firstIndex, int secondIndex, glm::vec3* outVertices, glm::vec2* outTexCoords, glm::vec3& outNormal)>;
-
-    void calculateTangents(const hfm::Mesh& mesh, IndexAccessor accessor);
+    // Maps a mesh vertex index to the index of its attributes (normal, tangent, texture coordinate) in a
+    // blendshape, or -1 if the vertex is not part of the blendshape. An empty map is the identity mapping.
+    using AttributeIndexMap = std::vector<int>;
+
+    // Builds the attribute index map of a blendshape, and its vertex positions indexed by mesh vertex index
+    void prepareBlendshape(const hfm::Mesh& mesh, const hfm::Blendshape& blendshape, AttributeIndexMap& outAttributeIndices, QVector<glm::vec3>& outPositions);
+
+    // Assigns the face normal of every quad and triangle in the mesh to the normals of its vertices.
+    // positions are indexed by mesh vertex index, and outNormals by attribute index.
+    // Faces with a vertex that has no attribute index are skipped.
+    void calculateNormals(const hfm::Mesh& mesh, const QVector<glm::vec3>& positions, const AttributeIndexMap& attributeIndices,
+        std::vector<glm::vec3>& outNormals);
+
+    // Accumulates the tangent of every edge in the mesh into the tangent of the edge's first vertex.
+    // positions are indexed by mesh vertex index, and normals and outTangents by attribute index.
+    void calculateTangents(const hfm::Mesh& mesh, const QVector<glm::vec3>& positions, const AttributeIndexMap& attributeIndices,
+        const std::vector<glm::vec3>& normals, std::vector<glm::vec3>& outTangents);
 };
@@ -0,0 +1,40 @@
+//
+//  HFMCache.cpp
+//  libraries/model-networking/src/model-networking
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HFMCache.h"
+
+#include <SettingHandle.h>
+#include <model-baker/BinaryModel.h>
+
+using File = cache::File;
+
+// Whenever a change is made to the serialized format for the HFM cache that isn't backward compatible,
+// this value should be incremented.  This will force the HFM cache to be wiped
+const int HFMCache::CURRENT_VERSION = baker::BINARY_MODEL_VERSION;
+const int HFMCache::INVALID_VERSION = 0x00;
+const char* HFMCache::SETTING_VERSION_NAME = "hifi.hfm.cache_version";
+
+HFMCache::HFMCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) { }
+
+void HFMCache::initialize() {
+    FileCache::initialize();
+    Setting::Handle<int> cacheVersionHandle(SETTING_VERSION_NAME, INVALID_VERSION);
+    auto cacheVersion = cacheVersionHandle.get();
+    if (cacheVersion != CURRENT_VERSION) {
+        wipe();
+        cacheVersionHandle.set(CURRENT_VERSION);
+    }
+}
+
+std::unique_ptr<File> HFMCache::createFile(Metadata&& metadata, const std::string& filepath) {
+    qCInfo(file_cache) << "Wrote HFM" << metadata.key.c_str();
+    return FileCache::createFile(std::move(metadata), filepath);
+}
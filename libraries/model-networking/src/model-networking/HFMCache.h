@@ -0,0 +1,35 @@
+//
+//  HFMCache.h
+//  libraries/model-networking/src/model-networking
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HFMCache_h
+#define hifi_HFMCache_h
+
+#include <shared/FileCache.h>
+
+// Persists processed models between sessions, in the layout written by baker::writeBinaryModel
+class HFMCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the serialized format for the HFM cache that isn't backward compatible,
+    // this value should be incremented.  This will force the HFM cache to be wiped
+    static const int CURRENT_VERSION;
+    static const int INVALID_VERSION;
+    static const char* SETTING_VERSION_NAME;
+
+    HFMCache(const std::string& dir, const std::string& ext);
+
+    void initialize() override;
+
+protected:
+    std::unique_ptr<cache::File> createFile(Metadata&& metadata, const std::string& filepath) override final;
+};
+
+#endif // hifi_HFMCache_h
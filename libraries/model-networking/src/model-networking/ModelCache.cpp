@@ -16,6 +16,8 @@
 #include <gpu/Batch.h>
 #include <gpu/Stream.h>
 
+#include <QCryptographicHash>
+#include <QFile>
 #include <QThreadPool>
 
 #include <Gzip.h>
@@ -28,6 +30,7 @@
 #include <OBJSerializer.h>
 #include <GLTFSerializer.h>
 #include <model-baker/Baker.h>
+#include <model-baker/BinaryModel.h>
 
 Q_LOGGING_CATEGORY(trace_resource_parse_geometry, "trace.resource.parse.geometry")
 
@@ -85,6 +88,77 @@ namespace std {
     };
 }
 
+// QHash iteration order is randomized per process, so write hashes in sorted key order to get a stable HFM cache key
+static void writeCanonicalVariant(QDataStream& stream, const QVariant& value) {
+    stream << (qint32)value.type();
+    if (value.type() == QVariant::Hash) {
+        auto variantHash = value.toHash();
+        auto keys = variantHash.uniqueKeys();
+        std::sort(keys.begin(), keys.end());
+        for (const auto& key : keys) {
+            stream << key;
+            for (const auto& element : variantHash.values(key)) {
+                writeCanonicalVariant(stream, element);
+            }
+        }
+    } else if (value.type() == QVariant::Map) {
+        auto variantMap = value.toMap();
+        for (auto it = variantMap.cbegin(); it != variantMap.cend(); ++it) {
+            stream << it.key();
+            writeCanonicalVariant(stream, it.value());
+        }
+    } else if (value.type() == QVariant::List) {
+        for (const auto& element : value.toList()) {
+            writeCanonicalVariant(stream, element);
+        }
+    } else {
+        stream << value;
+    }
+}
+
+// Processed models are keyed by their content, the mapping given to the serializer and the baker version
+static std::string getHFMCacheKey(const QUrl& url, const QByteArray& data, const QVariantHash& serializerMapping) {
+    QByteArray mappingBytes;
+    QDataStream stream(&mappingBytes, QIODevice::WriteOnly);
+    writeCanonicalVariant(stream, serializerMapping);
+
+    QCryptographicHash hasher(QCryptographicHash::Md5);
+    hasher.addData(QByteArray::number(baker::BAKER_VERSION));
+    hasher.addData(url.toEncoded());
+    hasher.addData(mappingBytes);
+    hasher.addData(data);
+    return hasher.result().toHex().toStdString();
+}
+
+static HFMModel::Pointer readCachedModel(const cache::FilePointer& file) {
+    QFile modelFile(QString::fromStdString(file->getFilepath()));
+    if (!modelFile.open(QIODevice::ReadOnly)) {
+        return HFMModel::Pointer();
+    }
+    uchar* data = modelFile.map(0, modelFile.size());
+    if (!data) {
+        return HFMModel::Pointer();
+    }
+    auto hfmModel = baker::readBinaryModel(reinterpret_cast<const char*>(data), (size_t)modelFile.size());
+    modelFile.unmap(data);
+    return hfmModel;
+}
+
+// Normals and tangents are the expensive part of baking that doesn't depend on the FST mapping, so they are cached along
+// with the serializer output, and the rest of the baker runs again when the model is loaded from the cache
+static void copyBakedAttributes(const HFMModel& bakedModel, HFMModel& hfmModel) {
+    for (int i = 0; i < hfmModel.meshes.size() && i < bakedModel.meshes.size(); i++) {
+        auto& mesh = hfmModel.meshes[i];
+        const auto& bakedMesh = bakedModel.meshes[i];
+        mesh.normals = bakedMesh.normals;
+        mesh.tangents = bakedMesh.tangents;
+        for (int j = 0; j < mesh.blendshapes.size() && j < bakedMesh.blendshapes.size(); j++) {
+            mesh.blendshapes[j].normals = bakedMesh.blendshapes[j].normals;
+            mesh.blendshapes[j].tangents = bakedMesh.blendshapes[j].tangents;
+        }
+    }
+}
+
 class GeometryReader : public QRunnable {
 public:
     GeometryReader(const ModelLoader& modelLoader, QWeakPointer<Resource>& resource, const QUrl& url, const GeometryMappingPair& mapping,
@@ -144,18 +218,38 @@ void GeometryReader::run() {
         serializerMapping["combineParts"] = _combineParts;
         serializerMapping["deduplicateIndices"] = true;
 
-        if (_url.path().toLower().endsWith(".gz")) {
-            QByteArray uncompressedData;
-            if (!gunzip(_data, uncompressedData)) {
-                throw QString("failed to decompress .gz model");
+        // Only FBX models are persisted, as other formats can pull in side files (.mtl, .bin) that the cache key doesn't cover
+        auto modelCache = DependencyManager::get<ModelCache>();
+        QString path = _url.path().toLower();
+        bool isCacheable = modelCache && (path.endsWith(".fbx") || path.endsWith(".fbx.gz"));
+        std::string cacheKey;
+        cache::FilePointer cacheFile;
+        if (isCacheable) {
+            cacheKey = getHFMCacheKey(_url, _data, serializerMapping);
+            cacheFile = modelCache->_hfmCache->getFile(cacheKey);
+            if (cacheFile) {
+                hfmModel = readCachedModel(cacheFile);
+                if (!hfmModel) {
+                    qCWarning(modelnetworking) << "Discarding unreadable cached model for" << _url;
+                }
+            }
+        }
+        bool isCached = hfmModel != nullptr;
+
+        if (!isCached) {
+            if (_url.path().toLower().endsWith(".gz")) {
+                QByteArray uncompressedData;
+                if (!gunzip(_data, uncompressedData)) {
+                    throw QString("failed to decompress .gz model");
+                }
+                // Strip the compression extension from the path, so the loader can infer the file type from what remains.
+                // This is okay because we don't expect the serializer to be able to read the contents of a compressed model file.
+                auto strippedUrl = _url;
+                strippedUrl.setPath(_url.path().left(_url.path().size() - 3));
+                hfmModel = _modelLoader.load(uncompressedData, serializerMapping, strippedUrl, "");
+            } else {
+                hfmModel = _modelLoader.load(_data, serializerMapping, _url, _webMediaType.toStdString());
             }
-            // Strip the compression extension from the path, so the loader can infer the file type from what remains.
-            // This is okay because we don't expect the serializer to be able to read the contents of a compressed model file.
-            auto strippedUrl = _url;
-            strippedUrl.setPath(_url.path().left(_url.path().size() - 3));
-            hfmModel = _modelLoader.load(uncompressedData, serializerMapping, strippedUrl, "");
-        } else {
-            hfmModel = _modelLoader.load(_data, serializerMapping, _url, _webMediaType.toStdString());
         }
 
         if (!hfmModel) {
@@ -167,13 +261,19 @@ void GeometryReader::run() {
         }
 
         // Add scripts to hfmModel
-        if (!serializerMapping.value(SCRIPT_FIELD).isNull()) {
+        if (!isCached && !serializerMapping.value(SCRIPT_FIELD).isNull()) {
             QVariantList scripts = serializerMapping.values(SCRIPT_FIELD);
             for (auto &script : scripts) {
                 hfmModel->scripts.push_back(script.toString());
             }
         }
 
+        // The baker processes the model in place, so keep a copy of the serializer output to cache
+        HFMModel unbakedModel;
+        if (isCacheable && !isCached) {
+            unbakedModel = *hfmModel;
+        }
+
         // Do processing on the model
         baker::Baker modelBaker(hfmModel, _mapping.second, _mapping.first);
         modelBaker.run();
@@ -181,8 +281,22 @@ void GeometryReader::run() {
         auto processedHFMModel = modelBaker.getHFMModel();
         auto materialMapping = modelBaker.getMaterialMapping();
 
+        if (isCacheable && !isCached) {
+            copyBakedAttributes(*processedHFMModel, unbakedModel);
+        }
+
         QMetaObject::invokeMethod(resource.data(), "setGeometryDefinition",
                 Q_ARG(HFMModel::Pointer, processedHFMModel), Q_ARG(MaterialMapping, materialMapping));
+
+        if (isCacheable && !isCached) {
+            // Replace the cached model if it couldn't be read
+            bool overwrite = cacheFile != nullptr;
+            cacheFile.reset();
+            auto modelData = baker::writeBinaryModel(unbakedModel);
+            if (!modelCache->_hfmCache->writeFile(modelData.constData(), HFMCache::Metadata(cacheKey, modelData.size()), overwrite)) {
+                qCWarning(modelnetworking) << _url << "failed to write cache file";
+            }
+        }
     } catch (const std::exception&) {
         auto resource = _resource.toStrongRef();
         if (resource) {
@@ -365,7 +479,12 @@ void GeometryResource::resetTextures() {
     _materials.clear();
 }
 
+const std::string ModelCache::HFM_DIRNAME { "hfm_cache" };
+const std::string ModelCache::HFM_EXT { "hfm" };
+
 ModelCache::ModelCache() {
+    _hfmCache->initialize();
+
     const qint64 GEOMETRY_DEFAULT_UNUSED_MAX_SIZE = DEFAULT_UNUSED_MAX_SIZE;
     setUnusedResourceCacheSize(GEOMETRY_DEFAULT_UNUSED_MAX_SIZE);
     setObjectName("ModelCache");
@@ -21,6 +21,7 @@
 #include <material-networking/MaterialCache.h>
 #include <material-networking/TextureCache.h>
 #include "ModelLoader.h"
+#include "HFMCache.h"
 
 class MeshPart;
 
@@ -132,6 +133,7 @@ public:
     void setResource(GeometryResource::Pointer resource);
 
     QUrl getURL() const { return (bool)_resource ? _resource->getURL() : QUrl(); }
+    GeometryResource::Pointer getResource() const { return _resource; }
     int getResourceDownloadAttempts() { return _resource ? _resource->getDownloadAttempts() : 0; }
     int getResourceDownloadAttemptsRemaining() { return _resource ? _resource->getDownloadAttemptsRemaining() : 0; }
 
@@ -170,6 +172,7 @@ public:
 
 protected:
     friend class GeometryResource;
+    friend class GeometryReader;
 
     virtual QSharedPointer<Resource> createResource(const QUrl& url) override;
     QSharedPointer<Resource> createResourceCopy(const QSharedPointer<Resource>& resource) override;
@@ -178,6 +181,10 @@ private:
     ModelCache();
     virtual ~ModelCache() = default;
     ModelLoader _modelLoader;
+
+    static const std::string HFM_DIRNAME;
+    static const std::string HFM_EXT;
+    std::shared_ptr<cache::FileCache> _hfmCache { std::make_shared<HFMCache>(HFM_DIRNAME, HFM_EXT) };
 };
 
 class MeshPart {
@@ -115,6 +115,12 @@ public:
     };
     Q_ENUM(ConnectReason);
 
+    // each record in a DomainList packet is a node that was added or changed, or the ID of one that was removed
+    enum DomainListRecordType : quint8 {
+        DomainListNode = 0,
+        DomainListRemovedNode
+    };
+
     QUuid getSessionUUID() const;
     void setSessionUUID(const QUuid& sessionUUID);
     Node::LocalID getSessionLocalID() const;
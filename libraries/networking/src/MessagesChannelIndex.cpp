@@ -0,0 +1,123 @@
+//
+//  MessagesChannelIndex.cpp
+//  libraries/networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MessagesChannelIndex.h"
+
+#include <algorithm>
+
+MessagesChannelIndex::ChannelID MessagesChannelIndex::find(const QByteArray& name) const {
+    return _names.value(name, INVALID_CHANNEL);
+}
+
+MessagesChannelIndex::ChannelID MessagesChannelIndex::intern(const QByteArray& name) {
+    auto itr = _names.find(name);
+    if (itr != _names.end()) {
+        return itr.value();
+    }
+
+    ChannelID id;
+    if (_freeIDs.empty()) {
+        id = (ChannelID)_channels.size();
+        _channels.emplace_back();
+    } else {
+        id = _freeIDs.back();
+        _freeIDs.pop_back();
+    }
+    // the name is never null once interned, even for the empty channel
+    _channels[id].name = name.isNull() ? QByteArray("") : name;
+    _names.insert(_channels[id].name, id);
+    return id;
+}
+
+bool MessagesChannelIndex::subscribe(const QByteArray& name, const QUuid& subscriber) {
+    ChannelID id = intern(name);
+    auto& channels = _subscriptions[subscriber];
+    if (std::find(channels.begin(), channels.end(), id) != channels.end()) {
+        return false;
+    }
+    channels.push_back(id);
+    _channels[id].subscribers.push_back(subscriber);
+    return true;
+}
+
+bool MessagesChannelIndex::unsubscribe(const QByteArray& name, const QUuid& subscriber) {
+    ChannelID id = find(name);
+    auto itr = _subscriptions.find(subscriber);
+    if (id == INVALID_CHANNEL || itr == _subscriptions.end()) {
+        return false;
+    }
+    auto& channels = itr.value();
+    auto channel = std::find(channels.begin(), channels.end(), id);
+    if (channel == channels.end()) {
+        return false;
+    }
+    *channel = channels.back();
+    channels.pop_back();
+    if (channels.empty()) {
+        _subscriptions.erase(itr);
+    }
+    removeFromChannel(id, subscriber);
+    return true;
+}
+
+void MessagesChannelIndex::removeSubscriber(const QUuid& subscriber) {
+    auto itr = _subscriptions.find(subscriber);
+    if (itr == _subscriptions.end()) {
+        return;
+    }
+    for (ChannelID id : itr.value()) {
+        removeFromChannel(id, subscriber);
+    }
+    _subscriptions.erase(itr);
+}
+
+void MessagesChannelIndex::removeFromChannel(ChannelID id, const QUuid& subscriber) {
+    // subscribing is rare next to sending, so the lists are kept packed and searched when they change
+    auto& subscribers = _channels[id].subscribers;
+    auto itr = std::find(subscribers.begin(), subscribers.end(), subscriber);
+    if (itr != subscribers.end()) {
+        *itr = subscribers.back();
+        subscribers.pop_back();
+    }
+}
+
+void MessagesChannelIndex::recordMessage(ChannelID id, int size, int numDeliveries) {
+    auto& channel = _channels[id];
+    ++channel.numMessages;
+    channel.numBytesIn += size;
+    channel.numDeliveries += numDeliveries;
+    channel.numBytesOut += (quint64)size * numDeliveries;
+}
+
+void MessagesChannelIndex::recordUnsubscribedMessage(int size) {
+    ++_numUnsubscribedMessages;
+    _numUnsubscribedBytes += size;
+}
+
+void MessagesChannelIndex::resetStats() {
+    for (ChannelID id = 0; id < (ChannelID)_channels.size(); ++id) {
+        auto& channel = _channels[id];
+        if (channel.name.isNull()) {
+            continue;
+        }
+        if (channel.subscribers.empty()) {
+            _names.remove(channel.name);
+            channel = Channel();
+            _freeIDs.push_back(id);
+        } else {
+            channel.numMessages = 0;
+            channel.numBytesIn = 0;
+            channel.numDeliveries = 0;
+            channel.numBytesOut = 0;
+        }
+    }
+    _numUnsubscribedMessages = 0;
+    _numUnsubscribedBytes = 0;
+}
@@ -0,0 +1,82 @@
+//
+//  MessagesChannelIndex.h
+//  libraries/networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MessagesChannelIndex_h
+#define hifi_MessagesChannelIndex_h
+
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QUuid>
+
+// The subscribers of each messages channel, for the messages mixer.
+// Channel names are interned to dense IDs so that fanning a message out is one hash lookup of the channel followed by
+// a walk of a packed subscriber list, however many nodes are connected.  The index also counts the traffic on each
+// channel between calls to resetStats.
+class MessagesChannelIndex {
+public:
+    using ChannelID = uint32_t;
+    static const ChannelID INVALID_CHANNEL = (ChannelID)-1;
+
+    class Channel {
+    public:
+        QByteArray name; // UTF-8, as it is on the wire
+        std::vector<QUuid> subscribers;
+
+        // since the last resetStats
+        quint64 numMessages { 0 };
+        quint64 numBytesIn { 0 };
+        quint64 numDeliveries { 0 };
+        quint64 numBytesOut { 0 };
+    };
+
+    // Returns the ID of the channel, or INVALID_CHANNEL if nobody has subscribed to it since it was last recycled
+    ChannelID find(const QByteArray& name) const;
+
+    // Return false if nothing changed
+    bool subscribe(const QByteArray& name, const QUuid& subscriber);
+    bool unsubscribe(const QByteArray& name, const QUuid& subscriber);
+    void removeSubscriber(const QUuid& subscriber);
+
+    const Channel& getChannel(ChannelID id) const { return _channels[id]; }
+    const std::vector<QUuid>& getSubscribers(ChannelID id) const { return _channels[id].subscribers; }
+    size_t getNumChannels() const { return _names.size(); }
+    size_t getNumChannelSlots() const { return _channels.size(); }
+    bool isLive(ChannelID id) const { return id < _channels.size() && !_channels[id].name.isNull(); }
+
+    // A message of the given size sent on the channel to some of its subscribers
+    void recordMessage(ChannelID id, int size, int numDeliveries);
+
+    // One sent on a channel nobody subscribes to
+    void recordUnsubscribedMessage(int size);
+    quint64 getNumUnsubscribedMessages() const { return _numUnsubscribedMessages; }
+    quint64 getNumUnsubscribedBytes() const { return _numUnsubscribedBytes; }
+
+    // Zeroes the counters and recycles the IDs of the channels left without subscribers
+    void resetStats();
+
+private:
+    ChannelID intern(const QByteArray& name);
+    void removeFromChannel(ChannelID id, const QUuid& subscriber);
+
+    QHash<QByteArray, ChannelID> _names;
+    std::vector<Channel> _channels;
+    std::vector<ChannelID> _freeIDs;
+
+    // the channels of each subscriber, so a node leaving only touches its own channels
+    QHash<QUuid, std::vector<ChannelID>> _subscriptions;
+
+    quint64 _numUnsubscribedMessages { 0 };
+    quint64 _numUnsubscribedBytes { 0 };
+};
+
+#endif // hifi_MessagesChannelIndex_h
@@ -12,6 +12,7 @@
 #include "MessagesClient.h"
 
 #include <cstdint>
+#include <cstring>
 
 #include <QtCore/QBuffer>
 #include <QtCore/QThread>
@@ -60,47 +61,59 @@ void MessagesClient::decodeMessagesPacket(QSharedPointer<ReceivedMessage> receiv
 }
 
 std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesPacket(QString channel, QString message, QUuid senderID) {
-    auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
-
-    auto channelUtf8 = channel.toUtf8();
-    quint16 channelLength = channelUtf8.length();
-    packetList->writePrimitive(channelLength);
-    packetList->write(channelUtf8);
-
-    bool isTextMessage = true;
-    packetList->writePrimitive(isTextMessage);
-
-    auto messageUtf8 = message.toUtf8();
-    quint32 messageLength = messageUtf8.length();
-    packetList->writePrimitive(messageLength);
-    packetList->write(messageUtf8);
-
-    packetList->write(senderID.toRfc4122());
-
-    return packetList;
+    return createMessagesPacketList(encodeMessagesPayload(channel.toUtf8(), true, message.toUtf8(), senderID));
 }
 
 std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID) {
-    auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+    return createMessagesPacketList(encodeMessagesPayload(channel.toUtf8(), false, data, senderID));
+}
 
-    auto channelUtf8 = channel.toUtf8();
+QByteArray MessagesClient::encodeMessagesPayload(const QByteArray& channelUtf8, bool isText, const QByteArray& message,
+                                                 const QUuid& senderID) {
     quint16 channelLength = channelUtf8.length();
-    packetList->writePrimitive(channelLength);
-    packetList->write(channelUtf8);
+    quint32 messageLength = message.length();
+
+    QByteArray payload;
+    payload.reserve((int)(sizeof(channelLength) + channelLength + sizeof(isText) + sizeof(messageLength) + messageLength) +
+                    NUM_BYTES_RFC4122_UUID);
+    payload.append(reinterpret_cast<const char*>(&channelLength), sizeof(channelLength));
+    payload.append(channelUtf8.constData(), channelLength);
+    payload.append(reinterpret_cast<const char*>(&isText), sizeof(isText));
+    payload.append(reinterpret_cast<const char*>(&messageLength), sizeof(messageLength));
+    payload.append(message);
+    payload.append(senderID.toRfc4122());
+    return payload;
+}
 
-    bool isTextMessage = false;
-    packetList->writePrimitive(isTextMessage);
+std::unique_ptr<NLPacketList> MessagesClient::createMessagesPacketList(const QByteArray& payload) {
+    auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+    packetList->write(payload);
+    return packetList;
+}
 
-    quint32 dataLength = data.length();
-    packetList->writePrimitive(dataLength);
-    packetList->write(data);
+bool MessagesClient::decodeMessagesChannel(const QByteArray& payload, QByteArray& channelUtf8) {
+    const int CHANNEL_OFFSET = (int)sizeof(quint16);
+    quint16 channelLength;
+    if (payload.size() < CHANNEL_OFFSET) {
+        return false;
+    }
+    memcpy(&channelLength, payload.constData(), sizeof(channelLength));
 
-    packetList->write(senderID.toRfc4122());
+    const int MESSAGE_LENGTH_OFFSET = CHANNEL_OFFSET + channelLength + (int)sizeof(bool);
+    const int MESSAGE_OFFSET = MESSAGE_LENGTH_OFFSET + (int)sizeof(quint32);
+    if (payload.size() < MESSAGE_OFFSET) {
+        return false;
+    }
+    quint32 messageLength;
+    memcpy(&messageLength, payload.constData() + MESSAGE_LENGTH_OFFSET, sizeof(messageLength));
+    if ((quint64)payload.size() < (quint64)MESSAGE_OFFSET + messageLength + NUM_BYTES_RFC4122_UUID) {
+        return false;
+    }
 
-    return packetList;
+    channelUtf8 = payload.mid(CHANNEL_OFFSET, channelLength);
+    return true;
 }
 
-
 void MessagesClient::handleMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
     QString channel, message;
     QByteArray data;
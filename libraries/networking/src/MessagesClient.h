@@ -167,6 +167,15 @@ public:
     static std::unique_ptr<NLPacketList> encodeMessagesPacket(QString channel, QString message, QUuid senderID);
     static std::unique_ptr<NLPacketList> encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID);
 
+    // The payload of a MessagesData packet list, for a message in UTF-8 or data
+    static QByteArray encodeMessagesPayload(const QByteArray& channelUtf8, bool isText, const QByteArray& message,
+                                            const QUuid& senderID);
+    static std::unique_ptr<NLPacketList> createMessagesPacketList(const QByteArray& payload);
+
+    // Reads the channel of a MessagesData payload without decoding the message, returns false if the payload is
+    // not complete
+    static bool decodeMessagesChannel(const QByteArray& payload, QByteArray& channelUtf8);
+
 signals:
     /**jsdoc
      * Triggered when a text message is received.
@@ -107,6 +107,10 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
     // anytime we get a new node we may need to re-send our set of ignored node IDs to it
     connect(this, &LimitedNodeList::nodeActivated, this, &NodeList::maybeSendIgnoreSetToNode);
 
+    // the domain-server only sends the changes since the list we last received, so it would never re-send
+    // a node we dropped on our own (because it went silent, for instance) - ask for the full list instead
+    connect(this, &LimitedNodeList::nodeKilled, this, &NodeList::handleNodeKilled);
+
     // setup our timer to send keepalive pings (it's started and stopped on domain connect/disconnect)
     _keepAlivePingTimer.setInterval(KEEPALIVE_PING_INTERVAL_MS); // 1s, Qt::CoarseTimer acceptable
     connect(&_keepAlivePingTimer, &QTimer::timeout, this, &NodeList::sendKeepAlivePings);
@@ -282,6 +286,9 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
     setSessionUUID(QUuid());
     setSessionLocalID(Node::NULL_LOCAL_ID);
 
+    // we no longer know about any nodes, so the next list from the domain-server must be a full one
+    resetDomainListEpoch();
+
     // if we setup the DTLS socket, also disconnect from the DTLS socket readyRead() so it can handle handshaking
     if (_dtlsSocket) {
         disconnect(_dtlsSocket, 0, this, 0);
@@ -436,6 +443,11 @@ void NodeList::sendDomainServerCheckIn() {
         packetStream << _ownerType.load() << publicSockAddr << localSockAddr << _nodeTypesOfInterest.toList();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
+        if (domainPacketType == PacketType::DomainListRequest) {
+            // the domain-server only sends the nodes that changed since the last list we have in full
+            packetStream << _domainListEpoch.load();
+        }
+
         if (!domainIsConnected) {
             DataServerAccountInfo& accountInfo = accountManager->getAccountInfo();
             packetStream << accountInfo.getUsername();
@@ -677,9 +689,21 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     bool newConnection;
     packetStream >> newConnection;
 
+    quint64 baseDomainListEpoch;
+    packetStream >> baseDomainListEpoch;
+
+    quint64 domainListEpoch;
+    packetStream >> domainListEpoch;
+
+    quint32 numDomainListRecords;
+    packetStream >> numDomainListRecords;
+
     if (newConnection) {
         _nodeConnectTimestamp = usecTimestampNow();
         _connectReason = Connect;
+
+        // the domain-server may have restarted, in which case its epochs started over
+        resetDomainListEpoch();
     }
 
     qint64 pingLagTime = (now - qint64(connectRequestTimestamp)) / qint64(USECS_PER_MSEC);
@@ -756,9 +780,60 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     setPermissions(newPermissions);
     setAuthenticatePackets(isAuthenticated);
 
+    emit domainServerListStats(message->getSize(), baseDomainListEpoch == 0, domainServerCheckinProcessingTime);
+
+    // a list may arrive split over several packets, possibly more than once if we sent duplicate check ins,
+    // so keep track of which of its records we have seen
+    bool isNewList = baseDomainListEpoch != _pendingDomainListBaseEpoch || domainListEpoch != _pendingDomainListEpoch;
+    if (isNewList) {
+        _pendingDomainListBaseEpoch = baseDomainListEpoch;
+        _pendingDomainListEpoch = domainListEpoch;
+        _pendingDomainListRecords.clear();
+    }
+
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+        quint32 recordIndex;
+        quint8 recordType;
+        packetStream >> recordIndex >> recordType;
+        _pendingDomainListRecords.insert(recordIndex);
+
+        if (recordType == DomainListRemovedNode) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            killNodeForDomainServer(nodeUUID);
+        } else {
+            parseNodeFromPacketStream(packetStream);
+        }
+    }
+
+    // Once we have all of it we are caught up to the list's epoch.  A delta computed from an older epoch than ours
+    // still covers everything since ours, but one from a newer epoch doesn't apply to what we have.
+    if ((quint32)_pendingDomainListRecords.size() >= numDomainListRecords &&
+        baseDomainListEpoch <= _domainListEpoch && domainListEpoch > _domainListEpoch) {
+        _domainListEpoch = domainListEpoch;
+    }
+}
+
+void NodeList::resetDomainListEpoch() {
+    _domainListEpoch = 0;
+    _pendingDomainListBaseEpoch = 0;
+    _pendingDomainListEpoch = 0;
+    _pendingDomainListRecords.clear();
+}
+
+void NodeList::killNodeForDomainServer(const QUuid& nodeUUID) {
+    // the domain-server has this removal in its list of changes, so it doesn't put us behind
+    _isKillingNodeForDomainServer = true;
+    killNodeWithUUID(nodeUUID);
+    _isKillingNodeForDomainServer = false;
+
+    removeDelayedAdd(nodeUUID);
+}
+
+void NodeList::handleNodeKilled() {
+    if (!_isKillingNodeForDomainServer) {
+        resetDomainListEpoch();
     }
 }
 
@@ -774,8 +849,7 @@ void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> me
     // read the UUID from the packet, remove it if it exists
     QUuid nodeUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
     qCDebug(networking) << "Received packet from domain-server to remove node with UUID" << uuidStringWithoutCurlyBraces(nodeUUID);
-    killNodeWithUUID(nodeUUID);
-    removeDelayedAdd(nodeUUID);
+    killNodeForDomainServer(nodeUUID);
 }
 
 void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
@@ -97,6 +97,9 @@ public:
 
     void removeFromIgnoreMuteSets(const QUuid& nodeID);
 
+    /// \return the last domain list epoch for which we have received every change from the domain-server
+    quint64 getDomainListEpoch() const { return _domainListEpoch; }
+
     virtual bool isDomainServer() const override { return false; }
     virtual QUuid getDomainUUID() const override { return _domainHandler.getUUID(); }
     virtual Node::LocalID getDomainLocalID() const override { return _domainHandler.getLocalID(); }
@@ -129,6 +132,7 @@ public slots:
 
 signals:
     void receivedDomainServerList();
+    void domainServerListStats(qint64 numBytes, bool isFullList, quint64 domainServerProcessingTime);
     void ignoredNode(const QUuid& nodeID, bool enabled);
     void ignoreRadiusEnabledChanged(bool isIgnored);
     void usernameFromIDReply(const QString& nodeID, const QString& username, const QString& machineFingerprint, bool isAdmin);
@@ -140,6 +144,7 @@ private slots:
 
     void startNodeHolePunch(const SharedNodePointer& node);
     void handleNodePingTimeout();
+    void handleNodeKilled();
 
     void pingPunchForDomainServer();
 
@@ -161,6 +166,8 @@ private:
     void sendDSPathQuery(const QString& newPath);
 
     void parseNodeFromPacketStream(QDataStream& packetStream);
+    void resetDomainListEpoch();
+    void killNodeForDomainServer(const QUuid& nodeUUID);
 
     void pingPunchForInactiveNode(const SharedNodePointer& node);
 
@@ -176,6 +183,13 @@ private:
 
     bool _sendDomainServerCheckInEnabled { true };
 
+    // the domain list epoch is read by the check in, which may run on another thread
+    std::atomic<quint64> _domainListEpoch { 0 };
+    quint64 _pendingDomainListBaseEpoch { 0 };
+    quint64 _pendingDomainListEpoch { 0 };
+    QSet<quint32> _pendingDomainListRecords;
+    bool _isKillingNodeForDomainServer { false };
+
     mutable QReadWriteLock _ignoredSetLock;
     tbb::concurrent_unordered_set<QUuid, UUIDHasher> _ignoredNodeIDs;
     mutable QReadWriteLock _personalMutedSetLock;
@@ -12,6 +12,7 @@
 #include "ResourceCache.h"
 #include "ResourceRequestObserver.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <assert.h>
@@ -28,13 +29,162 @@
 #include "NetworkLogging.h"
 #include "NodeList.h"
 
+ResourceCacheSharedItems::Protocol ResourceCacheSharedItems::getProtocol(const QUrl& url) {
+    auto scheme = url.scheme();
+    if (scheme == HIFI_URL_SCHEME_FILE || scheme == URL_SCHEME_QRC || scheme == URL_SCHEME_DATA) {
+        return FILE;
+    } else if (scheme == URL_SCHEME_ATP) {
+        return ATP;
+    }
+    return HTTP;
+}
+
+void ResourceCacheSharedItems::RequestHeap::place(size_t position, const Entry& entry) {
+    _entries[position] = entry;
+    _positions[entry.key] = position;
+}
+
+void ResourceCacheSharedItems::RequestHeap::siftUp(size_t position) {
+    Entry entry = _entries[position];
+    while (position > 0) {
+        size_t parent = (position - 1) / 2;
+        if (!(_entries[parent] < entry)) {
+            break;
+        }
+        place(position, _entries[parent]);
+        position = parent;
+    }
+    place(position, entry);
+}
+
+void ResourceCacheSharedItems::RequestHeap::siftDown(size_t position) {
+    Entry entry = _entries[position];
+    size_t size = _entries.size();
+    while (true) {
+        size_t child = 2 * position + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && _entries[child] < _entries[child + 1]) {
+            ++child;
+        }
+        if (!(entry < _entries[child])) {
+            break;
+        }
+        place(position, _entries[child]);
+        position = child;
+    }
+    place(position, entry);
+}
+
+void ResourceCacheSharedItems::RequestHeap::push(const Entry& entry) {
+    auto itr = _positions.find(entry.key);
+    if (itr != _positions.end()) {
+        // the same resource queued again, or a new one where a freed one was
+        size_t position = itr->second;
+        _entries[position] = entry;
+        siftUp(position);
+        siftDown(_positions[entry.key]);
+        return;
+    }
+    _entries.push_back(entry);
+    siftUp(_entries.size() - 1);
+}
+
+void ResourceCacheSharedItems::RequestHeap::pop() {
+    _positions.erase(_entries.front().key);
+    Entry last = _entries.back();
+    _entries.pop_back();
+    if (!_entries.empty()) {
+        _entries.front() = last;
+        siftDown(0);
+    }
+}
+
+void ResourceCacheSharedItems::RequestHeap::remove(Resource* key) {
+    auto itr = _positions.find(key);
+    if (itr == _positions.end()) {
+        return;
+    }
+    size_t position = itr->second;
+    _positions.erase(itr);
+    Entry last = _entries.back();
+    _entries.pop_back();
+    if (position < _entries.size()) {
+        _entries[position] = last;
+        siftUp(position);
+        siftDown(_positions[last.key]);
+    }
+}
+
+void ResourceCacheSharedItems::RequestHeap::update(Resource* key, float priority) {
+    auto itr = _positions.find(key);
+    if (itr == _positions.end()) {
+        return;
+    }
+    size_t position = itr->second;
+    float previous = _entries[position].priority;
+    _entries[position].priority = priority;
+    if (priority > previous) {
+        siftUp(position);
+    } else if (priority < previous) {
+        siftDown(position);
+    }
+}
+
+void ResourceCacheSharedItems::RequestHeap::rebuild() {
+    std::vector<Entry> entries;
+    entries.reserve(_entries.size());
+    for (auto& entry : _entries) {
+        auto resource = entry.resource.lock();
+        if (resource) {
+            entry.priority = resource->getLoadPriority();
+            entries.push_back(entry);
+        }
+    }
+    std::make_heap(entries.begin(), entries.end());
+    _entries.swap(entries);
+    _positions.clear();
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        _positions[_entries[i].key] = i;
+    }
+}
+
+void ResourceCacheSharedItems::RequestHeap::clear() {
+    _entries.clear();
+    _positions.clear();
+}
+
+bool ResourceCacheSharedItems::hasRoomFor(Protocol protocol) const {
+    uint32_t numLoading = 0;
+    uint32_t numDownloading = 0;
+    for (const auto& request : _loadingRequests) {
+        if (request.protocol == protocol) {
+            ++numLoading;
+        }
+        if (request.protocol != FILE) {
+            ++numDownloading;
+        }
+    }
+    return numLoading < _protocolRequestLimits[protocol] && (protocol == FILE || numDownloading < _requestLimit);
+}
+
 bool ResourceCacheSharedItems::appendRequest(QWeakPointer<Resource> resource) {
+    auto locked = resource.lock();
+    if (!locked) {
+        return false;
+    }
+    auto protocol = getProtocol(locked->getURL());
+
     Lock lock(_mutex);
-    if ((uint32_t)_loadingRequests.size() < _requestLimit) {
-        _loadingRequests.append(resource);
+    if (hasRoomFor(protocol)) {
+        _pendingRequests[protocol].remove(locked.data());
+        locked->_isQueued = false;
+        _loadingRequests.append({ resource, protocol });
         return true;
     } else {
-        _pendingRequests.append(resource);
+        _pendingRequests[protocol].push({ resource, locked.data(), locked->getLoadPriority(), _nextSequence++ });
+        locked->_isQueued = true;
         return false;
     }
 }
@@ -49,14 +199,26 @@ uint32_t ResourceCacheSharedItems::getRequestLimit() const {
     return _requestLimit;
 }
 
+void ResourceCacheSharedItems::setProtocolRequestLimit(Protocol protocol, uint32_t limit) {
+    Lock lock(_mutex);
+    _protocolRequestLimits[protocol] = limit;
+}
+
+uint32_t ResourceCacheSharedItems::getProtocolRequestLimit(Protocol protocol) const {
+    Lock lock(_mutex);
+    return _protocolRequestLimits[protocol];
+}
+
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() const {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach (QWeakPointer<Resource> resource, _pendingRequests) {
-        auto locked = resource.lock();
-        if (locked) {
-            result.append(locked);
+    for (const auto& heap : _pendingRequests) {
+        for (const auto& entry : heap.getEntries()) {
+            auto locked = entry.resource.lock();
+            if (locked) {
+                result.append(locked);
+            }
         }
     }
 
@@ -65,15 +227,19 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() c
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+    size_t count = 0;
+    for (const auto& heap : _pendingRequests) {
+        count += heap.size();
+    }
+    return (uint32_t)count;
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() const {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QWeakPointer<Resource> resource, _loadingRequests) {
-        auto locked = resource.lock();
+    foreach(const LoadingRequest& request, _loadingRequests) {
+        auto locked = request.resource.lock();
         if (locked) {
             result.append(locked);
         }
@@ -94,7 +260,7 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     // QWeakPointer has no operator== implementation for two weak ptrs, so
     // manually loop in case resource has been freed.
     for (int i = 0; i < _loadingRequests.size();) {
-        auto request = _loadingRequests.at(i);
+        auto request = _loadingRequests.at(i).resource;
         // Clear our resource and any freed resources
         if (!request || request.data() == resource.data()) {
             _loadingRequests.removeAt(i);
@@ -105,44 +271,69 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
 }
 
 QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    QSharedPointer<Resource> highestResource;
     Lock lock(_mutex);
+    uint32_t epoch = _loadPriorityEpoch;
 
-    bool currentHighestIsFile = false;
+    // the top of each protocol's heap that has room, local files ahead of any download
+    QSharedPointer<Resource> highestResource;
+    RequestHeap* highestHeap = nullptr;
+    for (int protocol = FILE; protocol < NUM_PROTOCOLS; ++protocol) {
+        auto& heap = _pendingRequests[protocol];
+        if (heap.isEmpty() || !hasRoomFor((Protocol)protocol)) {
+            continue;
+        }
+        if (heap.epoch != epoch) {
+            heap.rebuild();
+            heap.epoch = epoch;
+        }
 
-    for (int i = 0; i < _pendingRequests.size();) {
         // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
+        QSharedPointer<Resource> resource;
+        while (!heap.isEmpty() && !(resource = heap.top().resource.lock())) {
+            heap.pop();
+        }
         if (!resource) {
-            _pendingRequests.removeAt(i);
             continue;
         }
-
-        // Check load priority
-        float priority = resource->getLoadPriority();
-        bool isFile = resource->getURL().scheme() == HIFI_URL_SCHEME_FILE;
-        if (priority >= highestPriority && (isFile || !currentHighestIsFile)) {
-            highestPriority = priority;
-            highestIndex = i;
+        if (!highestHeap || highestHeap->top() < heap.top()) {
+            highestHeap = &heap;
             highestResource = resource;
-            currentHighestIsFile = isFile;
         }
-        i++;
+        if (protocol == FILE) {
+            break;
+        }
     }
 
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
+    if (highestHeap) {
+        highestHeap->pop();
+        highestResource->_isQueued = false;
     }
-
     return highestResource;
 }
 
+void ResourceCacheSharedItems::updateRequestPriority(Resource* resource) {
+    Lock lock(_mutex);
+    auto& heap = _pendingRequests[getProtocol(resource->getURL())];
+    if (heap.contains(resource)) {
+        heap.update(resource, resource->getLoadPriority());
+    }
+}
+
+void ResourceCacheSharedItems::invalidateLoadPriorities() {
+    ++_loadPriorityEpoch;
+}
+
 void ResourceCacheSharedItems::clear() {
     Lock lock(_mutex);
-    _pendingRequests.clear();
+    for (auto& heap : _pendingRequests) {
+        for (const auto& entry : heap.getEntries()) {
+            auto locked = entry.resource.lock();
+            if (locked) {
+                locked->_isQueued = false;
+            }
+        }
+        heap.clear();
+    }
     _loadingRequests.clear();
 }
 
@@ -338,11 +529,14 @@ void ResourceCache::setRequestLimit(uint32_t limit) {
     sharedItems->setRequestLimit(limit);
 
     // Now go fill any new request spots
-    while (sharedItems->getLoadingRequestsCount() < limit && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
+    while (attemptHighestPriorityRequest()) {
     }
 }
 
+void ResourceCache::invalidateLoadPriorities() {
+    DependencyManager::get<ResourceCacheSharedItems>()->invalidateLoadPriorities();
+}
+
 QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl& fallback, void* extra, size_t extraHash) {
     QSharedPointer<Resource> resource;
     {
@@ -540,8 +734,7 @@ void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
     sharedItems->removeRequest(resource);
 
     // Now go fill any new request spots
-    while (sharedItems->getLoadingRequestsCount() < sharedItems->getRequestLimit() && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
+    while (attemptHighestPriorityRequest()) {
     }
 }
 
@@ -600,6 +793,7 @@ void Resource::ensureLoading() {
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!_failedToLoad) {
         _loadPriorities.insert(owner, priority);
+        loadPriorityChanged();
     }
 }
 
@@ -611,11 +805,25 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    loadPriorityChanged();
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
     if (!_failedToLoad) {
         _loadPriorities.remove(owner);
+        loadPriorityChanged();
+    }
+}
+
+void Resource::loadPriorityChanged() {
+    // only a queued request has a place to move to.  Loaded resources are never queued, unless they are fetching more
+    // of themselves like progressive KTX textures, so they don't take the scheduler's lock here.  _isQueued may be
+    // stale if the resource is being dequeued on another thread, which updateRequestPriority checks under the lock.
+    if (_isQueued) {
+        auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+        if (sharedItems) {
+            sharedItems->updateRequestPriority(this);
+        }
     }
 }
 
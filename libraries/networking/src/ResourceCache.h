@@ -14,6 +14,8 @@
 
 #include <atomic>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -66,25 +68,101 @@ class ResourceCacheSharedItems : public Dependency  {
     using Lock = std::unique_lock<Mutex>;
 
 public:
+    // Requests are scheduled and limited by protocol, so a slow asset server doesn't hold up web downloads or
+    // local files and vice versa
+    enum Protocol {
+        FILE = 0,
+        HTTP,
+        ATP,
+        NUM_PROTOCOLS
+    };
+    static Protocol getProtocol(const QUrl& url);
+
     bool appendRequest(QWeakPointer<Resource> newRequest);
     void removeRequest(QWeakPointer<Resource> doneRequest);
     void setRequestLimit(uint32_t limit);
     uint32_t getRequestLimit() const;
+    void setProtocolRequestLimit(Protocol protocol, uint32_t limit);
+    uint32_t getProtocolRequestLimit(Protocol protocol) const;
     QList<QSharedPointer<Resource>> getPendingRequests() const;
+    // Returns the highest priority pending request there is room to start, local files first
     QSharedPointer<Resource> getHighestPendingRequest();
     uint32_t getPendingRequestsCount() const;
     QList<QSharedPointer<Resource>> getLoadingRequests() const;
     uint32_t getLoadingRequestsCount() const;
     void clear();
 
+    // Re-sorts a pending request after its load priority changed
+    void updateRequestPriority(Resource* resource);
+
+    // Marks every pending priority stale, for when the viewer has moved.  They are recomputed the next time a
+    // request is started, and owners that derive their priority from the viewer can watch the epoch to refresh it.
+    void invalidateLoadPriorities();
+    uint32_t getLoadPriorityEpoch() const { return _loadPriorityEpoch; }
+
 private:
     ResourceCacheSharedItems() = default;
 
+    // A binary max heap of the pending requests of one protocol, by priority and then newest first
+    class RequestHeap {
+    public:
+        class Entry {
+        public:
+            QWeakPointer<Resource> resource;
+            Resource* key;
+            float priority;
+            uint64_t sequence;
+
+            bool operator<(const Entry& other) const {
+                return priority < other.priority || (priority == other.priority && sequence < other.sequence);
+            }
+        };
+
+        bool isEmpty() const { return _entries.empty(); }
+        size_t size() const { return _entries.size(); }
+        const Entry& top() const { return _entries.front(); }
+        const std::vector<Entry>& getEntries() const { return _entries; }
+        bool contains(Resource* key) const { return _positions.find(key) != _positions.end(); }
+
+        // Adds the entry, or replaces the one with the same key
+        void push(const Entry& entry);
+        void pop();
+        void remove(Resource* key);
+        void update(Resource* key, float priority);
+
+        // Recomputes every priority and drops the freed requests
+        void rebuild();
+        void clear();
+
+        uint32_t epoch { 0 };
+
+    private:
+        void siftUp(size_t position);
+        void siftDown(size_t position);
+        void place(size_t position, const Entry& entry);
+
+        std::vector<Entry> _entries;
+        std::unordered_map<Resource*, size_t> _positions;
+    };
+
+    class LoadingRequest {
+    public:
+        QWeakPointer<Resource> resource;
+        Protocol protocol;
+    };
+
+    bool hasRoomFor(Protocol protocol) const;
+
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
-    QList<QWeakPointer<Resource>> _loadingRequests;
+    RequestHeap _pendingRequests[NUM_PROTOCOLS];
+    QList<LoadingRequest> _loadingRequests;
+    uint64_t _nextSequence { 0 };
+    std::atomic<uint32_t> _loadPriorityEpoch { 0 };
+
+    // the overall limit applies to downloads, local files are only held to their own
     const uint32_t DEFAULT_REQUEST_LIMIT = 10;
     uint32_t _requestLimit { DEFAULT_REQUEST_LIMIT };
+    uint32_t _protocolRequestLimits[NUM_PROTOCOLS] { 4, DEFAULT_REQUEST_LIMIT, DEFAULT_REQUEST_LIMIT };
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -211,6 +289,10 @@ public:
 
     static void setRequestLimit(uint32_t limit);
     static uint32_t getRequestLimit() { return DependencyManager::get<ResourceCacheSharedItems>()->getRequestLimit(); }
+
+    /// Marks the load priorities of the queued requests stale, for when the viewer has moved
+    static void invalidateLoadPriorities();
+    static uint32_t getLoadPriorityEpoch() { return DependencyManager::get<ResourceCacheSharedItems>()->getLoadPriorityEpoch(); }
     
     void setUnusedResourceCacheSize(qint64 unusedResourcesMaxSize);
     qint64 getUnusedResourceCacheSize() const { return _unusedResourcesMaxSize; }
@@ -428,6 +510,9 @@ public:
     /// Checks whether the resource has failed to download.
     virtual bool isFailed() const { return _failedToLoad; }
 
+    /// Checks whether the resource is waiting for a free request slot.
+    bool isQueued() const { return _isQueued; }
+
     /// For loading resources, returns the number of bytes received.
     qint64 getBytesReceived() const { return _bytesReceived; }
     
@@ -487,6 +572,9 @@ protected slots:
 protected:
     virtual void init(bool resetLoaded = true);
 
+    /// Moves a queued request to its new place in the queue.
+    void loadPriorityChanged();
+
     /// Called by ResourceCache to begin loading this Resource.
     /// This method can be overriden to provide custom request functionality. If this is done,
     /// downloadFinished and ResourceCache::requestCompleted must be called.
@@ -523,6 +611,7 @@ protected:
     bool _startedLoading = false;
     bool _failedToLoad = false;
     bool _loaded = false;
+    std::atomic<bool> _isQueued { false }; // waiting in ResourceCacheSharedItems for a free request slot
 
     QHash<QPointer<QObject>, float> _loadPriorities;
     QWeakPointer<Resource> _self;
@@ -543,6 +632,7 @@ public slots:
 
 private:
     friend class ResourceCache;
+    friend class ResourceCacheSharedItems;
     friend class ScriptableResource;
     
     void setLRUKey(int lruKey) { _lruKey = lruKey; }
@@ -112,6 +112,27 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
 
     statsObject["assignmentStats"] = assignmentStats;
 
+    if (!_metrics.inboundKbps && DependencyManager::isSet<MetricsRegistry>()) {
+        auto registry = DependencyManager::get<MetricsRegistry>();
+        auto assignment = MetricsRegistry::label("assignment", getTypeName());
+        _metrics.inboundKbps = registry->gauge("hifi_assignment_inbound_kbps", "Inbound bandwidth of all nodes", assignment);
+        _metrics.inboundPPS = registry->gauge("hifi_assignment_inbound_pps", "Inbound packets per second of all nodes",
+                                              assignment);
+        _metrics.outboundKbps = registry->gauge("hifi_assignment_outbound_kbps", "Outbound bandwidth to all nodes",
+                                                assignment);
+        _metrics.outboundPPS = registry->gauge("hifi_assignment_outbound_pps", "Outbound packets per second to all nodes",
+                                               assignment);
+        _metrics.queuedCheckIns = registry->gauge("hifi_assignment_queued_check_ins",
+                                                  "Domain server check ins sent without a reply", assignment);
+    }
+    if (_metrics.inboundKbps) {
+        _metrics.inboundKbps->set(nodeList->getInboundKbps());
+        _metrics.inboundPPS->set(nodeList->getInboundPPS());
+        _metrics.outboundKbps->set(nodeList->getOutboundKbps());
+        _metrics.outboundPPS->set(nodeList->getOutboundPPS());
+        _metrics.queuedCheckIns->set(_numQueuedCheckIns);
+    }
+
     nodeList->sendStatsToDomainServer(statsObject);
 }
 
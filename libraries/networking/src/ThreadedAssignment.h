@@ -14,6 +14,8 @@
 
 #include <QtCore/QSharedPointer>
 
+#include <MetricsRegistry.h>
+
 #include "ReceivedMessage.h"
 
 #include "Assignment.h"
@@ -54,6 +56,17 @@ protected slots:
 
 private slots:
     void checkInWithDomainServerOrExit();
+
+private:
+    // the stats every assignment sends, also exposed on the metrics endpoint
+    struct Metrics {
+        std::shared_ptr<MetricGauge> inboundKbps;
+        std::shared_ptr<MetricGauge> inboundPPS;
+        std::shared_ptr<MetricGauge> outboundKbps;
+        std::shared_ptr<MetricGauge> outboundPPS;
+        std::shared_ptr<MetricGauge> queuedCheckIns;
+    };
+    Metrics _metrics;
 };
 
 typedef QSharedPointer<ThreadedAssignment> SharedAssignmentPointer;
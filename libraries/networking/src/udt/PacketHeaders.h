@@ -367,7 +367,13 @@ enum class DomainListVersion : PacketVersion {
     GetMachineFingerprintFromUUIDSupport,
     AuthenticationOptional,
     HasTimestamp,
-    HasConnectReason
+    HasConnectReason,
+    HasDomainListEpoch
+};
+
+enum class DomainListRequestVersion : PacketVersion {
+    PreDomainListEpoch = 22,
+    HasDomainListEpoch
 };
 
 enum class AudioVersion : PacketVersion {
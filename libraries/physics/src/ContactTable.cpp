@@ -0,0 +1,82 @@
+//
+//  ContactTable.cpp
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ContactTable.h"
+
+#include <assert.h>
+
+const int32_t EMPTY_SLOT = -1;
+const size_t MIN_NUM_SLOTS = 64;
+
+uint32_t ContactKey::hash() const {
+    // pointers are aligned so their low bits carry little information: mix everything down into 32 bits
+    uint64_t h = (uint64_t)(uintptr_t)_a ^ ((uint64_t)(uintptr_t)_b * 0x9e3779b97f4a7c15ULL);
+    h ^= h >> 31;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 29;
+    return (uint32_t)h;
+}
+
+size_t ContactTable::findSlot(const ContactKey& key) const {
+    // linear probing: the index is never more than half full so there is always an empty slot to stop on
+    size_t mask = _slots.size() - 1;
+    size_t slot = key.hash() & mask;
+    while (_slots[slot] != EMPTY_SLOT && !(_entries[_slots[slot]].key == key)) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+ContactInfo& ContactTable::operator[](const ContactKey& key) {
+    if (2 * (_entries.size() + 1) > _slots.size()) {
+        rebuildIndex(_slots.empty() ? MIN_NUM_SLOTS : 2 * _slots.size());
+    }
+    size_t slot = findSlot(key);
+    if (_slots[slot] == EMPTY_SLOT) {
+        _slots[slot] = (int32_t)_entries.size();
+        _entries.emplace_back(key);
+    }
+    return _entries[_slots[slot]].info;
+}
+
+ContactInfo* ContactTable::find(const ContactKey& key) {
+    if (_entries.empty()) {
+        return nullptr;
+    }
+    size_t slot = findSlot(key);
+    return _slots[slot] == EMPTY_SLOT ? nullptr : &(_entries[_slots[slot]].info);
+}
+
+void ContactTable::clear() {
+    _entries.clear();
+    _slots.clear();
+}
+
+void ContactTable::removeContacts(const void* motionState) {
+    pruneIf([&](const Entry& entry) {
+        return entry.key.involves(motionState);
+    });
+}
+
+void ContactTable::rebuildIndex(size_t numSlots) {
+    assert((numSlots & (numSlots - 1)) == 0);
+    _slots.assign(numSlots, EMPTY_SLOT);
+    if (numSlots == 0) {
+        return;
+    }
+    size_t mask = numSlots - 1;
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        size_t slot = _entries[i].key.hash() & mask;
+        while (_slots[slot] != EMPTY_SLOT) {
+            slot = (slot + 1) & mask;
+        }
+        _slots[slot] = (int32_t)i;
+    }
+}
@@ -0,0 +1,87 @@
+//
+//  ContactTable.h
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ContactTable_h
+#define hifi_ContactTable_h
+
+#include <stdint.h>
+#include <vector>
+
+#include "ContactInfo.h"
+
+// simple class for keeping track of contacts
+class ContactKey {
+public:
+    ContactKey() = delete;
+    ContactKey(void* a, void* b) : _a(a), _b(b) {}
+    bool operator==(const ContactKey& other) const { return _a == other._a && _b == other._b; }
+    bool involves(const void* motionState) const { return _a == motionState || _b == motionState; }
+    uint32_t hash() const;
+    void* _a; // ObjectMotionState pointer
+    void* _b; // ObjectMotionState pointer
+};
+
+// Flat storage for the contacts tracked between steps.
+//
+// Contacts live in a dense array in the order they were first seen, so the per-step scans walk contiguous
+// memory and collision events come out in a stable order.  An open-addressed index of array offsets
+// finds a contact by key.  Removals are batched: entries are compacted in one pass and the index is
+// rebuilt once, rather than unlinking one node at a time.
+class ContactTable {
+public:
+    struct Entry {
+        Entry(const ContactKey& key) : key(key) {}
+        ContactKey key;
+        ContactInfo info;
+    };
+
+    /// \return contact for key, inserted if it wasn't already tracked
+    ContactInfo& operator[](const ContactKey& key);
+
+    /// \return contact for key, or nullptr if it isn't tracked
+    ContactInfo* find(const ContactKey& key);
+
+    size_t size() const { return _entries.size(); }
+    bool empty() const { return _entries.empty(); }
+    void clear();
+
+    /// \brief remove all contacts that involve motionState
+    void removeContacts(const void* motionState);
+
+    /// \brief call visitor(entry) for each contact in order and remove the ones for which it returns true
+    template <typename Visitor>
+    void pruneIf(Visitor visitor) {
+        size_t numKept = 0;
+        for (size_t i = 0; i < _entries.size(); ++i) {
+            if (!visitor(_entries[i])) {
+                if (numKept != i) {
+                    _entries[numKept] = _entries[i];
+                }
+                ++numKept;
+            }
+        }
+        if (numKept != _entries.size()) {
+            _entries.erase(_entries.begin() + numKept, _entries.end());
+            rebuildIndex(_slots.size());
+        }
+    }
+
+    std::vector<Entry>::const_iterator begin() const { return _entries.begin(); }
+    std::vector<Entry>::const_iterator end() const { return _entries.end(); }
+
+private:
+    size_t findSlot(const ContactKey& key) const;
+    void rebuildIndex(size_t numSlots);
+
+    std::vector<Entry> _entries;
+    std::vector<int32_t> _slots; // offsets into _entries, size is a power of two
+};
+
+#endif // hifi_ContactTable_h
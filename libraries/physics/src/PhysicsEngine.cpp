@@ -18,12 +18,17 @@
 #include <PerfStat.h>
 #include <PhysicsCollisionGroups.h>
 #include <Profile.h>
+#include <SharedUtil.h>
 #include <BulletCollision/CollisionShapes/btTriangleShape.h>
+#if BT_THREADSAFE
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#endif
 
 #include "CharacterController.h"
 #include "ObjectMotionState.h"
 #include "PhysicsHelpers.h"
 #include "PhysicsDebugDraw.h"
+#include "PhysicsTaskScheduler.h"
 #include "ThreadSafeDynamicsWorld.h"
 #include "PhysicsLogging.h"
 
@@ -59,16 +64,34 @@ PhysicsEngine::~PhysicsEngine() {
     delete _broadphaseFilter;
     delete _constraintSolver;
     delete _dynamicsWorld;
+    delete _solverPool;
     delete _ghostPairCallback;
 }
 
 void PhysicsEngine::init() {
     if (!_dynamicsWorld) {
         _collisionConfig = new btDefaultCollisionConfiguration();
-        _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
         _broadphaseFilter = new btDbvtBroadphase();
+#if BT_THREADSAFE
+        // Bullet's parallel loops all go through one global scheduler, shared by every PhysicsEngine
+        static PhysicsTaskScheduler taskScheduler;
+        if (btGetTaskScheduler() != &taskScheduler) {
+            btSetTaskScheduler(&taskScheduler);
+        }
+
+        // Each simulation island is solved by one of the pooled solvers, so islands are solved in parallel
+        // while the bodies within an island are still solved in a fixed order.  Islands too large to be worth
+        // solving alone are handed to the multithreaded solver instead.
+        _collisionDispatcher = new btCollisionDispatcherMt(_collisionConfig);
+        _solverPool = new btConstraintSolverPoolMt(taskScheduler.getNumThreads());
+        _constraintSolver = new btSequentialImpulseConstraintSolverMt();
+        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter,
+            static_cast<btConstraintSolverPoolMt*>(_solverPool), _constraintSolver, _collisionConfig);
+#else
+        _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
         _constraintSolver = new btSequentialImpulseConstraintSolver;
         _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+#endif
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
         // hook up debug draw renderer
@@ -236,7 +259,7 @@ void PhysicsEngine::removeObjects(const VectorOfMotionStates& objects) {
 
 // Same as above, but takes a Set instead of a Vector.  Should only be called during teardown.
 void PhysicsEngine::removeSetOfObjects(const SetOfMotionStates& objects) {
-    _contactMap.clear();
+    _contactTable.clear();
     for (auto object : objects) {
         btRigidBody* body = object->getRigidBody();
         if (body) {
@@ -310,15 +333,7 @@ void PhysicsEngine::processTransaction(PhysicsEngine::Transaction& transaction)
 }
 
 void PhysicsEngine::removeContacts(ObjectMotionState* motionState) {
-    // trigger events for new/existing/old contacts
-    ContactMap::iterator contactItr = _contactMap.begin();
-    while (contactItr != _contactMap.end()) {
-        if (contactItr->first._a == motionState || contactItr->first._b == motionState) {
-            contactItr = _contactMap.erase(contactItr);
-        } else {
-            ++contactItr;
-        }
-    }
+    _contactTable.removeContacts(motionState);
 }
 
 void PhysicsEngine::stepSimulation() {
@@ -333,8 +348,10 @@ void PhysicsEngine::stepSimulation() {
     const float MAX_TIMESTEP = (float)PHYSICS_ENGINE_MAX_NUM_SUBSTEPS * PHYSICS_ENGINE_FIXED_SUBSTEP;
     float dt = 1.0e-6f * (float)(_clock.getTimeMicroseconds());
     _clock.reset();
-    float timeStep = btMin(dt, MAX_TIMESTEP);
+    stepSimulation(btMin(dt, MAX_TIMESTEP));
+}
 
+void PhysicsEngine::stepSimulation(float timeStep) {
     if (_myAvatarController) {
         DETAILED_PROFILE_RANGE(simulation_physics, "avatarController");
         BT_PROFILE("avatarController");
@@ -356,8 +373,11 @@ void PhysicsEngine::stepSimulation() {
         _myAvatarController->preSimulation();
     }
 
-    auto onSubStep = [this]() {
+    uint64_t contactUpdateTime = 0;
+    auto onSubStep = [this, &contactUpdateTime]() {
+        uint64_t start = usecTimestampNow();
         this->updateContactMap();
+        contactUpdateTime += usecTimestampNow() - start;
         this->doOwnershipInfectionForConstraints();
     };
 
@@ -365,6 +385,7 @@ void PhysicsEngine::stepSimulation() {
                                                                         PHYSICS_ENGINE_FIXED_SUBSTEP, onSubStep);
     if (numSubsteps > 0) {
         BT_PROFILE("postSimulation");
+        _contactUpdateTime = contactUpdateTime;
         if (_myAvatarController) {
             _myAvatarController->postSimulation();
         }
@@ -533,7 +554,7 @@ void PhysicsEngine::updateContactMap() {
             ObjectMotionState* b = static_cast<ObjectMotionState*>(objectB->getUserPointer());
             if (a || b) {
                 // the manifold has up to 4 distinct points, but only extract info from the first
-                _contactMap[ContactKey(a, b)].update(_numContactFrames, contactManifold->getContactPoint(0));
+                _contactTable[ContactKey(a, b)].update(_numContactFrames, contactManifold->getContactPoint(0));
             }
 
             if (!Physics::getSessionUUID().isNull()) {
@@ -593,19 +614,18 @@ void PhysicsEngine::doOwnershipInfectionForConstraints() {
 
 const CollisionEvents& PhysicsEngine::getCollisionEvents() {
     _collisionEvents.clear();
+    _collisionEvents.reserve(_contactTable.size());
 
-    // scan known contacts and trigger events
-    ContactMap::iterator contactItr = _contactMap.begin();
-
-    while (contactItr != _contactMap.end()) {
-        ContactInfo& contact = contactItr->second;
+    // scan known contacts and trigger events, then drop the contacts that ended in the same pass
+    _contactTable.pruneIf([&](ContactTable::Entry& entry) {
+        ContactInfo& contact = entry.info;
         ContactEventType type = contact.computeType(_numContactFrames);
         const btScalar SIGNIFICANT_DEPTH = -0.002f; // penetrations have negative distance
         if (type != CONTACT_EVENT_TYPE_CONTINUE ||
                 (contact.distance < SIGNIFICANT_DEPTH &&
                  contact.readyForContinue(_numContactFrames))) {
-            ObjectMotionState* motionStateA = static_cast<ObjectMotionState*>(contactItr->first._a);
-            ObjectMotionState* motionStateB = static_cast<ObjectMotionState*>(contactItr->first._b);
+            ObjectMotionState* motionStateA = static_cast<ObjectMotionState*>(entry.key._a);
+            ObjectMotionState* motionStateB = static_cast<ObjectMotionState*>(entry.key._b);
 
             // NOTE: the MyAvatar RigidBody is the only object in the simulation that does NOT have a MotionState
             // which means should we ever want to report ALL collision events against the avatar we can
@@ -638,13 +658,8 @@ const CollisionEvents& PhysicsEngine::getCollisionEvents() {
                 _collisionEvents.push_back(Collision(type, idB, idA, position, penetration, velocityChange));
             }
         }
-
-        if (type == CONTACT_EVENT_TYPE_END) {
-            contactItr = _contactMap.erase(contactItr);
-        } else {
-            ++contactItr;
-        }
-    }
+        return type == CONTACT_EVENT_TYPE_END;
+    });
     return _collisionEvents;
 }
 
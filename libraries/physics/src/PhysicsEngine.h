@@ -21,7 +21,7 @@
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 
 #include "BulletUtil.h"
-#include "ContactInfo.h"
+#include "ContactTable.h"
 #include "ObjectMotionState.h"
 #include "ThreadSafeDynamicsWorld.h"
 #include "ObjectAction.h"
@@ -32,17 +32,6 @@ const float HALF_SIMULATION_EXTENT = 512.0f; // meters
 class CharacterController;
 class PhysicsDebugDraw;
 
-// simple class for keeping track of contacts
-class ContactKey {
-public:
-    ContactKey() = delete;
-    ContactKey(void* a, void* b) : _a(a), _b(b) {}
-    bool operator<(const ContactKey& other) const { return _a < other._a || (_a == other._a && _b < other._b); }
-    bool operator==(const ContactKey& other) const { return _a == other._a && _b == other._b; }
-    void* _a; // ObjectMotionState pointer
-    void* _b; // ObjectMotionState pointer
-};
-
 struct ContactTestResult {
     ContactTestResult() = delete;
 
@@ -69,7 +58,6 @@ struct ContactTestResult {
     glm::vec3 collisionNormal;
 };
 
-using ContactMap = std::map<ContactKey, ContactInfo>;
 using CollisionEvents = std::vector<Collision>;
 
 class PhysicsEngine {
@@ -105,6 +93,9 @@ public:
     void processTransaction(Transaction& transaction);
 
     void stepSimulation();
+    /// \brief steps the simulation by a fixed amount of time rather than the time elapsed since the last step,
+    /// for headless simulations that don't run in real time
+    void stepSimulation(float timeStep);
     void harvestPerformanceStats();
     void printPerformanceStatsToFile(const QString& filename);
     void updateContactMap();
@@ -119,6 +110,12 @@ public:
     /// \return reference to list of Collision events.  The list is only valid until beginning of next simulation loop.
     const CollisionEvents& getCollisionEvents();
 
+    /// \return number of contacts being tracked
+    uint32_t getNumContacts() const { return (uint32_t)_contactTable.size(); }
+
+    /// \return microseconds spent updating contacts during the last step
+    uint64_t getContactUpdateTime() const { return _contactUpdateTime; }
+
     /// \brief prints timings for last frame if stats have been requested.
     void dumpStatsIfNecessary();
 
@@ -168,11 +165,12 @@ private:
     btCollisionDispatcher* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
     btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
+    btConstraintSolver* _solverPool = NULL;
     ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
     btGhostPairCallback* _ghostPairCallback = NULL;
     std::unique_ptr<PhysicsDebugDraw> _physicsDebugDraw;
 
-    ContactMap _contactMap;
+    ContactTable _contactTable;
     CollisionEvents _collisionEvents;
     QHash<QUuid, EntityDynamicPointer> _objectDynamics;
     QHash<btRigidBody*, QSet<QUuid>> _objectDynamicsByBody;
@@ -184,6 +182,7 @@ private:
     CharacterController* _myAvatarController;
 
     uint32_t _numContactFrames { 0 };
+    uint64_t _contactUpdateTime { 0 };
 
     bool _dumpNextStats { false };
     bool _saveNextStats { false };
@@ -0,0 +1,59 @@
+//
+//  PhysicsTaskScheduler.cpp
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsTaskScheduler.h"
+
+#if BT_THREADSAFE
+
+#include <algorithm>
+#include <functional>
+
+#include <TBBHelpers.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_init.h>
+
+PhysicsTaskScheduler::PhysicsTaskScheduler() : btITaskScheduler("PhysicsTaskScheduler") {
+    setNumThreads(getMaxNumThreads());
+}
+
+PhysicsTaskScheduler::~PhysicsTaskScheduler() {
+}
+
+int PhysicsTaskScheduler::getMaxNumThreads() const {
+    // Bullet keeps per thread data in arrays of BT_MAX_THREAD_COUNT
+    return std::min(tbb::task_scheduler_init::default_num_threads(), (int)BT_MAX_THREAD_COUNT);
+}
+
+void PhysicsTaskScheduler::setNumThreads(int numThreads) {
+    _numThreads = std::max(1, std::min(numThreads, getMaxNumThreads()));
+    _arena.reset(new tbb::task_arena(_numThreads));
+}
+
+void PhysicsTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) {
+    _arena->execute([&] {
+        tbb::parallel_for(tbb::blocked_range<int>(iBegin, iEnd, grainSize), [&](const tbb::blocked_range<int>& range) {
+            body.forLoop(range.begin(), range.end());
+        }, tbb::simple_partitioner());
+    });
+}
+
+btScalar PhysicsTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) {
+    btScalar sum = btScalar(0);
+    _arena->execute([&] {
+        sum = tbb::parallel_reduce(tbb::blocked_range<int>(iBegin, iEnd, grainSize), btScalar(0),
+            [&](const tbb::blocked_range<int>& range, btScalar partialSum) {
+                return partialSum + body.sumLoop(range.begin(), range.end());
+            }, std::plus<btScalar>(), tbb::simple_partitioner());
+    });
+    return sum;
+}
+
+#endif // BT_THREADSAFE
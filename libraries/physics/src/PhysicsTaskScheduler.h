@@ -0,0 +1,44 @@
+//
+//  PhysicsTaskScheduler.h
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsTaskScheduler_h
+#define hifi_PhysicsTaskScheduler_h
+
+#include <LinearMath/btThreads.h>
+
+#if BT_THREADSAFE
+
+#include <memory>
+
+namespace tbb {
+    class task_arena;
+}
+
+// Runs Bullet's parallel loops (narrowphase, simulation islands, integration) on the TBB worker pool
+// shared with the rest of the application, instead of a separate pool of Bullet's own.
+class PhysicsTaskScheduler : public btITaskScheduler {
+public:
+    PhysicsTaskScheduler();
+    ~PhysicsTaskScheduler();
+
+    int getMaxNumThreads() const override;
+    int getNumThreads() const override { return _numThreads; }
+    void setNumThreads(int numThreads) override;
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+private:
+    int _numThreads;
+    std::unique_ptr<tbb::task_arena> _arena;
+};
+
+#endif // BT_THREADSAFE
+
+#endif // hifi_PhysicsTaskScheduler_h
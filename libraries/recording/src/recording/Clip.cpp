@@ -13,6 +13,9 @@
 
 #include "impl/FileClip.h"
 #include "impl/BufferClip.h"
+#include "impl/ClipIndex.h"
+
+#include <unordered_map>
 
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
@@ -29,14 +32,15 @@ Clip::Pointer Clip::fromFile(const QString& filePath) {
     return result;
 }
 
-void Clip::toFile(const QString& filePath, const Clip::ConstPointer& clip) {
-    FileClip::write(filePath, clip->duplicate());
+void Clip::toFile(const QString& filePath, const Clip::ConstPointer& clip, Encoding encoding) {
+    FileClip::write(filePath, clip->duplicate(), encoding);
 }
 
 QByteArray Clip::toBuffer(const Clip::ConstPointer& clip) {
     QBuffer buffer;
     if (buffer.open(QFile::Truncate | QFile::WriteOnly)) {
-        clip->duplicate()->write(buffer);
+        // uploaded clips are kept readable by older versions
+        clip->duplicate()->write(buffer, Encoding::Compressed);
         buffer.close();
     }
     return buffer.data();
@@ -55,12 +59,7 @@ float Clip::position() const {
 }
 
 // FIXME move to frame?
-bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
-    if (frame.type == Frame::TYPE_INVALID) {
-        qWarning() << "Attempting to write invalid frame";
-        return true;
-    }
-
+static bool writeFrame(QIODevice& output, const Frame& frame, const QByteArray& frameData, quint64& fileOffset) {
     auto written = output.write((char*)&(frame.type), sizeof(FrameType));
     if (written != sizeof(FrameType)) {
         return false;
@@ -70,11 +69,6 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
     if (written != sizeof(Frame::Time)) {
         return false;
     }
-    QByteArray frameData = frame.data;
-    if (compressed) {
-        frameData = qCompress(frameData);
-    }
-
     uint16_t dataSize = frameData.size();
     written = output.write((char*)&dataSize, sizeof(FrameSize));
     if (written != sizeof(uint16_t)) {
@@ -87,13 +81,15 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
             return false;
         }
     }
+    fileOffset += sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize) + dataSize;
     return true;
 }
 
 const QString Clip::FRAME_TYPE_MAP = QStringLiteral("frameTypes");
 const QString Clip::FRAME_COMREPSSION_FLAG = QStringLiteral("compressed");
+const QString Clip::FRAME_DELTA_FLAG = QStringLiteral("delta");
 
-bool Clip::write(QIODevice& output) {
+bool Clip::write(QIODevice& output, Encoding encoding) {
     auto frameTypes = Frame::getFrameTypes();
     QJsonObject frameTypeObj;
     for (const auto& frameTypeName : frameTypes.keys()) {
@@ -102,20 +98,46 @@ bool Clip::write(QIODevice& output) {
 
     QJsonObject rootObject;
     rootObject.insert(FRAME_TYPE_MAP, frameTypeObj);
-    // Always mark new files as compressed
-    rootObject.insert(FRAME_COMREPSSION_FLAG, true);
+    rootObject.insert(FRAME_COMREPSSION_FLAG, encoding != Encoding::Raw);
+    rootObject.insert(FRAME_DELTA_FLAG, encoding == Encoding::Delta);
     QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
+    quint64 fileOffset = 0;
     // Never compress the header frame
-    if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false)) {
+    Frame headerFrame(Frame::TYPE_HEADER, 0, headerFrameData);
+    if (!writeFrame(output, headerFrame, headerFrame.data, fileOffset)) {
         return false;
     }
 
     seek(0);
 
+    ClipIndex index;
+    std::unordered_map<FrameType, QByteArray> previousData;
     for (auto frame = nextFrame(); frame; frame = nextFrame()) {
-        if (!writeFrame(output, *frame)) {
+        if (frame->type == Frame::TYPE_INVALID) {
+            qWarning() << "Attempting to write invalid frame";
+            continue;
+        }
+
+        // each chunk starts with a keyframe of every type, so playback can start at any chunk
+        if (index.addFrame(fileOffset, frame->type, frame->timeOffset)) {
+            previousData.clear();
+        }
+
+        QByteArray frameData = frame->data;
+        if (encoding == Encoding::Delta) {
+            auto previous = previousData.find(frame->type);
+            if (previous != previousData.end()) {
+                frameData = ClipIndex::applyDelta(frameData, previous->second);
+            }
+            previousData[frame->type] = frame->data;
+        }
+        if (encoding != Encoding::Raw) {
+            frameData = qCompress(frameData);
+        }
+
+        if (!writeFrame(output, *frame, frameData, fileOffset)) {
             return false;
         }
     }
-    return true;
+    return index.write(output, fileOffset);
 }
@@ -27,6 +27,13 @@ public:
     using Pointer = std::shared_ptr<Clip>;
     using ConstPointer = std::shared_ptr<const Clip>;
 
+    // How frame data is stored in a clip file
+    enum class Encoding {
+        Raw, // as is, so frames can be played from a mapped file without a copy
+        Compressed, // each frame compressed on its own, readable by older versions
+        Delta // each frame compressed as its difference from the previous frame of its type
+    };
+
     virtual ~Clip() {}
 
     virtual Pointer duplicate() const = 0;
@@ -47,15 +54,16 @@ public:
     virtual void skipFrame() = 0;
     virtual void addFrame(FrameConstPointer) = 0;
 
-    bool write(QIODevice& output);
+    bool write(QIODevice& output, Encoding encoding = Encoding::Compressed);
 
     static Pointer fromFile(const QString& filePath);
-    static void toFile(const QString& filePath, const ConstPointer& clip);
+    static void toFile(const QString& filePath, const ConstPointer& clip, Encoding encoding = Encoding::Raw);
     static QByteArray toBuffer(const ConstPointer& clip);
     static Pointer newClip();
     
     static const QString FRAME_TYPE_MAP;
     static const QString FRAME_COMREPSSION_FLAG;
+    static const QString FRAME_DELTA_FLAG;
 
 protected:
     friend class WrapperClip;
@@ -21,8 +21,9 @@ NetworkClipLoader::NetworkClipLoader(const QUrl& url) :
     _clip(std::make_shared<NetworkClip>(url)) {}
 
 void NetworkClip::init(const QByteArray& clipData) {
-    _clipData = clipData;
-    PointerClip::init((uchar*)_clipData.data(), _clipData.size());
+    // kept alive by the frames that point into it
+    auto data = std::make_shared<QByteArray>(clipData);
+    PointerClip::init((uchar*)data->data(), data->size(), data);
 }
 
 void NetworkClipLoader::downloadFinished(const QByteArray& data) {
@@ -59,6 +59,7 @@ public:
     using ConstPointer = std::shared_ptr<const Frame>;
     using Handler = std::function<void(Frame::ConstPointer frame)>;
 
+    // may point into the clip the frame was read from, so copies shouldn't outlive the frame
     QByteArray data;
 
     Frame() {}
@@ -0,0 +1,181 @@
+//
+//  ClipIndex.cpp
+//  libraries/recording/src/recording/impl
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ClipIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <QtCore/QIODevice>
+
+using namespace recording;
+
+static const size_t FRAME_HEADER_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize);
+static const size_t MAX_INDEX_FRAME_DATA = std::numeric_limits<FrameSize>::max();
+static const quint32 TRAILER_MAGIC = 0x49524648; // "HFRI"
+static const quint32 INDEX_VERSION = 1;
+static const size_t TRAILER_DATA_SIZE = sizeof(quint64) + sizeof(quint32) + sizeof(quint32);
+
+const size_t ClipIndex::TRAILER_SIZE = FRAME_HEADER_SIZE + TRAILER_DATA_SIZE;
+
+template <typename T>
+static void append(QByteArray& buffer, const T& value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool take(const uchar*& current, const uchar* end, T& value) {
+    if ((size_t)(end - current) < sizeof(T)) {
+        return false;
+    }
+    memcpy(&value, current, sizeof(T));
+    current += sizeof(T);
+    return true;
+}
+
+static bool writeIndexFrame(QIODevice& output, const char* data, FrameSize size) {
+    QByteArray frame;
+    append(frame, (FrameType)ClipIndex::TYPE_INDEX);
+    append(frame, (Frame::Time)0);
+    append(frame, size);
+    frame.append(data, size);
+    return output.write(frame) == frame.size();
+}
+
+QByteArray ClipIndex::applyDelta(const QByteArray& data, const QByteArray& previous) {
+    // successive frames of a type mostly repeat each other, so the difference is mostly zeros and compresses well
+    QByteArray result = data;
+    auto size = std::min(data.size(), previous.size());
+    char* resultData = result.data();
+    const char* previousData = previous.constData();
+    for (int i = 0; i < size; ++i) {
+        resultData[i] ^= previousData[i];
+    }
+    return result;
+}
+
+bool ClipIndex::addFrame(quint64 fileOffset, FrameType type, Frame::Time timeOffset) {
+    bool isNewChunk = (_numFrames++ % FRAMES_PER_CHUNK) == 0;
+    if (isNewChunk) {
+        chunks.push_back({ fileOffset, timeOffset });
+    }
+    auto& summary = types[type];
+    ++summary.frameCount;
+    summary.lastTime = std::max(summary.lastTime, timeOffset);
+    return isNewChunk;
+}
+
+bool ClipIndex::write(QIODevice& output, quint64 fileOffset) const {
+    QByteArray index;
+    append(index, INDEX_VERSION);
+    append(index, (quint32)chunks.size());
+    for (const auto& chunk : chunks) {
+        append(index, chunk.fileOffset);
+        append(index, chunk.firstTime);
+    }
+    append(index, (quint32)types.size());
+    for (const auto& type : types) {
+        append(index, type.first);
+        append(index, type.second.frameCount);
+        append(index, type.second.lastTime);
+    }
+
+    // frame sizes are 16 bit, so a long clip's index takes several frames
+    for (int offset = 0; offset < index.size(); offset += (int)MAX_INDEX_FRAME_DATA) {
+        auto size = (FrameSize)std::min((size_t)(index.size() - offset), MAX_INDEX_FRAME_DATA);
+        if (!writeIndexFrame(output, index.constData() + offset, size)) {
+            return false;
+        }
+    }
+
+    QByteArray trailer;
+    append(trailer, fileOffset);
+    append(trailer, INDEX_VERSION);
+    append(trailer, TRAILER_MAGIC);
+    return writeIndexFrame(output, trailer.constData(), (FrameSize)trailer.size());
+}
+
+bool ClipIndex::read(const uchar* data, size_t size, size_t& indexOffset) {
+    chunks.clear();
+    types.clear();
+
+    if (size < TRAILER_SIZE) {
+        return false;
+    }
+
+    const uchar* current = data + size - TRAILER_SIZE;
+    const uchar* end = data + size;
+    FrameType type;
+    Frame::Time timeOffset;
+    FrameSize frameSize;
+    quint64 offset;
+    quint32 version;
+    quint32 magic;
+    if (!take(current, end, type) || !take(current, end, timeOffset) || !take(current, end, frameSize) ||
+            !take(current, end, offset) || !take(current, end, version) || !take(current, end, magic)) {
+        return false;
+    }
+    if (type != TYPE_INDEX || frameSize != TRAILER_DATA_SIZE || magic != TRAILER_MAGIC || version != INDEX_VERSION ||
+            offset > size - TRAILER_SIZE) {
+        return false;
+    }
+
+    // gather the index frames between the last frame of the clip and the trailer
+    QByteArray index;
+    current = data + offset;
+    end = data + size - TRAILER_SIZE;
+    while (current < end) {
+        if (!take(current, end, type) || !take(current, end, timeOffset) || !take(current, end, frameSize) ||
+                type != TYPE_INDEX || (size_t)(end - current) < frameSize) {
+            return false;
+        }
+        index.append(reinterpret_cast<const char*>(current), frameSize);
+        current += frameSize;
+    }
+
+    current = reinterpret_cast<const uchar*>(index.constData());
+    end = current + index.size();
+    quint32 numChunks;
+    if (!take(current, end, version) || version != INDEX_VERSION || !take(current, end, numChunks)) {
+        return false;
+    }
+    chunks.reserve(std::min((size_t)numChunks, (size_t)(end - current) / (sizeof(quint64) + sizeof(Frame::Time))));
+    for (quint32 i = 0; i < numChunks; ++i) {
+        Chunk chunk;
+        if (!take(current, end, chunk.fileOffset) || !take(current, end, chunk.firstTime) || chunk.fileOffset >= offset) {
+            chunks.clear();
+            return false;
+        }
+        chunks.push_back(chunk);
+    }
+
+    quint32 numTypes;
+    if (!take(current, end, numTypes)) {
+        chunks.clear();
+        return false;
+    }
+    for (quint32 i = 0; i < numTypes; ++i) {
+        TypeSummary summary;
+        if (!take(current, end, type) || !take(current, end, summary.frameCount) || !take(current, end, summary.lastTime)) {
+            chunks.clear();
+            types.clear();
+            return false;
+        }
+        types[type] = summary;
+    }
+
+    _numFrames = 0;
+    for (const auto& typeSummary : types) {
+        _numFrames += typeSummary.second.frameCount;
+    }
+    indexOffset = (size_t)offset;
+    return true;
+}
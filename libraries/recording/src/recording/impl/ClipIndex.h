@@ -0,0 +1,74 @@
+//
+//  ClipIndex.h
+//  libraries/recording/src/recording/impl
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Recording_Impl_ClipIndex_h
+#define hifi_Recording_Impl_ClipIndex_h
+
+#include <map>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include "../Frame.h"
+
+class QIODevice;
+
+namespace recording {
+
+// Index of the frames in a clip file, written in its footer.
+//
+// The frames of a file are grouped into chunks of FRAMES_PER_CHUNK frames, and the index holds the file offset and
+// time of the first frame of each chunk, so seeking only has to read the frames of one chunk.  Delta encoded frames
+// are encoded against the previous frame of their type in the same chunk, so each chunk starts with a keyframe of
+// every type.  The index also holds the number of frames and last time of each frame type, so a reader can tell the
+// length of a clip without reading its frames.
+//
+// The index is stored as frames of TYPE_INDEX after the last frame of the clip, and ends with a trailer frame that
+// points at the first of them.  Readers that predate the index skip these frames as an unknown type.
+struct ClipIndex {
+    static const FrameType TYPE_INDEX = 0xFFFD;
+    static const size_t FRAMES_PER_CHUNK = 256;
+    static const size_t TRAILER_SIZE; // trailer frame, including its frame header
+
+    struct Chunk {
+        quint64 fileOffset;
+        Frame::Time firstTime;
+    };
+
+    struct TypeSummary {
+        quint32 frameCount { 0 };
+        Frame::Time lastTime { 0 };
+    };
+
+    std::vector<Chunk> chunks;
+    std::map<FrameType, TypeSummary> types; // by the frame type stored in the file
+
+    /// \return data with the difference from the previous frame of its type applied, which both encodes a delta
+    /// frame and decodes it again
+    static QByteArray applyDelta(const QByteArray& data, const QByteArray& previous);
+
+    /// \return true if the frame starts a new chunk
+    bool addFrame(quint64 fileOffset, FrameType type, Frame::Time timeOffset);
+
+    /// \brief write the index and trailer frames, starting at fileOffset of output
+    bool write(QIODevice& output, quint64 fileOffset) const;
+    /// \brief read the index from the footer of a clip file
+    /// \param[out] indexOffset where the index frames start, the end of the clip's frames
+    /// \return false if the file has no index
+    bool read(const uchar* data, size_t size, size_t& indexOffset);
+
+private:
+    size_t _numFrames { 0 };
+};
+
+}
+
+#endif
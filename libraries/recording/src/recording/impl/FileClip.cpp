@@ -21,26 +21,32 @@
 
 using namespace recording;
 
-FileClip::FileClip(const QString& fileName) : _file(fileName) {
-    auto size = _file.size();
+FileClip::FileClip(const QString& fileName) : _fileName(fileName) {
+    // the file stays mapped, and frames point into it, until the clip and the last of its frames are gone
+    auto file = std::make_shared<QFile>(fileName);
+    auto size = file->size();
     qDebug(recordingLog) << "Opening file of size: " << size;
-    bool opened = _file.open(QIODevice::ReadOnly);
+    bool opened = file->open(QIODevice::ReadOnly);
     if (!opened) {
         qCWarning(recordingLog) << "Unable to open file " << fileName;
         return;
     }
-    auto mappedFile = _file.map(0, size, QFile::MapPrivateOption);
-    init(mappedFile, size);
+    auto mappedFile = file->map(0, size, QFile::MapPrivateOption);
+    if (!mappedFile) {
+        qCWarning(recordingLog) << "Unable to map file " << fileName;
+        return;
+    }
+    init(mappedFile, size, file);
 }
 
 
 QString FileClip::getName() const {
-    return _file.fileName();
+    return _fileName;
 }
 
 
 
-bool FileClip::write(const QString& fileName, Clip::Pointer clip) {
+bool FileClip::write(const QString& fileName, Clip::Pointer clip, Encoding encoding) {
     // FIXME need to move this to a different thread
     //qCDebug(recordingLog) << "Writing clip to file " << fileName << " with " << clip->frameCount() << " frames";
 
@@ -54,14 +60,10 @@ bool FileClip::write(const QString& fileName, Clip::Pointer clip) {
     }
 
     Finally closer([&] { outputFile.close(); });
-    return clip->write(outputFile);
+    return clip->write(outputFile, encoding);
 }
 
 FileClip::~FileClip() {
     Locker lock(_mutex);
-    _file.unmap(_data);
-    if (_file.isOpen()) {
-        _file.close();
-    }
     reset();
 }
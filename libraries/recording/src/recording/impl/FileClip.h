@@ -25,10 +25,10 @@ public:
 
     virtual QString getName() const override;
 
-    static bool write(const QString& filePath, Clip::Pointer clip);
+    static bool write(const QString& filePath, Clip::Pointer clip, Encoding encoding = Encoding::Raw);
 
 private:
-    QFile _file;
+    QString _fileName;
 };
 
 }
@@ -33,16 +33,22 @@ Frame::Time OffsetClip::positionFrameTime() const {
     return _wrappedClip->positionFrameTime() + _offset;
 }
 
-FrameConstPointer OffsetClip::peekFrame() const {
-    auto result = std::make_shared<Frame>(*_wrappedClip->peekFrame());
-    result->timeOffset += _offset;
+// the copy shares the data of the wrapped frame, which may point into the wrapped clip, so it holds on to it
+static FrameConstPointer offsetFrame(const FrameConstPointer& frame, Frame::Time offset) {
+    if (!frame) {
+        return frame;
+    }
+    FramePointer result(new Frame(*frame), [frame](Frame* copy) { delete copy; });
+    result->timeOffset += offset;
     return result;
 }
 
+FrameConstPointer OffsetClip::peekFrame() const {
+    return offsetFrame(_wrappedClip->peekFrame(), _offset);
+}
+
 FrameConstPointer OffsetClip::nextFrame() {
-    auto result = std::make_shared<Frame>(*_wrappedClip->nextFrame());
-    result->timeOffset += _offset;
-    return result;
+    return offsetFrame(_wrappedClip->nextFrame(), _offset);
 }
 
 float OffsetClip::duration() const {
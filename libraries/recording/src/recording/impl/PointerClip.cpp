@@ -44,116 +44,245 @@ FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
     return results;
 }
 
-
-PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size) {
-    PointerFrameHeaderList results;
-    auto current = start;
-    auto end = current + size;
-    // Read all the frame headers
-    // FIXME move to Frame::readHeader?
-    while (end - current >= PointerClip::MINIMUM_FRAME_SIZE) {
-        PointerFrameHeader header;
-        memcpy(&(header.type), current, sizeof(FrameType));
-        current += sizeof(FrameType);
-        memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
-        current += sizeof(Frame::Time);
-        memcpy(&(header.size), current, sizeof(FrameSize));
-        current += sizeof(FrameSize);
-        header.fileOffset = current - start;
-        if (end - current < header.size) {
-            break;
-        }
-        current += header.size;
-        results.push_back(header);
-    }
-    qDebug(recordingLog) << "Parsed source data into " << results.size() << " frames";
-//    int i = 0;
-//    for (const auto& frameHeader : results) {
-//        qDebug(recordingLog) << "Frame " << i++ << " time " << frameHeader.timeOffset << " Type " << frameHeader.type;
-//    }
-    return results;
-}
-
 void PointerClip::reset() {
-    _frames.clear();
     _data = nullptr;
     _size = 0;
+    _dataEnd = 0;
+    _owner.reset();
     _header = QJsonDocument();
+    _typeTranslation.clear();
+    _chunks.clear();
+    _frameCount = 0;
+    _lastTime = 0;
+    _cursor = Cursor();
+}
+
+bool PointerClip::readRecord(size_t offset, FrameRecord& record) const {
+    // FIXME move to Frame::readHeader?
+    if (offset >= _dataEnd || _dataEnd - offset < (size_t)MINIMUM_FRAME_SIZE) {
+        return false;
+    }
+    auto current = _data + offset;
+    memcpy(&(record.type), current, sizeof(FrameType));
+    current += sizeof(FrameType);
+    memcpy(&(record.timeOffset), current, sizeof(Frame::Time));
+    current += sizeof(Frame::Time);
+    memcpy(&(record.size), current, sizeof(FrameSize));
+    current += sizeof(FrameSize);
+    record.dataOffset = current - _data;
+    if (_dataEnd - record.dataOffset < record.size) {
+        return false;
+    }
+    record.nextOffset = record.dataOffset + record.size;
+    return true;
 }
 
-void PointerClip::init(uchar* data, size_t size) {
+void PointerClip::init(uchar* data, size_t size, const std::shared_ptr<void>& owner) {
     reset();
 
     _data = data;
     _size = size;
+    _dataEnd = size;
+    _owner = owner;
 
-    auto parsedFrameHeaders = parseFrameHeaders(data, size);
-    // Verify that at least one frame exists and that the first frame is a header
-    if (0 == parsedFrameHeaders.size()) {
+    // Grab the file header
+    FrameRecord fileHeaderRecord;
+    if (!readRecord(0, fileHeaderRecord)) {
         qWarning() << "No frames found, invalid file";
         reset();
         return;
     }
-
-    // Grab the file header
+    if (fileHeaderRecord.type != Frame::TYPE_HEADER) {
+        qWarning() << "Missing header frame, invalid file";
+        reset();
+        return;
+    }
     {
-        auto fileHeaderFrameHeader = *parsedFrameHeaders.begin();
-        parsedFrameHeaders.pop_front();
-        if (fileHeaderFrameHeader.type != Frame::TYPE_HEADER) {
-            qWarning() << "Missing header frame, invalid file";
-            reset();
-            return;
-        }
-
-        QByteArray fileHeaderData((char*)_data + fileHeaderFrameHeader.fileOffset, fileHeaderFrameHeader.size);
+        QByteArray fileHeaderData((char*)_data + fileHeaderRecord.dataOffset, fileHeaderRecord.size);
         _header = QJsonDocument::fromBinaryData(fileHeaderData);
     }
 
     // Check for compression
     {
         _compressed = _header.object()[FRAME_COMREPSSION_FLAG].toBool();
+        _delta = _header.object()[FRAME_DELTA_FLAG].toBool();
     }
 
-    // Find the type enum translation map and fix up the frame headers
-    {
-        FrameTranslationMap translationMap = parseTranslationMap(_header);
-        if (translationMap.empty()) {
-            qWarning() << "Header missing frame type map, invalid file";
-            reset();
-            return;
+    // Find the type enum translation map
+    _typeTranslation = parseTranslationMap(_header);
+    if (_typeTranslation.empty()) {
+        qWarning() << "Header missing frame type map, invalid file";
+        reset();
+        return;
+    }
+
+    // Read the index from the footer, or build it from the frame headers of a file written without one
+    ClipIndex index;
+    size_t indexOffset;
+    if (index.read(_data, _size, indexOffset)) {
+        _dataEnd = indexOffset;
+    } else {
+        FrameRecord record;
+        size_t offset = fileHeaderRecord.nextOffset;
+        for (; readRecord(offset, record); offset = record.nextOffset) {
+            index.addFrame(offset, record.type, record.timeOffset);
         }
+        _dataEnd = offset;
+    }
+    _chunks = std::move(index.chunks);
 
-        // Update the loaded headers with the frame data
-        _frames.reserve(parsedFrameHeaders.size());
-        for (auto& frameHeader : parsedFrameHeaders) {
-            if (!translationMap.contains(frameHeader.type)) {
-                continue;
-            }
-            frameHeader.type = translationMap[frameHeader.type];
-            _frames.push_back(frameHeader);
+    for (const auto& type : index.types) {
+        if (_typeTranslation.contains(type.first)) {
+            _frameCount += type.second.frameCount;
+            _lastTime = std::max(_lastTime, type.second.lastTime);
         }
     }
+    qDebug(recordingLog) << "Indexed source data of" << _frameCount << "frames in" << _chunks.size() << "chunks";
+
+    moveToChunk(_cursor, 0);
+}
+
+void PointerClip::moveTo(Cursor& cursor, size_t offset) const {
+    // skip the frames of types this process doesn't know about
+    FrameRecord record;
+    while (true) {
+        // delta frames start over at each chunk
+        while (cursor.chunk + 1 < _chunks.size() && offset >= _chunks[cursor.chunk + 1].fileOffset) {
+            ++cursor.chunk;
+            cursor.previousData.clear();
+        }
+        if (!readRecord(offset, record) || _typeTranslation.contains(record.type)) {
+            break;
+        }
+        offset = record.nextOffset;
+    }
+    cursor.offset = readRecord(offset, record) ? offset : _dataEnd;
+}
 
+void PointerClip::moveToChunk(Cursor& cursor, size_t chunk) const {
+    cursor.chunk = chunk;
+    cursor.previousData.clear();
+    moveTo(cursor, chunk < _chunks.size() ? _chunks[chunk].fileOffset : _dataEnd);
 }
 
 // Internal only function, needs no locking
-FrameConstPointer PointerClip::readFrame(size_t frameIndex) const {
+FramePointer PointerClip::readFrame(const FrameRecord& record, const Cursor& cursor) const {
     FramePointer result;
-    if (frameIndex < _frames.size()) {
+    const char* data = reinterpret_cast<const char*>(_data) + record.dataOffset;
+    if (_owner && !_compressed && !_delta) {
+        // point into the file, which stays around for as long as the frame does
+        auto owner = _owner;
+        result = FramePointer(new Frame(), [owner](Frame* frame) { delete frame; });
+        result->data = QByteArray::fromRawData(data, record.size);
+    } else {
         result = std::make_shared<Frame>();
-        const auto& header = _frames[frameIndex];
-        result->type = header.type;
-        result->timeOffset = header.timeOffset;
-        if (header.size) {
-            result->data.insert(0, reinterpret_cast<char*>(_data)+header.fileOffset, header.size);
+        if (record.size) {
+            result->data = QByteArray(data, record.size);
             if (_compressed) {
                 result->data = qUncompress(result->data);
             }
         }
+        if (_delta) {
+            auto previous = cursor.previousData.find(record.type);
+            if (previous != cursor.previousData.end()) {
+                result->data = ClipIndex::applyDelta(result->data, previous->second);
+            }
+        }
+    }
+    result->type = _typeTranslation[record.type];
+    result->timeOffset = record.timeOffset;
+    return result;
+}
+
+FramePointer PointerClip::advance(Cursor& cursor, bool needFrame) const {
+    FramePointer result;
+    FrameRecord record;
+    if (!readRecord(cursor.offset, record)) {
+        return result;
+    }
+    // a delta frame is needed to read the next one of its type
+    if (needFrame || _delta) {
+        result = readFrame(record, cursor);
+    }
+    if (_delta) {
+        cursor.previousData[record.type] = result->data;
     }
+    moveTo(cursor, record.nextOffset);
     return result;
 }
 
+Clip::Pointer PointerClip::duplicate() const {
+    auto result = newClip();
+    Locker lock(_mutex);
+    Cursor cursor;
+    moveToChunk(cursor, 0);
+    for (auto frame = advance(cursor, true); frame; frame = advance(cursor, true)) {
+        // the copy outlives the frame, so it can't point into this clip's data
+        if (_owner && !frame->data.isEmpty()) {
+            frame->data = QByteArray(frame->data.constData(), frame->data.size());
+        }
+        result->addFrame(frame);
+    }
+    return result;
+}
+
+float PointerClip::duration() const {
+    Locker lock(_mutex);
+    return _frameCount ? Frame::frameTimeToSeconds(_lastTime) : 0.0f;
+}
+
+size_t PointerClip::frameCount() const {
+    Locker lock(_mutex);
+    return _frameCount;
+}
+
+void PointerClip::seekFrameTime(Frame::Time offset) {
+    Locker lock(_mutex);
+    // start from the last chunk that starts before offset, as frames at offset may be at the end of it
+    auto itr = std::lower_bound(_chunks.begin(), _chunks.end(), offset,
+        [](const ClipIndex::Chunk& chunk, Frame::Time time)->bool {
+            return chunk.firstTime < time;
+        }
+    );
+    size_t chunk = (itr == _chunks.begin()) ? 0 : (itr - _chunks.begin()) - 1;
+    moveToChunk(_cursor, chunk);
+
+    FrameRecord record;
+    while (readRecord(_cursor.offset, record) && record.timeOffset < offset) {
+        advance(_cursor, false);
+    }
+}
+
+Frame::Time PointerClip::positionFrameTime() const {
+    Locker lock(_mutex);
+    Frame::Time result = Frame::INVALID_TIME;
+    FrameRecord record;
+    if (readRecord(_cursor.offset, record)) {
+        result = record.timeOffset;
+    }
+    return result;
+}
+
+FrameConstPointer PointerClip::peekFrame() const {
+    Locker lock(_mutex);
+    FrameConstPointer result;
+    FrameRecord record;
+    if (readRecord(_cursor.offset, record)) {
+        result = readFrame(record, _cursor);
+    }
+    return result;
+}
+
+FrameConstPointer PointerClip::nextFrame() {
+    Locker lock(_mutex);
+    return advance(_cursor, true);
+}
+
+void PointerClip::skipFrame() {
+    Locker lock(_mutex);
+    advance(_cursor, false);
+}
+
 void PointerClip::addFrame(FrameConstPointer) {
     throw std::runtime_error("Pointer clips are read only, use duplicate to create a read/write clip");
 }
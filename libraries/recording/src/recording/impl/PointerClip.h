@@ -10,34 +10,48 @@
 #ifndef hifi_Recording_Impl_PointerClip_h
 #define hifi_Recording_Impl_PointerClip_h
 
-#include "ArrayClip.h"
+#include "../Clip.h"
 
 #include <mutex>
+#include <unordered_map>
 
 #include <QtCore/QJsonDocument>
+#include <QtCore/QMap>
 
 #include "../Frame.h"
+#include "ClipIndex.h"
 
 namespace recording {
 
-struct PointerFrameHeader : public FrameHeader {
-    FrameType type;
-    Frame::Time timeOffset;
-    uint16_t size;
-    quint64 fileOffset;
-};
-
-using PointerFrameHeaderList = std::list<PointerFrameHeader>;
-
-class PointerClip : public ArrayClip<PointerFrameHeader> {
+// A clip read in place from the contents of a clip file.
+//
+// Only the chunk index of the file is kept in memory, read from the file's footer or, for files written before
+// there was one, built with a pass over the frame headers.  Frames are read as they are played, and seeking reads
+// at most one chunk of frames.
+class PointerClip : public Clip {
 public:
     using Pointer = std::shared_ptr<PointerClip>;
 
     PointerClip() {};
     PointerClip(uchar* data, size_t size) { init(data, size); }
 
-    void init(uchar* data, size_t size);
+    /// \param owner if set, keeps data alive for as long as frames read from it, so their data can point into it
+    /// rather than be copied
+    void init(uchar* data, size_t size, const std::shared_ptr<void>& owner = std::shared_ptr<void>());
+
+    virtual Clip::Pointer duplicate() const override;
+
+    virtual float duration() const override;
+    virtual size_t frameCount() const override;
+
+    virtual void seekFrameTime(Frame::Time offset) override;
+    virtual Frame::Time positionFrameTime() const override;
+
+    virtual FrameConstPointer peekFrame() const override;
+    virtual FrameConstPointer nextFrame() override;
+    virtual void skipFrame() override;
     virtual void addFrame(FrameConstPointer) override;
+
     const QJsonDocument& getHeader() const {
         return _header;
     }
@@ -45,12 +59,42 @@ public:
     // FIXME move to frame?
     static const qint64 MINIMUM_FRAME_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize);
 protected:
+    struct FrameRecord {
+        FrameType type; // as stored in the file
+        Frame::Time timeOffset;
+        FrameSize size;
+        size_t dataOffset;
+        size_t nextOffset;
+    };
+
+    struct Cursor {
+        size_t offset { 0 }; // of the next frame to play, or the end of the frames
+        size_t chunk { 0 };
+        std::unordered_map<FrameType, QByteArray> previousData; // of each type in the chunk, for delta frames
+    };
+
     void reset() override;
-    virtual FrameConstPointer readFrame(size_t index) const override;
+
+    bool readRecord(size_t offset, FrameRecord& record) const;
+    void moveTo(Cursor& cursor, size_t offset) const;
+    void moveToChunk(Cursor& cursor, size_t chunk) const;
+    FramePointer readFrame(const FrameRecord& record, const Cursor& cursor) const;
+    FramePointer advance(Cursor& cursor, bool needFrame) const;
+
     QJsonDocument _header;
     uchar* _data { nullptr };
     size_t _size { 0 };
+    size_t _dataEnd { 0 }; // end of the frames, where the index starts
+    std::shared_ptr<void> _owner;
     bool _compressed { true };
+    bool _delta { false };
+
+    QMap<FrameType, FrameType> _typeTranslation; // from the types stored in the file to the current ones
+    std::vector<ClipIndex::Chunk> _chunks;
+    size_t _frameCount { 0 };
+    Frame::Time _lastTime { 0 };
+
+    Cursor _cursor;
 };
 
 }
@@ -1169,6 +1169,17 @@ void Model::setTextures(const QVariantMap& textures) {
     }
 }
 
+void Model::setLoadingPriority(float priority) {
+    if (priority == _loadingPriority) {
+        return;
+    }
+    _loadingPriority = priority;
+    auto resource = _renderWatcher.getResource();
+    if (resource && !resource->isLoaded()) {
+        resource->setLoadPriority(this, _loadingPriority);
+    }
+}
+
 void Model::setURL(const QUrl& url) {
     // don't recreate the geometry if it's the same URL
     if (_url == url && _renderWatcher.getURL() == url) {
@@ -16,6 +16,7 @@
 
 #include <PerfStat.h>
 #include <OctreeUtils.h>
+#include <TBBHelpers.h>
 
 using namespace render;
 
@@ -169,6 +170,53 @@ void FetchSpatialTree::run(const RenderContextPointer& renderContext, const Inpu
     }
 }
 
+template <typename Cull>
+void CullSpatialSelection::cullSelectedItems(RenderArgs* args, Scene& scene, const ItemFilter& filter, const ItemIDs& ids,
+                                             Cull cull, RenderDetails::Item& details, ItemBounds& outItems) {
+    auto cullRange = [&](size_t begin, size_t end, RenderDetails::Item& rangeDetails, ItemBounds& rangeItems) {
+        CullTest test(_cullFunctor, args, rangeDetails);
+        for (size_t i = begin; i < end; ++i) {
+            auto id = ids[i];
+            auto& item = scene.getItem(id);
+            if (filter.test(item.getKey())) {
+                ItemBound itemBound(id, item.getBound());
+                if (cull(test, itemBound.bound)) {
+                    rangeItems.emplace_back(itemBound);
+                    if (item.getKey().isMetaCullGroup()) {
+                        item.fetchMetaSubItemBounds(rangeItems, scene);
+                    }
+                }
+            }
+        }
+    };
+
+    size_t numRanges = (ids.size() + CULL_RANGE_SIZE - 1) / CULL_RANGE_SIZE;
+    if (numRanges <= 1) {
+        cullRange(0, ids.size(), details, outItems);
+        return;
+    }
+
+    // Every range culls into its own items and counts, which are then appended in selection order so that the result
+    // is the same as culling serially
+    if (_rangeItems.size() < numRanges) {
+        _rangeItems.resize(numRanges);
+    }
+    _rangeDetails.assign(numRanges, RenderDetails::Item());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numRanges, 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t r = range.begin(); r < range.end(); ++r) {
+            size_t begin = r * CULL_RANGE_SIZE;
+            _rangeItems[r].clear();
+            cullRange(begin, std::min(begin + CULL_RANGE_SIZE, ids.size()), _rangeDetails[r], _rangeItems[r]);
+        }
+    });
+
+    for (size_t r = 0; r < numRanges; ++r) {
+        outItems.insert(outItems.end(), _rangeItems[r].begin(), _rangeItems[r].end());
+        details._outOfView += _rangeDetails[r]._outOfView;
+        details._tooSmall += _rangeDetails[r]._tooSmall;
+    }
+}
+
 void CullSpatialSelection::configure(const Config& config) {
     _justFrozeFrustum = _justFrozeFrustum || (config.freezeFrustum && !_freezeFrustum);
     _freezeFrustum = config.freezeFrustum;
@@ -195,8 +243,6 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         args->pushViewFrustum(_frozenFrustum); // replace the true view frustum by the frozen one
     }
 
-    CullTest test(_cullFunctor, args, details);
-
     // Now we have a selection of items to render
     outItems.clear();
     outItems.reserve(inSelection.numItems());
@@ -205,6 +251,13 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
     if (!srcFilter.selectsNothing()) {
         auto filter = render::ItemFilter::Builder(srcFilter).withoutSubMetaCulled().build();
 
+        auto pass = [](CullTest&, const AABox&) { return true; };
+        auto solidAngleCull = [](CullTest& test, const AABox& bound) { return test.solidAngleTest(bound); };
+        auto frustumCull = [](CullTest& test, const AABox& bound) { return test.frustumTest(bound); };
+        auto frustumAndSolidAngleCull = [](CullTest& test, const AABox& bound) {
+            return test.frustumTest(bound) && test.solidAngleTest(bound);
+        };
+
         // Now get the bound, and
         // filter individually against the _filter
         // visibility cull if partially selected ( octree cell contianing it was partial)
@@ -213,61 +266,25 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
             // inside & fit items: filter only, culling is disabled
             {
                 PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
+                cullSelectedItems(args, *scene, filter, inSelection.insideItems, pass, details, outItems);
             }
 
             // inside & subcell items: filter only, culling is disabled
             {
                 PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
+                cullSelectedItems(args, *scene, filter, inSelection.insideSubcellItems, pass, details, outItems);
             }
 
             // partial & fit items: filter only, culling is disabled
             {
                 PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
+                cullSelectedItems(args, *scene, filter, inSelection.partialItems, pass, details, outItems);
             }
 
             // partial & subcell items: filter only, culling is disabled
             {
                 PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
+                cullSelectedItems(args, *scene, filter, inSelection.partialSubcellItems, pass, details, outItems);
             }
 
         } else {
@@ -275,69 +292,25 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
             // inside & fit items: easy, just filter
             {
                 PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
+                cullSelectedItems(args, *scene, filter, inSelection.insideItems, pass, details, outItems);
             }
 
             // inside & subcell items: filter & distance cull
             {
                 PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene));
-                            }
-                        }
-                    }
-                }
+                cullSelectedItems(args, *scene, filter, inSelection.insideSubcellItems, solidAngleCull, details, outItems);
             }
 
             // partial & fit items: filter & frustum cull
             {
                 PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene));
-                            }
-                        }
-                    }
-                }
+                cullSelectedItems(args, *scene, filter, inSelection.partialItems, frustumCull, details, outItems);
             }
 
             // partial & subcell items:: filter & frutum cull & solidangle cull
             {
                 PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            if (test.solidAngleTest(itemBound.bound)) {
-                                outItems.emplace_back(itemBound);
-                                if (item.getKey().isMetaCullGroup()) {
-                                    item.fetchMetaSubItemBounds(outItems, (*scene));
-                                }
-                            }
-                        }
-                    }
-                }
+                cullSelectedItems(args, *scene, filter, inSelection.partialSubcellItems, frustumAndSolidAngleCull, details, outItems);
             }
         }
     }
@@ -122,6 +122,19 @@ namespace render {
 
         void configure(const Config& config);
         void run(const RenderContextPointer& renderContext, const Inputs& inputs, ItemBounds& outItems);
+
+    private:
+        // Selected items are filtered and culled across the worker pool in ranges of this many
+        static const size_t CULL_RANGE_SIZE = 256;
+
+        // Appends the items passing the filter and the cull, and the meta sub items of the cull groups among them
+        template <typename Cull>
+        void cullSelectedItems(RenderArgs* args, Scene& scene, const ItemFilter& filter, const ItemIDs& ids, Cull cull,
+                               RenderDetails::Item& details, ItemBounds& outItems);
+
+        // the results of each range, kept to reuse their allocations from frame to frame
+        std::vector<ItemBounds> _rangeItems;
+        std::vector<RenderDetails::Item> _rangeDetails;
     };
 
     class CullShapeBounds {
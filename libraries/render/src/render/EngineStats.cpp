@@ -63,4 +63,20 @@ void EngineStats::run(const RenderContextPointer& renderContext) {
 
     config->frameSetPipelineCount = _gpuStats._PSNumSetPipelines;
     config->frameSetInputFormatCount = _gpuStats._ISNumFormatChanges;
+
+    auto& scene = renderContext->_scene;
+    if (scene) {
+        uint64_t numTransactions = scene->getNumEnqueuedTransactions();
+        uint64_t numItemChanges = scene->getNumProcessedItemChanges();
+        uint64_t transactionProcessingTime = scene->getTransactionProcessingTime();
+
+        config->frameTransactionCount = (quint32)(numTransactions - _numTransactions);
+        config->frameTransactionRate = config->frameTransactionCount * frequency;
+        config->frameItemChangeCount = (quint32)(numItemChanges - _numItemChanges);
+        config->frameTransactionProcessingTime = (quint32)(transactionProcessingTime - _transactionProcessingTime);
+
+        _numTransactions = numTransactions;
+        _numItemChanges = numItemChanges;
+        _transactionProcessingTime = transactionProcessingTime;
+    }
 }
@@ -61,6 +61,11 @@ namespace render {
         Q_PROPERTY(quint32 frameSetPipelineCount MEMBER frameSetPipelineCount NOTIFY dirty)
         Q_PROPERTY(quint32 frameSetInputFormatCount MEMBER frameSetInputFormatCount NOTIFY dirty)
 
+        Q_PROPERTY(quint32 frameTransactionCount MEMBER frameTransactionCount NOTIFY dirty)
+        Q_PROPERTY(quint32 frameTransactionRate MEMBER frameTransactionRate NOTIFY dirty)
+        Q_PROPERTY(quint32 frameItemChangeCount MEMBER frameItemChangeCount NOTIFY dirty)
+        Q_PROPERTY(quint32 frameTransactionProcessingTime MEMBER frameTransactionProcessingTime NOTIFY dirty)
+
 
     public:
         EngineStatsConfig() : Job::Config(true) {}
@@ -102,6 +107,12 @@ namespace render {
 
         quint32 frameSetInputFormatCount{ 0 };
 
+        // Scene transactions enqueued and items they reset, updated or removed since the last frame, and how long
+        // the render thread took to apply them in usecs
+        quint32 frameTransactionCount{ 0 };
+        quint32 frameTransactionRate{ 0 };
+        quint32 frameItemChangeCount{ 0 };
+        quint32 frameTransactionProcessingTime{ 0 };
 
 
         void emitDirty() { emit dirty(); }
@@ -113,6 +124,11 @@ namespace render {
     class EngineStats {
         gpu::ContextStats _gpuStats;
         QElapsedTimer _frameTimer;
+
+        // the scene's totals at the last frame
+        uint64_t _numTransactions { 0 };
+        uint64_t _numItemChanges { 0 };
+        uint64_t _transactionProcessingTime { 0 };
     public:
         using Config = EngineStatsConfig;
         using JobModel = Job::Model<EngineStats, Config>;
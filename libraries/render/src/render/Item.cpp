@@ -72,6 +72,82 @@ void Item::PayloadInterface::addStatusGetters(const Status::Getters& getters) {
     }
 }
 
+// Pooled blocks are of 64, 128 or 256 bytes, bigger functors come straight from the heap
+static const size_t MIN_POOLED_BLOCK_SIZE = 64;
+static const int NUM_POOLED_BLOCK_SIZES = 3;
+static const size_t POOLED_BLOCK_BATCH_SIZE = 64;
+
+static int getPooledBlockSizeIndex(size_t size) {
+    for (int i = 0; i < NUM_POOLED_BLOCK_SIZES; ++i) {
+        if (size <= (MIN_POOLED_BLOCK_SIZE << i)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+class PooledBlocks {
+public:
+    std::vector<void*> blocks[NUM_POOLED_BLOCK_SIZES];
+};
+
+// Where the render thread leaves the blocks it frees for the threads making the functors.  Never destroyed, as the
+// caches of the threads still running at exit give their blocks back to it
+static std::mutex pooledBlockDepotMutex;
+static PooledBlocks* pooledBlockDepot = new PooledBlocks();
+
+static void moveBlockBatch(std::vector<void*>& from, std::vector<void*>& to) {
+    size_t numBlocks = std::min(from.size(), POOLED_BLOCK_BATCH_SIZE);
+    to.insert(to.end(), from.end() - numBlocks, from.end());
+    from.resize(from.size() - numBlocks);
+}
+
+class PooledBlockCache : public PooledBlocks {
+public:
+    ~PooledBlockCache() {
+        std::lock_guard<std::mutex> lock(pooledBlockDepotMutex);
+        for (int i = 0; i < NUM_POOLED_BLOCK_SIZES; ++i) {
+            auto& depotBlocks = pooledBlockDepot->blocks[i];
+            depotBlocks.insert(depotBlocks.end(), blocks[i].begin(), blocks[i].end());
+        }
+    }
+};
+static thread_local PooledBlockCache pooledBlockCache;
+
+void* UpdateFunctorPool::allocate(size_t size) {
+    int index = getPooledBlockSizeIndex(size);
+    if (index < 0) {
+        return ::operator new(size);
+    }
+
+    auto& blocks = pooledBlockCache.blocks[index];
+    if (blocks.empty()) {
+        std::lock_guard<std::mutex> lock(pooledBlockDepotMutex);
+        moveBlockBatch(pooledBlockDepot->blocks[index], blocks);
+    }
+    if (blocks.empty()) {
+        return ::operator new(MIN_POOLED_BLOCK_SIZE << index);
+    }
+    void* block = blocks.back();
+    blocks.pop_back();
+    return block;
+}
+
+void UpdateFunctorPool::deallocate(void* block, size_t size) {
+    int index = getPooledBlockSizeIndex(size);
+    if (index < 0) {
+        ::operator delete(block);
+        return;
+    }
+
+    auto& blocks = pooledBlockCache.blocks[index];
+    blocks.push_back(block);
+    if (blocks.size() >= 2 * POOLED_BLOCK_BATCH_SIZE) {
+        std::lock_guard<std::mutex> lock(pooledBlockDepotMutex);
+        moveBlockBatch(blocks, pooledBlockDepot->blocks[index]);
+    }
+}
+
 void Item::update(const UpdateFunctorPointer& updateFunctor) {
     if (updateFunctor) {
         _payload->update(updateFunctor);
@@ -507,13 +507,44 @@ typedef Item::UpdateFunctorInterface UpdateFunctorInterface;
 typedef Item::UpdateFunctorPointer UpdateFunctorPointer;
 typedef std::vector<UpdateFunctorPointer> UpdateFunctors;
 
+// Update functors are made by the thousand every frame on many threads then destroyed on the render thread, so their
+// memory comes from blocks of a few sizes which each thread caches, and which travel between threads in batches
+class UpdateFunctorPool {
+public:
+    static void* allocate(size_t size);
+    static void deallocate(void* block, size_t size);
+};
+
+template <class T> class UpdateFunctorAllocator {
+public:
+    using value_type = T;
+
+    UpdateFunctorAllocator() {}
+    template <class U> UpdateFunctorAllocator(const UpdateFunctorAllocator<U>& other) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(UpdateFunctorPool::allocate(n * sizeof(T))); }
+    void deallocate(T* pointer, size_t n) { UpdateFunctorPool::deallocate(pointer, n * sizeof(T)); }
+
+    template <class U> bool operator==(const UpdateFunctorAllocator<U>& other) const { return true; }
+    template <class U> bool operator!=(const UpdateFunctorAllocator<U>& other) const { return false; }
+};
+
 template <class T> class UpdateFunctor : public Item::UpdateFunctorInterface {
 public:
     typedef std::function<void(T&)> Func;
-    Func _func;
 
-    UpdateFunctor(Func func): _func(func) {}
-    ~UpdateFunctor() {}
+    virtual void apply(T& data) = 0;
+};
+
+// Holds the function itself rather than a std::function, which would allocate again for most lambda captures
+template <class T, class F> class FunctionUpdateFunctor : public UpdateFunctor<T> {
+public:
+    FunctionUpdateFunctor(F func) : _func(std::move(func)) {}
+
+    void apply(T& data) override { _func(data); }
+
+private:
+    F _func;
 };
 
 
@@ -566,7 +597,7 @@ protected:
 
     // Update mechanics
     virtual void update(const UpdateFunctorPointer& functor) override {
-        std::static_pointer_cast<Updater>(functor)->_func((*_data));
+        std::static_pointer_cast<Updater>(functor)->apply((*_data));
     }
     friend class Item;
 };
@@ -10,8 +10,10 @@
 //
 #include "Scene.h"
 
+#include <algorithm>
 #include <numeric>
 #include <gpu/Batch.h>
+#include <SharedUtil.h>
 #include "Logging.h"
 #include "TransitionStage.h"
 #include "HighlightStage.h"
@@ -189,6 +191,12 @@ Scene::Scene(glm::vec3 origin, float size) :
 
 Scene::~Scene() {
     qCDebug(renderlogging) << "Scene::~Scene()";
+    auto pending = _pendingTransactions.exchange(nullptr);
+    while (pending) {
+        auto next = pending->next;
+        delete pending;
+        pending = next;
+    }
 }
 
 ItemID Scene::allocateID() {
@@ -200,30 +208,44 @@ bool Scene::isAllocatedID(const ItemID& id) const {
     return Item::isValidID(id) && (id < _numAllocatedItems.load());
 }
 
+void Scene::pushPendingTransaction(PendingTransaction* pending) {
+    pending->next = _pendingTransactions.load(std::memory_order_relaxed);
+    while (!_pendingTransactions.compare_exchange_weak(pending->next, pending, std::memory_order_release,
+                                                       std::memory_order_relaxed)) {
+    }
+}
+
 /// Enqueue change batch to the scene
 void Scene::enqueueTransaction(const Transaction& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(transaction);
+    pushPendingTransaction(new PendingTransaction(Transaction(transaction)));
 }
 
 void Scene::enqueueTransaction(Transaction&& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(std::move(transaction));
+    pushPendingTransaction(new PendingTransaction(std::move(transaction)));
 }
 
 uint32_t Scene::enqueueFrame() {
     PROFILE_RANGE(render, __FUNCTION__);
+
+    // Take all the pending transactions, and put them back in the order they were enqueued
+    auto pending = _pendingTransactions.exchange(nullptr, std::memory_order_acquire);
     TransactionQueue localTransactionQueue;
-    {
-        std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-        localTransactionQueue.swap(_transactionQueue);
+    for (auto transaction = pending; transaction; transaction = transaction->next) {
+        localTransactionQueue.emplace_back(std::move(transaction->transaction));
+    }
+    while (pending) {
+        auto next = pending->next;
+        delete pending;
+        pending = next;
     }
+    std::reverse(localTransactionQueue.begin(), localTransactionQueue.end());
+    _numEnqueuedTransactions += localTransactionQueue.size();
 
     Transaction consolidatedTransaction;
     consolidatedTransaction.merge(std::move(localTransactionQueue));
     {
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
-        _transactionFrames.push_back(consolidatedTransaction);
+        _transactionFrames.push_back(std::move(consolidatedTransaction));
     }
 
     return ++_transactionFrameNumber;
@@ -232,6 +254,7 @@ uint32_t Scene::enqueueFrame() {
  
 void Scene::processTransactionQueue() {
     PROFILE_RANGE(render, __FUNCTION__);
+    uint64_t start = usecTimestampNow();
 
     static TransactionFrames queuedFrames;
     {
@@ -246,10 +269,14 @@ void Scene::processTransactionQueue() {
     }
 
     queuedFrames.clear();
+
+    _transactionProcessingTime += usecTimestampNow() - start;
 }
 
-void Scene::processTransactionFrame(const Transaction& transaction) {
+void Scene::processTransactionFrame(Transaction& transaction) {
     PROFILE_RANGE(render, __FUNCTION__);
+    _numProcessedItemChanges += transaction._resetItems.size() + transaction._updatedItems.size() +
+        transaction._removedItems.size();
     {
         std::unique_lock<std::mutex> lock(_itemsMutex);
         // Here we should be able to check the value of last ItemID allocated 
@@ -290,8 +317,22 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
     queryHighlights(transaction._highlightQueries);
 }
 
-void Scene::resetItems(const Transaction::Resets& transactions) {
-    for (auto& reset : transactions) {
+void Scene::resetItems(Transaction::Resets& transactions) {
+    // Walking the items and the tree in ID order is kinder to the caches.  The sort is stable so that, of the resets of
+    // one item, only the last one enqueued is applied.
+    auto byID = [](const Transaction::Reset& left, const Transaction::Reset& right) {
+        return std::get<0>(left) < std::get<0>(right);
+    };
+    if (!std::is_sorted(transactions.begin(), transactions.end(), byID)) {
+        std::stable_sort(transactions.begin(), transactions.end(), byID);
+    }
+
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        auto& reset = transactions[i];
+        if (i + 1 < transactions.size() && std::get<0>(transactions[i + 1]) == std::get<0>(reset)) {
+            continue;
+        }
+
         // Access the true item
         auto itemId = std::get<0>(reset);
         auto& item = _items[itemId];
@@ -313,7 +354,11 @@ void Scene::resetItems(const Transaction::Resets& transactions) {
     }
 }
 
-void Scene::removeItems(const Transaction::Removes& transactions) {
+void Scene::removeItems(Transaction::Removes& transactions) {
+    // in ID order, and each item once
+    std::sort(transactions.begin(), transactions.end());
+    transactions.erase(std::unique(transactions.begin(), transactions.end()), transactions.end());
+
     for (auto removedID : transactions) {
         // Access the true item
         auto& item = _items[removedID];
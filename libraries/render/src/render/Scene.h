@@ -50,8 +50,9 @@ public:
     void resetItem(ItemID id, const PayloadPointer& payload);
     void removeItem(ItemID id);
     bool hasRemovedItems() const { return !_removedItems.empty(); }
-    template <class T> void updateItem(ItemID id, std::function<void(T&)> func) {
-        updateItem(id, std::make_shared<UpdateFunctor<T>>(func));
+    template <class T, class F> void updateItem(ItemID id, F&& func) {
+        using Functor = FunctionUpdateFunctor<T, typename std::decay<F>::type>;
+        updateItem(id, std::allocate_shared<Functor>(UpdateFunctorAllocator<Functor>(), std::forward<F>(func)));
     }
     void updateItem(ItemID id, const UpdateFunctorPointer& functor);
     void updateItem(ItemID id) { updateItem(id, nullptr); }
@@ -158,6 +159,11 @@ public:
     // Process the pending transactions queued
     void processTransactionQueue();
 
+    // Totals since the scene was created, for the stats to measure rates from
+    uint64_t getNumEnqueuedTransactions() const { return _numEnqueuedTransactions.load(); }
+    uint64_t getNumProcessedItemChanges() const { return _numProcessedItemChanges.load(); }
+    uint64_t getTransactionProcessingTime() const { return _transactionProcessingTime.load(); } // usecs
+
     // Access a particular selection (empty if doesn't exist)
     // Thread safe
     Selection getSelection(const Selection::Name& name) const;
@@ -199,17 +205,30 @@ protected:
     // Thread safe elements that can be accessed from anywhere
     std::atomic<unsigned int> _IDAllocator{ 1 }; // first valid itemID will be One
     std::atomic<unsigned int> _numAllocatedItems{ 1 }; // num of allocated items, matching the _items.size()
-    std::mutex _transactionQueueMutex;
-    TransactionQueue _transactionQueue;
 
-    
+    // The transactions enqueued since the last frame, newest first.  Any thread pushes its own with a single
+    // compare and swap, and enqueueFrame takes them all at once.
+    class PendingTransaction {
+    public:
+        PendingTransaction(Transaction&& transaction) : transaction(std::move(transaction)) {}
+
+        Transaction transaction;
+        PendingTransaction* next { nullptr };
+    };
+    std::atomic<PendingTransaction*> _pendingTransactions { nullptr };
+    void pushPendingTransaction(PendingTransaction* pending);
+
     std::mutex _transactionFramesMutex;
     using TransactionFrames = std::vector<Transaction>;
     TransactionFrames _transactionFrames;
     uint32_t _transactionFrameNumber{ 0 };
 
+    std::atomic<uint64_t> _numEnqueuedTransactions { 0 };
+    std::atomic<uint64_t> _numProcessedItemChanges { 0 };
+    std::atomic<uint64_t> _transactionProcessingTime { 0 };
+
     // Process one transaction frame 
-    void processTransactionFrame(const Transaction& transaction);
+    void processTransactionFrame(Transaction& transaction);
 
     // The actual database
     // database of items is protected for editing by a mutex
@@ -218,9 +237,10 @@ protected:
     ItemSpatialTree _masterSpatialTree;
     ItemIDSet _masterNonspatialSet;
 
-    void resetItems(const Transaction::Resets& transactions);
+    // Resets and removes are applied in ItemID order, sorting them in place
+    void resetItems(Transaction::Resets& transactions);
     void resetTransitionFinishedOperator(const Transaction::TransitionFinishedOperators& transactions);
-    void removeItems(const Transaction::Removes& transactions);
+    void removeItems(Transaction::Removes& transactions);
     void updateItems(const Transaction::Updates& transactions);
 
     void resetTransitionItems(const Transaction::TransitionResets& transactions);
@@ -14,6 +14,8 @@
 
 #include <assert.h>
 #include <ViewFrustum.h>
+#include <TBBHelpers.h>
+#include <tbb/parallel_sort.h>
 
 using namespace render;
 
@@ -28,25 +30,32 @@ struct ItemBoundSort {
     ItemBoundSort(float centerDepth, float nearDepth, float farDepth, ItemID id, const AABox& bounds) : _centerDepth(centerDepth), _nearDepth(nearDepth), _farDepth(farDepth), _id(id), _bounds(bounds) {}
 };
 
+// Ties are broken by ID so that the order doesn't depend on how the sort splits the work
 struct FrontToBackSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth < right._centerDepth);
+    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) const {
+        return (left._centerDepth < right._centerDepth) || (left._centerDepth == right._centerDepth && left._id < right._id);
     }
 };
 
 struct BackToFrontSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth > right._centerDepth);
+    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) const {
+        return (left._centerDepth > right._centerDepth) || (left._centerDepth == right._centerDepth && left._id < right._id);
     }
 };
 
+// Depths of more items than this are computed across the worker pool
+static const size_t PARALLEL_DEPTH_GRAIN_SIZE = 1024;
+
+// Items are bucketed by pipeline across the worker pool in ranges of this many
+static const size_t PIPELINE_SORT_RANGE_SIZE = 1024;
+
 void render::depthSortItems(const RenderContextPointer& renderContext, bool frontToBack, 
                             const ItemBounds& inItems, ItemBounds& outItems, AABox* bounds) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
-    auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
+    const ViewFrustum& frustum = args->getViewFrustum();
 
 
     // Allocate and simply copy
@@ -55,24 +64,32 @@ void render::depthSortItems(const RenderContextPointer& renderContext, bool fron
 
 
     // Make a local dataset of the center distance and closest point distance
-    std::vector<ItemBoundSort> itemBoundSorts;
-    itemBoundSorts.reserve(outItems.size());
-
-    for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
-        auto bound = itemDetails.bound; // item.getBound();
-        float distanceSquared = args->getViewFrustum().distanceToCameraSquared(bound.calcCenter());
-
-        itemBoundSorts.emplace_back(ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, itemDetails.id, bound));
+    std::vector<ItemBoundSort> itemBoundSorts(inItems.size());
+
+    auto evalDepths = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            auto& itemDetails = inItems[i];
+            auto& bound = itemDetails.bound;
+            float distanceSquared = frustum.distanceToCameraSquared(bound.calcCenter());
+            itemBoundSorts[i] = ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, itemDetails.id, bound);
+        }
+    };
+    if (inItems.size() > PARALLEL_DEPTH_GRAIN_SIZE) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, inItems.size(), PARALLEL_DEPTH_GRAIN_SIZE),
+            [&](const tbb::blocked_range<size_t>& range) {
+                evalDepths(range.begin(), range.end());
+            });
+    } else {
+        evalDepths(0, inItems.size());
     }
 
     // sort against Z
     if (frontToBack) {
         FrontToBackSort frontToBackSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
+        tbb::parallel_sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
     } else {
         BackToFrontSort  backToFrontSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
+        tbb::parallel_sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
     }
 
     // Finally once sorted result to a list of itemID and keep uniques
@@ -102,54 +119,79 @@ void PipelineSortShapes::run(const RenderContextPointer& renderContext, const It
     auto& scene = renderContext->_scene;
     outShapes.clear();
 
-    for (const auto& item : inItems) {
-        auto key = scene->getItem(item.id).getShapeKey();
-        auto outItems = outShapes.find(key);
-        if (outItems == outShapes.end()) {
-            outItems = outShapes.insert(std::make_pair(key, ItemBounds{})).first;
-            outItems->second.reserve(inItems.size());
+    auto sortRange = [&](size_t begin, size_t end, ShapeBounds& shapes) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto& item = inItems[i];
+            shapes[scene->getItem(item.id).getShapeKey()].push_back(item);
         }
+    };
 
-        outItems->second.push_back(item);
+    size_t numRanges = (inItems.size() + PIPELINE_SORT_RANGE_SIZE - 1) / PIPELINE_SORT_RANGE_SIZE;
+    if (_rangeShapes.size() < numRanges) {
+        _rangeShapes.resize(numRanges);
     }
 
-    for (auto& items : outShapes) {
-        items.second.shrink_to_fit();
+    // Every range buckets its items on its own, keeping the buckets from last frame to reuse their allocations
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numRanges, 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t r = range.begin(); r < range.end(); ++r) {
+            auto& shapes = _rangeShapes[r];
+            for (auto& items : shapes) {
+                items.second.clear();
+            }
+            size_t begin = r * PIPELINE_SORT_RANGE_SIZE;
+            sortRange(begin, std::min(begin + PIPELINE_SORT_RANGE_SIZE, inItems.size()), shapes);
+        }
+    });
+
+    // then the buckets of the ranges are appended in range order, so the items of each pipeline keep their input order
+    for (size_t r = 0; r < numRanges; ++r) {
+        for (const auto& items : _rangeShapes[r]) {
+            if (!items.second.empty()) {
+                auto& outItems = outShapes[items.first];
+                outItems.insert(outItems.end(), items.second.begin(), items.second.end());
+            }
+        }
     }
 }
 
-void DepthSortShapes::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, ShapeBounds& outShapes) {
+// Depth sorts the items of every pipeline into the same pipeline of the output, one pipeline per task, and returns
+// the bounds of each pipeline in the order of the input when asked
+static void depthSortShapes(const RenderContextPointer& renderContext, bool frontToBack, const ShapeBounds& inShapes,
+                            ShapeBounds& outShapes, std::vector<AABox>* bounds = nullptr) {
     outShapes.clear();
     outShapes.reserve(inShapes.size());
 
+    // the output pipelines are all created up front, as the map can't be modified by the tasks
+    std::vector<std::pair<const ItemBounds*, ItemBounds*>> pipelines;
+    pipelines.reserve(inShapes.size());
     for (auto& pipeline : inShapes) {
-        auto& inItems = pipeline.second;
-        auto outItems = outShapes.find(pipeline.first);
-        if (outItems == outShapes.end()) {
-            outItems = outShapes.insert(std::make_pair(pipeline.first, ItemBounds{})).first;
+        pipelines.emplace_back(&pipeline.second, &outShapes[pipeline.first]);
+    }
+    if (bounds) {
+        bounds->assign(pipelines.size(), AABox());
+    }
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, pipelines.size(), 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); ++i) {
+            depthSortItems(renderContext, frontToBack, *pipelines[i].first, *pipelines[i].second,
+                           bounds ? &(*bounds)[i] : nullptr);
         }
+    });
+}
 
-        depthSortItems(renderContext, _frontToBack, inItems, outItems->second);
-    }
+void DepthSortShapes::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, ShapeBounds& outShapes) {
+    depthSortShapes(renderContext, _frontToBack, inShapes, outShapes);
 }
 
 void DepthSortShapesAndComputeBounds::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, Outputs& outputs) {
     auto& outShapes = outputs.edit0();
     auto& outBounds = outputs.edit1();
 
-    outShapes.clear();
-    outShapes.reserve(inShapes.size());
-    outBounds = AABox();
-
-    for (auto& pipeline : inShapes) {
-        auto& inItems = pipeline.second;
-        auto outItems = outShapes.find(pipeline.first);
-        if (outItems == outShapes.end()) {
-            outItems = outShapes.insert(std::make_pair(pipeline.first, ItemBounds{})).first;
-        }
-        AABox bounds;
+    std::vector<AABox> pipelineBounds;
+    depthSortShapes(renderContext, _frontToBack, inShapes, outShapes, &pipelineBounds);
 
-        depthSortItems(renderContext, _frontToBack, inItems, outItems->second, &bounds);
+    outBounds = AABox();
+    for (auto& bounds : pipelineBounds) {
         outBounds += bounds;
     }
 }
@@ -21,6 +21,10 @@ namespace render {
     public:
         using JobModel = Job::ModelIO<PipelineSortShapes, ItemBounds, ShapeBounds>;
         void run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ShapeBounds& outShapes);
+
+    private:
+        // the pipelines of each range of the input, sorted in parallel then merged in order
+        std::vector<ShapeBounds> _rangeShapes;
     };
 
     class DepthSortShapes {
@@ -11,6 +11,7 @@
 #include "SpatialTree.h"
 
 #include <ViewFrustum.h>
+#include <TBBHelpers.h>
 
 using namespace render;
 
@@ -445,10 +446,29 @@ int Octree::select(CellSelection& selection, const FrustumSelector& selector) co
     selectCellBrick(cellID, selection, false);
 
     // then traverse deeper
-    for (int i = 0; i < NUM_OCTANTS; i++) {
-        Index subCellID = cell.child((Link)i);
-        if (subCellID != INVALID_CELL) {
-            selectTraverse(subCellID, selection, selector);
+    if (getNumAllocatedCells() < MIN_CELLS_FOR_PARALLEL_SELECT) {
+        for (int i = 0; i < NUM_OCTANTS; i++) {
+            Index subCellID = cell.child((Link)i);
+            if (subCellID != INVALID_CELL) {
+                selectTraverse(subCellID, selection, selector);
+            }
+        }
+    } else {
+        // The world origin is at the center of the root, so content spreads over its octants: traverse each one as
+        // its own task, then append their selections in octant order to get exactly what the serial traversal does
+        std::array<CellSelection, NUM_OCTANTS> octantSelections;
+        tbb::parallel_for(0, (int)NUM_OCTANTS, [&](int i) {
+            Index subCellID = cell.child((Link)i);
+            if (subCellID != INVALID_CELL) {
+                selectTraverse(subCellID, octantSelections[i], selector);
+            }
+        });
+
+        for (auto& octantSelection : octantSelections) {
+            selection.insideCells.insert(selection.insideCells.end(), octantSelection.insideCells.begin(), octantSelection.insideCells.end());
+            selection.insideBricks.insert(selection.insideBricks.end(), octantSelection.insideBricks.begin(), octantSelection.insideBricks.end());
+            selection.partialCells.insert(selection.partialCells.end(), octantSelection.partialCells.begin(), octantSelection.partialCells.end());
+            selection.partialBricks.insert(selection.partialBricks.end(), octantSelection.partialBricks.begin(), octantSelection.partialBricks.end());
         }
     }
 
@@ -335,6 +335,9 @@ namespace render {
             float testThreshold(const Coord3f& point, float size) const override;
         };
 
+        // Trees with fewer cells than this are traversed on the calling thread only
+        static const int MIN_CELLS_FOR_PARALLEL_SELECT = 512;
+
         int select(CellSelection& selection, const FrustumSelector& selector) const;
         int selectTraverse(Index cellID, CellSelection& selection, const FrustumSelector& selector) const;
         int selectBranch(Index cellID, CellSelection& selection, const FrustumSelector& selector) const;
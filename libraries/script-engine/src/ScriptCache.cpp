@@ -12,7 +12,13 @@
 #include "ScriptCache.h"
 
 #include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
 #include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QNetworkAccessManager>
 #include <QNetworkConfiguration>
 #include <QNetworkReply>
@@ -20,8 +26,12 @@
 #include <QThread>
 #include <QRegularExpression>
 #include <QMetaEnum>
+#include <QSaveFile>
 
+#include <algorithm>
 #include <assert.h>
+
+#include <NetworkingConstants.h>
 #include <SharedUtil.h>
 
 #include "ScriptEngines.h"
@@ -31,15 +41,332 @@
 const QString ScriptCache::STATUS_INLINE { "Inline" };
 const QString ScriptCache::STATUS_CACHED { "Cached" };
 
+static const QString DISK_INDEX_FILENAME { "index.json" };
+static const int DISK_INDEX_VERSION { 1 };
+static const int MAX_PASSED_CHECKS { 10000 };
+static const int DISK_INDEX_SAVE_DELAY_MSECS { 1000 };
+
+// scripts from elsewhere on the network are worth keeping, local files are quicker to read again
+static bool isCacheableOnDisk(const QUrl& url) {
+    return url.scheme() == HIFI_URL_SCHEME_HTTP || url.scheme() == HIFI_URL_SCHEME_HTTPS || url.scheme() == URL_SCHEME_ATP;
+}
+
 ScriptCache::ScriptCache(QObject* parent) {
     // nothing to do here...
 }
 
+ScriptCache::~ScriptCache() {
+    Lock lock(_containerLock);
+    if (_isDiskIndexSaveScheduled) {
+        saveDiskIndex();
+    }
+}
+
 void ScriptCache::clearCache() {
     Lock lock(_containerLock);
     _scriptCache.clear();
 }
 
+void ScriptCache::setDiskCacheDirectory(const QString& path) {
+    if (!QDir().mkpath(path)) {
+        qCWarning(scriptengine) << "Unable to create script disk cache at" << path;
+        return;
+    }
+
+    Lock lock(_containerLock);
+    _diskCacheDirectory = path;
+    loadDiskIndex();
+    qCDebug(scriptengine) << "Script disk cache at" << path << "with" << _diskIndex.size() << "scripts";
+}
+
+QByteArray ScriptCache::hashContents(const QString& contents) {
+    return QCryptographicHash::hash(contents.toUtf8(), QCryptographicHash::Sha1).toHex();
+}
+
+bool ScriptCache::hasPassed(const QByteArray& contentHash, Check check) const {
+    Lock lock(_containerLock);
+    return _passedChecks[check].contains(contentHash);
+}
+
+void ScriptCache::setPassed(const QByteArray& contentHash, Check check) {
+    Lock lock(_containerLock);
+    auto& passed = _passedChecks[check];
+    if (passed.contains(contentHash)) {
+        return;
+    }
+    if (passed.size() >= MAX_PASSED_CHECKS) {
+        passed.clear();
+    }
+    passed.insert(contentHash);
+    scheduleDiskIndexSave();
+}
+
+// blanks out // and /* */ comments, leaving string literals that happen to contain them alone
+static QString stripComments(const QString& contents) {
+    static const QRegularExpression STRING_OR_COMMENT {
+        R"("(?:[^"\\\n]|\\.)*"|'(?:[^'\\\n]|\\.)*'|//[^\n]*|/\*.*?\*/)",
+        QRegularExpression::DotMatchesEverythingOption
+    };
+
+    QString stripped;
+    stripped.reserve(contents.size());
+    int copied = 0;
+    auto matches = STRING_OR_COMMENT.globalMatch(contents);
+    while (matches.hasNext()) {
+        auto match = matches.next();
+        if (match.captured().startsWith('/')) {
+            stripped += contents.midRef(copied, match.capturedStart() - copied);
+            stripped += ' ';
+            copied = match.capturedEnd();
+        }
+    }
+    stripped += contents.midRef(copied);
+    return stripped;
+}
+
+QList<QUrl> ScriptCache::findDependencies(const QUrl& url, const QString& contents) {
+    // Script.include("a.js"), include(["a.js", "b.js"]) and require("./c.js") with literal paths; anything computed
+    // at run time is left for the script to fetch
+    static const QRegularExpression INCLUDE_CALL { R"(\binclude\s*\(\s*(\[[^\]]*\]|"[^"\n]*"|'[^'\n]*'))" };
+    static const QRegularExpression REQUIRE_CALL { R"(\brequire\s*\(\s*("[^"\n]*"|'[^'\n]*')\s*\))" };
+    static const QRegularExpression STRING_LITERAL { R"("([^"\n]*)"|'([^'\n]*)')" };
+    // the module ids require() resolves against the requiring script, see ScriptEngine::_requireResolve
+    static const QRegularExpression QUALIFIED_MODULE_ID { R"(^\w+:|^[.]{1,2}/)" };
+
+    QList<QUrl> dependencies;
+    if (!isCacheableOnDisk(url)) {
+        return dependencies;
+    }
+
+    auto addDependency = [&](const QString& path) {
+        // paths starting with /~/ are the local default scripts
+        if (path.isEmpty() || path.startsWith("/")) {
+            return;
+        }
+        QUrl dependency = url.resolved(QUrl(path));
+        if (isCacheableOnDisk(dependency) && dependency != url && !dependencies.contains(dependency)) {
+            dependencies.push_back(dependency);
+        }
+    };
+
+    auto literals = [&](const QString& text) {
+        QStringList paths;
+        auto matches = STRING_LITERAL.globalMatch(text);
+        while (matches.hasNext()) {
+            auto match = matches.next();
+            paths << (match.capturedStart(1) >= 0 ? match.captured(1) : match.captured(2));
+        }
+        return paths;
+    };
+
+    QString code = stripComments(contents);
+    auto includes = INCLUDE_CALL.globalMatch(code);
+    while (includes.hasNext()) {
+        for (const auto& path : literals(includes.next().captured(1))) {
+            addDependency(path);
+        }
+    }
+
+    auto requires = REQUIRE_CALL.globalMatch(code);
+    while (requires.hasNext()) {
+        for (const auto& path : literals(requires.next().captured(1))) {
+            if (QUALIFIED_MODULE_ID.match(path).hasMatch()) {
+                addDependency(path);
+            }
+        }
+    }
+
+    return dependencies;
+}
+
+void ScriptCache::prefetch(const QUrl& unnormalizedURL) {
+    QUrl url = DependencyManager::get<ResourceManager>()->normalizeURL(unnormalizedURL);
+    {
+        Lock lock(_containerLock);
+        if (_scriptCache.contains(url) || _activeScriptRequests.contains(url)) {
+            return;
+        }
+        auto& scriptRequest = _activeScriptRequests[url];
+        scriptRequest.isPrefetch = true;
+        // a script that needs it raises this when it asks for it
+        scriptRequest.maxRetries = 0;
+    }
+
+    qCDebug(scriptengine) << "Prefetching script at:" << url.toString();
+    sendRequest(url, false);
+    prefetchKnownDependencies(url);
+}
+
+void ScriptCache::prefetchDependencies(const QUrl& url, const QString& contents) {
+    for (const auto& dependency : findDependencies(url, contents)) {
+        prefetch(dependency);
+    }
+}
+
+void ScriptCache::prefetchKnownDependencies(const QUrl& url) {
+    // what the script depended on the last time it was fetched, all the way down, so the whole tree loads at once
+    QList<QUrl> dependencies;
+    {
+        Lock lock(_containerLock);
+        QSet<QUrl> visited { url };
+        QList<QUrl> toVisit { url };
+        while (!toVisit.isEmpty()) {
+            auto itr = _diskIndex.find(toVisit.takeFirst());
+            if (itr == _diskIndex.end()) {
+                continue;
+            }
+            for (const auto& dependency : itr->dependencies) {
+                if (!visited.contains(dependency)) {
+                    visited.insert(dependency);
+                    toVisit.push_back(dependency);
+                    dependencies.push_back(dependency);
+                }
+            }
+        }
+    }
+
+    for (const auto& dependency : dependencies) {
+        prefetch(dependency);
+    }
+}
+
+QString ScriptCache::diskCacheFilePath(const QByteArray& contentHash) const {
+    return QDir(_diskCacheDirectory).absoluteFilePath(QString::fromLatin1(contentHash) + ".js");
+}
+
+void ScriptCache::loadDiskIndex() {
+    _diskIndex.clear();
+
+    QFile file(QDir(_diskCacheDirectory).absoluteFilePath(DISK_INDEX_FILENAME));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    auto index = QJsonDocument::fromJson(file.readAll()).object();
+    if (index["version"].toInt() != DISK_INDEX_VERSION) {
+        return;
+    }
+
+    auto scripts = index["scripts"].toObject();
+    for (auto itr = scripts.begin(); itr != scripts.end(); ++itr) {
+        auto entry = itr.value().toObject();
+        CachedScript script;
+        script.hash = entry["hash"].toString().toLatin1();
+        for (const auto& dependency : entry["dependencies"].toArray()) {
+            script.dependencies.push_back(QUrl(dependency.toString()));
+        }
+        if (QFile::exists(diskCacheFilePath(script.hash))) {
+            _diskIndex[QUrl(itr.key())] = script;
+        }
+    }
+
+    for (const auto& hash : index["passed_syntax_check"].toArray()) {
+        _passedChecks[SyntaxCheck].insert(hash.toString().toLatin1());
+    }
+    for (const auto& hash : index["passed_entity_constructor_check"].toArray()) {
+        _passedChecks[EntityConstructorCheck].insert(hash.toString().toLatin1());
+    }
+}
+
+void ScriptCache::scheduleDiskIndexSave() {
+    // a script tree or a batch of entity scripts loads at once, write the index once they have
+    if (_diskCacheDirectory.isEmpty() || _isDiskIndexSaveScheduled) {
+        return;
+    }
+    _isDiskIndexSaveScheduled = true;
+    QTimer::singleShot(DISK_INDEX_SAVE_DELAY_MSECS, this, [this] {
+        Lock lock(_containerLock);
+        saveDiskIndex();
+    });
+}
+
+void ScriptCache::saveDiskIndex() {
+    _isDiskIndexSaveScheduled = false;
+    if (_diskCacheDirectory.isEmpty()) {
+        return;
+    }
+
+    QJsonObject scripts;
+    for (auto itr = _diskIndex.begin(); itr != _diskIndex.end(); ++itr) {
+        QJsonArray dependencies;
+        for (const auto& dependency : itr->dependencies) {
+            dependencies.push_back(dependency.toString());
+        }
+        QJsonObject entry;
+        entry["hash"] = QString::fromLatin1(itr->hash);
+        entry["dependencies"] = dependencies;
+        scripts[itr.key().toString()] = entry;
+    }
+
+    auto toArray = [](const QSet<QByteArray>& hashes) {
+        QJsonArray array;
+        for (const auto& hash : hashes) {
+            array.push_back(QString::fromLatin1(hash));
+        }
+        return array;
+    };
+
+    QJsonObject index;
+    index["version"] = DISK_INDEX_VERSION;
+    index["scripts"] = scripts;
+    index["passed_syntax_check"] = toArray(_passedChecks[SyntaxCheck]);
+    index["passed_entity_constructor_check"] = toArray(_passedChecks[EntityConstructorCheck]);
+
+    // several assignment clients on a machine may share the directory, so replace the index in one step
+    QSaveFile file(QDir(_diskCacheDirectory).absoluteFilePath(DISK_INDEX_FILENAME));
+    if (!file.open(QIODevice::WriteOnly) || file.write(QJsonDocument(index).toJson(QJsonDocument::Compact)) < 0 ||
+            !file.commit()) {
+        qCWarning(scriptengine) << "Unable to write script disk cache index to" << _diskCacheDirectory;
+    }
+}
+
+void ScriptCache::storeOnDisk(const QUrl& url, const QString& contents, const QList<QUrl>& dependencies) {
+    if (_diskCacheDirectory.isEmpty() || !isCacheableOnDisk(url)) {
+        return;
+    }
+
+    auto hash = hashContents(contents);
+    auto itr = _diskIndex.find(url);
+    if (itr != _diskIndex.end() && itr->hash == hash && itr->dependencies == dependencies) {
+        return;
+    }
+
+    QString filePath = diskCacheFilePath(hash);
+    if (!QFile::exists(filePath)) {
+        QSaveFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly) || file.write(contents.toUtf8()) < 0 || !file.commit()) {
+            qCWarning(scriptengine) << "Unable to write" << url.toString() << "to the script disk cache";
+            return;
+        }
+    }
+
+    if (itr != _diskIndex.end() && itr->hash != hash) {
+        // drop the old version, unless another URL has the same contents
+        auto oldHash = itr->hash;
+        _diskIndex.erase(itr);
+        bool isShared = std::any_of(_diskIndex.begin(), _diskIndex.end(), [&](const CachedScript& script) {
+            return script.hash == oldHash;
+        });
+        if (!isShared) {
+            QFile::remove(diskCacheFilePath(oldHash));
+        }
+    }
+
+    _diskIndex[url] = { hash, dependencies };
+    scheduleDiskIndexSave();
+}
+
+QString ScriptCache::loadFromDisk(const QUrl& url) const {
+    auto itr = _diskIndex.find(url);
+    if (itr == _diskIndex.end()) {
+        return QString();
+    }
+    QFile file(diskCacheFilePath(itr->hash));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+    return QString::fromUtf8(file.readAll());
+}
+
 void ScriptCache::clearATPScriptsFromCache() {
     Lock lock(_containerLock);
     qCDebug(scriptengine) << "Clearing ATP scripts from ScriptCache";
@@ -91,30 +418,38 @@ void ScriptCache::getScriptContents(const QString& scriptOrURL, contentAvailable
         contentAvailable(url.toString(), scriptContent, true, true, STATUS_CACHED);
     } else {
         auto& scriptRequest = _activeScriptRequests[url];
-        bool alreadyWaiting = scriptRequest.scriptUsers.size() > 0;
+        bool alreadyWaiting = scriptRequest.scriptUsers.size() > 0 || scriptRequest.isPrefetch;
         scriptRequest.scriptUsers.push_back(contentAvailable);
+        scriptRequest.maxRetries = std::max(scriptRequest.maxRetries, maxRetries);
+        int numScriptUsers = (int)scriptRequest.scriptUsers.size();
+        int numRetries = scriptRequest.numRetries;
 
         lock.unlock();
 
         if (alreadyWaiting) {
             qCDebug(scriptengine) << QString("Already downloading script at: %1 (retry: %2; scriptusers: %3)")
-                .arg(url.toString()).arg(scriptRequest.numRetries).arg(scriptRequest.scriptUsers.size());
+                .arg(url.toString()).arg(numRetries).arg(numScriptUsers);
         } else {
-            scriptRequest.maxRetries = maxRetries;
-            #ifdef THREAD_DEBUGGING
-            qCDebug(scriptengine) << "about to call: ResourceManager::createResourceRequest(this, url); on thread [" << QThread::currentThread() << "] expected thread [" << thread() << "]";
-            #endif
-            auto request = DependencyManager::get<ResourceManager>()->createResourceRequest(
-                nullptr, url, true, -1, "ScriptCache::getScriptContents");
-            Q_ASSERT(request);
-            request->setCacheEnabled(!forceDownload);
-            connect(request, &ResourceRequest::finished, this, [=]{ scriptContentAvailable(maxRetries); });
-            request->send();
+            sendRequest(url, forceDownload);
+            // the scripts it needed last time can be on their way while this one downloads
+            prefetchKnownDependencies(url);
         }
     }
 }
 
-void ScriptCache::scriptContentAvailable(int maxRetries) {
+void ScriptCache::sendRequest(const QUrl& url, bool forceDownload) {
+    #ifdef THREAD_DEBUGGING
+    qCDebug(scriptengine) << "about to call: ResourceManager::createResourceRequest(this, url); on thread [" << QThread::currentThread() << "] expected thread [" << thread() << "]";
+    #endif
+    auto request = DependencyManager::get<ResourceManager>()->createResourceRequest(
+        nullptr, url, true, -1, "ScriptCache::getScriptContents");
+    Q_ASSERT(request);
+    request->setCacheEnabled(!forceDownload);
+    connect(request, &ResourceRequest::finished, this, [=]{ scriptContentAvailable(); });
+    request->send();
+}
+
+void ScriptCache::scriptContentAvailable() {
     #ifdef THREAD_DEBUGGING
     qCDebug(scriptengine) << "ScriptCache::scriptContentAvailable() on thread [" << QThread::currentThread() << "] expected thread [" << thread() << "]";
     #endif
@@ -125,6 +460,7 @@ void ScriptCache::scriptContentAvailable(int maxRetries) {
     std::vector<contentAvailableCallback> allCallbacks;
     QString status = QMetaEnum::fromType<ResourceRequest::Result>().valueToKey(req->getResult());
     bool success { false };
+    bool isPrefetchOnly { false };
 
     {
         Q_ASSERT(req->getState() == ResourceRequest::Finished);
@@ -134,6 +470,8 @@ void ScriptCache::scriptContentAvailable(int maxRetries) {
 
         if (_activeScriptRequests.contains(url)) {
             auto& scriptRequest = _activeScriptRequests[url];
+            int maxRetries = scriptRequest.maxRetries;
+            isPrefetchOnly = scriptRequest.scriptUsers.empty();
 
             if (success) {
                 allCallbacks = scriptRequest.scriptUsers;
@@ -168,7 +506,7 @@ void ScriptCache::scriptContentAvailable(int maxRetries) {
                         // We've already made a request, so the cache must be disabled or it wasn't there, so enabling
                         // it will do nothing.
                         request->setCacheEnabled(false);
-                        connect(request, &ResourceRequest::finished, this, [=]{ scriptContentAvailable(maxRetries); });
+                        connect(request, &ResourceRequest::finished, this, [=]{ scriptContentAvailable(); });
                         request->send();
                     });
                 } else {
@@ -180,8 +518,22 @@ void ScriptCache::scriptContentAvailable(int maxRetries) {
                         scriptContent = _scriptCache[url];
                     }
                     _activeScriptRequests.remove(url);
-                    qCWarning(scriptengine) << "Error loading script from URL (" << status <<")";
 
+                    bool isGone = result == ResourceRequest::AccessDenied || result == ResourceRequest::InvalidURL ||
+                        result == ResourceRequest::NotFound;
+                    if (isPrefetchOnly) {
+                        // a guess at what a script will need, it will report the error if it does
+                        qCDebug(scriptengine) << "Unable to prefetch script at" << url.toString() << "(" << status << ")";
+                    } else if (!isGone && scriptContent.isEmpty() && !(scriptContent = loadFromDisk(url)).isEmpty()) {
+                        // the server can't be reached, the last copy we had is better than no script at all
+                        qCWarning(scriptengine) << "Error loading script from URL (" << status << "), using the copy from"
+                            << "the script disk cache";
+                        _scriptCache[url] = scriptContent;
+                        success = true;
+                        status = STATUS_CACHED;
+                    } else {
+                        qCWarning(scriptengine) << "Error loading script from URL (" << status <<")";
+                    }
                 }
             }
         }
@@ -189,6 +541,17 @@ void ScriptCache::scriptContentAvailable(int maxRetries) {
 
     req->deleteLater();
 
+    if (success && status != STATUS_CACHED) {
+        auto dependencies = findDependencies(url, scriptContent);
+        {
+            Lock lock(_containerLock);
+            storeOnDisk(url, scriptContent, dependencies);
+        }
+        for (const auto& dependency : dependencies) {
+            prefetch(dependency);
+        }
+    }
+
     if (allCallbacks.size() > 0 && !DependencyManager::get<ScriptEngines>()->isStopped()) {
         foreach(contentAvailableCallback thisCallback, allCallbacks) {
             thisCallback(url.toString(), scriptContent, true, success, status);
@@ -13,6 +13,9 @@
 #define hifi_ScriptCache_h
 
 #include <mutex>
+
+#include <QtCore/QSet>
+
 #include <ResourceCache.h>
 
 using contentAvailableCallback = std::function<void(const QString& scriptOrURL, const QString& contents, bool isURL, bool contentAvailable, const QString& status)>;
@@ -30,12 +33,20 @@ public:
     std::vector<contentAvailableCallback> scriptUsers { };
     int numRetries { 0 };
     int maxRetries { MAX_RETRIES };
+    bool isPrefetch { false }; // started by prefetch() rather than a script that needs it
 };
 
 /// Interface for loading scripts
+///
+/// Fetched scripts are kept in memory for the life of the process.  With a disk cache directory set they are also
+/// kept on disk, content addressed, along with the include() and require() dependencies found in each script and the
+/// hashes of the sources that passed their syntax and entity constructor checks.  A restarted process uses these to
+/// fetch a script's whole dependency tree in parallel, before the script gets to its first include(), and to skip
+/// checks it has already done.
 class ScriptCache : public QObject, public Dependency {
     Q_OBJECT
     SINGLETON_DEPENDENCY
+    friend class ScriptCacheTests;
 
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
@@ -47,21 +58,63 @@ public:
         return status == "Success" || status == STATUS_INLINE || status == STATUS_CACHED;
     }
 
+    enum Check {
+        SyntaxCheck,
+        EntityConstructorCheck
+    };
+
     void clearCache();
     Q_INVOKABLE void clearATPScriptsFromCache();
     void getScriptContents(const QString& scriptOrURL, contentAvailableCallback contentAvailable, bool forceDownload = false, int maxRetries = ScriptRequest::MAX_RETRIES);
 
     void deleteScript(const QUrl& unnormalizedURL);
 
+    /// \brief keep fetched scripts and what is known about them in this directory, across restarts
+    void setDiskCacheDirectory(const QString& path);
+
+    /// \brief start fetching a script, if it isn't cached or on its way, so it is ready when a script needs it
+    void prefetch(const QUrl& unnormalizedURL);
+    /// \brief prefetch the scripts that contents include() or require(), and theirs when they arrive
+    void prefetchDependencies(const QUrl& url, const QString& contents);
+
+    /// \return URLs of the scripts included or required with a literal path outside comments, resolved against url
+    static QList<QUrl> findDependencies(const QUrl& url, const QString& contents);
+
+    static QByteArray hashContents(const QString& contents);
+    /// \return true if a script with this content hash has passed check before
+    bool hasPassed(const QByteArray& contentHash, Check check) const;
+    void setPassed(const QByteArray& contentHash, Check check);
+
 private:
-    void scriptContentAvailable(int maxRetries); // new version
+    struct CachedScript {
+        QByteArray hash;
+        QList<QUrl> dependencies;
+    };
+
+    void scriptContentAvailable();
+    void sendRequest(const QUrl& url, bool forceDownload);
+    void prefetchKnownDependencies(const QUrl& url);
+
+    QString diskCacheFilePath(const QByteArray& contentHash) const;
+    void loadDiskIndex();
+    void scheduleDiskIndexSave();
+    void saveDiskIndex();
+    void storeOnDisk(const QUrl& url, const QString& contents, const QList<QUrl>& dependencies);
+    QString loadFromDisk(const QUrl& url) const;
+
     ScriptCache(QObject* parent = NULL);
+    ~ScriptCache();
     
-    Mutex _containerLock;
+    mutable Mutex _containerLock;
     QMap<QUrl, ScriptRequest> _activeScriptRequests;
     
     QHash<QUrl, QString> _scriptCache;
     QMultiMap<QUrl, ScriptUser*> _scriptUsers;
+
+    QString _diskCacheDirectory; // empty if there is no disk cache
+    QHash<QUrl, CachedScript> _diskIndex;
+    QSet<QByteArray> _passedChecks[2]; // content hashes, by Check
+    bool _isDiskIndexSaveScheduled { false };
 };
 
 #endif // hifi_ScriptCache_h
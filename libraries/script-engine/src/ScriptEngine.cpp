@@ -11,6 +11,7 @@
 
 #include "ScriptEngine.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -45,6 +46,7 @@
 #include <DebugDraw.h>
 #include <EntityScriptingInterface.h>
 #include <MessagesClient.h>
+#include <MetricsRegistry.h>
 #include <NetworkAccessManager.h>
 #include <PathUtils.h>
 #include <ResourceScriptingInterface.h>
@@ -97,6 +99,39 @@ static const QScriptValue::PropertyFlags READONLY_HIDDEN_PROP_FLAGS { READONLY_P
 
 static const bool HIFI_AUTOREFRESH_FILE_SCRIPTS { true };
 
+// shorter sources, e.g. from the console, are quick to check and not worth remembering
+static const int MIN_LINT_CACHED_SOURCE_LENGTH { 1024 };
+
+static uint64_t loadTimerNow() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Times a stage of loading scripts, less the stages nested in it, e.g. the include() a script waits on while it is
+// evaluated, so each usec is only counted against one stage
+class ScriptLoadTimer {
+public:
+    ScriptLoadTimer(ScriptLoadTimer*& current, std::atomic<uint64_t>& total) :
+        _current(current), _parent(current), _total(total), _start(loadTimerNow()) {
+        _current = this;
+    }
+
+    ~ScriptLoadTimer() {
+        uint64_t elapsed = loadTimerNow() - _start;
+        _total += elapsed - std::min(elapsed, _nested);
+        if (_parent) {
+            _parent->_nested += elapsed;
+        }
+        _current = _parent;
+    }
+
+private:
+    ScriptLoadTimer*& _current;
+    ScriptLoadTimer* _parent;
+    std::atomic<uint64_t>& _total;
+    uint64_t _start;
+    uint64_t _nested { 0 };
+};
+
 Q_DECLARE_METATYPE(QScriptEngine::FunctionSignature)
 int functionSignatureMetaID = qRegisterMetaType<QScriptEngine::FunctionSignature>();
 
@@ -339,6 +374,8 @@ void ScriptEngine::runDebuggable() {
             return;
         }
 
+        dispatchTimers();
+
         qint64 now = usecTimestampNow();
         // we check for 'now' in the past in case people set their clock back
         if (_lastUpdate < now) {
@@ -481,8 +518,10 @@ void ScriptEngine::loadURL(const QUrl& scriptURL, bool reload) {
 
     const auto maxRetries = 0; // for consistency with previous scriptCache->getScript() behavior
     auto scriptCache = DependencyManager::get<ScriptCache>();
-    scriptCache->getScriptContents(url.toString(), [this](const QString& url, const QString& scriptContents, bool isURL, bool success, const QString&status) {
+    auto fetchStart = loadTimerNow();
+    scriptCache->getScriptContents(url.toString(), [this, fetchStart](const QString& url, const QString& scriptContents, bool isURL, bool success, const QString&status) {
         qCDebug(scriptengine) << "loadURL" << url << status << QThread::currentThread();
+        _fetchTime += loadTimerNow() - fetchStart;
         if (!success) {
             scriptErrorMessage("ERROR Loading file (" + status + "):" + url);
             emit errorLoadingScript(_fileNameString);
@@ -1062,33 +1101,66 @@ QScriptValue ScriptEngine::evaluate(const QString& sourceCode, const QString& fi
         return result;
     }
 
-    // Check syntax
-    auto syntaxError = lintScript(sourceCode, fileName);
-    if (syntaxError.isError()) {
-        if (!isEvaluating()) {
-            syntaxError.setProperty("detail", "evaluate");
+    QScriptProgram program;
+    {
+        ScriptLoadTimer compileTimer(_currentLoadTimer, _compileTime);
+
+        // Check syntax
+        auto syntaxError = lintScriptOnce(sourceCode, fileName, lineNumber);
+        if (syntaxError.isError()) {
+            if (!isEvaluating()) {
+                syntaxError.setProperty("detail", "evaluate");
+            }
+            raiseException(syntaxError);
+            maybeEmitUncaughtException("lint");
+            return syntaxError;
+        }
+        program = QScriptProgram { sourceCode, fileName, lineNumber };
+        if (program.isNull()) {
+            // can this happen?
+            auto err = makeError("could not create QScriptProgram for " + fileName);
+            raiseException(err);
+            maybeEmitUncaughtException("compile");
+            return err;
         }
-        raiseException(syntaxError);
-        maybeEmitUncaughtException("lint");
-        return syntaxError;
-    }
-    QScriptProgram program { sourceCode, fileName, lineNumber };
-    if (program.isNull()) {
-        // can this happen?
-        auto err = makeError("could not create QScriptProgram for " + fileName);
-        raiseException(err);
-        maybeEmitUncaughtException("compile");
-        return err;
     }
 
     QScriptValue result;
     {
+        ScriptLoadTimer evaluateTimer(_currentLoadTimer, _evaluateTime);
         result = BaseScriptEngine::evaluate(program);
         maybeEmitUncaughtException("evaluate");
     }
     return result;
 }
 
+// lintScript(), skipping sources that have passed it before, in this engine or another
+QScriptValue ScriptEngine::lintScriptOnce(const QString& sourceCode, const QString& fileName, int lineNumber) {
+    if (sourceCode.length() < MIN_LINT_CACHED_SOURCE_LENGTH || !DependencyManager::isSet<ScriptCache>()) {
+        return lintScript(sourceCode, fileName, lineNumber);
+    }
+
+    auto scriptCache = DependencyManager::get<ScriptCache>();
+    auto contentHash = ScriptCache::hashContents(sourceCode);
+    if (scriptCache->hasPassed(contentHash, ScriptCache::SyntaxCheck)) {
+        return QScriptValue();
+    }
+
+    auto syntaxError = lintScript(sourceCode, fileName, lineNumber);
+    if (!syntaxError.isError()) {
+        scriptCache->setPassed(contentHash, ScriptCache::SyntaxCheck);
+    }
+    return syntaxError;
+}
+
+ScriptEngine::LoadStats ScriptEngine::getLoadStats() const {
+    LoadStats stats;
+    stats.fetchTime = _fetchTime;
+    stats.compileTime = _compileTime;
+    stats.evaluateTime = _evaluateTime;
+    return stats;
+}
+
 void ScriptEngine::run() {
     auto filenameParts = _fileNameString.split("/");
     auto name = filenameParts.size() > 0 ? filenameParts[filenameParts.size() - 1] : "unknown";
@@ -1113,6 +1185,15 @@ void ScriptEngine::run() {
         evaluate(_scriptContents, _fileNameString);
         maybeEmitUncaughtException(__FUNCTION__);
     }
+
+    {
+        auto loadStats = getLoadStats();
+        qCInfo(scriptengine).noquote() << QString("[%1] loaded: %2 ms fetching, %3 ms compiling, %4 ms evaluating")
+            .arg(getFilename())
+            .arg((double)loadStats.fetchTime / USECS_PER_MSEC, 0, 'f', 1)
+            .arg((double)loadStats.compileTime / USECS_PER_MSEC, 0, 'f', 1)
+            .arg((double)loadStats.evaluateTime / USECS_PER_MSEC, 0, 'f', 1);
+    }
 #ifdef _WIN32
     // VS13 does not sleep_until unless it uses the system_clock, see:
     // https://www.reddit.com/r/cpp_questions/comments/3o71ic/sleep_until_not_working_with_a_time_pointsteady/
@@ -1208,6 +1289,13 @@ void ScriptEngine::run() {
             break;
         }
 
+        // timers run before the entity edits are released, so edits they make go out this frame
+        dispatchTimers();
+
+        if (_isFinished) {
+            break;
+        }
+
         if (!_isFinished && entityScriptingInterface->getEntityPacketSender()->serversExist()) {
             // release the queue of edit entity messages.
             entityScriptingInterface->getEntityPacketSender()->releaseQueuedMessages();
@@ -1275,27 +1363,27 @@ void ScriptEngine::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptEngine::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
     int j {0};
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
+    for (auto timer : _timerFunctionMap.values()) {
         qCDebug(scriptengine) << getFilename() << "stopAllTimers[" << j++ << "]";
         stopTimer(timer);
     }
+    _timerWheel.clear();
+    if (_timerDispatchTimer) {
+        _timerDispatchTimer->stop();
+    }
 }
 
 void ScriptEngine::stopAllTimersForEntityScript(const EntityItemID& entityID) {
-     // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
-    QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
+     // We could maintain a separate map of entityID => timer, but someone will have to prove to me that it's worth the complexity. -HRS
+    QVector<ScriptTimer*> toDelete;
+    QHashIterator<TimerWheel::TimerID, ScriptTimer*> i(_timerFunctionMap);
     while (i.hasNext()) {
         i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
+        if (i.value()->callback.definingEntityIdentifier != entityID) {
             continue;
         }
-        QTimer* timer = i.key();
-        toDelete << timer; // don't delete while we're iterating. save it.
+        toDelete << i.value(); // don't delete while we're iterating. save it.
     }
     for (auto timer:toDelete) { // now reap 'em
         stopTimer(timer);
@@ -1353,59 +1441,134 @@ void ScriptEngine::updateMemoryCost(const qint64& deltaSize) {
     }
 }
 
-void ScriptEngine::timerFired() {
-    {
-        QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
-        if (!scriptEngines || scriptEngines->isStopped()) {
-            scriptWarningMessage("Script.timerFired() while shutting down is ignored... parent script:" + getFilename());
-            return; // bail early
+static uint64_t timerWheelNow() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Runs the callbacks of every timer that has expired since the last call, in the order they were due.  Called each
+// script frame and whenever _timerDispatchTimer wakes the engine for the next timer due, so a script with many timers
+// costs one Qt timer event per expiry time rather than one per timer.
+void ScriptEngine::dispatchTimers() {
+    if (_timerWheel.empty()) {
+        if (_timerDispatchTimer) {
+            _timerDispatchTimer->stop();
         }
+        return;
     }
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
+    // reuse the batch's allocation, but not the vector itself: a callback that spins an event loop may dispatch again
+    std::vector<TimerWheel::Expired> expired;
+    expired.swap(_expiredTimers);
+    expired.clear();
+    _timerWheel.advance(timerWheelNow(), expired);
 
-    if (!callingTimer->isActive()) {
-        // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
-    }
-
-    // call the associated JS function, if it exists
-    if (timerData.function.isValid()) {
+    if (!expired.empty()) {
         PROFILE_RANGE(script, __FUNCTION__);
-        auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
-        auto postTimer = p_high_resolution_clock::now();
-        auto elapsed = (postTimer - preTimer);
-        _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
-    } else {
-        qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+
+        bool isShuttingDown = false;
+        {
+            QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
+            if (!scriptEngines || scriptEngines->isStopped()) {
+                scriptWarningMessage("Script.timerFired() while shutting down is ignored... parent script:" + getFilename());
+                isShuttingDown = true;
+            }
+        }
+
+        uint64_t totalLag = 0;
+        uint64_t maxLag = 0;
+        uint64_t numDispatched = 0;
+        for (const auto& timer : expired) {
+            auto itr = _timerFunctionMap.find(timer.id);
+            if (itr == _timerFunctionMap.end()) {
+                // cleared by a callback earlier in this batch
+                continue;
+            }
+
+            CallbackData timerData = itr.value()->callback;
+            if (!timer.repeating) {
+                // this timer is done, we can kill it
+                delete itr.value();
+                _timerFunctionMap.erase(itr);
+            }
+
+            if (isShuttingDown) {
+                continue;
+            }
+
+            // call the associated JS function, if it exists
+            if (timerData.function.isValid()) {
+                auto preTimer = p_high_resolution_clock::now();
+                int64_t sinceDeadline = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count() - (int64_t)(timer.deadline * USECS_PER_MSEC);
+                uint64_t lag = (uint64_t)std::max(sinceDeadline, (int64_t)0);
+                totalLag += lag;
+                maxLag = std::max(maxLag, lag);
+                ++numDispatched;
+                if (_timerDispatchLagHistogram) {
+                    _timerDispatchLagHistogram->record(lag);
+                }
+
+                callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+                auto postTimer = p_high_resolution_clock::now();
+                auto elapsed = (postTimer - preTimer);
+                _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+            } else {
+                qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+            }
+        }
+
+        _numTimersDispatched += numDispatched;
+        _totalTimerDispatchLag += totalLag;
+        uint64_t previousMaxLag = _maxTimerDispatchLag;
+        while (maxLag > previousMaxLag && !_maxTimerDispatchLag.compare_exchange_weak(previousMaxLag, maxLag)) {}
     }
-}
 
-QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
-    QTimer* newTimer = new QTimer(this);
-    newTimer->setSingleShot(isSingleShot);
+    _numTimers = (int)_timerFunctionMap.size();
+    expired.clear();
+    _expiredTimers.swap(expired);
+    scheduleTimerDispatch();
+}
 
-    // The default timer type is not very accurate below about 200ms http://doc.qt.io/qt-5/qt.html#TimerType-enum
-    static const int MIN_TIMEOUT_FOR_COARSE_TIMER = 200;
-    if (intervalMS < MIN_TIMEOUT_FOR_COARSE_TIMER) {
-        newTimer->setTimerType(Qt::PreciseTimer);
+void ScriptEngine::scheduleTimerDispatch() {
+    if (_timerWheel.empty()) {
+        if (_timerDispatchTimer) {
+            _timerDispatchTimer->stop();
+        }
+        return;
     }
 
-    connect(newTimer, &QTimer::timeout, this, &ScriptEngine::timerFired);
+    if (!_timerDispatchTimer) {
+        // made on the script thread, where the timers are added and dispatched
+        _timerDispatchTimer = new QTimer(this);
+        _timerDispatchTimer->setSingleShot(true);
+        _timerDispatchTimer->setTimerType(Qt::PreciseTimer);
+        connect(_timerDispatchTimer, &QTimer::timeout, this, &ScriptEngine::dispatchTimers);
+    }
+    // the frame loop sleeps in an event loop, so this also fires timers shorter than a frame on time
+    _timerDispatchTimer->start((int)_timerWheel.timeUntilNextExpiry(timerWheelNow()));
+}
 
-    // make sure the timer stops when the script does
-    connect(this, &ScriptEngine::scriptEnding, newTimer, &QTimer::stop);
+ScriptEngine::TimerStats ScriptEngine::takeTimerStats() {
+    TimerStats stats;
+    stats.numTimers = _numTimers;
+    stats.numDispatched = _numTimersDispatched.exchange(0);
+    uint64_t totalLag = _totalTimerDispatchLag.exchange(0);
+    stats.averageDispatchLag = stats.numDispatched > 0 ? totalLag / stats.numDispatched : 0;
+    stats.maxDispatchLag = _maxTimerDispatchLag.exchange(0);
+    return stats;
+}
 
+QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
+    // add the timer to the wheel and the map, dispatchTimers() calls it when it comes due
+    auto id = _timerWheel.add(timerWheelNow(), (uint32_t)std::max(intervalMS, 0), !isSingleShot);
 
     CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
-    _timerFunctionMap.insert(newTimer, timerData);
+    auto timer = new ScriptTimer(id, timerData, this);
+    _timerFunctionMap.insert(id, timer);
+    _numTimers = (int)_timerFunctionMap.size();
+    scheduleTimerDispatch();
 
-    newTimer->start(intervalMS);
-    return newTimer;
+    return timer;
 }
 
 QObject* ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
@@ -1428,10 +1591,11 @@ QObject* ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
     return setupTimerWithInterval(function, timeoutMS, true);
 }
 
-void ScriptEngine::stopTimer(QTimer *timer) {
-    if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
-        _timerFunctionMap.remove(timer);
+void ScriptEngine::stopTimer(ScriptTimer* timer) {
+    if (timer && _timerFunctionMap.value(timer->id) == timer) {
+        _timerFunctionMap.remove(timer->id);
+        _timerWheel.remove(timer->id);
+        _numTimers = (int)_timerFunctionMap.size();
         delete timer;
     } else {
         qCDebug(scriptengine) << "stopTimer -- not in _timerFunctionMap" << timer;
@@ -1660,6 +1824,7 @@ QScriptValue ScriptEngine::newModule(const QString& modulePath, const QScriptVal
 
 // synchronously fetch a module's source code using BatchLoader
 QVariantMap ScriptEngine::fetchModuleSource(const QString& modulePath, const bool forceDownload) {
+    ScriptLoadTimer fetchTimer(_currentLoadTimer, _fetchTime);
     using UrlMap = QMap<QUrl, QString>;
     auto scriptCache = DependencyManager::get<ScriptCache>();
     QVariantMap req;
@@ -1725,6 +1890,7 @@ QScriptValue ScriptEngine::instantiateModule(const QScriptValue& module, const Q
     qCDebug(scriptengine_module) << QString("require.instantiateModule: %1 / %2 bytes")
         .arg(QUrl(modulePath).fileName()).arg(sourceCode.length());
 
+    ScriptLoadTimer evaluateTimer(_currentLoadTimer, _evaluateTime);
     if (module.property("content-type").toString() == "application/json") {
         qCDebug(scriptengine_module) << "... parsing as JSON";
         closure.setProperty("__json", sourceCode);
@@ -1936,12 +2102,17 @@ void ScriptEngine::include(const QStringList& includeFiles, QScriptValue callbac
     // If we are destroyed before the loader completes, make sure to clean it up
     connect(this, &QObject::destroyed, loader, &QObject::deleteLater);
 
-    loader->start(processLevelMaxRetries);
-
-    if (!callback.isFunction() && !loader->isFinished()) {
-        QEventLoop loop;
-        QObject::connect(loader, &BatchLoader::finished, &loop, &QEventLoop::quit);
-        loop.exec();
+    if (callback.isFunction()) {
+        loader->start(processLevelMaxRetries);
+    } else {
+        // the script waits on the download, and evaluates what it got when it finishes
+        ScriptLoadTimer fetchTimer(_currentLoadTimer, _fetchTime);
+        loader->start(processLevelMaxRetries);
+        if (!loader->isFinished()) {
+            QEventLoop loop;
+            QObject::connect(loader, &BatchLoader::finished, &loop, &QEventLoop::quit);
+            loop.exec();
+        }
     }
 }
 
@@ -2146,13 +2317,15 @@ void ScriptEngine::loadEntityScript(const EntityItemID& entityID, const QString&
     auto scriptCache = DependencyManager::get<ScriptCache>();
     // note: see EntityTreeRenderer.cpp for shared pointer lifecycle management
     QWeakPointer<BaseScriptEngine> weakRef(sharedFromThis());
+    auto fetchStart = loadTimerNow();
     scriptCache->getScriptContents(entityScript,
-        [this, weakRef, entityScript, entityID](const QString& url, const QString& contents, bool isURL, bool success, const QString& status) {
+        [this, weakRef, entityScript, entityID, fetchStart](const QString& url, const QString& contents, bool isURL, bool success, const QString& status) {
             QSharedPointer<BaseScriptEngine> strongRef(weakRef);
             if (!strongRef) {
                 qCWarning(scriptengine) << "loadEntityScript.contentAvailable -- ScriptEngine was deleted during getScriptContents!!";
                 return;
             }
+            _fetchTime += loadTimerNow() - fetchStart;
             if (isStopping()) {
 #ifdef DEBUG_ENTITY_STATES
                 qCDebug(scriptengine) << "loadEntityScript.contentAvailable -- stopping";
@@ -2253,7 +2426,8 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
     }
 
     // SYNTAX ERRORS
-    auto syntaxError = lintScript(contents, fileName);
+    ScriptLoadTimer compileTimer(_currentLoadTimer, _compileTime);
+    auto syntaxError = lintScriptOnce(contents, fileName);
     if (syntaxError.isError()) {
         auto message = syntaxError.property("formatted").toString();
         if (message.isEmpty()) {
@@ -2275,62 +2449,68 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         setParentURL(scriptOrURL);
     }
 
-    // SANITY/PERFORMANCE CHECK USING SANDBOX
-    const int SANDBOX_TIMEOUT = 0.25 * MSECS_PER_SECOND;
-    BaseScriptEngine sandbox;
-    sandbox.setProcessEventsInterval(SANDBOX_TIMEOUT);
-    QScriptValue testConstructor, exception;
-    {
-        QTimer timeout;
-        timeout.setSingleShot(true);
-        timeout.start(SANDBOX_TIMEOUT);
-        connect(&timeout, &QTimer::timeout, [=, &sandbox]{
-                qCDebug(scriptengine) << "ScriptEngine::entityScriptContentAvailable timeout";
-
-                // Guard against infinite loops and non-performant code
-                sandbox.raiseException(
-                    sandbox.makeError(QString("Timed out (entity constructors are limited to %1ms)").arg(SANDBOX_TIMEOUT))
-                );
-        });
+    // the sandbox preflight evaluates the whole script, skip it for content that has already passed it
+    auto contentHash = ScriptCache::hashContents(contents);
+    bool hasPassedPreflight = scriptCache->hasPassed(contentHash, ScriptCache::EntityConstructorCheck);
+    if (!hasPassedPreflight) {
+        // SANITY/PERFORMANCE CHECK USING SANDBOX
+        const int SANDBOX_TIMEOUT = 0.25 * MSECS_PER_SECOND;
+        BaseScriptEngine sandbox;
+        sandbox.setProcessEventsInterval(SANDBOX_TIMEOUT);
+        QScriptValue testConstructor, exception;
+        {
+            QTimer timeout;
+            timeout.setSingleShot(true);
+            timeout.start(SANDBOX_TIMEOUT);
+            connect(&timeout, &QTimer::timeout, [=, &sandbox]{
+                    qCDebug(scriptengine) << "ScriptEngine::entityScriptContentAvailable timeout";
+
+                    // Guard against infinite loops and non-performant code
+                    sandbox.raiseException(
+                        sandbox.makeError(QString("Timed out (entity constructors are limited to %1ms)").arg(SANDBOX_TIMEOUT))
+                    );
+            });
 
-        testConstructor = sandbox.evaluate(program);
+            testConstructor = sandbox.evaluate(program);
 
-        if (sandbox.hasUncaughtException()) {
-            exception = sandbox.cloneUncaughtException(QString("(preflight %1)").arg(entityID.toString()));
-            sandbox.clearExceptions();
-        } else if (testConstructor.isError()) {
-            exception = testConstructor;
+            if (sandbox.hasUncaughtException()) {
+                exception = sandbox.cloneUncaughtException(QString("(preflight %1)").arg(entityID.toString()));
+                sandbox.clearExceptions();
+            } else if (testConstructor.isError()) {
+                exception = testConstructor;
+            }
         }
-    }
-
-    if (exception.isError()) {
-        // create a local copy using makeError to decouple from the sandbox engine
-        exception = makeError(exception);
-        setError(formatException(exception, _enableExtendedJSExceptions.get()), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        emit unhandledException(exception);
-        return;
-    }
 
-    // CONSTRUCTOR VIABILITY
-    if (!testConstructor.isFunction()) {
-        QString testConstructorType = QString(testConstructor.toVariant().typeName());
-        if (testConstructorType == "") {
-            testConstructorType = "empty";
-        }
-        QString testConstructorValue = testConstructor.toString();
-        if (testConstructorValue.size() > MAX_DEBUG_VALUE_LENGTH) {
-            testConstructorValue = testConstructorValue.mid(0, MAX_DEBUG_VALUE_LENGTH) + "...";
+        if (exception.isError()) {
+            // create a local copy using makeError to decouple from the sandbox engine
+            exception = makeError(exception);
+            setError(formatException(exception, _enableExtendedJSExceptions.get()), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
+            emit unhandledException(exception);
+            return;
         }
-        auto message = QString("failed to load entity script -- expected a function, got %1, %2")
-            .arg(testConstructorType).arg(testConstructorValue);
 
-        auto err = makeError(message);
-        err.setProperty("fileName", scriptOrURL);
-        err.setProperty("detail", "(constructor " + entityID.toString() + ")");
+        // CONSTRUCTOR VIABILITY
+        if (!testConstructor.isFunction()) {
+            QString testConstructorType = QString(testConstructor.toVariant().typeName());
+            if (testConstructorType == "") {
+                testConstructorType = "empty";
+            }
+            QString testConstructorValue = testConstructor.toString();
+            if (testConstructorValue.size() > MAX_DEBUG_VALUE_LENGTH) {
+                testConstructorValue = testConstructorValue.mid(0, MAX_DEBUG_VALUE_LENGTH) + "...";
+            }
+            auto message = QString("failed to load entity script -- expected a function, got %1, %2")
+                .arg(testConstructorType).arg(testConstructorValue);
+
+            auto err = makeError(message);
+            err.setProperty("fileName", scriptOrURL);
+            err.setProperty("detail", "(constructor " + entityID.toString() + ")");
 
-        setError("Could not find constructor (" + testConstructorType + ")", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        emit unhandledException(err);
-        return; // done processing script
+            setError("Could not find constructor (" + testConstructorType + ")", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
+            emit unhandledException(err);
+            return; // done processing script
+        }
+        scriptCache->setPassed(contentHash, ScriptCache::EntityConstructorCheck);
     }
 
     // (this feeds into refreshFileScript)
@@ -2353,7 +2533,10 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         }
     };
 
-    doWithEnvironment(entityID, sandboxURL, initialization);
+    {
+        ScriptLoadTimer evaluateTimer(_currentLoadTimer, _evaluateTime);
+        doWithEnvironment(entityID, sandboxURL, initialization);
+    }
 
     if (entityScriptObject.isError()) {
         auto exception = entityScriptObject;
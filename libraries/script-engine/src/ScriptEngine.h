@@ -12,6 +12,7 @@
 #ifndef hifi_ScriptEngine_h
 #define hifi_ScriptEngine_h
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -44,9 +45,12 @@
 #include "Vec3.h"
 #include "ConsoleScriptingInterface.h"
 #include "SettingHandle.h"
+#include "TimerWheel.h"
 #include "Profile.h"
 
+class MetricHistogram;
 class QScriptEngineDebugger;
+class QTimer;
 
 static const QString NO_SCRIPT("");
 
@@ -55,6 +59,7 @@ static const int DEFAULT_MAX_ENTITY_PPS = 9000;
 static const int DEFAULT_ENTITY_PPS_PER_SCRIPT = 900;
 
 class ScriptEngines;
+class ScriptLoadTimer;
 
 Q_DECLARE_METATYPE(ScriptEnginePointer)
 
@@ -65,6 +70,18 @@ public:
     QUrl definingSandboxURL;
 };
 
+// The handle Script.setInterval() and Script.setTimeout() give a script to pass back to Script.clearInterval() and
+// Script.clearTimeout().  The timer itself is in the engine's TimerWheel, and the handle is deleted once it is done.
+class ScriptTimer : public QObject {
+    Q_OBJECT
+public:
+    ScriptTimer(TimerWheel::TimerID id, const CallbackData& callback, QObject* parent) :
+        QObject(parent), id(id), callback(callback) {}
+
+    const TimerWheel::TimerID id;
+    const CallbackData callback;
+};
+
 class DeferredLoadEntity {
 public:
     EntityItemID entityID;
@@ -472,7 +489,7 @@ public:
      *     Script.clearInterval(timer);
      * }, 10000);
      */
-    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(qobject_cast<ScriptTimer*>(timer)); }
 
     /**jsdoc
      * Stops a timeout timer set by {@link Script.setTimeout|setTimeout}.
@@ -487,7 +504,7 @@ public:
      * // Uncomment the following line to stop the timer from firing.
      * //Script.clearTimeout(timer);
      */
-    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(qobject_cast<ScriptTimer*>(timer)); }
 
     /**jsdoc
      * Prints a message to the program log.
@@ -663,6 +680,26 @@ public:
     bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const;
     bool hasEntityScriptDetails(const EntityItemID& entityID) const;
 
+    struct TimerStats {
+        int numTimers { 0 };
+        uint64_t numDispatched { 0 };       // callbacks run since the last takeTimerStats()
+        uint64_t averageDispatchLag { 0 };  // usecs from a timer's deadline to its callback running
+        uint64_t maxDispatchLag { 0 };
+    };
+    /// \return timer activity since the last call, safe to call from any thread
+    TimerStats takeTimerStats();
+
+    /// \brief also record the lag of every timer callback, e.g. for a metrics endpoint; call before the engine runs
+    void setTimerDispatchLagHistogram(std::shared_ptr<MetricHistogram> histogram) { _timerDispatchLagHistogram = histogram; }
+
+    struct LoadStats {
+        uint64_t fetchTime { 0 };     // usecs waiting for scripts to download
+        uint64_t compileTime { 0 };   // usecs checking syntax and entity script constructors
+        uint64_t evaluateTime { 0 };  // usecs running script bodies, less the includes and requires they wait on
+    };
+    /// \return time spent loading this engine's scripts so far, safe to call from any thread
+    LoadStats getLoadStats() const;
+
     void setScriptEngines(QSharedPointer<ScriptEngines>& scriptEngines) { _scriptEngines = scriptEngines; }
 
 public slots:
@@ -885,7 +922,9 @@ protected:
     Q_INVOKABLE QString _requireResolve(const QString& moduleId, const QString& relativeTo = QString());
 
     QString logException(const QScriptValue& exception);
-    void timerFired();
+    QScriptValue lintScriptOnce(const QString& sourceCode, const QString& fileName, int lineNumber = 1);
+    void dispatchTimers();
+    void scheduleTimerDispatch();
     void stopAllTimers();
     void stopAllTimersForEntityScript(const EntityItemID& entityID);
     void refreshFileScript(const EntityItemID& entityID);
@@ -894,7 +933,7 @@ protected:
     void setParentURL(const QString& parentURL) { _parentURL = parentURL; }
 
     QObject* setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
-    void stopTimer(QTimer* timer);
+    void stopTimer(ScriptTimer* timer);
 
     QHash<EntityItemID, RegisteredEventHandlers> _registeredHandlers;
     void forwardHandlerCall(const EntityItemID& entityID, const QString& eventName, QScriptValueList eventHanderArgs);
@@ -924,7 +963,10 @@ protected:
     std::atomic<bool> _isRunning { false };
     std::atomic<bool> _isStopping { false };
     bool _isInitialized { false };
-    QHash<QTimer*, CallbackData> _timerFunctionMap;
+    TimerWheel _timerWheel;
+    std::vector<TimerWheel::Expired> _expiredTimers;
+    QHash<TimerWheel::TimerID, ScriptTimer*> _timerFunctionMap;
+    QTimer* _timerDispatchTimer { nullptr }; // wakes the engine for the next timer due, between frames too
     QSet<QUrl> _includedURLs;
     mutable QReadWriteLock _entityScriptsLock { QReadWriteLock::Recursive };
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
@@ -956,6 +998,18 @@ protected:
 
     std::chrono::microseconds _totalTimerExecution { 0 };
 
+    // written by the script thread, read by takeTimerStats()
+    std::atomic<int> _numTimers { 0 };
+    std::atomic<uint64_t> _numTimersDispatched { 0 };
+    std::atomic<uint64_t> _totalTimerDispatchLag { 0 };
+    std::atomic<uint64_t> _maxTimerDispatchLag { 0 };
+    std::shared_ptr<MetricHistogram> _timerDispatchLagHistogram;
+
+    ScriptLoadTimer* _currentLoadTimer { nullptr };
+    std::atomic<uint64_t> _fetchTime { 0 };
+    std::atomic<uint64_t> _compileTime { 0 };
+    std::atomic<uint64_t> _evaluateTime { 0 };
+
     static const QString _SETTINGS_ENABLE_EXTENDED_MODULE_COMPAT;
     static const QString _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS;
 
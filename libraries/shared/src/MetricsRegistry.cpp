@@ -0,0 +1,215 @@
+//
+//  MetricsRegistry.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MetricsRegistry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <QtCore/QtAlgorithms>
+
+#include "SharedLogging.h"
+
+static QString formatLabels(const QString& labels, const QString& extraLabel = QString()) {
+    if (labels.isEmpty() && extraLabel.isEmpty()) {
+        return QString();
+    }
+    if (labels.isEmpty() || extraLabel.isEmpty()) {
+        return "{" + labels + extraLabel + "}";
+    }
+    return "{" + labels + "," + extraLabel + "}";
+}
+
+void MetricCounter::writePrometheus(QTextStream& out, const QString& name, const QString& labels) const {
+    out << name << formatLabels(labels) << " " << get() << "\n";
+}
+
+void MetricGauge::set(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    _bits.store(bits, std::memory_order_relaxed);
+}
+
+double MetricGauge::get() const {
+    uint64_t bits = _bits.load(std::memory_order_relaxed);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void MetricGauge::writePrometheus(QTextStream& out, const QString& name, const QString& labels) const {
+    out << name << formatLabels(labels) << " " << QString::number(get(), 'g', 12) << "\n";
+}
+
+int MetricHistogram::bucketIndex(uint64_t value) {
+    if (value < (uint64_t)SUB_BUCKETS) {
+        return (int)value;
+    }
+    int exponent = 63 - qCountLeadingZeroBits((quint64)value);
+    int subBucket = (int)(value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + subBucket;
+}
+
+uint64_t MetricHistogram::bucketLowerBound(int index) {
+    if (index < SUB_BUCKETS) {
+        return (uint64_t)index;
+    }
+    int exponent = index / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    uint64_t subBucket = (uint64_t)(index % SUB_BUCKETS);
+    return (SUB_BUCKETS + subBucket) << (exponent - SUB_BUCKET_BITS);
+}
+
+uint64_t MetricHistogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKETS) {
+        return (uint64_t)index + 1;
+    }
+    int exponent = index / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    uint64_t lower = bucketLowerBound(index);
+    uint64_t upper = lower + ((uint64_t)1 << (exponent - SUB_BUCKET_BITS));
+    // the last bucket ends past the largest uint64_t
+    return upper > lower ? upper : UINT64_MAX;
+}
+
+void MetricHistogram::record(uint64_t value) {
+    _buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(value, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t MetricHistogram::getQuantile(double q) const {
+    uint64_t count = getCount();
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t target = std::max((uint64_t)1, (uint64_t)std::ceil(q * (double)count));
+    uint64_t cumulative = 0;
+    int lastNonEmpty = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        uint64_t bucketCount = getBucketCount(i);
+        if (bucketCount > 0) {
+            cumulative += bucketCount;
+            lastNonEmpty = i;
+            if (cumulative >= target) {
+                return bucketUpperBound(i) - 1;
+            }
+        }
+    }
+    // values recorded while we were reading can leave the buckets behind the count
+    return bucketUpperBound(lastNonEmpty) - 1;
+}
+
+void MetricHistogram::writePrometheus(QTextStream& out, const QString& name, const QString& labels) const {
+    std::array<uint64_t, NUM_BUCKETS> counts;
+    uint64_t total = 0;
+    int lastNonEmpty = -1;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        counts[i] = getBucketCount(i);
+        total += counts[i];
+        if (counts[i] > 0) {
+            lastNonEmpty = i;
+        }
+    }
+
+    // only report the bounds of each half of a power of two, up to the first one past the largest value, to keep the
+    // number of series down; values are integers, so le is the largest value below a bound
+    const int REPORTED_BUCKETS = SUB_BUCKETS / 2;
+    uint64_t cumulative = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        cumulative += counts[i];
+        if ((i + 1) % REPORTED_BUCKETS == 0) {
+            out << name << "_bucket" << formatLabels(labels, QString("le=\"%1\"").arg(bucketUpperBound(i) - 1))
+                << " " << cumulative << "\n";
+            if (i >= lastNonEmpty) {
+                break;
+            }
+        }
+    }
+    out << name << "_bucket" << formatLabels(labels, "le=\"+Inf\"") << " " << total << "\n";
+    out << name << "_sum" << formatLabels(labels) << " " << getSum() << "\n";
+    out << name << "_count" << formatLabels(labels) << " " << total << "\n";
+}
+
+template <typename T>
+std::shared_ptr<T> MetricsRegistry::getOrCreate(Type type, const QString& name, const QString& help, const QString& labels) {
+    std::lock_guard<std::mutex> lock(_familiesMutex);
+    auto familyItr = _families.find(name);
+    if (familyItr == _families.end()) {
+        familyItr = _families.emplace(name, Family { type, help, {} }).first;
+    } else if (familyItr->second.type != type) {
+        qCWarning(shared) << "Metric" << name << "is already registered with another type, it won't be exposed";
+        return std::make_shared<T>();
+    }
+
+    auto& metric = familyItr->second.metrics[labels];
+    if (!metric) {
+        metric = std::make_shared<T>();
+    }
+    return std::static_pointer_cast<T>(metric);
+}
+
+std::shared_ptr<MetricCounter> MetricsRegistry::counter(const QString& name, const QString& help, const QString& labels) {
+    return getOrCreate<MetricCounter>(Counter, name, help, labels);
+}
+
+std::shared_ptr<MetricGauge> MetricsRegistry::gauge(const QString& name, const QString& help, const QString& labels) {
+    return getOrCreate<MetricGauge>(Gauge, name, help, labels);
+}
+
+std::shared_ptr<MetricHistogram> MetricsRegistry::histogram(const QString& name, const QString& help, const QString& labels) {
+    return getOrCreate<MetricHistogram>(Histogram, name, help, labels);
+}
+
+void MetricsRegistry::remove(const QString& name, const QString& labels) {
+    std::lock_guard<std::mutex> lock(_familiesMutex);
+    auto familyItr = _families.find(name);
+    if (familyItr != _families.end()) {
+        familyItr->second.metrics.erase(labels);
+        if (familyItr->second.metrics.empty()) {
+            _families.erase(familyItr);
+        }
+    }
+}
+
+QByteArray MetricsRegistry::toPrometheusText() const {
+    QByteArray text;
+    QTextStream out(&text);
+
+    std::lock_guard<std::mutex> lock(_familiesMutex);
+    for (const auto& family : _families) {
+        QString help = family.second.help;
+        help.replace("\\", "\\\\").replace("\n", "\\n");
+        out << "# HELP " << family.first << " " << help << "\n";
+
+        switch (family.second.type) {
+            case Counter:
+                out << "# TYPE " << family.first << " counter\n";
+                break;
+            case Gauge:
+                out << "# TYPE " << family.first << " gauge\n";
+                break;
+            case Histogram:
+                out << "# TYPE " << family.first << " histogram\n";
+                break;
+        }
+
+        for (const auto& metric : family.second.metrics) {
+            metric.second->writePrometheus(out, family.first, metric.first);
+        }
+    }
+    out.flush();
+    return text;
+}
+
+QString MetricsRegistry::label(const QString& key, const QString& value) {
+    QString escaped = value;
+    escaped.replace("\\", "\\\\").replace("\"", "\\\"").replace("\n", "\\n");
+    return QString("%1=\"%2\"").arg(key, escaped);
+}
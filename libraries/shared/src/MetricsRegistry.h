@@ -0,0 +1,134 @@
+//
+//  MetricsRegistry.h
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_MetricsRegistry_h
+#define hifi_MetricsRegistry_h
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QTextStream>
+
+#include "DependencyManager.h"
+
+class Metric {
+public:
+    virtual ~Metric() = default;
+
+protected:
+    friend class MetricsRegistry;
+    virtual void writePrometheus(QTextStream& out, const QString& name, const QString& labels) const = 0;
+};
+
+// A value that only goes up, e.g. packets sent
+class MetricCounter : public Metric {
+public:
+    void increment(uint64_t amount = 1) { _value.fetch_add(amount, std::memory_order_relaxed); }
+    uint64_t get() const { return _value.load(std::memory_order_relaxed); }
+
+protected:
+    void writePrometheus(QTextStream& out, const QString& name, const QString& labels) const override;
+
+private:
+    std::atomic<uint64_t> _value { 0 };
+};
+
+// A value that is set, e.g. connected listeners
+class MetricGauge : public Metric {
+public:
+    void set(double value);
+    double get() const;
+
+protected:
+    void writePrometheus(QTextStream& out, const QString& name, const QString& labels) const override;
+
+private:
+    std::atomic<uint64_t> _bits { 0 }; // of a double, all zero bits is 0.0
+};
+
+// Distribution of non-negative integer values, e.g. durations in usecs.
+//
+// Buckets are log-linear, as in HdrHistogram: values below SUB_BUCKETS are counted exactly and every power of two
+// above that is split into SUB_BUCKETS equal buckets, so any quantile is known to within 1 / SUB_BUCKETS of its value.
+// Recording a value is three relaxed atomic adds.
+class MetricHistogram : public Metric {
+public:
+    static const int SUB_BUCKET_BITS = 3;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    static int bucketIndex(uint64_t value);
+    static uint64_t bucketLowerBound(int index);
+    /// \return first value past the bucket
+    static uint64_t bucketUpperBound(int index);
+
+    void record(uint64_t value);
+
+    uint64_t getCount() const { return _count.load(std::memory_order_relaxed); }
+    uint64_t getSum() const { return _sum.load(std::memory_order_relaxed); }
+    uint64_t getBucketCount(int index) const { return _buckets[index].load(std::memory_order_relaxed); }
+    /// \return largest value of the bucket holding quantile q (0.0 to 1.0) of the recorded values, 0 if there are none
+    uint64_t getQuantile(double q) const;
+
+protected:
+    void writePrometheus(QTextStream& out, const QString& name, const QString& labels) const override;
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> _buckets {};
+    std::atomic<uint64_t> _count { 0 };
+    std::atomic<uint64_t> _sum { 0 };
+};
+
+// Process wide metrics, exposed in the Prometheus text format.
+//
+// Registering a metric takes a lock, so callers hold on to the returned metric and update it directly: updates
+// are lock free.  Metrics with the same name are a family that differ by their labels, e.g. stage="mix".
+//
+// A metric can also be made with std::make_shared, in which case it is updated like any other but not exposed.
+// Assignments start with metrics like that and swap in registered ones from their setUpMetrics(), so the code
+// updating them doesn't have to check whether there is a registry.
+class MetricsRegistry : public Dependency {
+public:
+    std::shared_ptr<MetricCounter> counter(const QString& name, const QString& help, const QString& labels = QString());
+    std::shared_ptr<MetricGauge> gauge(const QString& name, const QString& help, const QString& labels = QString());
+    std::shared_ptr<MetricHistogram> histogram(const QString& name, const QString& help, const QString& labels = QString());
+
+    /// \brief stop exposing a metric, e.g. one labelled with a node that has left
+    void remove(const QString& name, const QString& labels = QString());
+
+    QByteArray toPrometheusText() const;
+
+    /// \return key="value" with the value escaped for the Prometheus text format
+    static QString label(const QString& key, const QString& value);
+
+private:
+    enum Type { Counter, Gauge, Histogram };
+
+    struct Family {
+        Type type;
+        QString help;
+        std::map<QString, std::shared_ptr<Metric>> metrics; // by labels
+    };
+
+    template <typename T>
+    std::shared_ptr<T> getOrCreate(Type type, const QString& name, const QString& help, const QString& labels);
+
+    mutable std::mutex _familiesMutex;
+    std::map<QString, Family> _families; // by name
+};
+
+#endif // hifi_MetricsRegistry_h
@@ -0,0 +1,228 @@
+//
+//  PrioritySortUtil.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PrioritySortUtil.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "CPUDetect.h"
+
+#ifdef ARCH_X86
+#include <emmintrin.h>
+#endif
+
+using namespace PrioritySortUtil;
+
+static const float MIN_DISTANCE = 0.001f; // add 1mm to avoid divide by zero
+static const float MIN_RADIUS = 0.1f; // WORKAROUND for zero size objects (we still want them to sort by distance)
+
+void SortableArrays::reserve(size_t num) {
+    positionsX.reserve(num);
+    positionsY.reserve(num);
+    positionsZ.reserve(num);
+    radii.reserve(num);
+    ages.reserve(num);
+}
+
+void SortableArrays::clear() {
+    positionsX.clear();
+    positionsY.clear();
+    positionsZ.clear();
+    radii.clear();
+    ages.clear();
+}
+
+void SortableArrays::push(const glm::vec3& position, float radius, float age) {
+    positionsX.push_back(position.x);
+    positionsY.push_back(position.y);
+    positionsZ.push_back(position.z);
+    radii.push_back(radius);
+    ages.push_back(age);
+}
+
+void SortableArrays::reorder(const std::vector<uint32_t>& order) {
+    assert(order.size() == size());
+    std::vector<float> reordered(order.size());
+    for (auto* values : { &positionsX, &positionsY, &positionsZ, &radii, &ages }) {
+        for (size_t i = 0; i < order.size(); ++i) {
+            reordered[i] = (*values)[order[i]];
+        }
+        values->swap(reordered);
+    }
+}
+
+// What every thing's priority needs of a view, looked up once per view rather than once per thing
+class ViewConstants {
+public:
+    ViewConstants(const ConicalViewFrustum& view) :
+        position(view.getPosition()),
+        direction(view.getDirection()),
+        radius(view.getRadius()),
+        farClip(view.getFarClip()),
+        sinAngle(view.getSinAngle()),
+        cosAngle(view.getCosAngle()) {
+    }
+
+    glm::vec3 position;
+    glm::vec3 direction;
+    float radius;
+    float farClip;
+    float sinAngle;
+    float cosAngle;
+};
+
+// ConicalViewFrustum::intersects, given the dot product of the offset to the thing with the view direction
+static bool intersects(const ViewConstants& view, float dotDirection, float distance, float radius) {
+    if (distance < view.radius + radius) {
+        return true;
+    }
+    if (distance > view.farClip + radius) {
+        return false;
+    }
+    return dotDirection > std::sqrt(distance * distance - radius * radius) * view.cosAngle - radius * view.sinAngle;
+}
+
+static float computePriority(const ViewConstants& view, const Weights& weights, const SortableArrays& things, size_t i) {
+    // priority = weighted linear combination of multiple values:
+    //   (a) angular size
+    //   (b) proximity to center of view
+    //   (c) time since last update
+    // where the relative "weights" are tuned to scale the contributing values into units of "priority".
+
+    glm::vec3 offset = glm::vec3(things.positionsX[i], things.positionsY[i], things.positionsZ[i]) - view.position;
+    float distance = std::sqrt(glm::dot(offset, offset)) + MIN_DISTANCE;
+    float radius = std::max(things.radii[i], MIN_RADIUS);
+    // Other item's angle from view centre:
+    float dotDirection = glm::dot(offset, view.direction);
+    float cosineAngle = dotDirection / distance;
+    if (cosineAngle > 0.0f) {
+        cosineAngle = std::sqrt(cosineAngle);
+    }
+    float age = things.ages[i];
+
+    // the "age" term accumulates at the sum of all weights
+    float angularSize = radius / distance;
+    float priority = (weights.angular * angularSize + weights.center * cosineAngle) * (age + 1.0f) + weights.age * age;
+
+    // decrement priority of things outside keyhole
+    if (distance - radius > view.radius) {
+        if (!intersects(view, dotDirection, distance, radius)) {
+            priority += OUT_OF_VIEW_PENALTY;
+        }
+    }
+    return priority;
+}
+
+void PrioritySortUtil::computePriorities(const ConicalViewFrustums& views, const Weights& weights,
+                                         const SortableArrays& things, RankedVector& ranked) {
+    size_t numThings = things.size();
+    ranked.resize(numThings);
+    for (size_t i = 0; i < numThings; ++i) {
+        ranked[i] = { std::numeric_limits<float>::min(), (uint32_t)i };
+    }
+
+    for (const auto& conicalView : views) {
+        ViewConstants view(conicalView);
+        size_t i = 0;
+#ifdef ARCH_X86
+        // the same as computePriority, four things at a time
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 minDistance = _mm_set1_ps(MIN_DISTANCE);
+        const __m128 minRadius = _mm_set1_ps(MIN_RADIUS);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 penalty = _mm_set1_ps(OUT_OF_VIEW_PENALTY);
+        const __m128 angularWeight = _mm_set1_ps(weights.angular);
+        const __m128 centerWeight = _mm_set1_ps(weights.center);
+        const __m128 ageWeight = _mm_set1_ps(weights.age);
+        const __m128 viewX = _mm_set1_ps(view.position.x);
+        const __m128 viewY = _mm_set1_ps(view.position.y);
+        const __m128 viewZ = _mm_set1_ps(view.position.z);
+        const __m128 directionX = _mm_set1_ps(view.direction.x);
+        const __m128 directionY = _mm_set1_ps(view.direction.y);
+        const __m128 directionZ = _mm_set1_ps(view.direction.z);
+        const __m128 viewRadius = _mm_set1_ps(view.radius);
+        const __m128 farClip = _mm_set1_ps(view.farClip);
+        const __m128 sinAngle = _mm_set1_ps(view.sinAngle);
+        const __m128 cosAngle = _mm_set1_ps(view.cosAngle);
+        for (; i + 4 <= numThings; i += 4) {
+            __m128 offsetX = _mm_sub_ps(_mm_loadu_ps(&things.positionsX[i]), viewX);
+            __m128 offsetY = _mm_sub_ps(_mm_loadu_ps(&things.positionsY[i]), viewY);
+            __m128 offsetZ = _mm_sub_ps(_mm_loadu_ps(&things.positionsZ[i]), viewZ);
+            __m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(offsetX, offsetX), _mm_mul_ps(offsetY, offsetY)),
+                                                _mm_mul_ps(offsetZ, offsetZ));
+            __m128 distance = _mm_add_ps(_mm_sqrt_ps(distanceSquared), minDistance);
+            __m128 radius = _mm_max_ps(_mm_loadu_ps(&things.radii[i]), minRadius);
+
+            __m128 dotDirection = _mm_add_ps(_mm_add_ps(_mm_mul_ps(offsetX, directionX), _mm_mul_ps(offsetY, directionY)),
+                                             _mm_mul_ps(offsetZ, directionZ));
+            __m128 cosineAngle = _mm_div_ps(dotDirection, distance);
+            __m128 positive = _mm_cmpgt_ps(cosineAngle, zero);
+            cosineAngle = _mm_or_ps(_mm_and_ps(positive, _mm_sqrt_ps(_mm_and_ps(positive, cosineAngle))),
+                                    _mm_andnot_ps(positive, cosineAngle));
+            __m128 age = _mm_loadu_ps(&things.ages[i]);
+
+            __m128 angularSize = _mm_div_ps(radius, distance);
+            __m128 priority = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(angularWeight, angularSize), _mm_mul_ps(centerWeight, cosineAngle)),
+                                         _mm_add_ps(age, one));
+            priority = _mm_add_ps(priority, _mm_mul_ps(ageWeight, age));
+
+            __m128 outsideKeyhole = _mm_cmpgt_ps(_mm_sub_ps(distance, radius), viewRadius);
+            __m128 pastFarClip = _mm_cmpgt_ps(distance, _mm_add_ps(farClip, radius));
+            __m128 coneDistance = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(_mm_mul_ps(distance, distance),
+                                                                    _mm_mul_ps(radius, radius)), zero));
+            __m128 outsideCone = _mm_cmpngt_ps(dotDirection, _mm_sub_ps(_mm_mul_ps(coneDistance, cosAngle),
+                                                                         _mm_mul_ps(radius, sinAngle)));
+            __m128 insideRadius = _mm_cmplt_ps(distance, _mm_add_ps(viewRadius, radius));
+            __m128 outOfView = _mm_andnot_ps(insideRadius, _mm_and_ps(outsideKeyhole, _mm_or_ps(pastFarClip, outsideCone)));
+            priority = _mm_add_ps(priority, _mm_and_ps(outOfView, penalty));
+
+            float priorities[4];
+            _mm_storeu_ps(priorities, priority);
+            for (size_t j = 0; j < 4; ++j) {
+                ranked[i + j].priority = std::max(ranked[i + j].priority, priorities[j]);
+            }
+        }
+#endif
+        for (; i < numThings; ++i) {
+            ranked[i].priority = std::max(ranked[i].priority, computePriority(view, weights, things, i));
+        }
+    }
+}
+
+void PrioritySortUtil::sortHighest(RankedVector& ranked, size_t numToSort, float& threshold) {
+    auto higher = [](const Ranked& left, const Ranked& right) { return left.priority > right.priority; };
+    numToSort = std::min(numToSort, ranked.size());
+    if (numToSort == 0) {
+        return;
+    }
+    if (numToSort == ranked.size()) {
+        std::sort(ranked.begin(), ranked.end(), higher);
+        return;
+    }
+
+    auto nth = ranked.begin() + numToSort;
+    if (threshold == NO_THRESHOLD) {
+        std::nth_element(ranked.begin(), nth - 1, ranked.end(), higher);
+    } else {
+        // everything before aboveThreshold outranks everything after it, so the nth is on whichever side it falls
+        float lastThreshold = threshold;
+        auto aboveThreshold = std::partition(ranked.begin(), ranked.end(),
+            [lastThreshold](const Ranked& thing) { return thing.priority >= lastThreshold; });
+        if (aboveThreshold >= nth) {
+            std::nth_element(ranked.begin(), nth - 1, aboveThreshold, higher);
+        } else {
+            std::nth_element(aboveThreshold, nth - 1, ranked.end(), higher);
+        }
+    }
+    std::sort(ranked.begin(), nth - 1, higher);
+    threshold = (nth - 1)->priority;
+}
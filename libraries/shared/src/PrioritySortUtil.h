@@ -11,9 +11,13 @@
 #ifndef hifi_PrioritySortUtil_h
 #define hifi_PrioritySortUtil_h
 
+#include <limits>
+#include <vector>
+
 #include <glm/glm.hpp>
 
 #include "NumericalConstants.h"
+#include "SharedUtil.h"
 #include "shared/ConicalViewFrustum.h"
 
 //   PrioritySortUtil is a helper for sorting 3D things relative to a ViewFrustum.
@@ -41,94 +45,116 @@ namespace PrioritySortUtil {
         float _priority { 0.0f };
     };
 
+    class Weights {
+    public:
+        float angular { DEFAULT_ANGULAR_COEF };
+        float center { DEFAULT_CENTER_COEF };
+        float age { DEFAULT_AGE_COEF };
+    };
+
+    // What the priority of a thing depends on, for many things at once as a structure of arrays
+    class SortableArrays {
+    public:
+        size_t size() const { return radii.size(); }
+        void reserve(size_t num);
+        void clear();
+        void push(const glm::vec3& position, float radius, float age);
+
+        // Reorders the things so that the ith is the one that was at order[i]
+        void reorder(const std::vector<uint32_t>& order);
+
+        std::vector<float> positionsX;
+        std::vector<float> positionsY;
+        std::vector<float> positionsZ;
+        std::vector<float> radii;
+        std::vector<float> ages; // seconds since last updated
+    };
+
+    class Ranked {
+    public:
+        float priority;
+        uint32_t index;
+    };
+    using RankedVector = std::vector<Ranked>;
+
+    // The priority of each thing, the highest it has in any of the views
+    void computePriorities(const ConicalViewFrustums& views, const Weights& weights, const SortableArrays& things,
+                           RankedVector& ranked);
+
+    // Puts the numToSort highest priorities first, in order, and leaves the rest after them in no particular order.
+    // The priority of the last of them is kept in threshold for the next call: the things that were high enough this
+    // frame mostly are the next, so only those above it need selecting among when there are still enough of them.
+    void sortHighest(RankedVector& ranked, size_t numToSort, float& threshold);
+
+    constexpr float NO_THRESHOLD { std::numeric_limits<float>::lowest() };
+
     template <typename T>
     class PriorityQueue {
     public:
         PriorityQueue() = delete;
-        PriorityQueue(const ConicalViewFrustums& views) : _views(views) { }
+        PriorityQueue(const ConicalViewFrustums& views) : _views(views), _usecCurrentTime(usecTimestampNow()) { }
         PriorityQueue(const ConicalViewFrustums& views, float angularWeight, float centerWeight, float ageWeight)
-            : _views(views), _angularWeight(angularWeight), _centerWeight(centerWeight), _ageWeight(ageWeight)
+            : _views(views), _weights({ angularWeight, centerWeight, ageWeight })
             , _usecCurrentTime(usecTimestampNow()) {
         }
 
         void setViews(const ConicalViewFrustums& views) { _views = views; }
 
         void setWeights(float angularWeight, float centerWeight, float ageWeight) {
-            _angularWeight = angularWeight;
-            _centerWeight = centerWeight;
-            _ageWeight = ageWeight;
+            _weights = { angularWeight, centerWeight, ageWeight };
             _usecCurrentTime = usecTimestampNow();
         }
 
         size_t size() const { return _vector.size(); }
         void push(T thing) {
-            thing.setPriority(computePriority(thing));
-            _vector.push_back(thing);
+            float age = float((_usecCurrentTime - thing.getTimestamp()) / USECS_PER_SECOND);
+            _things.push(thing.getPosition(), thing.getRadius(), age);
+            _vector.push_back(std::move(thing));
         }
         void reserve(size_t num) {
             _vector.reserve(num);
+            _things.reserve(num);
         }
-        const std::vector<T>& getSortedVector(int numToSort = 0) {
-            if (numToSort == 0 || numToSort >= (int)_vector.size()) {
-                std::sort(_vector.begin(), _vector.end(),
-                    [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); });
-            } else {
-                std::partial_sort(_vector.begin(), _vector.begin() + numToSort, _vector.end(),
-                    [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); });
-            }
-            return _vector;
-        }
-
-    private:
 
-        float computePriority(const T& thing) const {
-            float priority = std::numeric_limits<float>::min();
-
-            for (const auto& view : _views) {
-                priority = std::max(priority, computePriority(view, thing));
-            }
-
-            return priority;
+        // Empties the queue for the next frame, keeping what it learned sorting this one
+        void clear() {
+            _vector.clear();
+            _things.clear();
+            _usecCurrentTime = usecTimestampNow();
         }
 
-        float computePriority(const ConicalViewFrustum& view, const T& thing) const {
-            // priority = weighted linear combination of multiple values:
-            //   (a) angular size
-            //   (b) proximity to center of view
-            //   (c) time since last update
-            // where the relative "weights" are tuned to scale the contributing values into units of "priority".
-
-            glm::vec3 position = thing.getPosition();
-            glm::vec3 offset = position - view.getPosition();
-            float distance = glm::length(offset) + 0.001f; // add 1mm to avoid divide by zero
-            const float MIN_RADIUS = 0.1f; // WORKAROUND for zero size objects (we still want them to sort by distance)
-            float radius = glm::max(thing.getRadius(), MIN_RADIUS);
-            // Other item's angle from view centre:
-            float cosineAngle = glm::dot(offset, view.getDirection()) / distance;
-            if (cosineAngle > 0.0f) {
-                cosineAngle = std::sqrt(cosineAngle);
-            }
-            float age = float((_usecCurrentTime - thing.getTimestamp()) / USECS_PER_SECOND);
-
-            // the "age" term accumulates at the sum of all weights
-            float angularSize = radius / distance;
-            float priority = (_angularWeight * angularSize + _centerWeight * cosineAngle) * (age + 1.0f) + _ageWeight * age;
-
-            // decrement priority of things outside keyhole
-            if (distance - radius > view.getRadius()) {
-                if (!view.intersects(offset, distance, radius)) {
-                    priority += OUT_OF_VIEW_PENALTY;
-                }
+        const std::vector<T>& getSortedVector(int numToSort = 0) {
+            // the priorities are only computed now, all at once
+            computePriorities(_views, _weights, _things, _ranked);
+            size_t numHighest = (numToSort <= 0 || numToSort >= (int)_vector.size()) ? _vector.size() : (size_t)numToSort;
+            sortHighest(_ranked, numHighest, _threshold);
+
+            _order.resize(_ranked.size());
+            _sortedVector.clear();
+            _sortedVector.reserve(_vector.size());
+            for (size_t i = 0; i < _ranked.size(); ++i) {
+                const auto& ranked = _ranked[i];
+                _order[i] = ranked.index;
+                _vector[ranked.index].setPriority(ranked.priority);
+                _sortedVector.push_back(std::move(_vector[ranked.index]));
             }
-            return priority;
+            _vector.swap(_sortedVector);
+            _sortedVector.clear();
+            _things.reorder(_order);
+            return _vector;
         }
 
+    private:
         ConicalViewFrustums _views;
         std::vector<T> _vector;
-        float _angularWeight { DEFAULT_ANGULAR_COEF };
-        float _centerWeight { DEFAULT_CENTER_COEF };
-        float _ageWeight { DEFAULT_AGE_COEF };
+        SortableArrays _things; // in the same order as _vector
+        Weights _weights;
         quint64 _usecCurrentTime { 0 };
+
+        float _threshold { NO_THRESHOLD };
+        RankedVector _ranked;
+        std::vector<uint32_t> _order;
+        std::vector<T> _sortedVector;
     };
 } // namespace PrioritySortUtil
 
@@ -38,13 +38,23 @@ Q_LOGGING_CATEGORY(trace_baker, "trace.baker")
 #define NSIGHT_TRACING
 #endif
 
-static bool tracingEnabled() {
-    // Cheers, love! The cavalry's here!
-    auto tracer = DependencyManager::get<tracing::Tracer>();
-    return (tracer && tracer->isEnabled());
+#if defined(NSIGHT_TRACING)
+static void pushNsightRange(const char* name, uint32_t argbColor, uint64_t payload) {
+    nvtxEventAttributes_t eventAttrib{ 0 };
+    eventAttrib.version = NVTX_VERSION;
+    eventAttrib.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
+    eventAttrib.colorType = NVTX_COLOR_ARGB;
+    eventAttrib.color = argbColor;
+    eventAttrib.messageType = NVTX_MESSAGE_TYPE_ASCII;
+    eventAttrib.message.ascii = name;
+    eventAttrib.payload.llValue = payload;
+    eventAttrib.payloadType = NVTX_PAYLOAD_TYPE_UNSIGNED_INT64;
+
+    nvtxRangePushEx(&eventAttrib);
 }
+#endif
 
-DurationBase::DurationBase(const QLoggingCategory& category, const QString& name) : _name(name), _category(category) {
+DurationBase::DurationBase(const QLoggingCategory& category) : _category(category) {
 }
 
 Duration::Duration(const QLoggingCategory& category,
@@ -52,31 +62,52 @@ Duration::Duration(const QLoggingCategory& category,
                    uint32_t argbColor,
                    uint64_t payload,
                    const QVariantMap& baseArgs) :
-    DurationBase(category, name) {
-    if (tracingEnabled() && category.isDebugEnabled()) {
-        QVariantMap args = baseArgs;
-        args["nv_payload"] = QVariant::fromValue(payload);
-        tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
-
+    DurationBase(category) {
+    if (tracing::TraceRecorder::isRecording() && category.isDebugEnabled()) {
+        begin(tracing::TraceRecorder::internName(name), name, payload, baseArgs);
 #if defined(NSIGHT_TRACING)
-        nvtxEventAttributes_t eventAttrib{ 0 };
-        eventAttrib.version = NVTX_VERSION;
-        eventAttrib.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
-        eventAttrib.colorType = NVTX_COLOR_ARGB;
-        eventAttrib.color = argbColor;
-        eventAttrib.messageType = NVTX_MESSAGE_TYPE_ASCII;
-        eventAttrib.message.ascii = name.toUtf8().data();
-        eventAttrib.payload.llValue = payload;
-        eventAttrib.payloadType = NVTX_PAYLOAD_TYPE_UNSIGNED_INT64;
+        pushNsightRange(name.toUtf8().data(), argbColor, payload);
+#endif
+    }
+}
 
-        nvtxRangePushEx(&eventAttrib);
+Duration::Duration(const QLoggingCategory& category,
+                   const char* name,
+                   uint32_t argbColor,
+                   uint64_t payload,
+                   const QVariantMap& baseArgs) :
+    DurationBase(category) {
+    if (tracing::TraceRecorder::isRecording() && category.isDebugEnabled()) {
+        uint32_t nameID = tracing::TraceRecorder::internName(name);
+        if (baseArgs.empty()) {
+            _nameID = nameID;
+            _isTraced = true;
+            tracing::TraceRecorder::record(_category, nameID, tracing::DurationBegin, tracing::Tracer::now(), payload);
+        } else {
+            begin(nameID, QString(name), payload, baseArgs);
+        }
+#if defined(NSIGHT_TRACING)
+        pushNsightRange(name, argbColor, payload);
 #endif
     }
 }
 
+void Duration::begin(uint32_t nameID, const QString& name, uint64_t payload, const QVariantMap& baseArgs) {
+    _nameID = nameID;
+    _isTraced = true;
+    if (!baseArgs.empty() && DependencyManager::isSet<tracing::Tracer>() && tracing::enabled()) {
+        // extra args only fit in the tracer's own events
+        QVariantMap args = baseArgs;
+        args["nv_payload"] = QVariant::fromValue(payload);
+        tracing::traceEvent(_category, name, tracing::DurationBegin, "", args);
+    } else {
+        tracing::TraceRecorder::record(_category, nameID, tracing::DurationBegin, tracing::Tracer::now(), payload);
+    }
+}
+
 Duration::~Duration() {
-    if (tracingEnabled() && _category.isDebugEnabled()) {
-        tracing::traceEvent(_category, _name, tracing::DurationEnd);
+    if (_isTraced) {
+        tracing::TraceRecorder::record(_category, _nameID, tracing::DurationEnd, tracing::Tracer::now());
 #ifdef NSIGHT_TRACING
         nvtxRangePop();
 #endif
@@ -86,7 +117,7 @@ Duration::~Duration() {
 // FIXME
 uint64_t Duration::beginRange(const QLoggingCategory& category, const char* name, uint32_t argbColor) {
 #ifdef NSIGHT_TRACING
-    if (tracingEnabled() && category.isDebugEnabled()) {
+    if (tracing::TraceRecorder::isRecording() && category.isDebugEnabled()) {
         nvtxEventAttributes_t eventAttrib = { 0 };
         eventAttrib.version = NVTX_VERSION;
         eventAttrib.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
@@ -103,23 +134,24 @@ uint64_t Duration::beginRange(const QLoggingCategory& category, const char* name
 // FIXME
 void Duration::endRange(const QLoggingCategory& category, uint64_t rangeId) {
 #ifdef NSIGHT_TRACING
-    if (tracingEnabled() && category.isDebugEnabled()) {
+    if (tracing::TraceRecorder::isRecording() && category.isDebugEnabled()) {
         nvtxRangeEnd(rangeId);
     }
 #endif
 }
 
 ConditionalDuration::ConditionalDuration(const QLoggingCategory& category, const QString& name, uint32_t minTime) :
-    DurationBase(category, name), _startTime(tracing::Tracer::now()), _minTime(minTime * USECS_PER_MSEC) {
+    DurationBase(category), _name(name), _startTime(tracing::Tracer::now()), _minTime(minTime * USECS_PER_MSEC) {
 }
 
 ConditionalDuration::~ConditionalDuration() {
-    if (tracingEnabled() && _category.isDebugEnabled()) {
+    if (tracing::TraceRecorder::isRecording() && _category.isDebugEnabled()) {
         auto endTime = tracing::Tracer::now();
         auto duration = endTime - _startTime;
         if (duration >= _minTime) {
-            tracing::traceEvent(_category, _startTime, _name, tracing::DurationBegin);
-            tracing::traceEvent(_category, endTime, _name, tracing::DurationEnd);
+            uint32_t nameID = tracing::TraceRecorder::internName(_name);
+            tracing::TraceRecorder::record(_category, nameID, tracing::DurationBegin, _startTime);
+            tracing::TraceRecorder::record(_category, nameID, tracing::DurationEnd, endTime);
         }
     }
 }
@@ -11,6 +11,7 @@
 #define HIFI_PROFILE_
 
 #include "Trace.h"
+#include "TraceRecorder.h"
 #include "SharedUtil.h"
 
 // When profiling something that may happen many times per frame, use a xxx_detail category so that they may easily be filtered out of trace results
@@ -40,18 +41,26 @@ Q_DECLARE_LOGGING_CATEGORY(trace_baker)
 class DurationBase {
 
 protected:
-    DurationBase(const QLoggingCategory& category, const QString& name);
-    const QString _name;
+    DurationBase(const QLoggingCategory& category);
     const QLoggingCategory& _category;
 };
 
+// Ranges are recorded by the TraceRecorder.  The const char* overload lets string literals skip the QString
+// conversion, so an enabled range costs an interned name lookup and two buffered events.
 class Duration : public DurationBase {
 public:
     Duration(const QLoggingCategory& category, const QString& name, uint32_t argbColor = 0xff0000ff, uint64_t payload = 0, const QVariantMap& args = QVariantMap());
+    Duration(const QLoggingCategory& category, const char* name, uint32_t argbColor = 0xff0000ff, uint64_t payload = 0, const QVariantMap& args = QVariantMap());
     ~Duration();
 
     static uint64_t beginRange(const QLoggingCategory& category, const char* name, uint32_t argbColor);
     static void endRange(const QLoggingCategory& category, uint64_t rangeId);
+
+private:
+    void begin(uint32_t nameID, const QString& name, uint64_t payload, const QVariantMap& args);
+
+    uint32_t _nameID { 0 };
+    bool _isTraced { false };
 };
 
 class ConditionalDuration : public DurationBase {
@@ -60,6 +69,7 @@ public:
     ~ConditionalDuration();
 
 private:
+    const QString _name;
     const int64_t _startTime;
     const int64_t _minTime;
 };
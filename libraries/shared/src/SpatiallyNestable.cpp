@@ -11,9 +11,14 @@
 
 #include "SpatiallyNestable.h"
 
+#include <algorithm>
+#include <mutex>
 #include <queue>
+#include <unordered_set>
 
 #include "DependencyManager.h"
+#include "Profile.h"
+#include "TBBHelpers.h"
 #include "SharedUtil.h"
 #include "StreamUtils.h"
 #include "SharedLogging.h"
@@ -21,6 +26,11 @@
 const float defaultAACubeSize = 1.0f;
 const int MAX_PARENTING_CHAIN_SIZE = 30;
 
+// nestables whose world transforms changed since the last updateWorldTransforms(), when batched updates are on
+static std::atomic<bool> batchedTransformUpdates { false };
+static std::mutex changedTransformsMutex;
+static std::unordered_set<SpatiallyNestable*> changedTransforms;
+
 SpatiallyNestable::SpatiallyNestable(NestableType nestableType, QUuid id) :
     _id(id),
     _nestableType(nestableType),
@@ -36,8 +46,13 @@ SpatiallyNestable::SpatiallyNestable(NestableType nestableType, QUuid id) :
 
 SpatiallyNestable::~SpatiallyNestable() {
     forEachChild([&](SpatiallyNestablePointer object) {
+        object->worldTransformChanged();
         object->parentDeleted();
     });
+    if (_isWorldTransformQueued) {
+        std::lock_guard<std::mutex> lock(changedTransformsMutex);
+        changedTransforms.erase(this);
+    }
 }
 
 const QUuid SpatiallyNestable::getID() const {
@@ -79,6 +94,10 @@ void SpatiallyNestable::setParentID(const QUuid& parentID) {
         }
     });
 
+    if (parentChanged) {
+        worldTransformChanged();
+    }
+
     if (parentChanged && success && parent) {
         parent->recalculateChildCauterization();
     }
@@ -184,6 +203,7 @@ void SpatiallyNestable::forgetChild(SpatiallyNestablePointer newChild) const {
 
 void SpatiallyNestable::setParentJointIndex(quint16 parentJointIndex) {
     _parentJointIndex = parentJointIndex;
+    worldTransformChanged();
     bool success = false;
     auto parent = getParentPointer(success);
     if (success && parent) {
@@ -515,6 +535,7 @@ void SpatiallyNestable::setWorldTransform(const glm::vec3& position, const glm::
             }
         });
         if (changed) {
+            worldTransformChanged();
             locationChanged(false);
         }
     }
@@ -558,6 +579,9 @@ void SpatiallyNestable::setWorldPosition(const glm::vec3& position, bool& succes
             _translationChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        worldTransformChanged();
+    }
     if (success && changed) {
         locationChanged(tellPhysics);
     }
@@ -611,6 +635,9 @@ void SpatiallyNestable::setWorldOrientation(const glm::quat& orientation, bool&
             _rotationChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        worldTransformChanged();
+    }
     if (success && changed) {
         locationChanged(tellPhysics);
     }
@@ -746,14 +773,124 @@ glm::vec3 SpatiallyNestable::getParentAngularVelocity(bool& success) const {
 
 const Transform SpatiallyNestable::getTransform(bool& success, int depth) const {
     Transform result;
-    // return a world-space transform for this object's location
-    Transform parentTransform = getParentTransform(success, depth);
+    bool isCached = false;
     _transformLock.withReadLock([&] {
-        Transform::mult(result, parentTransform, _transform);
+        if (_worldTransformCacheVersion == _worldTransformVersion) {
+            result = _worldTransformCache;
+            isCached = true;
+        }
     });
+    if (isCached) {
+        success = true;
+        return result;
+    }
+
+    // return a world-space transform for this object's location
+    uint32_t version = _worldTransformVersion;
+    Transform parentTransform = getParentTransform(success, depth);
+    if (success && canCacheWorldTransform()) {
+        _transformLock.withWriteLock([&] {
+            Transform::mult(result, parentTransform, _transform);
+            // unless it moved while the parent's transform was being found
+            if (version == _worldTransformVersion) {
+                _worldTransformCache = result;
+                _worldTransformCacheVersion = version;
+            }
+        });
+    } else {
+        _transformLock.withReadLock([&] {
+            Transform::mult(result, parentTransform, _transform);
+        });
+    }
     return result;
 }
 
+bool SpatiallyNestable::canCacheWorldTransform() const {
+    // The cached world transform is dropped when this or an ancestor moves.  Joints move and parents rescale their
+    // children without telling them, and a parent that doesn't know about this child yet can't tell it anything.
+    if (getParentID().isNull()) {
+        return true;
+    }
+    if (_parentJointIndex != INVALID_JOINT_INDEX || !_parentKnowsMe || getScalesWithParent()) {
+        return false;
+    }
+    // the parent's transform has to come from its own cache, so it's dropped along with this one
+    SpatiallyNestablePointer parent = _parent.lock();
+    return parent && parent->_worldTransformCacheVersion == parent->_worldTransformVersion;
+}
+
+void SpatiallyNestable::worldTransformChanged(int depth) {
+    if (depth > MAX_PARENTING_CHAIN_SIZE) {
+        return;
+    }
+    ++_worldTransformVersion;
+    if (batchedTransformUpdates && !_isWorldTransformQueued.exchange(true)) {
+        std::lock_guard<std::mutex> lock(changedTransformsMutex);
+        changedTransforms.insert(this);
+    }
+    forEachChild([&](const SpatiallyNestablePointer& child) {
+        child->worldTransformChanged(depth + 1);
+    });
+}
+
+void SpatiallyNestable::setBatchedTransformUpdates(bool enabled) {
+    std::lock_guard<std::mutex> lock(changedTransformsMutex);
+    batchedTransformUpdates = enabled;
+    for (auto nestable : changedTransforms) {
+        nestable->_isWorldTransformQueued = false;
+    }
+    changedTransforms.clear();
+}
+
+void SpatiallyNestable::updateWorldTransforms() {
+    PROFILE_RANGE(simulation, "WorldTransforms");
+    std::vector<std::pair<int, SpatiallyNestablePointer>> changed;
+    {
+        std::lock_guard<std::mutex> lock(changedTransformsMutex);
+        changed.reserve(changedTransforms.size());
+        for (auto nestable : changedTransforms) {
+            nestable->_isWorldTransformQueued = false;
+            try {
+                // a nestable on its way out hasn't taken itself off the list yet
+                changed.emplace_back(0, nestable->getThisPointer());
+            } catch (const std::bad_weak_ptr&) {
+            }
+        }
+        changedTransforms.clear();
+    }
+
+    // parents before children, so each only has to look one level up for its parent's transform
+    for (auto& entry : changed) {
+        int depth = 0;
+        for (auto parent = entry.second->_parent.lock(); parent && depth < MAX_PARENTING_CHAIN_SIZE;
+                parent = parent->_parent.lock()) {
+            ++depth;
+        }
+        entry.first = depth;
+    }
+    std::sort(changed.begin(), changed.end(), [](const std::pair<int, SpatiallyNestablePointer>& a,
+                                                 const std::pair<int, SpatiallyNestablePointer>& b) {
+        return a.first < b.first;
+    });
+
+    // the nestables at each depth are independent of each other
+    auto levelBegin = changed.begin();
+    while (levelBegin != changed.end()) {
+        int depth = levelBegin->first;
+        auto levelEnd = std::find_if(levelBegin, changed.end(), [&](const std::pair<int, SpatiallyNestablePointer>& entry) {
+            return entry.first != depth;
+        });
+        tbb::parallel_for(tbb::blocked_range<size_t>(levelBegin - changed.begin(), levelEnd - changed.begin()),
+            [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i < range.end(); ++i) {
+                    bool success;
+                    changed[i].second->getTransform(success);
+                }
+            });
+        levelBegin = levelEnd;
+    }
+}
+
 const Transform SpatiallyNestable::getTransform() const {
     bool success;
     Transform result = getTransform(success);
@@ -820,6 +957,7 @@ void SpatiallyNestable::setTransform(const Transform& transform, bool& success)
             }
         });
         if (changed) {
+            worldTransformChanged();
             locationChanged();
         }
     }
@@ -874,6 +1012,9 @@ void SpatiallyNestable::setSNScale(const glm::vec3& scale, bool& success) {
             _scaleChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        worldTransformChanged();
+    }
     if (success && changed) {
         dimensionsChanged();
     }
@@ -906,6 +1047,7 @@ void SpatiallyNestable::setLocalTransform(const Transform& transform) {
     });
 
     if (changed) {
+        worldTransformChanged();
         locationChanged();
     }
 }
@@ -933,6 +1075,7 @@ void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhy
         }
     });
     if (changed) {
+        worldTransformChanged();
         locationChanged(tellPhysics);
     }
 }
@@ -960,6 +1103,7 @@ void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
         }
     });
     if (changed) {
+        worldTransformChanged();
         locationChanged();
     }
 }
@@ -1016,6 +1160,7 @@ void SpatiallyNestable::setLocalSNScale(const glm::vec3& scale) {
         }
     });
     if (changed) {
+        worldTransformChanged();
         dimensionsChanged();
     }
 }
@@ -1332,6 +1477,7 @@ void SpatiallyNestable::setLocalTransformAndVelocities(
     });
 
     if (changed) {
+        worldTransformChanged();
         locationChanged(false);
     }
 }
@@ -88,6 +88,12 @@ public:
 
     virtual Transform getParentTransform(bool& success, int depth = 0) const;
 
+    // World transforms are cached until this or an ancestor moves.  With batched updates on, the nestables that moved
+    // are collected and updateWorldTransforms() recomputes them once per frame, parents before children, on the
+    // worker threads, rather than each on its first getTransform().
+    static void setBatchedTransformUpdates(bool enabled);
+    static void updateWorldTransforms();
+
     void setWorldTransform(const glm::vec3& position, const glm::quat& orientation);
     virtual glm::vec3 getWorldPosition(bool& success) const;
     virtual glm::vec3 getWorldPosition() const;
@@ -264,7 +270,14 @@ private:
     bool _isDead { false };
     bool _queryAACubeIsPuffed { false };
 
+    mutable Transform _worldTransformCache;
+    mutable std::atomic<uint32_t> _worldTransformCacheVersion { 0 }; // the cache is valid when this matches
+    std::atomic<uint32_t> _worldTransformVersion { 1 };
+    std::atomic<bool> _isWorldTransformQueued { false }; // for updateWorldTransforms()
+
     void breakParentingLoop() const;
+    bool canCacheWorldTransform() const;
+    void worldTransformChanged(int depth = 0);
 };
 
 
@@ -0,0 +1,153 @@
+//
+//  TimerWheel.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <limits>
+
+TimerWheel::TimerID TimerWheel::add(uint64_t now, uint32_t interval, bool repeating) {
+    if (_timers.empty() && now > _currentTick) {
+        // nothing to expire in between, so skip straight there
+        _currentTick = now;
+    }
+
+    TimerID id = _nextID;
+    while (id == INVALID_TIMER_ID || contains(id)) {
+        ++id;
+    }
+    _nextID = id + 1;
+
+    // a repeating timer needs to move forward each time it fires
+    if (repeating && interval == 0) {
+        interval = 1;
+    }
+
+    uint64_t deadline = std::max(now, _currentTick) + interval;
+    _timers[id] = { deadline, interval, repeating };
+    // due now or in the past: the next tick is the soonest it can fire
+    schedule(id, std::max(deadline, _currentTick + 1));
+    return id;
+}
+
+bool TimerWheel::remove(TimerID id) {
+    return _timers.erase(id) > 0;
+}
+
+void TimerWheel::clear() {
+    for (auto& level : _levels) {
+        for (auto& slot : level) {
+            slot.clear();
+        }
+    }
+    _overflow.clear();
+    _timers.clear();
+}
+
+void TimerWheel::schedule(TimerID id, uint64_t deadline) {
+    // file it in the lowest level where the deadline and the current tick only differ in that level's bits,
+    // so the slot is reached exactly when the deadline's bits for every level above it are current
+    uint64_t differentBits = deadline ^ _currentTick;
+    for (int level = 0; level < NUM_LEVELS; ++level) {
+        if ((differentBits >> (LEVEL_BITS * (level + 1))) == 0) {
+            int index = (int)((deadline >> (LEVEL_BITS * level)) & (SLOTS_PER_LEVEL - 1));
+            _levels[level][index].push_back(id);
+            return;
+        }
+    }
+    _overflow.push_back(id);
+}
+
+void TimerWheel::cascade(int level, uint64_t tick) {
+    Slot timers;
+    if (level == NUM_LEVELS) {
+        timers.swap(_overflow);
+    } else {
+        int index = (int)((tick >> (LEVEL_BITS * level)) & (SLOTS_PER_LEVEL - 1));
+        timers.swap(_levels[level][index]);
+    }
+
+    for (auto id : timers) {
+        auto itr = _timers.find(id);
+        if (itr != _timers.end()) {
+            // a timer that was due when it was added was filed for the tick after, which may be this one
+            schedule(id, std::max(itr->second.deadline, tick));
+        }
+    }
+}
+
+uint64_t TimerWheel::timeUntilNextExpiry(uint64_t now) const {
+    if (_timers.empty()) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+
+    // level 0 only holds the ticks left in its current revolution, the levels above cascade when it wraps
+    uint64_t lastTick = _currentTick | (SLOTS_PER_LEVEL - 1);
+    uint64_t tick = _currentTick + 1;
+    for (; tick <= lastTick; ++tick) {
+        const auto& slot = _levels[0][tick & (SLOTS_PER_LEVEL - 1)];
+        bool isLive = std::any_of(slot.begin(), slot.end(), [this](TimerID id) { return contains(id); });
+        if (isLive) {
+            break;
+        }
+    }
+    return tick > now ? tick - now : 0;
+}
+
+void TimerWheel::advance(uint64_t now, std::vector<Expired>& expired) {
+    size_t firstExpired = expired.size();
+
+    while (_currentTick < now) {
+        if (_timers.empty()) {
+            _currentTick = now;
+            break;
+        }
+
+        uint64_t tick = ++_currentTick;
+
+        // when a level wraps, the next slot of the level above it comes due and moves down
+        int wrappedLevels = 0;
+        while (wrappedLevels < NUM_LEVELS && (tick & ((1ULL << (LEVEL_BITS * (wrappedLevels + 1))) - 1)) == 0) {
+            ++wrappedLevels;
+        }
+        for (int level = wrappedLevels; level > 0; --level) {
+            cascade(level, tick);
+        }
+
+        auto& slot = _levels[0][tick & (SLOTS_PER_LEVEL - 1)];
+        for (auto id : slot) {
+            auto itr = _timers.find(id);
+            if (itr != _timers.end()) {
+                expired.push_back({ id, itr->second.deadline, itr->second.repeating });
+            }
+        }
+        slot.clear();
+    }
+
+    // the ids in a slot are in the order they were filed, sort so timers fire in deadline then creation order
+    std::sort(expired.begin() + firstExpired, expired.end(), [](const Expired& a, const Expired& b) {
+        return a.deadline < b.deadline || (a.deadline == b.deadline && a.id < b.id);
+    });
+
+    for (auto itr = expired.begin() + firstExpired; itr != expired.end(); ++itr) {
+        auto timer = _timers.find(itr->id);
+        if (!itr->repeating) {
+            _timers.erase(timer);
+            continue;
+        }
+
+        // keep the original phase, but skip the beats that were missed
+        uint64_t deadline = timer->second.deadline;
+        uint64_t interval = timer->second.interval;
+        deadline += interval * ((now - deadline) / interval + 1);
+        timer->second.deadline = deadline;
+        schedule(itr->id, std::max(deadline, _currentTick + 1));
+    }
+}
@@ -0,0 +1,87 @@
+//
+//  TimerWheel.h
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_TimerWheel_h
+#define hifi_TimerWheel_h
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Hierarchical timer wheel with millisecond ticks.
+//
+// Timers are filed in the slot of the wheel level that matches how far away they are: level 0 has a slot for
+// each of the next 256 ms, level 1 a slot for each of the next 256 level 0 revolutions, and so on.  Adding and
+// removing a timer is O(1), and advancing the wheel only touches the slots that have come due, cascading the
+// timers of a higher level slot down a level when the level below it wraps.  The wheel doesn't run callbacks:
+// advance() hands back the expired timers so the owner can dispatch them as one batch.
+//
+// Not thread safe, the owner drives it from one thread.
+class TimerWheel {
+public:
+    using TimerID = uint32_t;
+    static const TimerID INVALID_TIMER_ID = 0;
+
+    struct Expired {
+        TimerID id;
+        uint64_t deadline; // msecs
+        bool repeating;
+    };
+
+    /// \param now msecs, from a monotonic clock
+    explicit TimerWheel(uint64_t now = 0) : _currentTick(now) {}
+
+    /// \brief start a timer that expires interval msecs from now, and every interval msecs after that if repeating
+    TimerID add(uint64_t now, uint32_t interval, bool repeating);
+    /// \return false if the timer has already expired (and wasn't repeating) or was removed
+    bool remove(TimerID id);
+    bool contains(TimerID id) const { return _timers.find(id) != _timers.end(); }
+
+    /// \brief move the wheel up to now, appending the timers that expired in deadline order.  Repeating timers are
+    /// rearmed for their next deadline after now, so a late dispatch doesn't cause a burst of catch up calls.
+    void advance(uint64_t now, std::vector<Expired>& expired);
+
+    /// \return msecs from now until the next timer may expire: exact for timers due within the current level 0
+    /// revolution, otherwise the time until it wraps, so an owner that sleeps this long and advances never fires late
+    uint64_t timeUntilNextExpiry(uint64_t now) const;
+
+    size_t size() const { return _timers.size(); }
+    bool empty() const { return _timers.empty(); }
+    void clear();
+
+private:
+    static const int LEVEL_BITS = 8;
+    static const int SLOTS_PER_LEVEL = 1 << LEVEL_BITS;
+    static const int NUM_LEVELS = 4;
+
+    struct Timer {
+        uint64_t deadline;
+        uint32_t interval;
+        bool repeating;
+    };
+
+    using Slot = std::vector<TimerID>;
+
+    void schedule(TimerID id, uint64_t deadline);
+    void cascade(int level, uint64_t tick);
+
+    std::array<std::array<Slot, SLOTS_PER_LEVEL>, NUM_LEVELS> _levels;
+    Slot _overflow; // deadlines past the last level's revolution
+
+    // removed timers are dropped from here and skipped when their slot comes up
+    std::unordered_map<TimerID, Timer> _timers;
+    uint64_t _currentTick; // last tick advanced to
+    TimerID _nextID { 1 };
+};
+
+#endif // hifi_TimerWheel_h
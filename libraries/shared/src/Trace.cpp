@@ -31,6 +31,7 @@
 #include "Gzip.h"
 #include "PortableHighResolutionClock.h"
 #include "SharedLogging.h"
+#include "TraceRecorder.h"
 #include "shared/FileUtils.h"
 #include "shared/GlobalAppProperties.h"
 
@@ -49,6 +50,15 @@ void Tracer::startTracing() {
 
     _events.clear();
     _enabled = true;
+
+    if (TraceRecorder::isRecording()) {
+        qWarning() << "Trace recording already in progress, only events with extra args will be traced";
+        return;
+    }
+    QString recordingFile = QDir::temp().filePath(QString("hifi-trace-%1.hftrace").arg(QCoreApplication::applicationPid()));
+    if (TraceRecorder::start(recordingFile)) {
+        _tracingRecordingFile = recordingFile;
+    }
 }
 
 void Tracer::stopTracing() {
@@ -58,6 +68,28 @@ void Tracer::stopTracing() {
         return;
     }
     _enabled = false;
+
+    if (!_tracingRecordingFile.isEmpty()) {
+        TraceRecorder::stop();
+    }
+}
+
+bool Tracer::startRecording(const QString& filename) {
+    QString fullPath = FileUtils::replaceDateTimeTokens(filename);
+    fullPath = FileUtils::computeDocumentPath(fullPath);
+    if (!TraceRecorder::start(fullPath)) {
+        return false;
+    }
+    qDebug(shared) << "Recording trace to" << fullPath;
+    return true;
+}
+
+void Tracer::stopRecording() {
+    if (_enabled && !_tracingRecordingFile.isEmpty()) {
+        qWarning() << "Cannot stop recording while tracing, use stopTracing";
+        return;
+    }
+    TraceRecorder::stop();
 }
 
 void TraceEvent::writeJson(QTextStream& out) const {
@@ -113,12 +145,19 @@ void Tracer::serialize(const QString& filename) {
     }
 
     std::list<TraceEvent> currentEvents;
+    QString recordingFile;
     {
         std::lock_guard<std::mutex> guard(_eventsMutex);
         currentEvents.swap(_events);
         for (auto& event : _metadataEvents) {
             currentEvents.push_back(event);
         }
+        if (!_enabled) {
+            recordingFile.swap(_tracingRecordingFile);
+        } else if (!_tracingRecordingFile.isEmpty()) {
+            TraceRecorder::flush();
+            recordingFile = _tracingRecordingFile;
+        }
     }
 
     // If we can't open a temp file for writing, fail early
@@ -135,9 +174,16 @@ void Tracer::serialize(const QString& filename) {
             }
             event.writeJson(out);
         }
+        if (!recordingFile.isEmpty()) {
+            TraceRecorder::writeChromeTraceEvents(recordingFile, out, first);
+        }
         out << "\n]";
     }
 
+    if (!recordingFile.isEmpty() && !_enabled) {
+        QFile::remove(recordingFile);
+    }
+
     if (fullPath.endsWith(".gz")) {
         QByteArray compressed;
         gzip(data, compressed);
@@ -180,6 +226,73 @@ int64_t Tracer::now() {
     return std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
 }
 
+static bool isNumber(const QVariant& value) {
+    switch (value.userType()) {
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::Long:
+        case QMetaType::ULong:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Short:
+        case QMetaType::UShort:
+        case QMetaType::Float:
+        case QMetaType::Double:
+        case QMetaType::Bool:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// true if the event loses nothing when recorded as a TraceRecord
+static bool isCompact(EventType type, const QVariantMap& args, const QVariantMap& extra) {
+    for (auto it = extra.begin(); it != extra.end(); it++) {
+        if (type != Instant || it.key() != "s") {
+            return false;
+        }
+    }
+    if (type == Counter) {
+        for (auto it = args.begin(); it != args.end(); it++) {
+            if (!isNumber(it.value())) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return args.empty() || (type == DurationBegin && args.size() == 1 && args.contains("nv_payload"));
+}
+
+void Tracer::recordEvent(const QLoggingCategory& category,
+    const QString& name, EventType type, int64_t timestamp,
+    const QString& id, const QVariantMap& args, const QVariantMap& extra) {
+    uint32_t nameID = TraceRecorder::internName(name);
+    if (type == Counter) {
+        for (auto it = args.begin(); it != args.end(); it++) {
+            if (isNumber(it.value())) {
+                TraceRecorder::recordCounter(category, nameID, TraceRecorder::internName(it.key()), timestamp, it.value().toDouble());
+            }
+        }
+        return;
+    }
+
+    if (type == DurationBegin) {
+        TraceRecorder::record(category, nameID, type, timestamp, args.value("nv_payload").toULongLong(), TraceRecorder::internName(id));
+    } else if (type == Instant) {
+        QString scope = extra.value("s").toString();
+        TraceRecorder::record(category, nameID, type, timestamp, scope.isEmpty() ? 't' : scope[0].toLatin1());
+    } else {
+        // async ids are usually request numbers, which would grow the name table without bound
+        bool isNumericID = false;
+        uint64_t numericID = id.toULongLong(&isNumericID);
+        if (isNumericID) {
+            TraceRecorder::record(category, nameID, type, timestamp, numericID, 0, TraceRecord::NumericID);
+        } else {
+            TraceRecorder::record(category, nameID, type, timestamp, 0, TraceRecorder::internName(id));
+        }
+    }
+}
+
 void Tracer::traceEvent(const QLoggingCategory& category,
     const QString& name, EventType type,
     qint64 timestamp, qint64 processID, qint64 threadID,
@@ -226,7 +339,7 @@ void Tracer::traceEvent(const QLoggingCategory& category,
 void Tracer::traceEvent(const QLoggingCategory& category, 
     const QString& name, EventType type, const QString& id, 
     const QVariantMap& args, const QVariantMap& extra) {
-    if (!_enabled && type != Metadata) {
+    if (!_enabled && type != Metadata && !TraceRecorder::isRecording()) {
         return;
     }
 
@@ -236,7 +349,15 @@ void Tracer::traceEvent(const QLoggingCategory& category,
 void Tracer::traceEvent(const QLoggingCategory& category, 
     const QString& name, EventType type, int64_t timestamp, const QString& id, 
     const QVariantMap& args, const QVariantMap& extra) {
-    if (!_enabled && type != Metadata) {
+    if (type == Metadata) {
+        if (name == "thread_name") {
+            TraceRecorder::setThreadName(args.value("name").toString());
+        }
+    } else if (TraceRecorder::isRecording() && (!_enabled || isCompact(type, args, extra))) {
+        // when only recording, richer events are recorded without their extra args
+        recordEvent(category, name, type, timestamp, id, args, extra);
+        return;
+    } else if (!_enabled) {
         return;
     }
 
@@ -95,7 +95,16 @@ public:
     void serialize(const QString& file);
     bool isEnabled() const { return _enabled; }
 
+    // Continuous, low overhead tracing to a binary recording, see TraceRecorder.  Only event names, categories,
+    // ids, range payloads and numeric counter values are kept; convert the file with TraceRecorder::exportChromeTrace.
+    bool startRecording(const QString& file);
+    void stopRecording();
+
 private:
+    void recordEvent(const QLoggingCategory& category,
+        const QString& name, EventType type, int64_t timestamp,
+        const QString& id, const QVariantMap& args, const QVariantMap& extra);
+
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
         qint64 timestamp, qint64 processID, qint64 threadID,
@@ -103,6 +112,8 @@ private:
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
     bool _enabled { false };
+    // while tracing, the events that fit in a TraceRecorder are recorded here rather than kept in _events
+    QString _tracingRecordingFile;
     std::list<TraceEvent> _events;
     std::list<TraceEvent> _metadataEvents;
     std::mutex _eventsMutex;
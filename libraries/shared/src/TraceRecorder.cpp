@@ -0,0 +1,581 @@
+//
+//  TraceRecorder.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QThread>
+
+#include "Gzip.h"
+#include "SharedLogging.h"
+#include "shared/FileUtils.h"
+
+using namespace tracing;
+
+std::atomic<bool> TraceRecorder::_recording { false };
+
+namespace {
+
+// A recording is a header followed by chunks.  Chunks are appended as the buffers are drained, so a recording
+// cut short by a crash is still readable up to its last complete chunk.
+const char RECORDING_MAGIC[4] = { 'H', 'F', 'T', 'R' };
+const uint32_t RECORDING_VERSION = 1;
+
+struct RecordingHeader {
+    char magic[4];
+    uint32_t version;
+    int64_t processID;
+};
+
+enum ChunkType : uint32_t {
+    NameChunk = 'N',        // uint32_t id, utf8 name
+    ThreadNameChunk = 'T',  // int64_t thread id, utf8 name
+    EventChunk = 'E'        // int64_t thread id, TraceRecord[]
+};
+
+struct ChunkHeader {
+    uint32_t type;
+    uint32_t size; // bytes following the chunk header
+};
+
+// Each thread caches the ids of the names it records, to skip the shared name table's lock.  Names built at runtime,
+// e.g. per node counters, would grow the caches without bound, so a cache is cleared when it fills up and when a new
+// recording starts.
+const int MAX_CACHED_NAMES_PER_THREAD = 1024;
+std::atomic<uint32_t> nameCacheGeneration { 0 };
+
+template <typename Cache>
+void trimNameCache(Cache& nameIDs, uint32_t& generation) {
+    auto currentGeneration = nameCacheGeneration.load(std::memory_order_relaxed);
+    if (generation != currentGeneration || (int)nameIDs.size() >= MAX_CACHED_NAMES_PER_THREAD) {
+        nameIDs.clear();
+        generation = currentGeneration;
+    }
+}
+
+// must be a power of two: 8192 events is 256KB for each thread that records
+const size_t BUFFER_CAPACITY = 8192;
+const auto FLUSH_INTERVAL = std::chrono::milliseconds(50);
+
+// Single producer / single consumer ring of events.  Only the thread that owns the buffer pushes,
+// and only the thread holding the recorder's file lock drains.
+class TraceBuffer {
+public:
+    TraceBuffer(int64_t threadID) : _threadID(threadID), _records(BUFFER_CAPACITY) {}
+
+    void push(const TraceRecord& record) {
+        uint64_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= BUFFER_CAPACITY) {
+            _numDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        _records[head & (BUFFER_CAPACITY - 1)] = record;
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    // visitor(records, count) is called with up to two contiguous runs of events, oldest first
+    template <typename Visitor>
+    void drain(Visitor visitor) {
+        uint64_t tail = _tail.load(std::memory_order_relaxed);
+        uint64_t head = _head.load(std::memory_order_acquire);
+        if (head == tail) {
+            return;
+        }
+        size_t start = tail & (BUFFER_CAPACITY - 1);
+        size_t count = head - tail;
+        size_t firstRun = std::min(count, BUFFER_CAPACITY - start);
+        visitor(&_records[start], firstRun);
+        if (firstRun < count) {
+            visitor(&_records[0], count - firstRun);
+        }
+        _tail.store(head, std::memory_order_release);
+    }
+
+    int64_t getThreadID() const { return _threadID; }
+    bool isEmpty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_relaxed); }
+    uint64_t getNumDropped() const { return _numDropped.load(std::memory_order_relaxed); }
+
+    void retire() { _retired.store(true, std::memory_order_release); }
+    bool isRetired() const { return _retired.load(std::memory_order_acquire); }
+
+private:
+    const int64_t _threadID;
+    std::vector<TraceRecord> _records;
+    std::atomic<uint64_t> _head { 0 };
+    std::atomic<uint64_t> _tail { 0 };
+    std::atomic<uint64_t> _numDropped { 0 };
+    std::atomic<bool> _retired { false };
+};
+
+struct Recorder {
+    ~Recorder();
+
+    std::mutex namesMutex;
+    QHash<QByteArray, uint32_t> nameIDs;
+    std::vector<QByteArray> names; // the name with id N is names[N - 1]
+    std::vector<std::pair<int64_t, QByteArray>> threadNames;
+
+    std::mutex buffersMutex;
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    uint64_t numDroppedByExitedThreads { 0 };
+
+    // held while draining buffers and writing
+    std::mutex fileMutex;
+    QFile file;
+    size_t numNamesWritten { 0 };
+    size_t numThreadNamesWritten { 0 };
+
+    std::mutex flushMutex;
+    std::condition_variable flushCondition;
+    bool stopFlushing { false };
+    std::thread flushThread;
+};
+
+Recorder& recorder() {
+    static Recorder instance;
+    return instance;
+}
+
+// The calling thread's buffer.  It is retired when the thread exits, and released once it has been drained.
+struct ThreadBuffer {
+    ~ThreadBuffer() {
+        if (buffer) {
+            buffer->retire();
+        }
+    }
+    std::shared_ptr<TraceBuffer> buffer;
+};
+thread_local ThreadBuffer threadBuffer;
+
+TraceBuffer& getThreadBuffer() {
+    if (!threadBuffer.buffer) {
+        threadBuffer.buffer = std::make_shared<TraceBuffer>(int64_t(QThread::currentThreadId()));
+        auto& r = recorder();
+        std::lock_guard<std::mutex> lock(r.buffersMutex);
+        r.buffers.push_back(threadBuffer.buffer);
+    }
+    return *threadBuffer.buffer;
+}
+
+uint32_t internUtf8(const QByteArray& name) {
+    auto& r = recorder();
+    std::lock_guard<std::mutex> lock(r.namesMutex);
+    auto itr = r.nameIDs.constFind(name);
+    if (itr != r.nameIDs.constEnd()) {
+        return itr.value();
+    }
+    r.names.push_back(name);
+    uint32_t id = (uint32_t)r.names.size();
+    r.nameIDs.insert(name, id);
+    return id;
+}
+
+uint32_t internCategory(const QLoggingCategory& category) {
+    thread_local std::unordered_map<const QLoggingCategory*, uint32_t> categoryIDs;
+    auto itr = categoryIDs.find(&category);
+    if (itr != categoryIDs.end()) {
+        return itr->second;
+    }
+    uint32_t id = internUtf8(QByteArray(category.categoryName()));
+    categoryIDs[&category] = id;
+    return id;
+}
+
+void writeChunk(QFile& file, ChunkType type, const void* prefix, size_t prefixSize, const void* data, size_t size) {
+    ChunkHeader header { type, (uint32_t)(prefixSize + size) };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(static_cast<const char*>(prefix), prefixSize);
+    file.write(static_cast<const char*>(data), size);
+}
+
+// the caller holds fileMutex
+void flushBuffers(Recorder& r) {
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(r.buffersMutex);
+        buffers = r.buffers;
+    }
+
+    for (const auto& buffer : buffers) {
+        int64_t threadID = buffer->getThreadID();
+        buffer->drain([&](const TraceRecord* records, size_t count) {
+            writeChunk(r.file, EventChunk, &threadID, sizeof(threadID), records, count * sizeof(TraceRecord));
+        });
+    }
+
+    {
+        // a thread can't record anything more once it has exited, so its buffer can go once it is drained
+        std::lock_guard<std::mutex> lock(r.buffersMutex);
+        auto newEnd = std::remove_if(r.buffers.begin(), r.buffers.end(), [&](const std::shared_ptr<TraceBuffer>& buffer) {
+            if (buffer->isRetired() && buffer->isEmpty()) {
+                r.numDroppedByExitedThreads += buffer->getNumDropped();
+                return true;
+            }
+            return false;
+        });
+        r.buffers.erase(newEnd, r.buffers.end());
+    }
+
+    // names go after the events, since the events just drained may use names interned after they were recorded
+    std::vector<QByteArray> newNames;
+    std::vector<std::pair<int64_t, QByteArray>> newThreadNames;
+    {
+        std::lock_guard<std::mutex> lock(r.namesMutex);
+        newNames.assign(r.names.begin() + r.numNamesWritten, r.names.end());
+        newThreadNames.assign(r.threadNames.begin() + r.numThreadNamesWritten, r.threadNames.end());
+    }
+    for (const auto& name : newNames) {
+        uint32_t id = (uint32_t)(++r.numNamesWritten);
+        writeChunk(r.file, NameChunk, &id, sizeof(id), name.constData(), name.size());
+    }
+    for (const auto& threadName : newThreadNames) {
+        writeChunk(r.file, ThreadNameChunk, &threadName.first, sizeof(threadName.first),
+            threadName.second.constData(), threadName.second.size());
+    }
+    r.numThreadNamesWritten += newThreadNames.size();
+
+    r.file.flush();
+}
+
+Recorder::~Recorder() {
+    // still recording at exit: keep what was recorded and don't leave the flush thread running
+    if (flushThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(flushMutex);
+            stopFlushing = true;
+        }
+        flushCondition.notify_one();
+        flushThread.join();
+
+        std::lock_guard<std::mutex> lock(fileMutex);
+        flushBuffers(*this);
+        file.close();
+    }
+}
+
+void flushLoop(Recorder& r) {
+    std::unique_lock<std::mutex> lock(r.flushMutex);
+    while (!r.stopFlushing) {
+        r.flushCondition.wait_for(lock, FLUSH_INTERVAL);
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> fileLock(r.fileMutex);
+            if (r.file.isOpen()) {
+                flushBuffers(r);
+            }
+        }
+        lock.lock();
+    }
+}
+
+QString toJsonString(const QByteArray& utf8) {
+    QString result = "\"";
+    for (const QChar& c : QString::fromUtf8(utf8)) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if (c.unicode() < 0x20) {
+            result += QString("\\u%1").arg(c.unicode(), 4, 16, QChar('0'));
+        } else {
+            result += c;
+        }
+    }
+    result += '"';
+    return result;
+}
+
+}
+
+bool TraceRecorder::start(const QString& filename) {
+    if (isRecording()) {
+        qCWarning(shared) << "Tried to start trace recording, but already recording";
+        return false;
+    }
+
+    auto& r = recorder();
+    {
+        std::lock_guard<std::mutex> lock(r.fileMutex);
+        if (!FileUtils::canCreateFile(filename)) {
+            return false;
+        }
+        r.file.setFileName(filename);
+        if (!r.file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCWarning(shared) << "Unable to open trace recording" << filename;
+            return false;
+        }
+
+        RecordingHeader header;
+        memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+        header.version = RECORDING_VERSION;
+        header.processID = QCoreApplication::applicationPid();
+        r.file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        // anything still buffered was recorded after an earlier recording stopped
+        std::lock_guard<std::mutex> buffersLock(r.buffersMutex);
+        for (const auto& buffer : r.buffers) {
+            buffer->drain([](const TraceRecord* records, size_t count) {});
+        }
+        r.numNamesWritten = 0;
+        r.numThreadNamesWritten = 0;
+    }
+    nameCacheGeneration.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(r.flushMutex);
+        r.stopFlushing = false;
+    }
+    _recording.store(true);
+    r.flushThread = std::thread([&r] { flushLoop(r); });
+    return true;
+}
+
+void TraceRecorder::stop() {
+    if (!_recording.exchange(false)) {
+        return;
+    }
+
+    auto& r = recorder();
+    {
+        std::lock_guard<std::mutex> lock(r.flushMutex);
+        r.stopFlushing = true;
+    }
+    r.flushCondition.notify_one();
+    r.flushThread.join();
+
+    {
+        std::lock_guard<std::mutex> lock(r.fileMutex);
+        flushBuffers(r);
+        r.file.close();
+    }
+
+    auto numDropped = getNumDroppedEvents();
+    if (numDropped > 0) {
+        qCWarning(shared) << "Trace recording has dropped" << numDropped << "events since startup";
+    }
+}
+
+void TraceRecorder::flush() {
+    auto& r = recorder();
+    std::lock_guard<std::mutex> lock(r.fileMutex);
+    if (r.file.isOpen()) {
+        flushBuffers(r);
+    }
+}
+
+uint32_t TraceRecorder::internName(const QString& name) {
+    if (name.isEmpty()) {
+        return 0;
+    }
+    thread_local QHash<QString, uint32_t> nameIDs;
+    thread_local uint32_t generation { 0 };
+    auto itr = nameIDs.constFind(name);
+    if (itr != nameIDs.constEnd()) {
+        return itr.value();
+    }
+    uint32_t id = internUtf8(name.toUtf8());
+    trimNameCache(nameIDs, generation);
+    nameIDs.insert(name, id);
+    return id;
+}
+
+uint32_t TraceRecorder::internName(const char* name) {
+    if (!name || !name[0]) {
+        return 0;
+    }
+    // the pointer is almost always a string literal, but check the text in case the memory has been reused
+    thread_local std::unordered_map<const char*, std::pair<QByteArray, uint32_t>> nameIDs;
+    thread_local uint32_t generation { 0 };
+    auto itr = nameIDs.find(name);
+    if (itr != nameIDs.end() && strcmp(itr->second.first.constData(), name) == 0) {
+        return itr->second.second;
+    }
+    QByteArray utf8(name);
+    uint32_t id = internUtf8(utf8);
+    trimNameCache(nameIDs, generation);
+    nameIDs[name] = { utf8, id };
+    return id;
+}
+
+void TraceRecorder::record(const QLoggingCategory& category, uint32_t nameID, EventType type, int64_t timestamp,
+        uint64_t value, uint32_t argID, uint8_t flags) {
+    TraceRecord record;
+    record.timestamp = timestamp;
+    record.value = value;
+    record.nameID = nameID;
+    record.argID = argID;
+    record.categoryID = internCategory(category);
+    record.type = type;
+    record.flags = flags;
+    memset(record.reserved, 0, sizeof(record.reserved));
+    getThreadBuffer().push(record);
+}
+
+void TraceRecorder::recordCounter(const QLoggingCategory& category, uint32_t nameID, uint32_t seriesID,
+        int64_t timestamp, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    record(category, nameID, Counter, timestamp, bits, seriesID);
+}
+
+void TraceRecorder::setThreadName(const QString& name) {
+    auto& r = recorder();
+    std::lock_guard<std::mutex> lock(r.namesMutex);
+    r.threadNames.emplace_back(int64_t(QThread::currentThreadId()), name.toUtf8());
+}
+
+uint64_t TraceRecorder::getNumDroppedEvents() {
+    auto& r = recorder();
+    std::lock_guard<std::mutex> lock(r.buffersMutex);
+    uint64_t numDropped = r.numDroppedByExitedThreads;
+    for (const auto& buffer : r.buffers) {
+        numDropped += buffer->getNumDropped();
+    }
+    return numDropped;
+}
+
+bool TraceRecorder::writeChromeTraceEvents(const QString& recordingFile, QTextStream& out, bool& first) {
+    QFile file(recordingFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(shared) << "Unable to open trace recording" << recordingFile;
+        return false;
+    }
+    QByteArray data = file.readAll();
+    file.close();
+
+    RecordingHeader header;
+    if (data.size() < (int)sizeof(header)) {
+        qCWarning(shared) << "Trace recording" << recordingFile << "is truncated";
+        return false;
+    }
+    memcpy(&header, data.constData(), sizeof(header));
+    if (memcmp(header.magic, RECORDING_MAGIC, sizeof(header.magic)) != 0 || header.version != RECORDING_VERSION) {
+        qCWarning(shared) << recordingFile << "is not a supported trace recording";
+        return false;
+    }
+
+    // names can come after the events that use them, so gather everything before writing
+    QHash<uint32_t, QString> names;
+    std::vector<std::pair<int64_t, QString>> threadNames;
+    std::vector<std::pair<int64_t, TraceRecord>> events;
+    int offset = sizeof(header);
+    while (offset + (int)sizeof(ChunkHeader) <= data.size()) {
+        ChunkHeader chunk;
+        memcpy(&chunk, data.constData() + offset, sizeof(chunk));
+        offset += sizeof(chunk);
+        if (chunk.size > (uint32_t)(data.size() - offset)) {
+            // the last chunk of a recording that didn't stop cleanly
+            break;
+        }
+        const char* body = data.constData() + offset;
+        if (chunk.type == NameChunk && chunk.size >= sizeof(uint32_t)) {
+            uint32_t id;
+            memcpy(&id, body, sizeof(id));
+            names[id] = toJsonString(QByteArray(body + sizeof(id), chunk.size - sizeof(id)));
+        } else if (chunk.type == ThreadNameChunk && chunk.size >= sizeof(int64_t)) {
+            int64_t threadID;
+            memcpy(&threadID, body, sizeof(threadID));
+            threadNames.emplace_back(threadID, toJsonString(QByteArray(body + sizeof(threadID), chunk.size - sizeof(threadID))));
+        } else if (chunk.type == EventChunk && chunk.size >= sizeof(int64_t)) {
+            int64_t threadID;
+            memcpy(&threadID, body, sizeof(threadID));
+            size_t numRecords = (chunk.size - sizeof(threadID)) / sizeof(TraceRecord);
+            for (size_t i = 0; i < numRecords; ++i) {
+                TraceRecord record;
+                memcpy(&record, body + sizeof(threadID) + i * sizeof(TraceRecord), sizeof(record));
+                events.emplace_back(threadID, record);
+            }
+        }
+        offset += chunk.size;
+    }
+
+    const QString EMPTY_NAME = "\"\"";
+    auto separate = [&] {
+        if (first) {
+            first = false;
+        } else {
+            out << ",\n";
+        }
+    };
+
+    for (const auto& threadName : threadNames) {
+        separate();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << header.processID << ",\"tid\":" << threadName.first
+            << ",\"args\":{\"name\":" << threadName.second << "}}";
+    }
+
+    for (const auto& event : events) {
+        const TraceRecord& record = event.second;
+        separate();
+        out << "{\"name\":" << names.value(record.nameID, EMPTY_NAME)
+            << ",\"cat\":" << names.value(record.categoryID, EMPTY_NAME)
+            << ",\"ph\":\"" << QChar((char)record.type) << "\",\"ts\":" << record.timestamp
+            << ",\"pid\":" << header.processID << ",\"tid\":" << event.first;
+        if (record.type == Counter) {
+            double value;
+            memcpy(&value, &record.value, sizeof(value));
+            out << ",\"args\":{" << names.value(record.argID, EMPTY_NAME) << ":"
+                << QString::number(std::isfinite(value) ? value : 0.0, 'g', 12) << "}";
+        } else {
+            if (record.type == DurationBegin) {
+                out << ",\"args\":{\"nv_payload\":" << record.value << "}";
+            } else if (record.type == Instant) {
+                out << ",\"s\":\"" << QChar((char)record.value) << "\"";
+            }
+            if (record.flags & TraceRecord::NumericID) {
+                out << ",\"id\":\"" << record.value << "\"";
+            } else if (record.argID != 0) {
+                out << ",\"id\":" << names.value(record.argID, EMPTY_NAME);
+            }
+        }
+        out << "}";
+    }
+    return true;
+}
+
+bool TraceRecorder::exportChromeTrace(const QString& recordingFile, const QString& jsonFile) {
+    QByteArray data;
+    {
+        QTextStream out(&data);
+        out << "[\n";
+        bool first = true;
+        if (!writeChromeTraceEvents(recordingFile, out, first)) {
+            return false;
+        }
+        out << "\n]";
+    }
+
+    if (jsonFile.endsWith(".gz")) {
+        QByteArray compressed;
+        gzip(data, compressed);
+        data = compressed;
+    }
+
+    QFile file(jsonFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(shared) << "Unable to open" << jsonFile;
+        return false;
+    }
+    file.write(data);
+    return true;
+}
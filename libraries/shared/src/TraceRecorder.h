@@ -0,0 +1,91 @@
+//
+//  TraceRecorder.h
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_TraceRecorder_h
+#define hifi_TraceRecorder_h
+
+#include <atomic>
+#include <cstdint>
+
+#include <QtCore/QString>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QTextStream>
+
+#include "Trace.h"
+
+namespace tracing {
+
+// One compact trace event.  Names, categories and ids are interned, so a record is plain old data that can be
+// copied into a ring buffer and written to disk as is.
+struct TraceRecord {
+    int64_t timestamp;   // usecs, from Tracer::now()
+    uint64_t value;      // nv_payload of a range, bits of a double for a counter, scope of an instant,
+                         // or the id of an async event when it is a number
+    uint32_t nameID;
+    uint32_t argID;      // series name of a counter, id of an async or sync event, 0 if none
+    uint32_t categoryID;
+    EventType type;
+    uint8_t flags;
+    char reserved[2];
+
+    enum Flags : uint8_t {
+        NumericID = 0x01 // the event's id is value rather than argID
+    };
+};
+static_assert(sizeof(TraceRecord) == 32, "TraceRecord is written to disk as is");
+
+// Low overhead binary trace recording.
+//
+// Each thread that records events gets its own single producer / single consumer ring buffer, so recording an
+// event is an interned name lookup, a clock read and a copy into the buffer: no locks and no allocations.  A
+// background thread drains the buffers into a compact binary file.  Events are dropped, and counted, if a thread
+// fills its buffer faster than it is drained.  Use exportChromeTrace() to convert a recording for chrome://tracing.
+class TraceRecorder {
+public:
+    static bool isRecording() { return _recording.load(std::memory_order_relaxed); }
+
+    /// \brief start recording to a binary file, replacing it if it exists
+    /// \return false if already recording or the file can't be written
+    static bool start(const QString& filename);
+    /// \brief write everything recorded so far and close the file
+    static void stop();
+    /// \brief write everything recorded so far without stopping
+    static void flush();
+
+    /// \return id of name, 0 for an empty name
+    static uint32_t internName(const QString& name);
+    /// \return id of name, cached by pointer so string literals are only hashed once per thread
+    static uint32_t internName(const char* name);
+
+    static void record(const QLoggingCategory& category, uint32_t nameID, EventType type, int64_t timestamp,
+        uint64_t value = 0, uint32_t argID = 0, uint8_t flags = 0);
+    static void recordCounter(const QLoggingCategory& category, uint32_t nameID, uint32_t seriesID, int64_t timestamp,
+        double value);
+
+    /// \brief name the calling thread in recordings
+    static void setThreadName(const QString& name);
+
+    static uint64_t getNumDroppedEvents();
+
+    /// \brief append the events of a recording to out as Chrome trace events, separated by commas
+    /// \param first true if nothing has been written to out yet, updated as events are written
+    /// \return false if the recording can't be read
+    static bool writeChromeTraceEvents(const QString& recordingFile, QTextStream& out, bool& first);
+    /// \brief convert a recording to a Chrome trace JSON file, gzipped if jsonFile ends with .gz
+    static bool exportChromeTrace(const QString& recordingFile, const QString& jsonFile);
+
+private:
+    static std::atomic<bool> _recording;
+};
+
+}
+
+#endif // hifi_TraceRecorder_h
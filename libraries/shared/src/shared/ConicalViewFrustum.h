@@ -40,6 +40,8 @@ public:
     float getAngle() const { return _angle; }
     float getRadius() const { return _radius; }
     float getFarClip() const { return _farClip; }
+    float getSinAngle() const { return _sinAngle; }
+    float getCosAngle() const { return _cosAngle; }
 
     bool isVerySimilar(const ConicalViewFrustum& other) const;
 
@@ -0,0 +1,106 @@
+//
+//  ProxyGrid.cpp
+//  libraries/workload/src/workload
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ProxyGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace workload;
+
+// cell coordinates are packed 21 bits each into a key
+static const int32_t CELL_COORD_BITS = 21;
+static const int32_t CELL_COORD_OFFSET = 1 << (CELL_COORD_BITS - 1);
+static const int32_t CELL_COORD_MASK = (1 << CELL_COORD_BITS) - 1;
+static const float HALF_CUBE_DIAGONAL = 0.5f * sqrtf(3.0f);
+
+Sphere ProxyGrid::Cell::getBound(float cellSize) const {
+    return Sphere(center, HALF_CUBE_DIAGONAL * cellSize + maxProxyRadius);
+}
+
+ProxyGrid::CellKey ProxyGrid::computeKey(const glm::vec3& position) const {
+    CellKey key = 0;
+    for (int i = 0; i < 3; ++i) {
+        float coord = floorf(position[i] / _cellSize);
+        int32_t cell = (int32_t)glm::clamp(coord, (float)-CELL_COORD_OFFSET, (float)(CELL_COORD_OFFSET - 1));
+        key = (key << CELL_COORD_BITS) | (CellKey)((cell + CELL_COORD_OFFSET) & CELL_COORD_MASK);
+    }
+    return key;
+}
+
+void ProxyGrid::setCellSize(float cellSize) {
+    clear();
+    _cellSize = std::max(cellSize, 0.0f);
+}
+
+void ProxyGrid::update(ProxyID id, const Sphere& sphere) {
+    if (!isEnabled() || id < 0) {
+        return;
+    }
+    if (id >= (ProxyID)_proxySlots.size()) {
+        _proxyCells.resize(id + 1, 0);
+        _proxySlots.resize(id + 1, INVALID_SLOT);
+    }
+
+    glm::vec3 position(sphere);
+    CellKey key = computeKey(position);
+    if (_proxySlots[id] != INVALID_SLOT && _proxyCells[id] != key) {
+        remove(id);
+    }
+
+    auto itr = _cells.find(key);
+    if (itr == _cells.end()) {
+        itr = _cells.emplace(key, Cell()).first;
+        glm::vec3 corner = glm::floor(position / _cellSize);
+        itr->second.center = (corner + glm::vec3(0.5f)) * _cellSize;
+    }
+    Cell& cell = itr->second;
+    cell.maxProxyRadius = std::max(cell.maxProxyRadius, sphere.w);
+
+    if (_proxySlots[id] == INVALID_SLOT) {
+        _proxyCells[id] = key;
+        _proxySlots[id] = (uint32_t)cell.proxies.size();
+        cell.proxies.push_back(id);
+    }
+}
+
+void ProxyGrid::remove(ProxyID id) {
+    if (id < 0 || id >= (ProxyID)_proxySlots.size() || _proxySlots[id] == INVALID_SLOT) {
+        return;
+    }
+    auto itr = _cells.find(_proxyCells[id]);
+    if (itr != _cells.end()) {
+        // swap the last proxy of the cell into the slot
+        auto& proxies = itr->second.proxies;
+        uint32_t slot = _proxySlots[id];
+        ProxyID last = proxies.back();
+        proxies[slot] = last;
+        _proxySlots[last] = slot;
+        proxies.pop_back();
+        if (proxies.empty()) {
+            _cells.erase(itr);
+        }
+    }
+    _proxySlots[id] = INVALID_SLOT;
+}
+
+void ProxyGrid::clear() {
+    _cells.clear();
+    _proxyCells.clear();
+    _proxySlots.clear();
+}
+
+void ProxyGrid::getCells(CellPointers& cells) const {
+    cells.clear();
+    cells.reserve(_cells.size());
+    for (const auto& cell : _cells) {
+        cells.push_back(&cell.second);
+    }
+}
@@ -0,0 +1,67 @@
+//
+//  ProxyGrid.h
+//  libraries/workload/src/workload
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_workload_ProxyGrid_h
+#define hifi_workload_ProxyGrid_h
+
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Transaction.h"
+
+namespace workload {
+
+// A uniform grid of the proxies in a Space, by the cell their center is in.
+// A cell that touches none of the view regions holds only proxies outside all of them, which lets the Space classify
+// every proxy in it at once.
+class ProxyGrid {
+public:
+    class Cell {
+    public:
+        glm::vec3 center;
+        float maxProxyRadius { 0.0f }; // of the proxies added since the cell was last empty
+        IndexVector proxies;
+
+        // Sphere around every proxy in the cell
+        Sphere getBound(float cellSize) const;
+    };
+    using CellPointers = std::vector<const Cell*>;
+
+    // A cell size of zero disables the grid
+    void setCellSize(float cellSize);
+    float getCellSize() const { return _cellSize; }
+    bool isEnabled() const { return _cellSize > 0.0f; }
+
+    // Adds the proxy, or moves it to the cell it belongs in now
+    void update(ProxyID id, const Sphere& sphere);
+    void remove(ProxyID id);
+    void clear();
+
+    uint32_t getNumCells() const { return (uint32_t)_cells.size(); }
+    void getCells(CellPointers& cells) const;
+
+private:
+    using CellKey = uint64_t;
+    static const uint32_t INVALID_SLOT = (uint32_t)-1;
+
+    CellKey computeKey(const glm::vec3& position) const;
+
+    float _cellSize { 0.0f };
+    std::unordered_map<CellKey, Cell> _cells;
+
+    // where each proxy is: the key of its cell and its index in the cell's list
+    std::vector<CellKey> _proxyCells;
+    std::vector<uint32_t> _proxySlots;
+};
+
+} // namespace workload
+
+#endif // hifi_workload_ProxyGrid_h
@@ -18,19 +18,39 @@
 
 #include <glm/gtx/quaternion.hpp>
 
+#include <CPUDetect.h>
+#include <TBBHelpers.h>
+
+#ifdef ARCH_X86
+#include <emmintrin.h>
+#endif
+
 using namespace workload;
 
+// proxies are classified in tasks of this many, and the tasks spread over the worker threads
+static const uint32_t PROXIES_PER_TASK = 4096;
+static const uint32_t GRID_CELLS_PER_TASK = 64;
+
 Space::Space() : Collection() {
 }
 
+void Space::resizeProxies(uint32_t size) {
+    _proxyX.resize(size, 0.0f);
+    _proxyY.resize(size, 0.0f);
+    _proxyZ.resize(size, 0.0f);
+    _proxyRadius.resize(size, 0.0f);
+    _regions.resize(size, Region::INVALID);
+    _prevRegions.resize(size, Region::INVALID);
+    _owners.resize(size);
+}
+
 void Space::processTransactionFrame(const Transaction& transaction) {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
     // Here we should be able to check the value of last ProxyID allocated
     // and allocate new proxies accordingly
     ProxyID maxID = _IDAllocator.getNumAllocatedIndices();
-    if (maxID > (Index) _proxies.size()) {
-        _proxies.resize(maxID + 100); // allocate the maxId and more
-        _owners.resize(maxID + 100);
+    if (maxID > (Index) _regions.size()) {
+        resizeProxies(maxID + 100); // allocate the maxId and more
     }
     // Now we know for sure that we have enough items in the array to
     // capture anything coming from the transaction
@@ -49,11 +69,15 @@ void Space::processResets(const Transaction::Resets& transactions) {
         if (!_IDAllocator.checkIndex(proxyID)) {
             continue;
         }
-        auto& item = _proxies[proxyID];
 
         // Reset the item with a new payload
-        item.sphere = (std::get<1>(reset));
-        item.prevRegion = item.region = Region::UNKNOWN;
+        const Sphere& sphere = std::get<1>(reset);
+        _proxyX[proxyID] = sphere.x;
+        _proxyY[proxyID] = sphere.y;
+        _proxyZ[proxyID] = sphere.z;
+        _proxyRadius[proxyID] = sphere.w;
+        _prevRegions[proxyID] = _regions[proxyID] = Region::UNKNOWN;
+        _grid.update(proxyID, sphere);
 
         _owners[proxyID] = (std::get<2>(reset));
     }
@@ -66,11 +90,9 @@ void Space::processRemoves(const Transaction::Removes& transactions) {
         }
         _IDAllocator.freeIndex(removedID);
 
-        // Access the true item
-        auto& item = _proxies[removedID];
-
         // Kill it
-        item.prevRegion = item.region = Region::INVALID;
+        _prevRegions[removedID] = _regions[removedID] = Region::INVALID;
+        _grid.remove(removedID);
         _owners[removedID] = Owner();
     }
 }
@@ -82,54 +104,219 @@ void Space::processUpdates(const Transaction::Updates& transactions) {
             continue;
         }
 
-        // Access the true item
-        auto& item = _proxies[updateID];
-
         // Update the item
-        item.sphere = (std::get<1>(update));
+        const Sphere& sphere = std::get<1>(update);
+        _proxyX[updateID] = sphere.x;
+        _proxyY[updateID] = sphere.y;
+        _proxyZ[updateID] = sphere.z;
+        _proxyRadius[updateID] = sphere.w;
+        if (_regions[updateID] < Region::INVALID) {
+            _grid.update(updateID, sphere);
+        }
     }
 }
 
-void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
-    std::unique_lock<std::mutex> lock(_proxiesMutex);
-    uint32_t numProxies = (uint32_t)_proxies.size();
-    uint32_t numViews = (uint32_t)_views.size();
-    for (uint32_t i = 0; i < numProxies; ++i) {
-        Proxy& proxy = _proxies[i];
-        if (proxy.region < Region::INVALID) {
-            glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
-            float proxyRadius = proxy.sphere.w;
-            uint8_t region = Region::UNKNOWN;
-            for (uint32_t j = 0; j < numViews; ++j) {
-                auto& view = _views[j];
-                // for each 'view' we need only increment 'k' below the current value of 'region'
-                for (uint8_t k = 0; k < region; ++k) {
-                    float touchDistance = proxyRadius + view.regions[k].w;
-                    if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
-                        region = k;
-                        break;
-                    }
+void Space::classify(const RegionSpheres& regions, const float* x, const float* y, const float* z, const float* radius,
+                     uint8_t* newRegions, uint32_t count) {
+    // A proxy is in the innermost region of any view that it touches. The region spheres are ordered from the
+    // outermost in, so the last one touched wins.
+    uint32_t i = 0;
+#ifdef ARCH_X86
+    const __m128 unknown = _mm_set1_ps((float)Region::UNKNOWN);
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        __m128 pz = _mm_loadu_ps(z + i);
+        __m128 pr = _mm_loadu_ps(radius + i);
+        __m128 region = unknown;
+        for (const auto& regionSphere : regions) {
+            __m128 dx = _mm_sub_ps(px, _mm_set1_ps(regionSphere.sphere.x));
+            __m128 dy = _mm_sub_ps(py, _mm_set1_ps(regionSphere.sphere.y));
+            __m128 dz = _mm_sub_ps(pz, _mm_set1_ps(regionSphere.sphere.z));
+            __m128 distance2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            __m128 touchDistance = _mm_add_ps(pr, _mm_set1_ps(regionSphere.sphere.w));
+            __m128 touches = _mm_cmplt_ps(distance2, _mm_mul_ps(touchDistance, touchDistance));
+            region = _mm_or_ps(_mm_and_ps(touches, _mm_set1_ps(regionSphere.region)), _mm_andnot_ps(touches, region));
+        }
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_cvttps_epi32(region));
+        newRegions[i] = (uint8_t)lanes[0];
+        newRegions[i + 1] = (uint8_t)lanes[1];
+        newRegions[i + 2] = (uint8_t)lanes[2];
+        newRegions[i + 3] = (uint8_t)lanes[3];
+    }
+#endif
+    for (; i < count; ++i) {
+        float region = (float)Region::UNKNOWN;
+        for (const auto& regionSphere : regions) {
+            float dx = x[i] - regionSphere.sphere.x;
+            float dy = y[i] - regionSphere.sphere.y;
+            float dz = z[i] - regionSphere.sphere.z;
+            float touchDistance = radius[i] + regionSphere.sphere.w;
+            if (dx * dx + dy * dy + dz * dz < touchDistance * touchDistance) {
+                region = regionSphere.region;
+            }
+        }
+        newRegions[i] = (uint8_t)region;
+    }
+}
+
+void Space::categorizeAll(const RegionSpheres& regions, std::vector<Space::Change>& changes) {
+    uint32_t numProxies = (uint32_t)_regions.size();
+    uint32_t numTasks = (numProxies + PROXIES_PER_TASK - 1) / PROXIES_PER_TASK;
+    std::vector<std::vector<Space::Change>> taskChanges(numTasks);
+
+    auto categorizeTask = [&](uint32_t task) {
+        uint32_t begin = task * PROXIES_PER_TASK;
+        uint32_t count = std::min(PROXIES_PER_TASK, numProxies - begin);
+        uint8_t newRegions[PROXIES_PER_TASK];
+        classify(regions, &_proxyX[begin], &_proxyY[begin], &_proxyZ[begin], &_proxyRadius[begin], newRegions, count);
+
+        auto& outChanges = taskChanges[task];
+        for (uint32_t j = 0; j < count; ++j) {
+            uint32_t i = begin + j;
+            if (_regions[i] < Region::INVALID) {
+                _prevRegions[i] = _regions[i];
+                _regions[i] = newRegions[j];
+                if (_regions[i] != _prevRegions[i]) {
+                    outChanges.emplace_back(Space::Change((int32_t)i, _regions[i], _prevRegions[i]));
+                }
+            }
+        }
+    };
+
+    if (numTasks > 1) {
+        tbb::parallel_for(tbb::blocked_range<uint32_t>(0, numTasks, 1), [&](const tbb::blocked_range<uint32_t>& range) {
+            for (uint32_t task = range.begin(); task < range.end(); ++task) {
+                categorizeTask(task);
+            }
+        });
+    } else if (numTasks == 1) {
+        categorizeTask(0);
+    }
+
+    // the tasks' changes are in proxy order, as they would be from a single pass
+    for (const auto& outChanges : taskChanges) {
+        changes.insert(changes.end(), outChanges.begin(), outChanges.end());
+    }
+}
+
+void Space::categorizeGridCells(const RegionSpheres& regions, std::vector<Space::Change>& changes) {
+    ProxyGrid::CellPointers cells;
+    _grid.getCells(cells);
+    float cellSize = _grid.getCellSize();
+    uint32_t numCells = (uint32_t)cells.size();
+    uint32_t numTasks = (numCells + GRID_CELLS_PER_TASK - 1) / GRID_CELLS_PER_TASK;
+    std::vector<std::vector<Space::Change>> taskChanges(numTasks);
+
+    auto categorizeTask = [&](uint32_t task) {
+        std::vector<float> x, y, z, radius;
+        std::vector<uint8_t> newRegions;
+        auto& outChanges = taskChanges[task];
+        uint32_t end = std::min((task + 1) * GRID_CELLS_PER_TASK, numCells);
+        for (uint32_t c = task * GRID_CELLS_PER_TASK; c < end; ++c) {
+            const auto& cell = *cells[c];
+            uint32_t count = (uint32_t)cell.proxies.size();
+            newRegions.resize(count);
+
+            Sphere bound = cell.getBound(cellSize);
+            bool touchesRegion = std::any_of(regions.begin(), regions.end(), [&](const RegionSphere& regionSphere) {
+                float touchDistance = bound.w + regionSphere.sphere.w;
+                return distance2(glm::vec3(bound), glm::vec3(regionSphere.sphere)) < touchDistance * touchDistance;
+            });
+            if (touchesRegion) {
+                x.resize(count);
+                y.resize(count);
+                z.resize(count);
+                radius.resize(count);
+                for (uint32_t j = 0; j < count; ++j) {
+                    ProxyID id = cell.proxies[j];
+                    x[j] = _proxyX[id];
+                    y[j] = _proxyY[id];
+                    z[j] = _proxyZ[id];
+                    radius[j] = _proxyRadius[id];
+                }
+                classify(regions, x.data(), y.data(), z.data(), radius.data(), newRegions.data(), count);
+            } else {
+                // every proxy in the cell is outside all the views
+                std::fill(newRegions.begin(), newRegions.end(), (uint8_t)Region::UNKNOWN);
+            }
+
+            for (uint32_t j = 0; j < count; ++j) {
+                ProxyID i = cell.proxies[j];
+                _prevRegions[i] = _regions[i];
+                _regions[i] = newRegions[j];
+                if (_regions[i] != _prevRegions[i]) {
+                    outChanges.emplace_back(Space::Change((int32_t)i, _regions[i], _prevRegions[i]));
                 }
             }
-            proxy.prevRegion = proxy.region;
-            proxy.region = region;
-            if (proxy.region != proxy.prevRegion) {
-                changes.emplace_back(Space::Change((int32_t)i, proxy.region, proxy.prevRegion));
+        }
+    };
+
+    if (numTasks > 1) {
+        tbb::parallel_for(tbb::blocked_range<uint32_t>(0, numTasks, 1), [&](const tbb::blocked_range<uint32_t>& range) {
+            for (uint32_t task = range.begin(); task < range.end(); ++task) {
+                categorizeTask(task);
             }
+        });
+    } else if (numTasks == 1) {
+        categorizeTask(0);
+    }
+
+    // put the changes in proxy order, as they would be without the grid
+    size_t firstChange = changes.size();
+    for (const auto& outChanges : taskChanges) {
+        changes.insert(changes.end(), outChanges.begin(), outChanges.end());
+    }
+    std::sort(changes.begin() + firstChange, changes.end(), [](const Space::Change& a, const Space::Change& b) {
+        return a.proxyId < b.proxyId;
+    });
+}
+
+void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
+    std::unique_lock<std::mutex> lock(_proxiesMutex);
+
+    RegionSpheres regions;
+    regions.reserve(_views.size() * Region::NUM_VIEW_REGIONS);
+    for (int k = Region::NUM_VIEW_REGIONS - 1; k >= 0; --k) {
+        for (const auto& view : _views) {
+            regions.push_back({ view.regions[k], (float)k });
         }
     }
+
+    if (_grid.isEnabled()) {
+        categorizeGridCells(regions, changes);
+    } else {
+        categorizeAll(regions, changes);
+    }
 }
 
 uint32_t Space::copyProxyValues(Proxy* proxies, uint32_t numDestProxies) const {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
-    auto numCopied = std::min(numDestProxies, (uint32_t)_proxies.size());
-    memcpy(proxies, _proxies.data(), numCopied * sizeof(Proxy));
+    auto numCopied = std::min(numDestProxies, (uint32_t)_regions.size());
+    for (uint32_t i = 0; i < numCopied; ++i) {
+        Proxy& proxy = proxies[i];
+        proxy.sphere = Sphere(_proxyX[i], _proxyY[i], _proxyZ[i], _proxyRadius[i]);
+        proxy.region = _regions[i];
+        proxy.prevRegion = _prevRegions[i];
+    }
     return numCopied;
 }
 
+void Space::setGridCellSize(float cellSize) {
+    std::unique_lock<std::mutex> lock(_proxiesMutex);
+    _grid.setCellSize(cellSize);
+    uint32_t numProxies = (uint32_t)_regions.size();
+    for (uint32_t i = 0; i < numProxies; ++i) {
+        if (_regions[i] < Region::INVALID) {
+            _grid.update((ProxyID)i, Sphere(_proxyX[i], _proxyY[i], _proxyZ[i], _proxyRadius[i]));
+        }
+    }
+}
+
 const Owner Space::getOwner(int32_t proxyID) const {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
-    if (isAllocatedID(proxyID) && (proxyID < (Index)_proxies.size())) {
+    if (isAllocatedID(proxyID) && (proxyID < (Index)_owners.size())) {
         return _owners[proxyID];
     }
     return Owner();
@@ -137,8 +324,8 @@ const Owner Space::getOwner(int32_t proxyID) const {
 
 uint8_t Space::getRegion(int32_t proxyID) const {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
-    if (isAllocatedID(proxyID) && (proxyID < (Index)_proxies.size())) {
-        return _proxies[proxyID].region;
+    if (isAllocatedID(proxyID) && (proxyID < (Index)_regions.size())) {
+        return _regions[proxyID];
     }
     return (uint8_t)Region::INVALID;
 }
@@ -147,8 +334,14 @@ void Space::clear() {
     Collection::clear();
     std::unique_lock<std::mutex> lock(_proxiesMutex);
     _IDAllocator.clear();
-    _proxies.clear();
+    _proxyX.clear();
+    _proxyY.clear();
+    _proxyZ.clear();
+    _proxyRadius.clear();
+    _regions.clear();
+    _prevRegions.clear();
     _owners.clear();
+    _grid.clear();
     _views.clear();
 }
 
@@ -19,6 +19,7 @@
 #include <vector>
 #include <glm/glm.hpp>
 
+#include "ProxyGrid.h"
 #include "Transaction.h"
 
 namespace workload {
@@ -48,6 +49,11 @@ public:
     void categorizeAndGetChanges(std::vector<Change>& changes);
     uint32_t copyProxyValues(Proxy* proxies, uint32_t numDestProxies) const;
 
+    // Proxies in grid cells that touch none of the view regions are classified a cell at a time,
+    // a cell size of zero (the default) classifies every proxy
+    void setGridCellSize(float cellSize);
+    float getGridCellSize() const { return _grid.getCellSize(); }
+
     const Owner getOwner(int32_t proxyID) const;
     uint8_t getRegion(int32_t proxyID) const;
 
@@ -59,11 +65,34 @@ private:
     void processRemoves(const Transaction::Removes& transactions);
     void processUpdates(const Transaction::Updates& transactions);
 
+    // The region spheres of all the views, ordered from the outermost region to the innermost
+    class RegionSphere {
+    public:
+        Sphere sphere;
+        float region;
+    };
+    using RegionSpheres = std::vector<RegionSphere>;
+
+    static void classify(const RegionSpheres& regions, const float* x, const float* y, const float* z,
+                         const float* radius, uint8_t* newRegions, uint32_t count);
+
+    void resizeProxies(uint32_t size);
+    void categorizeAll(const RegionSpheres& regions, std::vector<Change>& changes);
+    void categorizeGridCells(const RegionSpheres& regions, std::vector<Change>& changes);
+
     // The database of proxies is protected for editing by a mutex
+    // The proxy fields are stored in separate arrays so they can be classified several proxies at a time
     mutable std::mutex _proxiesMutex;
-    Proxy::Vector _proxies;
+    std::vector<float> _proxyX;
+    std::vector<float> _proxyY;
+    std::vector<float> _proxyZ;
+    std::vector<float> _proxyRadius;
+    std::vector<uint8_t> _regions;
+    std::vector<uint8_t> _prevRegions;
     std::vector<Owner> _owners;
 
+    ProxyGrid _grid;
+
     Views _views;
 };
 
@@ -97,6 +97,36 @@ Item {
             ]
         }
 
+        PlotPerf {
+            title: "Scene Transactions"
+            height: parent.evalEvenHeight()
+            object: stats.config
+            plots: [
+                {
+                    prop: "frameTransactionCount",
+                    label: "Transactions",
+                    color: "#00B4EF"
+                },
+                {
+                    prop: "frameItemChangeCount",
+                    label: "Item changes",
+                    color: "#1AC567"
+                },
+                {
+                    prop: "frameTransactionProcessingTime",
+                    label: "Processing usecs",
+                    color: "#E2334D"
+                },
+                {
+                    prop: "frameTransactionRate",
+                    label: "rate",
+                    color: "#FED959",
+                    scale: 0.001,
+                    unit: "K/s"
+                }
+            ]
+        }
+
         property var drawOpaqueConfig: Render.getConfig("RenderMainView.DrawOpaqueDeferred")
         property var drawTransparentConfig: Render.getConfig("RenderMainView.DrawTransparentDeferred")
         property var drawLightConfig: Render.getConfig("RenderMainView.DrawLight")
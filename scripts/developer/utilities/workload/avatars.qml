@@ -71,6 +71,54 @@ Item {
                 }
             ]
         }
+        PlotPerf {
+            title: "Avatar Animation LOD"
+            height: parent.evalEvenHeight()
+            object: Stats
+            valueScale: 1
+            valueUnit: "num"
+            plots: [
+                {
+                    prop: "highAnimationLODAvatarCount",
+                    label: "high",
+                    color: "#FFFF00"
+                },
+                {
+                    prop: "mediumAnimationLODAvatarCount",
+                    label: "medium",
+                    color: "#00FF00"
+                },
+                {
+                    prop: "lowAnimationLODAvatarCount",
+                    label: "low",
+                    color: "#1AC567"
+                }
+            ]
+        }
+        PlotPerf {
+            title: "Avatar Animation LOD Time"
+            height: parent.evalEvenHeight()
+            object: Stats
+            valueScale: 1
+            valueUnit: "ms"
+            plots: [
+                {
+                    prop: "highAnimationLODTime",
+                    label: "high",
+                    color: "#FFFF00"
+                },
+                {
+                    prop: "mediumAnimationLODTime",
+                    label: "medium",
+                    color: "#00FF00"
+                },
+                {
+                    prop: "lowAnimationLODTime",
+                    label: "low",
+                    color: "#1AC567"
+                }
+            ]
+        }
         Separator {
             id: bottomLine
         }
@@ -0,0 +1,434 @@
+//
+//  AnimPerfTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPerfTests.h"
+
+#include <glm/gtx/transform.hpp>
+
+#include <AnimClip.h>
+#include <AnimClipData.h>
+#include <AnimNodeLoader.h>
+#include <AnimSkeleton.h>
+#include <AnimUtil.h>
+#include <AnimationCache.h>
+#include <NodeList.h>
+#include <AddressManager.h>
+#include <AccountManager.h>
+#include <ResourceManager.h>
+#include <ResourceRequestObserver.h>
+#include <StatTracker.h>
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(AnimPerfTests)
+
+const float TEST_EPSILON = 0.0001f;
+
+// the per joint blend the kernels replace
+void referenceBlend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    for (size_t i = 0; i < numPoses; i++) {
+        result[i].scale() = lerp(a[i].scale(), b[i].scale(), alpha);
+        result[i].rot() = safeLerp(a[i].rot(), b[i].rot(), alpha);
+        result[i].trans() = lerp(a[i].trans(), b[i].trans(), alpha);
+    }
+}
+
+glm::quat randomRotation() {
+    return glm::angleAxis(randFloatInRange(-PI, PI), glm::normalize(randVector() + glm::vec3(0.01f)));
+}
+
+AnimPose randomPose(bool uniformScale) {
+    glm::vec3 scale = uniformScale ? glm::vec3(randFloatInRange(0.5f, 2.0f)) :
+        glm::vec3(randFloatInRange(0.5f, 2.0f), randFloatInRange(0.5f, 2.0f), randFloatInRange(0.5f, 2.0f));
+    glm::quat rot = randomRotation();
+    // both signs of the same rotation should blend the same
+    if (randFloat() < 0.5f) {
+        rot = -rot;
+    }
+    return AnimPose(scale, rot, glm::vec3(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f)));
+}
+
+void comparePoses(const AnimPose& actual, const AnimPose& expected) {
+    QCOMPARE_WITH_ABS_ERROR(actual.scale(), expected.scale(), TEST_EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(actual.rot(), expected.rot(), TEST_EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(actual.trans(), expected.trans(), TEST_EPSILON);
+}
+
+// A humanoid with the joint names of the default avatar, standing along +y
+std::vector<HFMJoint> makeHumanoidJoints() {
+    std::vector<HFMJoint> joints;
+    auto addJoint = [&](const QString& name, const QString& parentName, const glm::vec3& translation) {
+        HFMJoint joint;
+        joint.isFree = false;
+        joint.parentIndex = -1;
+        for (int i = 0; i < (int)joints.size(); ++i) {
+            if (joints[i].name == parentName) {
+                joint.parentIndex = i;
+            }
+        }
+        joint.distanceToParent = glm::length(translation);
+        joint.translation = translation;
+        joint.preTransform = glm::mat4();
+        joint.preRotation = glm::quat();
+        joint.rotation = glm::quat();
+        joint.postRotation = glm::quat();
+        joint.postTransform = glm::mat4();
+        joint.rotationMin = glm::vec3(-PI);
+        joint.rotationMax = glm::vec3(PI);
+        joint.inverseDefaultRotation = glm::quat();
+        joint.inverseBindRotation = glm::quat();
+        glm::mat4 parentTransform = joint.parentIndex == -1 ? glm::mat4() : joints[joint.parentIndex].transform;
+        joint.transform = parentTransform * glm::translate(translation);
+        joint.bindTransform = joint.transform;
+        joint.name = name;
+        joint.isSkeletonJoint = true;
+        joints.push_back(joint);
+    };
+
+    addJoint("Hips", "", glm::vec3(0.0f, 1.0f, 0.0f));
+    addJoint("Spine", "Hips", glm::vec3(0.0f, 0.1f, 0.0f));
+    addJoint("Spine1", "Spine", glm::vec3(0.0f, 0.1f, 0.0f));
+    addJoint("Spine2", "Spine1", glm::vec3(0.0f, 0.1f, 0.0f));
+    addJoint("Neck", "Spine2", glm::vec3(0.0f, 0.2f, 0.0f));
+    addJoint("Head", "Neck", glm::vec3(0.0f, 0.1f, 0.0f));
+    addJoint("LeftEye", "Head", glm::vec3(0.03f, 0.1f, 0.1f));
+    addJoint("RightEye", "Head", glm::vec3(-0.03f, 0.1f, 0.1f));
+
+    const char* FINGERS[] = { "Thumb", "Index", "Middle", "Ring", "Pinky" };
+    for (int side = 0; side < 2; ++side) {
+        QString prefix = side == 0 ? "Left" : "Right";
+        float x = side == 0 ? 1.0f : -1.0f;
+        addJoint(prefix + "Shoulder", "Spine2", glm::vec3(0.05f * x, 0.15f, 0.0f));
+        addJoint(prefix + "Arm", prefix + "Shoulder", glm::vec3(0.1f * x, 0.0f, 0.0f));
+        addJoint(prefix + "ForeArm", prefix + "Arm", glm::vec3(0.25f * x, 0.0f, 0.0f));
+        addJoint(prefix + "Hand", prefix + "ForeArm", glm::vec3(0.25f * x, 0.0f, 0.0f));
+        for (int finger = 0; finger < 5; ++finger) {
+            QString parentName = prefix + "Hand";
+            for (int bone = 1; bone <= 4; ++bone) {
+                QString name = prefix + "Hand" + FINGERS[finger] + QString::number(bone);
+                glm::vec3 offset = bone == 1 ? glm::vec3(0.05f * x, 0.0f, 0.02f * (finger - 2)) : glm::vec3(0.02f * x, 0.0f, 0.0f);
+                addJoint(name, parentName, offset);
+                parentName = name;
+            }
+        }
+        addJoint(prefix + "UpLeg", "Hips", glm::vec3(0.1f * x, 0.0f, 0.0f));
+        addJoint(prefix + "Leg", prefix + "UpLeg", glm::vec3(0.0f, -0.45f, 0.0f));
+        addJoint(prefix + "Foot", prefix + "Leg", glm::vec3(0.0f, -0.45f, 0.0f));
+        addJoint(prefix + "ToeBase", prefix + "Foot", glm::vec3(0.0f, -0.05f, 0.1f));
+    }
+    return joints;
+}
+
+// Frames of a walk cycle like clip: the hips move forward, most joints swing and some hold still
+std::vector<AnimPoseVec> makeClipFrames(const AnimSkeleton& skeleton, int numFrames, int offset) {
+    std::vector<AnimPoseVec> frames(numFrames);
+    for (int frame = 0; frame < numFrames; ++frame) {
+        AnimPoseVec& poses = frames[frame];
+        poses = skeleton.getRelativeDefaultPoses();
+        for (int i = 0; i < (int)poses.size(); ++i) {
+            if (i % 3 != 2) {
+                float angle = 0.2f * sinf(0.1f * frame + i + offset);
+                poses[i].rot() = poses[i].rot() * glm::angleAxis(angle, Vectors::UNIT_X);
+            }
+        }
+        poses[0].trans() += glm::vec3(0.0f, 0.02f * sinf(0.2f * frame), 0.02f * frame);
+    }
+    return frames;
+}
+
+void compareRotations(const glm::quat& actual, const glm::quat& expected, float tolerance) {
+    // either sign of a quaternion is the same rotation
+    glm::quat chord = glm::dot(actual, expected) < 0.0f ? actual + expected : actual - expected;
+    float angle = 4.0f * asinf(std::min(0.5f * glm::length(chord), 1.0f));
+    QVERIFY2(angle <= tolerance, qPrintable(QString("rotations %1 radians apart").arg(angle)));
+}
+
+void AnimPerfTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent);
+    DependencyManager::set<ResourceManager>();
+    DependencyManager::set<AnimationCache>();
+    DependencyManager::set<ResourceRequestObserver>();
+    DependencyManager::set<ResourceCacheSharedItems>();
+    DependencyManager::set<StatTracker>();
+}
+
+void AnimPerfTests::cleanupTestCase() {
+    DependencyManager::get<ResourceManager>()->cleanup();
+}
+
+void AnimPerfTests::testBlend() {
+    const size_t NUM_POSES = 67;
+    AnimPoseVec a, b;
+    for (size_t i = 0; i < NUM_POSES; ++i) {
+        a.push_back(randomPose(i % 2 == 0));
+        b.push_back(randomPose(i % 3 == 0));
+    }
+
+    const float ALPHAS[] = { 0.0f, 0.25f, 0.5f, 0.9f, 1.0f };
+    for (float alpha : ALPHAS) {
+        AnimPoseVec expected(NUM_POSES), actual(NUM_POSES);
+        referenceBlend(NUM_POSES, &a[0], &b[0], alpha, &expected[0]);
+        ::blend(NUM_POSES, &a[0], &b[0], alpha, &actual[0]);
+        for (size_t i = 0; i < NUM_POSES; ++i) {
+            comparePoses(actual[i], expected[i]);
+        }
+
+        // blending into either input
+        AnimPoseVec intoA = a;
+        ::blend(NUM_POSES, &intoA[0], &b[0], alpha, &intoA[0]);
+        AnimPoseVec intoB = b;
+        ::blend(NUM_POSES, &a[0], &intoB[0], alpha, &intoB[0]);
+        for (size_t i = 0; i < NUM_POSES; ++i) {
+            comparePoses(intoA[i], expected[i]);
+            comparePoses(intoB[i], expected[i]);
+        }
+    }
+
+    // with an alpha per pose, as the overlays blend
+    std::vector<float> alphas;
+    for (size_t i = 0; i < NUM_POSES; ++i) {
+        alphas.push_back(randFloat());
+    }
+    const float ALPHA_SCALE = 0.75f;
+    AnimPoseVec actual(NUM_POSES);
+    ::blend(NUM_POSES, &a[0], &b[0], &alphas[0], ALPHA_SCALE, &actual[0]);
+    for (size_t i = 0; i < NUM_POSES; ++i) {
+        AnimPose expected;
+        referenceBlend(1, &a[i], &b[i], alphas[i] * ALPHA_SCALE, &expected);
+        comparePoses(actual[i], expected);
+    }
+}
+
+void AnimPerfTests::testPoseMultiply() {
+    const int NUM_TRIALS = 1000;
+    const glm::vec3 POINTS[] = { glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f) };
+    for (int trial = 0; trial < NUM_TRIALS; ++trial) {
+        // the composition skips the matrices when the left scale is uniform, but must come out the same
+        bool uniformScale = trial % 4 != 0;
+        AnimPose a = randomPose(uniformScale);
+        AnimPose b = randomPose(trial % 2 == 0);
+        AnimPose product = a * b;
+        glm::mat4 expected = (glm::mat4)a * (glm::mat4)b;
+        comparePoses(product, AnimPose(expected));
+        if (uniformScale) {
+            // there is no shear to lose, so points move exactly as through the matrices
+            for (const auto& point : POINTS) {
+                QCOMPARE_WITH_ABS_ERROR(product.xformPoint(point), transformPoint(expected, point), TEST_EPSILON * 10.0f);
+            }
+        }
+    }
+}
+
+void AnimPerfTests::blendPerf() {
+    const size_t NUM_AVATARS = 100;
+    const size_t NUM_JOINTS = 100;
+    const int NUM_FRAMES = 100;
+    AnimPoseVec a, b, result(NUM_AVATARS * NUM_JOINTS);
+    for (size_t i = 0; i < NUM_AVATARS * NUM_JOINTS; ++i) {
+        a.push_back(randomPose(true));
+        b.push_back(randomPose(true));
+    }
+
+    uint64_t start = usecTimestampNow();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        referenceBlend(a.size(), &a[0], &b[0], (float)frame / NUM_FRAMES, &result[0]);
+    }
+    uint64_t referenceTime = usecTimestampNow() - start;
+
+    start = usecTimestampNow();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        ::blend(a.size(), &a[0], &b[0], (float)frame / NUM_FRAMES, &result[0]);
+    }
+    uint64_t blendTime = usecTimestampNow() - start;
+
+    AnimPoseVec absolutePoses(NUM_JOINTS);
+    std::vector<int> parentIndices;
+    for (size_t i = 0; i < NUM_JOINTS; ++i) {
+        parentIndices.push_back((int)i - 1);
+    }
+    start = usecTimestampNow();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        for (size_t avatar = 0; avatar < NUM_AVATARS; ++avatar) {
+            const AnimPose* relativePoses = &a[avatar * NUM_JOINTS];
+            for (size_t i = 0; i < NUM_JOINTS; ++i) {
+                int parentIndex = parentIndices[i];
+                absolutePoses[i] = parentIndex == -1 ? relativePoses[i] : absolutePoses[parentIndex] * relativePoses[i];
+            }
+        }
+    }
+    uint64_t absoluteTime = usecTimestampNow() - start;
+
+    qDebug() << NUM_AVATARS << "avatars of" << NUM_JOINTS << "joints:"
+        << "reference blend =" << (referenceTime / NUM_FRAMES) << "usec/frame"
+        << " blend =" << (blendTime / NUM_FRAMES) << "usec/frame"
+        << " relative to absolute =" << (absoluteTime / NUM_FRAMES) << "usec/frame";
+}
+
+void AnimPerfTests::testClipData() {
+    auto skeleton = std::make_shared<AnimSkeleton>(makeHumanoidJoints(), QMap<int, glm::quat>());
+    const int NUM_FRAMES = 120;
+    std::vector<AnimPoseVec> frames = makeClipFrames(*skeleton, NUM_FRAMES, 0);
+    AnimClipData clipData(frames);
+    QCOMPARE(clipData.getNumFrames(), NUM_FRAMES);
+    QCOMPARE(clipData.getNumJoints(), skeleton->getNumJoints());
+
+    // on the frames and between them the tracks stay within what the key reduction allows
+    const float ROTATION_TOLERANCE = 0.002f;
+    const float TRANSLATION_TOLERANCE = 0.005f;
+    AnimPoseVec sampled(clipData.getNumJoints()), expected(clipData.getNumJoints());
+    for (int frame = 0; frame < NUM_FRAMES - 1; ++frame) {
+        const float ALPHAS[] = { 0.0f, 0.5f };
+        for (float alpha : ALPHAS) {
+            referenceBlend(expected.size(), &frames[frame][0], &frames[frame + 1][0], alpha, &expected[0]);
+            clipData.sample(frame + alpha, &sampled[0]);
+            for (int i = 0; i < clipData.getNumJoints(); ++i) {
+                compareRotations(sampled[i].rot(), expected[i].rot(), ROTATION_TOLERANCE);
+                QCOMPARE_WITH_ABS_ERROR(sampled[i].trans(), expected[i].trans(), TRANSLATION_TOLERANCE);
+                QCOMPARE_WITH_ABS_ERROR(sampled[i].scale(), expected[i].scale(), TEST_EPSILON);
+            }
+        }
+    }
+
+    // past the ends the first and last frames hold
+    clipData.sample(-1.0f, &sampled[0]);
+    compareRotations(sampled[1].rot(), frames[0][1].rot(), ROTATION_TOLERANCE);
+    clipData.sample((float)NUM_FRAMES, &sampled[0]);
+    compareRotations(sampled[1].rot(), frames[NUM_FRAMES - 1][1].rot(), ROTATION_TOLERANCE);
+
+    // the first clip shared under a key is the one everyone gets, until nobody holds it
+    const QString URL = "test://clip.fbx";
+    uint64_t hash = AnimClipData::hashSkeleton(*skeleton);
+    auto first = AnimClipData::share(URL, hash, false, std::make_shared<AnimClipData>(frames));
+    auto second = AnimClipData::share(URL, hash, false, std::make_shared<AnimClipData>(frames));
+    QVERIFY(first == second);
+    QVERIFY(AnimClipData::find(URL, hash, false) == first);
+    QVERIFY(!AnimClipData::find(URL, hash, true));
+    QVERIFY(!AnimClipData::find(URL, hash + 1, false));
+    first.reset();
+    second.reset();
+    QVERIFY(!AnimClipData::find(URL, hash, false));
+}
+
+void AnimPerfTests::clipDataPerf() {
+    auto skeleton = std::make_shared<AnimSkeleton>(makeHumanoidJoints(), QMap<int, glm::quat>());
+    const int NUM_CLIPS = 40;
+    const int NUM_CLIP_FRAMES = 300;
+    const int NUM_AVATARS = 100;
+    const int numJoints = skeleton->getNumJoints();
+
+    // every clip of every avatar used to keep its own frames, and its own mirrored frames once mirrored
+    std::vector<AnimClipData::Pointer> clips;
+    std::vector<std::vector<AnimPoseVec>> rawClips;
+    size_t compressedSize = 0;
+    for (int clip = 0; clip < NUM_CLIPS; ++clip) {
+        rawClips.push_back(makeClipFrames(*skeleton, NUM_CLIP_FRAMES, clip));
+        clips.push_back(std::make_shared<AnimClipData>(rawClips.back()));
+        compressedSize += clips.back()->getMemorySize();
+    }
+    size_t rawSize = (size_t)NUM_CLIPS * NUM_CLIP_FRAMES * numJoints * sizeof(AnimPose);
+
+    const int NUM_SAMPLES = 2000;
+    AnimPoseVec poses(numJoints);
+    uint64_t start = usecTimestampNow();
+    for (int sample = 0; sample < NUM_SAMPLES; ++sample) {
+        const auto& frames = rawClips[sample % NUM_CLIPS];
+        int frame = (sample * 7) % (NUM_CLIP_FRAMES - 1);
+        ::blend(numJoints, &frames[frame][0], &frames[frame + 1][0], 0.3f, &poses[0]);
+    }
+    uint64_t rawTime = usecTimestampNow() - start;
+
+    start = usecTimestampNow();
+    for (int sample = 0; sample < NUM_SAMPLES; ++sample) {
+        int frame = (sample * 7) % (NUM_CLIP_FRAMES - 1);
+        clips[sample % NUM_CLIPS]->sample(frame + 0.3f, &poses[0]);
+    }
+    uint64_t compressedTime = usecTimestampNow() - start;
+
+    float samplesPerJoint = (float)NUM_SAMPLES * numJoints;
+    qDebug() << NUM_CLIPS << "clips of" << NUM_CLIP_FRAMES << "frames and" << numJoints << "joints:"
+        << "raw =" << rawSize / 1024 << "KB/clip set," << (2 * rawSize * NUM_AVATARS) / (1024 * 1024) << "MB for" << NUM_AVATARS << "mirroring avatars"
+        << " compressed and shared =" << compressedSize / 1024 << "KB, twice that when mirrored";
+    qDebug() << "sampling: raw blend =" << (rawTime * 1000.0f / samplesPerJoint) << "nsec/joint"
+        << " compressed =" << (compressedTime * 1000.0f / samplesPerJoint) << "nsec/joint";
+}
+
+void AnimPerfTests::evaluateAvatarGraphPerf() {
+    QString path = QFINDTESTDATA("../../../interface/resources/avatar/avatar-animation.json");
+    if (path.isEmpty()) {
+        QSKIP("default avatar graph not found");
+    }
+    AnimNodeLoader loader(QUrl::fromLocalFile(path));
+
+    const int TIMEOUT = 5000;
+    QEventLoop loop;
+    AnimNode::Pointer node = nullptr;
+    connect(&loader, &AnimNodeLoader::success, [&](AnimNode::Pointer nodeIn) { node = nodeIn; });
+    loop.connect(&loader, SIGNAL(success(AnimNode::Pointer)), SLOT(quit()));
+    loop.connect(&loader, SIGNAL(error(int, QString)), SLOT(quit()));
+    QTimer::singleShot(TIMEOUT, &loop, SLOT(quit()));
+    loop.exec();
+    QVERIFY((bool)node);
+
+    auto skeleton = std::make_shared<AnimSkeleton>(makeHumanoidJoints(), QMap<int, glm::quat>());
+    node->setSkeleton(skeleton);
+
+    // the clips come from the application resources, so give each of them some made up frames instead
+    const int NUM_CLIP_FRAMES = 60;
+    int numClips = 0;
+    std::function<void(const AnimNode::Pointer&)> fillClips = [&](const AnimNode::Pointer& node) {
+        if (node->getType() == AnimNode::Type::Clip) {
+            auto clip = std::static_pointer_cast<AnimClip>(node);
+            clip->_clipData = std::make_shared<AnimClipData>(makeClipFrames(*skeleton, NUM_CLIP_FRAMES, numClips));
+            clip->_poses.resize(skeleton->getNumJoints());
+            ++numClips;
+        }
+        for (int i = 0; i < node->getChildCount(); ++i) {
+            fillClips(node->getChild(i));
+        }
+    };
+    fillClips(node);
+
+    // a graph per avatar would evaluate the same way, so the one graph stands in for all of them
+    const int NUM_AVATARS = 100;
+    const int NUM_FRAMES = 30;
+    const float DELTA_TIME = 1.0f / 60.0f;
+    AnimVariantMap animVars;
+    animVars.set("isMovingForward", true);
+    animVars.set("moveForwardSpeed", 1.5f);
+    AnimPoseVec absolutePoses;
+    uint64_t evaluateTime = 0;
+    uint64_t absoluteTime = 0;
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        for (int avatar = 0; avatar < NUM_AVATARS; ++avatar) {
+            AnimContext context(false, false, false, glm::mat4(), glm::mat4(), frame * NUM_AVATARS + avatar);
+            AnimVariantMap triggersOut;
+            uint64_t start = usecTimestampNow();
+            const AnimPoseVec& poses = node->evaluate(animVars, context, DELTA_TIME / NUM_AVATARS, triggersOut);
+            uint64_t evaluated = usecTimestampNow();
+            absolutePoses = poses;
+            skeleton->convertRelativePosesToAbsolute(absolutePoses);
+            uint64_t end = usecTimestampNow();
+            evaluateTime += evaluated - start;
+            absoluteTime += end - evaluated;
+        }
+    }
+    QCOMPARE((int)absolutePoses.size(), skeleton->getNumJoints());
+
+    qDebug() << NUM_AVATARS << "avatars of" << skeleton->getNumJoints() << "joints through" << numClips << "clips:"
+        << "evaluate =" << (evaluateTime / NUM_FRAMES) << "usec/frame"
+        << " relative to absolute =" << (absoluteTime / NUM_FRAMES) << "usec/frame";
+}
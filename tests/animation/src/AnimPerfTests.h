@@ -0,0 +1,30 @@
+//
+//  AnimPerfTests.h
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPerfTests_h
+#define hifi_AnimPerfTests_h
+
+#include <QtTest/QtTest>
+
+class AnimPerfTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void testBlend();
+    void testPoseMultiply();
+    void testClipData();
+    void blendPerf();
+    void clipDataPerf();
+    void evaluateAvatarGraphPerf();
+};
+
+#endif // hifi_AnimPerfTests_h
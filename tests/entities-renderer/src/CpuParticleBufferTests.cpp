@@ -0,0 +1,245 @@
+//
+//  CpuParticleBufferTests.cpp
+//  tests/entities-renderer/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CpuParticleBufferTests.h"
+
+#include <chrono>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include <QtTest/QtTest>
+
+#include <CpuParticleBuffer.h>
+#include <TBBHelpers.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(CpuParticleBufferTests)
+
+using Particle = CpuParticleBuffer::Particle;
+
+static const float TOLERANCE = 0.0001f;
+
+static Particle makeParticle(std::mt19937& generator, uint64_t expiration) {
+    std::uniform_real_distribution<float> values(-1.0f, 1.0f);
+    Particle particle;
+    particle.seed = values(generator);
+    particle.expiration = expiration;
+    particle.basePosition = glm::vec3(values(generator), values(generator), values(generator));
+    particle.relativePosition = glm::vec3(values(generator), values(generator), values(generator));
+    particle.velocity = glm::vec3(values(generator), values(generator), values(generator));
+    particle.acceleration = glm::vec3(values(generator), values(generator), values(generator));
+    return particle;
+}
+
+// the way particles were integrated one at a time
+static void integrate(Particle& particle, float deltaTime) {
+    glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * particle.acceleration;
+    particle.relativePosition += particle.velocity * deltaTime + atSquared;
+    particle.velocity += particle.acceleration * deltaTime;
+    particle.lifetime += deltaTime;
+}
+
+static void compare(const CpuParticleBuffer& buffer, const std::deque<Particle>& expected) {
+    QCOMPARE(buffer.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        auto particle = buffer.get(i);
+        QCOMPARE(particle.expiration, expected[i].expiration);
+        QCOMPARE(particle.seed, expected[i].seed);
+        QCOMPARE_WITH_ABS_ERROR(particle.lifetime, expected[i].lifetime, TOLERANCE);
+        QCOMPARE_WITH_ABS_ERROR(particle.basePosition, expected[i].basePosition, TOLERANCE);
+        QCOMPARE_WITH_ABS_ERROR(particle.relativePosition, expected[i].relativePosition, TOLERANCE);
+        QCOMPARE_WITH_ABS_ERROR(particle.velocity, expected[i].velocity, TOLERANCE);
+    }
+}
+
+void CpuParticleBufferTests::testRing() {
+    std::mt19937 generator(1);
+    CpuParticleBuffer buffer;
+    std::deque<Particle> expected;
+
+    // emit and expire at uneven rates so the ring wraps and grows with particles on both sides of its end
+    uint64_t now = 0;
+    for (int step = 0; step < 500; ++step) {
+        now += 10;
+        int numEmitted = (int)(generator() % 20);
+        for (int i = 0; i < numEmitted; ++i) {
+            auto particle = makeParticle(generator, now + 200 + generator() % 100);
+            buffer.push(particle);
+            expected.push_back(particle);
+        }
+        size_t maxParticles = 100 + generator() % 200;
+        buffer.expire(now, maxParticles);
+        while (expected.size() > maxParticles || (!expected.empty() && expected.front().expiration <= now)) {
+            expected.pop_front();
+        }
+        compare(buffer, expected);
+    }
+
+    buffer.clear();
+    QVERIFY(buffer.empty());
+}
+
+void CpuParticleBufferTests::testIntegrate() {
+    std::mt19937 generator(2);
+    CpuParticleBuffer buffer;
+    std::deque<Particle> expected;
+
+    // enough to wrap, and not a multiple of four
+    for (int i = 0; i < 100; ++i) {
+        auto particle = makeParticle(generator, i);
+        buffer.push(particle);
+        expected.push_back(particle);
+    }
+    buffer.expire(60, 1000);
+    expected.erase(expected.begin(), expected.begin() + 61);
+    for (int i = 0; i < 60; ++i) {
+        auto particle = makeParticle(generator, 1000);
+        buffer.push(particle);
+        expected.push_back(particle);
+    }
+
+    for (int step = 0; step < 60; ++step) {
+        const float DELTA_TIME = 1.0f / 60.0f;
+        buffer.integrate(DELTA_TIME);
+        for (auto& particle : expected) {
+            integrate(particle, DELTA_TIME);
+        }
+    }
+    compare(buffer, expected);
+}
+
+void CpuParticleBufferTests::testRebase() {
+    std::mt19937 generator(3);
+    CpuParticleBuffer buffer;
+    std::deque<Particle> expected;
+    for (int i = 0; i < 10; ++i) {
+        auto particle = makeParticle(generator, i);
+        buffer.push(particle);
+        expected.push_back(particle);
+    }
+
+    // stopping a trail keeps the particles where they are in the world
+    glm::vec3 emitterPosition(5.0f, 6.0f, 7.0f);
+    buffer.rebase(emitterPosition, true);
+    for (auto& particle : expected) {
+        particle.relativePosition += particle.basePosition - emitterPosition;
+        particle.basePosition = emitterPosition;
+    }
+    compare(buffer, expected);
+
+    // starting one only moves the bases
+    emitterPosition = glm::vec3(-1.0f);
+    buffer.rebase(emitterPosition, false);
+    for (auto& particle : expected) {
+        particle.basePosition = emitterPosition;
+    }
+    compare(buffer, expected);
+}
+
+void CpuParticleBufferTests::testWriteVertices() {
+    std::mt19937 generator(4);
+    CpuParticleBuffer buffer;
+    std::deque<Particle> expected;
+    for (int i = 0; i < 100; ++i) {
+        auto particle = makeParticle(generator, i);
+        buffer.push(particle);
+        expected.push_back(particle);
+    }
+    buffer.expire(49, 1000);
+    expected.erase(expected.begin(), expected.begin() + 50);
+    for (int i = 0; i < 60; ++i) {
+        auto particle = makeParticle(generator, 1000);
+        buffer.push(particle);
+        expected.push_back(particle);
+    }
+
+    glm::vec3 emitterPosition(1.0f, 2.0f, 3.0f);
+    std::vector<CpuParticleBuffer::Vertex> vertices(buffer.size());
+    for (bool trail : { false, true }) {
+        buffer.writeVertices(vertices.data(), trail, emitterPosition);
+        for (size_t i = 0; i < expected.size(); ++i) {
+            glm::vec3 position = expected[i].relativePosition + (trail ? expected[i].basePosition : emitterPosition);
+            QCOMPARE_WITH_ABS_ERROR(vertices[i].xyz, position, TOLERANCE);
+            QCOMPARE(vertices[i].uv, glm::vec2(expected[i].lifetime, expected[i].seed));
+        }
+    }
+}
+
+void CpuParticleBufferTests::particlePerf() {
+    // a big event: many emitters, each at its particle limit, stepped and written out every frame
+    const int NUM_EMITTERS = 64;
+    const int PARTICLES_PER_EMITTER = 10000;
+    const int NUM_FRAMES = 30;
+    const float DELTA_TIME = 1.0f / 60.0f;
+    const int NUM_PARTICLES = NUM_EMITTERS * PARTICLES_PER_EMITTER;
+
+    std::mt19937 generator(5);
+    std::vector<std::deque<Particle>> dequeEmitters(NUM_EMITTERS);
+    std::vector<CpuParticleBuffer> emitters(NUM_EMITTERS);
+    for (int i = 0; i < NUM_EMITTERS; ++i) {
+        for (int j = 0; j < PARTICLES_PER_EMITTER; ++j) {
+            auto particle = makeParticle(generator, UINT64_MAX);
+            dequeEmitters[i].push_back(particle);
+            emitters[i].push(particle);
+        }
+    }
+    std::vector<std::vector<CpuParticleBuffer::Vertex>> vertices(NUM_EMITTERS,
+        std::vector<CpuParticleBuffer::Vertex>(PARTICLES_PER_EMITTER));
+    glm::vec3 emitterPosition(1.0f);
+
+    using Clock = std::chrono::high_resolution_clock;
+    auto particlesPerSecond = [&](Clock::time_point start) {
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return (double)NUM_PARTICLES * NUM_FRAMES / seconds;
+    };
+
+    // one particle at a time out of a deque, copied into a vector for upload
+    auto start = Clock::now();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        for (int i = 0; i < NUM_EMITTERS; ++i) {
+            size_t j = 0;
+            for (auto& particle : dequeEmitters[i]) {
+                integrate(particle, DELTA_TIME);
+                vertices[i][j].xyz = particle.relativePosition + emitterPosition;
+                vertices[i][j].uv = glm::vec2(particle.lifetime, particle.seed);
+                ++j;
+            }
+        }
+    }
+    auto dequeRate = particlesPerSecond(start);
+
+    start = Clock::now();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        for (int i = 0; i < NUM_EMITTERS; ++i) {
+            emitters[i].integrate(DELTA_TIME);
+            emitters[i].writeVertices(vertices[i].data(), false, emitterPosition);
+        }
+    }
+    auto soaRate = particlesPerSecond(start);
+
+    start = Clock::now();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, NUM_EMITTERS), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                emitters[i].integrate(DELTA_TIME);
+                emitters[i].writeVertices(vertices[i].data(), false, emitterPosition);
+            }
+        });
+    }
+    auto parallelRate = particlesPerSecond(start);
+
+    qDebug() << NUM_EMITTERS << "emitters of" << PARTICLES_PER_EMITTER << "particles, millions of particles per second:";
+    qDebug() << "    deque:" << dequeRate / 1.0e6;
+    qDebug() << "    ring of arrays:" << soaRate / 1.0e6;
+    qDebug() << "    ring of arrays, emitters in parallel:" << parallelRate / 1.0e6;
+}
@@ -0,0 +1,26 @@
+//
+//  CpuParticleBufferTests.h
+//  tests/entities-renderer/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CpuParticleBufferTests_h
+#define hifi_CpuParticleBufferTests_h
+
+#include <QtCore/QObject>
+
+class CpuParticleBufferTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testRing();
+    void testIntegrate();
+    void testRebase();
+    void testWriteVertices();
+    void particlePerf();
+};
+
+#endif // hifi_CpuParticleBufferTests_h
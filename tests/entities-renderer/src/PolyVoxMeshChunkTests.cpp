@@ -0,0 +1,86 @@
+//
+//  PolyVoxMeshChunkTests.cpp
+//  tests/entities-renderer/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxMeshChunkTests.h"
+
+#include <memory>
+#include <vector>
+
+#include <QtTest/QtTest>
+
+#include <RenderablePolyVoxEntityItem.h>
+
+QTEST_MAIN(PolyVoxMeshChunkTests)
+
+namespace {
+
+// a volume that is 32 voxels a side in _volData, so 2 x 2 x 2 chunks of 16 that share the voxels at 16
+std::shared_ptr<RenderablePolyVoxEntityItem> makeVolume(PolyVoxEntityItem::PolyVoxSurfaceStyle surfaceStyle) {
+    auto entity = std::make_shared<RenderablePolyVoxEntityItem>(EntityItemID(QUuid::createUuid()));
+    entity->setVoxelSurfaceStyle(surfaceStyle);
+    // edged volumes keep an extra layer of voxels on each side
+    entity->setVoxelVolumeSize(glm::vec3(PolyVoxEntityItem::isEdged(surfaceStyle) ? 30.0f : 32.0f));
+    entity->withWriteLock([&] {
+        // everything starts out needing to be meshed
+        entity->takeDirtyMeshChunks();
+    });
+    return entity;
+}
+
+std::vector<size_t> edit(RenderablePolyVoxEntityItem& entity, const glm::ivec3& voxel, uint8_t value = 255) {
+    std::vector<size_t> dirtyChunks;
+    entity.withWriteLock([&] {
+        entity.setVoxelInternal(voxel, value);
+        dirtyChunks = entity.takeDirtyMeshChunks();
+    });
+    return dirtyChunks;
+}
+
+size_t chunkIndex(int x, int y, int z) {
+    return (z * 2 + y) * 2 + x;
+}
+
+}
+
+void PolyVoxMeshChunkTests::testInteriorEdit() {
+    auto entity = makeVolume(PolyVoxEntityItem::SURFACE_MARCHING_CUBES);
+    QCOMPARE(edit(*entity, { 5, 5, 5 }), std::vector<size_t>({ chunkIndex(0, 0, 0) }));
+    QCOMPARE(edit(*entity, { 24, 5, 24 }), std::vector<size_t>({ chunkIndex(1, 0, 1) }));
+}
+
+void PolyVoxMeshChunkTests::testChunkBoundaryEdit() {
+    auto entity = makeVolume(PolyVoxEntityItem::SURFACE_MARCHING_CUBES);
+
+    // the voxels at 16 are in the meshes of the chunks on both sides
+    QCOMPARE(edit(*entity, { 16, 5, 5 }), std::vector<size_t>({ chunkIndex(0, 0, 0), chunkIndex(1, 0, 0) }));
+    QCOMPARE(edit(*entity, { 5, 5, 16 }), std::vector<size_t>({ chunkIndex(0, 0, 0), chunkIndex(0, 0, 1) }));
+
+    // and those next to them are in the normals and hulls of both
+    QCOMPARE(edit(*entity, { 5, 15, 5 }), std::vector<size_t>({ chunkIndex(0, 0, 0), chunkIndex(0, 1, 0) }));
+    QCOMPARE(edit(*entity, { 5, 17, 5 }), std::vector<size_t>({ chunkIndex(0, 0, 0), chunkIndex(0, 1, 0) }));
+    QCOMPARE(edit(*entity, { 5, 18, 5 }), std::vector<size_t>({ chunkIndex(0, 1, 0) }));
+}
+
+void PolyVoxMeshChunkTests::testChunkCornerEdit() {
+    auto entity = makeVolume(PolyVoxEntityItem::SURFACE_CUBIC);
+    QCOMPARE(edit(*entity, { 16, 16, 16 }).size(), (size_t)8);
+}
+
+void PolyVoxMeshChunkTests::testEdgedChunkBoundaryEdit() {
+    // with the extra layer, user voxel 15 is at 16 in _volData
+    auto entity = makeVolume(PolyVoxEntityItem::SURFACE_EDGED_CUBIC);
+    QCOMPARE(edit(*entity, { 15, 4, 4 }), std::vector<size_t>({ chunkIndex(0, 0, 0), chunkIndex(1, 0, 0) }));
+}
+
+void PolyVoxMeshChunkTests::testUnchangedVoxel() {
+    auto entity = makeVolume(PolyVoxEntityItem::SURFACE_MARCHING_CUBES);
+    edit(*entity, { 16, 5, 5 });
+    QVERIFY(edit(*entity, { 16, 5, 5 }).empty());
+}
@@ -0,0 +1,26 @@
+//
+//  PolyVoxMeshChunkTests.h
+//  tests/entities-renderer/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PolyVoxMeshChunkTests_h
+#define hifi_PolyVoxMeshChunkTests_h
+
+#include <QtCore/QObject>
+
+class PolyVoxMeshChunkTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testInteriorEdit();
+    void testChunkBoundaryEdit();
+    void testChunkCornerEdit();
+    void testEdgedChunkBoundaryEdit();
+    void testUnchangedVoxel();
+};
+
+#endif // hifi_PolyVoxMeshChunkTests_h
@@ -0,0 +1,135 @@
+//
+//  BinaryModelTests.cpp
+//  tests/model-baker/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BinaryModelTests.h"
+
+#include <model-baker/BinaryModel.h>
+
+QTEST_MAIN(BinaryModelTests)
+
+static hfm::Model createModel() {
+    hfm::Model model;
+    model.originalURL = "file:///models/test.fbx";
+    model.author = "test";
+
+    hfm::Joint joint;
+    joint.name = "Hips";
+    joint.parentIndex = -1;
+    joint.translation = glm::vec3(0.0f, 1.0f, 0.0f);
+    joint.rotation = glm::angleAxis(0.5f, glm::vec3(0.0f, 1.0f, 0.0f));
+    joint.isSkeletonJoint = true;
+    joint.shapeInfo.points.push_back(glm::vec3(1.0f, 2.0f, 3.0f));
+    model.joints.push_back(joint);
+    model.jointIndices.insert(joint.name, 1);
+    model.hasSkeletonJoints = true;
+
+    hfm::Mesh mesh;
+    mesh.vertices << glm::vec3(0.0f) << glm::vec3(1.0f, 0.0f, 0.0f) << glm::vec3(0.0f, 0.0f, 1.0f);
+    mesh.normals << glm::vec3(0.0f, 1.0f, 0.0f) << glm::vec3(0.0f, 1.0f, 0.0f) << glm::vec3(0.0f, 1.0f, 0.0f);
+    mesh.texCoords << glm::vec2(0.0f) << glm::vec2(1.0f, 0.0f) << glm::vec2(0.0f, 1.0f);
+    mesh.clusterIndices << 0 << 0 << 0;
+    hfm::MeshPart part;
+    part.triangleIndices << 0 << 1 << 2;
+    part.materialID = "material";
+    mesh.parts.push_back(part);
+    hfm::Cluster cluster;
+    cluster.jointIndex = 0;
+    cluster.inverseBindMatrix = glm::mat4();
+    cluster.inverseBindTransform.setTranslation(glm::vec3(0.0f, -1.0f, 0.0f));
+    mesh.clusters.push_back(cluster);
+    hfm::Blendshape blendshape;
+    blendshape.indices << 2;
+    blendshape.vertices << glm::vec3(0.0f, 0.5f, 1.0f);
+    mesh.blendshapes.push_back(blendshape);
+    mesh.meshExtents = Extents(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 1.0f));
+    mesh.meshIndex = 0;
+    model.meshes.push_back(mesh);
+    model.meshIndicesToModelNames.insert(0, "Body");
+
+    hfm::Material material;
+    material.materialID = "material";
+    material.name = "material";
+    material.diffuseColor = glm::vec3(0.5f, 0.25f, 1.0f);
+    material.albedoTexture.filename = "albedo.png";
+    material.albedoTexture.transform.setScale(glm::vec3(2.0f, 1.0f, 1.0f));
+    material._material = std::make_shared<graphics::Material>();
+    material._material->setAlbedo(material.diffuseColor);
+    material._material->setMetallic(0.25f);
+    model.materials.insert(material.materialID, material);
+
+    model.blendshapeChannelNames << "Smile";
+    model.flowData._physicsConfig.insert("hair", QVariantMap { { "active", true } });
+    return model;
+}
+
+void BinaryModelTests::testRoundTrip() {
+    hfm::Model model = createModel();
+    hifi::ByteArray data = baker::writeBinaryModel(model);
+
+    auto result = baker::readBinaryModel(data.constData(), data.size());
+    QVERIFY(result != nullptr);
+
+    QCOMPARE(result->originalURL, model.originalURL);
+    QCOMPARE(result->author, model.author);
+    QCOMPARE(result->joints.size(), 1);
+    QCOMPARE(result->joints[0].name, model.joints[0].name);
+    QCOMPARE(result->joints[0].rotation, model.joints[0].rotation);
+    QCOMPARE(result->joints[0].shapeInfo.points, model.joints[0].shapeInfo.points);
+    QCOMPARE(result->jointIndices, model.jointIndices);
+    QCOMPARE(result->hasSkeletonJoints, true);
+
+    QCOMPARE(result->meshes.size(), 1);
+    const auto& mesh = result->meshes[0];
+    QCOMPARE(mesh.vertices, model.meshes[0].vertices);
+    QCOMPARE(mesh.normals, model.meshes[0].normals);
+    QCOMPARE(mesh.texCoords, model.meshes[0].texCoords);
+    QCOMPARE(mesh.clusterIndices, model.meshes[0].clusterIndices);
+    QCOMPARE(mesh.parts.size(), 1);
+    QCOMPARE(mesh.parts[0].triangleIndices, model.meshes[0].parts[0].triangleIndices);
+    QCOMPARE(mesh.parts[0].materialID, model.meshes[0].parts[0].materialID);
+    QCOMPARE(mesh.clusters.size(), 1);
+    QCOMPARE(mesh.clusters[0].inverseBindTransform, model.meshes[0].clusters[0].inverseBindTransform);
+    QCOMPARE(mesh.blendshapes.size(), 1);
+    QCOMPARE(mesh.blendshapes[0].indices, model.meshes[0].blendshapes[0].indices);
+    QCOMPARE(mesh.blendshapes[0].vertices, model.meshes[0].blendshapes[0].vertices);
+    QCOMPARE(mesh.meshExtents.maximum, model.meshes[0].meshExtents.maximum);
+    QCOMPARE(result->meshIndicesToModelNames, model.meshIndicesToModelNames);
+
+    QCOMPARE(result->materials.size(), 1);
+    const auto& material = result->materials["material"];
+    QCOMPARE(material.diffuseColor, model.materials["material"].diffuseColor);
+    QCOMPARE(material.albedoTexture.filename, model.materials["material"].albedoTexture.filename);
+    QCOMPARE(material.albedoTexture.transform, model.materials["material"].albedoTexture.transform);
+    QVERIFY(material._material != nullptr);
+    QCOMPARE(material._material->getKey().isAlbedo(), true);
+    QCOMPARE(material._material->getKey().isMetallic(), true);
+    QCOMPARE(material._material->getMetallic(), 0.25f);
+
+    QCOMPARE(result->blendshapeChannelNames, model.blendshapeChannelNames);
+    QCOMPARE(result->flowData._physicsConfig, model.flowData._physicsConfig);
+}
+
+void BinaryModelTests::testRejectsCorruptData() {
+    hifi::ByteArray data = baker::writeBinaryModel(createModel());
+
+    // truncated
+    QVERIFY(baker::readBinaryModel(data.constData(), data.size() / 2) == nullptr);
+    QVERIFY(baker::readBinaryModel(data.constData(), 4) == nullptr);
+
+    // wrong version
+    hifi::ByteArray wrongVersion = data;
+    wrongVersion[4] = (char)(wrongVersion[4] + 1);
+    QVERIFY(baker::readBinaryModel(wrongVersion.constData(), wrongVersion.size()) == nullptr);
+
+    // a corrupt element count
+    hifi::ByteArray corruptCount = data;
+    memset(corruptCount.data() + 16, 0xff, 4);
+    QVERIFY(baker::readBinaryModel(corruptCount.constData(), corruptCount.size()) == nullptr);
+}
@@ -0,0 +1,23 @@
+//
+//  BinaryModelTests.h
+//  tests/model-baker/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BinaryModelTests_h
+#define hifi_BinaryModelTests_h
+
+#include <QtTest/QtTest>
+
+class BinaryModelTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testRoundTrip();
+    void testRejectsCorruptData();
+};
+
+#endif // hifi_BinaryModelTests_h
@@ -0,0 +1,240 @@
+//
+//  MeshKernelsTests.cpp
+//  tests/model-baker/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshKernelsTests.h"
+
+#include <chrono>
+
+#include <glm/gtx/quaternion.hpp>
+
+#include <SharedUtil.h>
+#include <NumericalConstants.h>
+#include <model-baker/MeshKernels.h>
+#include <model-baker/ModelMath.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(MeshKernelsTests)
+
+const float KERNEL_TOLERANCE = 1.0e-4f;
+
+// The per-vertex glm implementation the kernels replaced, used as the reference
+static void referenceNormals(const hfm::Mesh& mesh, const QVector<glm::vec3>& positions, std::vector<glm::vec3>& normals) {
+    for (const auto& part : mesh.parts) {
+        for (int i = 0; i < part.quadIndices.size(); i += 4) {
+            const glm::vec3& v0 = positions[part.quadIndices[i]];
+            glm::vec3 normal = glm::cross(positions[part.quadIndices[i + 1]] - v0, positions[part.quadIndices[i + 2]] - v0);
+            for (int k = 0; k < 4; k++) {
+                normals[part.quadIndices[i + k]] = normal;
+            }
+        }
+        for (int i = 0; i <= part.triangleIndices.size() - 3; i += 3) {
+            const glm::vec3& v0 = positions[part.triangleIndices[i]];
+            glm::vec3 normal = glm::cross(positions[part.triangleIndices[i + 1]] - v0, positions[part.triangleIndices[i + 2]] - v0);
+            for (int k = 0; k < 3; k++) {
+                normals[part.triangleIndices[i + k]] = normal;
+            }
+        }
+    }
+}
+
+static glm::vec3 referenceEdgeTangent(const glm::vec3& normal, const glm::vec3& edge, const glm::vec2& texCoordDelta) {
+    glm::vec3 bitangent = glm::cross(normal, edge);
+    if (glm::length(bitangent) < EPSILON) {
+        return glm::vec3();
+    }
+    glm::vec3 normalizedNormal = glm::normalize(normal);
+    return glm::cross(glm::angleAxis(-atan2f(-texCoordDelta.t, texCoordDelta.s), normalizedNormal) *
+        glm::normalize(bitangent), normalizedNormal);
+}
+
+static void referenceTangents(const hfm::Mesh& mesh, const std::vector<glm::vec3>& normals, std::vector<glm::vec3>& tangents) {
+    auto addTangent = [&](int first, int second) {
+        tangents[first] += referenceEdgeTangent(normals[first], mesh.vertices[second] - mesh.vertices[first],
+            mesh.texCoords[second] - mesh.texCoords[first]);
+    };
+    for (const auto& part : mesh.parts) {
+        for (int i = 0; i < part.quadIndices.size(); i += 4) {
+            for (int k = 0; k < 4; k++) {
+                addTangent(part.quadIndices[i + k], part.quadIndices[i + (k + 1) % 4]);
+            }
+        }
+        for (int i = 0; i <= part.triangleIndices.size() - 3; i += 3) {
+            for (int k = 0; k < 3; k++) {
+                addTangent(part.triangleIndices[i + k], part.triangleIndices[i + (k + 1) % 3]);
+            }
+        }
+    }
+}
+
+// A bumpy grid, split into a part made of quads and a part made of triangles
+static hfm::Mesh createGridMesh(int size) {
+    hfm::Mesh mesh;
+    for (int y = 0; y <= size; y++) {
+        for (int x = 0; x <= size; x++) {
+            glm::vec2 uv((float)x / size, (float)y / size);
+            mesh.vertices.push_back(glm::vec3(uv.x, randFloatInRange(-0.05f, 0.05f), uv.y));
+            mesh.texCoords.push_back(uv);
+        }
+    }
+
+    hfm::MeshPart quadPart;
+    hfm::MeshPart trianglePart;
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            int i0 = y * (size + 1) + x;
+            int i1 = i0 + 1;
+            int i2 = i1 + size + 1;
+            int i3 = i0 + size + 1;
+            if (y < size / 2) {
+                quadPart.quadIndices << i0 << i1 << i2 << i3;
+            } else {
+                trianglePart.triangleIndices << i0 << i1 << i2 << i0 << i2 << i3;
+            }
+        }
+    }
+    mesh.parts << quadPart << trianglePart;
+    return mesh;
+}
+
+static void fillRandom(baker::Vec3Batch& batch) {
+    for (size_t i = 0; i < batch.size(); i++) {
+        batch.x[i] = randFloatInRange(-1.0f, 1.0f);
+        batch.y[i] = randFloatInRange(-1.0f, 1.0f);
+        batch.z[i] = randFloatInRange(-1.0f, 1.0f);
+    }
+}
+
+void MeshKernelsTests::testFaceNormals() {
+    // an odd count exercises the scalar tail of the SIMD kernels
+    const int COUNT = 1027;
+    baker::Vec3Batch a, b, c, normals;
+    a.resize(COUNT);
+    b.resize(COUNT);
+    c.resize(COUNT);
+    normals.resize(COUNT);
+    fillRandom(a);
+    fillRandom(b);
+    fillRandom(c);
+
+    baker::faceNormals(a.x.data(), a.y.data(), a.z.data(), b.x.data(), b.y.data(), b.z.data(),
+        c.x.data(), c.y.data(), c.z.data(), normals.x.data(), normals.y.data(), normals.z.data(), COUNT);
+
+    for (int i = 0; i < COUNT; i++) {
+        glm::vec3 v0(a.x[i], a.y[i], a.z[i]);
+        glm::vec3 expected = glm::cross(glm::vec3(b.x[i], b.y[i], b.z[i]) - v0, glm::vec3(c.x[i], c.y[i], c.z[i]) - v0);
+        QCOMPARE_WITH_ABS_ERROR(glm::vec3(normals.x[i], normals.y[i], normals.z[i]), expected, KERNEL_TOLERANCE);
+    }
+}
+
+void MeshKernelsTests::testEdgeTangents() {
+    const int COUNT = 1027;
+    baker::Vec3Batch normals, edges, tangents;
+    normals.resize(COUNT);
+    edges.resize(COUNT);
+    tangents.resize(COUNT);
+    fillRandom(normals);
+    fillRandom(edges);
+    std::vector<float> ds(COUNT);
+    std::vector<float> dt(COUNT);
+    for (int i = 0; i < COUNT; i++) {
+        ds[i] = randFloatInRange(-1.0f, 1.0f);
+        dt[i] = randFloatInRange(-1.0f, 1.0f);
+    }
+    // degenerate cases: an edge parallel to the normal, and a zero texture coordinate delta
+    edges.x[0] = normals.x[0];
+    edges.y[0] = normals.y[0];
+    edges.z[0] = normals.z[0];
+    ds[1] = dt[1] = 0.0f;
+
+    baker::edgeTangents(normals.x.data(), normals.y.data(), normals.z.data(), edges.x.data(), edges.y.data(), edges.z.data(),
+        ds.data(), dt.data(), tangents.x.data(), tangents.y.data(), tangents.z.data(), COUNT);
+
+    for (int i = 0; i < COUNT; i++) {
+        glm::vec3 expected = referenceEdgeTangent(glm::vec3(normals.x[i], normals.y[i], normals.z[i]),
+            glm::vec3(edges.x[i], edges.y[i], edges.z[i]), glm::vec2(ds[i], dt[i]));
+        QCOMPARE_WITH_ABS_ERROR(glm::vec3(tangents.x[i], tangents.y[i], tangents.z[i]), expected, KERNEL_TOLERANCE);
+    }
+}
+
+void MeshKernelsTests::testMeshNormalsAndTangents() {
+    hfm::Mesh mesh = createGridMesh(33);
+
+    std::vector<glm::vec3> expectedNormals(mesh.vertices.size());
+    referenceNormals(mesh, mesh.vertices, expectedNormals);
+    std::vector<glm::vec3> normals(mesh.vertices.size());
+    baker::calculateNormals(mesh, mesh.vertices, baker::AttributeIndexMap(), normals);
+    for (size_t i = 0; i < normals.size(); i++) {
+        QCOMPARE_WITH_ABS_ERROR(normals[i], expectedNormals[i], KERNEL_TOLERANCE);
+    }
+
+    std::vector<glm::vec3> expectedTangents(normals.size());
+    referenceTangents(mesh, normals, expectedTangents);
+    std::vector<glm::vec3> tangents(normals.size());
+    baker::calculateTangents(mesh, mesh.vertices, baker::AttributeIndexMap(), normals, tangents);
+    for (size_t i = 0; i < tangents.size(); i++) {
+        QCOMPARE_WITH_ABS_ERROR(tangents[i], expectedTangents[i], KERNEL_TOLERANCE);
+    }
+}
+
+void MeshKernelsTests::testBlendshapeNormals() {
+    hfm::Mesh mesh = createGridMesh(17);
+
+    // a blendshape that moves every vertex, stored in reverse order
+    hfm::Blendshape blendshape;
+    QVector<glm::vec3> expectedPositions = mesh.vertices;
+    for (int i = mesh.vertices.size() - 1; i >= 0; i--) {
+        glm::vec3 position = mesh.vertices[i] + glm::vec3(0.0f, randFloatInRange(-0.1f, 0.1f), 0.0f);
+        blendshape.indices.push_back(i);
+        blendshape.vertices.push_back(position);
+        expectedPositions[i] = position;
+    }
+
+    baker::AttributeIndexMap attributeIndices;
+    QVector<glm::vec3> positions;
+    baker::prepareBlendshape(mesh, blendshape, attributeIndices, positions);
+    QCOMPARE(positions, expectedPositions);
+
+    std::vector<glm::vec3> expectedNormals(mesh.vertices.size());
+    referenceNormals(mesh, expectedPositions, expectedNormals);
+    std::vector<glm::vec3> normals(mesh.vertices.size());
+    baker::calculateNormals(mesh, positions, attributeIndices, normals);
+    for (int i = 0; i < mesh.vertices.size(); i++) {
+        QCOMPARE_WITH_ABS_ERROR(normals[attributeIndices[i]], expectedNormals[i], KERNEL_TOLERANCE);
+    }
+}
+
+void MeshKernelsTests::meshPerf() {
+    const int NUM_ITERATIONS = 10;
+    hfm::Mesh mesh = createGridMesh(512);
+    std::vector<glm::vec3> normals(mesh.vertices.size());
+    std::vector<glm::vec3> tangents(mesh.vertices.size());
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        referenceNormals(mesh, mesh.vertices, normals);
+        std::fill(tangents.begin(), tangents.end(), glm::vec3());
+        referenceTangents(mesh, normals, tangents);
+    }
+    auto referenceTime = std::chrono::high_resolution_clock::now() - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        baker::calculateNormals(mesh, mesh.vertices, baker::AttributeIndexMap(), normals);
+        std::fill(tangents.begin(), tangents.end(), glm::vec3());
+        baker::calculateTangents(mesh, mesh.vertices, baker::AttributeIndexMap(), normals, tangents);
+    }
+    auto kernelTime = std::chrono::high_resolution_clock::now() - start;
+
+    qDebug() << "normals and tangents for" << mesh.vertices.size() << "vertices: reference ="
+        << std::chrono::duration<double, std::milli>(referenceTime).count() / NUM_ITERATIONS << "ms, kernels ="
+        << std::chrono::duration<double, std::milli>(kernelTime).count() / NUM_ITERATIONS << "ms";
+}
@@ -0,0 +1,26 @@
+//
+//  MeshKernelsTests.h
+//  tests/model-baker/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MeshKernelsTests_h
+#define hifi_MeshKernelsTests_h
+
+#include <QtTest/QtTest>
+
+class MeshKernelsTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testFaceNormals();
+    void testEdgeTangents();
+    void testMeshNormalsAndTangents();
+    void testBlendshapeNormals();
+    void meshPerf();
+};
+
+#endif // hifi_MeshKernelsTests_h
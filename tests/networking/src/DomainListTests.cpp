@@ -0,0 +1,139 @@
+//
+//  DomainListTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListTests.h"
+
+#include <vector>
+
+#include <DependencyManager.h>
+#include <LimitedNodeList.h>
+#include <NodeList.h>
+#include <ReceivedMessage.h>
+#include <SharedUtil.h>
+#include <StatTracker.h>
+
+QTEST_MAIN(DomainListTests)
+
+namespace {
+
+const QUuid DOMAIN_ID = QUuid::createUuid();
+const Node::LocalID DOMAIN_LOCAL_ID = 1;
+const QUuid SESSION_ID = QUuid::createUuid();
+const Node::LocalID SESSION_LOCAL_ID = 2;
+const HifiSockAddr DOMAIN_SOCKET(QHostAddress::LocalHost, 40102);
+
+const QUuid MIXER_ID = QUuid::createUuid();
+const Node::LocalID MIXER_LOCAL_ID = 3;
+const HifiSockAddr MIXER_SOCKET(QHostAddress::LocalHost, 48000);
+
+// a DomainList the way the domain-server writes it, in a single packet
+QSharedPointer<ReceivedMessage> domainList(quint64 baseEpoch, quint64 epoch, const std::vector<QUuid>& addedNodes,
+                                           const std::vector<QUuid>& removedNodes = {}) {
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+
+    stream << DOMAIN_ID << DOMAIN_LOCAL_ID << SESSION_ID << SESSION_LOCAL_ID;
+    stream << NodePermissions() << false;
+    stream << quint64(usecTimestampNow()) << quint64(usecTimestampNow()) << quint64(0) << false;
+    stream << baseEpoch << epoch << quint32(addedNodes.size() + removedNodes.size());
+
+    quint32 recordIndex = 0;
+    for (auto& nodeID : addedNodes) {
+        stream << recordIndex++ << quint8(LimitedNodeList::DomainListNode);
+        stream << NodeType_t(NodeType::AudioMixer) << nodeID << MIXER_SOCKET << MIXER_SOCKET << NodePermissions() << false
+               << MIXER_LOCAL_ID << QUuid::createUuid();
+    }
+    for (auto& nodeID : removedNodes) {
+        stream << recordIndex++ << quint8(LimitedNodeList::DomainListRemovedNode) << nodeID;
+    }
+
+    return QSharedPointer<ReceivedMessage>::create(data, PacketType::DomainList, versionForPacketType(PacketType::DomainList),
+                                                   DOMAIN_SOCKET);
+}
+
+}
+
+void DomainListTests::initTestCase() {
+    DependencyManager::set<StatTracker>();
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::Agent, INVALID_PORT);
+
+    // pretend we are already connected, so the lists are taken as coming from our domain-server
+    auto& domainHandler = DependencyManager::get<NodeList>()->getDomainHandler();
+    domainHandler.setSockAddr(DOMAIN_SOCKET, QString());
+    domainHandler.setUUID(DOMAIN_ID);
+    domainHandler.setIsConnected(true);
+}
+
+void DomainListTests::init() {
+    DependencyManager::get<NodeList>()->reset("Next test", true);
+}
+
+void DomainListTests::testDelta() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    QCOMPARE(nodeList->getDomainListEpoch(), (quint64)0);
+
+    nodeList->processDomainServerList(domainList(0, 3, { MIXER_ID }));
+    QVERIFY(nodeList->nodeWithUUID(MIXER_ID));
+    QCOMPARE(nodeList->getDomainListEpoch(), (quint64)3);
+
+    // an empty delta still moves us up
+    nodeList->processDomainServerList(domainList(3, 4, {}));
+    QCOMPARE(nodeList->getDomainListEpoch(), (quint64)4);
+
+    // a delta from an epoch we aren't at doesn't
+    nodeList->processDomainServerList(domainList(6, 7, {}));
+    QCOMPARE(nodeList->getDomainListEpoch(), (quint64)4);
+}
+
+void DomainListTests::testDomainServerRemoval() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->processDomainServerList(domainList(0, 3, { MIXER_ID }));
+    QVERIFY(nodeList->nodeWithUUID(MIXER_ID));
+
+    // the removal is one of the domain-server's changes, so it doesn't cost us our epoch
+    nodeList->processDomainServerList(domainList(3, 4, {}, { MIXER_ID }));
+    QVERIFY(!nodeList->nodeWithUUID(MIXER_ID));
+    QCOMPARE(nodeList->getDomainListEpoch(), (quint64)4);
+}
+
+void DomainListTests::testSilentNodeRestored() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->processDomainServerList(domainList(0, 3, { MIXER_ID }));
+    QCOMPARE(nodeList->getDomainListEpoch(), (quint64)3);
+
+    auto mixer = nodeList->nodeWithUUID(MIXER_ID);
+    QVERIFY(mixer);
+    mixer->setLastHeardMicrostamp(0);
+    mixer.reset();
+    nodeList->removeSilentNodes();
+    QVERIFY(!nodeList->nodeWithUUID(MIXER_ID));
+
+    // the domain-server has no change for the mixer, so only a full list brings it back
+    QCOMPARE(nodeList->getDomainListEpoch(), (quint64)0);
+    nodeList->processDomainServerList(domainList(0, 3, { MIXER_ID }));
+    QVERIFY(nodeList->nodeWithUUID(MIXER_ID));
+    QCOMPARE(nodeList->getDomainListEpoch(), (quint64)3);
+}
+
+void DomainListTests::testKilledNodeRestored() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->processDomainServerList(domainList(0, 3, { MIXER_ID }));
+    QVERIFY(nodeList->killNodeWithUUID(MIXER_ID));
+    QCOMPARE(nodeList->getDomainListEpoch(), (quint64)0);
+
+    // a delta that was already on its way doesn't apply once we've asked for the full list
+    nodeList->processDomainServerList(domainList(3, 4, {}));
+    QCOMPARE(nodeList->getDomainListEpoch(), (quint64)0);
+
+    nodeList->processDomainServerList(domainList(0, 4, { MIXER_ID }));
+    QVERIFY(nodeList->nodeWithUUID(MIXER_ID));
+    QCOMPARE(nodeList->getDomainListEpoch(), (quint64)4);
+}
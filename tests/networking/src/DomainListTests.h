@@ -0,0 +1,27 @@
+//
+//  DomainListTests.h
+//  tests/networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListTests_h
+#define hifi_DomainListTests_h
+
+#include <QtTest/QtTest>
+
+class DomainListTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void init();
+    void testDelta();
+    void testDomainServerRemoval();
+    void testSilentNodeRestored();
+    void testKilledNodeRestored();
+};
+
+#endif // hifi_DomainListTests_h
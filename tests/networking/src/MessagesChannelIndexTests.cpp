@@ -0,0 +1,206 @@
+//
+//  MessagesChannelIndexTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MessagesChannelIndexTests.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <MessagesChannelIndex.h>
+#include <MessagesClient.h>
+
+QTEST_MAIN(MessagesChannelIndexTests)
+
+void MessagesChannelIndexTests::testSubscribe() {
+    MessagesChannelIndex index;
+    QUuid first = QUuid::createUuid();
+    QUuid second = QUuid::createUuid();
+
+    QCOMPARE(index.find("game"), MessagesChannelIndex::INVALID_CHANNEL);
+    QVERIFY(index.subscribe("game", first));
+    QVERIFY(!index.subscribe("game", first));
+    QVERIFY(index.subscribe("game", second));
+    QVERIFY(index.subscribe("chat", second));
+    QCOMPARE(index.getNumChannels(), (size_t)2);
+
+    auto game = index.find("game");
+    QVERIFY(game != MessagesChannelIndex::INVALID_CHANNEL);
+    QCOMPARE(index.getSubscribers(game).size(), (size_t)2);
+
+    QVERIFY(index.unsubscribe("game", first));
+    QVERIFY(!index.unsubscribe("game", first));
+    QVERIFY(!index.unsubscribe("missing", first));
+    QCOMPARE(index.getSubscribers(game).size(), (size_t)1);
+    QCOMPARE(index.getSubscribers(game)[0], second);
+
+    // the empty channel is a channel like any other
+    QVERIFY(index.subscribe(QByteArray(), first));
+    QVERIFY(index.find("") != MessagesChannelIndex::INVALID_CHANNEL);
+}
+
+void MessagesChannelIndexTests::testRemoveSubscriber() {
+    MessagesChannelIndex index;
+    std::vector<QUuid> nodes;
+    for (int i = 0; i < 5; ++i) {
+        nodes.push_back(QUuid::createUuid());
+        index.subscribe("all", nodes.back());
+        if (i % 2 == 0) {
+            index.subscribe("even", nodes.back());
+        }
+    }
+
+    index.removeSubscriber(nodes[2]);
+    index.removeSubscriber(QUuid::createUuid());
+
+    const auto& all = index.getSubscribers(index.find("all"));
+    const auto& even = index.getSubscribers(index.find("even"));
+    QCOMPARE(all.size(), (size_t)4);
+    QCOMPARE(even.size(), (size_t)2);
+    QVERIFY(std::find(all.begin(), all.end(), nodes[2]) == all.end());
+    QVERIFY(std::find(even.begin(), even.end(), nodes[2]) == even.end());
+
+    // a removed node can subscribe again
+    QVERIFY(index.subscribe("even", nodes[2]));
+    QCOMPARE(index.getSubscribers(index.find("even")).size(), (size_t)3);
+}
+
+void MessagesChannelIndexTests::testRecycleChannels() {
+    MessagesChannelIndex index;
+    QUuid node = QUuid::createUuid();
+    index.subscribe("short-lived", node);
+    index.subscribe("kept", node);
+    auto shortLived = index.find("short-lived");
+    auto kept = index.find("kept");
+
+    index.recordMessage(kept, 100, 3);
+    index.recordMessage(kept, 50, 2);
+    index.recordUnsubscribedMessage(10);
+    QCOMPARE(index.getChannel(kept).numMessages, (quint64)2);
+    QCOMPARE(index.getChannel(kept).numBytesIn, (quint64)150);
+    QCOMPARE(index.getChannel(kept).numDeliveries, (quint64)5);
+    QCOMPARE(index.getChannel(kept).numBytesOut, (quint64)400);
+    QCOMPARE(index.getNumUnsubscribedMessages(), (quint64)1);
+
+    // a channel without subscribers keeps its ID until the stats are reset
+    index.unsubscribe("short-lived", node);
+    QCOMPARE(index.find("short-lived"), shortLived);
+    index.resetStats();
+    QCOMPARE(index.find("short-lived"), MessagesChannelIndex::INVALID_CHANNEL);
+    QVERIFY(!index.isLive(shortLived));
+    QCOMPARE(index.getNumChannels(), (size_t)1);
+    QCOMPARE(index.getChannel(kept).numMessages, (quint64)0);
+    QCOMPARE(index.getNumUnsubscribedMessages(), (quint64)0);
+
+    // and its ID goes to the next new channel
+    index.subscribe("new", node);
+    QCOMPARE(index.find("new"), shortLived);
+    QCOMPARE(index.getNumChannelSlots(), (size_t)2);
+}
+
+void MessagesChannelIndexTests::testPayload() {
+    QUuid sender = QUuid::createUuid();
+    QByteArray payload = MessagesClient::encodeMessagesPayload("channel", true, "hello", sender);
+
+    QByteArray channel;
+    QVERIFY(MessagesClient::decodeMessagesChannel(payload, channel));
+    QCOMPARE(channel, QByteArray("channel"));
+
+    // it decodes as a whole message too
+    auto message = QSharedPointer<ReceivedMessage>::create(payload, PacketType::MessagesData, 0, HifiSockAddr());
+    QString decodedChannel, text;
+    QByteArray data;
+    QUuid senderID;
+    bool isText { false };
+    MessagesClient::decodeMessagesPacket(message, decodedChannel, isText, text, data, senderID);
+    QCOMPARE(decodedChannel, QString("channel"));
+    QVERIFY(isText);
+    QCOMPARE(text, QString("hello"));
+    QCOMPARE(senderID, sender);
+
+    // anything short of the sender ID is incomplete
+    for (int size = 0; size < payload.size(); ++size) {
+        QVERIFY(!MessagesClient::decodeMessagesChannel(payload.left(size), channel));
+    }
+}
+
+void MessagesChannelIndexTests::pubSubPerf() {
+    // a domain full of scripts: most nodes listen to a few popular channels, the rest are scattered thinly
+    const int NUM_NODES = 1000;
+    const int NUM_CHANNELS = 200;
+    const int CHANNELS_PER_NODE = 8;
+    const int NUM_MESSAGES = 2000;
+    const int MESSAGE_SIZE = 100;
+
+    std::mt19937 generator(7);
+    std::geometric_distribution<int> popularity(0.1);
+    auto pickChannel = [&] {
+        return std::min(popularity(generator), NUM_CHANNELS - 1);
+    };
+
+    std::vector<QUuid> nodes;
+    QHash<QString, QSet<QUuid>> channelSubscribers;
+    MessagesChannelIndex index;
+    for (int i = 0; i < NUM_NODES; ++i) {
+        nodes.push_back(QUuid::createUuid());
+        for (int j = 0; j < CHANNELS_PER_NODE; ++j) {
+            QString channel = QString("channel-%1").arg(pickChannel());
+            channelSubscribers[channel] << nodes.back();
+            index.subscribe(channel.toUtf8(), nodes.back());
+        }
+    }
+
+    std::vector<QString> channels;
+    for (int i = 0; i < NUM_MESSAGES; ++i) {
+        channels.push_back(QString("channel-%1").arg(pickChannel()));
+    }
+    QString text(MESSAGE_SIZE, 'x');
+    QUuid sender = nodes[0];
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    // every node checked against a set, and the message encoded again for each subscriber
+    size_t legacyDeliveries = 0;
+    auto start = Clock::now();
+    for (const auto& channel : channels) {
+        for (const auto& node : nodes) {
+            if (channelSubscribers[channel].contains(node)) {
+                auto packetList = MessagesClient::encodeMessagesPacket(channel, text, sender);
+                legacyDeliveries += packetList->getNumPackets();
+            }
+        }
+    }
+    auto legacyTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+
+    // the channel found once, the payload shared
+    size_t indexedDeliveries = 0;
+    start = Clock::now();
+    for (const auto& channel : channels) {
+        QByteArray payload = MessagesClient::encodeMessagesPayload(channel.toUtf8(), true, text.toUtf8(), sender);
+        QByteArray channelUtf8;
+        MessagesClient::decodeMessagesChannel(payload, channelUtf8);
+        auto id = index.find(channelUtf8);
+        if (id == MessagesChannelIndex::INVALID_CHANNEL) {
+            continue;
+        }
+        for (size_t i = 0; i < index.getSubscribers(id).size(); ++i) {
+            auto packetList = MessagesClient::createMessagesPacketList(payload);
+            indexedDeliveries += packetList->getNumPackets();
+        }
+        index.recordMessage(id, payload.size(), (int)index.getSubscribers(id).size());
+    }
+    auto indexedTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+
+    QCOMPARE(indexedDeliveries, legacyDeliveries);
+    qDebug() << NUM_MESSAGES << "messages," << legacyDeliveries << "deliveries to" << NUM_NODES << "nodes";
+    qDebug() << "    scan and encode per subscriber:" << legacyTime << "usec";
+    qDebug() << "    indexed, encoded once:" << indexedTime << "usec";
+}
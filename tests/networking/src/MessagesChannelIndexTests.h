@@ -0,0 +1,26 @@
+//
+//  MessagesChannelIndexTests.h
+//  tests/networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MessagesChannelIndexTests_h
+#define hifi_MessagesChannelIndexTests_h
+
+#include <QtTest/QtTest>
+
+class MessagesChannelIndexTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testSubscribe();
+    void testRemoveSubscriber();
+    void testRecycleChannels();
+    void testPayload();
+    void pubSubPerf();
+};
+
+#endif // hifi_MessagesChannelIndexTests_h
@@ -0,0 +1,299 @@
+//
+//  ResourceSchedulerTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceSchedulerTests.h"
+
+#include <cfloat>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <DependencyManager.h>
+#include <ResourceCache.h>
+
+QTEST_MAIN(ResourceSchedulerTests)
+
+using Protocol = ResourceCacheSharedItems::Protocol;
+using ResourcePointer = QSharedPointer<Resource>;
+
+static QObject* owner { nullptr };
+
+static ResourcePointer makeResource(const QString& url, float priority) {
+    auto resource = ResourcePointer::create(QUrl(url));
+    resource->setSelf(resource);
+    resource->setLoadPriority(owner, priority);
+    return resource;
+}
+
+// queues everything by closing every protocol, then opens them back up
+static void queue(const std::vector<ResourcePointer>& resources) {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    uint32_t limits[ResourceCacheSharedItems::NUM_PROTOCOLS];
+    for (int i = 0; i < ResourceCacheSharedItems::NUM_PROTOCOLS; ++i) {
+        limits[i] = sharedItems->getProtocolRequestLimit((Protocol)i);
+        sharedItems->setProtocolRequestLimit((Protocol)i, 0);
+    }
+    for (const auto& resource : resources) {
+        QVERIFY(!sharedItems->appendRequest(resource));
+    }
+    for (int i = 0; i < ResourceCacheSharedItems::NUM_PROTOCOLS; ++i) {
+        sharedItems->setProtocolRequestLimit((Protocol)i, limits[i]);
+    }
+}
+
+// starts and finishes the highest pending request
+static ResourcePointer next() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto resource = sharedItems->getHighestPendingRequest();
+    if (resource) {
+        sharedItems->appendRequest(resource);
+        sharedItems->removeRequest(resource);
+    }
+    return resource;
+}
+
+void ResourceSchedulerTests::initTestCase() {
+    owner = new QObject(this);
+    DependencyManager::set<ResourceCacheSharedItems>();
+}
+
+void ResourceSchedulerTests::init() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    sharedItems->clear();
+    sharedItems->setRequestLimit(10);
+    sharedItems->setProtocolRequestLimit(ResourceCacheSharedItems::FILE, 4);
+    sharedItems->setProtocolRequestLimit(ResourceCacheSharedItems::HTTP, 10);
+    sharedItems->setProtocolRequestLimit(ResourceCacheSharedItems::ATP, 10);
+}
+
+void ResourceSchedulerTests::testPriorityOrder() {
+    std::vector<ResourcePointer> resources;
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<float> priorities(-10.0f, 10.0f);
+    for (int i = 0; i < 200; ++i) {
+        resources.push_back(makeResource(QString("http://test/%1").arg(i), priorities(generator)));
+    }
+    queue(resources);
+    QCOMPARE(DependencyManager::get<ResourceCacheSharedItems>()->getPendingRequestsCount(), (uint32_t)200);
+
+    float previous = FLT_MAX;
+    for (int i = 0; i < 200; ++i) {
+        auto resource = next();
+        QVERIFY(resource);
+        QVERIFY(resource->getLoadPriority() <= previous);
+        previous = resource->getLoadPriority();
+    }
+    QVERIFY(!next());
+}
+
+void ResourceSchedulerTests::testFilesFirst() {
+    std::vector<ResourcePointer> resources {
+        makeResource("http://test/high", 10.0f),
+        makeResource("atp:/higher.fbx", 20.0f),
+        makeResource("file:///low.fbx", -10.0f)
+    };
+    queue(resources);
+    QCOMPARE(next(), resources[2]);
+    QCOMPARE(next(), resources[1]);
+    QCOMPARE(next(), resources[0]);
+}
+
+void ResourceSchedulerTests::testProtocolLimits() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    sharedItems->setProtocolRequestLimit(ResourceCacheSharedItems::ATP, 1);
+    sharedItems->setRequestLimit(3);
+
+    std::vector<ResourcePointer> resources;
+    for (int i = 0; i < 3; ++i) {
+        resources.push_back(makeResource(QString("atp:/%1.fbx").arg(i), 1.0f));
+    }
+    QVERIFY(sharedItems->appendRequest(resources[0]));
+    QVERIFY(!sharedItems->appendRequest(resources[1]));
+    QVERIFY(!sharedItems->appendRequest(resources[2]));
+
+    // a full asset server leaves room for the web, up to the overall limit
+    auto http = makeResource("http://test/a", 0.0f);
+    auto https = makeResource("https://test/b", 0.0f);
+    auto http2 = makeResource("http://test/c", 0.0f);
+    QVERIFY(sharedItems->appendRequest(http));
+    QVERIFY(sharedItems->appendRequest(https));
+    QVERIFY(!sharedItems->appendRequest(http2));
+
+    // local files aren't downloads
+    auto file = makeResource("file:///a.fbx", 0.0f);
+    QVERIFY(sharedItems->appendRequest(file));
+    QCOMPARE(sharedItems->getLoadingRequestsCount(), (uint32_t)4);
+
+    // nothing fits until an ATP request finishes, and then only another ATP request
+    QVERIFY(!sharedItems->getHighestPendingRequest());
+    sharedItems->removeRequest(resources[0]);
+    auto started = sharedItems->getHighestPendingRequest();
+    QVERIFY(started == resources[1] || started == resources[2]);
+    QVERIFY(sharedItems->appendRequest(started));
+    QVERIFY(!sharedItems->getHighestPendingRequest());
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)2);
+}
+
+void ResourceSchedulerTests::testPriorityUpdate() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    std::vector<ResourcePointer> resources;
+    for (int i = 0; i < 10; ++i) {
+        resources.push_back(makeResource(QString("http://test/%1").arg(i), (float)i));
+    }
+    queue(resources);
+
+    resources[2]->setLoadPriority(owner, 100.0f);
+    sharedItems->updateRequestPriority(resources[2].data());
+    resources[9]->setLoadPriority(owner, -100.0f);
+    sharedItems->updateRequestPriority(resources[9].data());
+
+    QCOMPARE(next(), resources[2]);
+    QCOMPARE(next(), resources[8]);
+    for (int i = 0; i < 7; ++i) {
+        next();
+    }
+    QCOMPARE(next(), resources[9]);
+}
+
+void ResourceSchedulerTests::testQueuedFlag() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    std::vector<ResourcePointer> resources;
+    for (int i = 0; i < 3; ++i) {
+        resources.push_back(makeResource(QString("http://test/%1").arg(i), (float)i));
+    }
+    QVERIFY(!resources[0]->isQueued());
+    queue(resources);
+    for (const auto& resource : resources) {
+        QVERIFY(resource->isQueued());
+    }
+
+    // a queued resource moves as soon as its priority changes
+    resources[0]->setLoadPriority(owner, 100.0f);
+    QCOMPARE(next(), resources[0]);
+    QVERIFY(!resources[0]->isQueued());
+
+    // so a finished one has nowhere to move to
+    resources[0]->setLoadPriority(owner, 200.0f);
+    QVERIFY(!resources[0]->isQueued());
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)2);
+
+    sharedItems->clear();
+    QVERIFY(!resources[1]->isQueued());
+    QVERIFY(!resources[2]->isQueued());
+}
+
+void ResourceSchedulerTests::testInvalidatePriorities() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    std::vector<ResourcePointer> resources;
+    for (int i = 0; i < 10; ++i) {
+        resources.push_back(makeResource(QString("http://test/%1").arg(i), (float)i));
+    }
+    queue(resources);
+
+    // the viewer turned around: priorities changed behind the scheduler's back
+    for (int i = 0; i < 10; ++i) {
+        resources[i]->setLoadPriority(owner, (float)-i);
+    }
+    auto epoch = sharedItems->getLoadPriorityEpoch();
+    sharedItems->invalidateLoadPriorities();
+    QVERIFY(sharedItems->getLoadPriorityEpoch() != epoch);
+
+    for (int i = 0; i < 10; ++i) {
+        QCOMPARE(next(), resources[i]);
+    }
+}
+
+void ResourceSchedulerTests::testFreedRequests() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    std::vector<ResourcePointer> resources;
+    for (int i = 0; i < 10; ++i) {
+        resources.push_back(makeResource(QString("http://test/%1").arg(i), (float)i));
+    }
+    queue(resources);
+
+    resources[9].reset();
+    resources[5].reset();
+    QCOMPARE(sharedItems->getPendingRequests().size(), 8);
+    QCOMPARE(next(), resources[8]);
+    for (int i = 7; i >= 0; --i) {
+        if (i != 5) {
+            QCOMPARE(next(), resources[i]);
+        }
+    }
+    QVERIFY(!next());
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)0);
+}
+
+void ResourceSchedulerTests::schedulerPerf() {
+    // a dense domain: 10k requests queued behind a handful of slots, across the asset server and the web
+    const int NUM_RESOURCES = 10000;
+    const int NUM_CAMERA_MOVES = 10;
+    const int LEGACY_DRAINED = 1000;
+
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<float> priorities(0.0f, 1.0f);
+    std::vector<ResourcePointer> resources;
+    for (int i = 0; i < NUM_RESOURCES; ++i) {
+        QString url = (i % 3 == 0) ? QString("atp:/%1.fbx").arg(i) : QString("http://test/%1").arg(i);
+        resources.push_back(makeResource(url, priorities(generator)));
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+    auto elapsed = [](Clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    };
+
+    // the old scheduler: every started request scans every pending one for its priority
+    QList<QWeakPointer<Resource>> legacyPending;
+    for (const auto& resource : resources) {
+        legacyPending.append(resource);
+    }
+    auto start = Clock::now();
+    for (int i = 0; i < LEGACY_DRAINED; ++i) {
+        int highestIndex = -1;
+        float highestPriority = -FLT_MAX;
+        for (int j = 0; j < legacyPending.size(); ++j) {
+            auto resource = legacyPending.at(j).lock();
+            float priority = resource->getLoadPriority();
+            if (priority >= highestPriority) {
+                highestPriority = priority;
+                highestIndex = j;
+            }
+        }
+        legacyPending.takeAt(highestIndex);
+    }
+    auto legacyTime = elapsed(start);
+
+    start = Clock::now();
+    queue(resources);
+    auto queueTime = elapsed(start);
+
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    int drained = 0;
+    start = Clock::now();
+    for (int move = 0; move < NUM_CAMERA_MOVES; ++move) {
+        // the viewer moves every so often while the queue drains
+        for (int i = drained; i < NUM_RESOURCES; i += 7) {
+            resources[i]->setLoadPriority(owner, priorities(generator));
+        }
+        sharedItems->invalidateLoadPriorities();
+        for (int i = 0; i < NUM_RESOURCES / NUM_CAMERA_MOVES; ++i) {
+            QVERIFY(next());
+            ++drained;
+        }
+    }
+    auto heapTime = elapsed(start);
+    QVERIFY(!next());
+
+    qDebug() << NUM_RESOURCES << "queued requests";
+    qDebug() << "    linear scan, first" << LEGACY_DRAINED << "started:" << legacyTime << "usec";
+    qDebug() << "    heap, queueing all:" << queueTime << "usec";
+    qDebug() << "    heap, all" << NUM_RESOURCES << "started over" << NUM_CAMERA_MOVES << "viewer moves:" << heapTime << "usec";
+}
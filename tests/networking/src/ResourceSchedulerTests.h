@@ -0,0 +1,31 @@
+//
+//  ResourceSchedulerTests.h
+//  tests/networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceSchedulerTests_h
+#define hifi_ResourceSchedulerTests_h
+
+#include <QtTest/QtTest>
+
+class ResourceSchedulerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void init();
+    void testPriorityOrder();
+    void testFilesFirst();
+    void testProtocolLimits();
+    void testPriorityUpdate();
+    void testQueuedFlag();
+    void testInvalidatePriorities();
+    void testFreedRequests();
+    void schedulerPerf();
+};
+
+#endif // hifi_ResourceSchedulerTests_h
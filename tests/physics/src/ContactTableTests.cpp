@@ -0,0 +1,123 @@
+//
+//  ContactTableTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ContactTableTests.h"
+
+#include <ContactTable.h>
+
+QTEST_MAIN(ContactTableTests)
+
+// fake motion state pointers: the table never dereferences them
+static void* object(uintptr_t i) {
+    return reinterpret_cast<void*>((i + 1) * 16);
+}
+
+static btManifoldPoint point(float distance) {
+    btManifoldPoint p(btVector3(0.0f, 0.0f, 0.0f), btVector3(0.0f, 0.0f, 0.0f), btVector3(0.0f, 1.0f, 0.0f), distance);
+    return p;
+}
+
+void ContactTableTests::testInsertAndFind() {
+    ContactTable table;
+    QCOMPARE(table.empty(), true);
+    QVERIFY(table.find(ContactKey(object(0), object(1))) == nullptr);
+
+    table[ContactKey(object(0), object(1))].update(1, point(-0.5f));
+    table[ContactKey(object(1), object(0))].update(1, point(-0.25f));
+    table[ContactKey(nullptr, object(2))].update(1, point(-0.125f));
+    QCOMPARE((int)table.size(), 3);
+
+    // the key is ordered: (a, b) and (b, a) are different contacts
+    ContactInfo* contact = table.find(ContactKey(object(0), object(1)));
+    QVERIFY(contact != nullptr);
+    QCOMPARE(contact->distance, -0.5f);
+    contact = table.find(ContactKey(object(1), object(0)));
+    QVERIFY(contact != nullptr);
+    QCOMPARE(contact->distance, -0.25f);
+
+    // updating an existing contact doesn't add another
+    table[ContactKey(nullptr, object(2))].update(2, point(-1.0f));
+    QCOMPARE((int)table.size(), 3);
+    QCOMPARE(table.find(ContactKey(nullptr, object(2)))->distance, -1.0f);
+
+    table.clear();
+    QCOMPARE(table.empty(), true);
+    QVERIFY(table.find(ContactKey(object(0), object(1))) == nullptr);
+}
+
+void ContactTableTests::testRemoveContacts() {
+    ContactTable table;
+    const uintptr_t NUM_OBJECTS = 10;
+    for (uintptr_t i = 0; i < NUM_OBJECTS; ++i) {
+        table[ContactKey(object(i), object((i + 1) % NUM_OBJECTS))].update(1, point(0.0f));
+    }
+    QCOMPARE((int)table.size(), (int)NUM_OBJECTS);
+
+    // object 3 touches objects 2 and 4
+    table.removeContacts(object(3));
+    QCOMPARE((int)table.size(), (int)NUM_OBJECTS - 2);
+    QVERIFY(table.find(ContactKey(object(2), object(3))) == nullptr);
+    QVERIFY(table.find(ContactKey(object(3), object(4))) == nullptr);
+    for (auto& entry : table) {
+        QCOMPARE(entry.key.involves(object(3)), false);
+    }
+
+    // every remaining contact can still be found after the index is rebuilt
+    for (uintptr_t i = 0; i < NUM_OBJECTS; ++i) {
+        if (i != 2 && i != 3) {
+            QVERIFY(table.find(ContactKey(object(i), object((i + 1) % NUM_OBJECTS))) != nullptr);
+        }
+    }
+
+    // removing an object with no contacts changes nothing
+    table.removeContacts(object(NUM_OBJECTS + 1));
+    QCOMPARE((int)table.size(), (int)NUM_OBJECTS - 2);
+}
+
+void ContactTableTests::testPruneKeepsOrder() {
+    ContactTable table;
+    const uintptr_t NUM_CONTACTS = 100;
+    for (uintptr_t i = 0; i < NUM_CONTACTS; ++i) {
+        table[ContactKey(object(i), nullptr)].update((uint32_t)i, point(0.0f));
+    }
+
+    // drop every third contact
+    uintptr_t numVisited = 0;
+    bool visitedInOrder = true;
+    table.pruneIf([&](ContactTable::Entry& entry) {
+        visitedInOrder = visitedInOrder && entry.key._a == object(numVisited);
+        return (numVisited++ % 3) == 0;
+    });
+    QCOMPARE(numVisited, NUM_CONTACTS);
+    QVERIFY(visitedInOrder);
+
+    // the survivors come out in the order they were added
+    uintptr_t expected = 1;
+    for (auto& entry : table) {
+        QCOMPARE(entry.key._a, object(expected));
+        expected += (expected % 3 == 1) ? 1 : 2;
+    }
+    QCOMPARE((int)table.size(), (int)(NUM_CONTACTS - (NUM_CONTACTS + 2) / 3));
+}
+
+void ContactTableTests::addManyContacts() {
+    ContactTable table;
+    const uintptr_t NUM_OBJECTS = 2000;
+    for (uintptr_t i = 0; i < NUM_OBJECTS; ++i) {
+        table[ContactKey(object(i), object(i + 1))].update(1, point(0.0f));
+        table[ContactKey(object(i), object(i + 2))].update(1, point(0.0f));
+    }
+    QCOMPARE((int)table.size(), (int)(2 * NUM_OBJECTS));
+    for (uintptr_t i = 0; i < NUM_OBJECTS; ++i) {
+        QVERIFY(table.find(ContactKey(object(i), object(i + 1))) != nullptr);
+        QVERIFY(table.find(ContactKey(object(i), object(i + 2))) != nullptr);
+        QVERIFY(table.find(ContactKey(object(i + 1), object(i))) == nullptr);
+    }
+}
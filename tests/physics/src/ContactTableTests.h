@@ -0,0 +1,26 @@
+//
+//  ContactTableTests.h
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ContactTableTests_h
+#define hifi_ContactTableTests_h
+
+#include <QtTest/QtTest>
+
+class ContactTableTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testInsertAndFind();
+    void testRemoveContacts();
+    void testPruneKeepsOrder();
+    void addManyContacts();
+};
+
+#endif // hifi_ContactTableTests_h
@@ -0,0 +1,219 @@
+//
+//  PhysicsEngineTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsEngineTests.h"
+
+#include <chrono>
+
+#include <BulletUtil.h>
+#include <PhysicsCollisionGroups.h>
+#include <PhysicsEngine.h>
+#include <PhysicsHelpers.h>
+#include <ShapeManager.h>
+
+QTEST_MAIN(PhysicsEngineTests)
+
+const glm::vec3 BOX_HALF_EXTENTS(0.5f);
+const float BOX_GAP = 0.01f;
+const float GRAVITY = -9.8f;
+
+// A box with no entity behind it, so the engine can be stepped headless
+class BoxMotionState : public ObjectMotionState {
+public:
+    BoxMotionState(const btCollisionShape* shape, const glm::vec3& position, PhysicsMotionType motionType) :
+        ObjectMotionState(shape), _position(position), _computedMotionType(motionType), _id(QUuid::createUuid()) {
+        _type = MOTIONSTATE_TYPE_DETAILED;
+    }
+
+    uint32_t getIncomingDirtyFlags() const override { return 0; }
+    void clearIncomingDirtyFlags(uint32_t mask) override {}
+    PhysicsMotionType computePhysicsMotionType() const override { return _computedMotionType; }
+    bool isMoving() const override { return _computedMotionType == MOTION_TYPE_DYNAMIC; }
+
+    float getObjectRestitution() const override { return 0.0f; }
+    float getObjectFriction() const override { return 0.5f; }
+    float getObjectLinearDamping() const override { return 0.0f; }
+    float getObjectAngularDamping() const override { return 0.0f; }
+
+    glm::vec3 getObjectPosition() const override { return _position; }
+    glm::quat getObjectRotation() const override { return _rotation; }
+    glm::vec3 getObjectLinearVelocity() const override { return glm::vec3(0.0f); }
+    glm::vec3 getObjectAngularVelocity() const override { return glm::vec3(0.0f); }
+    glm::vec3 getObjectGravity() const override {
+        return _computedMotionType == MOTION_TYPE_DYNAMIC ? glm::vec3(0.0f, GRAVITY, 0.0f) : glm::vec3(0.0f);
+    }
+
+    const QUuid getObjectID() const override { return _id; }
+    QUuid getSimulatorID() const override { return QUuid(); }
+    ShapeType getShapeType() const override { return SHAPE_TYPE_BOX; }
+
+    void computeCollisionGroupAndMask(int32_t& group, int32_t& mask) const override {
+        if (_computedMotionType == MOTION_TYPE_DYNAMIC) {
+            group = BULLET_COLLISION_GROUP_DYNAMIC;
+            mask = BULLET_COLLISION_MASK_DYNAMIC;
+        } else {
+            group = BULLET_COLLISION_GROUP_STATIC;
+            mask = BULLET_COLLISION_MASK_STATIC;
+        }
+    }
+
+    void getWorldTransform(btTransform& worldTrans) const override {
+        worldTrans.setOrigin(glmToBullet(_position - ObjectMotionState::getWorldOffset()));
+        worldTrans.setRotation(glmToBullet(_rotation));
+    }
+
+    void setWorldTransform(const btTransform& worldTrans) override {
+        _position = bulletToGLM(worldTrans.getOrigin()) + ObjectMotionState::getWorldOffset();
+        _rotation = bulletToGLM(worldTrans.getRotation());
+    }
+
+private:
+    glm::vec3 _position;
+    glm::quat _rotation;
+    PhysicsMotionType _computedMotionType;
+    QUuid _id;
+};
+
+// Stacks of boxes on a static floor.  Stacks are spaced apart so each one is its own simulation island.
+class StackScene {
+public:
+    StackScene(int numStacks, int stackHeight) : _engine(glm::vec3(0.0f)) {
+        _engine.init();
+
+        ShapeInfo floorInfo;
+        floorInfo.setBox(glm::vec3(200.0f, 0.5f, 200.0f));
+        _floor = new BoxMotionState(ObjectMotionState::getShapeManager()->getShape(floorInfo), glm::vec3(0.0f, -0.5f, 0.0f), MOTION_TYPE_STATIC);
+        _floor->setMass(0.0f);
+
+        ShapeInfo boxInfo;
+        boxInfo.setBox(BOX_HALF_EXTENTS);
+        int stacksPerRow = (int)ceilf(sqrtf((float)numStacks));
+        const float STACK_SPACING = 4.0f;
+        for (int i = 0; i < numStacks; i++) {
+            glm::vec3 base(STACK_SPACING * (i % stacksPerRow - stacksPerRow / 2), 0.0f,
+                STACK_SPACING * (i / stacksPerRow - stacksPerRow / 2));
+            for (int j = 0; j < stackHeight; j++) {
+                glm::vec3 position = base + glm::vec3(0.0f, BOX_HALF_EXTENTS.y + j * (2.0f * BOX_HALF_EXTENTS.y + BOX_GAP), 0.0f);
+                auto box = new BoxMotionState(ObjectMotionState::getShapeManager()->getShape(boxInfo), position, MOTION_TYPE_DYNAMIC);
+                box->setMass(1.0f);
+                _boxes.push_back(box);
+            }
+        }
+
+        VectorOfMotionStates objects;
+        objects.push_back(_floor);
+        for (auto box : _boxes) {
+            objects.push_back(box);
+        }
+        _engine.addObjects(objects);
+    }
+
+    ~StackScene() {
+        VectorOfMotionStates objects;
+        objects.push_back(_floor);
+        for (auto box : _boxes) {
+            objects.push_back(box);
+        }
+        _engine.removeObjects(objects);
+        for (auto object : objects) {
+            delete object;
+        }
+    }
+
+    PhysicsEngine& getEngine() { return _engine; }
+    const std::vector<BoxMotionState*>& getBoxes() const { return _boxes; }
+
+    // steps one fixed substep and harvests the motion states, like PhysicalEntitySimulation does each frame
+    const VectorOfMotionStates& step() {
+        _engine.stepSimulation(PHYSICS_ENGINE_FIXED_SUBSTEP);
+        return _engine.getChangedMotionStates();
+    }
+
+private:
+    PhysicsEngine _engine;
+    BoxMotionState* _floor;
+    std::vector<BoxMotionState*> _boxes;
+};
+
+void PhysicsEngineTests::initTestCase() {
+    // motion states release their shapes through the global shape manager when deleted
+    static ShapeManager shapeManager;
+    ObjectMotionState::setShapeManager(&shapeManager);
+}
+
+void PhysicsEngineTests::testStackSettles() {
+    const int NUM_STACKS = 16;
+    const int STACK_HEIGHT = 5;
+    StackScene scene(NUM_STACKS, STACK_HEIGHT);
+
+    const int NUM_STEPS = 180;
+    for (int i = 0; i < NUM_STEPS; i++) {
+        scene.step();
+    }
+
+    // each box touches the one below it (or the floor)
+    QVERIFY(scene.getEngine().getNumContacts() >= (uint32_t)(NUM_STACKS * STACK_HEIGHT));
+
+    // every stack should still be standing, with each box resting on the one below
+    const float TOLERANCE = 0.05f;
+    const auto& boxes = scene.getBoxes();
+    for (int i = 0; i < NUM_STACKS; i++) {
+        const auto& bottom = boxes[i * STACK_HEIGHT]->getObjectPosition();
+        for (int j = 0; j < STACK_HEIGHT; j++) {
+            glm::vec3 position = boxes[i * STACK_HEIGHT + j]->getObjectPosition();
+            QVERIFY(fabsf(position.x - bottom.x) < TOLERANCE);
+            QVERIFY(fabsf(position.z - bottom.z) < TOLERANCE);
+            QVERIFY(fabsf(position.y - (BOX_HALF_EXTENTS.y + j * 2.0f * BOX_HALF_EXTENTS.y)) < TOLERANCE);
+        }
+    }
+}
+
+void PhysicsEngineTests::testHarvestOrder() {
+    // islands are solved in parallel, but motion states must be harvested in a fixed order
+    // so the entity updates sent each frame don't depend on thread timing
+    StackScene scene(64, 3);
+    const auto& boxes = scene.getBoxes();
+    for (int i = 0; i < 10; i++) {
+        const auto& changed = scene.step();
+        size_t nextBox = 0;
+        for (auto motionState : changed) {
+            if (motionState->getMotionType() != MOTION_TYPE_DYNAMIC) {
+                continue;
+            }
+            QVERIFY(nextBox < boxes.size());
+            QCOMPARE(motionState, static_cast<ObjectMotionState*>(boxes[nextBox]));
+            ++nextBox;
+        }
+        QCOMPARE(nextBox, boxes.size());
+    }
+}
+
+void PhysicsEngineTests::stackPerf() {
+    const int STACK_HEIGHT = 8;
+    const int NUM_STEPS = 90;
+    for (int numStacks : { 32, 128, 512 }) {
+        StackScene scene(numStacks, STACK_HEIGHT);
+        // the first steps wake and settle everything, so leave them out of the timing
+        for (int i = 0; i < 10; i++) {
+            scene.step();
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < NUM_STEPS; i++) {
+            scene.step();
+        }
+        auto elapsed = std::chrono::high_resolution_clock::now() - start;
+
+        qDebug() << numStacks * STACK_HEIGHT << "stacked bodies:"
+            << std::chrono::duration<double, std::milli>(elapsed).count() / NUM_STEPS << "ms/step,"
+            << scene.getEngine().getNumContacts() << "contacts updated in"
+            << scene.getEngine().getContactUpdateTime() << "usec";
+    }
+}
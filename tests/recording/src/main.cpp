@@ -29,6 +29,7 @@
 
 #include <recording/Clip.h>
 #include <recording/Frame.h>
+#include <recording/impl/ClipIndex.h>
 
 #include <SharedUtil.h>
 
@@ -119,10 +120,97 @@ void testClipOrdering() {
     Q_UNUSED(lastFrameTimeOffset); // FIXME - Unix build not yet upgraded to Qt 5.5.1 we can remove this once it is
 }
 
+// several seconds of two frame types, with repeated times and data that changes a little from frame to frame
+Clip::Pointer makeLongClip() {
+    static const FrameType SECOND_FRAME_TYPE = Frame::registerFrameType(TEST_NAME + ".Second");
+    auto clip = Clip::newClip();
+    for (int i = 0; i < 2000; ++i) {
+        Frame::Time time = (i / 3) * 10;
+        QByteArray data(64 + i % 7, (char)(i % 3));
+        data[i % data.size()] = (char)i;
+        // Frame takes seconds, set the time in milliseconds directly
+        auto frame = std::make_shared<Frame>(i % 2 ? TEST_FRAME_TYPE : SECOND_FRAME_TYPE, 0.0f, data);
+        frame->timeOffset = time;
+        clip->addFrame(frame);
+    }
+    return clip;
+}
+
+void verifySameFrames(const Clip::Pointer& readClip, const Clip::Pointer& writeClip) {
+    QVERIFY(readClip->frameCount() == writeClip->frameCount());
+    QVERIFY(readClip->duration() == writeClip->duration());
+
+    // seeking lands on the same frame, from any chunk, and the frames after it are the same
+    for (Frame::Time time : { 0, 5, 10, 1000, 2550, 2560, 6650, 6660, 100000 }) {
+        readClip->seekFrameTime(time);
+        writeClip->seekFrameTime(time);
+        QVERIFY(readClip->positionFrameTime() == writeClip->positionFrameTime());
+        for (int i = 0; i < 10; ++i) {
+            auto readFrame = readClip->nextFrame();
+            auto writeFrame = writeClip->nextFrame();
+            QVERIFY((bool)readFrame == (bool)writeFrame);
+            if (!readFrame) {
+                break;
+            }
+            QVERIFY(readFrame->type == writeFrame->type);
+            QVERIFY(readFrame->timeOffset == writeFrame->timeOffset);
+            QVERIFY(readFrame->data == writeFrame->data);
+        }
+    }
+}
+
+void testIndexedFile() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    auto writeClip = makeLongClip();
+    for (auto encoding : { Clip::Encoding::Raw, Clip::Encoding::Compressed, Clip::Encoding::Delta }) {
+        Clip::toFile(fileName, writeClip, encoding);
+        auto readClip = Clip::fromFile(fileName);
+        QVERIFY(readClip != Clip::Pointer());
+        verifySameFrames(readClip, writeClip);
+    }
+}
+
+void testUnindexedFile() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    auto writeClip = makeLongClip();
+    Clip::toFile(fileName, writeClip, Clip::Encoding::Compressed);
+
+    // cut the index off, leaving a file as it was written before there was one
+    QFile indexedFile(fileName);
+    QVERIFY(indexedFile.open(QFile::ReadWrite));
+    auto size = indexedFile.size();
+    // the trailer frame's data starts with the offset of the index
+    const qint64 FRAME_HEADER_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize);
+    indexedFile.seek(size - (qint64)ClipIndex::TRAILER_SIZE + FRAME_HEADER_SIZE);
+    quint64 indexOffset { 0 };
+    QVERIFY(indexedFile.read((char*)&indexOffset, sizeof(indexOffset)) == sizeof(indexOffset));
+    QVERIFY(indexOffset > 0 && indexOffset < (quint64)size);
+    QVERIFY(indexedFile.resize(indexOffset));
+    indexedFile.close();
+
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    verifySameFrames(readClip, writeClip);
+}
+
 int main(int, const char**) {
     setupHifiApplication("Recording Test");
 
     testFrameTypeRegistration();
     testFilePersist();
     testClipOrdering();
+    testIndexedFile();
+    testUnindexedFile();
 }
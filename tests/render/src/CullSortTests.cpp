@@ -0,0 +1,332 @@
+//
+//  CullSortTests.cpp
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CullSortTests.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <render/CullTask.h>
+#include <render/SortTask.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(CullSortTests)
+
+using namespace render;
+
+// A box standing for whatever the entities put in the scene
+class TestShape {
+public:
+    AABox bound;
+    ShapeKey shapeKey;
+};
+using TestShapePointer = std::shared_ptr<TestShape>;
+
+namespace render {
+template <> const ItemKey payloadGetKey(const TestShapePointer& shape) { return ItemKey::Builder::opaqueShape().build(); }
+template <> const Item::Bound payloadGetBound(const TestShapePointer& shape) { return shape->bound; }
+template <> const ShapeKey shapeGetShapeKey(const TestShapePointer& shape) { return shape->shapeKey; }
+}
+
+const float TREE_SIZE = 32768.0f;
+const float SPACING = 4.0f;
+const int NUM_PIPELINES = 16;
+const ItemFilter FILTER = ItemFilter::Builder::visibleWorldItems().withoutLayered().build();
+
+// A cube of numPerSide^3 boxes around the origin, of a few sizes and spread over a few pipelines
+ScenePointer makeScene(int numPerSide) {
+    auto scene = std::make_shared<Scene>(glm::vec3(-0.5f * TREE_SIZE), TREE_SIZE);
+    Transaction transaction;
+    int i = 0;
+    for (int x = 0; x < numPerSide; ++x) {
+        for (int y = 0; y < numPerSide; ++y) {
+            for (int z = 0; z < numPerSide; ++z) {
+                auto shape = std::make_shared<TestShape>();
+                glm::vec3 center = SPACING * (glm::vec3(x, y, z) - 0.5f * (float)(numPerSide - 1));
+                float size = 0.25f * (float)(1 + i % 8);
+                shape->bound = AABox(center - glm::vec3(0.5f * size), size);
+
+                int pipeline = (i * 7) % NUM_PIPELINES;
+                ShapeKey::Builder builder;
+                if (pipeline & 1) {
+                    builder.withMaterial();
+                }
+                if (pipeline & 2) {
+                    builder.withTangents();
+                }
+                if (pipeline & 4) {
+                    builder.withUnlit();
+                }
+                if (pipeline & 8) {
+                    builder.withFade();
+                }
+                shape->shapeKey = builder.build();
+
+                transaction.resetItem(scene->allocateID(), std::make_shared<Payload<TestShape>>(shape));
+                ++i;
+            }
+        }
+    }
+    scene->enqueueTransaction(transaction);
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+    return scene;
+}
+
+ViewFrustum makeFrustum(const glm::vec3& position) {
+    ViewFrustum frustum;
+    frustum.setPosition(position);
+    frustum.setOrientation(glm::quat());
+    frustum.setProjection(90.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+    frustum.calculate();
+    return frustum;
+}
+
+// What the render thread passes the jobs, looking at the scene through the frustum
+class TestContext {
+public:
+    TestContext(const ScenePointer& scene, const ViewFrustum& frustum) {
+        // no LOD, so that the octree keeps every cell the frustum touches
+        args._lodAngleHalfTan = 0.0f;
+        args.setViewFrustum(frustum);
+        args._scene = scene;
+        context = std::make_shared<RenderContext>();
+        context->args = &args;
+        context->_scene = scene;
+        context->jobConfig = std::make_shared<CullSpatialSelection::Config>();
+    }
+
+    RenderArgs args;
+    RenderContextPointer context;
+};
+
+void fetchAndCull(const RenderContextPointer& context, ItemSpatialTree::ItemSelection& selection, ItemBounds& culledItems) {
+    FetchSpatialTree fetch;
+    fetch.run(context, FetchSpatialTree::Inputs(FILTER, glm::ivec2(0)), selection);
+
+    CullSpatialSelection cull([](const RenderArgs*, const AABox&) { return true; }, RenderDetails::ITEM);
+    cull.run(context, CullSpatialSelection::Inputs(selection, FILTER), culledItems);
+}
+
+// What the octree selection was before it split the traversal across octants
+Octree::CellSelection selectCellsSerially(const ItemSpatialTree& tree, const ViewFrustum& frustum) {
+    Octree::PerspectiveSelector selector;
+    auto worldPlanes = frustum.getPlanes();
+    for (int i = 0; i < ViewFrustum::NUM_PLANES; i++) {
+        ::Plane octPlane;
+        octPlane.setNormalAndPoint(worldPlanes[i].getNormal(), tree.evalCoordf(worldPlanes[i].getPoint(), Octree::ROOT_DEPTH));
+        selector.frustum[i] = Octree::Coord4f(octPlane.getNormal(), octPlane.getDCoefficient());
+    }
+    selector.eyePos = tree.evalCoordf(frustum.getPosition(), Octree::ROOT_DEPTH);
+    selector.setAngle(0.0f);
+
+    Octree::CellSelection selection;
+    tree.selectCellBrick(Octree::ROOT_CELL, selection, false);
+    const auto& root = tree.getConcreteCell(Octree::ROOT_CELL);
+    for (int i = 0; i < Octree::NUM_OCTANTS; i++) {
+        Octree::Index subCellID = root.child((Octree::Link)i);
+        if (subCellID != Octree::INVALID_CELL) {
+            tree.selectTraverse(subCellID, selection, selector);
+        }
+    }
+    return selection;
+}
+
+void CullSortTests::testSelectCells() {
+    auto scene = makeScene(20);
+    const auto& tree = scene->getSpatialTree();
+    QVERIFY(tree.getNumAllocatedCells() >= Octree::MIN_CELLS_FOR_PARALLEL_SELECT);
+
+    auto frustum = makeFrustum(glm::vec3(10.0f, 5.0f, 30.0f));
+    Octree::CellSelection selection;
+    tree.selectCells(selection, frustum, 0.0f);
+
+    auto expected = selectCellsSerially(tree, frustum);
+    QVERIFY(selection.size() > 0);
+    QVERIFY(selection.insideCells == expected.insideCells);
+    QVERIFY(selection.insideBricks == expected.insideBricks);
+    QVERIFY(selection.partialCells == expected.partialCells);
+    QVERIFY(selection.partialBricks == expected.partialBricks);
+}
+
+void CullSortTests::testCull() {
+    auto scene = makeScene(20);
+    auto frustum = makeFrustum(glm::vec3(10.0f, 5.0f, 30.0f));
+    TestContext test(scene, frustum);
+
+    ItemSpatialTree::ItemSelection selection;
+    ItemBounds culledItems;
+    fetchAndCull(test.context, selection, culledItems);
+    QVERIFY(culledItems.size() > 0);
+    QVERIFY(culledItems.size() < scene->getNumItems());
+
+    // the culled items keep the order of the selection, whatever range of it they were culled in
+    std::unordered_map<ItemID, size_t> selectionOrder;
+    for (auto items : { &selection.insideItems, &selection.insideSubcellItems, &selection.partialItems, &selection.partialSubcellItems }) {
+        for (auto id : *items) {
+            selectionOrder.emplace(id, selectionOrder.size());
+        }
+    }
+    size_t previous = 0;
+    for (size_t i = 0; i < culledItems.size(); ++i) {
+        auto itr = selectionOrder.find(culledItems[i].id);
+        QVERIFY(itr != selectionOrder.end());
+        QVERIFY(i == 0 || itr->second > previous);
+        previous = itr->second;
+    }
+
+    // and they are the items in view
+    std::unordered_set<ItemID> culled;
+    for (auto& item : culledItems) {
+        QVERIFY(frustum.boxIntersectsFrustum(item.bound));
+        culled.insert(item.id);
+    }
+    for (ItemID id = 1; id < (ItemID)scene->getNumItems(); ++id) {
+        auto& item = scene->getItem(id);
+        if (item.exist() && frustum.boxInsideFrustum(item.getBound())) {
+            QVERIFY(culled.count(id) == 1);
+        }
+    }
+
+    const auto& details = test.args._details._item;
+    QCOMPARE(details._considered, (int)selection.numItems());
+    QCOMPARE(details._rendered, (int)culledItems.size());
+    QCOMPARE(details._considered - details._outOfView - details._tooSmall, details._rendered);
+}
+
+void CullSortTests::testPipelineSort() {
+    auto scene = makeScene(20);
+    TestContext test(scene, makeFrustum(glm::vec3(10.0f, 5.0f, 30.0f)));
+
+    ItemSpatialTree::ItemSelection selection;
+    ItemBounds culledItems;
+    fetchAndCull(test.context, selection, culledItems);
+
+    ShapeBounds shapes;
+    PipelineSortShapes sort;
+    sort.run(test.context, culledItems, shapes);
+    QCOMPARE((int)shapes.size(), NUM_PIPELINES);
+
+    // every pipeline has its items in the order they came in
+    ShapeBounds expected;
+    for (auto& item : culledItems) {
+        expected[scene->getItem(item.id).getShapeKey()].push_back(item);
+    }
+    for (auto& pipeline : expected) {
+        auto itr = shapes.find(pipeline.first);
+        QVERIFY(itr != shapes.end());
+        QCOMPARE(itr->second.size(), pipeline.second.size());
+        for (size_t i = 0; i < pipeline.second.size(); ++i) {
+            QCOMPARE(itr->second[i].id, pipeline.second[i].id);
+        }
+    }
+
+    // sorting again gives the same
+    ShapeBounds again;
+    sort.run(test.context, culledItems, again);
+    for (auto& pipeline : shapes) {
+        auto& items = again[pipeline.first];
+        QCOMPARE(items.size(), pipeline.second.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            QCOMPARE(items[i].id, pipeline.second[i].id);
+        }
+    }
+}
+
+void CullSortTests::testDepthSort() {
+    auto scene = makeScene(20);
+    auto frustum = makeFrustum(glm::vec3(10.0f, 5.0f, 30.0f));
+    TestContext test(scene, frustum);
+
+    ItemSpatialTree::ItemSelection selection;
+    ItemBounds culledItems;
+    fetchAndCull(test.context, selection, culledItems);
+    ShapeBounds shapes;
+    PipelineSortShapes().run(test.context, culledItems, shapes);
+
+    for (bool frontToBack : { true, false }) {
+        ShapeBounds sortedShapes;
+        DepthSortShapes(frontToBack).run(test.context, shapes, sortedShapes);
+        QCOMPARE(sortedShapes.size(), shapes.size());
+
+        for (auto& pipeline : shapes) {
+            // by depth, then by ID between items as far
+            std::vector<std::pair<float, ItemID>> expected;
+            for (auto& item : pipeline.second) {
+                float depth = frustum.distanceToCameraSquared(item.bound.calcCenter());
+                expected.emplace_back(frontToBack ? depth : -depth, item.id);
+            }
+            std::sort(expected.begin(), expected.end());
+
+            auto& items = sortedShapes[pipeline.first];
+            QCOMPARE(items.size(), expected.size());
+            for (size_t i = 0; i < items.size(); ++i) {
+                QCOMPARE(items[i].id, expected[i].second);
+            }
+        }
+    }
+
+    DepthSortShapesAndComputeBounds::Outputs outputs;
+    DepthSortShapesAndComputeBounds().run(test.context, shapes, outputs);
+    AABox expectedBounds;
+    for (auto& item : culledItems) {
+        expectedBounds += item.bound;
+    }
+    // the bounds grow pipeline by pipeline, which rounds differently
+    const float TOLERANCE = 0.001f;
+    QVERIFY(glm::distance(outputs.get1().getCorner(), expectedBounds.getCorner()) < TOLERANCE);
+    QVERIFY(glm::distance(outputs.get1().getDimensions(), expectedBounds.getDimensions()) < TOLERANCE);
+}
+
+void CullSortTests::cullSortPerf() {
+    const int NUM_PER_SIDE = 48;
+    const int NUM_FRAMES = 20;
+    auto scene = makeScene(NUM_PER_SIDE);
+    TestContext test(scene, makeFrustum(glm::vec3(0.0f, 0.0f, 0.5f * SPACING * NUM_PER_SIDE)));
+
+    FetchSpatialTree fetch;
+    CullSpatialSelection cull([](const RenderArgs*, const AABox&) { return true; }, RenderDetails::ITEM);
+    PipelineSortShapes pipelineSort;
+    DepthSortShapes depthSort;
+
+    FetchSpatialTree::Inputs fetchInputs(FILTER, glm::ivec2(0));
+    CullSpatialSelection::Inputs cullInputs(ItemSpatialTree::ItemSelection(), FILTER);
+    ItemBounds culledItems;
+    ShapeBounds shapes;
+    ShapeBounds sortedShapes;
+
+    uint64_t fetchTime = 0;
+    uint64_t cullTime = 0;
+    uint64_t pipelineSortTime = 0;
+    uint64_t depthSortTime = 0;
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        uint64_t start = usecTimestampNow();
+        fetch.run(test.context, fetchInputs, cullInputs.edit0());
+        uint64_t fetched = usecTimestampNow();
+        cull.run(test.context, cullInputs, culledItems);
+        uint64_t culled = usecTimestampNow();
+        pipelineSort.run(test.context, culledItems, shapes);
+        uint64_t pipelineSorted = usecTimestampNow();
+        depthSort.run(test.context, shapes, sortedShapes);
+        uint64_t depthSorted = usecTimestampNow();
+
+        fetchTime += fetched - start;
+        cullTime += culled - fetched;
+        pipelineSortTime += pipelineSorted - culled;
+        depthSortTime += depthSorted - pipelineSorted;
+    }
+
+    qDebug() << NUM_PER_SIDE * NUM_PER_SIDE * NUM_PER_SIDE << "items," << culledItems.size() << "in view, over" << shapes.size() << "pipelines";
+    qDebug() << "fetch =" << (fetchTime / NUM_FRAMES) << "usec"
+        << " cull =" << (cullTime / NUM_FRAMES) << "usec"
+        << " pipeline sort =" << (pipelineSortTime / NUM_FRAMES) << "usec"
+        << " depth sort =" << (depthSortTime / NUM_FRAMES) << "usec";
+}
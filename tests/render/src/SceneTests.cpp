@@ -0,0 +1,220 @@
+//
+//  SceneTests.cpp
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SceneTests.h"
+
+#include <thread>
+
+#include <render/Scene.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(SceneTests)
+
+using namespace render;
+
+// A box at some position, remembering the updates it went through
+class TestData {
+public:
+    TestData(const glm::vec3& position) : position(position) {}
+
+    glm::vec3 position;
+    std::vector<int> updates;
+};
+using TestDataPointer = std::shared_ptr<TestData>;
+
+namespace render {
+template <> const ItemKey payloadGetKey(const TestDataPointer& data) { return ItemKey::Builder::opaqueShape().build(); }
+template <> const Item::Bound payloadGetBound(const TestDataPointer& data) { return AABox(data->position, 1.0f); }
+}
+
+PayloadPointer makePayload(const TestDataPointer& data) {
+    return std::make_shared<Payload<TestData>>(data);
+}
+
+ScenePointer makeScene() {
+    const float TREE_SIZE = 32768.0f;
+    return std::make_shared<Scene>(glm::vec3(-0.5f * TREE_SIZE), TREE_SIZE);
+}
+
+void processFrame(const ScenePointer& scene) {
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+}
+
+void SceneTests::testEnqueueOrder() {
+    const int NUM_THREADS = 4;
+    const int NUM_TRANSACTIONS = 200;
+    auto scene = makeScene();
+
+    std::vector<ItemID> ids;
+    std::vector<TestDataPointer> datas;
+    Transaction resets;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        ids.push_back(scene->allocateID());
+        datas.push_back(std::make_shared<TestData>(glm::vec3((float)i)));
+        resets.resetItem(ids.back(), makePayload(datas.back()));
+    }
+    scene->enqueueTransaction(resets);
+    processFrame(scene);
+
+    // every thread updates its own item, one transaction per update
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([&, i] {
+            for (int j = 0; j < NUM_TRANSACTIONS; ++j) {
+                Transaction transaction;
+                transaction.updateItem<TestData>(ids[i], [j](TestData& data) {
+                    data.updates.push_back(j);
+                });
+                scene->enqueueTransaction(std::move(transaction));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    uint64_t numEnqueued = scene->getNumEnqueuedTransactions();
+    processFrame(scene);
+    QCOMPARE(scene->getNumEnqueuedTransactions() - numEnqueued, (uint64_t)(NUM_THREADS * NUM_TRANSACTIONS));
+
+    // whatever the interleaving, the updates of each thread are applied in the order it enqueued them
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        QCOMPARE((int)datas[i]->updates.size(), NUM_TRANSACTIONS);
+        for (int j = 0; j < NUM_TRANSACTIONS; ++j) {
+            QCOMPARE(datas[i]->updates[j], j);
+        }
+    }
+}
+
+void SceneTests::testResetsAndRemoves() {
+    auto scene = makeScene();
+    ItemID first = scene->allocateID();
+    ItemID second = scene->allocateID();
+    ItemID third = scene->allocateID();
+
+    // resets enqueued out of ID order, with two of the same item
+    Transaction transaction;
+    transaction.resetItem(third, makePayload(std::make_shared<TestData>(glm::vec3(3.0f))));
+    transaction.resetItem(first, makePayload(std::make_shared<TestData>(glm::vec3(1.0f))));
+    transaction.resetItem(second, makePayload(std::make_shared<TestData>(glm::vec3(2.0f))));
+    scene->enqueueTransaction(transaction);
+    Transaction again;
+    again.resetItem(first, makePayload(std::make_shared<TestData>(glm::vec3(10.0f))));
+    scene->enqueueTransaction(again);
+    uint64_t numChanges = scene->getNumProcessedItemChanges();
+    processFrame(scene);
+    QCOMPARE(scene->getNumProcessedItemChanges() - numChanges, (uint64_t)4);
+
+    QVERIFY(scene->getItem(first).exist());
+    QVERIFY(scene->getItem(second).exist());
+    QVERIFY(scene->getItem(third).exist());
+    QCOMPARE(scene->getItem(first).getBound().getCorner().x, 10.0f);
+    QCOMPARE(scene->getItem(second).getBound().getCorner().x, 2.0f);
+    QCOMPARE(scene->getItem(third).getBound().getCorner().x, 3.0f);
+
+    // the same item removed twice, and another one updated then removed
+    Transaction removes;
+    removes.removeItem(third);
+    removes.updateItem<TestData>(second, [](TestData& data) {
+        data.position.x = 20.0f;
+    });
+    removes.removeItem(second);
+    removes.removeItem(third);
+    scene->enqueueTransaction(removes);
+    processFrame(scene);
+
+    QVERIFY(scene->getItem(first).exist());
+    QVERIFY(!scene->getItem(second).exist());
+    QVERIFY(!scene->getItem(third).exist());
+}
+
+void SceneTests::testUpdateFunctorPool() {
+    // a freed block is the next one of its size
+    void* block = UpdateFunctorPool::allocate(48);
+    UpdateFunctorPool::deallocate(block, 48);
+    QVERIFY(UpdateFunctorPool::allocate(64) == block);
+    UpdateFunctorPool::deallocate(block, 64);
+
+    // blocks made on some threads and freed on another find their way back to the threads making them
+    const int NUM_THREADS = 4;
+    const int NUM_BLOCKS = 1000;
+    const size_t SIZES[] = { 16, 100, 200, 1000 };
+    for (int round = 0; round < 3; ++round) {
+        std::vector<std::vector<void*>> blocks(NUM_THREADS);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            threads.emplace_back([&, i] {
+                for (int j = 0; j < NUM_BLOCKS; ++j) {
+                    size_t size = SIZES[j % 4];
+                    void* block = UpdateFunctorPool::allocate(size);
+                    memset(block, i, size);
+                    blocks[i].push_back(block);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            for (int j = 0; j < NUM_BLOCKS; ++j) {
+                QCOMPARE(*(uint8_t*)blocks[i][j], (uint8_t)i);
+                UpdateFunctorPool::deallocate(blocks[i][j], SIZES[j % 4]);
+            }
+        }
+    }
+}
+
+void SceneTests::transactionPerf() {
+    const int NUM_THREADS = 4;
+    const int NUM_ITEMS_PER_THREAD = 2000;
+    const int NUM_FRAMES = 20;
+    auto scene = makeScene();
+
+    std::vector<ItemID> ids;
+    Transaction resets;
+    for (int i = 0; i < NUM_THREADS * NUM_ITEMS_PER_THREAD; ++i) {
+        ids.push_back(scene->allocateID());
+        resets.resetItem(ids.back(), makePayload(std::make_shared<TestData>(glm::vec3((float)(i % 100)))));
+    }
+    scene->enqueueTransaction(resets);
+    processFrame(scene);
+
+    // every thread moves its items each frame, as the entity and avatar updates do
+    uint64_t enqueueTime = 0;
+    uint64_t processTime = scene->getTransactionProcessingTime();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        uint64_t start = usecTimestampNow();
+        std::vector<std::thread> threads;
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            threads.emplace_back([&, i] {
+                for (int j = 0; j < NUM_ITEMS_PER_THREAD; ++j) {
+                    Transaction transaction;
+                    glm::vec3 position((float)frame, (float)j, 0.0f);
+                    transaction.updateItem<TestData>(ids[i * NUM_ITEMS_PER_THREAD + j], [position](TestData& data) {
+                        data.position = position;
+                    });
+                    scene->enqueueTransaction(std::move(transaction));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        enqueueTime += usecTimestampNow() - start;
+        processFrame(scene);
+    }
+    processTime = scene->getTransactionProcessingTime() - processTime;
+
+    int numTransactions = NUM_FRAMES * NUM_THREADS * NUM_ITEMS_PER_THREAD;
+    qDebug() << numTransactions << "transactions from" << NUM_THREADS << "threads:"
+        << "enqueue =" << (enqueueTime / NUM_FRAMES) << "usec/frame"
+        << (enqueueTime > 0 ? (uint64_t)numTransactions * USECS_PER_SECOND / enqueueTime : 0) << "transactions/sec"
+        << " process =" << (processTime / NUM_FRAMES) << "usec/frame";
+}
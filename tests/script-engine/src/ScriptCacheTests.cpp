@@ -0,0 +1,129 @@
+//
+//  ScriptCacheTests.cpp
+//  tests/script-engine/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptCacheTests.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include <ScriptCache.h>
+
+QTEST_MAIN(ScriptCacheTests)
+
+static const QUrl SCRIPT_URL { "https://example.com/scripts/app.js" };
+
+std::shared_ptr<ScriptCache> ScriptCacheTests::makeScriptCache() {
+    return std::shared_ptr<ScriptCache>(new ScriptCache(), [](ScriptCache* scriptCache) { delete scriptCache; });
+}
+
+void ScriptCacheTests::testFindDependencies() {
+    const QString CONTENTS = R"(
+        Script.include("lib/utils.js");
+        Script.include(["../shared/a.js", 'b.js']);
+        include("https://other.example.com/absolute.js");
+        var module = require("./module.js");
+        var parent = require('../up/module.js');
+        var builtin = require("vec3");
+        Script.include("/~/system/libraries/utils.js");
+        Script.include("lib/utils.js");
+        Script.include(computedPath);
+        Script.include("app.js");
+        // Script.include("line-comment.js");
+        /* require("./block-comment.js");
+           Script.include("block-comment2.js"); */
+        var notComment = "http://example.com//not-a-comment.js"; Script.include("after-string.js");
+    )";
+
+    // in the order they appear, each once, resolved against the script; the default scripts, bare module ids,
+    // computed paths, the script itself and anything commented out are left alone
+    QList<QUrl> expected {
+        QUrl("https://example.com/scripts/lib/utils.js"),
+        QUrl("https://example.com/shared/a.js"),
+        QUrl("https://example.com/scripts/b.js"),
+        QUrl("https://other.example.com/absolute.js"),
+        QUrl("https://example.com/scripts/after-string.js"),
+        QUrl("https://example.com/scripts/module.js"),
+        QUrl("https://example.com/up/module.js")
+    };
+    QCOMPARE(ScriptCache::findDependencies(SCRIPT_URL, CONTENTS), expected);
+
+    // local scripts aren't worth prefetching
+    QVERIFY(ScriptCache::findDependencies(QUrl("file:///scripts/app.js"), CONTENTS).isEmpty());
+}
+
+void ScriptCacheTests::testDiskCacheRoundTrip() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    const QString CONTENTS = "Script.include('lib/utils.js');";
+    const QList<QUrl> DEPENDENCIES { QUrl("https://example.com/scripts/lib/utils.js") };
+    auto contentHash = ScriptCache::hashContents(CONTENTS);
+    {
+        auto scriptCache = makeScriptCache();
+        scriptCache->setDiskCacheDirectory(directory.path());
+        {
+            ScriptCache::Lock lock(scriptCache->_containerLock);
+            scriptCache->storeOnDisk(SCRIPT_URL, CONTENTS, DEPENDENCIES);
+        }
+        scriptCache->setPassed(contentHash, ScriptCache::SyntaxCheck);
+        QCOMPARE(scriptCache->loadFromDisk(SCRIPT_URL), CONTENTS);
+        // the index is written when the cache goes away, if it hasn't been yet
+    }
+
+    // as a restarted process finds it
+    auto scriptCache = makeScriptCache();
+    scriptCache->setDiskCacheDirectory(directory.path());
+    QCOMPARE(scriptCache->loadFromDisk(SCRIPT_URL), CONTENTS);
+    QVERIFY(scriptCache->_diskIndex.contains(SCRIPT_URL));
+    QCOMPARE(scriptCache->_diskIndex[SCRIPT_URL].dependencies, DEPENDENCIES);
+    QVERIFY(scriptCache->hasPassed(contentHash, ScriptCache::SyntaxCheck));
+    QVERIFY(!scriptCache->hasPassed(contentHash, ScriptCache::EntityConstructorCheck));
+
+    // scripts that were never stored aren't there
+    QVERIFY(scriptCache->loadFromDisk(QUrl("https://example.com/scripts/other.js")).isEmpty());
+}
+
+void ScriptCacheTests::testContentChange() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    const QString OLD_CONTENTS = "print('old');";
+    const QString NEW_CONTENTS = "print('new');";
+    const QUrl COPY_URL { "https://example.com/scripts/copy.js" };
+    auto oldHash = ScriptCache::hashContents(OLD_CONTENTS);
+    auto newHash = ScriptCache::hashContents(NEW_CONTENTS);
+    QVERIFY(oldHash != newHash);
+
+    auto scriptCache = makeScriptCache();
+    scriptCache->setDiskCacheDirectory(directory.path());
+    auto store = [&](const QUrl& url, const QString& contents) {
+        ScriptCache::Lock lock(scriptCache->_containerLock);
+        scriptCache->storeOnDisk(url, contents, QList<QUrl>());
+    };
+
+    store(SCRIPT_URL, OLD_CONTENTS);
+    store(COPY_URL, OLD_CONTENTS);
+    scriptCache->setPassed(oldHash, ScriptCache::SyntaxCheck);
+    QVERIFY(QFile::exists(scriptCache->diskCacheFilePath(oldHash)));
+
+    // the new contents replace the old copy, and the checks the old contents passed don't carry over
+    store(SCRIPT_URL, NEW_CONTENTS);
+    QCOMPARE(scriptCache->loadFromDisk(SCRIPT_URL), NEW_CONTENTS);
+    QVERIFY(!scriptCache->hasPassed(newHash, ScriptCache::SyntaxCheck));
+    QVERIFY(scriptCache->hasPassed(oldHash, ScriptCache::SyntaxCheck));
+
+    // the old file stays while another URL still has those contents
+    QVERIFY(QFile::exists(scriptCache->diskCacheFilePath(oldHash)));
+    QCOMPARE(scriptCache->loadFromDisk(COPY_URL), OLD_CONTENTS);
+    store(COPY_URL, NEW_CONTENTS);
+    QVERIFY(!QFile::exists(scriptCache->diskCacheFilePath(oldHash)));
+    QCOMPARE(scriptCache->loadFromDisk(COPY_URL), NEW_CONTENTS);
+}
@@ -0,0 +1,32 @@
+//
+//  ScriptCacheTests.h
+//  tests/script-engine/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ScriptCacheTests_h
+#define hifi_ScriptCacheTests_h
+
+#include <memory>
+
+#include <QtCore/QObject>
+
+class ScriptCache;
+
+class ScriptCacheTests : public QObject {
+    Q_OBJECT
+private:
+    // a cache of its own, rather than the DependencyManager's, so that each test can start over
+    static std::shared_ptr<ScriptCache> makeScriptCache();
+
+private slots:
+    void testFindDependencies();
+    void testDiskCacheRoundTrip();
+    void testContentChange();
+};
+
+#endif // hifi_ScriptCacheTests_h
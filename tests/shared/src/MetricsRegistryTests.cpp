@@ -0,0 +1,154 @@
+//
+//  MetricsRegistryTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MetricsRegistryTests.h"
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <QtTest/QtTest>
+
+#include <MetricsRegistry.h>
+
+QTEST_MAIN(MetricsRegistryTests)
+
+void MetricsRegistryTests::testBucketBounds() {
+    // small values are exact
+    for (uint64_t value = 0; value < (uint64_t)MetricHistogram::SUB_BUCKETS; ++value) {
+        int index = MetricHistogram::bucketIndex(value);
+        QCOMPARE(MetricHistogram::bucketLowerBound(index), value);
+        QCOMPARE(MetricHistogram::bucketUpperBound(index), value + 1);
+    }
+
+    std::mt19937_64 generator(1);
+    for (int i = 0; i < 100000; ++i) {
+        // spread the values over every power of two
+        uint64_t value = generator() >> (generator() % 64);
+        int index = MetricHistogram::bucketIndex(value);
+        QVERIFY(index >= 0 && index < MetricHistogram::NUM_BUCKETS);
+        QVERIFY(MetricHistogram::bucketLowerBound(index) <= value);
+        QVERIFY(value < MetricHistogram::bucketUpperBound(index) || value == UINT64_MAX);
+
+        // a bucket is never wider than 1 / SUB_BUCKETS of its values
+        uint64_t width = MetricHistogram::bucketUpperBound(index) - MetricHistogram::bucketLowerBound(index);
+        QVERIFY(width <= std::max((uint64_t)1, MetricHistogram::bucketLowerBound(index) / MetricHistogram::SUB_BUCKETS));
+    }
+
+    // buckets are contiguous
+    for (int index = 1; index < MetricHistogram::NUM_BUCKETS; ++index) {
+        QCOMPARE(MetricHistogram::bucketLowerBound(index), MetricHistogram::bucketUpperBound(index - 1));
+    }
+    QCOMPARE(MetricHistogram::bucketIndex(UINT64_MAX), MetricHistogram::NUM_BUCKETS - 1);
+}
+
+void MetricsRegistryTests::testQuantiles() {
+    MetricHistogram histogram;
+    QCOMPARE(histogram.getQuantile(0.5), (uint64_t)0);
+
+    std::vector<uint64_t> values;
+    std::mt19937 generator(1);
+    std::lognormal_distribution<double> distribution(7.0, 1.0); // a long tail, like frame times in usecs
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t value = (uint64_t)distribution(generator);
+        values.push_back(value);
+        histogram.record(value);
+    }
+    std::sort(values.begin(), values.end());
+
+    QCOMPARE(histogram.getCount(), (uint64_t)values.size());
+    QCOMPARE(histogram.getSum(), std::accumulate(values.begin(), values.end(), (uint64_t)0));
+
+    for (double q : { 0.01, 0.5, 0.9, 0.99, 0.999, 1.0 }) {
+        uint64_t exact = values[std::max((size_t)1, (size_t)std::ceil(q * values.size())) - 1];
+        uint64_t estimate = histogram.getQuantile(q);
+        QVERIFY(estimate >= exact);
+        QVERIFY(estimate - exact <= std::max((uint64_t)1, exact / MetricHistogram::SUB_BUCKETS));
+    }
+}
+
+void MetricsRegistryTests::testConcurrentUpdates() {
+    MetricsRegistry registry;
+    const int NUM_THREADS = 8;
+    const int NUM_UPDATES = 100000;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([&registry] {
+            // every thread registers the same metrics and gets the same instances back
+            auto counter = registry.counter("test_updates_total", "Updates");
+            auto histogram = registry.histogram("test_update_value", "Update values");
+            for (int j = 0; j < NUM_UPDATES; ++j) {
+                counter->increment();
+                histogram->record(j);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    QCOMPARE(registry.counter("test_updates_total", "Updates")->get(), (uint64_t)(NUM_THREADS * NUM_UPDATES));
+    auto histogram = registry.histogram("test_update_value", "Update values");
+    QCOMPARE(histogram->getCount(), (uint64_t)(NUM_THREADS * NUM_UPDATES));
+    QCOMPARE(histogram->getSum(), (uint64_t)NUM_THREADS * ((uint64_t)NUM_UPDATES * (NUM_UPDATES - 1) / 2));
+}
+
+void MetricsRegistryTests::testPrometheusText() {
+    MetricsRegistry registry;
+    registry.counter("test_packets_total", "Packets sent", MetricsRegistry::label("type", "audio"))->increment(3);
+    registry.gauge("test_listeners", "Connected listeners")->set(2.5);
+    auto histogram = registry.histogram("test_frame_microseconds", "Frame time\nin usecs",
+        MetricsRegistry::label("stage", "mix \"all\""));
+    histogram->record(1);
+    histogram->record(10);
+    histogram->record(10);
+    histogram->record(100);
+
+    // a name can't be reused with another type
+    registry.gauge("test_packets_total", "Packets sent")->set(1.0);
+
+    QString text = registry.toPrometheusText();
+    QVERIFY(text.contains("# HELP test_packets_total Packets sent\n# TYPE test_packets_total counter\n"
+                          "test_packets_total{type=\"audio\"} 3\n"));
+    QVERIFY(!text.contains("test_packets_total 1"));
+    QVERIFY(text.contains("# TYPE test_listeners gauge\ntest_listeners 2.5\n"));
+
+    QVERIFY(text.contains("# HELP test_frame_microseconds Frame time\\nin usecs\n"));
+    QVERIFY(text.contains("# TYPE test_frame_microseconds histogram\n"));
+    const QString LABELS = "stage=\"mix \\\"all\\\"\"";
+    QVERIFY(text.contains("test_frame_microseconds_bucket{" + LABELS + ",le=\"3\"} 1\n"));
+    QVERIFY(text.contains("test_frame_microseconds_bucket{" + LABELS + ",le=\"11\"} 3\n"));
+    QVERIFY(text.contains("test_frame_microseconds_bucket{" + LABELS + ",le=\"+Inf\"} 4\n"));
+    QVERIFY(text.contains("test_frame_microseconds_sum{" + LABELS + "} 121\n"));
+    QVERIFY(text.contains("test_frame_microseconds_count{" + LABELS + "} 4\n"));
+
+    // buckets stop after the largest value
+    QVERIFY(text.contains("test_frame_microseconds_bucket{" + LABELS + ",le=\"95\"} 3\n"));
+    QVERIFY(text.contains("test_frame_microseconds_bucket{" + LABELS + ",le=\"127\"} 4\n"));
+    QVERIFY(!text.contains("le=\"191\""));
+
+    registry.remove("test_frame_microseconds", MetricsRegistry::label("stage", "mix \"all\""));
+    QVERIFY(!registry.toPrometheusText().contains("test_frame_microseconds"));
+}
+
+void MetricsRegistryTests::recordPerf() {
+    MetricHistogram histogram;
+    const int NUM_RECORDS = 10000000;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < NUM_RECORDS; ++i) {
+        histogram.record((uint64_t)i);
+    }
+    auto elapsed = std::chrono::high_resolution_clock::now() - start;
+    qDebug() << "histogram record:" << std::chrono::duration<double, std::nano>(elapsed).count() / NUM_RECORDS << "ns";
+}
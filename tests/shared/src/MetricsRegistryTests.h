@@ -0,0 +1,26 @@
+//
+//  MetricsRegistryTests.h
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MetricsRegistryTests_h
+#define hifi_MetricsRegistryTests_h
+
+#include <QtCore/QObject>
+
+class MetricsRegistryTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testBucketBounds();
+    void testQuantiles();
+    void testConcurrentUpdates();
+    void testPrometheusText();
+    void recordPerf();
+};
+
+#endif // hifi_MetricsRegistryTests_h
@@ -0,0 +1,293 @@
+//
+//  PrioritySortUtilTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PrioritySortUtilTests.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <QtTest/QtTest>
+
+#include <GLMHelpers.h>
+#include <PrioritySortUtil.h>
+#include <ViewFrustum.h>
+
+QTEST_MAIN(PrioritySortUtilTests)
+
+using namespace PrioritySortUtil;
+
+namespace {
+
+class SortableThing : public Sortable {
+public:
+    SortableThing(int id, const std::shared_ptr<glm::vec3>& position, float radius, uint64_t timestamp) :
+        _id(id), _position(position), _radius(radius), _timestamp(timestamp) {
+    }
+    glm::vec3 getPosition() const override { return *_position; }
+    float getRadius() const override { return _radius; }
+    uint64_t getTimestamp() const override { return _timestamp; }
+    int getID() const { return _id; }
+
+private:
+    int _id;
+    std::shared_ptr<glm::vec3> _position; // behind a pointer, like the avatars and entities are
+    float _radius;
+    uint64_t _timestamp;
+};
+
+// the way PriorityQueue used to compute the priorities, one thing and one view at a time
+float computeReferencePriority(const ConicalViewFrustums& views, const Weights& weights, uint64_t now,
+                               const SortableThing& thing) {
+    float priority = std::numeric_limits<float>::min();
+    for (const auto& view : views) {
+        glm::vec3 position = thing.getPosition();
+        glm::vec3 offset = position - view.getPosition();
+        float distance = glm::length(offset) + 0.001f;
+        const float MIN_RADIUS = 0.1f;
+        float radius = glm::max(thing.getRadius(), MIN_RADIUS);
+        float cosineAngle = glm::dot(offset, view.getDirection()) / distance;
+        if (cosineAngle > 0.0f) {
+            cosineAngle = std::sqrt(cosineAngle);
+        }
+        float age = float((now - thing.getTimestamp()) / USECS_PER_SECOND);
+        float angularSize = radius / distance;
+        float viewPriority = (weights.angular * angularSize + weights.center * cosineAngle) * (age + 1.0f) +
+            weights.age * age;
+        if (distance - radius > view.getRadius()) {
+            if (!view.intersects(offset, distance, radius)) {
+                viewPriority += OUT_OF_VIEW_PENALTY;
+            }
+        }
+        priority = std::max(priority, viewPriority);
+    }
+    return priority;
+}
+
+ConicalViewFrustums makeViews() {
+    ConicalViewFrustums views;
+    ViewFrustum viewFrustum;
+    viewFrustum.setProjection(60.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+    viewFrustum.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    viewFrustum.setOrientation(glm::angleAxis(0.3f, glm::vec3(0.0f, 1.0f, 0.0f)));
+    viewFrustum.calculate();
+    views.emplace_back(viewFrustum);
+    views.back().calculate();
+
+    // a second camera looking the other way, as when a secondary camera is active
+    viewFrustum.setPosition(glm::vec3(-20.0f, 0.0f, 5.0f));
+    viewFrustum.setOrientation(glm::angleAxis(2.5f, glm::vec3(0.0f, 1.0f, 0.0f)));
+    viewFrustum.calculate();
+    views.emplace_back(viewFrustum);
+    views.back().calculate();
+    return views;
+}
+
+std::vector<SortableThing> makeThings(std::mt19937& generator, int numThings, uint64_t now) {
+    std::uniform_real_distribution<float> coordinates(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> radii(0.0f, 5.0f);
+    std::vector<SortableThing> things;
+    things.reserve(numThings);
+    for (int i = 0; i < numThings; ++i) {
+        auto position = std::make_shared<glm::vec3>(coordinates(generator), coordinates(generator), coordinates(generator));
+        // whole seconds and a half, so that the ages don't depend on when the queue reads the clock
+        uint64_t timestamp = now - (i % 7) * USECS_PER_SECOND - USECS_PER_SECOND / 2;
+        things.emplace_back(i, position, (i % 11 == 0) ? 0.0f : radii(generator), timestamp);
+    }
+    return things;
+}
+
+}
+
+void PrioritySortUtilTests::testPriorities() {
+    std::mt19937 generator(7);
+    auto views = makeViews();
+    Weights weights { 1.0f, 0.5f, 0.25f };
+    uint64_t now = usecTimestampNow();
+
+    // an odd count, so that some are left over after the four at a time
+    auto things = makeThings(generator, 1003, now);
+    SortableArrays arrays;
+    for (const auto& thing : things) {
+        arrays.push(thing.getPosition(), thing.getRadius(), float((now - thing.getTimestamp()) / USECS_PER_SECOND));
+    }
+
+    RankedVector ranked;
+    computePriorities(views, weights, arrays, ranked);
+    QCOMPARE(ranked.size(), things.size());
+    int numOutOfView = 0;
+    for (size_t i = 0; i < things.size(); ++i) {
+        QCOMPARE(ranked[i].index, (uint32_t)i);
+        QCOMPARE(ranked[i].priority, computeReferencePriority(views, weights, now, things[i]));
+        if (ranked[i].priority < OUT_OF_VIEW_THRESHOLD) {
+            ++numOutOfView;
+        }
+    }
+    // both sides of the keyhole were tested
+    QVERIFY(numOutOfView > 0);
+    QVERIFY(numOutOfView < (int)things.size());
+
+    computePriorities(ConicalViewFrustums(), weights, arrays, ranked);
+    for (const auto& thing : ranked) {
+        QCOMPARE(thing.priority, std::numeric_limits<float>::min());
+    }
+}
+
+void PrioritySortUtilTests::testSortedVector() {
+    std::mt19937 generator(11);
+    auto views = makeViews();
+    uint64_t now = usecTimestampNow();
+    auto things = makeThings(generator, 2000, now);
+
+    PriorityQueue<SortableThing> queue(views, 1.0f, 0.5f, 0.25f);
+    for (int numToSort : { 0, 100, 1999, 2000, 37 }) {
+        queue.clear();
+        for (const auto& thing : things) {
+            queue.push(thing);
+        }
+        const auto& sorted = queue.getSortedVector(numToSort);
+        QCOMPARE(sorted.size(), things.size());
+
+        std::vector<float> expected;
+        for (const auto& thing : things) {
+            expected.push_back(computeReferencePriority(views, { 1.0f, 0.5f, 0.25f }, now, thing));
+        }
+        std::vector<float> highest = expected;
+        std::sort(highest.begin(), highest.end(), std::greater<float>());
+
+        size_t numSorted = numToSort == 0 ? things.size() : (size_t)numToSort;
+        std::vector<bool> seen(things.size(), false);
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            int id = sorted[i].getID();
+            QVERIFY(!seen[id]);
+            seen[id] = true;
+            QCOMPARE(sorted[i].getPriority(), expected[id]);
+            if (i < numSorted) {
+                QCOMPARE(sorted[i].getPriority(), highest[i]);
+            }
+        }
+
+        // sorting again changes nothing
+        const auto& again = queue.getSortedVector(numToSort);
+        for (size_t i = 0; i < numSorted; ++i) {
+            QCOMPARE(again[i].getPriority(), highest[i]);
+        }
+    }
+}
+
+void PrioritySortUtilTests::testSortHighest() {
+    std::mt19937 generator(13);
+    std::uniform_real_distribution<float> priorities(-10.0f, 10.0f);
+    float threshold = NO_THRESHOLD;
+    const uint32_t NUM_THINGS = 5000;
+    for (int frame = 0; frame < 40; ++frame) {
+        // every few frames everything jumps, so that the last threshold is too low or too high to help
+        float shift = (frame % 5 == 4) ? 100.0f : ((frame % 7 == 6) ? -100.0f : 0.0f);
+        RankedVector ranked(NUM_THINGS);
+        std::vector<float> expected;
+        for (uint32_t i = 0; i < NUM_THINGS; ++i) {
+            ranked[i] = { priorities(generator) + shift, i };
+            expected.push_back(ranked[i].priority);
+        }
+        std::sort(expected.begin(), expected.end(), std::greater<float>());
+
+        size_t numToSort = 50 + frame * 20;
+        sortHighest(ranked, numToSort, threshold);
+        for (size_t i = 0; i < numToSort; ++i) {
+            QCOMPARE(ranked[i].priority, expected[i]);
+        }
+        QCOMPARE(threshold, expected[numToSort - 1]);
+
+        std::vector<bool> seen(NUM_THINGS, false);
+        for (const auto& thing : ranked) {
+            QVERIFY(!seen[thing.index]);
+            seen[thing.index] = true;
+        }
+    }
+}
+
+void PrioritySortUtilTests::sortPerf() {
+    // the entity renderer with a big backlog of renderables to update, and the camera turning
+    const int NUM_THINGS = 10000;
+    const int NUM_FRAMES = 100;
+    const int NUM_TO_SORT = 500;
+    std::mt19937 generator(17);
+    auto views = makeViews();
+    Weights weights;
+    uint64_t now = usecTimestampNow();
+    auto things = makeThings(generator, NUM_THINGS, now);
+
+    using Clock = std::chrono::high_resolution_clock;
+    auto usecsPerFrame = [&](Clock::time_point start) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / NUM_FRAMES;
+    };
+    auto turn = [&](int frame) {
+        auto turned = views;
+        for (auto& view : turned) {
+            ViewFrustum viewFrustum;
+            viewFrustum.setProjection(60.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+            viewFrustum.setPosition(view.getPosition());
+            viewFrustum.setOrientation(glm::angleAxis(0.01f * frame, glm::vec3(0.0f, 1.0f, 0.0f)));
+            viewFrustum.calculate();
+            view.set(viewFrustum);
+            view.calculate();
+        }
+        return turned;
+    };
+    std::vector<ConicalViewFrustums> frameViews;
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        frameViews.push_back(turn(frame));
+    }
+
+    // priorities one thing at a time, then sorting the things themselves
+    auto referenceSort = [&](int numToSort) {
+        auto start = Clock::now();
+        for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+            std::vector<SortableThing> sorted;
+            sorted.reserve(NUM_THINGS);
+            for (const auto& thing : things) {
+                sorted.push_back(thing);
+                sorted.back().setPriority(computeReferencePriority(frameViews[frame], weights, now, thing));
+            }
+            auto higher = [](const SortableThing& left, const SortableThing& right) {
+                return left.getPriority() > right.getPriority();
+            };
+            if (numToSort == 0) {
+                std::sort(sorted.begin(), sorted.end(), higher);
+            } else {
+                std::partial_sort(sorted.begin(), sorted.begin() + numToSort, sorted.end(), higher);
+            }
+        }
+        return usecsPerFrame(start);
+    };
+
+    auto queueSort = [&](int numToSort) {
+        PriorityQueue<SortableThing> queue(views);
+        auto start = Clock::now();
+        for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+            queue.clear();
+            queue.setViews(frameViews[frame]);
+            queue.reserve(NUM_THINGS);
+            for (const auto& thing : things) {
+                queue.push(thing);
+            }
+            queue.getSortedVector(numToSort);
+        }
+        return usecsPerFrame(start);
+    };
+
+    qDebug() << NUM_THINGS << "things, two views, usecs per frame:";
+    qDebug() << "    full sort, one at a time:" << referenceSort(0);
+    qDebug() << "    full sort, priority queue:" << queueSort(0);
+    qDebug() << "    top" << NUM_TO_SORT << "partial_sort, one at a time:" << referenceSort(NUM_TO_SORT);
+    qDebug() << "    top" << NUM_TO_SORT << "priority queue kept between frames:" << queueSort(NUM_TO_SORT);
+}
@@ -0,0 +1,25 @@
+//
+//  PrioritySortUtilTests.h
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PrioritySortUtilTests_h
+#define hifi_PrioritySortUtilTests_h
+
+#include <QtCore/QObject>
+
+class PrioritySortUtilTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testPriorities();
+    void testSortedVector();
+    void testSortHighest();
+    void sortPerf();
+};
+
+#endif // hifi_PrioritySortUtilTests_h
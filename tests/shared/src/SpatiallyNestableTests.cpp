@@ -0,0 +1,200 @@
+//
+//  SpatiallyNestableTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpatiallyNestableTests.h"
+
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+#include <QtTest/QtTest>
+
+#include <DependencyManager.h>
+#include <NumericalConstants.h>
+#include <SpatialParentFinder.h>
+#include <SpatiallyNestable.h>
+#include <UUIDHasher.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(SpatiallyNestableTests)
+
+class TestParentFinder : public SpatialParentFinder {
+public:
+    SpatiallyNestableWeakPointer find(QUuid parentID, bool& success, SpatialParentTree* entityTree = nullptr) const override {
+        auto itr = nestables.find(parentID);
+        success = itr != nestables.end();
+        return success ? itr->second : SpatiallyNestableWeakPointer();
+    }
+
+    std::unordered_map<QUuid, SpatiallyNestableWeakPointer> nestables;
+};
+
+static SpatiallyNestablePointer makeNestable(const SpatiallyNestablePointer& parent = SpatiallyNestablePointer()) {
+    auto nestable = std::make_shared<SpatiallyNestable>(NestableType::Entity, QUuid::createUuid());
+    DependencyManager::get<TestParentFinder>()->nestables[nestable->getID()] = nestable;
+    if (parent) {
+        nestable->setParentID(parent->getID());
+    }
+    return nestable;
+}
+
+// a chain of nestables each a meter along and a quarter turn around from its parent
+static std::vector<SpatiallyNestablePointer> makeChain(int length) {
+    std::vector<SpatiallyNestablePointer> chain;
+    for (int i = 0; i < length; ++i) {
+        chain.push_back(makeNestable(i > 0 ? chain.back() : SpatiallyNestablePointer()));
+        chain.back()->setLocalPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+        chain.back()->setLocalOrientation(glm::angleAxis(PI_OVER_TWO, glm::vec3(0.0f, 1.0f, 0.0f)));
+    }
+    return chain;
+}
+
+// the world transform, worked out up the chain without any caching
+static Transform expectedTransform(const SpatiallyNestablePointer& nestable) {
+    Transform result = nestable->getLocalTransform();
+    bool success;
+    for (auto parent = nestable->getParentPointer(success); parent; parent = parent->getParentPointer(success)) {
+        Transform childTransform = result;
+        Transform::mult(result, parent->getLocalTransform(), childTransform);
+    }
+    return result;
+}
+
+void SpatiallyNestableTests::initTestCase() {
+    DependencyManager::registerInheritance<SpatialParentFinder, TestParentFinder>();
+    DependencyManager::set<TestParentFinder>();
+}
+
+void SpatiallyNestableTests::testCachedTransformFollowsAncestors() {
+    auto chain = makeChain(4);
+    auto& root = chain.front();
+    auto& leaf = chain.back();
+
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldPosition(), expectedTransform(leaf).getTranslation(), EPSILON);
+
+    // asking again comes from the cache, and has to agree
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldPosition(), expectedTransform(leaf).getTranslation(), EPSILON);
+
+    // each kind of move of an ancestor reaches the leaf
+    root->setWorldPosition(glm::vec3(10.0f, 0.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldPosition(), expectedTransform(leaf).getTranslation(), EPSILON);
+
+    chain[1]->setLocalOrientation(glm::angleAxis(PI, glm::vec3(0.0f, 0.0f, 1.0f)));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldOrientation(), expectedTransform(leaf).getRotation(), EPSILON);
+
+    chain[2]->setLocalSNScale(glm::vec3(2.0f));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldPosition(), expectedTransform(leaf).getTranslation(), EPSILON);
+
+    Transform rootTransform;
+    rootTransform.setTranslation(glm::vec3(0.0f, 5.0f, 0.0f));
+    root->setTransform(rootTransform);
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldPosition(), expectedTransform(leaf).getTranslation(), EPSILON);
+}
+
+void SpatiallyNestableTests::testReparent() {
+    auto chain = makeChain(3);
+    auto other = makeNestable();
+    other->setWorldPosition(glm::vec3(0.0f, 0.0f, -20.0f));
+    auto& leaf = chain.back();
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldPosition(), expectedTransform(leaf).getTranslation(), EPSILON);
+
+    chain[1]->setParentID(other->getID());
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldPosition(), expectedTransform(leaf).getTranslation(), EPSILON);
+
+    chain[1]->setParentID(QUuid());
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldPosition(), expectedTransform(leaf).getTranslation(), EPSILON);
+
+    // moving the old parent no longer moves it
+    glm::vec3 position = leaf->getWorldPosition();
+    other->setWorldPosition(glm::vec3(0.0f, 0.0f, 20.0f));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldPosition(), position, EPSILON);
+}
+
+void SpatiallyNestableTests::testBatchedUpdates() {
+    SpatiallyNestable::setBatchedTransformUpdates(true);
+
+    // a few trees of different depths, so the update goes level by level
+    std::vector<std::vector<SpatiallyNestablePointer>> chains;
+    for (int i = 1; i <= 8; ++i) {
+        chains.push_back(makeChain(i));
+    }
+    SpatiallyNestable::updateWorldTransforms();
+
+    for (int frame = 0; frame < 4; ++frame) {
+        for (auto& chain : chains) {
+            chain.front()->setWorldPosition(glm::vec3((float)frame, 0.0f, (float)chain.size()));
+            if (chain.size() > 2) {
+                chain[chain.size() / 2]->setLocalOrientation(glm::angleAxis(0.1f * frame, glm::vec3(1.0f, 0.0f, 0.0f)));
+            }
+        }
+        SpatiallyNestable::updateWorldTransforms();
+
+        for (auto& chain : chains) {
+            for (auto& nestable : chain) {
+                Transform expected = expectedTransform(nestable);
+                QCOMPARE_WITH_ABS_ERROR(nestable->getWorldPosition(), expected.getTranslation(), EPSILON);
+                QCOMPARE_WITH_ABS_ERROR(nestable->getWorldOrientation(), expected.getRotation(), EPSILON);
+            }
+        }
+    }
+
+    // a nestable that goes away after it moved is skipped
+    auto doomed = makeNestable();
+    doomed->setWorldPosition(glm::vec3(1.0f));
+    doomed.reset();
+    SpatiallyNestable::updateWorldTransforms();
+
+    SpatiallyNestable::setBatchedTransformUpdates(false);
+}
+
+void SpatiallyNestableTests::transformPerf() {
+    // world positions of every nestable in deep trees, as the renderer and physics ask for them each frame,
+    // after the roots move
+    const int NUM_CHAINS = 1000;
+    const int CHAIN_LENGTH = 8;
+    const int NUM_FRAMES = 10;
+    std::vector<std::vector<SpatiallyNestablePointer>> chains;
+    for (int i = 0; i < NUM_CHAINS; ++i) {
+        chains.push_back(makeChain(CHAIN_LENGTH));
+    }
+
+    for (bool batched : { false, true }) {
+        SpatiallyNestable::setBatchedTransformUpdates(batched);
+        std::chrono::nanoseconds updateTime { 0 };
+        std::chrono::nanoseconds readTime { 0 };
+        for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+            for (auto& chain : chains) {
+                chain.front()->setWorldPosition(glm::vec3((float)frame, 0.0f, 0.0f));
+            }
+
+            auto start = std::chrono::high_resolution_clock::now();
+            SpatiallyNestable::updateWorldTransforms();
+            auto updated = std::chrono::high_resolution_clock::now();
+            glm::vec3 sum;
+            for (int reads = 0; reads < 3; ++reads) {
+                for (auto& chain : chains) {
+                    for (auto& nestable : chain) {
+                        sum += nestable->getWorldPosition();
+                    }
+                }
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            updateTime += updated - start;
+            readTime += end - updated;
+            QVERIFY(!glm::any(glm::isnan(sum)));
+        }
+        qDebug() << NUM_CHAINS << "chains of" << CHAIN_LENGTH << (batched ? "batched:" : "unbatched:")
+            << std::chrono::duration<float, std::milli>(updateTime).count() / NUM_FRAMES << "ms update,"
+            << std::chrono::duration<float, std::milli>(readTime).count() / NUM_FRAMES << "ms to read each world position 3 times";
+    }
+    SpatiallyNestable::setBatchedTransformUpdates(false);
+}
@@ -0,0 +1,239 @@
+//
+//  TimerWheelTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheelTests.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <QtTest/QtTest>
+
+#include <TimerWheel.h>
+
+QTEST_MAIN(TimerWheelTests)
+
+static std::vector<TimerWheel::TimerID> advance(TimerWheel& wheel, uint64_t now) {
+    std::vector<TimerWheel::Expired> expired;
+    wheel.advance(now, expired);
+    std::vector<TimerWheel::TimerID> ids;
+    for (const auto& timer : expired) {
+        ids.push_back(timer.id);
+    }
+    return ids;
+}
+
+void TimerWheelTests::testExpiryOrder() {
+    TimerWheel wheel(1000);
+    auto late = wheel.add(1000, 30, false);
+    auto early = wheel.add(1000, 10, false);
+    auto sameAsEarly = wheel.add(1000, 10, false);
+    auto immediate = wheel.add(1000, 0, false);
+
+    QVERIFY(advance(wheel, 1000).empty());
+
+    // a zero timeout fires on the next tick
+    QCOMPARE(advance(wheel, 1001), std::vector<TimerWheel::TimerID>({ immediate }));
+    QVERIFY(advance(wheel, 1009).empty());
+
+    // one batch, in deadline then creation order
+    QCOMPARE(advance(wheel, 1050), std::vector<TimerWheel::TimerID>({ early, sameAsEarly, late }));
+    QVERIFY(wheel.empty());
+}
+
+void TimerWheelTests::testRemove() {
+    TimerWheel wheel(0);
+    auto kept = wheel.add(0, 5, false);
+    auto removed = wheel.add(0, 5, false);
+
+    QVERIFY(wheel.remove(removed));
+    QVERIFY(!wheel.remove(removed));
+    QCOMPARE(wheel.size(), (size_t)1);
+
+    QCOMPARE(advance(wheel, 5), std::vector<TimerWheel::TimerID>({ kept }));
+
+    // a timer that has fired is gone
+    QVERIFY(!wheel.remove(kept));
+    QVERIFY(wheel.empty());
+}
+
+void TimerWheelTests::testRepeating() {
+    TimerWheel wheel(0);
+    auto interval = wheel.add(0, 10, true);
+
+    QCOMPARE(advance(wheel, 10), std::vector<TimerWheel::TimerID>({ interval }));
+    QCOMPARE(advance(wheel, 20), std::vector<TimerWheel::TimerID>({ interval }));
+
+    // a late dispatch fires once and stays in phase
+    QCOMPARE(advance(wheel, 55), std::vector<TimerWheel::TimerID>({ interval }));
+    QVERIFY(advance(wheel, 59).empty());
+    QCOMPARE(advance(wheel, 60), std::vector<TimerWheel::TimerID>({ interval }));
+
+    QVERIFY(wheel.contains(interval));
+    QVERIFY(wheel.remove(interval));
+    QVERIFY(advance(wheel, 100).empty());
+}
+
+void TimerWheelTests::testCascade() {
+    // start just short of level boundaries, so timers have to move down through every level
+    for (uint64_t start : { (uint64_t)0, (uint64_t)250, (uint64_t)(1 << 16) - 3, (uint64_t)(1ULL << 32) - 7 }) {
+        TimerWheel wheel(start);
+        std::vector<uint32_t> intervals { 1, 255, 256, 257, 1000, 65535, 65536, 70000, 1 << 24, (1 << 24) + 5 };
+        std::map<TimerWheel::TimerID, uint64_t> deadlines;
+        for (auto interval : intervals) {
+            deadlines[wheel.add(start, interval, false)] = start + interval;
+        }
+
+        for (const auto& timer : deadlines) {
+            QVERIFY(advance(wheel, timer.second - 1).empty());
+            QCOMPARE(advance(wheel, timer.second), std::vector<TimerWheel::TimerID>({ timer.first }));
+        }
+        QVERIFY(wheel.empty());
+    }
+}
+
+void TimerWheelTests::testAgainstReference() {
+    struct Timer {
+        uint64_t deadline;
+        uint32_t interval;
+        bool repeating;
+    };
+
+    std::mt19937 generator(1);
+    const std::vector<uint64_t> STEPS { 0, 1, 1, 3, 16, 17, 300 };
+    const std::vector<uint32_t> INTERVALS { 0, 1, 5, 100, 255, 256, 257, 1000, 70000, (1 << 24) + 3 };
+
+    for (uint64_t start : { (uint64_t)0, (uint64_t)(1 << 24) - 100, (uint64_t)(1ULL << 32) - 5000 }) {
+        TimerWheel wheel(start);
+        std::map<TimerWheel::TimerID, Timer> reference;
+        uint64_t now = start;
+
+        for (int step = 0; step < 5000; ++step) {
+            now += STEPS[generator() % STEPS.size()];
+
+            auto fired = advance(wheel, now);
+            std::sort(fired.begin(), fired.end());
+
+            std::vector<TimerWheel::TimerID> expected;
+            for (auto itr = reference.begin(); itr != reference.end();) {
+                auto& timer = itr->second;
+                if (timer.deadline > now) {
+                    ++itr;
+                    continue;
+                }
+                expected.push_back(itr->first);
+                if (timer.repeating) {
+                    timer.deadline += timer.interval * ((now - timer.deadline) / timer.interval + 1);
+                    ++itr;
+                } else {
+                    itr = reference.erase(itr);
+                }
+            }
+            QCOMPARE(fired, expected);
+
+            for (int i = generator() % 3; i > 0; --i) {
+                uint32_t interval = INTERVALS[generator() % INTERVALS.size()];
+                bool repeating = generator() % 4 == 0;
+                auto id = wheel.add(now, interval, repeating);
+                // the wheel fires zero timeouts on the next tick, and treats a zero interval as one
+                reference[id] = { now + std::max(interval, 1U), std::max(interval, 1U), repeating };
+            }
+
+            if (!reference.empty() && generator() % 5 == 0) {
+                auto itr = reference.begin();
+                std::advance(itr, generator() % reference.size());
+                QVERIFY(wheel.remove(itr->first));
+                reference.erase(itr);
+            }
+
+            QCOMPARE(wheel.size(), reference.size());
+        }
+    }
+}
+
+void TimerWheelTests::testTimeUntilNextExpiry() {
+    TimerWheel wheel(1000);
+    QCOMPARE(wheel.timeUntilNextExpiry(1000), std::numeric_limits<uint64_t>::max());
+
+    auto near = wheel.add(1000, 20, false);
+    wheel.add(1000, 5000, false);
+    QCOMPARE(wheel.timeUntilNextExpiry(1000), (uint64_t)20);
+    QCOMPARE(wheel.timeUntilNextExpiry(1015), (uint64_t)5);
+    QCOMPARE(wheel.timeUntilNextExpiry(1030), (uint64_t)0);
+
+    // once only far timers are left, the wait never overshoots them
+    wheel.remove(near);
+    uint64_t now = 1000;
+    while (!wheel.empty()) {
+        uint64_t wait = wheel.timeUntilNextExpiry(now);
+        QVERIFY(wait > 0);
+        QVERIFY(now + wait <= 6000);
+        now += wait;
+        advance(wheel, now);
+    }
+    QCOMPARE(now, (uint64_t)6000);
+}
+
+void TimerWheelTests::testSubFrameInterval() {
+    // mirrors ScriptEngine, which wakes up for the next expiry rather than once per frame, so an interval shorter
+    // than a frame has to keep firing at its own rate
+    const uint64_t START = 1000;
+    const uint64_t END = START + 10 * 16;
+    TimerWheel wheel(START);
+    auto fast = wheel.add(START, 5, true);
+    auto slow = wheel.add(START, 40, true);
+
+    std::map<TimerWheel::TimerID, std::vector<uint64_t>> fired;
+    uint64_t now = START;
+    while (true) {
+        now += wheel.timeUntilNextExpiry(now);
+        if (now > END) {
+            break;
+        }
+        for (auto id : advance(wheel, now)) {
+            fired[id].push_back(now);
+        }
+    }
+
+    QCOMPARE((int)fired[fast].size(), 32);
+    QCOMPARE((int)fired[slow].size(), 4);
+    for (size_t i = 0; i < fired[fast].size(); ++i) {
+        QCOMPARE(fired[fast][i], START + 5 * (i + 1));
+    }
+}
+
+void TimerWheelTests::dispatchPerf() {
+    // many scripts, each with a few intervals, dispatched once per 60Hz frame
+    const int NUM_TIMERS = 100000;
+    const int NUM_FRAMES = 600;
+    const uint64_t FRAME_MSECS = 16;
+
+    std::mt19937 generator(1);
+    TimerWheel wheel(0);
+    for (int i = 0; i < NUM_TIMERS; ++i) {
+        wheel.add(0, 10 + generator() % 5000, generator() % 2 == 0);
+    }
+
+    std::vector<TimerWheel::Expired> expired;
+    uint64_t numExpired = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 1; frame <= NUM_FRAMES; ++frame) {
+        expired.clear();
+        wheel.advance(frame * FRAME_MSECS, expired);
+        numExpired += expired.size();
+    }
+    auto elapsed = std::chrono::high_resolution_clock::now() - start;
+
+    qDebug() << NUM_TIMERS << "timers," << numExpired << "expired in" << NUM_FRAMES << "frames:"
+        << std::chrono::duration<double, std::micro>(elapsed).count() / NUM_FRAMES << "usecs/frame";
+}
@@ -0,0 +1,29 @@
+//
+//  TimerWheelTests.h
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TimerWheelTests_h
+#define hifi_TimerWheelTests_h
+
+#include <QtCore/QObject>
+
+class TimerWheelTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testExpiryOrder();
+    void testRemove();
+    void testRepeating();
+    void testCascade();
+    void testAgainstReference();
+    void testTimeUntilNextExpiry();
+    void testSubFrameInterval();
+    void dispatchPerf();
+};
+
+#endif // hifi_TimerWheelTests_h
@@ -8,10 +8,14 @@
 
 #include "TraceTests.h"
 
+#include <chrono>
+#include <thread>
+
 #include <QtTest/QtTest>
 #include <QtGui/QDesktopServices>
 
 #include <Profile.h>
+#include <TraceRecorder.h>
 
 #include <NumericalConstants.h>
 #include <test-utils/QTestExtensions.h>
@@ -45,3 +49,91 @@ void TraceTests::testTraceSerialization() {
     qDebug() << "Done";
 }
 
+
+void TraceTests::testRecordingExport() {
+    const QString RECORDING_FILE = QDir::temp().filePath("testTraceRecording.hftrace");
+    const QString EXPORT_FILE = QDir::temp().filePath("testTraceRecording.json");
+    const int NUM_RANGES = 1000;
+
+    DependencyManager::set<tracing::Tracer>();
+    QVERIFY(tracing::TraceRecorder::start(RECORDING_FILE));
+    auto recordRanges = [&] {
+        for (int i = 0; i < NUM_RANGES; ++i) {
+            PROFILE_RANGE_EX(test, "RecordedRange", 0xff00ff00, i)
+            PROFILE_COUNTER(test, "RecordedCounter", { { "value", i } })
+        }
+    };
+    std::thread worker([&] {
+        PROFILE_SET_THREAD_NAME("Trace Test Worker")
+        recordRanges();
+    });
+    recordRanges();
+    worker.join();
+    tracing::TraceRecorder::stop();
+
+    QVERIFY(tracing::TraceRecorder::exportChromeTrace(RECORDING_FILE, EXPORT_FILE));
+    QFile file(EXPORT_FILE);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    QJsonArray events = QJsonDocument::fromJson(file.readAll(), &error).array();
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    int numBegins = 0;
+    int numEnds = 0;
+    int numCounters = 0;
+    QSet<qint64> threads;
+    bool foundThreadName = false;
+    for (const auto& value : events) {
+        QJsonObject event = value.toObject();
+        QString type = event["ph"].toString();
+        if (type == "M") {
+            foundThreadName = foundThreadName || event["args"].toObject()["name"].toString() == "Trace Test Worker";
+            continue;
+        }
+        QCOMPARE(event["cat"].toString(), QString("trace.test"));
+        threads.insert((qint64)event["tid"].toDouble());
+        if (type == "B") {
+            QCOMPARE(event["name"].toString(), QString("RecordedRange"));
+            ++numBegins;
+        } else if (type == "E") {
+            ++numEnds;
+        } else if (type == "C") {
+            QCOMPARE(event["name"].toString(), QString("RecordedCounter"));
+            QVERIFY(event["args"].toObject().contains("value"));
+            ++numCounters;
+        }
+    }
+    QCOMPARE(numBegins, 2 * NUM_RANGES);
+    QCOMPARE(numEnds, 2 * NUM_RANGES);
+    QCOMPARE(numCounters, 2 * NUM_RANGES);
+    QCOMPARE(threads.size(), 2);
+    QVERIFY(foundThreadName);
+
+    QFile::remove(RECORDING_FILE);
+    QFile::remove(EXPORT_FILE);
+}
+
+void TraceTests::recordingPerf() {
+    const QString RECORDING_FILE = QDir::temp().filePath("testTracePerf.hftrace");
+    // stay under a thread's buffer capacity between flushes, so nothing is dropped
+    const int NUM_RANGES = 2000;
+    const int NUM_BATCHES = 20;
+
+    QVERIFY(tracing::TraceRecorder::start(RECORDING_FILE));
+    auto numDroppedBefore = tracing::TraceRecorder::getNumDroppedEvents();
+    std::chrono::high_resolution_clock::duration elapsed { 0 };
+    for (int batch = 0; batch < NUM_BATCHES; ++batch) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < NUM_RANGES; ++i) {
+            PROFILE_RANGE(test, "PerfRange")
+        }
+        elapsed += std::chrono::high_resolution_clock::now() - start;
+        QThread::msleep(60);
+    }
+    tracing::TraceRecorder::stop();
+
+    qDebug() << std::chrono::duration<double, std::nano>(elapsed).count() / (2 * NUM_RANGES * NUM_BATCHES)
+        << "ns per recorded event," << QFileInfo(RECORDING_FILE).size() / (2 * NUM_RANGES * NUM_BATCHES) << "bytes per event,"
+        << tracing::TraceRecorder::getNumDroppedEvents() - numDroppedBefore << "dropped";
+    QFile::remove(RECORDING_FILE);
+}
@@ -15,6 +15,8 @@ class TraceTests : public QObject {
     Q_OBJECT
 private slots:
     void testTraceSerialization();
+    void testRecordingExport();
+    void recordingPerf();
 };
 
 #endif // hifi_TraceTests_h
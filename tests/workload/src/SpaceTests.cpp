@@ -22,28 +22,46 @@ const float INV_SQRT_3 = 1.0f / sqrtf(3.0f);
 
 QTEST_MAIN(SpaceTests)
 
+using Changes = std::vector<workload::Space::Change>;
+
+workload::View makeView(const glm::vec3& center, float near, float mid, float far) {
+    workload::View view;
+    view.origin = center;
+    view.regions[workload::Region::R1] = workload::Sphere(center, near);
+    view.regions[workload::Region::R2] = workload::Sphere(center, mid);
+    view.regions[workload::Region::R3] = workload::Sphere(center, far);
+    return view;
+}
+
+void applyTransaction(workload::Space& space, const workload::Transaction& transaction) {
+    space.enqueueTransaction(transaction);
+    space.enqueueFrame();
+    space.processTransactionQueue();
+}
+
 void SpaceTests::testOverlaps() {
     workload::Space space;
-    using Changes = std::vector<workload::Space::Change>;
-    using Views = std::vector<workload::Space::View>;
 
     glm::vec3 viewCenter(0.0f, 0.0f, 0.0f);
     float near = 1.0f;
     float mid = 2.0f;
     float far = 3.0f;
 
-    Views views;
-    views.push_back(workload::Space::View(viewCenter, near, mid, far));
+    workload::Views views;
+    views.push_back(makeView(viewCenter, near, mid, far));
     space.setViews(views);
 
     int32_t proxyId = 0;
     const float DELTA = 0.001f;
     float proxyRadius = 0.5f;
     glm::vec3 proxyPosition = viewCenter + glm::vec3(0.0f, 0.0f, far + proxyRadius + DELTA);
-    workload::Space::Sphere proxySphere(proxyPosition, proxyRadius);
+    workload::Sphere proxySphere(proxyPosition, proxyRadius);
 
     { // create very_far proxy
-        proxyId = space.createProxy(proxySphere);
+        proxyId = space.allocateID();
+        workload::Transaction transaction;
+        transaction.reset(proxyId, proxySphere, workload::Owner());
+        applyTransaction(space, transaction);
         QVERIFY(space.getNumObjects() == 1);
 
         Changes changes;
@@ -54,53 +72,50 @@ void SpaceTests::testOverlaps() {
     { // move proxy far
         float newRadius = 1.0f;
         glm::vec3 newPosition = viewCenter + glm::vec3(0.0f, 0.0f, far + newRadius - DELTA);
-        workload::Space::Sphere newSphere(newPosition, newRadius);
-        std::vector<workload::Space::ProxyUpdate> updates;
-        updates.push_back(workload::Space::ProxyUpdate(proxyId, newSphere));
-        space.updateProxies(updates);
+        workload::Transaction transaction;
+        transaction.update(proxyId, workload::Sphere(newPosition, newRadius));
+        applyTransaction(space, transaction);
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 1);
         QVERIFY(changes[0].proxyId == proxyId);
-        QVERIFY(changes[0].region == workload::Space::REGION_FAR);
-        QVERIFY(changes[0].prevRegion == workload::Space::REGION_UNKNOWN);
+        QVERIFY(changes[0].region == workload::Region::R3);
+        QVERIFY(changes[0].prevRegion == workload::Region::UNKNOWN);
     }
 
     { // move proxy mid
         float newRadius = 1.0f;
         glm::vec3 newPosition = viewCenter + glm::vec3(0.0f, 0.0f, mid + newRadius - DELTA);
-        workload::Space::Sphere newSphere(newPosition, newRadius);
-        std::vector<workload::Space::ProxyUpdate> updates;
-        updates.push_back(workload::Space::ProxyUpdate(proxyId, newSphere));
-        space.updateProxies(updates);
+        workload::Transaction transaction;
+        transaction.update(proxyId, workload::Sphere(newPosition, newRadius));
+        applyTransaction(space, transaction);
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 1);
         QVERIFY(changes[0].proxyId == proxyId);
-        QVERIFY(changes[0].region == workload::Space::REGION_MIDDLE);
-        QVERIFY(changes[0].prevRegion == workload::Space::REGION_FAR);
+        QVERIFY(changes[0].region == workload::Region::R2);
+        QVERIFY(changes[0].prevRegion == workload::Region::R3);
     }
 
     { // move proxy near
         float newRadius = 1.0f;
         glm::vec3 newPosition = viewCenter + glm::vec3(0.0f, 0.0f, near + newRadius - DELTA);
-        workload::Space::Sphere newSphere(newPosition, newRadius);
-        std::vector<workload::Space::ProxyUpdate> updates;
-        updates.push_back(workload::Space::ProxyUpdate(proxyId, newSphere));
-        space.updateProxies(updates);
+        workload::Transaction transaction;
+        transaction.update(proxyId, workload::Sphere(newPosition, newRadius));
+        applyTransaction(space, transaction);
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 1);
         QVERIFY(changes[0].proxyId == proxyId);
-        QVERIFY(changes[0].region == workload::Space::REGION_NEAR);
-        QVERIFY(changes[0].prevRegion == workload::Space::REGION_MIDDLE);
+        QVERIFY(changes[0].region == workload::Region::R1);
+        QVERIFY(changes[0].prevRegion == workload::Region::R2);
     }
 
     { // delete proxy
         // NOTE: atm deleting a proxy doesn't result in a "Change"
-        std::vector<int32_t> deadProxies;
-        deadProxies.push_back(proxyId);
-        space.deleteProxies(deadProxies);
+        workload::Transaction transaction;
+        transaction.remove(proxyId);
+        applyTransaction(space, transaction);
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 0);
@@ -108,8 +123,6 @@ void SpaceTests::testOverlaps() {
     }
 }
 
-#ifdef MANUAL_TEST
-
 const float WORLD_WIDTH = 1000.0f;
 const float MIN_RADIUS = 1.0f;
 const float MAX_RADIUS = 100.0f;
@@ -123,18 +136,104 @@ glm::vec3 randomVec3() {
     return v;
 }
 
-void generateSpheres(uint32_t numProxies, std::vector<workload::Space::Sphere>& spheres) {
+void generateSpheres(uint32_t numProxies, std::vector<workload::Sphere>& spheres) {
     spheres.reserve(numProxies);
     for (uint32_t i = 0; i < numProxies; ++i) {
-        workload::Space::Sphere sphere(
+        workload::Sphere sphere(
                 WORLD_WIDTH * randomFloat(),
                 WORLD_WIDTH * randomFloat(),
                 WORLD_WIDTH * randomFloat(),
-                (MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS)) * randomFloat());
+                MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS) * 0.5f * (randomFloat() + 1.0f));
         spheres.push_back(sphere);
     }
 }
 
+workload::Views makeViews(const glm::vec3& offset) {
+    // two views near the middle of the world, their regions reach a quarter of the way across it
+    float near = 0.05f * WORLD_WIDTH;
+    float mid = 0.10f * WORLD_WIDTH;
+    float far = 0.25f * WORLD_WIDTH;
+    workload::Views views;
+    views.push_back(makeView(offset, near, mid, far));
+    views.push_back(makeView(offset + glm::vec3(0.0f, 0.0f, 0.1f * WORLD_WIDTH), near, mid, far));
+    return views;
+}
+
+void SpaceTests::testGrid() {
+    // the grid only changes how the proxies are classified, not the changes that come out
+    const uint32_t NUM_PROXIES = 20000;
+    std::vector<workload::Sphere> spheres;
+    srand(1);
+    generateSpheres(NUM_PROXIES, spheres);
+
+    workload::Space spaces[2];
+    spaces[1].setGridCellSize(0.05f * WORLD_WIDTH);
+    for (auto& space : spaces) {
+        workload::Transaction transaction;
+        for (const auto& sphere : spheres) {
+            transaction.reset(space.allocateID(), sphere, workload::Owner());
+        }
+        applyTransaction(space, transaction);
+    }
+
+    for (int step = 0; step < 10; ++step) {
+        // the views walk across the world while some proxies move and some are removed
+        workload::Views views = makeViews(glm::vec3(0.1f * step * WORLD_WIDTH, 0.0f, 0.0f));
+        workload::Transaction transaction;
+        for (uint32_t i = step; i < NUM_PROXIES; i += 10) {
+            spheres[i] += workload::Sphere(0.1f * WORLD_WIDTH * randomVec3(), 0.0f);
+            transaction.update(i, spheres[i]);
+        }
+        transaction.remove(step * 100);
+
+        Changes changes[2];
+        for (int i = 0; i < 2; ++i) {
+            spaces[i].setViews(views);
+            applyTransaction(spaces[i], transaction);
+            spaces[i].categorizeAndGetChanges(changes[i]);
+        }
+        QCOMPARE(changes[1].size(), changes[0].size());
+        for (size_t i = 0; i < changes[0].size(); ++i) {
+            QCOMPARE(changes[1][i].proxyId, changes[0][i].proxyId);
+            QCOMPARE(changes[1][i].region, changes[0][i].region);
+            QCOMPARE(changes[1][i].prevRegion, changes[0][i].prevRegion);
+        }
+    }
+}
+
+void SpaceTests::categorizePerf() {
+    // time a frame of classification of 100k proxies, with and without the grid, with the views moving each frame
+    const uint32_t NUM_PROXIES = 100000;
+    const int NUM_FRAMES = 20;
+    std::vector<workload::Sphere> spheres;
+    generateSpheres(NUM_PROXIES, spheres);
+
+    for (float cellSize : { 0.0f, 0.05f * WORLD_WIDTH, 0.1f * WORLD_WIDTH }) {
+        workload::Space space;
+        space.setGridCellSize(cellSize);
+        workload::Transaction transaction;
+        for (const auto& sphere : spheres) {
+            transaction.reset(space.allocateID(), sphere, workload::Owner());
+        }
+        applyTransaction(space, transaction);
+
+        uint64_t totalTime = 0;
+        size_t numChanges = 0;
+        for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+            space.setViews(makeViews(glm::vec3(0.01f * frame * WORLD_WIDTH, 0.0f, 0.0f)));
+            Changes changes;
+            uint64_t startTime = usecTimestampNow();
+            space.categorizeAndGetChanges(changes);
+            totalTime += usecTimestampNow() - startTime;
+            numChanges += changes.size();
+        }
+        qDebug() << NUM_PROXIES << "proxies, grid cell size" << cellSize << ":"
+            << (float)totalTime / NUM_FRAMES << "usec/frame," << numChanges / NUM_FRAMES << "changes/frame";
+    }
+}
+
+#ifdef MANUAL_TEST
+
 void generatePositions(uint32_t numProxies, std::vector<glm::vec3>& positions) {
     positions.reserve(numProxies);
     for (uint32_t i = 0; i < numProxies; ++i) {
@@ -167,24 +266,29 @@ void SpaceTests::benchmark() {
             float radius0 = 0.25f * WORLD_WIDTH;
             float radius1 = 0.50f * WORLD_WIDTH;
             float radius2 = 0.75f * WORLD_WIDTH;
-            std::vector<workload::Space::View> views;
-            views.push_back(workload::Space::View(viewPositions[0], radius0, radius1, radius2));
-            views.push_back(workload::Space::View(viewPositions[1], radius0, radius1, radius2));
+            workload::Views views;
+            views.push_back(makeView(viewPositions[0], radius0, radius1, radius2));
+            views.push_back(makeView(viewPositions[1], radius0, radius1, radius2));
             space.setViews(views);
         }
 
         // build the proxies
         uint32_t n = numProxies[i];
-        std::vector<workload::Space::Sphere> proxySpheres;
+        std::vector<workload::Sphere> proxySpheres;
         generateSpheres(n, proxySpheres);
         std::vector<int32_t> proxyKeys;
         proxyKeys.reserve(n);
 
         // measure time to put proxies in the space
         uint64_t startTime = usecTimestampNow();
-        for (uint32_t j = 0; j < n; ++j) {
-            int32_t key = space.createProxy(proxySpheres[j]);
-            proxyKeys.push_back(key);
+        {
+            workload::Transaction transaction;
+            for (uint32_t j = 0; j < n; ++j) {
+                int32_t key = space.allocateID();
+                transaction.reset(key, proxySpheres[j], workload::Owner());
+                proxyKeys.push_back(key);
+            }
+            applyTransaction(space, transaction);
         }
         uint64_t usec = usecTimestampNow() - startTime;
         timeToAddAll.push_back(usec);
@@ -197,9 +301,9 @@ void SpaceTests::benchmark() {
             float radius0 = 0.25f * WORLD_WIDTH;
             float radius1 = 0.50f * WORLD_WIDTH;
             float radius2 = 0.75f * WORLD_WIDTH;
-            std::vector<workload::Space::View> views;
-            views.push_back(workload::Space::View(viewPositions[0], radius0, radius1, radius2));
-            views.push_back(workload::Space::View(viewPositions[1], radius0, radius1, radius2));
+            workload::Views views;
+            views.push_back(makeView(viewPositions[0], radius0, radius1, radius2));
+            views.push_back(makeView(viewPositions[1], radius0, radius1, radius2));
             space.setViews(views);
         }
 
@@ -212,7 +316,7 @@ void SpaceTests::benchmark() {
 
         // move every 10th proxy around
         const float proxySpeed = 1.0f;
-        std::vector<workload::Space::Sphere> newSpheres;
+        std::vector<workload::Sphere> newSpheres;
         uint32_t numMovingProxies = n / 10;
         uint32_t jstep = n / numMovingProxies;
         uint32_t maxJ = numMovingProxies * jstep - 1;
@@ -222,17 +326,21 @@ void SpaceTests::benchmark() {
             glm::vec3 destination = (glm::vec3)proxySpheres[j + jstep];
             direction = glm::normalize(destination - position);
             glm::vec3 newPosition = position + proxySpeed * direction;
-            newSpheres.push_back(workload::Space::Sphere(newPosition, proxySpheres[j].w));
+            newSpheres.push_back(workload::Sphere(newPosition, proxySpheres[j].w));
         }
         glm::vec3 position = (glm::vec3)proxySpheres[maxJ = jstep];
         glm::vec3 destination = (glm::vec3)proxySpheres[0];
         direction = glm::normalize(destination - position);
         direction = position + proxySpeed * direction;
-        newSpheres.push_back(workload::Space::Sphere(direction, proxySpheres[0].w));
+        newSpheres.push_back(workload::Sphere(direction, proxySpheres[0].w));
         uint32_t k = 0;
         startTime = usecTimestampNow();
-        for (uint32_t j = 0; j < maxJ; j += jstep) {
-            space.updateProxy(proxyKeys[j], newSpheres[k++]);
+        {
+            workload::Transaction transaction;
+            for (uint32_t j = 0; j < maxJ; j += jstep) {
+                transaction.update(proxyKeys[j], newSpheres[k++]);
+            }
+            applyTransaction(space, transaction);
         }
         changes.clear();
         space.categorizeAndGetChanges(changes);
@@ -241,8 +349,12 @@ void SpaceTests::benchmark() {
 
         // measure time to remove proxies from space
         startTime = usecTimestampNow();
-        for (uint32_t j = 0; j < n; ++j) {
-            space.deleteProxy(proxyKeys[j]);
+        {
+            workload::Transaction transaction;
+            for (uint32_t j = 0; j < n; ++j) {
+                transaction.remove(proxyKeys[j]);
+            }
+            applyTransaction(space, transaction);
         }
         usec = usecTimestampNow() - startTime;
         timeToRemoveAll.push_back(usec);
@@ -21,6 +21,8 @@ class SpaceTests : public QObject {
 
 private slots:
     void testOverlaps();
+    void testGrid();
+    void categorizePerf();
 #ifdef MANUAL_TEST
     void benchmark();
 #endif // MANUAL_TEST
@@ -0,0 +1,593 @@
+//
+//  AvatarBotsApp.cpp
+//  tools/avatar-bots/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarBotsApp.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+#include <QCommandLineParser>
+#include <QLoggingCategory>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+
+#include <AbstractAudioInterface.h>
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <AudioConstants.h>
+#include <AvatarData.h>
+#include <AvatarHashMap.h>
+#include <ClientTraitsHandler.h>
+#include <DependencyManager.h>
+#include <GLMHelpers.h>
+#include <NetworkLogging.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedLogging.h>
+#include <SharedUtil.h>
+#include <Transform.h>
+#include <ViewFrustum.h>
+#include <recording/Clip.h>
+#include <recording/Deck.h>
+#include <recording/Frame.h>
+#include <shared/ConicalViewFrustum.h>
+
+const QString BOT_STATS_PREFIX = "stats";
+const int STATS_INTERVAL_MSECS = 5000;
+const int BOT_LAUNCH_INTERVAL_MSECS = 50;
+const int AVATAR_QUERY_INTERVAL_MSECS = 1000;
+const float WALK_RADIUS = 2.0f; // meters
+const float WALK_SPEED = 1.0f; // meters per second
+const float TONE_FREQUENCY = 440.0f; // Hz
+const float TONE_AMPLITUDE = 0.1f;
+
+// stats a bot reports that are maximums rather than totals
+const QStringList MAX_STATS { "bulk_data_gap_max_usecs", "mixer_ping_max_msecs" };
+
+// An AvatarData that sends its identity and traits along with its data, as ScriptableAvatar does for an Agent
+class BotAvatar : public AvatarData {
+public:
+    BotAvatar() {
+        _clientTraitsHandler.reset(new ClientTraitsHandler(this));
+    }
+
+    QByteArray toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking) override {
+        _globalPosition = getWorldPosition();
+        return AvatarData::toByteArrayStateful(dataDetail, dropFaceTracking);
+    }
+
+    int sendAvatarDataPacket(bool sendAll = false) override {
+        int bytesSent = 0;
+        if (getIdentityDataChanged()) {
+            bytesSent += sendIdentityPacket();
+        }
+        bytesSent += _clientTraitsHandler->sendChangedTraitsToMixer();
+        return bytesSent + AvatarData::sendAvatarDataPacket(sendAll);
+    }
+};
+
+AvatarBotsApp::AvatarBotsApp(int argc, char* argv[]) :
+    QCoreApplication(argc, argv)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity avatar and audio mixer load generator, one process per avatar bot");
+
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption verboseOutput("v", "verbose output");
+    parser.addOption(verboseOutput);
+
+    const QCommandLineOption domainAddressOption("d", "domain-server address", "127.0.0.1:40103");
+    parser.addOption(domainAddressOption);
+
+    const QCommandLineOption numBotsOption("n", "number of avatar bots, each a process of its own", "50");
+    parser.addOption(numBotsOption);
+
+    const QCommandLineOption durationOption("duration", "seconds to run the test", "60");
+    parser.addOption(durationOption);
+
+    const QCommandLineOption recordingOption("recording", "recording (.hfr) each avatar replays, from a random point",
+                                             "path");
+    parser.addOption(recordingOption);
+
+    const QCommandLineOption audioOption("audio", "stream audio, from the recording or a tone if it has none");
+    parser.addOption(audioOption);
+
+    const QCommandLineOption spreadOption("spread", "radius in meters of the area the avatars are spread over", "10");
+    parser.addOption(spreadOption);
+
+    const QCommandLineOption metricsOption("metrics", "mixer metrics to report, e.g. http://127.0.0.1:9100/metrics "
+                                           "for an assignment-client run with --metrics-port 9100", "url");
+    parser.addOption(metricsOption);
+
+    const QCommandLineOption botOption("bot", "run as a single avatar bot, as started by the controller");
+    parser.addOption(botOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    _verbose = parser.isSet(verboseOutput);
+    if (!_verbose) {
+        QLoggingCategory::setFilterRules("qt.network.ssl.warning=false");
+
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtWarningMsg, false);
+
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtWarningMsg, false);
+    }
+
+    _domainServerAddress = parser.isSet(domainAddressOption) ? parser.value(domainAddressOption) : "127.0.0.1:40103";
+    if (parser.isSet(numBotsOption)) {
+        _numBots = parser.value(numBotsOption).toInt();
+    }
+    if (parser.isSet(durationOption)) {
+        _duration = parser.value(durationOption).toFloat();
+    }
+    if (parser.isSet(recordingOption)) {
+        _recordingPath = parser.value(recordingOption);
+    }
+    _sendAudio = parser.isSet(audioOption);
+    if (parser.isSet(spreadOption)) {
+        _spread = parser.value(spreadOption).toFloat();
+    }
+    _metricsURLs = parser.values(metricsOption);
+
+    if (parser.isSet(botOption)) {
+        startBot();
+    } else {
+        startController();
+    }
+}
+
+AvatarBotsApp::~AvatarBotsApp() {
+    delete _deck;
+    delete _avatar;
+}
+
+void AvatarBotsApp::startController() {
+    qDebug() << "Running" << _numBots << "avatar bots on" << _domainServerAddress << "for" << _duration << "seconds,"
+        << (_recordingPath.isEmpty() ? "walking in circles" : "replaying " + _recordingPath)
+        << (_sendAudio ? "with audio" : "without audio");
+
+    _startTime = usecTimestampNow();
+
+    connect(&_launchTimer, &QTimer::timeout, this, &AvatarBotsApp::launchBots);
+    _launchTimer.start(BOT_LAUNCH_INTERVAL_MSECS);
+
+    connect(&_statsTimer, &QTimer::timeout, this, &AvatarBotsApp::printStats);
+    _statsTimer.start(STATS_INTERVAL_MSECS);
+
+    if (!_metricsURLs.isEmpty()) {
+        _metricsAccess = new QNetworkAccessManager(this);
+        connect(_metricsAccess, &QNetworkAccessManager::finished, this, &AvatarBotsApp::metricsReceived);
+    }
+}
+
+void AvatarBotsApp::launchBots() {
+    quint64 elapsed = usecTimestampNow() - _startTime;
+    if (elapsed > (quint64)(_duration * USECS_PER_SECOND)) {
+        // the bots leave on their own at the end of the test, so the mixers see them go
+        _launchTimer.stop();
+        _isStopping = true;
+        if (_bots.isEmpty()) {
+            printStats();
+            quit();
+        }
+        return;
+    }
+
+    if (_numStarted >= _numBots) {
+        return;
+    }
+
+    QProcess* bot = new QProcess(this);
+    bot->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    connect(bot, &QProcess::readyReadStandardOutput, this, &AvatarBotsApp::readBotStats);
+    connect(bot, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            this, &AvatarBotsApp::botFinished);
+
+    float remaining = _duration - (float)elapsed / USECS_PER_SECOND;
+    QStringList arguments { "--bot", "-d", _domainServerAddress, "--spread", QString::number(_spread),
+                            "--duration", QString::number(remaining) };
+    if (!_recordingPath.isEmpty()) {
+        arguments << "--recording" << _recordingPath;
+    }
+    if (_sendAudio) {
+        arguments << "--audio";
+    }
+    if (_verbose) {
+        arguments << "-v";
+    }
+    bot->start(QCoreApplication::applicationFilePath(), arguments);
+
+    _bots.push_back(bot);
+    ++_numStarted;
+}
+
+void AvatarBotsApp::readBotStats() {
+    QProcess* bot = qobject_cast<QProcess*>(sender());
+    while (bot && bot->canReadLine()) {
+        QStringList fields = QString(bot->readLine()).trimmed().split(' ');
+        if (fields.isEmpty() || fields[0] != BOT_STATS_PREFIX) {
+            continue;
+        }
+        for (int i = 1; i < fields.size(); ++i) {
+            auto keyValue = fields[i].split('=');
+            if (keyValue.size() != 2) {
+                continue;
+            }
+            auto& stat = _stats[keyValue[0]];
+            quint64 value = keyValue[1].toULongLong();
+            stat = MAX_STATS.contains(keyValue[0]) ? std::max(stat, value) : stat + value;
+        }
+    }
+}
+
+void AvatarBotsApp::botFinished() {
+    QProcess* bot = qobject_cast<QProcess*>(sender());
+    if (!bot) {
+        return;
+    }
+    _bots.removeOne(bot);
+    bot->deleteLater();
+
+    if (_isStopping && _bots.isEmpty()) {
+        printStats();
+        quit();
+    }
+}
+
+void AvatarBotsApp::printStats() {
+    float seconds = (float)_statsTimer.interval() / (float)MSECS_PER_SECOND;
+    // each bot reports once a second, so this counts avatar seconds connected
+    float connectedSeconds = (float)_stats["connected"];
+    auto kbpsPerAvatar = [&](const QString& stat) {
+        return connectedSeconds > 0.0f ? (float)_stats[stat] * BITS_IN_BYTE / BYTES_PER_KILOBIT / connectedSeconds : 0.0f;
+    };
+    auto average = [&](const QString& sum, const QString& count) {
+        return QString::number(_stats[count] > 0 ? (float)_stats[sum] / (float)_stats[count] : 0.0f, 'f', 1);
+    };
+
+    qDebug().noquote() << QString("avatars: %1 running, %2 connected | avatar kbps per avatar: %3 out, %4 in | "
+                                  "audio kbps per avatar: %5 out, %6 in")
+        .arg(_bots.size()).arg(connectedSeconds / seconds, 0, 'f', 0)
+        .arg(kbpsPerAvatar("avatar_bytes_out"), 0, 'f', 1)
+        .arg(kbpsPerAvatar("avatar_bytes_in"), 0, 'f', 1)
+        .arg(kbpsPerAvatar("audio_bytes_out"), 0, 'f', 1)
+        .arg(kbpsPerAvatar("audio_bytes_in"), 0, 'f', 1);
+
+    // the ping is the network round trip, the gap between avatar data packets is how often the mixer gets to us
+    qDebug().noquote() << QString("  mixer ping: %1 ms average, %2 ms max | avatar mixer updates: %3 ms apart on "
+                                  "average, %4 ms max")
+        .arg(average("mixer_ping_msecs", "mixer_pings"))
+        .arg(_stats["mixer_ping_max_msecs"])
+        .arg(QString::number(_stats["bulk_data_packets"] > 0 ?
+                             (float)_stats["bulk_data_gap_usecs"] / _stats["bulk_data_packets"] / USECS_PER_MSEC : 0.0f,
+                             'f', 1))
+        .arg(QString::number((float)_stats["bulk_data_gap_max_usecs"] / USECS_PER_MSEC, 'f', 1));
+
+    _stats.clear();
+
+    // mixer side, reported when the scrape comes back
+    for (const auto& url : _metricsURLs) {
+        _metricsAccess->get(QNetworkRequest(QUrl(url)));
+    }
+}
+
+void AvatarBotsApp::metricsReceived(QNetworkReply* reply) {
+    reply->deleteLater();
+    QString url = reply->request().url().toString();
+    if (reply->error() != QNetworkReply::NoError) {
+        qDebug().noquote() << "  " << url << "unavailable:" << reply->errorString();
+        return;
+    }
+
+    QMap<QString, double> metrics;
+    for (const auto& line : QString(reply->readAll()).split('\n')) {
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+        int valueStart = line.lastIndexOf(' ');
+        metrics[line.left(valueStart)] = line.mid(valueStart + 1).toDouble();
+    }
+
+    // the mean of each latency histogram, and the rate of each byte counter, since the last scrape
+    auto& lastMetrics = _lastMetrics[url];
+    float seconds = (float)_statsTimer.interval() / (float)MSECS_PER_SECOND;
+    QStringList lines;
+    for (auto itr = metrics.begin(); itr != metrics.end(); ++itr) {
+        QString name = itr.key().section('{', 0, 0);
+        QString labels = itr.key().mid(name.size());
+        double delta = itr.value() - lastMetrics.value(itr.key(), 0.0);
+
+        if (name.endsWith("_microseconds_count") && delta > 0.0) {
+            QString base = name.left(name.size() - (int)strlen("_count"));
+            double sumDelta = metrics.value(base + "_sum" + labels) - lastMetrics.value(base + "_sum" + labels, 0.0);
+            lines << QString("%1%2: %3 usecs").arg(base, labels).arg(sumDelta / delta, 0, 'f', 1);
+        } else if (name.endsWith("_bytes_total") && delta > 0.0) {
+            lines << QString("%1%2: %3 kbps").arg(name, labels)
+                .arg(delta * BITS_IN_BYTE / BYTES_PER_KILOBIT / seconds, 0, 'f', 1);
+        }
+    }
+    lastMetrics = metrics;
+
+    qDebug().noquote() << "  " << url;
+    for (const auto& line : lines) {
+        qDebug().noquote() << "    " << line;
+    }
+}
+
+void AvatarBotsApp::startBot() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+
+    DependencyManager::set<AccountManager>([&]{ return QString("Mozilla/5.0 (HighFidelityAvatarBots)"); });
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent, INVALID_PORT);
+
+    auto accountManager = DependencyManager::get<AccountManager>();
+    accountManager->setIsAgent(true);
+
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    // setup a timer for domain-server check ins
+    QTimer* domainCheckInTimer = new QTimer(nodeList.data());
+    connect(domainCheckInTimer, &QTimer::timeout, nodeList.data(), &NodeList::sendDomainServerCheckIn);
+    domainCheckInTimer->start(DOMAIN_SERVER_CHECK_IN_MSECS);
+
+    // start the nodeThread so its event loop is running
+    // (must happen after the checkin timer is created with the nodelist as it's parent)
+    nodeList->startThread();
+
+    nodeList->addSetOfNodeTypesToNodeInterestSet(NodeSet() << NodeType::AudioMixer << NodeType::AvatarMixer);
+    connect(nodeList.data(), &NodeList::nodeActivated, this, &AvatarBotsApp::nodeActivated);
+
+    auto& packetReceiver = nodeList->getPacketReceiver();
+    packetReceiver.registerListenerForTypes({ PacketType::BulkAvatarData, PacketType::AvatarIdentity,
+                                              PacketType::BulkAvatarTraits, PacketType::KillAvatar,
+                                              PacketType::MixedAudio, PacketType::SilentAudioFrame },
+                                            this, "processMixerPacket");
+
+    static std::mt19937 generator(std::random_device{}());
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    // somewhere in a disc of the spread radius, so avatars near each other hear and see each other
+    float angle = unit(generator) * TWO_PI;
+    float distance = sqrtf(unit(generator)) * _spread;
+    _center = glm::vec3(cosf(angle) * distance, 0.0f, sinf(angle) * distance);
+    _phase = unit(generator) * TWO_PI;
+
+    _avatar = new BotAvatar();
+    _avatar->setSkeletonModelURL(AvatarData::defaultFullAvatarModelUrl());
+    _avatar->setDisplayName(QString("bot-%1").arg(QCoreApplication::applicationPid()));
+    _avatar->setWorldPosition(_center);
+    connect(nodeList.data(), &NodeList::uuidChanged, _avatar, &AvatarData::setSessionUUID);
+
+    if (!_recordingPath.isEmpty()) {
+        auto clip = recording::Clip::fromFile(_recordingPath);
+        if (!clip) {
+            qCritical() << "Unable to read recording" << _recordingPath;
+            QCoreApplication::exit(1);
+            return;
+        }
+
+        using namespace recording;
+        static const FrameType AVATAR_FRAME_TYPE = Frame::registerFrameType(AvatarData::FRAME_NAME);
+        static const FrameType AUDIO_FRAME_TYPE = Frame::registerFrameType(AudioConstants::getAudioFrameName());
+
+        // replayed relative to where this avatar stands
+        _avatar->setRecordingBasis();
+        Frame::registerFrameHandler(AVATAR_FRAME_TYPE, [this](Frame::ConstPointer frame) {
+            AvatarData::fromFrame(frame->data, *_avatar);
+        });
+        Frame::registerFrameHandler(AUDIO_FRAME_TYPE, [this](Frame::ConstPointer frame) {
+            _hasRecordedAudio = true;
+            if (_sendAudio) {
+                sendAudio(frame->data);
+            }
+        });
+
+        // start each avatar at a different point in the recording, so they don't move in lock step
+        _deck = new Deck();
+        _deck->queueClip(clip);
+        _deck->loop(true);
+        _deck->seek(unit(generator) * clip->duration());
+        _deck->play();
+    }
+
+    connect(&_avatarTimer, &QTimer::timeout, this, &AvatarBotsApp::updateAvatar);
+    _avatarTimer.setTimerType(Qt::PreciseTimer);
+    _avatarTimer.start((int)MSECS_PER_SECOND / CLIENT_TO_AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
+
+    if (_sendAudio) {
+        connect(&_audioTimer, &QTimer::timeout, this, &AvatarBotsApp::sendToneAudio);
+        _audioTimer.setTimerType(Qt::PreciseTimer);
+        _audioTimer.start((int)AudioConstants::NETWORK_FRAME_MSECS);
+    }
+
+    connect(&_queryTimer, &QTimer::timeout, this, &AvatarBotsApp::queryAvatars);
+    _queryTimer.start(AVATAR_QUERY_INTERVAL_MSECS);
+
+    DependencyManager::get<AddressManager>()->handleLookupString(_domainServerAddress, false);
+
+    connect(&_statsTimer, &QTimer::timeout, this, &AvatarBotsApp::sendBotStats);
+    _statsTimer.start((int)MSECS_PER_SECOND);
+
+    QTimer::singleShot((int)(_duration * MSECS_PER_SECOND), this, &AvatarBotsApp::finishBot);
+}
+
+void AvatarBotsApp::nodeActivated(SharedNodePointer node) {
+    if (node->getType() == NodeType::AvatarMixer) {
+        // a new mixer needs to hear who we are
+        _avatar->markIdentityDataChanged();
+        _avatar->sendAvatarDataPacket(true);
+    }
+}
+
+void AvatarBotsApp::processMixerPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    auto type = message->getType();
+    if (type == PacketType::MixedAudio || type == PacketType::SilentAudioFrame) {
+        _stats["audio_bytes_in"] += message->getSize();
+        return;
+    }
+
+    _stats["avatar_bytes_in"] += message->getSize();
+    if (type == PacketType::BulkAvatarData) {
+        quint64 now = usecTimestampNow();
+        if (_lastBulkDataTime != 0) {
+            quint64 gap = now - _lastBulkDataTime;
+            ++_stats["bulk_data_packets"];
+            _stats["bulk_data_gap_usecs"] += gap;
+            _stats["bulk_data_gap_max_usecs"] = std::max(_stats["bulk_data_gap_max_usecs"], gap);
+        }
+        _lastBulkDataTime = now;
+    }
+}
+
+void AvatarBotsApp::updateAvatar() {
+    if (!_deck) {
+        // walk in a circle around where we started
+        _phase += WALK_SPEED / WALK_RADIUS / CLIENT_TO_AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
+        glm::vec3 offset(cosf(_phase), 0.0f, sinf(_phase));
+        _avatar->setWorldPosition(_center + WALK_RADIUS * offset);
+        _avatar->setWorldOrientation(glm::angleAxis(-_phase, Vectors::UNIT_Y));
+    }
+
+    auto avatarMixer = DependencyManager::get<NodeList>()->soloNodeOfType(NodeType::AvatarMixer);
+    if (avatarMixer && avatarMixer->getActiveSocket()) {
+        _stats["avatar_bytes_out"] += _avatar->sendAvatarDataPacket();
+    }
+}
+
+void AvatarBotsApp::sendToneAudio() {
+    if (_hasRecordedAudio) {
+        return;
+    }
+
+    static QByteArray tone;
+    static int toneOffset = 0;
+    if (tone.isEmpty()) {
+        // a second of it, a whole number of cycles so it loops without a click
+        tone.resize(AudioConstants::SAMPLE_RATE * AudioConstants::SAMPLE_SIZE);
+        auto samples = reinterpret_cast<int16_t*>(tone.data());
+        for (int i = 0; i < AudioConstants::SAMPLE_RATE; ++i) {
+            samples[i] = (int16_t)(TONE_AMPLITUDE * AudioConstants::MAX_SAMPLE_VALUE *
+                                   sinf(TWO_PI * TONE_FREQUENCY * i / AudioConstants::SAMPLE_RATE));
+        }
+    }
+
+    sendAudio(tone.mid(toneOffset, AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL));
+    toneOffset = (toneOffset + AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL) % tone.size();
+}
+
+void AvatarBotsApp::sendAudio(const QByteArray& audio) {
+    auto audioMixer = DependencyManager::get<NodeList>()->soloNodeOfType(NodeType::AudioMixer);
+    if (!audioMixer || !audioMixer->getActiveSocket()) {
+        return;
+    }
+
+    // uncompressed, like an Agent that hasn't negotiated a codec
+    Transform audioTransform;
+    audioTransform.setTranslation(_avatar->getWorldPosition());
+    audioTransform.setRotation(_avatar->getWorldOrientation());
+    AbstractAudioInterface::emitAudioPacket(audio.data(), audio.size(), _audioSequenceNumber, false, audioTransform,
+                                            _avatar->getWorldPosition(), glm::vec3(0), PacketType::MicrophoneAudioNoEcho);
+    _stats["audio_bytes_out"] += audio.size();
+}
+
+void AvatarBotsApp::queryAvatars() {
+    ViewFrustum view;
+    view.setPosition(_avatar->getWorldPosition());
+    view.setOrientation(_avatar->getWorldOrientation());
+    view.setProjection(DEFAULT_FIELD_OF_VIEW_DEGREES, DEFAULT_ASPECT_RATIO, DEFAULT_NEAR_CLIP, DEFAULT_FAR_CLIP);
+    view.calculate();
+    ConicalViewFrustum conicalView { view };
+
+    auto avatarPacket = NLPacket::create(PacketType::AvatarQuery);
+    auto destinationBuffer = reinterpret_cast<unsigned char*>(avatarPacket->getPayload());
+    auto bufferStart = destinationBuffer;
+
+    uint8_t numFrustums = 1;
+    memcpy(destinationBuffer, &numFrustums, sizeof(numFrustums));
+    destinationBuffer += sizeof(numFrustums);
+
+    destinationBuffer += conicalView.serialize(destinationBuffer);
+
+    avatarPacket->setPayloadSize(destinationBuffer - bufferStart);
+
+    DependencyManager::get<NodeList>()->broadcastToNodes(std::move(avatarPacket), { NodeType::AvatarMixer });
+}
+
+void AvatarBotsApp::sendBotStats() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    for (auto type : { NodeType::AvatarMixer, NodeType::AudioMixer }) {
+        auto mixer = nodeList->soloNodeOfType(type);
+        if (mixer && mixer->getActiveSocket() && mixer->getPingMs() >= 0) {
+            quint64 ping = (quint64)mixer->getPingMs();
+            ++_stats["mixer_pings"];
+            _stats["mixer_ping_msecs"] += ping;
+            _stats["mixer_ping_max_msecs"] = std::max(_stats["mixer_ping_max_msecs"], ping);
+        }
+    }
+    auto avatarMixer = nodeList->soloNodeOfType(NodeType::AvatarMixer);
+    _stats["connected"] = (avatarMixer && avatarMixer->getActiveSocket()) ? 1 : 0;
+
+    // the controller reads these from our stdout, each line adds to its totals for the interval
+    std::cout << BOT_STATS_PREFIX.toStdString();
+    for (auto itr = _stats.begin(); itr != _stats.end(); ++itr) {
+        std::cout << " " << itr.key().toStdString() << "=" << itr.value();
+    }
+    std::cout << std::endl;
+
+    _stats.clear();
+}
+
+void AvatarBotsApp::finishBot() {
+    sendBotStats();
+
+    if (_deck) {
+        _deck->stop();
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    // tell the avatar mixer to forget this avatar now, rather than when the node times out
+    auto avatarMixer = nodeList->soloNodeOfType(NodeType::AvatarMixer);
+    if (avatarMixer && avatarMixer->getActiveSocket()) {
+        auto packet = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason), true);
+        packet->write(nodeList->getSessionUUID().toRfc4122());
+        packet->writePrimitive(KillAvatarReason::NoReason);
+        nodeList->sendPacket(std::move(packet), *avatarMixer);
+    }
+
+    // send the domain a disconnect packet, force stoppage of domain-server check-ins
+    nodeList->getDomainHandler().disconnect("Finishing");
+    nodeList->setIsShuttingDown(true);
+
+    // tell the packet receiver we're shutting down, so it can drop packets
+    nodeList->getPacketReceiver().setShouldDropPackets(true);
+
+    // remove the NodeList from the DependencyManager
+    DependencyManager::destroy<NodeList>();
+
+    QCoreApplication::exit(0);
+}
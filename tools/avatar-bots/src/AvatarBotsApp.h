@@ -0,0 +1,103 @@
+//
+//  AvatarBotsApp.h
+//  tools/avatar-bots/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarBotsApp_h
+#define hifi_AvatarBotsApp_h
+
+#include <QCoreApplication>
+#include <QMap>
+#include <QNetworkAccessManager>
+#include <QProcess>
+#include <QTimer>
+
+#include <glm/glm.hpp>
+
+#include <Node.h>
+#include <ReceivedMessage.h>
+
+class BotAvatar;
+
+namespace recording {
+class Deck;
+}
+
+// Load generator for the avatar and audio mixers: launches avatar bots against a local domain, each replaying motion
+// from a recording (or walking in a circle without one) and optionally streaming audio, and reports the traffic they
+// see and the mixers' own timings.
+//
+// Each bot is a copy of this program run with --bot, one avatar per process.  Several avatars can't share a process,
+// since the NodeList, and the domain handler, avatar identity, trait and audio sends that reach it through the
+// DependencyManager, is one per process.  A bot is only a NodeList, an AvatarData and a recording::Deck, much lighter
+// than an Agent, but still a process of its own.
+class AvatarBotsApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    AvatarBotsApp(int argc, char* argv[]);
+    ~AvatarBotsApp();
+
+private slots:
+    // controller
+    void launchBots();
+    void readBotStats();
+    void botFinished();
+    void printStats();
+    void metricsReceived(QNetworkReply* reply);
+
+    // bot
+    void nodeActivated(SharedNodePointer node);
+    void processMixerPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    void updateAvatar();
+    void sendToneAudio();
+    void queryAvatars();
+    void sendBotStats();
+    void finishBot();
+
+private:
+    void startBot();
+    void startController();
+    void sendAudio(const QByteArray& audio);
+
+    // options
+    QString _domainServerAddress;
+    int _numBots { 50 };
+    float _duration { 60.0f }; // seconds
+    QString _recordingPath;
+    bool _sendAudio { false };
+    float _spread { 10.0f }; // meters
+    QStringList _metricsURLs;
+    bool _verbose { false };
+
+    // controller
+    QTimer _launchTimer;
+    QTimer _statsTimer;
+    QList<QProcess*> _bots;
+    int _numStarted { 0 };
+    quint64 _startTime { 0 };
+    bool _isStopping { false };
+    QNetworkAccessManager* _metricsAccess { nullptr };
+    QMap<QString, QMap<QString, double>> _lastMetrics; // by URL, then by metric with labels
+
+    // bot
+    BotAvatar* _avatar { nullptr };
+    recording::Deck* _deck { nullptr };
+    QTimer _avatarTimer;
+    QTimer _audioTimer;
+    QTimer _queryTimer;
+    glm::vec3 _center;
+    float _phase { 0.0f };
+    bool _hasRecordedAudio { false };
+    quint16 _audioSequenceNumber { 0 };
+    quint64 _lastBulkDataTime { 0 };
+
+    // accumulated since the last report, by the bot and then by the controller
+    QMap<QString, quint64> _stats;
+};
+
+#endif // hifi_AvatarBotsApp_h
@@ -0,0 +1,23 @@
+//
+//  main.cpp
+//  tools/avatar-bots/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <SettingHandle.h>
+#include <SharedUtil.h>
+
+#include "AvatarBotsApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Avatar Bots");
+
+    Setting::init();
+
+    AvatarBotsApp app(argc, argv);
+    return app.exec();
+}
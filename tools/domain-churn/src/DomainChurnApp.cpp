@@ -0,0 +1,266 @@
+//
+//  DomainChurnApp.cpp
+//  tools/domain-churn/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainChurnApp.h"
+
+#include <iostream>
+#include <random>
+
+#include <QCommandLineParser>
+#include <QLoggingCategory>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <NetworkLogging.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedLogging.h>
+#include <SharedUtil.h>
+
+const QString BOT_STATS_PREFIX = "stats";
+const int STATS_INTERVAL_MSECS = 5000;
+const int BOT_LAUNCH_INTERVAL_MSECS = 20;
+
+DomainChurnApp::DomainChurnApp(int argc, char* argv[]) :
+    QCoreApplication(argc, argv)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity domain-server churn load test");
+
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption verboseOutput("v", "verbose output");
+    parser.addOption(verboseOutput);
+
+    const QCommandLineOption domainAddressOption("d", "domain-server address", "127.0.0.1:40103");
+    parser.addOption(domainAddressOption);
+
+    const QCommandLineOption numBotsOption("n", "number of connected bots to maintain", "100");
+    parser.addOption(numBotsOption);
+
+    const QCommandLineOption lifetimeOption("lifetime", "average seconds each bot stays connected", "30");
+    parser.addOption(lifetimeOption);
+
+    const QCommandLineOption durationOption("duration", "seconds to run the test", "60");
+    parser.addOption(durationOption);
+
+    const QCommandLineOption botOption("bot", "run as a single bot, connected for exactly --lifetime seconds");
+    parser.addOption(botOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    _verbose = parser.isSet(verboseOutput);
+    if (!_verbose) {
+        QLoggingCategory::setFilterRules("qt.network.ssl.warning=false");
+
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtWarningMsg, false);
+
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtWarningMsg, false);
+    }
+
+    _domainServerAddress = parser.isSet(domainAddressOption) ? parser.value(domainAddressOption) : "127.0.0.1:40103";
+    if (parser.isSet(numBotsOption)) {
+        _numBots = parser.value(numBotsOption).toInt();
+    }
+    if (parser.isSet(lifetimeOption)) {
+        _lifetime = parser.value(lifetimeOption).toFloat();
+    }
+    if (parser.isSet(durationOption)) {
+        _duration = parser.value(durationOption).toFloat();
+    }
+
+    if (parser.isSet(botOption)) {
+        startBot();
+    } else {
+        startController();
+    }
+}
+
+void DomainChurnApp::startController() {
+    qDebug() << "Maintaining" << _numBots << "bots on" << _domainServerAddress << "with an average lifetime of"
+        << _lifetime << "seconds for" << _duration << "seconds";
+
+    _startTime = usecTimestampNow();
+
+    // bring the bots up gradually so the domain-server sees churn rather than one burst of connections
+    connect(&_launchTimer, &QTimer::timeout, this, &DomainChurnApp::launchBots);
+    _launchTimer.start(BOT_LAUNCH_INTERVAL_MSECS);
+
+    connect(&_statsTimer, &QTimer::timeout, this, &DomainChurnApp::printStats);
+    _statsTimer.start(STATS_INTERVAL_MSECS);
+}
+
+void DomainChurnApp::launchBots() {
+    if (usecTimestampNow() - _startTime > (quint64)(_duration * USECS_PER_SECOND)) {
+        _launchTimer.stop();
+        _isStopping = true;
+        for (auto bot : _bots) {
+            bot->terminate();
+        }
+        if (_bots.isEmpty()) {
+            printStats();
+            quit();
+        }
+        return;
+    }
+
+    if (_bots.size() >= _numBots) {
+        return;
+    }
+
+    // each bot lives between half and one and a half times the average lifetime
+    static std::mt19937 generator(std::random_device{}());
+    std::uniform_real_distribution<float> lifetime(0.5f * _lifetime, 1.5f * _lifetime);
+
+    QProcess* bot = new QProcess(this);
+    bot->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    connect(bot, &QProcess::readyReadStandardOutput, this, &DomainChurnApp::readBotStats);
+    connect(bot, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            this, &DomainChurnApp::botFinished);
+
+    QStringList arguments { "--bot", "-d", _domainServerAddress, "--lifetime", QString::number(lifetime(generator)) };
+    if (_verbose) {
+        arguments << "-v";
+    }
+    bot->start(QCoreApplication::applicationFilePath(), arguments);
+
+    _bots.push_back(bot);
+    ++_numStarted;
+}
+
+void DomainChurnApp::readBotStats() {
+    QProcess* bot = qobject_cast<QProcess*>(sender());
+    while (bot && bot->canReadLine()) {
+        QStringList fields = QString(bot->readLine()).trimmed().split(' ');
+        if (fields.size() == 5 && fields[0] == BOT_STATS_PREFIX) {
+            _numLists += fields[1].toULongLong();
+            _numFullLists += fields[2].toULongLong();
+            _numListBytes += fields[3].toULongLong();
+            _domainServerProcessingTime += fields[4].toULongLong();
+        }
+    }
+}
+
+void DomainChurnApp::botFinished() {
+    QProcess* bot = qobject_cast<QProcess*>(sender());
+    if (!bot) {
+        return;
+    }
+    _bots.removeOne(bot);
+    bot->deleteLater();
+    ++_numFinished;
+
+    if (_isStopping && _bots.isEmpty()) {
+        printStats();
+        quit();
+    }
+}
+
+void DomainChurnApp::printStats() {
+    float seconds = (float)_statsTimer.interval() / (float)MSECS_PER_SECOND;
+    qDebug().noquote() << QString("bots: %1 connected, %2 started, %3 left | domain lists: %4/s (%5 full), %6 KB/s, "
+                                  "%7 usec domain-server processing per list")
+        .arg(_bots.size()).arg(_numStarted).arg(_numFinished)
+        .arg((float)_numLists / seconds, 0, 'f', 1).arg(_numFullLists)
+        .arg((float)_numListBytes / seconds / (float)BYTES_PER_KILOBYTE, 0, 'f', 1)
+        .arg(_numLists > 0 ? _domainServerProcessingTime / _numLists : 0);
+
+    _numLists = 0;
+    _numFullLists = 0;
+    _numListBytes = 0;
+    _domainServerProcessingTime = 0;
+}
+
+void DomainChurnApp::startBot() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+
+    DependencyManager::set<AccountManager>([&]{ return QString("Mozilla/5.0 (HighFidelityDomainChurn)"); });
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent, INVALID_PORT);
+
+    auto accountManager = DependencyManager::get<AccountManager>();
+    accountManager->setIsAgent(true);
+
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    // setup a timer for domain-server check ins
+    QTimer* domainCheckInTimer = new QTimer(nodeList.data());
+    connect(domainCheckInTimer, &QTimer::timeout, nodeList.data(), &NodeList::sendDomainServerCheckIn);
+    domainCheckInTimer->start(DOMAIN_SERVER_CHECK_IN_MSECS);
+
+    // start the nodeThread so its event loop is running
+    // (must happen after the checkin timer is created with the nodelist as it's parent)
+    nodeList->startThread();
+
+    connect(nodeList.data(), &NodeList::domainServerListStats, this,
+            [this](qint64 numBytes, bool isFullList, quint64 domainServerProcessingTime) {
+        ++_numLists;
+        _numFullLists += isFullList ? 1 : 0;
+        _numListBytes += numBytes;
+        _domainServerProcessingTime += domainServerProcessingTime;
+    });
+
+    // an interface client's interest set plus the other bots, which are what come and go, so that each bot's lists carry
+    // the churn the way a mixer's do
+    nodeList->addSetOfNodeTypesToNodeInterestSet(NodeSet() << NodeType::AudioMixer << NodeType::AvatarMixer
+                                                 << NodeType::EntityServer << NodeType::AssetServer
+                                                 << NodeType::MessagesMixer << NodeType::EntityScriptServer
+                                                 << NodeType::Agent);
+
+    DependencyManager::get<AddressManager>()->handleLookupString(_domainServerAddress, false);
+
+    connect(&_statsTimer, &QTimer::timeout, this, &DomainChurnApp::sendBotStats);
+    _statsTimer.start((int)MSECS_PER_SECOND);
+
+    QTimer::singleShot((int)(_lifetime * MSECS_PER_SECOND), this, &DomainChurnApp::finishBot);
+}
+
+void DomainChurnApp::sendBotStats() {
+    // the controller reads these from our stdout
+    std::cout << BOT_STATS_PREFIX.toStdString() << " " << _numLists << " " << _numFullLists << " "
+        << _numListBytes << " " << _domainServerProcessingTime << std::endl;
+
+    _numLists = 0;
+    _numFullLists = 0;
+    _numListBytes = 0;
+    _domainServerProcessingTime = 0;
+}
+
+void DomainChurnApp::finishBot() {
+    sendBotStats();
+
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    // send the domain a disconnect packet, force stoppage of domain-server check-ins
+    nodeList->getDomainHandler().disconnect("Finishing");
+    nodeList->setIsShuttingDown(true);
+
+    // tell the packet receiver we're shutting down, so it can drop packets
+    nodeList->getPacketReceiver().setShouldDropPackets(true);
+
+    // remove the NodeList from the DependencyManager
+    DependencyManager::destroy<NodeList>();
+
+    QCoreApplication::exit(0);
+}
@@ -0,0 +1,64 @@
+//
+//  DomainChurnApp.h
+//  tools/domain-churn/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainChurnApp_h
+#define hifi_DomainChurnApp_h
+
+#include <QCoreApplication>
+#include <QProcess>
+#include <QTimer>
+
+// Load test for the domain-server: keeps a population of bot agents connected to a local domain, each of which
+// leaves after a random lifetime and is replaced by a new one, and reports how much domain list traffic that causes.
+//
+// The bots are copies of this program run with --bot, since each needs a NodeList of its own.  They ask to hear about
+// each other, which the domain-server only allows when it is run with --agents-hear-agents.
+class DomainChurnApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    DomainChurnApp(int argc, char* argv[]);
+
+private slots:
+    // controller
+    void launchBots();
+    void readBotStats();
+    void botFinished();
+    void printStats();
+
+    // bot
+    void sendBotStats();
+    void finishBot();
+
+private:
+    void startBot();
+    void startController();
+
+    QString _domainServerAddress;
+    int _numBots { 100 };
+    float _lifetime { 30.0f }; // seconds
+    float _duration { 60.0f }; // seconds
+    bool _verbose { false };
+
+    QTimer _launchTimer;
+    QTimer _statsTimer;
+    QList<QProcess*> _bots;
+    int _numStarted { 0 };
+    int _numFinished { 0 };
+    quint64 _startTime { 0 };
+    bool _isStopping { false };
+
+    // accumulated since the last report, by the bot and then by the controller
+    quint64 _numLists { 0 };
+    quint64 _numFullLists { 0 };
+    quint64 _numListBytes { 0 };
+    quint64 _domainServerProcessingTime { 0 }; // usecs
+};
+
+#endif // hifi_DomainChurnApp_h
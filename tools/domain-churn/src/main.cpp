@@ -0,0 +1,23 @@
+//
+//  main.cpp
+//  tools/domain-churn/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <SettingHandle.h>
+#include <SharedUtil.h>
+
+#include "DomainChurnApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Domain Churn");
+
+    Setting::init();
+
+    DomainChurnApp app(argc, argv);
+    return app.exec();
+}
@@ -0,0 +1,182 @@
+//
+//  ModelBenchApp.cpp
+//  tools/model-bench/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelBenchApp.h"
+
+#include <chrono>
+
+#include <QCommandLineParser>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+
+#include <DependencyManager.h>
+#include <ResourceManager.h>
+#include <ResourceRequestObserver.h>
+#include <StatTracker.h>
+#include <FBXSerializer.h>
+#include <OBJSerializer.h>
+#include <GLTFSerializer.h>
+#include <hfm/ModelFormatRegistry.h>
+#include <model-baker/Baker.h>
+
+static const QString PARSE_STAGE_NAME = "Parse";
+static const QString TOTAL_STAGE_NAME = "Total";
+static const QStringList MODEL_EXTENSIONS { "fbx", "obj", "gltf", "glb" };
+
+ModelBenchApp::ModelBenchApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity Model Load Benchmark");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption repeatOption("r", "number of times to load each model", "count", "1");
+    parser.addOption(repeatOption);
+
+    const QCommandLineOption dracoOption("draco", "also run the BuildDracoMesh baker task");
+    parser.addOption(dracoOption);
+
+    parser.addPositionalArgument("inputs", "model files, or directories to search for models", "[inputs...]");
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption) || parser.positionalArguments().isEmpty()) {
+        parser.showHelp();
+        return;
+    }
+
+    int repeats = std::max(1, parser.value(repeatOption).toInt());
+    bool enableDraco = parser.isSet(dracoOption);
+
+    DependencyManager::set<StatTracker>();
+    DependencyManager::set<ResourceManager>(false);
+    DependencyManager::set<ResourceRequestObserver>();
+    auto modelFormatRegistry = DependencyManager::set<ModelFormatRegistry>();
+    modelFormatRegistry->addFormat(FBXSerializer());
+    modelFormatRegistry->addFormat(OBJSerializer());
+    modelFormatRegistry->addFormat(GLTFSerializer());
+
+    QStringList models = findModels(parser.positionalArguments());
+    if (models.isEmpty()) {
+        qCritical() << "No models found in" << parser.positionalArguments();
+        _returnCode = 2;
+        return;
+    }
+
+    QTextStream out(stdout);
+    StageTimings corpusTimings;
+    int failures = 0;
+    for (const auto& model : models) {
+        StageTimings timings;
+        if (!benchmarkModel(model, repeats, enableDraco, timings)) {
+            failures++;
+            continue;
+        }
+
+        out << model << endl;
+        for (const auto& stage : timings) {
+            out << "    " << QString::fromStdString(stage.first).leftJustified(28)
+                << QString::number(stage.second / repeats, 'f', 3).rightJustified(10) << " ms" << endl;
+            corpusTimings[stage.first] += stage.second / repeats;
+        }
+    }
+
+    out << endl << "Corpus of " << (models.size() - failures) << " models, averaged over " << repeats << " runs" << endl;
+    for (const auto& stage : corpusTimings) {
+        out << "    " << QString::fromStdString(stage.first).leftJustified(28)
+            << QString::number(stage.second, 'f', 3).rightJustified(10) << " ms" << endl;
+    }
+
+    DependencyManager::get<ResourceManager>()->cleanup();
+    _returnCode = failures > 0 ? 3 : 0;
+}
+
+ModelBenchApp::~ModelBenchApp() {
+}
+
+QStringList ModelBenchApp::findModels(const QStringList& inputs) const {
+    QStringList models;
+    for (const auto& input : inputs) {
+        QFileInfo info(input);
+        if (info.isDir()) {
+            QDirIterator it(input, QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext()) {
+                QString filename = it.next();
+                if (MODEL_EXTENSIONS.contains(QFileInfo(filename).suffix().toLower())) {
+                    models.push_back(filename);
+                }
+            }
+        } else if (info.isFile()) {
+            models.push_back(input);
+        }
+    }
+    models.sort();
+    return models;
+}
+
+bool ModelBenchApp::benchmarkModel(const QString& filename, int repeats, bool enableDraco, StageTimings& timings) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open file" << filename;
+        return false;
+    }
+    hifi::ByteArray data = file.readAll();
+    hifi::URL url = QUrl::fromLocalFile(QFileInfo(filename).absoluteFilePath());
+
+    auto serializer = DependencyManager::get<ModelFormatRegistry>()->getSerializerForMediaType(data, url, "");
+    if (!serializer) {
+        qCritical() << "Unsupported model format" << filename;
+        return false;
+    }
+
+    // match the mapping ModelCache gives the serializer
+    hifi::VariantHash mapping;
+    mapping["deduplicateIndices"] = true;
+
+    for (int i = 0; i < repeats; i++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        HFMModel::Pointer hfmModel;
+        try {
+            hfmModel = serializer->read(data, mapping, url);
+        } catch (const QString& error) {
+            qCritical() << "Failed to parse" << filename << "--" << error;
+            return false;
+        }
+        if (!hfmModel) {
+            qCritical() << "Failed to parse" << filename;
+            return false;
+        }
+        auto parseEnd = std::chrono::high_resolution_clock::now();
+
+        baker::Baker modelBaker(hfmModel, mapping, url);
+        auto config = modelBaker.getConfiguration();
+        auto dracoConfig = config->getJobConfig("BuildDracoMesh");
+        if (dracoConfig) {
+            dracoConfig->setEnabled(enableDraco);
+        }
+        modelBaker.run();
+        auto bakeEnd = std::chrono::high_resolution_clock::now();
+
+        timings[PARSE_STAGE_NAME.toStdString()] += std::chrono::duration<double, std::milli>(parseEnd - start).count();
+        for (auto subConfig : config->getSubConfigs()) {
+            auto jobConfig = qobject_cast<task::JobConfig*>(subConfig);
+            if (jobConfig && jobConfig->isEnabled()) {
+                timings[jobConfig->objectName().toStdString()] += jobConfig->getCPURunTime();
+            }
+        }
+        timings[TOTAL_STAGE_NAME.toStdString()] += std::chrono::duration<double, std::milli>(bakeEnd - start).count();
+    }
+    return true;
+}
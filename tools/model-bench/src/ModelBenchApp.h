@@ -0,0 +1,40 @@
+//
+//  ModelBenchApp.h
+//  tools/model-bench/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ModelBenchApp_h
+#define hifi_ModelBenchApp_h
+
+#include <map>
+#include <string>
+
+#include <QCoreApplication>
+#include <QStringList>
+
+// Loads a corpus of models through the same serializer and model-baker pipeline as ModelCache,
+// and reports how long each stage took per model and in total.
+class ModelBenchApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    ModelBenchApp(int argc, char* argv[]);
+    ~ModelBenchApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    // stage name -> milliseconds
+    using StageTimings = std::map<std::string, double>;
+
+    QStringList findModels(const QStringList& inputs) const;
+    bool benchmarkModel(const QString& filename, int repeats, bool enableDraco, StageTimings& timings);
+
+    int _returnCode { 0 };
+};
+
+#endif // hifi_ModelBenchApp_h
@@ -0,0 +1,41 @@
+//
+//  main.cpp
+//  tools/trace-export/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+
+#include <SharedUtil.h>
+#include <TraceRecorder.h>
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Trace Export");
+
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Converts a binary trace recording, as written with HIFI_TRACE_FILE set, "
+                                     "to Chrome trace JSON for chrome://tracing");
+    parser.addHelpOption();
+    parser.addPositionalArgument("recording", "binary trace recording to read");
+    parser.addPositionalArgument("output", "Chrome trace JSON file to write, gzipped if it ends with .gz");
+    parser.process(app);
+
+    const QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 2) {
+        parser.showHelp(1);
+    }
+
+    if (!tracing::TraceRecorder::exportChromeTrace(arguments[0], arguments[1])) {
+        qCritical() << "Failed to export" << arguments[0];
+        return 2;
+    }
+    return 0;
+}